@@ -0,0 +1,105 @@
+#!/usr/bin/env python3
+# webserv-cpp17 v1.21.0 벤치마크: 접근 로그를 켜고 끈 처리량과 요청당 서버 CPU, 버린 레코드 수를 잰다.
+# - 설정(variant)마다 서버를 새로 띄우고 `webserv_bench` 로 /health 폐쇄 루프 부하를 건다. rounds 번 반복해 req/s 중앙값을 낸다.
+# - server_cpu_us/req 는 서버 프로세스 전체(워커 + 기록 스레드)의 CPU 시간을 응답 수로 나눈 값이다.
+# - dropped 는 `webserv_access_log_records_total{result="dropped"}`, log_MB 는 로그 파일 크기다.
+# - `{log}` 는 설정마다 새로 만든 로그 파일 경로로 바뀐다.
+# 사용법:
+#   python3 bench/access_log_bench.py build/webserv build/webserv_bench --duration 3 --rounds 3
+#   python3 bench/access_log_bench.py build/webserv build/webserv_bench --variant 'tiny=--access-log {log} --access-log-buffer 64'
+import argparse
+import os
+import re
+import socket
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+
+DEFAULT_VARIANTS = [
+    "off=",
+    "on=--access-log {log}",
+    "sample10=--access-log {log} --access-log-sample 10",
+    "ring256=--access-log {log} --access-log-buffer 256",
+]
+
+
+def cpu_seconds(pid):
+    # utime + stime 은 모든 스레드의 합이다(/proc/PID/schedstat 은 주 스레드만 센다).
+    with open(f"/proc/{pid}/stat") as f:
+        fields = f.read().rsplit(")", 1)[1].split()
+    return (int(fields[11]) + int(fields[12])) / os.sysconf("SC_CLK_TCK")
+
+
+def dropped_records(port):
+    with socket.create_connection(("127.0.0.1", port), timeout=5) as s:
+        s.sendall(b"GET /metrics HTTP/1.1\r\nHost: bench\r\nConnection: close\r\n\r\n")
+        body = b""
+        while True:
+            chunk = s.recv(65536)
+            if not chunk:
+                break
+            body += chunk
+    match = re.search(rb'webserv_access_log_records_total\{result="dropped"\} (\d+)', body)
+    return int(match.group(1)) if match else 0
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("binary")
+    parser.add_argument("bench")
+    parser.add_argument("--port", type=int, default=9190)
+    parser.add_argument("--workers", type=int, default=1)
+    parser.add_argument("--threads", type=int, default=1, help="부하 스레드 수")
+    parser.add_argument("--connections", type=int, default=16)
+    parser.add_argument("--pipeline", type=int, default=1)
+    parser.add_argument("--duration", type=int, default=3)
+    parser.add_argument("--rounds", type=int, default=3)
+    parser.add_argument("--log-dir", default=None, help="로그 파일을 둘 디렉터리(기본: 임시 디렉터리)")
+    parser.add_argument("--variant", action="append", help="NAME=서버 옵션, 여러 번 줄 수 있다")
+    args = parser.parse_args()
+
+    log_dir = args.log_dir or tempfile.mkdtemp(prefix="webserv-access-log-")
+    print(f"{'variant':>10} {'req/s':>10} {'rounds':>24} {'p99_us':>9} {'server_cpu_us/req':>18} "
+          f"{'dropped':>9} {'log_MB':>8}")
+    for variant in args.variant or DEFAULT_VARIANTS:
+        name, _, options = variant.partition("=")
+        rates, p99s, cpu, requests, dropped, log_bytes = [], [], 0.0, 0, 0, 0
+        for round_index in range(args.rounds):
+            log_path = os.path.join(log_dir, f"{name}-{round_index}.log")
+            server = subprocess.Popen(
+                [args.binary, str(args.port), "--unlimited", "--workers", str(args.workers),
+                 "--idle-timeout-ms", "60000"] + options.replace("{log}", log_path).split(),
+                stderr=subprocess.DEVNULL)
+            try:
+                time.sleep(0.3)
+                cpu_before = cpu_seconds(server.pid)
+                output = subprocess.run(
+                    [args.bench, "--threads", str(args.threads), "--connections", str(args.connections),
+                     "--pipeline", str(args.pipeline), "--duration-sec", str(args.duration), "--warmup-sec", "1",
+                     f"127.0.0.1:{args.port}"],
+                    check=True, capture_output=True, text=True).stdout
+                cpu += cpu_seconds(server.pid) - cpu_before
+                summary = dict(item.split("=", 1) for item in output.splitlines()[-1].split()[1:])
+                rates.append(float(summary["rps"]))
+                p99s.append(float(summary["p99_us"]))
+                # 워밍업 응답도 CPU 시간에 들어가므로 워밍업 1초를 더해 나눈다.
+                requests += int(float(summary["rps"]) * (args.duration + 1))
+                dropped += dropped_records(args.port)
+            finally:
+                server.terminate()
+                server.wait()
+            if os.path.exists(log_path):
+                log_bytes += os.path.getsize(log_path)
+                os.unlink(log_path)
+        print(f"{name:>10} {statistics.median(rates):>10.0f} {' / '.join('%.0f' % r for r in rates):>24} "
+              f"{statistics.median(p99s):>9.1f} {cpu / max(requests, 1) * 1e6:>18.2f} {dropped:>9} "
+              f"{log_bytes / args.rounds / 1e6:>8.1f}")
+    if not args.log_dir:
+        os.rmdir(log_dir)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
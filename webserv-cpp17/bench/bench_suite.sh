@@ -0,0 +1,60 @@
+#!/usr/bin/env bash
+# webserv-cpp17 v1.19.0 벤치마크 묶음: 요청 경로를 바꿀 때마다 같은 조건으로 다시 재는 기준 부하.
+# - `webserv --unlimited` 를 띄우고 webserv_bench 로 아래 시나리오를 차례로 돌린 뒤 summary 줄을 모아 보여 준다.
+#   (1) /health 폐쇄 루프, 연결 64개
+#   (2) /health 폐쇄 루프, 연결 64개 x 파이프라이닝 16
+#   (3) /health 고정 속도(RATE, 기본 20000 req/s). 지연은 보냈어야 했던 시각부터 잰다.
+#   (4) /metrics 폐쇄 루프, 연결 64개(핸들러가 본문을 만드는 경로)
+# - Release 빌드에서 돌린다. 기본값은 환경 변수(WORKERS, THREADS, DURATION, RATE, PORT)로 바꾼다.
+# 사용법:
+#   bench/bench_suite.sh build/webserv build/webserv_bench
+#   cmake --build build --target webserv_bench_suite
+set -euo pipefail
+
+if [ "$#" -ne 2 ]; then
+  echo "사용법: bench_suite.sh <webserv_binary> <webserv_bench_binary>" >&2
+  exit 1
+fi
+
+binary="$1"
+bench="$2"
+port="${PORT:-9199}"
+workers="${WORKERS:-1}"
+threads="${THREADS:-2}"
+duration="${DURATION:-5}"
+rate="${RATE:-20000}"
+server_pid=""
+log="$(mktemp)"
+summary="$(mktemp)"
+
+cleanup() {
+  if [ -n "$server_pid" ] && kill -0 "$server_pid" 2>/dev/null; then
+    kill "$server_pid"
+    wait "$server_pid" 2>/dev/null || true
+  fi
+  rm -f "$log" "$summary"
+}
+trap cleanup EXIT
+
+"$binary" "$port" --unlimited --workers "$workers" --idle-timeout-ms 60000 2>/dev/null &
+server_pid=$!
+sleep 0.3
+
+# 시나리오 하나를 돌려 전체 출력을 보여 주고, summary 줄은 이름을 붙여 모아 둔다.
+run() {
+  local name="$1"
+  shift
+  echo "== $name"
+  "$bench" --threads "$threads" --duration-sec "$duration" --warmup-sec 1 "$@" "127.0.0.1:$port" > "$log" || true
+  cat "$log"
+  grep '^summary ' "$log" | sed "s/^summary/$name/" >> "$summary" || true
+}
+
+run health-c64 --connections 64
+run health-c64-p16 --connections 64 --pipeline 16
+run health-rate --connections 64 --rate "$rate"
+run metrics-c64 --connections 64 --path /metrics
+
+echo
+echo "요약 (워커 $workers, 부하 스레드 $threads, 시나리오마다 ${duration}초)"
+cat "$summary"
@@ -0,0 +1,181 @@
+/**
+ * [모듈] webserv-cpp17/bench/client_limit_bench.cpp
+ * 설명:
+ *   - 클라이언트 한도 표(ClientLimiter)가 요청과 연결마다 더하는 비용을 잰다.
+ *     - request: 요청마다 하는 일(연결이 들고 있는 칸의 토큰 버킷에서 토큰 하나 꺼내기). 주소 수만 다르게 한다.
+ *     - connect: 연결마다 하는 일(주소 키 해시, 창 탐색, 칸 잡기/가져가기, 닫을 때 내려놓기). 표 채움률을 바꾼다.
+ *     - shared: 스레드 여럿이 같은 칸(주소 하나)과 서로 다른 칸에서 토큰을 꺼낼 때. 같은 칸은 CAS 경합이 생긴다.
+ * 버전: v1.24.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.24.0-client-limits.md
+ * 변경 이력:
+ *   - v1.24.0: 클라이언트 한도 표 조회/토큰 버킷 비용 벤치마크 추가
+ * 사용법:
+ *   - ./build/webserv_client_limit_bench [iterations] [threads]
+ */
+
+#include <netinet/in.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "client_limit.hpp"
+
+namespace {
+
+constexpr std::size_t TABLE = 65536;
+
+double nanosPer(std::chrono::steady_clock::duration elapsed, std::size_t iterations) {
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) /
+           static_cast<double>(iterations);
+}
+
+std::uint64_t keyFor(std::uint32_t address) {
+    sockaddr_storage storage{};
+    auto &in = reinterpret_cast<sockaddr_in &>(storage);
+    in.sin_family = AF_INET;
+    in.sin_addr.s_addr = htonl(address);
+    return clientKey(storage);
+}
+
+std::vector<std::uint64_t> makeKeys(std::size_t count) {
+    std::vector<std::uint64_t> keys(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        // 10.0.0.0/8 에서 연속 주소. 연속 키가 해시 뒤에도 고르게 퍼지는지도 함께 본다.
+        keys[i] = keyFor(0x0a000000u + static_cast<std::uint32_t>(i));
+    }
+    return keys;
+}
+
+// 요청 경로: 주소 clients 개가 칸을 하나씩 잡은 상태에서 무작위 칸의 버킷을 꺼낸다.
+double requestCost(std::size_t iterations, std::size_t clients) {
+    // 초당 10억 요청이면 버킷이 비지 않으므로 거절 분기 없이 CAS 만 잰다.
+    ClientLimiter limiter(TABLE, 1000000000u, 0, 0);
+    std::vector<std::uint64_t> keys = makeKeys(clients);
+    std::vector<std::uint32_t> slots;
+    auto now = std::chrono::steady_clock::now();
+    for (std::uint64_t key : keys) {
+        // 표가 붐벼 칸을 얻지 못한 주소(untracked)는 요청마다 버킷을 보지 않으므로 뺀다.
+        std::uint32_t slot = ClientLimiter::NO_SLOT;
+        if (limiter.admit(key, now, slot) == ClientAdmission::kAdmitted) {
+            slots.push_back(slot);
+        }
+    }
+    std::mt19937_64 random(42);
+    std::vector<std::uint32_t> order(iterations);
+    for (auto &slot : order) {
+        slot = slots[random() % slots.size()];
+    }
+    std::uint32_t retry = 0;
+    std::size_t allowed = 0;
+    auto begin = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        allowed += limiter.allowRequest(order[i], begin, retry) ? 1 : 0;
+    }
+    double ns = nanosPer(std::chrono::steady_clock::now() - begin, iterations);
+    if (allowed == 0) {
+        std::printf("토큰을 하나도 꺼내지 못했습니다\n");
+    }
+    return ns;
+}
+
+struct ConnectResult {
+    double ns = 0.0;
+    double untracked = 0.0;
+};
+
+// 연결 경로: 주소 clients 개 중 하나가 연결을 열고 바로 닫기를 반복한다. 키는 표 크기보다 많을 수 있다.
+ConnectResult connectCost(std::size_t iterations, std::size_t clients) {
+    ClientLimiter limiter(TABLE, 0, 0, 64);
+    std::vector<std::uint64_t> keys = makeKeys(clients);
+    std::mt19937_64 random(7);
+    std::vector<std::uint32_t> order(iterations);
+    for (auto &index : order) {
+        index = static_cast<std::uint32_t>(random() % clients);
+    }
+    // 모든 주소를 한 번씩 넣어 표를 채운 상태에서 잰다. 연결을 들고 있지 않은 칸은 가져갈 수 있다.
+    auto now = std::chrono::steady_clock::now();
+    for (std::uint64_t key : keys) {
+        std::uint32_t slot = ClientLimiter::NO_SLOT;
+        if (limiter.admit(key, now, slot) == ClientAdmission::kAdmitted) {
+            limiter.release(slot);
+        }
+    }
+    std::size_t untracked = 0;
+    auto begin = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        std::uint32_t slot = ClientLimiter::NO_SLOT;
+        if (limiter.admit(keys[order[i]], begin, slot) == ClientAdmission::kAdmitted) {
+            limiter.release(slot);
+        } else {
+            ++untracked;
+        }
+    }
+    ConnectResult result;
+    result.ns = nanosPer(std::chrono::steady_clock::now() - begin, iterations);
+    result.untracked = static_cast<double>(untracked) / static_cast<double>(iterations);
+    return result;
+}
+
+// 여러 스레드가 동시에 버킷을 꺼낸다. same 이면 모두 같은 칸, 아니면 스레드마다 다른 칸이다.
+double sharedCost(std::size_t iterations, std::size_t threads, bool same) {
+    ClientLimiter limiter(TABLE, 1000000000u, 0, 0);
+    std::vector<std::uint32_t> slots(threads);
+    auto now = std::chrono::steady_clock::now();
+    for (std::size_t t = 0; t < threads; ++t) {
+        limiter.admit(keyFor(0x0a000000u + static_cast<std::uint32_t>(same ? 0 : t)), now, slots[t]);
+    }
+    std::atomic<bool> go{false};
+    std::vector<std::thread> workers;
+    for (std::size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            while (!go.load(std::memory_order_acquire)) {
+            }
+            std::uint32_t retry = 0;
+            for (std::size_t i = 0; i < iterations; ++i) {
+                limiter.allowRequest(slots[t], now, retry);
+            }
+        });
+    }
+    auto begin = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    // 전체 처리량 기준: 꺼낸 토큰 하나당 벽시계 시간.
+    return nanosPer(std::chrono::steady_clock::now() - begin, iterations * threads);
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+    std::size_t iterations = argc >= 2 ? std::strtoul(argv[1], nullptr, 10) : 5000000;
+    std::size_t threads = argc >= 3 ? std::strtoul(argv[2], nullptr, 10) : 2;
+    if (threads == 0) {
+        threads = 1;
+    }
+
+    std::printf("요청 %zu회, 표 %zu칸\n", iterations, TABLE);
+    std::printf("%10s %12s\n", "clients", "ns/request");
+    for (std::size_t clients : {1ul, 1000ul, 60000ul}) {
+        std::printf("%10zu %12.1f\n", clients, requestCost(iterations, clients));
+    }
+
+    std::printf("%10s %12s %12s\n", "clients", "ns/connect", "untracked");
+    for (std::size_t clients : {1000ul, 32768ul, 60000ul, 200000ul}) {
+        ConnectResult result = connectCost(iterations, clients);
+        std::printf("%10zu %12.1f %11.2f%%\n", clients, result.ns, result.untracked * 100.0);
+    }
+
+    std::printf("스레드 %zu개 (하드웨어 스레드 %u개)\n", threads, std::thread::hardware_concurrency());
+    std::printf("%10s %12s\n", "slot", "ns/request");
+    std::printf("%10s %12.1f\n", "same", sharedCost(iterations, threads, true));
+    std::printf("%10s %12.1f\n", "distinct", sharedCost(iterations, threads, false));
+    return 0;
+}
@@ -0,0 +1,95 @@
+#!/usr/bin/env python3
+# webserv-cpp17 v1.24.0 벤치마크: 한 주소가 폭주할 때 다른 주소의 정상 클라이언트가 받는 지연(p99)을 잰다.
+# - flooder: `webserv_bench` 폐쇄 루프를 127.0.0.2 에서 보낸다(연결 여럿, 파이프라이닝).
+# - 정상 클라이언트: `webserv_bench --rate` 고정 속도를 127.0.0.1 에서 보낸다. 지연은 보냈어야 했던 시각부터 잰다.
+# - 설정(variant)마다 서버를 새로 띄운다. quiet 는 flooder 없이 정상 클라이언트만 보낸 기준선이다.
+# - good_non2xx 가 0 이 아니면 정상 클라이언트도 거절(429/503)을 받은 것이다. flood_shed% 는 flooder 응답 중
+#   2xx 가 아닌 비율이다.
+# 사용법:
+#   python3 bench/client_limit_bench.py build/webserv build/webserv_bench --duration 5 --rounds 3
+#   python3 bench/client_limit_bench.py build/webserv build/webserv_bench --variant 'rate=--client-rate 500'
+import argparse
+import statistics
+import subprocess
+import sys
+import time
+
+DEFAULT_VARIANTS = [
+    "quiet=",
+    "flood=",
+    "rate=--client-rate 2000",
+    "conns=--client-connections 8",
+    "overload=--overload-lag-ms 2",
+]
+
+
+def summary_of(output):
+    return dict(item.split("=", 1) for item in output.splitlines()[-1].split()[1:])
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("binary")
+    parser.add_argument("bench")
+    parser.add_argument("--port", type=int, default=9194)
+    parser.add_argument("--workers", type=int, default=1)
+    parser.add_argument("--duration", type=int, default=5)
+    parser.add_argument("--rounds", type=int, default=3)
+    parser.add_argument("--good-rate", type=int, default=200, help="정상 클라이언트의 초당 요청 수")
+    parser.add_argument("--good-connections", type=int, default=4)
+    parser.add_argument("--flood-connections", type=int, default=128)
+    parser.add_argument("--flood-pipeline", type=int, default=8)
+    parser.add_argument("--variant", action="append", help="NAME=서버 옵션, 여러 번 줄 수 있다")
+    args = parser.parse_args()
+
+    target = f"127.0.0.1:{args.port}"
+    print(f"{'variant':>9} {'good_p50_us':>12} {'good_p99_us':>12} {'rounds':>26} {'good_non2xx':>12} "
+          f"{'flood_rps':>10} {'flood_shed%':>12}")
+    for variant in args.variant or DEFAULT_VARIANTS:
+        name, _, options = variant.partition("=")
+        p50s, p99s, good_non2xx, flood_rates, flood_shed = [], [], 0, [], []
+        for _ in range(args.rounds):
+            server = subprocess.Popen(
+                [args.binary, str(args.port), "--unlimited", "--workers", str(args.workers),
+                 "--idle-timeout-ms", "60000"] + options.split(),
+                stderr=subprocess.DEVNULL)
+            flood = None
+            try:
+                time.sleep(0.3)
+                if name != "quiet":
+                    flood = subprocess.Popen(
+                        [args.bench, "--bind", "127.0.0.2", "--threads", "1",
+                         "--connections", str(args.flood_connections), "--pipeline", str(args.flood_pipeline),
+                         "--duration-sec", str(args.duration), "--warmup-sec", "1", target],
+                        stdout=subprocess.PIPE, text=True)
+                    # flooder 가 연결을 다 열고 루프가 밀리기 시작한 뒤에 정상 클라이언트를 붙인다.
+                    time.sleep(0.5)
+                good = subprocess.run(
+                    [args.bench, "--bind", "127.0.0.1", "--threads", "1",
+                     "--connections", str(args.good_connections), "--rate", str(args.good_rate),
+                     "--duration-sec", str(args.duration - 1), "--warmup-sec", "0", target],
+                    check=True, capture_output=True, text=True).stdout
+                summary = summary_of(good)
+                p50s.append(float(summary["p50_us"]))
+                p99s.append(float(summary["p99_us"]))
+                good_non2xx += int(summary["non2xx"]) + int(summary["errors"])
+                if flood is not None:
+                    flood_summary = summary_of(flood.communicate()[0])
+                    requests = int(flood_summary["requests"])
+                    flood_rates.append(float(flood_summary["rps"]))
+                    flood_shed.append(int(flood_summary["non2xx"]) / max(requests, 1) * 100.0)
+            finally:
+                if flood is not None and flood.poll() is None:
+                    flood.kill()
+                    flood.wait()
+                server.terminate()
+                server.wait()
+        flood_rps = f"{statistics.median(flood_rates):.0f}" if flood_rates else "-"
+        shed = f"{statistics.median(flood_shed):.1f}" if flood_shed else "-"
+        print(f"{name:>9} {statistics.median(p50s):>12.1f} {statistics.median(p99s):>12.1f} "
+              f"{' / '.join('%.0f' % p for p in p99s):>26} {good_non2xx:>12} {flood_rps:>10} {shed:>12}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,112 @@
+/**
+ * [모듈] webserv-cpp17/bench/compression_bench.cpp
+ * 설명:
+ *   - 텍스트 응답 하나를 만드는 비용을 압축 방식별로 비교한다.
+ *     - identity: 본문을 그대로 writeResponse 로 출력 큐에 직렬화한다.
+ *     - gzip/deflate 요청마다 압축: 워커의 Compressor(스트림 재사용)로 본문을 압축한 뒤 직렬화한다.
+ *     - 압축본 캐시 복사: 미리 압축해 둔 본문을 헤더 뒤에 복사한다(정적 파일 캐시 적중 경로).
+ *   - 본문은 HTML 과 비슷하게 반복이 섞인 텍스트다. 크기는 인자로 바꿀 수 있다.
+ * 버전: v1.14.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.14.0-response-compression.md
+ * 변경 이력:
+ *   - v1.14.0: 응답 압축 비용 벤치마크 추가
+ * 사용법:
+ *   - ./build/webserv_compression_bench [iterations] [body_bytes]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "compression.hpp"
+#include "http_message.hpp"
+#include "io_buffer.hpp"
+
+namespace {
+
+// 태그와 문장이 반복되지만 줄마다 번호가 달라 완전히 같은 줄은 없는 본문.
+std::string makeBody(std::size_t bytes) {
+    static const char *const WORDS[] = {"worker", "event", "socket", "buffer", "request", "response", "cache"};
+    std::string body;
+    body.reserve(bytes + 128);
+    for (std::size_t line = 0; body.size() < bytes; ++line) {
+        body += "<li class=\"item\"><a href=\"/items/";
+        body += std::to_string(line * 7919 % 100003);
+        body += "\">";
+        for (std::size_t w = 0; w < 6; ++w) {
+            body += WORDS[(line + w * 3) % 7];
+            body += ' ';
+        }
+        body += "</a></li>\n";
+    }
+    body.resize(bytes);
+    return body;
+}
+
+template <typename Fn>
+double nanosPerResponse(std::size_t iterations, Fn &&fn) {
+    auto begin = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        fn();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) /
+           static_cast<double>(iterations);
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+    std::size_t iterations = argc >= 2 ? std::strtoul(argv[1], nullptr, 10) : 20000;
+    std::size_t body_bytes = argc >= 3 ? std::strtoul(argv[2], nullptr, 10) : 16 * 1024;
+    std::string body = makeBody(body_bytes);
+    std::size_t checksum = 0;
+
+    ResponseTemplates templates;
+    OutputQueue output;
+    double identity_ns = nanosPerResponse(iterations, [&] {
+        writeResponse(output, 200, {body}, true, templates.dateLine(), codingHeaders(ContentCoding::kIdentity));
+        checksum += output.bytes();
+        output.clear();
+    });
+
+    auto perRequest = [&](int level, ContentCoding coding, std::size_t &compressed_size) {
+        Compressor compressor(level);
+        double ns = nanosPerResponse(iterations, [&] {
+            compressor.compress(coding, {body});
+            writeResponse(output, 200, {compressor.output()}, true, templates.dateLine(), codingHeaders(coding));
+            checksum += output.bytes();
+            output.clear();
+        });
+        compressed_size = compressor.output().size();
+        return ns;
+    };
+    std::size_t gzip1_size = 0;
+    std::size_t gzip6_size = 0;
+    std::size_t deflate6_size = 0;
+    double gzip1_ns = perRequest(1, ContentCoding::kGzip, gzip1_size);
+    double gzip6_ns = perRequest(6, ContentCoding::kGzip, gzip6_size);
+    double deflate6_ns = perRequest(6, ContentCoding::kDeflate, deflate6_size);
+
+    Compressor compressor(6);
+    compressor.compress(ContentCoding::kGzip, {body});
+    std::string cached(compressor.output());
+    double cached_ns = nanosPerResponse(iterations, [&] {
+        writeFileResponseHeader(output, cached.size(), "text/html; charset=utf-8", "\"1-2-gzip\"", true,
+                                templates.dateLine(), codingHeaders(ContentCoding::kGzip));
+        output.append(cached);
+        checksum += output.bytes();
+        output.clear();
+    });
+
+    std::printf("본문 %zu바이트, 응답 %zu개 (checksum %zu)\n", body.size(), iterations, checksum);
+    std::printf("%28s %12s %12s\n", "encoder", "ns/resp", "body bytes");
+    std::printf("%28s %12.1f %12zu\n", "identity", identity_ns, body.size());
+    std::printf("%28s %12.1f %12zu\n", "gzip level 1 per request", gzip1_ns, gzip1_size);
+    std::printf("%28s %12.1f %12zu\n", "gzip level 6 per request", gzip6_ns, gzip6_size);
+    std::printf("%28s %12.1f %12zu\n", "deflate level 6 per request", deflate6_ns, deflate6_size);
+    std::printf("%28s %12.1f %12zu\n", "precompressed cache copy", cached_ns, cached.size());
+    return 0;
+}
@@ -0,0 +1,191 @@
+#!/usr/bin/env python3
+# webserv-cpp17 v1.20.0 벤치마크: 연결 폭주(connect storm) 중 수락 경로의 손실과 기존 연결의 지연을 측정한다.
+# - 서버 설정(variant)마다 서버를 새로 띄우고, keep-alive 프로브 연결이 /health 를 계속 보내는 동안
+#   논블로킹 connect 를 한꺼번에 storm 개 걸어 각 연결이 첫 응답을 받기까지의 시간을 잰다.
+# - 리슨 대기열이 넘쳐 버려진 SYN/ACK 는 클라이언트 재전송(1초~)으로 이어지므로 storm_p99/max 와 slow(>=0.9s)에 드러난다.
+#   커널 계수 TcpExtListenOverflows/ListenDrops 의 증가분도 함께 보인다(시스템 전체 값이라 다른 부하가 없을 때 읽는다).
+# - probe_p99/max 는 폭주를 받는 동안 이미 맺은 연결의 요청이 얼마나 밀렸는지다.
+# - server_cpu_us/conn 은 폭주 한 번에 쓴 서버 CPU 시간을 연결 수로 나눈 값이다. 프로브 처리도 들어가므로
+#   수락 경로만 비교할 때는 --probes 0 으로 돌린다.
+# 사용법:
+#   python3 bench/connect_storm_bench.py build/webserv --storm 2000 --rounds 3
+#   python3 bench/connect_storm_bench.py build/webserv --variant 'small=--listen-backlog 16' --variant 'tuned='
+import argparse
+import multiprocessing
+import resource
+import selectors
+import socket
+import subprocess
+import sys
+import time
+
+REQUEST = b"GET /health HTTP/1.1\r\nHost: storm\r\n\r\n"
+DEFAULT_VARIANTS = [
+    "backlog16=--listen-backlog 16 --accept-batch 0",
+    "backlog4096=--listen-backlog 4096 --accept-batch 0",
+    "batch64=--listen-backlog 4096 --accept-batch 64",
+    "batch64-defer=--listen-backlog 4096 --accept-batch 64 --defer-accept-sec 1",
+]
+
+
+def cpu_seconds(pid):
+    with open(f"/proc/{pid}/schedstat") as f:
+        return int(f.read().split()[0]) / 1e9
+
+
+def listen_counters():
+    with open("/proc/net/netstat") as f:
+        lines = f.read().splitlines()
+    for names, values in zip(lines[::2], lines[1::2]):
+        if names.startswith("TcpExt:"):
+            table = dict(zip(names.split()[1:], (int(v) for v in values.split()[1:])))
+            return table.get("ListenOverflows", 0), table.get("ListenDrops", 0)
+    return 0, 0
+
+
+def percentile(values, fraction):
+    if not values:
+        return 0.0
+    ordered = sorted(values)
+    return ordered[min(len(ordered) - 1, int(fraction * len(ordered)))]
+
+
+def probe_loop(port, probes, stop, out):
+    # 폭주를 거는 프로세스와 따로 돌아야 폭주 클라이언트의 connect 루프가 프로브 지연에 섞이지 않는다.
+    sel = selectors.DefaultSelector()
+    for _ in range(probes):
+        s = socket.create_connection(("127.0.0.1", port))
+        s.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        s.setblocking(False)
+        s.send(REQUEST)
+        sel.register(s, selectors.EVENT_READ, [time.perf_counter(), b""])
+    latency = []
+    while not stop.is_set():
+        for key, _ in sel.select(timeout=0.05):
+            s, state = key.fileobj, key.data
+            state[1] += s.recv(65536)
+            if b"status: ok" in state[1]:
+                now = time.perf_counter()
+                latency.append(now - state[0])
+                state[0], state[1] = now, b""
+                s.send(REQUEST)
+    out.send(latency)
+
+
+def storm_round(port, storm, probes, timeout):
+    sel = selectors.DefaultSelector()
+    stop = multiprocessing.Event()
+    receiver, sender = multiprocessing.Pipe(False)
+    prober = None
+    if probes > 0:
+        prober = multiprocessing.Process(target=probe_loop, args=(port, probes, stop, sender))
+        prober.start()
+        time.sleep(0.2)
+
+    begin = time.perf_counter()
+    for _ in range(storm):
+        s = socket.socket()
+        s.setblocking(False)
+        s.connect_ex(("127.0.0.1", port))
+        sel.register(s, selectors.EVENT_WRITE, ["connect", time.perf_counter(), b""])
+
+    storm_latency = []
+    failed = 0
+    remaining = storm
+    deadline = begin + timeout
+    while remaining > 0 and time.perf_counter() < deadline:
+        for key, _ in sel.select(timeout=0.05):
+            s, state = key.fileobj, key.data
+            now = time.perf_counter()
+            if state[0] == "connect":
+                try:
+                    s.send(REQUEST)
+                except OSError:
+                    failed += 1
+                    remaining -= 1
+                    sel.unregister(s)
+                    s.close()
+                    continue
+                state[0] = "storm"
+                sel.modify(s, selectors.EVENT_READ, state)
+                continue
+            try:
+                chunk = s.recv(65536)
+            except OSError:
+                chunk = b""
+            state[2] += chunk
+            if b"status: ok" not in state[2]:
+                if not chunk:
+                    sel.unregister(s)
+                    s.close()
+                    failed += 1
+                    remaining -= 1
+                continue
+            storm_latency.append(now - state[1])
+            remaining -= 1
+            sel.unregister(s)
+            s.close()
+    elapsed = time.perf_counter() - begin
+    failed += remaining
+    for key in list(sel.get_map().values()):
+        key.fileobj.close()
+    probe_latency = []
+    if prober is not None:
+        stop.set()
+        probe_latency = receiver.recv()
+        prober.join()
+    return storm_latency, probe_latency, failed, elapsed
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("binary")
+    parser.add_argument("--port", type=int, default=9195)
+    parser.add_argument("--storm", type=int, default=2000, help="한 번에 거는 connect 수")
+    parser.add_argument("--probes", type=int, default=4, help="폭주 중 요청을 보내는 keep-alive 연결 수")
+    parser.add_argument("--rounds", type=int, default=3)
+    parser.add_argument("--timeout", type=float, default=10.0)
+    parser.add_argument("--variant", action="append", help="NAME=서버 옵션, 여러 번 줄 수 있다")
+    args = parser.parse_args()
+
+    soft, hard = resource.getrlimit(resource.RLIMIT_NOFILE)
+    resource.setrlimit(resource.RLIMIT_NOFILE, (hard, hard))
+
+    print(f"{'variant':>14} {'conn/s':>8} {'storm_p50_ms':>12} {'storm_p99_ms':>12} {'storm_max_ms':>12} "
+          f"{'slow':>5} {'failed':>6} {'overflows':>9} {'probe_p99_ms':>12} {'probe_max_ms':>12} "
+          f"{'server_cpu_us/conn':>18}")
+    for variant in args.variant or DEFAULT_VARIANTS:
+        name, _, options = variant.partition("=")
+        server = subprocess.Popen(
+            [args.binary, str(args.port), "--unlimited", "--workers", "1", "--idle-timeout-ms", "60000"]
+            + options.split(),
+            stderr=subprocess.DEVNULL)
+        try:
+            time.sleep(0.3)
+            storm_latency, probe_latency, failed, elapsed, cpu = [], [], 0, 0.0, 0.0
+            overflows_before = sum(listen_counters())
+            for _ in range(args.rounds):
+                cpu_before = cpu_seconds(server.pid)
+                s_lat, p_lat, f, e = storm_round(args.port, args.storm, args.probes, args.timeout)
+                cpu += cpu_seconds(server.pid) - cpu_before
+                storm_latency += s_lat
+                probe_latency += p_lat
+                failed += f
+                elapsed += e
+                # 서버 쪽 TIME_WAIT 과 닫힌 연결 정리를 기다린다.
+                time.sleep(0.5)
+            overflows = sum(listen_counters()) - overflows_before
+            done = len(storm_latency)
+            slow = sum(1 for value in storm_latency if value >= 0.9)
+            print(f"{name:>14} {done / elapsed:>8.0f} {percentile(storm_latency, 0.5) * 1e3:>12.2f} "
+                  f"{percentile(storm_latency, 0.99) * 1e3:>12.2f} {max(storm_latency, default=0) * 1e3:>12.2f} "
+                  f"{slow:>5} {failed:>6} {overflows:>9} {percentile(probe_latency, 0.99) * 1e3:>12.2f} "
+                  f"{max(probe_latency, default=0) * 1e3:>12.2f} {cpu / max(done, 1) * 1e6:>18.2f}")
+        finally:
+            server.kill()
+            server.wait()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,94 @@
+#!/usr/bin/env python3
+# webserv-cpp17 v1.9.0 벤치마크: 연결 교체(connect -> 요청 하나 -> 서버가 닫음) 속도와 연결당 서버 CPU 시간을 측정한다.
+# - concurrency 개의 논블로킹 클라이언트가 각자 연결을 열고 `Connection: close` 요청을 보낸 뒤,
+#   서버가 연결을 닫으면(EOF) 곧바로 새 연결을 연다.
+# - 서버가 먼저 닫으므로 TIME_WAIT 은 서버 쪽에 쌓여 클라이언트 에페메럴 포트가 고갈되지 않는다.
+# - 연결 테이블 삽입/삭제와 연결별 버퍼 할당 비용은 server_cpu_us/conn 에 드러난다.
+# 사용법:
+#   python3 bench/connection_churn_bench.py build/webserv --concurrency 1,16,64 --duration 5
+import argparse
+import errno
+import selectors
+import socket
+import subprocess
+import sys
+import time
+
+REQUEST = b"GET /health HTTP/1.1\r\nHost: bench\r\nConnection: close\r\n\r\n"
+
+
+def cpu_seconds(pid):
+    with open(f"/proc/{pid}/schedstat") as f:
+        return int(f.read().split()[0]) / 1e9
+
+
+def open_client(sel, port):
+    s = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    s.setblocking(False)
+    s.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+    code = s.connect_ex(("127.0.0.1", port))
+    if code not in (0, errno.EINPROGRESS):
+        raise RuntimeError(f"connect 실패: {errno.errorcode.get(code, code)}")
+    sel.register(s, selectors.EVENT_WRITE, False)
+
+
+def run_level(port, concurrency, duration):
+    sel = selectors.DefaultSelector()
+    for _ in range(concurrency):
+        open_client(sel, port)
+    completed = 0
+    deadline = time.perf_counter() + duration
+    while time.perf_counter() < deadline:
+        for key, _ in sel.select(timeout=0.1):
+            s = key.fileobj
+            if not key.data:
+                # 연결이 성립하면 요청을 보내고 응답(EOF 까지)을 기다린다.
+                s.send(REQUEST)
+                sel.modify(s, selectors.EVENT_READ, True)
+                continue
+            try:
+                chunk = s.recv(65536)
+            except ConnectionResetError:
+                chunk = b""
+            if chunk:
+                continue
+            sel.unregister(s)
+            s.close()
+            completed += 1
+            open_client(sel, port)
+    for key in list(sel.get_map().values()):
+        key.fileobj.close()
+    return completed
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("binary")
+    parser.add_argument("--port", type=int, default=9194)
+    parser.add_argument("--concurrency", default="1,16,64")
+    parser.add_argument("--duration", type=float, default=5.0)
+    args = parser.parse_args()
+
+    print(f"{'clients':>8} {'conn/s':>10} {'server_cpu_us/conn':>19}")
+    for level in [int(x) for x in args.concurrency.split(",")]:
+        server = subprocess.Popen(
+            [args.binary, str(args.port), "1000000000", "--idle-timeout-ms", "60000", "--max-runtime-sec", "0"],
+            stderr=subprocess.DEVNULL)
+        try:
+            time.sleep(0.3)
+            run_level(args.port, level, 0.5)  # 워밍업
+            cpu_before = cpu_seconds(server.pid)
+            begin = time.perf_counter()
+            completed = run_level(args.port, level, args.duration)
+            elapsed = time.perf_counter() - begin
+            cpu_after = cpu_seconds(server.pid)
+            per_conn = (cpu_after - cpu_before) / completed * 1e6
+            print(f"{level:>8} {completed / elapsed:>10.0f} {per_conn:>19.2f}")
+        finally:
+            server.kill()
+            server.wait()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,108 @@
+/**
+ * [모듈] webserv-cpp17/bench/connection_pool_bench.cpp
+ * 설명:
+ *   - 연결 하나를 열고 닫는 데 드는 연결 테이블 비용(삽입, 조회, 첫 수신 버퍼 사용, 삭제)을
+ *     v1.8.0 의 FD 키 해시 테이블(std::unordered_map<int, Connection>)과 v1.9.0 의 슬랩 연결 풀로 비교한다.
+ *   - live 개의 연결이 열려 있는 상태에서 무작위 연결 하나를 닫고 새 연결 하나를 여는 교체를 반복한다.
+ * 버전: v1.9.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.9.0-connection-pool.md
+ * 변경 이력:
+ *   - v1.9.0: 연결 테이블 교체 비용 벤치마크 추가
+ * 사용법:
+ *   - ./build/webserv_connection_pool_bench [iterations] [live_connections]
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "connection_pool.hpp"
+
+namespace {
+
+const char REQUEST[] = "GET /health HTTP/1.1\r\nHost: bench\r\nConnection: close\r\n\r\n";
+
+// 연결마다 한 번은 하는 일: 요청을 입력 버퍼에 받고, 파싱 후 응답을 출력 큐에 넣는다.
+void touch(Connection &conn) {
+    char *destination = conn.input.prepare(4096);
+    std::memcpy(destination, REQUEST, sizeof(REQUEST) - 1);
+    conn.input.commit(sizeof(REQUEST) - 1);
+    conn.parser.parse(conn.input.data(), conn.input.size());
+    conn.output.append("HTTP/1.1 200 OK\r\nContent-Length: 11\r\n\r\nstatus: ok\n");
+    conn.in_flight.push_back(PendingResponse{conn.output.pushedTotal(), std::chrono::steady_clock::time_point()});
+}
+
+double nanosPer(std::chrono::steady_clock::duration elapsed, std::size_t iterations) {
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) /
+           static_cast<double>(iterations);
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+    std::size_t iterations = argc >= 2 ? std::strtoul(argv[1], nullptr, 10) : 2000000;
+    std::size_t live = argc >= 3 ? std::strtoul(argv[2], nullptr, 10) : 1000;
+    if (live == 0) {
+        live = 1;
+    }
+
+    // 두 방식이 같은 순서로 연결을 고르도록 닫을 위치를 미리 뽑아 둔다.
+    std::mt19937_64 random(42);
+    std::vector<std::uint32_t> victims(iterations);
+    for (auto &victim : victims) {
+        victim = static_cast<std::uint32_t>(random() % live);
+    }
+
+    double map_ns = 0.0;
+    {
+        std::unordered_map<int, Connection> table;
+        std::vector<int> open;
+        int next_fd = 3;
+        for (std::size_t i = 0; i < live; ++i) {
+            table.try_emplace(next_fd).first->second.fd = next_fd;
+            open.push_back(next_fd++);
+        }
+        auto begin = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < iterations; ++i) {
+            // 커널처럼 가장 작은 빈 FD 를 재사용한다.
+            int fd = open[victims[i]];
+            table.erase(fd);
+            Connection &conn = table.try_emplace(fd).first->second;
+            conn.fd = fd;
+            touch(table.find(fd)->second);
+        }
+        map_ns = nanosPer(std::chrono::steady_clock::now() - begin, iterations);
+    }
+
+    double pool_ns = 0.0;
+    {
+        ConnectionPool pool;
+        std::vector<std::uint64_t> open;
+        for (std::size_t i = 0; i < live; ++i) {
+            open.push_back(pool.acquire(static_cast<int>(i + 3)).handle);
+        }
+        auto begin = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < iterations; ++i) {
+            std::uint64_t &handle = open[victims[i]];
+            Connection *old = pool.find(handle);
+            int fd = old->fd;
+            pool.release(*old);
+            Connection &conn = pool.acquire(fd);
+            handle = conn.handle;
+            touch(*pool.find(handle));
+        }
+        pool_ns = nanosPer(std::chrono::steady_clock::now() - begin, iterations);
+    }
+
+    std::printf("교체 %zu회, 열린 연결 %zu개\n", iterations, live);
+    std::printf("%28s %14s\n", "table", "ns/churn");
+    std::printf("%28s %14.1f\n", "unordered_map<int, Conn>", map_ns);
+    std::printf("%28s %14.1f\n", "ConnectionPool (slab)", pool_ns);
+    return 0;
+}
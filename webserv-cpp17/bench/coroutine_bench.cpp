@@ -0,0 +1,198 @@
+/**
+ * [모듈] webserv-cpp17/bench/coroutine_bench.cpp
+ * 설명:
+ *   - 본문 조각 몇 개와 타이머 하나를 기다리는 핸들러 하나를 두 방식으로 돌려 비교한다.
+ *     - 콜백 체인: 요청 상태를 shared_ptr 로 잡고, 기다릴 때마다 다음 단계를 std::function 으로 넘긴다.
+ *     - 코루틴: coroutine.hpp 의 Coroutine 을 연결의 FrameArena 에 만들고 resume 을 되풀이한다.
+ *   - 재개 한 번의 시간, 멈춘 요청 하나가 붙잡는 힙 바이트, 요청당 힙 할당 횟수를 낸다.
+ *     할당은 전역 operator new 를 바꿔 센다.
+ * 버전: v1.18.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.18.0-coroutine-handlers.md
+ * 변경 이력:
+ *   - v1.18.0: 코루틴/콜백 재개 비용 벤치마크 추가
+ * 사용법:
+ *   - ./build/webserv_coroutine_bench [requests] [slices]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+
+#include "coroutine.hpp"
+
+namespace {
+
+std::size_t g_allocations = 0;
+std::size_t g_allocated_bytes = 0;
+
+}  // namespace
+
+void *operator new(std::size_t size) {
+    ++g_allocations;
+    g_allocated_bytes += size;
+    if (void *memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept { std::free(memory); }
+void operator delete(void *memory, std::size_t) noexcept { std::free(memory); }
+
+namespace {
+
+const std::string_view SLICE = "0123456789abcdef0123456789abcdef";
+
+// 이벤트 루프가 다음에 부를 것. 콜백 방식은 한 번에 하나만 걸려 있다.
+struct CallbackLoop {
+    std::function<void(std::string_view, bool)> on_body;
+    std::function<void()> on_timer;
+};
+
+// 콜백 체인 핸들러: 본문을 모으고, 끝나면 타이머를 기다린 뒤 응답 길이를 남긴다.
+struct CallbackState {
+    std::string body;
+    std::size_t slices = 0;
+    int status = 0;
+};
+
+void readNext(CallbackLoop &loop, std::shared_ptr<CallbackState> state) {
+    loop.on_body = [&loop, state](std::string_view slice, bool end) {
+        if (!end) {
+            state->body.append(slice.data(), slice.size());
+            ++state->slices;
+            readNext(loop, state);
+            return;
+        }
+        loop.on_timer = [state]() { state->status = 200; };
+    };
+}
+
+// 같은 일을 하는 코루틴 핸들러.
+class BenchHandler final : public Coroutine {
+ public:
+    CoStep resume(CoContext &co) override {
+        CO_BEGIN;
+        while (true) {
+            CO_AWAIT(co.readBody());
+            if (co.body_end) {
+                break;
+            }
+            co.body.append(co.slice.data(), co.slice.size());
+            ++slices_;
+        }
+        CO_AWAIT(co.sleep(0));
+        CO_RETURN(200);
+        CO_END;
+    }
+
+ private:
+    std::size_t slices_ = 0;
+};
+
+double nanosPer(std::chrono::steady_clock::duration elapsed, std::size_t iterations) {
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) /
+           static_cast<double>(iterations);
+}
+
+struct Result {
+    double ns_per_resume = 0.0;
+    double allocations_per_request = 0.0;
+    std::size_t suspended_bytes = 0;
+};
+
+Result runCallbacks(std::size_t requests, std::size_t slices) {
+    CallbackLoop loop;
+    Result result;
+    // 첫 요청이 멈춘 동안 붙잡은 바이트(본문 버퍼 제외)를 잰다.
+    {
+        std::size_t before = g_allocated_bytes;
+        readNext(loop, std::make_shared<CallbackState>());
+        result.suspended_bytes = g_allocated_bytes - before;
+        loop.on_body(std::string_view(), true);
+        loop.on_timer();
+        loop.on_body = nullptr;
+        loop.on_timer = nullptr;
+    }
+    std::size_t allocations = g_allocations;
+    auto begin = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < requests; ++i) {
+        auto state = std::make_shared<CallbackState>();
+        readNext(loop, state);
+        for (std::size_t s = 0; s < slices; ++s) {
+            loop.on_body(SLICE, false);
+        }
+        loop.on_body(std::string_view(), true);
+        loop.on_timer();
+        if (state->status != 200 || state->slices != slices) {
+            std::abort();
+        }
+        loop.on_body = nullptr;
+        loop.on_timer = nullptr;
+    }
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+    result.ns_per_resume = nanosPer(elapsed, requests * (slices + 2));
+    result.allocations_per_request =
+        static_cast<double>(g_allocations - allocations) / static_cast<double>(requests);
+    return result;
+}
+
+Result runCoroutines(std::size_t requests, std::size_t slices) {
+    CoContext co;
+    Result result;
+    // 워밍업 요청으로 아레나와 본문 버퍼 용량을 잡아 둔 뒤, 같은 연결에서 요청을 되풀이한다.
+    std::size_t allocations = 0;
+    auto begin = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i <= requests; ++i) {
+        if (i == 1) {
+            allocations = g_allocations;
+            begin = std::chrono::steady_clock::now();
+        }
+        co.frame = co.arena.create<BenchHandler>();
+        co.wait = co.frame->resume(co).wait;
+        result.suspended_bytes = co.arena.used();
+        for (std::size_t s = 0; s < slices; ++s) {
+            co.slice = SLICE;
+            co.wait = co.frame->resume(co).wait;
+        }
+        co.body_end = true;
+        co.wait = co.frame->resume(co).wait;
+        CoStep done = co.frame->resume(co);
+        if (done.wait != CoWait::kDone || done.value != 200 || co.body.size() != slices * SLICE.size()) {
+            std::abort();
+        }
+        co.reset();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+    result.ns_per_resume = nanosPer(elapsed, requests * (slices + 2));
+    result.allocations_per_request =
+        static_cast<double>(g_allocations - allocations) / static_cast<double>(requests);
+    return result;
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+    std::size_t requests = argc >= 2 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+    std::size_t slices = argc >= 3 ? std::strtoul(argv[2], nullptr, 10) : 4;
+    if (requests == 0) {
+        requests = 1;
+    }
+
+    Result callbacks = runCallbacks(requests, slices);
+    Result coroutines = runCoroutines(requests, slices);
+
+    std::printf("요청 %zu개, 요청당 본문 조각 %zu개 + 타이머 1회\n", requests, slices);
+    std::printf("%28s %14s %18s %14s\n", "handler", "ns/resume", "suspended bytes", "allocs/req");
+    std::printf("%28s %14.1f %18zu %14.2f\n", "shared_ptr + std::function", callbacks.ns_per_resume,
+                callbacks.suspended_bytes, callbacks.allocations_per_request);
+    std::printf("%28s %14.1f %18zu %14.2f\n", "Coroutine + FrameArena", coroutines.ns_per_resume,
+                coroutines.suspended_bytes, coroutines.allocations_per_request);
+    return 0;
+}
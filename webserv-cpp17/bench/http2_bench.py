@@ -0,0 +1,244 @@
+#!/usr/bin/env python3
+# webserv-cpp17 v1.23.0 벤치마크: 같은 요청을 HTTP/1.1 과 HTTP/2(prior knowledge) 로 보내 비교한다.
+# - small: `/health` 를 연결 하나로 반복한다. HTTP/1.1 은 파이프라이닝 깊이 D, HTTP/2 는 동시 스트림 D 개.
+#   req/s 는 파이썬 클라이언트에 묶이므로 서버 쪽 비용은 server_cpu_us/req, 헤더 압축 효과는 응답당 수신 바이트로 본다.
+# - fanout: `/delay/50` N 개를 한꺼번에 보낸다. HTTP/1.1 은 연결 N 개, HTTP/2 는 연결 하나의 스트림 N 개.
+#   두 방식 모두 작업 스레드 수(--handler-threads)만큼 겹쳐 돌므로 완료 시간은 비슷해야 하고, 연결 수만 다르다.
+# - bulk: 큰 정적 파일을 연결 하나로 반복해서 받는다. HTTP/2 도 DATA 본문은 sendfile 파일 구간으로 나간다.
+# 사용법:
+#   python3 bench/http2_bench.py build/webserv --duration 3 --rounds 3
+#   python3 bench/http2_bench.py build/webserv --only fanout --fanout 256
+import argparse
+import os
+import re
+import shutil
+import socket
+import statistics
+import struct
+import subprocess
+import sys
+import tempfile
+import time
+
+PREFACE = b"PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n"
+
+
+def cpu_seconds(pid):
+    with open(f"/proc/{pid}/stat") as f:
+        fields = f.read().rsplit(")", 1)[1].split()
+    return (int(fields[11]) + int(fields[12])) / os.sysconf("SC_CLK_TCK")
+
+
+def frame(kind, flags, stream, payload=b""):
+    return struct.pack(">I", len(payload))[1:] + bytes([kind, flags]) + struct.pack(">I", stream) + payload
+
+
+def h2_request(stream, path):
+    block = b"".join(bytes([0, len(n)]) + n + bytes([len(v)]) + v for n, v in
+                     ((b":method", b"GET"), (b":scheme", b"http"), (b":path", path.encode()),
+                      (b":authority", b"bench")))
+    return frame(1, 0x5, stream, block)
+
+
+class H2Client:
+    """프레임 경계만 따라가는 최소 클라이언트. 받은 DATA 만큼 창을 돌려준다."""
+
+    def __init__(self, port):
+        self.sock = socket.create_connection(("127.0.0.1", port))
+        self.sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        # 스트림 창 16MB, 연결 창도 같은 만큼 넓힌다.
+        self.sock.sendall(PREFACE + frame(4, 0, 0, struct.pack(">HI", 4, 1 << 24))
+                          + frame(8, 0, 0, struct.pack(">I", (1 << 24) - 65535)))
+        self.pending = bytearray()
+        self.next_stream = 1
+        self.received = 0
+        self.unacked = 0
+
+    def send(self, paths):
+        out, ids = b"", []
+        for path in paths:
+            out += h2_request(self.next_stream, path)
+            ids.append(self.next_stream)
+            self.next_stream += 2
+        self.sock.sendall(out)
+        return ids
+
+    def wait(self, count):
+        done = 0
+        while done < count:
+            while len(self.pending) < 9 or len(self.pending) < 9 + int.from_bytes(self.pending[:3], "big"):
+                chunk = self.sock.recv(1 << 20)
+                if not chunk:
+                    raise SystemExit("HTTP/2 연결이 닫혔습니다")
+                self.received += len(chunk)
+                self.pending += chunk
+            length = int.from_bytes(self.pending[:3], "big")
+            kind, flags = self.pending[3], self.pending[4]
+            stream = int.from_bytes(self.pending[5:9], "big") & 0x7FFFFFFF
+            del self.pending[:9 + length]
+            if kind == 0:
+                self.unacked += length
+                if self.unacked >= 1 << 22:
+                    # 한 스트림만 크게 받는 bulk 에서도 멈추지 않도록 연결 창과 스트림 창을 같이 돌려준다.
+                    update = struct.pack(">I", self.unacked)
+                    self.sock.sendall(frame(8, 0, 0, update) + frame(8, 0, stream, update))
+                    self.unacked = 0
+            if kind in (0, 1) and flags & 0x1:
+                done += 1
+            elif kind in (3, 7):
+                raise SystemExit("스트림/연결 오류 프레임을 받았습니다: %d" % kind)
+
+
+class H1Client:
+    def __init__(self, port):
+        self.sock = socket.create_connection(("127.0.0.1", port))
+        self.sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        self.pending = bytearray()
+        self.received = 0
+
+    def send(self, paths):
+        self.sock.sendall(b"".join(b"GET %s HTTP/1.1\r\nHost: bench\r\n\r\n" % p.encode() for p in paths))
+
+    def wait(self, count):
+        for _ in range(count):
+            while (end := self.pending.find(b"\r\n\r\n")) < 0:
+                self.pending += self.recv()
+            length = int(re.search(rb"Content-Length: (\d+)", self.pending[:end], re.I).group(1))
+            while len(self.pending) < end + 4 + length:
+                self.pending += self.recv()
+            del self.pending[:end + 4 + length]
+
+    def recv(self):
+        chunk = self.sock.recv(1 << 20)
+        if not chunk:
+            raise SystemExit("HTTP/1.1 연결이 닫혔습니다")
+        self.received += len(chunk)
+        return chunk
+
+
+def run_server(binary, port, root, options):
+    server = subprocess.Popen([binary, str(port), "--unlimited", "--workers", "1", "--idle-timeout-ms", "60000",
+                               "--demo-routes", "--root", root] + options, stderr=subprocess.DEVNULL)
+    time.sleep(0.3)
+    return server
+
+
+def small_loop(client, depth, duration):
+    count = 0
+    deadline = time.perf_counter() + duration
+    while time.perf_counter() < deadline:
+        client.send(["/health"] * depth)
+        client.wait(depth)
+        count += depth
+    return count
+
+
+def fanout_once(mode, port, count):
+    started = time.perf_counter()
+    if mode == "http/1.1":
+        clients = [H1Client(port) for _ in range(count)]
+        for client in clients:
+            client.send(["/delay/50"])
+        for client in clients:
+            client.wait(1)
+        for client in clients:
+            client.sock.close()
+    else:
+        client = H2Client(port)
+        client.send(["/delay/50"] * count)
+        client.wait(count)
+        client.sock.close()
+    return time.perf_counter() - started
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("binary")
+    parser.add_argument("--port", type=int, default=9193)
+    parser.add_argument("--duration", type=float, default=3)
+    parser.add_argument("--rounds", type=int, default=3)
+    parser.add_argument("--depth", type=int, default=16)
+    parser.add_argument("--fanout", type=int, default=64)
+    parser.add_argument("--file-mb", type=int, default=32)
+    parser.add_argument("--only", choices=["small", "fanout", "bulk"])
+    args = parser.parse_args()
+
+    work = tempfile.mkdtemp(prefix="webserv-http2-bench-")
+    try:
+        root = os.path.join(work, "root")
+        os.mkdir(root)
+        file_bytes = args.file_mb << 20
+        with open(os.path.join(root, "big.bin"), "wb") as f:
+            f.write(os.urandom(file_bytes))
+        clients = {"http/1.1": H1Client, "h2": H2Client}
+
+        if args.only in (None, "small"):
+            print(f"{'small':>9} {'req/s':>8} {'rounds':>22} {'server_cpu_us/req':>18} {'bytes/resp':>11}")
+            for mode, make in clients.items():
+                rates, cpu, requests, received = [], 0.0, 0, 0
+                for _ in range(args.rounds):
+                    server = run_server(args.binary, args.port, root, [])
+                    try:
+                        client = make(args.port)
+                        before = cpu_seconds(server.pid)
+                        start_bytes = client.received
+                        count = small_loop(client, args.depth, args.duration)
+                        cpu += cpu_seconds(server.pid) - before
+                        received += client.received - start_bytes
+                        client.sock.close()
+                    finally:
+                        server.terminate()
+                        server.wait()
+                    rates.append(count / args.duration)
+                    requests += count
+                print(f"{mode:>9} {statistics.median(rates):>8.0f} {' / '.join('%.0f' % r for r in rates):>22} "
+                      f"{cpu / requests * 1e6:>18.2f} {received / requests:>11.1f}")
+
+        if args.only in (None, "fanout"):
+            print(f"{'fanout':>9} {'ms':>8} {'rounds':>22} {'connections':>18}")
+            for mode in clients:
+                times = []
+                server = run_server(args.binary, args.port, root,
+                                    ["--handler-threads", str(args.fanout), "--handler-queue", str(args.fanout)])
+                try:
+                    for _ in range(args.rounds):
+                        times.append(fanout_once(mode, args.port, args.fanout) * 1e3)
+                finally:
+                    server.terminate()
+                    server.wait()
+                connections = args.fanout if mode == "http/1.1" else 1
+                print(f"{mode:>9} {statistics.median(times):>8.1f} {' / '.join('%.1f' % t for t in times):>22} "
+                      f"{connections:>18}")
+
+        if args.only in (None, "bulk"):
+            print(f"{'bulk':>9} {'MB/s':>8} {'rounds':>22} {'server_cpu_ms/MB':>18}")
+            for mode, make in clients.items():
+                rates, cpu, moved = [], 0.0, 0
+                for _ in range(args.rounds):
+                    server = run_server(args.binary, args.port, root, [])
+                    try:
+                        client = make(args.port)
+                        before = cpu_seconds(server.pid)
+                        started = time.perf_counter()
+                        total = 0
+                        while time.perf_counter() - started < args.duration:
+                            client.send(["/big.bin"])
+                            client.wait(1)
+                            total += file_bytes
+                        elapsed = time.perf_counter() - started
+                        cpu += cpu_seconds(server.pid) - before
+                        client.sock.close()
+                    finally:
+                        server.terminate()
+                        server.wait()
+                    rates.append(total / elapsed / 1e6)
+                    moved += total
+                print(f"{mode:>9} {statistics.median(rates):>8.0f} {' / '.join('%.0f' % r for r in rates):>22} "
+                      f"{cpu / (moved / 1e6) * 1e3:>18.2f}")
+    finally:
+        shutil.rmtree(work)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+# webserv-cpp17 v1.1.0 벤치마크: 유휴 연결 수(100 ~ 50k)에 따른 요청당 이벤트 처리 비용을 측정한다.
+# - 각 단계마다 서버를 새로 띄우고 N개의 유휴 연결을 열어 둔 뒤,
+#   하나의 keep-alive 연결로 순차 요청을 보내 왕복 지연과 서버 CPU 시간(요청당)을 기록한다.
+# - epoll 리액터라면 요청당 비용이 유휴 연결 수와 무관하게 거의 일정해야 한다.
+# - v1.8.0: 요청 없이 2초 동안 쓴 서버 CPU(idle_cpu_ms/s)도 기록한다. 타임아웃 처리가 연결 수에 비례하면 이 값이 커진다.
+# 사용법:
+#   python3 bench/idle_connections_bench.py build/webserv --levels 100,1000,10000,50000
+import argparse
+import resource
+import socket
+import struct
+import subprocess
+import sys
+import time
+
+
+def cpu_seconds(pid):
+    # /proc/<pid>/schedstat 첫 필드는 나노초 단위 누적 CPU 시간이다(clock tick 보다 정밀).
+    with open(f"/proc/{pid}/schedstat") as f:
+        return int(f.read().split()[0]) / 1e9
+
+
+def open_idle(port, count):
+    # 로컬 에페메럴 포트 고갈을 피하기 위해 2만 개마다 다른 루프백 출발지 주소를 사용한다.
+    sockets = []
+    for i in range(count):
+        source = f"127.0.0.{2 + i // 20000}"
+        s = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+        # 이전 단계의 TIME_WAIT 포트와 충돌하지 않도록 포트 선택을 connect 시점으로 미룬다.
+        s.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+        s.setsockopt(socket.IPPROTO_IP, 24, 1)  # IP_BIND_ADDRESS_NO_PORT
+        s.bind((source, 0))
+        s.connect(("127.0.0.1", port))
+        sockets.append(s)
+    return sockets
+
+
+def measure(port, requests):
+    request = b"GET /health HTTP/1.1\r\nHost: bench\r\n\r\n"
+    s = socket.create_connection(("127.0.0.1", port))
+    s.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+    latencies = []
+    for _ in range(requests):
+        begin = time.perf_counter()
+        s.sendall(request)
+        data = b""
+        while b"status: ok" not in data:
+            chunk = s.recv(4096)
+            if not chunk:
+                raise RuntimeError("서버가 연결을 닫았습니다")
+            data += chunk
+        latencies.append(time.perf_counter() - begin)
+    s.close()
+    latencies.sort()
+    return latencies
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("binary")
+    parser.add_argument("--port", type=int, default=9190)
+    parser.add_argument("--levels", default="100,1000,10000,50000")
+    parser.add_argument("--requests", type=int, default=5000)
+    parser.add_argument("--idle-seconds", type=float, default=2.0)
+    args = parser.parse_args()
+
+    soft, hard = resource.getrlimit(resource.RLIMIT_NOFILE)
+    resource.setrlimit(resource.RLIMIT_NOFILE, (hard, hard))
+
+    print(f"{'idle':>8} {'avg_us':>9} {'p99_us':>9} {'server_cpu_us/req':>18} {'idle_cpu_ms/s':>14}")
+    for level in [int(x) for x in args.levels.split(",")]:
+        if level + 64 > hard:
+            print(f"{level:>8} 건너뜀 (RLIMIT_NOFILE={hard})")
+            continue
+        server = subprocess.Popen(
+            [args.binary, str(args.port), "1000000000",
+             "--idle-timeout-ms", "3600000", "--max-runtime-sec", "0"],
+            stderr=subprocess.DEVNULL)
+        try:
+            time.sleep(0.3)
+            idle = open_idle(args.port, level)
+            time.sleep(0.5)
+            idle_before = cpu_seconds(server.pid)
+            time.sleep(args.idle_seconds)
+            idle_cpu = (cpu_seconds(server.pid) - idle_before) / args.idle_seconds * 1e3
+            cpu_before = cpu_seconds(server.pid)
+            latencies = measure(args.port, args.requests)
+            cpu_after = cpu_seconds(server.pid)
+            avg = sum(latencies) / len(latencies) * 1e6
+            p99 = latencies[int(len(latencies) * 0.99) - 1] * 1e6
+            per_req = (cpu_after - cpu_before) / args.requests * 1e6
+            print(f"{level:>8} {avg:>9.1f} {p99:>9.1f} {per_req:>18.2f} {idle_cpu:>14.3f}")
+            # RST 로 닫아 다음 단계가 TIME_WAIT 포트에 막히지 않게 한다.
+            linger = struct.pack("ii", 1, 0)
+            for s in idle:
+                s.setsockopt(socket.SOL_SOCKET, socket.SO_LINGER, linger)
+                s.close()
+        finally:
+            server.kill()
+            server.wait()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
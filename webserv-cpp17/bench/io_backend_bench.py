@@ -0,0 +1,164 @@
+#!/usr/bin/env python3
+# webserv-cpp17 v1.11.0 벤치마크: --io-backend epoll 과 uring 의 keep-alive /health 처리량,
+# 요청당 서버 CPU 시간, 요청당 시스템 호출 수를 비교한다.
+# - 처리량/CPU: 클라이언트 프로세스 여러 개가 각자 keep-alive 연결 여러 개에 요청을 depth 개씩 겹쳐 보낸다.
+# - 시스템 호출 수: 같은 부하를 webserv_syscall_count(ptrace) 아래에서 따로 돌린다. ptrace 로 서버가
+#   느려지므로 이 구간의 처리량은 버리고, 측정 구간 동안의 호출 수를 완료 요청 수로 나눈 값만 쓴다.
+# 사용법:
+#   python3 bench/io_backend_bench.py build/webserv build/webserv_syscall_count --connections 1,64,512 --duration 5
+import argparse
+import multiprocessing
+import os
+import selectors
+import signal
+import socket
+import subprocess
+import sys
+import tempfile
+import time
+
+REQUEST = b"GET /health HTTP/1.1\r\nHost: bench\r\n\r\n"
+RESPONSE_END = b"status: ok\n"
+
+
+def cpu_seconds(pid):
+    with open(f"/proc/{pid}/schedstat") as f:
+        return int(f.read().split()[0]) / 1e9
+
+
+def client_process(port, connections, depth, index, progress, stop_event):
+    sel = selectors.DefaultSelector()
+    for _ in range(connections):
+        s = socket.create_connection(("127.0.0.1", port))
+        s.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        s.setblocking(False)
+        s.send(REQUEST * depth)
+        sel.register(s, selectors.EVENT_READ, bytearray())
+    completed = 0
+    while not stop_event.is_set():
+        for key, _ in sel.select(timeout=0.05):
+            buffer = key.data
+            chunk = key.fileobj.recv(65536)
+            if not chunk:
+                sel.unregister(key.fileobj)
+                continue
+            buffer += chunk
+            done = buffer.count(RESPONSE_END)
+            if done:
+                completed += done
+                del buffer[:buffer.rfind(RESPONSE_END) + len(RESPONSE_END)]
+                key.fileobj.send(REQUEST * done)
+        # 부모가 측정 구간 앞뒤로 읽을 수 있도록 완료 수를 공유 배열에 올린다.
+        progress[index] = completed
+
+
+class Load:
+    """클라이언트 프로세스 묶음. completed() 는 지금까지 완료된 요청 수의 합이다."""
+
+    def __init__(self, port, clients, connections, depth):
+        count = min(clients, connections)
+        self.progress = multiprocessing.Array("q", count, lock=False)
+        self.stop_event = multiprocessing.Event()
+        self.procs = [multiprocessing.Process(
+            target=client_process,
+            args=(port, connections // count, depth, i, self.progress, self.stop_event))
+            for i in range(count)]
+
+    def start(self):
+        for p in self.procs:
+            p.start()
+
+    def completed(self):
+        return sum(self.progress)
+
+    def stop(self):
+        self.stop_event.set()
+        for p in self.procs:
+            p.join()
+
+
+def server_args(binary, port, backend):
+    return [binary, str(port), "1000000000", "--max-runtime-sec", "0",
+            "--idle-timeout-ms", "60000", "--io-backend", backend]
+
+
+def measure_throughput(binary, port, backend, clients, connections, depth, duration):
+    server = subprocess.Popen(server_args(binary, port, backend), stderr=subprocess.DEVNULL)
+    load = None
+    try:
+        time.sleep(0.3)
+        load = Load(port, clients, connections, depth)
+        load.start()
+        time.sleep(1.0)  # 연결 수립과 워밍업
+        cpu_before = cpu_seconds(server.pid)
+        done_before = load.completed()
+        time.sleep(duration)
+        cpu_after = cpu_seconds(server.pid)
+        requests = load.completed() - done_before
+        return requests / duration, (cpu_after - cpu_before) / max(1, requests) * 1e6
+    finally:
+        if load is not None:
+            load.stop()
+        server.kill()
+        server.wait()
+        time.sleep(0.1)  # io_uring 링 정리가 비동기라 포트가 잠깐 남아 있을 수 있다
+
+
+def measure_syscalls(binary, counter, port, backend, clients, connections, depth, duration):
+    with tempfile.NamedTemporaryFile("r", suffix=".txt") as out:
+        tracer = subprocess.Popen([counter, out.name, "--"] + server_args(binary, port, backend),
+                                  stderr=subprocess.DEVNULL)
+        load = None
+        try:
+            time.sleep(0.5)
+            load = Load(port, clients, connections, depth)
+            load.start()
+            time.sleep(1.0)
+            # 카운터가 신호를 처리하는 시점(다음 ptrace 정지)과 완료 수를 읽는 시점 사이의 오차는 무시한다.
+            tracer.send_signal(signal.SIGUSR1)
+            done_before = load.completed()
+            time.sleep(duration)
+            tracer.send_signal(signal.SIGUSR2)
+            requests = load.completed() - done_before
+            time.sleep(0.2)
+        finally:
+            if load is not None:
+                load.stop()
+            tracer.terminate()
+            tracer.wait()
+            time.sleep(0.1)
+        counts = {}
+        for line in out.read().splitlines():
+            name, value = line.split()
+            counts[name] = int(value)
+    return counts, requests
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("binary")
+    parser.add_argument("counter", help="webserv_syscall_count 경로")
+    parser.add_argument("--port", type=int, default=9192)
+    parser.add_argument("--connections", default="1,64,512")
+    parser.add_argument("--clients", type=int, default=os.cpu_count() or 1)
+    parser.add_argument("--depth", type=int, default=1, help="연결당 겹쳐 보내는 요청 수")
+    parser.add_argument("--duration", type=float, default=5.0)
+    args = parser.parse_args()
+
+    print(f"{'backend':>8} {'conns':>6} {'req/s':>10} {'cpu_us/req':>11} {'syscalls/req':>13}  top")
+    for connections in [int(c) for c in args.connections.split(",")]:
+        for backend in ("epoll", "uring"):
+            rps, cpu_us = measure_throughput(args.binary, args.port, backend, args.clients,
+                                             connections, args.depth, args.duration)
+            counts, requests = measure_syscalls(args.binary, args.counter, args.port, backend,
+                                                args.clients, connections, args.depth, args.duration)
+            per_request = counts.get("total", 0) / max(1.0, requests)
+            # 카운터 출력은 많은 순으로 정렬돼 있다.
+            top = ", ".join(f"{name} {value / max(1.0, requests):.2f}"
+                            for name, value in list(counts.items())[:3] if name != "total")
+            print(f"{backend:>8} {connections:>6} {rps:>10.0f} {cpu_us:>11.2f} {per_request:>13.2f}  {top}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,93 @@
+/**
+ * [모듈] webserv-cpp17/bench/metrics_bench.cpp
+ * 설명:
+ *   - 요청 하나를 계측하는 비용(경로/상태 카운터 + 지연 히스토그램 기록)을
+ *     워커별 단일 작성자 방식과 공유 원자 카운터(fetch_add) 방식으로 비교한다.
+ *   - 스레드 수를 늘려 공유 카운터의 캐시 라인 경합이 어떻게 커지는지 본다.
+ * 버전: v1.7.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.7.0-worker-metrics.md
+ * 변경 이력:
+ *   - v1.7.0: 계측 비용 벤치마크 추가
+ * 사용법:
+ *   - ./build/webserv_metrics_bench [iterations] [threads]
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "metrics.hpp"
+
+namespace {
+
+// 비교 기준: 모든 스레드가 같은 카운터/히스토그램에 lock 접두 명령으로 더한다.
+struct SharedMetrics {
+    std::atomic<std::uint64_t> requests[static_cast<std::size_t>(RouteLabel::kCount)]
+                                       [static_cast<std::size_t>(StatusLabel::kCount)] = {};
+    std::atomic<std::uint64_t> buckets[LatencyHistogram::BUCKETS] = {};
+    std::atomic<std::uint64_t> sum{0};
+};
+
+template <typename Fn>
+double runThreads(std::size_t threads, std::size_t iterations, Fn &&fn) {
+    std::atomic<bool> go{false};
+    std::vector<std::thread> pool;
+    for (std::size_t t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t]() {
+            while (!go.load(std::memory_order_acquire)) {
+            }
+            fn(t);
+        });
+    }
+    auto begin = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (std::thread &thread : pool) {
+        thread.join();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) /
+           static_cast<double>(iterations);
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+    std::size_t iterations = argc >= 2 ? std::strtoul(argv[1], nullptr, 10) : 20000000;
+    std::size_t threads = argc >= 3 ? std::strtoul(argv[2], nullptr, 10) : 4;
+    if (threads == 0) {
+        threads = 1;
+    }
+
+    std::printf("기록 %zu회 x 스레드 %zu개 (하드웨어 스레드 %u개)\n", iterations, threads,
+                std::thread::hardware_concurrency());
+    std::printf("%8s %22s %22s\n", "threads", "per-worker ns/record", "shared fetch_add ns/record");
+
+    for (std::size_t count = 1; count <= threads; count *= 2) {
+        MetricsRegistry registry(count);
+        double local_ns = runThreads(count, iterations, [&](std::size_t t) {
+            WorkerMetrics &metrics = registry.worker(t);
+            for (std::size_t i = 0; i < iterations; ++i) {
+                metrics.countRequest(RouteLabel::kHealth, 200);
+                metrics.latency.record(20000 + (i & 1023));
+            }
+        });
+
+        auto shared = std::make_unique<SharedMetrics>();
+        double shared_ns = runThreads(count, iterations, [&](std::size_t) {
+            for (std::size_t i = 0; i < iterations; ++i) {
+                shared->requests[0][0].fetch_add(1, std::memory_order_relaxed);
+                std::uint64_t nanos = 20000 + (i & 1023);
+                shared->buckets[LatencyHistogram::bucketFor(nanos)].fetch_add(1, std::memory_order_relaxed);
+                shared->sum.fetch_add(nanos, std::memory_order_relaxed);
+            }
+        });
+        std::printf("%8zu %22.2f %22.2f\n", count, local_ns, shared_ns);
+    }
+    return 0;
+}
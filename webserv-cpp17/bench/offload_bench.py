@@ -0,0 +1,95 @@
+#!/usr/bin/env python3
+# webserv-cpp17 v1.17.0 벤치마크: 느린 핸들러가 도는 동안 같은 워커의 /health 지연을 잰다.
+# - 클라이언트 스레드 여럿이 keep-alive 연결로 `/delay/MS` 를 쉬지 않고 보내는 동안, 다른 연결 하나로 /health 를
+#   하나씩 보내 요청별 왕복 시간의 p50/p99 를 낸다.
+# - (1) `--handler-threads N`: 작업 스레드 풀에 맡긴다. 풀이 차면 503 으로 거절한다.
+#   (2) 대기 자리 0: 쉬는 스레드가 없으면 바로 503 이다.
+#   (3) 워커 4개: 워커마다 deque 가 따로 있고, 스레드는 자기 deque 가 비면 다른 deque 에서 훔쳐 온다.
+# 사용법:
+#   python3 bench/offload_bench.py build/webserv --requests 500
+import argparse
+import http.client
+import subprocess
+import sys
+import threading
+import time
+
+
+def start(binary, port, *options):
+    server = subprocess.Popen(
+        [binary, str(port), "1000000000", "--max-runtime-sec", "0", "--idle-timeout-ms", "60000",
+         "--workers", "1", "--demo-routes", *options],
+        stderr=subprocess.DEVNULL)
+    time.sleep(0.3)
+    return server
+
+
+def load(port, path, stop, counts, lock):
+    conn = http.client.HTTPConnection("127.0.0.1", port, timeout=30)
+    while not stop.is_set():
+        conn.request("GET", path)
+        response = conn.getresponse()
+        response.read()
+        with lock:
+            counts[response.status] = counts.get(response.status, 0) + 1
+
+
+def measure(port, requests, clients, delay_ms):
+    stop = threading.Event()
+    counts = {}
+    lock = threading.Lock()
+    threads = [threading.Thread(target=load, args=(port, "/delay/%d" % delay_ms, stop, counts, lock))
+               for _ in range(clients)]
+    started = time.monotonic()
+    for thread in threads:
+        thread.start()
+    time.sleep(0.2)
+
+    conn = http.client.HTTPConnection("127.0.0.1", port, timeout=30)
+    samples = []
+    for _ in range(requests):
+        begin = time.perf_counter_ns()
+        conn.request("GET", "/health")
+        conn.getresponse().read()
+        samples.append(time.perf_counter_ns() - begin)
+    # 처리율은 부하를 건 전체 구간으로 나눈다.
+    time.sleep(max(0.0, 1.0 - (time.monotonic() - started)))
+    stop.set()
+    for thread in threads:
+        thread.join()
+    elapsed = time.monotonic() - started
+    samples.sort()
+    return (samples[len(samples) // 2] / 1000, samples[len(samples) * 99 // 100] / 1000,
+            counts.get(200, 0) / elapsed, counts.get(503, 0) / elapsed)
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("binary")
+    parser.add_argument("--port", type=int, default=9198)
+    parser.add_argument("--requests", type=int, default=500)
+    parser.add_argument("--clients", type=int, default=8)
+    parser.add_argument("--delay-ms", type=int, default=20)
+    parser.add_argument("--handler-threads", type=int, default=4)
+    parser.add_argument("--handler-queue", type=int, default=64)
+    args = parser.parse_args()
+
+    pool = ("--handler-threads", str(args.handler_threads), "--handler-queue", str(args.handler_queue))
+    modes = (("pool (threads %d)" % args.handler_threads, pool),
+             ("pool, queue 0", ("--handler-threads", str(args.handler_threads), "--handler-queue", "0")),
+             ("pool, workers 4", pool + ("--workers", "4")))
+    print(f"{'mode':>20} {'health p50 us':>14} {'health p99 us':>14} {'delay 200/s':>12} {'delay 503/s':>12}")
+    for index, (name, options) in enumerate(modes):
+        port = args.port + index
+        server = start(args.binary, port, *options)
+        try:
+            p50, p99, ok_rate, rejected_rate = measure(port, args.requests, args.clients, args.delay_ms)
+        finally:
+            server.kill()
+            server.wait()
+        print(f"{name:>20} {p50:>14.1f} {p99:>14.1f} {ok_rate:>12.1f} {rejected_rate:>12.1f}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
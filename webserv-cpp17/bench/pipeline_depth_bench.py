@@ -0,0 +1,99 @@
+#!/usr/bin/env python3
+# webserv-cpp17 v1.4.0 벤치마크: HTTP/1.1 파이프라이닝 깊이(1, 16, 128)별 처리량과 요청당 서버 CPU 시간을 측정한다.
+# - 각 연결은 약 600바이트 브라우저형 요청을 depth 개씩 한 번에 보내고, 응답 depth 개를 모두 받은 뒤 반복한다.
+# - 입력 버퍼가 요청마다 앞부분을 memmove 하면 깊이가 깊을수록 요청당 비용이 커지고,
+#   읽기 커서 방식이면 깊이와 무관하게 일정하거나 오히려 줄어야 한다.
+# 사용법:
+#   python3 bench/pipeline_depth_bench.py build/webserv --depths 1,16,128 --duration 5
+import argparse
+import selectors
+import socket
+import subprocess
+import sys
+import time
+
+REQUEST = (
+    b"GET /health HTTP/1.1\r\n"
+    b"Host: bench.example.co.kr\r\n"
+    b"User-Agent: Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) "
+    b"Chrome/124.0.0.0 Safari/537.36\r\n"
+    b"Accept: text/html,application/xhtml+xml,application/xml;q=0.9,image/avif,image/webp,*/*;q=0.8\r\n"
+    b"Accept-Language: ko-KR,ko;q=0.9,en-US;q=0.8,en;q=0.7\r\n"
+    b"Accept-Encoding: gzip, deflate, br\r\n"
+    b"Referer: https://bench.example.co.kr/products/list?page=2&sort=recent\r\n"
+    b"Cookie: _ga=GA1.1.1234567890.1700000000; session=3f1c2a9b8d7e6f5a4b3c2d1e0f9a8b7c; theme=dark\r\n"
+    b"Sec-Fetch-Site: same-origin\r\n"
+    b"Sec-Fetch-Mode: navigate\r\n"
+    b"Connection: keep-alive\r\n"
+    b"\r\n"
+)
+RESPONSE_END = b"status: ok\n"
+
+
+def cpu_seconds(pid):
+    with open(f"/proc/{pid}/schedstat") as f:
+        return int(f.read().split()[0]) / 1e9
+
+
+def run_depth(port, depth, connections, duration):
+    sel = selectors.DefaultSelector()
+    batch = REQUEST * depth
+    for _ in range(connections):
+        s = socket.create_connection(("127.0.0.1", port))
+        s.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        s.sendall(batch)
+        s.setblocking(False)
+        sel.register(s, selectors.EVENT_READ, [0, b""])
+    completed = 0
+    deadline = time.perf_counter() + duration
+    while time.perf_counter() < deadline:
+        for key, _ in sel.select(timeout=0.1):
+            state = key.data
+            chunk = key.fileobj.recv(1 << 20)
+            if not chunk:
+                raise RuntimeError("서버가 연결을 닫았습니다")
+            data = state[1] + chunk
+            done = data.count(RESPONSE_END)
+            state[0] += done
+            state[1] = data[data.rfind(RESPONSE_END) + len(RESPONSE_END):] if done else data
+            if state[0] >= depth:
+                completed += state[0]
+                state[0] = 0
+                key.fileobj.setblocking(True)
+                key.fileobj.sendall(batch)
+                key.fileobj.setblocking(False)
+    for key in list(sel.get_map().values()):
+        key.fileobj.close()
+    return completed
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("binary")
+    parser.add_argument("--port", type=int, default=9192)
+    parser.add_argument("--depths", default="1,16,128")
+    parser.add_argument("--connections", type=int, default=4)
+    parser.add_argument("--duration", type=float, default=5.0)
+    args = parser.parse_args()
+
+    print(f"{'depth':>6} {'req/s':>10} {'server_cpu_us/req':>18}")
+    for depth in [int(x) for x in args.depths.split(",")]:
+        server = subprocess.Popen(
+            [args.binary, str(args.port), "1000000000", "--max-runtime-sec", "0",
+             "--idle-timeout-ms", "60000"],
+            stderr=subprocess.DEVNULL)
+        try:
+            time.sleep(0.3)
+            cpu_before = cpu_seconds(server.pid)
+            completed = run_depth(args.port, depth, args.connections, args.duration)
+            cpu_after = cpu_seconds(server.pid)
+            per_req = (cpu_after - cpu_before) / max(completed, 1) * 1e6
+            print(f"{depth:>6} {completed / args.duration:>10.0f} {per_req:>18.2f}")
+        finally:
+            server.kill()
+            server.wait()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,82 @@
+#!/usr/bin/env python3
+# webserv-cpp17 v1.16.0 벤치마크: 리버스 프록시가 더하는 지연을 잰다.
+# - 원본 webserv 하나에 정적 파일을 두고, 같은 요청을 (1) 원본에 직접 (2) `--proxy` webserv 를 거쳐
+#   (3) `--upstream-keepalive 0` 으로 업스트림 연결을 매번 새로 맺는 프록시를 거쳐 보낸다.
+# - 클라이언트는 keep-alive 연결 하나로 요청을 하나씩 보내고 요청별 왕복 시간의 p50/p99 를 낸다.
+# 사용법:
+#   python3 bench/proxy_latency_bench.py build/webserv --requests 20000
+import argparse
+import os
+import socket
+import subprocess
+import sys
+import tempfile
+import time
+
+PATH = "/bench.txt"
+
+
+def start(binary, port, *options):
+    server = subprocess.Popen(
+        [binary, str(port), "1000000000", "--max-runtime-sec", "0", "--idle-timeout-ms", "60000",
+         "--workers", "1", *options],
+        stderr=subprocess.DEVNULL)
+    time.sleep(0.3)
+    return server
+
+
+def measure(port, requests, body_length):
+    request = ("GET %s HTTP/1.1\r\nHost: bench\r\n\r\n" % PATH).encode()
+    sock = socket.create_connection(("127.0.0.1", port))
+    sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+    samples = []
+    for index in range(requests):
+        started = time.perf_counter_ns()
+        sock.sendall(request)
+        buffer = b""
+        while True:
+            buffer += sock.recv(65536)
+            head_end = buffer.find(b"\r\n\r\n")
+            if head_end >= 0 and len(buffer) >= head_end + 4 + body_length:
+                break
+        elapsed = time.perf_counter_ns() - started
+        if index >= requests // 10:
+            # 앞의 10% 는 연결/캐시 준비 구간이라 뺀다.
+            samples.append(elapsed)
+    sock.close()
+    samples.sort()
+    return samples[len(samples) // 2] / 1000, samples[len(samples) * 99 // 100] / 1000
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("binary")
+    parser.add_argument("--port", type=int, default=9195)
+    parser.add_argument("--requests", type=int, default=20000)
+    parser.add_argument("--body-bytes", type=int, default=1024)
+    args = parser.parse_args()
+
+    root = tempfile.mkdtemp()
+    with open(os.path.join(root, PATH.lstrip("/")), "wb") as f:
+        f.write(b"x" * args.body_bytes)
+
+    origin_port, proxy_port, fresh_port = args.port, args.port + 1, args.port + 2
+    target = "%s=127.0.0.1:%d" % (PATH, origin_port)
+    servers = [start(args.binary, origin_port, "--root", root),
+               start(args.binary, proxy_port, "--proxy", target),
+               start(args.binary, fresh_port, "--proxy", target, "--upstream-keepalive", "0")]
+    try:
+        print(f"{'path':>24} {'p50 us':>10} {'p99 us':>10}")
+        for name, port in (("direct", origin_port), ("proxy (pooled)", proxy_port),
+                           ("proxy (no keepalive)", fresh_port)):
+            p50, p99 = measure(port, args.requests, args.body_bytes)
+            print(f"{name:>24} {p50:>10.1f} {p99:>10.1f}")
+    finally:
+        for server in servers:
+            server.kill()
+            server.wait()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+# webserv-cpp17 v1.25.0 벤치마크: 설정을 다시 읽거나 바이너리를 바꾸는 동안 클라이언트가 보는 실패와 지연을 잰다.
+# - baseline: 아무 일도 하지 않는 기준선
+# - sighup: --interval-ms 마다 SIGHUP 을 보낸다(설정 파일을 다시 읽고 워커가 새 세대를 적용한다)
+# - upgrade: --upgrade-sec 마다 `--takeover` 로 새 프로세스를 띄워 리슨 소켓을 넘긴다(이전 프로세스는 drain 후 끝난다)
+# - restart: 같은 주기로 이전 프로세스를 죽이고 새로 띄운다(소켓을 넘기지 않는 순진한 재시작)
+# - 부하는 `webserv_bench` 폐쇄 루프다. errors 는 연결 실패·읽기 실패·응답 유실을 합친 수이고, 0 이어야 무중단이다.
+# 사용법:
+#   python3 bench/reload_bench.py build/webserv build/webserv_bench --duration 5 --rounds 3
+#   python3 bench/reload_bench.py build/webserv build/webserv_bench --variant upgrade --workers 2
+import argparse
+import os
+import signal
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+
+VARIANTS = ["baseline", "sighup", "upgrade", "restart"]
+
+
+def summary_of(output):
+    return dict(item.split("=", 1) for item in output.splitlines()[-1].split()[1:])
+
+
+def start_server(args, config, control, takeover=False):
+    command = [args.binary, "--config", config, "--control-socket", control]
+    if takeover:
+        command += ["--takeover", control]
+    return subprocess.Popen(command, stderr=subprocess.DEVNULL)
+
+
+def run_round(args, variant, work_dir):
+    config = os.path.join(work_dir, "bench.conf")
+    control = os.path.join(work_dir, "control.sock")
+    with open(config, "w") as file:
+        file.write(f"port {args.port}\nworkers {args.workers}\nunlimited\nidle-timeout-ms 60000\n"
+                   f"drain-timeout-ms 2000\n")
+    servers = [start_server(args, config, control)]
+    time.sleep(0.3)
+    bench = subprocess.Popen(
+        [args.bench, "--threads", "1", "--connections", str(args.connections),
+         "--duration-sec", str(args.duration), "--warmup-sec", "0", f"127.0.0.1:{args.port}"],
+        stdout=subprocess.PIPE, text=True)
+    events = 0
+    try:
+        next_event = time.monotonic() + (args.interval_ms / 1000.0 if variant == "sighup" else args.upgrade_sec)
+        while bench.poll() is None:
+            now = time.monotonic()
+            if variant == "baseline" or now < next_event:
+                time.sleep(0.01)
+                continue
+            if variant == "sighup":
+                servers[-1].send_signal(signal.SIGHUP)
+                next_event = now + args.interval_ms / 1000.0
+            elif variant == "upgrade":
+                servers.append(start_server(args, config, control, takeover=True))
+                next_event = now + args.upgrade_sec
+            else:
+                servers[-1].kill()
+                servers[-1].wait()
+                servers.append(start_server(args, config, control))
+                next_event = now + args.upgrade_sec
+            events += 1
+        summary = summary_of(bench.communicate()[0])
+    finally:
+        if bench.poll() is None:
+            bench.kill()
+            bench.wait()
+        for server in servers:
+            if server.poll() is None:
+                server.kill()
+            server.wait()
+    return summary, events
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("binary")
+    parser.add_argument("bench")
+    parser.add_argument("--port", type=int, default=9195)
+    parser.add_argument("--workers", type=int, default=1)
+    parser.add_argument("--connections", type=int, default=16)
+    parser.add_argument("--duration", type=int, default=5)
+    parser.add_argument("--rounds", type=int, default=3)
+    parser.add_argument("--interval-ms", type=int, default=100, help="sighup 의 SIGHUP 간격")
+    parser.add_argument("--upgrade-sec", type=float, default=1.0, help="upgrade/restart 의 교체 간격")
+    parser.add_argument("--variant", action="append", choices=VARIANTS)
+    args = parser.parse_args()
+
+    print(f"{'variant':>9} {'events':>7} {'rps':>10} {'p99_us':>10} {'requests':>10} {'errors':>8} {'non2xx':>7}")
+    for variant in args.variant or VARIANTS:
+        rates, p99s, requests, errors, non2xx, events = [], [], 0, 0, 0, 0
+        for _ in range(args.rounds):
+            with tempfile.TemporaryDirectory() as work_dir:
+                summary, count = run_round(args, variant, work_dir)
+            rates.append(float(summary["rps"]))
+            p99s.append(float(summary["p99_us"]))
+            requests += int(summary["requests"])
+            errors += int(summary["errors"])
+            non2xx += int(summary["non2xx"])
+            events += count
+            # 순진한 재시작 뒤에는 커널이 이전 소켓을 정리할 틈을 준다.
+            time.sleep(0.3)
+        print(f"{variant:>9} {events:>7} {statistics.median(rates):>10.0f} {statistics.median(p99s):>10.1f} "
+              f"{requests:>10} {errors:>8} {non2xx:>7}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
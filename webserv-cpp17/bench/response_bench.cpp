@@ -0,0 +1,93 @@
+/**
+ * [모듈] webserv-cpp17/bench/response_bench.cpp
+ * 설명:
+ *   - 응답 하나를 직렬화해 출력 큐에 넣고 비우는 비용을 세 가지 방식으로 비교한다.
+ *     - v1.9.0 방식: 임시 std::string 을 이어 붙여 만든 응답을 std::deque<std::string> 조각 큐에 넣는다.
+ *     - writeResponse: 상태 줄/헤더 표와 to_chars 로 출력 큐 버퍼에 바로 직렬화한다.
+ *     - canned: 미리 만든 응답 바이트열을 출력 큐 버퍼에 복사한다(/health 경로).
+ *   - 본문은 /health 와 같은 11바이트다.
+ * 버전: v1.10.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.10.0-zero-alloc-responses.md
+ * 변경 이력:
+ *   - v1.10.0: 응답 직렬화 비용 벤치마크 추가
+ * 사용법:
+ *   - ./build/webserv_response_bench [iterations]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <string>
+
+#include "http_message.hpp"
+#include "io_buffer.hpp"
+
+namespace {
+
+// v1.9.0 의 buildResponse 를 그대로 옮긴 비교 기준.
+std::string legacyBuildResponse(int status, const std::string &message, bool keep_alive) {
+    std::string status_line;
+    switch (status) {
+        case 200: status_line = "HTTP/1.1 200 OK\r\n"; break;
+        case 404: status_line = "HTTP/1.1 404 Not Found\r\n"; break;
+        case 405: status_line = "HTTP/1.1 405 Method Not Allowed\r\n"; break;
+        default: status_line = "HTTP/1.1 400 Bad Request\r\n"; break;
+    }
+
+    std::string connection_header = keep_alive ? "keep-alive" : "close";
+    std::string body = message;
+    std::string response = status_line +
+        "Content-Type: text/plain; charset=utf-8\r\n" +
+        "Content-Length: " + std::to_string(body.size()) + "\r\n" +
+        "Connection: " + connection_header + "\r\n\r\n" + body;
+
+    return response;
+}
+
+template <typename Fn>
+double nanosPerResponse(std::size_t iterations, Fn &&fn) {
+    auto begin = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        fn();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) /
+           static_cast<double>(iterations);
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+    std::size_t iterations = argc >= 2 ? std::strtoul(argv[1], nullptr, 10) : 5000000;
+    std::size_t checksum = 0;
+
+    std::deque<std::string> chunks;
+    double legacy_ns = nanosPerResponse(iterations, [&] {
+        chunks.push_back(legacyBuildResponse(200, "status: ok\n", true));
+        checksum += chunks.front().size();
+        chunks.pop_front();
+    });
+
+    ResponseTemplates templates;
+    OutputQueue output;
+    double direct_ns = nanosPerResponse(iterations, [&] {
+        writeResponse(output, 200, {"status: ok\n"}, true, templates.dateLine());
+        checksum += output.bytes();
+        output.clear();
+    });
+
+    double canned_ns = nanosPerResponse(iterations, [&] {
+        output.append(templates.canned(CannedReply::kHealth, true));
+        checksum += output.bytes();
+        output.clear();
+    });
+
+    std::printf("응답 %zu개 (checksum %zu)\n", iterations, checksum);
+    std::printf("%32s %10s\n", "serializer", "ns/resp");
+    std::printf("%32s %10.1f\n", "string concat + deque (v1.9.0)", legacy_ns);
+    std::printf("%32s %10.1f\n", "writeResponse (direct)", direct_ns);
+    std::printf("%32s %10.1f\n", "canned blob append", canned_ns);
+    return 0;
+}
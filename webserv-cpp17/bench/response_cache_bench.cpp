@@ -0,0 +1,95 @@
+/**
+ * [모듈] webserv-cpp17/bench/response_cache_bench.cpp
+ * 설명:
+ *   - `/metrics` 응답 하나를 만드는 비용을 캐시 경로별로 비교한다.
+ *     - 핸들러 실행: MetricsRegistry::render 로 본문을 만들고 writeResponse 로 직렬화한다(v1.14.0 까지의 경로).
+ *     - 캐시 적중: ResponseCache::find 로 항목을 찾고 저장된 본문과 검증자 헤더를 직렬화한다.
+ *     - 304: 캐시 적중 후 If-None-Match 가 맞아 본문 없이 상태 줄과 검증자만 쓴다.
+ *   - 계측 레지스트리의 워커 수를 인자로 바꿔 본문 크기를 키울 수 있다.
+ * 버전: v1.15.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.15.0-response-cache.md
+ * 변경 이력:
+ *   - v1.15.0: 응답 캐시 벤치마크 추가
+ * 사용법:
+ *   - ./build/webserv_response_cache_bench [iterations] [workers]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <string>
+
+#include "http_message.hpp"
+#include "io_buffer.hpp"
+#include "metrics.hpp"
+#include "response_cache.hpp"
+
+namespace {
+
+template <typename Fn>
+double nanosPerResponse(std::size_t iterations, Fn &&fn) {
+    auto begin = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        fn();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) /
+           static_cast<double>(iterations);
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+    std::size_t iterations = argc >= 2 ? std::strtoul(argv[1], nullptr, 10) : 20000;
+    std::size_t workers = argc >= 3 ? std::strtoul(argv[2], nullptr, 10) : 4;
+    MetricsRegistry registry(workers);
+    for (std::size_t w = 0; w < workers; ++w) {
+        registry.worker(w).countRequest(RouteLabel::kMetrics, 200);
+    }
+    std::size_t checksum = 0;
+
+    ResponseTemplates templates;
+    OutputQueue output;
+    double render_ns = nanosPerResponse(iterations, [&] {
+        std::string body = registry.render();
+        writeResponse(output, 200, {body}, true, templates.dateLine());
+        checksum += output.bytes();
+        output.clear();
+    });
+
+    auto now = std::chrono::steady_clock::now();
+    ResponseCache cache(1 << 20, std::chrono::hours(1), false);
+    cache.find("GET", "localhost", "/metrics", now);
+    CachedResponse *stored = cache.store(registry.render(), RouteLabel::kMetrics, std::time(nullptr), now);
+    std::size_t body_bytes = stored->bodies[0].size();
+    double hit_ns = nanosPerResponse(iterations, [&] {
+        CachedResponse *entry = cache.find("GET", "localhost", "/metrics", now);
+        writeResponse(output, 200, {entry->bodies[0]}, true, templates.dateLine(), entry->headers[0]);
+        checksum += output.bytes();
+        output.clear();
+    });
+
+    HttpRequestView request;
+    request.method = "GET";
+    request.path = "/metrics";
+    request.version = "HTTP/1.1";
+    request.headers[0] = HeaderField{"If-None-Match", stored->etags[0]};
+    request.header_count = 1;
+    double not_modified_ns = nanosPerResponse(iterations, [&] {
+        CachedResponse *entry = cache.find("GET", "localhost", "/metrics", now);
+        if (isNotModified(request, entry->etags[0], entry->last_modified)) {
+            writeNotModified(output, true, templates.dateLine(), entry->headers[0]);
+        }
+        checksum += output.bytes();
+        output.clear();
+    });
+
+    std::printf("워커 %zu개, 본문 %zu바이트, 응답 %zu개 (checksum %zu)\n", workers, body_bytes, iterations, checksum);
+    std::printf("%24s %12s\n", "path", "ns/resp");
+    std::printf("%24s %12.1f\n", "handler render", render_ns);
+    std::printf("%24s %12.1f\n", "cache hit", hit_ns);
+    std::printf("%24s %12.1f\n", "cache hit 304", not_modified_ns);
+    return 0;
+}
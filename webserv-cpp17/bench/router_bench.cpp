@@ -0,0 +1,169 @@
+/**
+ * [모듈] webserv-cpp17/bench/router_bench.cpp
+ * 설명:
+ *   - 경로 수(10, 100, 1000)에 따라 요청 하나의 라우팅 비용이 어떻게 변하는지 비교한다.
+ *     - if 사슬: v1.12.0 의 handleDynamicRoute 처럼 등록 순서대로 경로 문자열을 비교한다.
+ *     - FixedRouteSet: 컴파일 타임에 만든 완전 해시 표(경로 목록도 컴파일 타임에 만든다).
+ *     - RadixRouter(고정): 같은 고정 경로를 기수 트리에 넣는다.
+ *     - RadixRouter(매개변수): `/api/v1/resN/:id` 패턴에 `/api/v1/resN/12345` 를 찾는다.
+ *   - 경로는 `/api/v1/res0` 처럼 공통 접두사가 길어 문자열 비교가 일찍 끝나지 않는다.
+ *     조회 순서는 무작위로 섞어 분기 예측이 한 경로에 고정되지 않게 한다.
+ * 버전: v1.13.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.13.0-router.md
+ * 변경 이력:
+ *   - v1.13.0: 라우팅 마이크로벤치마크 추가
+ * 사용법:
+ *   - ./build/webserv_router_bench [lookups]
+ */
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "router.hpp"
+
+namespace {
+
+constexpr char ROUTE_PREFIX[] = "/api/v1/res";
+constexpr std::size_t NAME_CAPACITY = 24;
+
+/**
+ * RouteNames
+ * 설명:
+ *   - `/api/v1/res0` ~ `/api/v1/res{N-1}` 경로 문자열을 컴파일 타임에 만들어 담는다.
+ */
+template <std::size_t N>
+struct RouteNames {
+    char text[N][NAME_CAPACITY] = {};
+    std::size_t length[N] = {};
+
+    constexpr RouteNames() {
+        for (std::size_t i = 0; i < N; ++i) {
+            std::size_t at = 0;
+            for (std::size_t c = 0; c + 1 < sizeof(ROUTE_PREFIX); ++c) {
+                text[i][at++] = ROUTE_PREFIX[c];
+            }
+            char digits[20] = {};
+            std::size_t count = 0;
+            std::size_t value = i;
+            do {
+                digits[count++] = static_cast<char>('0' + value % 10);
+                value /= 10;
+            } while (value != 0);
+            while (count > 0) {
+                text[i][at++] = digits[--count];
+            }
+            length[i] = at;
+        }
+    }
+};
+
+template <std::size_t N>
+constexpr RouteNames<N> NAMES{};
+
+template <std::size_t N>
+constexpr std::array<FixedRoute, N> makeFixedRoutes() {
+    std::array<FixedRoute, N> routes{};
+    for (std::size_t i = 0; i < N; ++i) {
+        routes[i] = FixedRoute{HttpMethod::kGet, std::string_view(NAMES<N>.text[i], NAMES<N>.length[i]),
+                               static_cast<RouteId>(i)};
+    }
+    return routes;
+}
+
+template <std::size_t N>
+constexpr FixedRouteSet<N> FIXED_SET(makeFixedRoutes<N>());
+
+static_assert(FIXED_SET<10>.valid() && FIXED_SET<100>.valid() && FIXED_SET<1000>.valid(),
+              "벤치마크 경로의 완전 해시 표를 만들 수 없습니다");
+
+template <typename Fn>
+double nanosPerLookup(const std::vector<std::string> &paths, std::size_t lookups, Fn &&fn) {
+    auto begin = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < lookups; ++i) {
+        fn(paths[i % paths.size()]);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) /
+           static_cast<double>(lookups);
+}
+
+template <std::size_t N>
+void runLevel(std::size_t lookups, std::size_t &checksum) {
+    std::vector<std::string> names;
+    for (std::size_t i = 0; i < N; ++i) {
+        names.emplace_back(NAMES<N>.text[i], NAMES<N>.length[i]);
+    }
+
+    // 요청 경로 목록: 모든 경로를 4번씩 넣고 섞는다.
+    std::mt19937 rng(42);
+    std::vector<std::string> requests;
+    std::vector<std::string> param_requests;
+    for (int round = 0; round < 4; ++round) {
+        for (const std::string &name : names) {
+            requests.push_back(name);
+            param_requests.push_back(name + "/12345");
+        }
+    }
+    std::shuffle(requests.begin(), requests.end(), rng);
+    std::shuffle(param_requests.begin(), param_requests.end(), rng);
+
+    double chain_ns = nanosPerLookup(requests, lookups, [&](const std::string &path) {
+        for (std::size_t i = 0; i < names.size(); ++i) {
+            if (path == names[i]) {
+                checksum += i;
+                return;
+            }
+        }
+    });
+
+    double fixed_ns = nanosPerLookup(requests, lookups, [&](const std::string &path) {
+        RouteId id = NO_ROUTE;
+        if (FIXED_SET<N>.find(HttpMethod::kGet, path, id) == RouteStatus::kFound) {
+            checksum += id;
+        }
+    });
+
+    RadixRouter fixed_tree;
+    RadixRouter param_tree;
+    for (std::size_t i = 0; i < N; ++i) {
+        fixed_tree.add(HttpMethod::kGet, names[i], static_cast<RouteId>(i));
+        param_tree.add(HttpMethod::kGet, names[i] + "/:id", static_cast<RouteId>(i));
+    }
+    RouteParams params;
+    double tree_ns = nanosPerLookup(requests, lookups, [&](const std::string &path) {
+        RouteId id = NO_ROUTE;
+        if (fixed_tree.match(HttpMethod::kGet, path, id, params) == RouteStatus::kFound) {
+            checksum += id;
+        }
+    });
+    double param_ns = nanosPerLookup(param_requests, lookups, [&](const std::string &path) {
+        RouteId id = NO_ROUTE;
+        if (param_tree.match(HttpMethod::kGet, path, id, params) == RouteStatus::kFound) {
+            checksum += id + params.get("id").size();
+        }
+    });
+
+    std::printf("%8zu %14.1f %16.1f %16.1f %18.1f\n", N, chain_ns, fixed_ns, tree_ns, param_ns);
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+    std::size_t lookups = argc >= 2 ? std::strtoul(argv[1], nullptr, 10) : 2000000;
+    std::size_t checksum = 0;
+
+    std::printf("%8s %14s %16s %16s %18s  (ns/lookup)\n", "routes", "if-chain", "FixedRouteSet", "radix(fixed)",
+                "radix(:param)");
+    runLevel<10>(lookups, checksum);
+    runLevel<100>(lookups, checksum);
+    runLevel<1000>(lookups, checksum);
+    std::printf("조회 %zu회씩 (checksum %zu)\n", lookups, checksum);
+    return 0;
+}
@@ -0,0 +1,117 @@
+#!/usr/bin/env python3
+# webserv-cpp17 v1.6.0 벤치마크: 정적 파일 서빙 방식별 큰 파일 처리량(MB/s)과 작은 파일 처리량(req/s),
+# 요청당 서버 CPU 시간을 비교한다.
+# - sendfile+cache : 기본 경로(sendfile, FD/메타데이터 캐시)
+# - read+cache     : --static-copy (본문을 pread 로 읽어 send, FD 캐시는 사용)
+# - read+nocache   : --static-copy --file-cache-entries 0 (요청마다 open/fstat/read/close, read()+send() 기준선)
+# 사용법:
+#   python3 bench/static_files_bench.py build/webserv --duration 4
+import argparse
+import os
+import selectors
+import socket
+import subprocess
+import sys
+import tempfile
+import time
+
+MODES = [
+    ("sendfile+cache", []),
+    ("read+cache", ["--static-copy"]),
+    ("read+nocache", ["--static-copy", "--file-cache-entries", "0"]),
+]
+
+
+def cpu_seconds(pid):
+    with open(f"/proc/{pid}/schedstat") as f:
+        return int(f.read().split()[0]) / 1e9
+
+
+def request_for(path):
+    return f"GET {path} HTTP/1.1\r\nHost: bench\r\nConnection: keep-alive\r\n\r\n".encode()
+
+
+def run_clients(port, path, body_size, connections, duration):
+    # 헤더 길이를 한 번 측정해 두고, 이후에는 응답 전체 길이만큼 읽었는지로 완료를 판단한다.
+    probe = socket.create_connection(("127.0.0.1", port))
+    probe.sendall(request_for(path))
+    head = b""
+    while b"\r\n\r\n" not in head:
+        head += probe.recv(65536)
+    response_size = head.index(b"\r\n\r\n") + 4 + body_size
+    remaining = response_size - len(head)
+    buffer = bytearray(1 << 20)
+    view = memoryview(buffer)
+    while remaining > 0:
+        remaining -= probe.recv_into(view, min(remaining, len(buffer)))
+    probe.close()
+
+    sel = selectors.DefaultSelector()
+    request = request_for(path)
+    for _ in range(connections):
+        s = socket.create_connection(("127.0.0.1", port))
+        s.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        s.sendall(request)
+        s.setblocking(False)
+        sel.register(s, selectors.EVENT_READ, [response_size])
+    completed = 0
+    deadline = time.perf_counter() + duration
+    while time.perf_counter() < deadline:
+        for key, _ in sel.select(timeout=0.1):
+            state = key.data
+            n = key.fileobj.recv_into(view, min(state[0], len(buffer)))
+            if n == 0:
+                raise RuntimeError("서버가 연결을 닫았습니다")
+            state[0] -= n
+            if state[0] == 0:
+                completed += 1
+                state[0] = response_size
+                key.fileobj.send(request)
+    for key in list(sel.get_map().values()):
+        key.fileobj.close()
+    return completed
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("binary")
+    parser.add_argument("--port", type=int, default=9193)
+    parser.add_argument("--large-mb", type=int, default=64)
+    parser.add_argument("--small-bytes", type=int, default=1024)
+    parser.add_argument("--connections", type=int, default=4)
+    parser.add_argument("--duration", type=float, default=4.0)
+    args = parser.parse_args()
+
+    with tempfile.TemporaryDirectory() as root:
+        with open(os.path.join(root, "large.bin"), "wb") as f:
+            f.write(os.urandom(args.large_mb << 20))
+        with open(os.path.join(root, "small.txt"), "wb") as f:
+            f.write(b"x" * args.small_bytes)
+        large_size = args.large_mb << 20
+
+        print(f"{'mode':>15} {'large MB/s':>11} {'cpu ms/GB':>10} {'small req/s':>12} {'cpu us/req':>11}")
+        for name, extra in MODES:
+            server = subprocess.Popen(
+                [args.binary, str(args.port), "1000000000", "--max-runtime-sec", "0",
+                 "--idle-timeout-ms", "60000", "--root", root] + extra,
+                stderr=subprocess.DEVNULL)
+            try:
+                time.sleep(0.3)
+                before = cpu_seconds(server.pid)
+                large = run_clients(args.port, "/large.bin", large_size, 1, args.duration)
+                large_cpu = cpu_seconds(server.pid) - before
+                before = cpu_seconds(server.pid)
+                small = run_clients(args.port, "/small.txt", args.small_bytes, args.connections, args.duration)
+                small_cpu = cpu_seconds(server.pid) - before
+                large_bytes = large * large_size
+                print(f"{name:>15} {large_bytes / args.duration / 1e6:>11.0f} "
+                      f"{large_cpu * 1e3 / max(large_bytes / 1e9, 1e-9):>10.1f} "
+                      f"{small / args.duration:>12.0f} {small_cpu / max(small, 1) * 1e6:>11.2f}")
+            finally:
+                server.kill()
+                server.wait()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,191 @@
+/**
+ * [모듈] webserv-cpp17/bench/syscall_count.cpp
+ * 설명:
+ *   - 명령 하나를 ptrace 로 실행하며 모든 스레드의 시스템 호출 횟수를 이름별로 센다(strace -c -f 대용).
+ *   - SIGUSR1 을 받으면 지금까지 센 값을 지우고, SIGUSR2 를 받거나 대상이 끝나면 결과를 출력한다.
+ *     벤치마크가 워밍업을 마친 뒤 SIGUSR1, 측정 구간 끝에서 SIGUSR2 를 보내 구간 횟수만 얻는다.
+ *   - ptrace 정지 비용 때문에 대상이 크게 느려지므로 처리량 측정과는 따로 돌린다.
+ * 버전: v1.11.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.11.0-io-uring-backend.md
+ * 변경 이력:
+ *   - v1.11.0: epoll/io_uring 백엔드의 요청당 시스템 호출 수 비교용으로 추가
+ * 사용법:
+ *   - ./build/webserv_syscall_count <output_file> -- <command> [args...]
+ */
+
+#include <signal.h>
+#include <sys/ptrace.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+volatile sig_atomic_t g_reset = 0;
+volatile sig_atomic_t g_dump = 0;
+
+void onSignal(int signo) {
+    if (signo == SIGUSR1) {
+        g_reset = 1;
+    } else {
+        g_dump = 1;
+    }
+}
+
+// 서버 경로에서 나오는 호출만 이름을 붙이고 나머지는 번호로 적는다.
+const char *syscallName(long nr) {
+    switch (nr) {
+        case SYS_read: return "read";
+        case SYS_write: return "write";
+        case SYS_close: return "close";
+        case SYS_execve: return "execve";
+        case SYS_fstat: return "fstat";
+        case SYS_newfstatat: return "newfstatat";
+        case SYS_openat: return "openat";
+        case SYS_writev: return "writev";
+        case SYS_sendfile: return "sendfile";
+        case SYS_accept: return "accept";
+        case SYS_accept4: return "accept4";
+        case SYS_sendto: return "sendto";
+        case SYS_recvfrom: return "recvfrom";
+        case SYS_sendmsg: return "sendmsg";
+        case SYS_recvmsg: return "recvmsg";
+        case SYS_shutdown: return "shutdown";
+        case SYS_fcntl: return "fcntl";
+        case SYS_setsockopt: return "setsockopt";
+        case SYS_epoll_wait: return "epoll_wait";
+        case SYS_epoll_pwait: return "epoll_pwait";
+        case SYS_epoll_ctl: return "epoll_ctl";
+        case SYS_futex: return "futex";
+        case SYS_clock_gettime: return "clock_gettime";
+        case SYS_io_uring_enter: return "io_uring_enter";
+        case SYS_io_uring_register: return "io_uring_register";
+        case SYS_mmap: return "mmap";
+        case SYS_munmap: return "munmap";
+        case SYS_madvise: return "madvise";
+        default: return nullptr;
+    }
+}
+
+void dump(const char *path, const std::map<long, unsigned long long> &counts) {
+    std::vector<std::pair<unsigned long long, long>> sorted;
+    unsigned long long total = 0;
+    for (const auto &entry : counts) {
+        sorted.emplace_back(entry.second, entry.first);
+        total += entry.second;
+    }
+    std::sort(sorted.rbegin(), sorted.rend());
+
+    FILE *out = std::fopen(path, "w");
+    if (out == nullptr) {
+        std::perror("fopen");
+        return;
+    }
+    for (const auto &entry : sorted) {
+        const char *name = syscallName(entry.second);
+        if (name != nullptr) {
+            std::fprintf(out, "%s %llu\n", name, entry.first);
+        } else {
+            std::fprintf(out, "sys_%ld %llu\n", entry.second, entry.first);
+        }
+    }
+    std::fprintf(out, "total %llu\n", total);
+    std::fclose(out);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    if (argc < 4 || std::strcmp(argv[2], "--") != 0) {
+        std::fprintf(stderr, "사용법: %s <output_file> -- <command> [args...]\n", argv[0]);
+        return 1;
+    }
+    const char *output_path = argv[1];
+
+    struct sigaction action;
+    std::memset(&action, 0, sizeof(action));
+    action.sa_handler = onSignal;
+    sigaction(SIGUSR1, &action, nullptr);
+    sigaction(SIGUSR2, &action, nullptr);
+
+    pid_t child = fork();
+    if (child < 0) {
+        std::perror("fork");
+        return 1;
+    }
+    if (child == 0) {
+        ptrace(PTRACE_TRACEME, 0, nullptr, nullptr);
+        raise(SIGSTOP);
+        execvp(argv[3], argv + 3);
+        std::perror("execvp");
+        _exit(127);
+    }
+
+    int status = 0;
+    if (waitpid(child, &status, 0) < 0 || !WIFSTOPPED(status)) {
+        std::fprintf(stderr, "대상 프로세스를 멈추지 못했습니다\n");
+        return 1;
+    }
+    ptrace(PTRACE_SETOPTIONS, child, nullptr,
+           PTRACE_O_TRACESYSGOOD | PTRACE_O_TRACECLONE | PTRACE_O_TRACEEXEC | PTRACE_O_EXITKILL);
+    ptrace(PTRACE_SYSCALL, child, nullptr, 0);
+
+    std::map<long, unsigned long long> counts;
+    int exit_code = 0;
+    for (;;) {
+        pid_t tid = waitpid(-1, &status, __WALL);
+        if (g_reset) {
+            g_reset = 0;
+            counts.clear();
+        }
+        if (g_dump) {
+            g_dump = 0;
+            dump(output_path, counts);
+        }
+        if (tid < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;  // ECHILD: 추적하던 스레드가 모두 끝났다
+        }
+        if (WIFEXITED(status) || WIFSIGNALED(status)) {
+            if (tid == child) {
+                exit_code = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+            }
+            continue;
+        }
+        if (!WIFSTOPPED(status)) {
+            continue;
+        }
+
+        int signo = WSTOPSIG(status);
+        int inject = 0;
+        if (signo == (SIGTRAP | 0x80)) {
+            __ptrace_syscall_info info;
+            long size = ptrace(PTRACE_GET_SYSCALL_INFO, tid, sizeof(info), &info);
+            if (size > 0 && info.op == PTRACE_SYSCALL_INFO_ENTRY) {
+                ++counts[static_cast<long>(info.entry.nr)];
+            }
+        } else if (signo == SIGTRAP && (status >> 16) != 0) {
+            // PTRACE_EVENT_CLONE/EXEC 정지: 새 스레드는 자동으로 추적된다.
+        } else if (signo == SIGSTOP) {
+            // 새로 추적되는 스레드의 첫 정지. 대상에 다시 전달하지 않는다.
+        } else {
+            inject = signo;
+        }
+        ptrace(PTRACE_SYSCALL, tid, nullptr, inject);
+    }
+
+    dump(output_path, counts);
+    return exit_code;
+}
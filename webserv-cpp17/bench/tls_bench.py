@@ -0,0 +1,188 @@
+#!/usr/bin/env python3
+# webserv-cpp17 v1.22.0 벤치마크: TLS 핸드셰이크 처리율과 대용량 송신 처리량을 평문과 비교한다.
+# - handshake: 연결마다 `GET /health` 하나를 보내고 닫는다. plain(평문), full(매번 전체 핸드셰이크),
+#   resumed(첫 연결의 세션으로 재개)를 TLS 1.3 과 TLS 1.2(-12) 로 같은 파이썬 클라이언트에서 잰다.
+#   TLS 1.3 재개도 키 교환(ECDHE)은 새로 하고 인증서 서명만 빠진다. TLS 1.2 재개는 키 교환도 없다.
+#   클라이언트 비용이 섞이는 conn/s 보다 서버 프로세스 CPU 시간을 연결 수로 나눈 server_cpu_us/conn 이 서버 쪽 비용이다.
+# - bulk: keep-alive 연결 하나로 큰 정적 파일을 반복해서 받는다. plain 은 sendfile, tls 는 사용자 공간 암호화,
+#   ktls 는 `--tls-ktls on` 에서 커널 TLS 송신이 켜졌을 때만(webserv_tls_ktls_send_total > 0) 의미가 있다.
+#   server_cpu_ms/MB 가 서버 쪽 바이트당 비용이다.
+# - 서버 인증서는 실행마다 openssl 로 만드는 자체 서명 EC(P-256) 인증서다.
+# 사용법:
+#   python3 bench/tls_bench.py build/webserv --duration 3 --rounds 3
+#   python3 bench/tls_bench.py build/webserv --file-mb 64 --only bulk
+import argparse
+import os
+import re
+import shutil
+import socket
+import ssl
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+
+
+def cpu_seconds(pid):
+    with open(f"/proc/{pid}/stat") as f:
+        fields = f.read().rsplit(")", 1)[1].split()
+    return (int(fields[11]) + int(fields[12])) / os.sysconf("SC_CLK_TCK")
+
+
+def read_response(sock, pending, buffer):
+    while b"\r\n\r\n" not in pending:
+        chunk = sock.recv(65536)
+        if not chunk:
+            raise SystemExit("응답 도중 연결이 닫혔습니다")
+        pending += chunk
+    head, _, rest = pending.partition(b"\r\n\r\n")
+    length = int(re.search(rb"Content-Length: (\d+)", head, re.I).group(1))
+    received = min(len(rest), length)
+    view = memoryview(buffer)
+    while received < length:
+        count = sock.recv_into(view[:min(len(buffer), length - received)])
+        if count == 0:
+            raise SystemExit("본문 도중 연결이 닫혔습니다")
+        received += count
+    return rest[length:] if len(rest) > length else b""
+
+
+def ktls_connections(port):
+    with socket.create_connection(("127.0.0.1", port), timeout=5) as s:
+        s.sendall(b"GET /metrics HTTP/1.1\r\nHost: bench\r\nConnection: close\r\n\r\n")
+        body = b""
+        while True:
+            chunk = s.recv(65536)
+            if not chunk:
+                break
+            body += chunk
+    match = re.search(rb"webserv_tls_ktls_send_total (\d+)", body)
+    return int(match.group(1)) if match else 0
+
+
+def handshake_loop(mode, port, tls_port, ctx, duration):
+    resume = mode.startswith("resumed")
+    request = b"GET /health HTTP/1.1\r\nHost: bench\r\nConnection: close\r\n\r\n"
+    session = None
+    count, resumed = 0, 0
+    deadline = time.perf_counter() + duration
+    while time.perf_counter() < deadline:
+        raw = socket.create_connection(("127.0.0.1", port if mode == "plain" else tls_port))
+        # TLS 1.2 재개에서 클라이언트는 Finished 바로 뒤에 요청을 쓴다. Nagle 이 켜져 있으면 그 요청이
+        # 서버의 지연 ACK(40ms)를 기다린다. 브라우저처럼 끄고 잰다.
+        raw.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        sock = raw if mode == "plain" else ctx.wrap_socket(raw, server_hostname="localhost", session=session)
+        with sock:
+            sock.sendall(request)
+            while sock.recv(65536):
+                pass
+            if resume:
+                resumed += 1 if sock.session_reused else 0
+                if session is None:
+                    session = sock.session
+        count += 1
+    return count, resumed
+
+
+def bulk_loop(mode, port, tls_port, ctx, duration, file_bytes):
+    request = b"GET /big.bin HTTP/1.1\r\nHost: bench\r\n\r\n"
+    buffer = bytearray(1 << 20)
+    raw = socket.create_connection(("127.0.0.1", port if mode == "plain" else tls_port))
+    sock = raw if mode == "plain" else ctx.wrap_socket(raw, server_hostname="localhost")
+    total = 0
+    with sock:
+        pending = b""
+        deadline = time.perf_counter() + duration
+        while time.perf_counter() < deadline:
+            sock.sendall(request)
+            pending = read_response(sock, pending, buffer)
+            total += file_bytes
+    return total
+
+
+def run_server(binary, port, tls_port, root, cert, key, options):
+    server = subprocess.Popen(
+        [binary, str(port), "--unlimited", "--workers", "1", "--idle-timeout-ms", "60000", "--root", root,
+         "--tls-port", str(tls_port), "--tls-cert", cert, "--tls-key", key] + options,
+        stderr=subprocess.DEVNULL)
+    time.sleep(0.3)
+    return server
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("binary")
+    parser.add_argument("--port", type=int, default=9191)
+    parser.add_argument("--tls-port", type=int, default=9192)
+    parser.add_argument("--duration", type=float, default=3)
+    parser.add_argument("--rounds", type=int, default=3)
+    parser.add_argument("--file-mb", type=int, default=32)
+    parser.add_argument("--only", choices=["handshake", "bulk"])
+    args = parser.parse_args()
+
+    work = tempfile.mkdtemp(prefix="webserv-tls-bench-")
+    try:
+        cert, key = os.path.join(work, "cert.pem"), os.path.join(work, "key.pem")
+        subprocess.run(["openssl", "req", "-x509", "-newkey", "ec", "-pkeyopt", "ec_paramgen_curve:prime256v1",
+                        "-nodes", "-days", "1", "-subj", "/CN=localhost",
+                        "-addext", "subjectAltName=DNS:localhost,IP:127.0.0.1", "-keyout", key, "-out", cert],
+                       check=True, capture_output=True)
+        root = os.path.join(work, "root")
+        os.mkdir(root)
+        file_bytes = args.file_mb << 20
+        with open(os.path.join(root, "big.bin"), "wb") as f:
+            f.write(os.urandom(file_bytes))
+        ctx = ssl.SSLContext(ssl.PROTOCOL_TLS_CLIENT)
+        ctx.load_verify_locations(cert)
+
+        if args.only in (None, "handshake"):
+            tls12 = ssl.SSLContext(ssl.PROTOCOL_TLS_CLIENT)
+            tls12.load_verify_locations(cert)
+            tls12.maximum_version = ssl.TLSVersion.TLSv1_2
+            print(f"{'handshake':>10} {'conn/s':>8} {'rounds':>22} {'server_cpu_us/conn':>19} {'resumed':>8}")
+            for mode in ("plain", "full", "resumed", "full-12", "resumed-12"):
+                client = tls12 if mode.endswith("-12") else ctx
+                rates, cpu, connections, resumed = [], 0.0, 0, 0
+                for _ in range(args.rounds):
+                    server = run_server(args.binary, args.port, args.tls_port, root, cert, key, [])
+                    try:
+                        before = cpu_seconds(server.pid)
+                        count, reused = handshake_loop(mode, args.port, args.tls_port, client, args.duration)
+                        cpu += cpu_seconds(server.pid) - before
+                    finally:
+                        server.terminate()
+                        server.wait()
+                    rates.append(count / args.duration)
+                    connections += count
+                    resumed += reused
+                print(f"{mode:>10} {statistics.median(rates):>8.0f} {' / '.join('%.0f' % r for r in rates):>22} "
+                      f"{cpu / connections * 1e6:>19.1f} {resumed:>8}")
+
+        if args.only in (None, "bulk"):
+            print(f"{'bulk':>10} {'MB/s':>8} {'rounds':>22} {'server_cpu_ms/MB':>19} {'ktls':>8}")
+            for mode, options in (("plain", []), ("tls", ["--tls-ktls", "off"]), ("ktls", ["--tls-ktls", "on"])):
+                rates, cpu, moved, ktls = [], 0.0, 0, 0
+                for _ in range(args.rounds):
+                    server = run_server(args.binary, args.port, args.tls_port, root, cert, key, options)
+                    try:
+                        before = cpu_seconds(server.pid)
+                        started = time.perf_counter()
+                        total = bulk_loop(mode, args.port, args.tls_port, ctx, args.duration, file_bytes)
+                        elapsed = time.perf_counter() - started
+                        cpu += cpu_seconds(server.pid) - before
+                        ktls += ktls_connections(args.port)
+                    finally:
+                        server.terminate()
+                        server.wait()
+                    rates.append(total / elapsed / 1e6)
+                    moved += total
+                print(f"{mode:>10} {statistics.median(rates):>8.0f} {' / '.join('%.0f' % r for r in rates):>22} "
+                      f"{cpu / (moved / 1e6) * 1e3:>19.2f} {ktls:>8}")
+    finally:
+        shutil.rmtree(work)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
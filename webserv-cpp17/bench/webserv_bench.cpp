@@ -0,0 +1,838 @@
+/**
+ * [모듈] webserv-cpp17/bench/webserv_bench.cpp
+ * 설명:
+ *   - wrk 와 비슷한 HTTP/1.1 부하 생성기. 스레드마다 epoll 루프 하나가 keep-alive 연결 여러 개로 같은 요청을
+ *     보내고, 초당 요청 수와 지연 백분위 분포를 낸다.
+ *     - 폐쇄 루프(기본): 연결마다 파이프라이닝 깊이만큼 요청을 띄워 두고, 응답이 오는 대로 다음 요청을 보낸다.
+ *     - 고정 속도(`--rate N`): 요청마다 보내야 했던 시각을 미리 정하고 지연을 그 시각부터 잰다. 서버가 밀려
+ *       제때 보내지 못한 요청의 대기 시간도 지연에 들어간다(coordinated omission 보정, wrk2 방식).
+ *   - 응답 헤더와 본문 경계는 리버스 프록시와 같은 parseResponseHead/responseFramingFor/BodyDecoder 로 찾는다.
+ *     본문 끝을 연결 종료로 알리는 응답은 지원하지 않는다(형식 오류로 센다).
+ *   - 워밍업 구간의 응답은 세지 않는다. 측정 구간에 끝난 응답만 처리량과 지연에 들어간다.
+ *   - `--bind ADDR` 는 모든 연결의 출발 주소를 정한다. 루프백이면 127.0.0.2 처럼 다른 주소로 붙어 서버가
+ *     다른 클라이언트로 보게 할 수 있다.
+ * 버전: v1.24.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.19.0-load-generator.md
+ *   - design/webserv-cpp17/v1.24.0-client-limits.md
+ * 변경 이력:
+ *   - v1.19.0: 부하 생성기 추가
+ *   - v1.24.0: 출발 주소를 정하는 --bind 옵션 추가
+ * 사용법:
+ *   - ./build/webserv_bench [--threads N] [--connections N] [--duration-sec N] [--warmup-sec N]
+ *       [--pipeline N] [--rate N] [--path PATH] [--header 'Name: value'] [--bind ADDR] HOST:PORT
+ */
+
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "io_buffer.hpp"
+#include "proxy.hpp"
+#include "request_body.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t RECV_CHUNK = 16 * 1024;
+constexpr std::uint64_t TIMER_TOKEN = UINT64_MAX;
+constexpr auto RECONNECT_DELAY = std::chrono::milliseconds(10);
+constexpr auto MAX_WAIT = std::chrono::milliseconds(100);
+
+struct Options {
+    std::string host;
+    std::string port;
+    std::string path = "/health";
+    std::vector<std::string> headers;
+    std::string bind;  // 비어 있지 않으면 연결마다 이 출발 주소에 bind 한다
+    std::size_t threads = 2;
+    std::size_t connections = 64;
+    std::size_t pipeline = 1;
+    double rate = 0.0;  // 모든 연결을 합친 초당 요청 수. 0 이면 폐쇄 루프
+    unsigned duration_sec = 10;
+    unsigned warmup_sec = 1;
+};
+
+bool parseUnsigned(const char *text, unsigned long &out) {
+    if (text == nullptr || *text == '\0') {
+        return false;
+    }
+    char *end = nullptr;
+    out = std::strtoul(text, &end, 10);
+    return end != nullptr && *end == '\0';
+}
+
+bool parseOptions(int argc, char *argv[], Options &options, std::string &error) {
+    for (int i = 1; i < argc; ++i) {
+        const char *arg = argv[i];
+        if (std::strncmp(arg, "--", 2) != 0) {
+            std::string target = arg;
+            std::size_t colon = target.rfind(':');
+            if (!options.host.empty() || colon == std::string::npos || colon == 0 || colon + 1 == target.size()) {
+                error = std::string("대상은 HOST:PORT 하나여야 합니다: ") + arg;
+                return false;
+            }
+            options.host = target.substr(0, colon);
+            options.port = target.substr(colon + 1);
+            continue;
+        }
+        if (i + 1 >= argc) {
+            error = std::string("옵션 값이 없습니다: ") + arg;
+            return false;
+        }
+        const char *value = argv[++i];
+        if (std::strcmp(arg, "--path") == 0) {
+            if (value[0] != '/') {
+                error = "--path 는 '/' 로 시작해야 합니다.";
+                return false;
+            }
+            options.path = value;
+            continue;
+        }
+        if (std::strcmp(arg, "--header") == 0) {
+            if (std::strchr(value, ':') == nullptr) {
+                error = "--header 값은 'Name: value' 형식이어야 합니다.";
+                return false;
+            }
+            options.headers.emplace_back(value);
+            continue;
+        }
+        if (std::strcmp(arg, "--bind") == 0) {
+            options.bind = value;
+            continue;
+        }
+        unsigned long number = 0;
+        if (!parseUnsigned(value, number)) {
+            error = std::string("옵션 값이 숫자가 아닙니다: ") + arg;
+            return false;
+        }
+        if (std::strcmp(arg, "--threads") == 0) {
+            options.threads = number;
+        } else if (std::strcmp(arg, "--connections") == 0) {
+            options.connections = number;
+        } else if (std::strcmp(arg, "--pipeline") == 0) {
+            options.pipeline = number;
+        } else if (std::strcmp(arg, "--rate") == 0) {
+            options.rate = static_cast<double>(number);
+        } else if (std::strcmp(arg, "--duration-sec") == 0) {
+            options.duration_sec = static_cast<unsigned>(number);
+        } else if (std::strcmp(arg, "--warmup-sec") == 0) {
+            options.warmup_sec = static_cast<unsigned>(number);
+        } else {
+            error = std::string("알 수 없는 옵션: ") + arg;
+            return false;
+        }
+    }
+    if (options.host.empty()) {
+        error = "대상 HOST:PORT 가 없습니다.";
+        return false;
+    }
+    if (options.threads == 0 || options.connections == 0 || options.pipeline == 0 || options.duration_sec == 0) {
+        error = "--threads, --connections, --pipeline, --duration-sec 는 1 이상이어야 합니다.";
+        return false;
+    }
+    options.threads = std::min(options.threads, options.connections);
+    return true;
+}
+
+/**
+ * LatencyHistogram
+ * 설명:
+ *   - 나노초 지연을 로그-선형 구간에 센다(HdrHistogram 과 같은 방식). 128 보다 작은 값은 1ns 칸이고,
+ *     그 위로는 2의 거듭제곱 구간 하나를 64칸으로 나누므로 상대 오차가 1/64(1.6%) 안이다.
+ *   - 기록은 덧셈 하나이고 스레드마다 따로 둔 뒤 끝에 합친다.
+ */
+class LatencyHistogram {
+ public:
+    static constexpr unsigned SUB_BITS = 7;
+    static constexpr std::uint64_t SUB_BUCKETS = std::uint64_t{1} << SUB_BITS;
+    static constexpr std::uint64_t HALF = SUB_BUCKETS / 2;
+    static constexpr unsigned MAX_BITS = 40;  // 약 1100초에서 자른다
+
+    LatencyHistogram() : counts_(SUB_BUCKETS + (MAX_BITS - SUB_BITS) * HALF, 0) {}
+
+    void record(std::uint64_t nanos) {
+        nanos = std::min(nanos, (std::uint64_t{1} << MAX_BITS) - 1);
+        ++counts_[indexOf(nanos)];
+        ++total_;
+        sum_ += nanos;
+        max_ = std::max(max_, nanos);
+    }
+
+    void merge(const LatencyHistogram &other) {
+        for (std::size_t i = 0; i < counts_.size(); ++i) {
+            counts_[i] += other.counts_[i];
+        }
+        total_ += other.total_;
+        sum_ += other.sum_;
+        max_ = std::max(max_, other.max_);
+    }
+
+    std::uint64_t total() const { return total_; }
+    std::uint64_t max() const { return max_; }
+    double mean() const { return total_ == 0 ? 0.0 : static_cast<double>(sum_) / static_cast<double>(total_); }
+
+    // 기록값의 fraction 이상을 덮는 가장 작은 칸의 상한. 실제 최댓값을 넘지 않는다.
+    std::uint64_t percentile(double fraction) const {
+        if (total_ == 0) {
+            return 0;
+        }
+        auto rank = static_cast<std::uint64_t>(std::ceil(fraction * static_cast<double>(total_)));
+        rank = std::max<std::uint64_t>(rank, 1);
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < counts_.size(); ++i) {
+            seen += counts_[i];
+            if (seen >= rank) {
+                return std::min(upperBound(i), max_);
+            }
+        }
+        return max_;
+    }
+
+    // value 가 든 칸까지의 기록 수.
+    std::uint64_t countAtOrBelow(std::uint64_t value) const {
+        std::size_t last = indexOf(std::min(value, (std::uint64_t{1} << MAX_BITS) - 1));
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i <= last; ++i) {
+            seen += counts_[i];
+        }
+        return seen;
+    }
+
+ private:
+    static std::size_t indexOf(std::uint64_t value) {
+        unsigned msb = 63u - static_cast<unsigned>(__builtin_clzll(value | 1));
+        if (msb < SUB_BITS) {
+            return static_cast<std::size_t>(value);
+        }
+        unsigned shift = msb - SUB_BITS + 1;
+        return static_cast<std::size_t>(SUB_BUCKETS + (shift - 1) * HALF + ((value >> shift) - HALF));
+    }
+
+    static std::uint64_t upperBound(std::size_t index) {
+        if (index < SUB_BUCKETS) {
+            return index;
+        }
+        std::size_t offset = index - SUB_BUCKETS;
+        unsigned shift = static_cast<unsigned>(offset / HALF) + 1;
+        std::uint64_t top = offset % HALF + HALF;
+        return ((top + 1) << shift) - 1;
+    }
+
+    std::vector<std::uint64_t> counts_;
+    std::uint64_t total_ = 0;
+    std::uint64_t sum_ = 0;
+    std::uint64_t max_ = 0;
+};
+
+struct Stats {
+    LatencyHistogram latency;
+    std::uint64_t responses = 0;
+    std::uint64_t bytes = 0;
+    std::array<std::uint64_t, 6> status_classes{};  // [1..5] 이 1xx~5xx
+    std::uint64_t connect_errors = 0;
+    std::uint64_t read_errors = 0;
+    std::uint64_t closed = 0;        // 서버가 닫아 다시 연결한 횟수
+    std::uint64_t parse_errors = 0;
+    std::uint64_t lost = 0;          // 응답을 받기 전에 연결이 끊긴 요청
+
+    void merge(const Stats &other) {
+        latency.merge(other.latency);
+        responses += other.responses;
+        bytes += other.bytes;
+        for (std::size_t i = 0; i < status_classes.size(); ++i) {
+            status_classes[i] += other.status_classes[i];
+        }
+        connect_errors += other.connect_errors;
+        read_errors += other.read_errors;
+        closed += other.closed;
+        parse_errors += other.parse_errors;
+        lost += other.lost;
+    }
+
+    std::uint64_t errors() const { return connect_errors + read_errors + parse_errors + lost; }
+};
+
+struct BenchConnection {
+    int fd = -1;
+    bool connected = false;
+    Clock::time_point reconnect_at;
+    InputBuffer input;
+    std::string output;  // 아직 못 보낸 요청 바이트
+    std::size_t output_sent = 0;
+    // 띄운 요청의 시작 시각 링. 고정 속도면 보냈어야 했던 시각이다.
+    std::vector<Clock::time_point> starts;
+    std::size_t first = 0;
+    std::size_t in_flight = 0;
+    Clock::time_point next_send;  // 고정 속도 모드에서 다음 요청을 보내야 하는 시각
+    // 응답 해석 상태
+    std::size_t scan = 0;
+    bool reading_body = false;
+    bool keep_alive = true;
+    int status = 0;
+    BodyDecoder decoder;
+};
+
+/**
+ * LoadThread
+ * 역할:
+ *   - 스레드 하나의 epoll 루프. 맡은 연결들을 열고, 요청을 띄우고, 응답을 해석해 Stats 에 센다.
+ * 주의 사항:
+ *   - 연결이 끊기면(서버 종료, `Connection: close`, 오류) 바로 다시 연결한다. 연결 자체가 실패하면
+ *     RECONNECT_DELAY 뒤에 다시 시도한다.
+ *   - 고정 속도 모드는 다음 예정 시각에 맞춰 timerfd 를 건다. epoll_wait 의 밀리초 단위 대기로는
+ *     요청 간격이 1ms 보다 짧을 때 보내는 시각이 밀려 지연이 부풀기 때문이다.
+ */
+class LoadThread {
+ public:
+    LoadThread(const Options &options, const addrinfo &address, const addrinfo *source, const std::string &request,
+               std::size_t connections, double rate)
+        : options_(options), address_(address), source_(source), request_(request), conns_(connections) {
+        if (rate > 0.0) {
+            // 연결마다 같은 속도로 보낸다. 시작 시각은 간격 안에서 고르게 흩어 한꺼번에 몰리지 않게 한다.
+            interval_ = std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>(static_cast<double>(connections) / rate));
+        }
+        for (auto &conn : conns_) {
+            conn.starts.resize(options_.pipeline);
+        }
+    }
+
+    void run(Clock::time_point begin, Clock::time_point measure_from, Clock::time_point until) {
+        measure_from_ = measure_from;
+        epoll_ = epoll_create1(EPOLL_CLOEXEC);
+        timer_ = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        if (epoll_ < 0 || timer_ < 0) {
+            std::perror("epoll_create1/timerfd_create");
+            return;
+        }
+        epoll_event timer_event{};
+        timer_event.events = EPOLLIN;
+        timer_event.data.u64 = TIMER_TOKEN;
+        epoll_ctl(epoll_, EPOLL_CTL_ADD, timer_, &timer_event);
+
+        for (std::size_t i = 0; i < conns_.size(); ++i) {
+            conns_[i].next_send = begin + interval_ * static_cast<Clock::rep>(i) / static_cast<Clock::rep>(conns_.size());
+            open(i, begin);
+        }
+
+        std::array<epoll_event, 256> events;
+        while (true) {
+            Clock::time_point now = Clock::now();
+            if (now >= until) {
+                break;
+            }
+            Clock::time_point wake = std::min(until, now + MAX_WAIT);
+            if (reopen_pending_ > 0 || rated()) {
+                wake = std::min(wake, sweep(now));
+            }
+            int timeout = 0;
+            if (wake > now) {
+                if (rated()) {
+                    armTimer(wake);
+                    timeout = static_cast<int>(std::chrono::ceil<std::chrono::milliseconds>(until - now).count());
+                } else {
+                    timeout = static_cast<int>(std::chrono::ceil<std::chrono::milliseconds>(wake - now).count());
+                }
+            }
+            int ready = epoll_wait(epoll_, events.data(), static_cast<int>(events.size()), timeout);
+            if (ready < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                std::perror("epoll_wait");
+                break;
+            }
+            now = Clock::now();
+            for (int i = 0; i < ready; ++i) {
+                if (events[i].data.u64 == TIMER_TOKEN) {
+                    std::uint64_t expirations = 0;
+                    ssize_t ignored = read(timer_, &expirations, sizeof(expirations));
+                    (void)ignored;
+                    continue;
+                }
+                handleEvent(static_cast<std::size_t>(events[i].data.u64), events[i].events, now);
+            }
+        }
+
+        for (auto &conn : conns_) {
+            if (conn.fd >= 0) {
+                close(conn.fd);
+            }
+        }
+        close(timer_);
+        close(epoll_);
+    }
+
+    const Stats &stats() const { return stats_; }
+
+ private:
+    bool rated() const { return interval_ > Clock::duration::zero(); }
+    bool measuring(Clock::time_point now) const { return now >= measure_from_; }
+
+    // 비차단 connect 를 시작한다. 완료는 EPOLLOUT 으로 온다.
+    void open(std::size_t index, Clock::time_point now) {
+        BenchConnection &conn = conns_[index];
+        conn.fd = socket(address_.ai_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (conn.fd >= 0) {
+            int on = 1;
+            setsockopt(conn.fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+            bool bound = source_ == nullptr || bind(conn.fd, source_->ai_addr, source_->ai_addrlen) == 0;
+            if (bound && (connect(conn.fd, address_.ai_addr, address_.ai_addrlen) == 0 || errno == EINPROGRESS)) {
+                epoll_event event{};
+                event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+                event.data.u64 = index;
+                if (epoll_ctl(epoll_, EPOLL_CTL_ADD, conn.fd, &event) == 0) {
+                    return;
+                }
+            }
+            close(conn.fd);
+            conn.fd = -1;
+        }
+        if (measuring(now)) {
+            ++stats_.connect_errors;
+        }
+        conn.reconnect_at = now + RECONNECT_DELAY;
+        ++reopen_pending_;
+    }
+
+    // 연결을 닫고 상태를 비운 뒤 다시 연결한다. 답을 못 받은 요청은 잃은 것으로 센다.
+    void reopen(std::size_t index, Clock::time_point now) {
+        BenchConnection &conn = conns_[index];
+        if (measuring(now)) {
+            stats_.lost += conn.in_flight;
+        }
+        close(conn.fd);
+        conn.fd = -1;
+        conn.connected = false;
+        conn.input.clear();
+        conn.output.clear();
+        conn.output_sent = 0;
+        conn.first = 0;
+        conn.in_flight = 0;
+        conn.scan = 0;
+        conn.reading_body = false;
+        conn.decoder.reset();
+        open(index, now);
+    }
+
+    /**
+     * sweep
+     * 설명:
+     *   - 다시 연결할 때가 된 연결을 열고, 고정 속도 모드면 예정 시각이 지난 요청을 띄운다.
+     *   - 다음에 깨어나야 할 가장 이른 시각을 돌려준다.
+     */
+    Clock::time_point sweep(Clock::time_point now) {
+        Clock::time_point wake = Clock::time_point::max();
+        for (std::size_t i = 0; i < conns_.size(); ++i) {
+            BenchConnection &conn = conns_[i];
+            if (conn.fd < 0) {
+                if (conn.reconnect_at <= now) {
+                    --reopen_pending_;
+                    open(i, now);
+                }
+                if (conn.fd < 0) {
+                    wake = std::min(wake, conn.reconnect_at);
+                }
+                continue;
+            }
+            if (!rated() || !conn.connected) {
+                continue;
+            }
+            schedule(conn, now);
+            flush(i, now);
+            if (conn.in_flight < options_.pipeline) {
+                wake = std::min(wake, conn.next_send);
+            }
+        }
+        return wake;
+    }
+
+    void armTimer(Clock::time_point when) {
+        auto since_epoch = std::chrono::duration_cast<std::chrono::nanoseconds>(when.time_since_epoch()).count();
+        itimerspec spec{};
+        spec.it_value.tv_sec = static_cast<time_t>(since_epoch / 1000000000);
+        spec.it_value.tv_nsec = static_cast<long>(since_epoch % 1000000000);
+        timerfd_settime(timer_, TFD_TIMER_ABSTIME, &spec, nullptr);
+    }
+
+    void enqueue(BenchConnection &conn, Clock::time_point start) {
+        conn.output.append(request_);
+        conn.starts[(conn.first + conn.in_flight) % options_.pipeline] = start;
+        ++conn.in_flight;
+    }
+
+    // 고정 속도: 예정 시각이 지난 요청을 파이프라이닝 깊이까지 띄운다. 시작 시각은 보낸 때가 아니라 예정 시각이다.
+    void schedule(BenchConnection &conn, Clock::time_point now) {
+        while (conn.in_flight < options_.pipeline && conn.next_send <= now) {
+            enqueue(conn, conn.next_send);
+            conn.next_send += interval_;
+        }
+    }
+
+    // 폐쇄 루프: 파이프라이닝 깊이까지 지금 시각으로 채운다.
+    void fill(BenchConnection &conn, Clock::time_point now) {
+        while (conn.in_flight < options_.pipeline) {
+            enqueue(conn, now);
+        }
+    }
+
+    void flush(std::size_t index, Clock::time_point now) {
+        BenchConnection &conn = conns_[index];
+        while (conn.output_sent < conn.output.size()) {
+            ssize_t sent = send(conn.fd, conn.output.data() + conn.output_sent, conn.output.size() - conn.output_sent,
+                                MSG_NOSIGNAL);
+            if (sent > 0) {
+                conn.output_sent += static_cast<std::size_t>(sent);
+                continue;
+            }
+            if (sent < 0 && errno == EINTR) {
+                continue;
+            }
+            if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                return;
+            }
+            if (measuring(now)) {
+                ++stats_.read_errors;
+            }
+            reopen(index, now);
+            return;
+        }
+        conn.output.clear();
+        conn.output_sent = 0;
+    }
+
+    void handleEvent(std::size_t index, std::uint32_t events, Clock::time_point now) {
+        BenchConnection &conn = conns_[index];
+        if (conn.fd < 0) {
+            return;
+        }
+        if (!conn.connected) {
+            int error = 0;
+            socklen_t length = sizeof(error);
+            getsockopt(conn.fd, SOL_SOCKET, SO_ERROR, &error, &length);
+            if (error != 0 || (events & (EPOLLERR | EPOLLHUP)) != 0) {
+                close(conn.fd);
+                conn.fd = -1;
+                if (measuring(now)) {
+                    ++stats_.connect_errors;
+                }
+                conn.reconnect_at = now + RECONNECT_DELAY;
+                ++reopen_pending_;
+                return;
+            }
+            if ((events & EPOLLOUT) == 0) {
+                return;
+            }
+            conn.connected = true;
+            if (rated()) {
+                schedule(conn, now);
+            } else {
+                fill(conn, now);
+            }
+        }
+        if ((events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) != 0 && !receive(index, now)) {
+            return;
+        }
+        flush(index, now);
+    }
+
+    // 받을 수 있는 만큼 받아 응답을 해석한다. 연결을 다시 열었으면 false.
+    bool receive(std::size_t index, Clock::time_point now) {
+        BenchConnection &conn = conns_[index];
+        while (true) {
+            char *destination = conn.input.prepare(RECV_CHUNK);
+            ssize_t received = recv(conn.fd, destination, conn.input.writable(), 0);
+            if (received > 0) {
+                conn.input.commit(static_cast<std::size_t>(received));
+                now = Clock::now();
+                if (measuring(now)) {
+                    stats_.bytes += static_cast<std::uint64_t>(received);
+                }
+                if (!parse(conn, now)) {
+                    if (measuring(now)) {
+                        ++stats_.parse_errors;
+                    }
+                    reopen(index, now);
+                    return false;
+                }
+                if (!conn.keep_alive) {
+                    if (measuring(now)) {
+                        ++stats_.closed;
+                    }
+                    reopen(index, now);
+                    return false;
+                }
+                continue;
+            }
+            if (received < 0 && errno == EINTR) {
+                continue;
+            }
+            if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                return true;
+            }
+            if (measuring(now)) {
+                if (received == 0) {
+                    ++stats_.closed;
+                } else {
+                    ++stats_.read_errors;
+                }
+            }
+            reopen(index, now);
+            return false;
+        }
+    }
+
+    // 입력 버퍼의 완성된 응답을 모두 해석한다. 형식 오류면 false.
+    bool parse(BenchConnection &conn, Clock::time_point now) {
+        while (!conn.input.empty() || conn.reading_body) {
+            if (!conn.reading_body) {
+                ResponseHead head;
+                ParseStatus status = parseResponseHead(conn.input.data(), conn.input.size(), conn.scan, head);
+                if (status == ParseStatus::kIncomplete) {
+                    return true;
+                }
+                if (status == ParseStatus::kError) {
+                    return false;
+                }
+                if (head.status < 200) {
+                    conn.input.consume(head.length);
+                    conn.scan = 0;
+                    continue;
+                }
+                BodySpec spec;
+                ResponseFraming framing = responseFramingFor(head, false, spec);
+                if (framing == ResponseFraming::kInvalid || framing == ResponseFraming::kUntilClose) {
+                    return false;
+                }
+                conn.status = head.status;
+                conn.keep_alive = upstreamKeepsAlive(head);
+                conn.input.consume(head.length);
+                conn.scan = 0;
+                if (framing == ResponseFraming::kNone) {
+                    if (!complete(conn, now)) {
+                        return false;
+                    }
+                    continue;
+                }
+                conn.decoder.start(spec, UINT64_MAX);
+                conn.reading_body = true;
+            }
+            std::size_t consumed = 0;
+            std::string_view slice;
+            BodyStatus status = conn.decoder.next(conn.input.data(), conn.input.size(), consumed, slice);
+            conn.input.consume(consumed);
+            if (status == BodyStatus::kSlice) {
+                continue;
+            }
+            if (status == BodyStatus::kNeedMore) {
+                return true;
+            }
+            if (status != BodyStatus::kDone) {
+                return false;
+            }
+            conn.reading_body = false;
+            conn.decoder.reset();
+            if (!complete(conn, now)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // 응답 하나가 끝났다. 보낸 적 없는 요청의 응답이면 false.
+    bool complete(BenchConnection &conn, Clock::time_point now) {
+        if (conn.in_flight == 0) {
+            return false;
+        }
+        Clock::time_point start = conn.starts[conn.first];
+        conn.first = (conn.first + 1) % options_.pipeline;
+        --conn.in_flight;
+        if (measuring(now)) {
+            stats_.latency.record(
+                static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - start).count()));
+            ++stats_.responses;
+            ++stats_.status_classes[static_cast<std::size_t>(std::clamp(conn.status / 100, 0, 5))];
+        }
+        if (conn.keep_alive) {
+            if (rated()) {
+                schedule(conn, now);
+            } else {
+                fill(conn, now);
+            }
+        }
+        return true;
+    }
+
+    const Options &options_;
+    const addrinfo &address_;
+    const addrinfo *source_;  // --bind 출발 주소, 없으면 nullptr
+    const std::string &request_;
+    std::vector<BenchConnection> conns_;
+    Clock::duration interval_ = Clock::duration::zero();
+    Clock::time_point measure_from_;
+    int epoll_ = -1;
+    int timer_ = -1;
+    std::size_t reopen_pending_ = 0;
+    Stats stats_;
+};
+
+std::string buildRequest(const Options &options) {
+    std::string request = "GET " + options.path + " HTTP/1.1\r\nHost: " + options.host + ":" + options.port + "\r\n";
+    for (const auto &header : options.headers) {
+        request += header;
+        request += "\r\n";
+    }
+    request += "\r\n";
+    return request;
+}
+
+void raiseFdLimit() {
+    rlimit limit{};
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+}
+
+double micros(std::uint64_t nanos) { return static_cast<double>(nanos) / 1000.0; }
+
+void report(const Options &options, const Stats &stats, double seconds) {
+    const LatencyHistogram &latency = stats.latency;
+    double rps = static_cast<double>(stats.responses) / seconds;
+    std::printf("  응답 %llu개, %.1f req/s, 수신 %.2f MB/s\n", static_cast<unsigned long long>(stats.responses), rps,
+                static_cast<double>(stats.bytes) / seconds / (1024.0 * 1024.0));
+    std::printf("  상태 2xx %llu, 3xx %llu, 4xx %llu, 5xx %llu\n",
+                static_cast<unsigned long long>(stats.status_classes[2]),
+                static_cast<unsigned long long>(stats.status_classes[3]),
+                static_cast<unsigned long long>(stats.status_classes[4]),
+                static_cast<unsigned long long>(stats.status_classes[5]));
+    std::printf("  오류 연결 %llu, 수신 %llu, 형식 %llu, 잃은 요청 %llu / 서버 종료 후 재연결 %llu\n",
+                static_cast<unsigned long long>(stats.connect_errors),
+                static_cast<unsigned long long>(stats.read_errors),
+                static_cast<unsigned long long>(stats.parse_errors), static_cast<unsigned long long>(stats.lost),
+                static_cast<unsigned long long>(stats.closed));
+    std::printf("  지연(us) 평균 %.1f, 최대 %.1f\n", latency.mean() / 1000.0, micros(latency.max()));
+
+    // 백분위 분포: 남은 비율을 반씩 줄여 가며(50, 75, 87.5, ...) 꼬리를 촘촘히 본다.
+    std::printf("  %12s %10s %12s\n", "percentile", "us", "count");
+    for (int step = 1; latency.total() > 0; ++step) {
+        double fraction = 1.0 - std::ldexp(1.0, -step);
+        std::uint64_t value = latency.percentile(fraction);
+        std::printf("  %12.5f %10.1f %12llu\n", fraction * 100.0, micros(value),
+                    static_cast<unsigned long long>(latency.countAtOrBelow(value)));
+        if (std::ldexp(1.0, -step) * static_cast<double>(latency.total()) < 1.0) {
+            break;
+        }
+    }
+    std::printf("  %12.5f %10.1f %12llu\n", 100.0, micros(latency.max()),
+                static_cast<unsigned long long>(latency.total()));
+
+    // 스크립트가 읽는 한 줄 요약.
+    std::printf("summary mode=%s requests=%llu rps=%.1f p50_us=%.1f p90_us=%.1f p99_us=%.1f p999_us=%.1f "
+                "max_us=%.1f non2xx=%llu errors=%llu\n",
+                options.rate > 0.0 ? "rate" : "closed", static_cast<unsigned long long>(stats.responses), rps,
+                micros(latency.percentile(0.5)), micros(latency.percentile(0.9)), micros(latency.percentile(0.99)),
+                micros(latency.percentile(0.999)), micros(latency.max()),
+                static_cast<unsigned long long>(stats.responses - stats.status_classes[2]),
+                static_cast<unsigned long long>(stats.errors()));
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+    Options options;
+    std::string error;
+    if (!parseOptions(argc, argv, options, error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        std::fprintf(stderr,
+                     "사용법: webserv_bench [--threads N] [--connections N] [--duration-sec N] [--warmup-sec N]"
+                     " [--pipeline N] [--rate N] [--path PATH] [--header 'Name: value'] [--bind ADDR] HOST:PORT\n");
+        return EXIT_FAILURE;
+    }
+
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo *resolved = nullptr;
+    int status = getaddrinfo(options.host.c_str(), options.port.c_str(), &hints, &resolved);
+    if (status != 0) {
+        std::fprintf(stderr, "주소를 해석할 수 없습니다: %s:%s (%s)\n", options.host.c_str(), options.port.c_str(),
+                     gai_strerror(status));
+        return EXIT_FAILURE;
+    }
+    // 127.0.0.2 처럼 다른 출발 주소로 붙어 서버가 다른 클라이언트로 보게 한다(주소별 한도 측정용).
+    addrinfo *source = nullptr;
+    if (!options.bind.empty()) {
+        addrinfo source_hints{};
+        source_hints.ai_family = resolved->ai_family;
+        source_hints.ai_socktype = SOCK_STREAM;
+        source_hints.ai_flags = AI_NUMERICHOST;
+        status = getaddrinfo(options.bind.c_str(), nullptr, &source_hints, &source);
+        if (status != 0) {
+            std::fprintf(stderr, "출발 주소를 해석할 수 없습니다: %s (%s)\n", options.bind.c_str(), gai_strerror(status));
+            freeaddrinfo(resolved);
+            return EXIT_FAILURE;
+        }
+    }
+    raiseFdLimit();
+
+    std::string request = buildRequest(options);
+    std::vector<std::unique_ptr<LoadThread>> loads;
+    for (std::size_t i = 0; i < options.threads; ++i) {
+        std::size_t connections = options.connections / options.threads + (i < options.connections % options.threads);
+        double rate = options.rate * static_cast<double>(connections) / static_cast<double>(options.connections);
+        loads.push_back(std::make_unique<LoadThread>(options, *resolved, source, request, connections, rate));
+    }
+
+    std::string mode = options.rate > 0.0
+                           ? "고정 속도 " + std::to_string(static_cast<unsigned long>(options.rate)) + " req/s"
+                           : "폐쇄 루프";
+    std::printf("webserv_bench %s:%s%s: 스레드 %zu, 연결 %zu, 파이프라이닝 %zu, %s, 측정 %u초(워밍업 %u초)\n",
+                options.host.c_str(), options.port.c_str(), options.path.c_str(), options.threads,
+                options.connections, options.pipeline, mode.c_str(), options.duration_sec, options.warmup_sec);
+    std::fflush(stdout);
+
+    Clock::time_point begin = Clock::now();
+    Clock::time_point measure_from = begin + std::chrono::seconds(options.warmup_sec);
+    Clock::time_point until = measure_from + std::chrono::seconds(options.duration_sec);
+    std::vector<std::thread> threads;
+    for (auto &load : loads) {
+        threads.emplace_back([&load, begin, measure_from, until] { load->run(begin, measure_from, until); });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    freeaddrinfo(resolved);
+    if (source != nullptr) {
+        freeaddrinfo(source);
+    }
+
+    Stats total;
+    for (const auto &load : loads) {
+        total.merge(load->stats());
+    }
+    report(options, total, static_cast<double>(options.duration_sec));
+    return total.responses > 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
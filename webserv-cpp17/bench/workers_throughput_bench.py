@@ -0,0 +1,89 @@
+#!/usr/bin/env python3
+# webserv-cpp17 v1.2.0 벤치마크: --workers 1..N 을 바꿔 가며 /health 처리량(req/s)을 측정한다.
+# - 부하 생성기는 클라이언트 프로세스 여러 개가 각자 keep-alive 연결 여러 개를 selectors 로 돌린다.
+# - 서버 코어와 부하 생성기 코어가 겹치지 않도록 taskset 으로 분리해 실행하는 것을 권장한다.
+# 사용법:
+#   python3 bench/workers_throughput_bench.py build/webserv --max-workers 4 --duration 5
+import argparse
+import multiprocessing
+import os
+import selectors
+import socket
+import subprocess
+import sys
+import time
+
+REQUEST = b"GET /health HTTP/1.1\r\nHost: bench\r\n\r\n"
+RESPONSE_END = b"status: ok\n"
+
+
+def client_process(port, connections, duration, result_queue):
+    sel = selectors.DefaultSelector()
+    for _ in range(connections):
+        s = socket.create_connection(("127.0.0.1", port))
+        s.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        s.setblocking(False)
+        s.send(REQUEST)
+        sel.register(s, selectors.EVENT_READ, bytearray())
+    completed = 0
+    deadline = time.perf_counter() + duration
+    while time.perf_counter() < deadline:
+        for key, _ in sel.select(timeout=0.1):
+            buffer = key.data
+            chunk = key.fileobj.recv(65536)
+            if not chunk:
+                sel.unregister(key.fileobj)
+                continue
+            buffer += chunk
+            done = buffer.count(RESPONSE_END)
+            if done:
+                completed += done
+                del buffer[:buffer.rfind(RESPONSE_END) + len(RESPONSE_END)]
+                key.fileobj.send(REQUEST * done)
+    result_queue.put(completed)
+
+
+def run_level(binary, port, workers, clients, connections, duration):
+    server = subprocess.Popen(
+        [binary, str(port), "1000000000", "--max-runtime-sec", "0",
+         "--idle-timeout-ms", "60000", "--workers", str(workers)],
+        stderr=subprocess.DEVNULL)
+    try:
+        time.sleep(0.3)
+        queue = multiprocessing.Queue()
+        procs = [multiprocessing.Process(target=client_process,
+                                         args=(port, connections, duration, queue))
+                 for _ in range(clients)]
+        for p in procs:
+            p.start()
+        total = sum(queue.get() for _ in procs)
+        for p in procs:
+            p.join()
+        return total / duration
+    finally:
+        server.kill()
+        server.wait()
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("binary")
+    parser.add_argument("--port", type=int, default=9191)
+    parser.add_argument("--max-workers", type=int, default=os.cpu_count() or 1)
+    parser.add_argument("--clients", type=int, default=os.cpu_count() or 1)
+    parser.add_argument("--connections", type=int, default=32)
+    parser.add_argument("--duration", type=float, default=5.0)
+    args = parser.parse_args()
+
+    print(f"{'workers':>8} {'req/s':>12} {'scale':>7}")
+    baseline = None
+    for workers in range(1, args.max_workers + 1):
+        rps = run_level(args.binary, args.port, workers, args.clients,
+                        args.connections, args.duration)
+        baseline = baseline or rps
+        print(f"{workers:>8} {rps:>12.0f} {rps / baseline:>7.2f}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/**
+ * [모듈] webserv-cpp17/include/access_log.hpp
+ * 설명:
+ *   - 워커가 요청 경로에서 기다리지 않고 접근 로그 레코드를 넘기는 단일 생산자/단일 소비자 링(AccessRing)과,
+ *     모든 워커의 링을 모아 큰 write 로 파일에 붙이는 배경 기록 스레드(AccessLog) 선언부.
+ * 버전: v1.21.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.21.0-access-log.md
+ * 변경 이력:
+ *   - v1.21.0: 워커별 SPSC 링, 배경 기록 스레드, 링이 차면 버리고 세는 접근 로그 추가
+ * 테스트:
+ *   - tests/test_webserv_access_log.sh
+ */
+
+/**
+ * AccessRecord (v1.21.0)
+ * 역할:
+ *   - 응답 하나의 접근 로그 레코드. 문자열을 고정 크기 배열에 담아 128바이트 한 덩어리로 링 칸에 복사한다.
+ * 주의 사항:
+ *   - finished_ns 는 steady_clock 시각이다. 벽시계 변환과 문자열 서식은 기록 스레드가 한다.
+ *   - 메서드는 METHOD_CAPACITY, 경로(질의 문자열 포함)는 PATH_CAPACITY 바이트까지만 담고 잘렸는지 표시한다.
+ *   - 길이가 0 인 메서드/경로는 요청 라인을 해석하기 전에 거절한 요청(400, 431)이다.
+ */
+struct AccessRecord {
+    static constexpr std::size_t METHOD_CAPACITY = 8;
+    static constexpr std::size_t PATH_CAPACITY = 80;
+
+    std::int64_t finished_ns = 0;
+    std::uint64_t connection = 0;
+    std::uint64_t bytes = 0;
+    std::uint32_t latency_us = 0;
+    std::uint16_t status = 0;
+    std::uint8_t method_length = 0;
+    std::uint8_t path_length = 0;
+    bool path_truncated = false;
+    char method[METHOD_CAPACITY];
+    char path[PATH_CAPACITY];
+
+    void setRequest(std::string_view request_method, std::string_view request_path);
+    void clearRequest() {
+        method_length = 0;
+        path_length = 0;
+        path_truncated = false;
+    }
+};
+
+static_assert(sizeof(AccessRecord) == 128, "AccessRecord 는 캐시 라인 두 개 크기여야 한다");
+
+/**
+ * AccessRing (v1.21.0)
+ * 역할:
+ *   - 워커 하나(생산자)와 기록 스레드(소비자) 사이의 2의 거듭제곱 크기 원형 배열. 잠금과 시스템 호출이 없다.
+ * 주의 사항:
+ *   - tryPush 는 소유 워커 스레드만, consume 은 기록 스레드만 부른다.
+ *   - 링이 차면 tryPush 는 기다리지 않고 false 를 돌려준다. 버린 레코드 수는 호출자가 센다.
+ *   - 생산자는 소비 위치를 캐시해 두고 링이 찬 것처럼 보일 때만 다시 읽는다. 두 위치는 서로 다른 캐시 라인에 둔다.
+ */
+class AccessRing {
+ public:
+    explicit AccessRing(std::size_t capacity);
+
+    AccessRing(const AccessRing &) = delete;
+    AccessRing &operator=(const AccessRing &) = delete;
+
+    bool tryPush(const AccessRecord &record) {
+        std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head - cached_tail_ > mask_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head - cached_tail_ > mask_) {
+                return false;
+            }
+        }
+        slots_[head & mask_] = record;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * consume
+     * 설명:
+     *   - 지금까지 들어온 레코드를 순서대로 fn 에 넘기고, 다 본 뒤 소비 위치를 한 번만 옮긴다.
+     * 출력:
+     *   - 넘긴 레코드 수
+     */
+    template <typename Fn>
+    std::size_t consume(Fn &&fn) {
+        std::size_t tail = tail_.load(std::memory_order_relaxed);
+        std::size_t head = head_.load(std::memory_order_acquire);
+        for (std::size_t i = tail; i != head; ++i) {
+            fn(slots_[i & mask_]);
+        }
+        tail_.store(head, std::memory_order_release);
+        return head - tail;
+    }
+
+    std::size_t capacity() const { return mask_ + 1; }
+
+ private:
+    alignas(64) std::atomic<std::size_t> head_{0};
+    std::size_t cached_tail_ = 0;
+    alignas(64) std::atomic<std::size_t> tail_{0};
+    alignas(64) std::size_t mask_;
+    std::unique_ptr<AccessRecord[]> slots_;
+};
+
+/**
+ * AccessLog (v1.21.0)
+ * 역할:
+ *   - 워커 수만큼 AccessRing 을 소유하고, 기록 스레드가 FLUSH_INTERVAL 마다 모든 링을 비워
+ *     한 줄짜리 레코드를 서식화한 뒤 WRITE_BATCH 단위의 큰 write 로 로그 파일 끝에 붙인다.
+ * 설계:
+ *   - design/webserv-cpp17/v1.21.0-access-log.md
+ * 주의 사항:
+ *   - 워커는 기록 스레드를 깨우지 않는다(eventfd, 조건 변수 없음). 링 크기는 FLUSH_INTERVAL 동안 들어올
+ *     요청 수보다 커야 하고, 작으면 넘친 레코드를 버린다.
+ *   - 한 번 비운 레코드 수가 링 용량의 절반을 넘으면 쉬지 않고 바로 다시 비운다.
+ *   - 소멸자는 기록 스레드를 멈추고 링에 남은 레코드까지 모두 쓴다. 워커 스레드가 끝난 뒤에 파괴되어야 한다.
+ *   - 로그 파일은 O_APPEND 로 열고, write 는 항상 줄 경계에서 끊는다.
+ */
+class AccessLog {
+ public:
+    static constexpr std::size_t WRITE_BATCH = 64 * 1024;
+    static constexpr std::chrono::milliseconds FLUSH_INTERVAL{10};
+
+    AccessLog(std::size_t workers, std::size_t ring_capacity);
+    ~AccessLog();
+
+    AccessLog(const AccessLog &) = delete;
+    AccessLog &operator=(const AccessLog &) = delete;
+
+    /**
+     * open
+     * 설명:
+     *   - 로그 파일을 덧붙이기 모드로 열고(없으면 만든다) 기록 스레드를 띄운다.
+     * 출력:
+     *   - 성공 시 true, 파일을 열지 못하면 false (errno 유지)
+     */
+    bool open(const std::string &path);
+
+    AccessRing &ring(std::size_t worker) { return *rings_[worker]; }
+
+ private:
+    void run();
+    std::size_t drain();
+    void format(std::size_t worker, const AccessRecord &record, std::int64_t wall_offset_ns);
+    void writeOut();
+
+    int fd_ = -1;
+    std::vector<std::unique_ptr<AccessRing>> rings_;
+    std::string buffer_;
+    // 같은 초의 레코드는 날짜/시각 부분을 다시 서식화하지 않는다.
+    std::int64_t cached_second_ = -1;
+    char cached_stamp_[24] = {};
+    bool write_failed_ = false;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stopping_ = false;
+    std::thread thread_;
+};
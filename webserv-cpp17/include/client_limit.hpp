@@ -0,0 +1,128 @@
+#pragma once
+
+#include <sys/socket.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * [모듈] webserv-cpp17/include/client_limit.hpp
+ * 설명:
+ *   - 클라이언트 주소마다 요청 속도(토큰 버킷)와 동시 연결 수를 세는 고정 크기 개방 주소 표(ClientLimiter) 선언부.
+ *   - 모든 워커가 표 하나를 잠금 없이 함께 쓴다. SO_REUSEPORT 는 같은 주소의 연결을 여러 워커로 나누므로
+ *     워커별 표로는 주소 하나의 한도를 지킬 수 없다.
+ * 버전: v1.24.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.24.0-client-limits.md
+ * 변경 이력:
+ *   - v1.24.0: 주소별 토큰 버킷과 동시 연결 한도, 원자 연산만 쓰는 개방 주소 표 추가
+ * 테스트:
+ *   - tests/test_webserv_client_limits.sh
+ */
+
+/**
+ * clientKey
+ * 설명:
+ *   - 원격 주소를 표의 키로 바꾼다. IPv4 는 주소 하나, IPv6 는 /64 접두사 하나가 클라이언트 하나다
+ *     (호스트 하나가 /64 를 통째로 받으므로 주소마다 세면 한도를 쉽게 피한다).
+ *   - IPv4 와 IPv4 매핑 IPv6 주소(::ffff:a.b.c.d)는 같은 키다. 0 은 빈 칸 표시라 키로 쓰지 않는다.
+ * 출력:
+ *   - 키. 주소 종류를 모르면 0(세지 않는다)
+ */
+std::uint64_t clientKey(const sockaddr_storage &address);
+
+// 연결 수락 판정. untracked 는 표가 붐벼 칸을 얻지 못한 연결로, 한도 없이 받는다.
+enum class ClientAdmission : std::uint8_t {
+    kAdmitted,
+    kRejected,
+    kUntracked,
+};
+
+/**
+ * ClientLimiter (v1.24.0)
+ * 역할:
+ *   - 2의 거듭제곱 크기 칸 배열. 키의 해시 위치부터 PROBE_WINDOW 칸 안에서만 찾고 넣는다.
+ *   - 칸 하나는 키, 버킷 상태, 열린 연결 수를 원자 변수로 담는다. 연결은 수락할 때 칸을 한 번 찾아 번호를
+ *     들고 있고, 요청마다는 그 칸의 버킷만 본다(요청 경로에 해시 조회가 없다).
+ *   - 토큰 버킷은 GCRA(가상 스케줄링) 형태로 센다. 버킷이 가득 차는 시각(tat) 하나만 두고, 요청마다
+ *     tat 를 요청 간격만큼 민다. tat 가 지금보다 burst 간격 넘게 앞서 있으면 토큰이 없는 것이다.
+ *     CAS 하나로 채우기와 꺼내기가 끝나고, 다시 시도할 시각도 바로 나온다.
+ * 설계:
+ *   - design/webserv-cpp17/v1.24.0-client-limits.md
+ * 주의 사항:
+ *   - 칸은 지우지 않는다. 찾는 쪽이 빈 칸에서 멈추지 않고 창 전체를 보므로, 창 안의 쉬는 칸(연결 0,
+ *     버킷 가득)을 다른 키가 바로 가져가도 다른 키의 탐색이 끊기지 않는다.
+ *   - 칸을 가져가는 쪽은 연결 수를 0 에서 RECLAIMING 으로 바꾼 뒤에 키를 바꾼다. 같은 칸에 연결을 더하는 쪽은
+ *     더한 뒤 RECLAIMING 비트와 키를 다시 보고, 둘 중 하나가 바뀌었으면 되돌리고 처음부터 다시 찾는다.
+ *   - 처음 보는 키 두 개가 동시에 다른 빈 칸을 잡으면 창에서 앞선 칸을 쓰고, 뒤 칸은 쉬는 칸으로
+ *     남겨 나중에 다른 키가 가져가게 한다.
+ *   - 창 안에 빈 칸도 쉬는 칸도 없으면 그 연결은 세지 않는다(kUntracked). 한도보다 가용성을 택한다.
+ */
+class ClientLimiter {
+ public:
+    static constexpr std::size_t PROBE_WINDOW = 8;
+    static constexpr std::uint32_t NO_SLOT = UINT32_MAX;
+
+    /**
+     * 생성자
+     * 입력:
+     *   - slots: 칸 수(2의 거듭제곱으로 올림)
+     *   - rate: 주소마다 초당 요청 수, 0 이면 속도를 제한하지 않는다
+     *   - burst: 쉬던 주소가 한꺼번에 보낼 수 있는 요청 수(버킷 크기), 0 이면 rate 와 같다
+     *   - connections: 주소마다 동시 연결 수, 0 이면 제한하지 않는다
+     */
+    ClientLimiter(std::size_t slots, std::uint32_t rate, std::uint32_t burst, std::uint32_t connections);
+
+    ClientLimiter(const ClientLimiter &) = delete;
+    ClientLimiter &operator=(const ClientLimiter &) = delete;
+
+    /**
+     * admit
+     * 설명:
+     *   - 키의 칸을 찾거나 만들고 연결 수를 하나 올린다. 한도를 넘으면 올리지 않고 거절한다.
+     * 출력:
+     *   - slot: kAdmitted 면 칸 번호(연결을 닫을 때 release 에 넘긴다), 그 밖에는 NO_SLOT
+     */
+    ClientAdmission admit(std::uint64_t key, std::chrono::steady_clock::time_point now, std::uint32_t &slot);
+
+    // admit 로 받은 연결 하나를 내려놓는다.
+    void release(std::uint32_t slot) { slots_[slot].connections.fetch_sub(1, std::memory_order_acq_rel); }
+
+    /**
+     * allowRequest
+     * 설명:
+     *   - 칸의 버킷에서 토큰 하나를 꺼낸다. rate 가 0 이면 항상 참이다.
+     * 출력:
+     *   - 꺼냈으면 true. 토큰이 없으면 false 와 다음 토큰까지 남은 초(올림, 1 이상)
+     */
+    bool allowRequest(std::uint32_t slot, std::chrono::steady_clock::time_point now, std::uint32_t &retry_after);
+
+    std::size_t capacity() const { return mask_ + 1; }
+    bool limitsRate() const { return interval_ns_ != 0; }
+
+ private:
+    static constexpr std::uint32_t RECLAIMING = 1u << 31;
+
+    struct alignas(32) Slot {
+        std::atomic<std::uint64_t> key{0};
+        // 버킷이 가득 차는 시각(epoch_ 부터의 ns). 지금보다 이르면 버킷이 가득 차 있다.
+        std::atomic<std::uint64_t> tat{0};
+        std::atomic<std::uint32_t> connections{0};
+    };
+
+    std::uint64_t elapsed(std::chrono::steady_clock::time_point now) const;
+    std::size_t home(std::uint64_t key) const;
+    // 연결 하나를 칸에 올린다. 칸이 그 사이 다른 키로 넘어갔으면 -1, 한도 초과면 0, 성공이면 1.
+    int enter(Slot &slot, std::uint64_t key);
+    bool idle(const Slot &slot, std::uint64_t now) const;
+
+    std::size_t mask_;
+    std::uint64_t interval_ns_;
+    std::uint64_t burst_ns_;
+    std::uint32_t max_connections_;
+    std::chrono::steady_clock::time_point epoch_;
+    std::unique_ptr<Slot[]> slots_;
+};
@@ -0,0 +1,190 @@
+#pragma once
+
+#include <zlib.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "file_cache.hpp"
+#include "http_parser.hpp"
+#include "metrics.hpp"
+#include "thread_pool.hpp"
+
+/**
+ * [모듈] webserv-cpp17/include/compression.hpp
+ * 설명:
+ *   - `Accept-Encoding` 협상, zlib 스트리밍 압축기(gzip/deflate), 정적 파일의 압축본을 메모리 한도 안에서
+ *     보관하는 미리 압축 캐시 선언부.
+ *   - 동적 본문은 워커가 요청마다 압축하고, 정적 파일은 처음 한 번만 압축해(작업 스레드 풀) 캐시에서 꺼내 쓴다.
+ * 버전: v1.14.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.14.0-response-compression.md
+ * 변경 이력:
+ *   - v1.14.0: 콘텐츠 코딩 협상, Compressor, CompressedCache 추가
+ * 테스트:
+ *   - tests/test_webserv_compression.sh
+ */
+
+// 응답 본문에 적용하는 콘텐츠 코딩. HTTP 의 `deflate` 는 zlib 형식이다(RFC 9110 8.4.1.2).
+enum class ContentCoding : std::uint8_t {
+    kIdentity,
+    kGzip,
+    kDeflate,
+};
+
+/**
+ * negotiateCoding
+ * 설명:
+ *   - `Accept-Encoding` 값에서 q 값이 가장 큰 코딩을 고른다. 같으면 gzip 을 먼저 쓴다.
+ *   - `*` 는 따로 적히지 않은 코딩에 적용되고, `q=0` 은 거부다. 헤더가 없으면 identity 다.
+ */
+ContentCoding negotiateCoding(const HttpRequestView &request);
+
+/**
+ * codingHeaders
+ * 설명:
+ *   - 압축 가능한 응답에 붙이는 헤더 줄. identity 여도 `Vary: Accept-Encoding` 은 붙여
+ *     중간 캐시가 코딩별로 응답을 나눠 보관하게 한다.
+ */
+std::string_view codingHeaders(ContentCoding coding);
+
+/**
+ * isCompressibleType
+ * 설명:
+ *   - 압축할 만한(text/ 계열, JSON, JavaScript, SVG, wasm) Content-Type 인지 확인한다. 이미 압축된 이미지 등은 제외한다.
+ */
+bool isCompressibleType(std::string_view content_type);
+
+// 이보다 작은 본문은 압축해도 헤더/틀 비용을 넘기 어려워 그대로 보낸다.
+constexpr std::size_t MIN_COMPRESS_BYTES = 256;
+
+/**
+ * Compressor (v1.14.0)
+ * 역할:
+ *   - zlib deflate 스트림을 코딩별로 하나씩 들고 있다가 deflateReset 으로 재사용한다.
+ *     스트림 초기화(수백 KB 할당)는 코딩별로 처음 한 번뿐이다.
+ *   - begin -> update(여러 번) -> finish 로 입력을 조각 단위로 흘려 넣는다. 결과는 내부 버퍼에 쌓이고
+ *     그 용량은 다음 압축에서 다시 쓴다.
+ * 주의 사항:
+ *   - 스레드 하나에서만 쓴다. 워커와 작업 스레드는 각자 자기 Compressor 를 만든다.
+ *   - output() 은 다음 begin 전까지만 유효하다.
+ */
+class Compressor {
+ public:
+    explicit Compressor(int level);
+    ~Compressor();
+
+    Compressor(const Compressor &) = delete;
+    Compressor &operator=(const Compressor &) = delete;
+
+    bool begin(ContentCoding coding);
+    bool update(std::string_view input);
+    bool finish();
+
+    /**
+     * compress
+     * 설명:
+     *   - 조각들을 이어 붙인 본문 하나를 압축한다. writeResponse 처럼 본문을 미리 합치지 않아도 된다.
+     * 출력:
+     *   - 성공 시 true, zlib 오류 시 false
+     */
+    bool compress(ContentCoding coding, std::initializer_list<std::string_view> parts);
+
+    std::string_view output() const { return std::string_view(output_.data(), produced_); }
+
+ private:
+    bool run(std::string_view input, int flush);
+
+    int level_;
+    z_stream streams_[2];
+    bool ready_[2] = {false, false};
+    z_stream *active_ = nullptr;
+    std::string output_;
+    std::size_t produced_ = 0;
+};
+
+/**
+ * CompressedVariant
+ * 설명:
+ *   - 정적 파일 하나의 코딩별 압축본. compressed 가 거짓이면 압축해도 줄지 않은 파일이라 원본을 보낸다.
+ *   - body 는 캐시와 다른 응답이 함께 쥐어도 되도록 공유 포인터다.
+ */
+struct CompressedVariant {
+    std::shared_ptr<const std::string> body;
+    std::string etag;
+    bool compressed = false;
+};
+
+/**
+ * CompressedCache (v1.14.0)
+ * 역할:
+ *   - URL 경로 + 코딩을 키로 정적 파일 압축본을 LRU 로 보관한다. 항목마다 고정 비용(ENTRY_OVERHEAD + 키 길이)에
+ *     압축본 바이트를 더한 합이 capacity 를 넘으면 가장 오래 안 쓴 항목부터 버린다. 압축 중인 항목과
+ *     원본을 보내기로 한 항목도 비용을 치르므로 항목 수가 한없이 늘지 않는다.
+ *   - 캐시에 없으면 압축을 시작하고 이번 요청은 원본으로 응답하게 한다. 작업 스레드 풀이 있으면 풀에서,
+ *     없으면 워커 스레드에서 바로 압축한다(바로 압축한 경우 이번 요청부터 압축본이 나간다).
+ *   - 항목은 원본 ETag(크기 + 수정 시각)를 함께 기억한다. 파일이 바뀌면 ETag 가 달라져 다시 압축한다.
+ * 설계:
+ *   - design/webserv-cpp17/v1.14.0-response-compression.md
+ * 주의 사항:
+ *   - 워커마다 하나씩 두고 워커 스레드에서만 조회/갱신한다. 작업 스레드는 결과를 CompletionQueue 로 넘긴다.
+ *   - 압축 중인 항목은 대기 상태로 두어 같은 파일을 두 번 맡기지 않는다.
+ *   - find 가 돌려준 포인터는 다음 find 나 완료 콜백 전까지만 유효하다.
+ */
+class CompressedCache {
+ public:
+    // 이보다 큰 파일은 미리 압축하지 않는다. 한 파일이 캐시를 독차지하지 않게 한다.
+    static constexpr std::size_t MAX_SOURCE_BYTES = 8 * 1024 * 1024;
+    // 본문과 별개로 항목 하나가 차지하는 대략의 크기(목록 노드, 색인 노드, ETag 문자열). 한도 계산에 넣는다.
+    static constexpr std::size_t ENTRY_OVERHEAD = 256;
+
+    CompressedCache(std::size_t capacity, int level, ThreadPool *pool, CompletionQueue &completions,
+                    WorkerMetrics &metrics);
+
+    CompressedCache(const CompressedCache &) = delete;
+    CompressedCache &operator=(const CompressedCache &) = delete;
+
+    /**
+     * find
+     * 설명:
+     *   - url_path(쿼리 문자열 제외)에 해당하는 파일 file 의 coding 압축본을 찾는다.
+     * 출력:
+     *   - 준비된 압축본 포인터. 아직 없거나(압축 시작) 압축 대상이 아니면 nullptr
+     */
+    const CompressedVariant *find(std::string_view url_path, ContentCoding coding, const FileInfo &file);
+
+    std::size_t size() const { return index_.size(); }
+    std::size_t bytes() const { return bytes_; }
+
+ private:
+    struct Entry {
+        std::string key;
+        std::string source_etag;
+        CompressedVariant variant;
+        bool ready = false;
+    };
+    using EntryList = std::list<Entry>;
+
+    void complete(const std::string &key, const std::string &source_etag, ContentCoding coding,
+                  std::shared_ptr<std::string> body, std::size_t source_size, bool ok);
+    static std::size_t cost(const Entry &entry);
+    void evictOverflow(EntryList::iterator keep);
+    void evict(EntryList::iterator it);
+
+    std::size_t capacity_;
+    int level_;
+    ThreadPool *pool_;
+    CompletionQueue &completions_;
+    WorkerMetrics &metrics_;
+    EntryList lru_;
+    std::unordered_map<std::string, EntryList::iterator> index_;
+    std::size_t bytes_ = 0;
+    // 조회 키를 만드는 버퍼. 용량을 남겨 캐시 적중 시 할당하지 않는다.
+    std::string key_;
+};
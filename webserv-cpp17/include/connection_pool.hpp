@@ -0,0 +1,335 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "access_log.hpp"
+#include "client_limit.hpp"
+#include "compression.hpp"
+#include "coroutine.hpp"
+#include "event_loop.hpp"
+#include "http2.hpp"
+#include "http_parser.hpp"
+#include "io_buffer.hpp"
+#include "metrics.hpp"
+#include "proxy.hpp"
+#include "request_body.hpp"
+#include "ring_queue.hpp"
+#include "timer_wheel.hpp"
+#include "tls.hpp"
+
+/**
+ * [모듈] webserv-cpp17/include/connection_pool.hpp
+ * 설명:
+ *   - 연결 상태 구조체(Connection)와, 연결 객체를 슬랩 단위로 미리 만들어 두고 재사용하는 연결 풀 선언부.
+ *   - 연결은 슬롯 번호와 세대(generation)를 합친 64비트 핸들로 찾는다. 닫힌 연결의 핸들은 세대가 달라 무효가 된다.
+ * 버전: v1.25.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.9.0-connection-pool.md
+ *   - design/webserv-cpp17/v1.10.0-zero-alloc-responses.md
+ *   - design/webserv-cpp17/v1.11.0-io-uring-backend.md
+ *   - design/webserv-cpp17/v1.12.0-streaming-request-body.md
+ *   - design/webserv-cpp17/v1.16.0-reverse-proxy.md
+ *   - design/webserv-cpp17/v1.17.0-handler-offload.md
+ *   - design/webserv-cpp17/v1.18.0-coroutine-handlers.md
+ *   - design/webserv-cpp17/v1.21.0-access-log.md
+ *   - design/webserv-cpp17/v1.22.0-tls.md
+ *   - design/webserv-cpp17/v1.23.0-http2.md
+ *   - design/webserv-cpp17/v1.24.0-client-limits.md
+ *   - design/webserv-cpp17/v1.25.0-config-reload.md
+ * 변경 이력:
+ *   - v1.9.0: worker.hpp 의 Connection 을 옮기고 FD 키 해시 테이블을 슬랩 풀로 교체
+ *   - v1.10.0: in_flight 를 std::deque 에서 RingQueue 로 교체, 반납 시 커진 출력 버퍼도 축소
+ *   - v1.11.0: 완료 기반 I/O 백엔드용 연결별 상태(ConnectionIo) 추가, 세대를 24비트로 줄여 핸들 상위 8비트를 비움
+ *   - v1.12.0: 읽고 있는 요청 본문 상태(RequestBody) 추가
+ *   - v1.16.0: 프록시 클라이언트/업스트림 연결을 잇는 상태(ProxyLink) 추가
+ *   - v1.17.0: 작업 스레드에 맡긴 핸들러 요청의 상태와 결과(OffloadSlot) 추가
+ *   - v1.18.0: 코루틴 핸들러 상태(CoContext) 추가, ProxyLink 에 응답을 코루틴으로 받는 capture 추가
+ *   - v1.21.0: 접근 로그 레코드(access)와 응답 시작 위치(reply_mark) 추가
+ *   - v1.22.0: TLS 연결 상태(TlsStream) 추가
+ *   - v1.23.0: HTTP/2 세션(Connection::http2) 추가
+ *   - v1.24.0: 클라이언트 한도 표의 칸 번호(Connection::client_slot) 추가
+ *   - v1.25.0: ProxyLink::upstreams(교환이 시작된 업스트림 풀) 추가
+ * 테스트:
+ *   - tests/test_webserv_connection_churn.sh
+ *   - tests/test_webserv_io_uring.sh
+ *   - tests/test_webserv_request_body.sh
+ *   - tests/test_webserv_proxy.sh
+ *   - tests/test_webserv_offload.sh
+ *   - tests/test_webserv_coroutine.sh
+ *   - tests/test_webserv_access_log.sh
+ *   - tests/test_webserv_tls.sh
+ *   - tests/test_webserv_http2.sh
+ *   - tests/test_webserv_client_limits.sh
+ *   - tests/test_webserv_reload.sh
+ */
+
+/**
+ * Connection
+ * 주의 사항:
+ *   - handle: 이 연결의 세대 태그 핸들. EventLoop 토큰과 타이머 토큰으로 쓴다.
+ *   - read_ready: 엣지 트리거에서 EAGAIN 까지 읽지 못한 채 남겨 둔 수신 데이터가 있을 수 있음을 뜻한다.
+ *     백프레셔로 수신을 멈췄을 때 다음 읽기 이벤트가 오지 않을 수 있으므로 이 플래그로 재개한다.
+ *   - interest: 현재 EventLoop 에 등록된 관심사. 바뀔 때만 modify 를 호출한다.
+ *   - request_start: 지금 파싱 중인 요청의 첫 바이트를 읽은 시각.
+ *   - in_flight: 출력 큐에 들어간 응답마다 끝 위치(누적 바이트)와 시작 시각. 그 위치까지 송신되면 지연을 기록한다.
+ *   - timer/timeout_phase: 타이밍 휠에 걸린 마감과 그 마감이 속한 단계. 풀의 슬롯은 주소가 바뀌지 않는다.
+ *   - access/reply_mark: 접근 로그를 켰을 때 지금 요청의 메서드/경로를 담아 두는 레코드와, 그 요청 응답이
+ *     출력 큐에서 시작하는 위치(누적 바이트). 응답을 다 넣으면 나머지를 채워 워커의 링에 복사한다(v1.21.0).
+ *   - tls: TLS 리스너로 받은 연결이면 SSL 객체가 붙어 있다. 백엔드는 이 연결의 수신/송신을 여기로 돌린다(v1.22.0).
+ *   - http2: HTTP/2 로 바뀐 적이 있는 슬롯의 세션(v1.23.0). 처음 HTTP/2 로 바뀔 때 만들고 슬롯을 돌려받아도
+ *     지우지 않고 되돌리기만 한다. HTTP/1 만 오가는 슬롯은 세션 메모리를 갖지 않는다.
+ */
+struct PendingResponse {
+    std::uint64_t end_mark = 0;
+    std::chrono::steady_clock::time_point start;
+};
+
+/**
+ * ConnectionIo (v1.11.0)
+ * 설명:
+ *   - 완료 기반 I/O 백엔드(io_uring)가 연결마다 보관하는 진행 상태. epoll 백엔드는 쓰지 않는다.
+ * 주의 사항:
+ *   - recv_buffer: 수신 완료로 받았지만 워커가 아직 가져가지 않은 제공 버퍼(provided buffer) 번호. 없으면 -1.
+ *   - send_armed: 송신 SQE 가 출력 큐 버퍼를 가리키고 있다. 완료될 때까지 출력 큐에 응답을 추가하면 안 된다
+ *     (버퍼가 정리/확장으로 옮겨질 수 있다).
+ *   - sent: 완료되었지만 아직 워커에 보고하지 않은 송신 바이트.
+ */
+struct ConnectionIo {
+    bool recv_armed = false;
+    int recv_buffer = -1;
+    std::uint32_t recv_offset = 0;
+    std::uint32_t recv_length = 0;
+    int recv_error = 0;
+    bool recv_eof = false;
+    bool send_armed = false;
+    bool poll_armed = false;
+    int send_error = 0;
+    std::size_t sent = 0;
+};
+
+/**
+ * RequestBody (v1.12.0)
+ * 설명:
+ *   - 헤더를 처리한 뒤 본문을 읽는 동안 보관하는 요청 상태. 헤더 조각(string_view)은 본문을 소비하면서
+ *     무효가 되므로, 본문 끝에서 응답/계측에 필요한 값은 헤더 시점에 여기에 옮겨 둔다.
+ * 주의 사항:
+ *   - decoder.active() 가 참인 동안 입력 버퍼의 앞부분은 본문 바이트다(다음 요청이 아니다).
+ *   - route 가 kDiscard 면 응답은 이미 출력 큐에 있고, 본문 끝에서 계측과 연결 유지 여부만 반영한다.
+ */
+struct RequestBody {
+    BodyDecoder decoder;
+    BodyRoute route = BodyRoute::kDiscard;
+    RouteLabel label = RouteLabel::kError;
+    int status = 0;
+    bool keep_alive = false;
+    UploadDigest upload;
+};
+
+// 프록시에서 연결이 맡은 쪽(v1.16.0). 업스트림 연결은 워커가 connect 로 연 연결이다.
+enum class ProxyRole : std::uint8_t {
+    kNone,
+    kClient,
+    kUpstream,
+};
+
+/**
+ * ProxyLink (v1.16.0)
+ * 설명:
+ *   - 프록시 중인 클라이언트 연결과 업스트림 연결이 서로의 핸들(peer)로 이어진 상태.
+ *     요청 본문은 클라이언트 입력에서 업스트림 출력으로, 응답은 업스트림 입력에서 클라이언트 출력으로 흐른다.
+ * 주의 사항:
+ *   - stalled: 상대 출력 큐가 HIGH_WATER 를 넘었거나 상대 송신이 걸려 있어(io_uring) 더 넘기지 못하고 멈췄다.
+ *     상대가 LOW_WATER 아래로 비우면 풀어 주고 다시 돌린다.
+ *   - 클라이언트 쪽: 요청 헤더 시점의 값(keep_alive, head_only, http10, has_body)과 업스트림에 보낸 요청 헤더(head).
+ *     head 는 재사용한 업스트림 연결이 응답 전에 끊겼을 때 새 연결로 한 번 다시 보내는 데 쓴다.
+ *     responded 는 응답 헤더를 이미 클라이언트 출력에 넣었는지, error 는 클라이언트가 대신 답할 오류 상태다.
+ *   - 업스트림 쪽: server 는 UpstreamPool 서버 번호, decoder 는 응답 본문 끝을 찾는 디코더다.
+ *     peer 가 0 이면 풀에서 쉬는 연결이다.
+ *   - upstreams(v1.25.0, 양쪽): 요청을 시작할 때의 UpstreamPool. route/server 번호는 이 풀 기준이다.
+ *     설정을 다시 읽어 워커의 풀이 바뀌어도 진행 중 요청은 이전 풀로 끝내고, 그 업스트림 연결은 풀에 돌려주지 않고 닫는다.
+ *   - capture(v1.18.0, 클라이언트 쪽): 코루틴 핸들러의 fetch 다. 응답은 클라이언트 출력이 아니라
+ *     CoContext::upstream_body 로 (chunked 면 풀어서) 들어가고, 응답 상태는 코루틴이 재개하며 읽는다.
+ */
+struct ProxyLink {
+    ProxyRole role = ProxyRole::kNone;
+    std::uint64_t peer = 0;
+    bool stalled = false;
+
+    UpstreamPool *upstreams = nullptr;
+    std::size_t route = 0;
+    bool keep_alive = false;
+    bool head_only = false;
+    bool http10 = false;
+    bool has_body = false;
+    bool responded = false;
+    bool retried = false;
+    bool capture = false;
+    int status = 0;
+    int error = 0;
+    std::string head;
+
+    std::size_t server = 0;
+    bool reused = false;
+    bool received = false;
+    bool reusable = false;
+    bool reading_body = false;
+    bool dechunk = false;
+    std::size_t scan = 0;
+    ResponseFraming framing = ResponseFraming::kNone;
+    BodyDecoder decoder;
+
+    // 요청 헤더 버퍼의 용량은 남기고 나머지를 초기값으로 되돌린다.
+    void reset() {
+        std::string kept = std::move(head);
+        kept.clear();
+        *this = ProxyLink();
+        head = std::move(kept);
+    }
+};
+
+// 작업 스레드에 맡긴 핸들러 요청의 진행 단계(v1.17.0).
+enum class OffloadState : std::uint8_t {
+    kNone,
+    kRunning,  // 작업 스레드가 핸들러를 돌리는 중이다
+    kDone,     // 결과가 돌아왔고 응답을 쓰기를 기다린다
+};
+
+/**
+ * OffloadSlot (v1.17.0)
+ * 설명:
+ *   - 블로킹 핸들러를 작업 스레드에 맡긴 요청 하나의 상태. 요청 헤더 시점의 값(keep_alive, coding)과
+ *     작업 스레드가 돌려준 결과(status, body)를 담는다.
+ * 주의 사항:
+ *   - 작업 스레드는 이 구조체를 만지지 않는다. 결과는 완료 큐 콜백이 워커 스레드에서 옮겨 넣는다.
+ *   - 상태가 kNone 이 아닌 동안 연결은 다음 요청을 읽지 않는다. 파이프라이닝된 응답 순서를 지키기 위해서다.
+ */
+struct OffloadSlot {
+    OffloadState state = OffloadState::kNone;
+    int status = 0;
+    bool keep_alive = false;
+    ContentCoding coding = ContentCoding::kIdentity;
+    std::string body;
+
+    // 본문 버퍼의 용량은 남기고 나머지를 초기값으로 되돌린다.
+    void reset() {
+        std::string kept = std::move(body);
+        kept.clear();
+        *this = OffloadSlot();
+        body = std::move(kept);
+    }
+};
+
+struct Connection {
+    int fd = -1;
+    std::uint64_t handle = 0;
+    InputBuffer input;
+    bool should_close = false;
+    HttpParser parser;
+    OutputQueue output;
+    std::uint32_t interest = EVENT_READ;
+    bool read_ready = false;
+    bool peer_closed = false;
+    bool reading_paused = false;
+    std::chrono::steady_clock::time_point request_start;
+    RingQueue<PendingResponse> in_flight;
+    TimerNode timer;
+    TimeoutLabel timeout_phase = TimeoutLabel::kIdle;
+    ConnectionIo io;
+    RequestBody body;
+    ProxyLink proxy;
+    OffloadSlot offload;
+    CoContext co;
+    AccessRecord access;
+    std::uint64_t reply_mark = 0;
+    TlsStream tls;
+    std::unique_ptr<Http2Session> http2;
+    // 클라이언트 한도 표에서 잡은 칸(v1.24.0). 한도가 꺼져 있거나 칸을 얻지 못했으면 NO_SLOT 이다.
+    std::uint32_t client_slot = ClientLimiter::NO_SLOT;
+};
+
+/**
+ * ConnectionPool (v1.9.0)
+ * 역할:
+ *   - Connection 을 SLAB_SIZE 개씩 한 번에 만들어 두고, 빈 슬롯 번호를 LIFO 자유 목록으로 관리한다.
+ *     acquire/release/find 는 모두 O(1) 이며 연결마다 힙 할당이 일어나지 않는다.
+ *   - release 는 객체를 파괴하지 않고 상태만 되돌린다. 입력 버퍼와 큐 컨테이너의 용량을 다음 연결이 그대로 쓴다.
+ * 설계:
+ *   - design/webserv-cpp17/v1.9.0-connection-pool.md
+ * 주의 사항:
+ *   - 슬랩은 풀이 사라질 때까지 해제하지 않으므로 Connection 주소가 바뀌지 않는다(타이머 노드가 이에 의존한다).
+ *   - release 전에 타이머를 취소해야 한다.
+ *   - 핸들의 32~55비트(세대)는 0 이 아니다. 리슨/inotify FD 토큰(상위 32비트 0)과 구분하는 데 쓴다.
+ *   - 핸들의 상위 8비트는 항상 0 이다. io_uring 백엔드가 user_data 에 작업 종류를 싣는 데 쓴다(v1.11.0).
+ *   - 워커 하나가 소유한다. 스레드 안전하지 않다.
+ */
+class ConnectionPool {
+ public:
+    static constexpr std::size_t SLAB_SIZE = 64;
+    // 이보다 커진 입력/출력 버퍼는 반납 시 기본 크기로 되돌려, 큰 요청/응답 한 번이 슬롯 메모리를 계속 붙잡지 않게 한다.
+    static constexpr std::size_t RETAINED_INPUT_CAPACITY = 64 * 1024;
+    static constexpr std::size_t RETAINED_OUTPUT_CAPACITY = 64 * 1024;
+    // 세대는 24비트 안에서 돈다. 같은 슬롯이 1,600만 번 재사용되어야 같은 핸들이 다시 나온다.
+    static constexpr std::uint32_t GENERATION_MASK = (1u << 24) - 1;
+
+    ConnectionPool() = default;
+
+    ConnectionPool(const ConnectionPool &) = delete;
+    ConnectionPool &operator=(const ConnectionPool &) = delete;
+
+    static bool isConnectionToken(std::uint64_t token) { return (token >> 32) != 0; }
+
+    /**
+     * acquire
+     * 설명:
+     *   - 빈 슬롯을 꺼내 fd 와 새 핸들을 채워 돌려준다. 빈 슬롯이 없으면 슬랩 하나를 더 만든다.
+     */
+    Connection &acquire(int fd);
+
+    /**
+     * release
+     * 설명:
+     *   - 슬롯을 자유 목록에 돌려놓고 세대를 올려 기존 핸들을 무효로 만든다. FD 는 닫지 않는다.
+     */
+    void release(Connection &conn);
+
+    // 살아 있는 연결이면 포인터, 닫혔거나 잘못된 핸들이면 nullptr.
+    Connection *find(std::uint64_t handle);
+
+    std::size_t size() const { return live_; }
+    std::size_t capacity() const { return slabs_.size() * SLAB_SIZE; }
+
+    /**
+     * forEach
+     * 설명:
+     *   - 살아 있는 연결마다 fn 을 호출한다. fn 안에서 그 연결을 release 해도 된다.
+     *   - 전체 슬롯을 훑으므로 종료 처리처럼 드문 경로에서만 쓴다.
+     */
+    template <typename Fn>
+    void forEach(Fn &&fn) {
+        for (std::size_t index = 0; index < capacity(); ++index) {
+            Slot &slot = slotAt(index);
+            if (slot.live) {
+                fn(slot.conn);
+            }
+        }
+    }
+
+ private:
+    struct Slot {
+        Connection conn;
+        std::uint32_t generation = 1;
+        bool live = false;
+    };
+
+    Slot &slotAt(std::size_t index) { return slabs_[index / SLAB_SIZE][index % SLAB_SIZE]; }
+    void grow();
+
+    std::vector<std::unique_ptr<Slot[]>> slabs_;
+    std::vector<std::uint32_t> free_;
+    std::size_t live_ = 0;
+};
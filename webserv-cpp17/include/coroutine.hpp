@@ -0,0 +1,188 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "compression.hpp"
+
+/**
+ * [모듈] webserv-cpp17/include/coroutine.hpp
+ * 설명:
+ *   - 이벤트 루프 위에서 도는 코루틴 핸들러 인터페이스. 핸들러는 본문 조각, 타이머, 업스트림 응답을
+ *     `CO_AWAIT` 로 기다리는 순서대로 쓰고, 워커가 그 사이의 멈춤/재개를 맡는다.
+ *   - C++17 에는 co_await 가 없으므로 switch 기반 스택 없는(stackless) 코루틴으로 흉내 낸다.
+ *     멈춘 위치는 프레임의 정수 하나(resume_point_)이고, 살아남아야 하는 값은 프레임 멤버에 둔다.
+ *   - 프레임은 전역 힙이 아니라 연결마다 둔 FrameArena 에 만든다. 같은 연결의 다음 요청이 그 메모리를 다시 쓴다.
+ * 버전: v1.18.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.18.0-coroutine-handlers.md
+ * 변경 이력:
+ *   - v1.18.0: Coroutine, CO_* 매크로, FrameArena, 연결별 코루틴 상태(CoContext) 추가
+ * 테스트:
+ *   - tests/test_webserv_coroutine.sh
+ *   - tests/test_webserv_alloc_free.sh
+ */
+
+// 코루틴이 멈추며 기다리는 것. kDone 이면 응답(status, CoContext::body)이 정해졌다.
+enum class CoWait : std::uint8_t {
+    kNone,      // 아직 한 번도 돌지 않았다
+    kBody,      // 다음 요청 본문 조각 또는 본문 끝
+    kTimer,     // value 밀리초 뒤
+    kUpstream,  // CoContext::target 에 보낸 업스트림 GET 의 응답 전체
+    kDone,      // value 가 응답 상태 코드다
+};
+
+// resume 이 돌려주는 다음 할 일. CoContext 의 readBody/sleep/fetch 와 CO_RETURN 이 만든다.
+struct CoStep {
+    CoWait wait = CoWait::kNone;
+    std::uint32_t value = 0;
+};
+
+/**
+ * FrameArena (v1.18.0)
+ * 역할:
+ *   - 코루틴 프레임을 놓는 연결별 범프 할당기. 요청이 끝나면 reset 으로 통째로 비우고, 용량은 남겨
+ *     같은 연결의 다음 요청이 힙 할당 없이 다시 쓴다.
+ * 주의 사항:
+ *   - 비어 있을 때만 커진다. 프레임이 살아 있는 동안 옮기면 프레임 주소가 바뀌기 때문이다.
+ *     요청마다 프레임은 하나이므로 첫 create 는 항상 들어간다. 자리가 없으면 nullptr 이다.
+ *   - 정렬은 max_align_t 까지만 지원한다.
+ */
+class FrameArena {
+ public:
+    static constexpr std::size_t INITIAL_BYTES = 256;
+
+    FrameArena() = default;
+
+    FrameArena(const FrameArena &) = delete;
+    FrameArena &operator=(const FrameArena &) = delete;
+
+    template <typename T, typename... Args>
+    T *create(Args &&...args) {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "FrameArena 는 max_align_t 정렬까지만 지원합니다");
+        void *memory = allocate(sizeof(T));
+        return memory != nullptr ? new (memory) T(std::forward<Args>(args)...) : nullptr;
+    }
+
+    // 프레임 소멸자는 호출자가 먼저 부른다.
+    void reset() { used_ = 0; }
+    // 용량까지 돌려준다. retained 보다 큰 저장소만 놓는다.
+    void shrink(std::size_t retained);
+
+    std::size_t used() const { return used_; }
+    std::size_t capacity() const { return capacity_; }
+
+ private:
+    void *allocate(std::size_t size);
+
+    std::unique_ptr<std::max_align_t[]> storage_;
+    std::size_t capacity_ = 0;
+    std::size_t used_ = 0;
+};
+
+struct CoContext;
+
+/**
+ * Coroutine (v1.18.0)
+ * 역할:
+ *   - 코루틴 핸들러의 기반 클래스. resume 은 지난번에 멈춘 CO_AWAIT 바로 뒤에서 이어 달리다가
+ *     다음 CO_AWAIT 나 CO_RETURN 에서 돌아온다.
+ * 사용법:
+ *   CoStep resume(CoContext &co) override {
+ *       CO_BEGIN;
+ *       while (true) {
+ *           CO_AWAIT(co.readBody());
+ *           if (co.body_end) break;
+ *           co.body.append(co.slice.data(), co.slice.size());
+ *       }
+ *       CO_RETURN(200);
+ *       CO_END;
+ *   }
+ * 주의 사항:
+ *   - CO_BEGIN 과 CO_END 사이의 지역 변수는 CO_AWAIT 를 넘어 살아남지 않는다. 초기화가 있는 지역 변수가
+ *     CO_AWAIT 를 가로지르면 컴파일 오류(case 라벨이 초기화를 건너뜀)가 나므로 실수로 쓸 수 없다. 멤버에 둔다.
+ *   - 한 줄에 CO_AWAIT 를 두 번 쓰지 않는다(줄 번호가 재개 지점이다). 핸들러 자신의 switch 안에도 두지 않는다
+ *     (case 라벨이 안쪽 switch 에 붙는다).
+ *   - 프레임 안의 string_view 는 멈춘 뒤 무효일 수 있다. 생성자에서 필요한 값은 복사해 둔다.
+ */
+class Coroutine {
+ public:
+    virtual ~Coroutine() = default;
+    virtual CoStep resume(CoContext &co) = 0;
+
+ protected:
+    int resume_point_ = 0;
+};
+
+#define CO_BEGIN                   \
+    switch (this->resume_point_) { \
+        case 0:
+
+#define CO_AWAIT(step)                         \
+    do {                                       \
+        this->resume_point_ = __LINE__;        \
+        return (step);                         \
+        case __LINE__:;                        \
+    } while (false)
+
+#define CO_RETURN(status)                                                 \
+    do {                                                                  \
+        this->resume_point_ = -1;                                         \
+        return CoStep{CoWait::kDone, static_cast<std::uint32_t>(status)}; \
+    } while (false)
+
+// CO_RETURN 없이 끝에 닿았거나 끝난 코루틴을 다시 불렀다. 핸들러 버그이므로 503 으로 답하게 한다.
+#define CO_END                    \
+    }                             \
+    this->resume_point_ = -1;     \
+    return CoStep { CoWait::kDone, 503 }
+
+/**
+ * CoContext (v1.18.0)
+ * 설명:
+ *   - 연결 하나의 코루틴 상태. 핸들러에게는 기다릴 것(readBody/sleep/fetch)을 만드는 곳이자
+ *     재개할 때 결과(slice, upstream_status 등)를 읽는 곳이다. 워커는 프레임과 멈춘 이유(wait)를 본다.
+ * 주의 사항:
+ *   - slice 는 입력 버퍼를 가리킨다. 다음 CO_AWAIT 전까지만 쓴다.
+ *   - upstream_status 는 업스트림 응답 상태다. 맞는 `--proxy` 접두사가 없으면 0, 연결 실패는 502,
+ *     응답 타임아웃은 504 다.
+ *   - 문자열 버퍼는 용량을 남기고 재사용한다. RETAINED_CAPACITY 를 넘긴 버퍼만 reset 에서 놓는다.
+ *   - 워커 스레드만 만진다.
+ */
+struct CoContext {
+    static constexpr std::size_t RETAINED_CAPACITY = 64 * 1024;
+
+    // 다음 본문 조각을 기다린다. 재개되면 slice 가 조각이고, 본문이 끝났으면 body_end 가 참이다.
+    static CoStep readBody() { return CoStep{CoWait::kBody, 0}; }
+    // ms 밀리초 뒤에 재개한다. 그동안 연결의 다른 타임아웃은 멈춘다.
+    static CoStep sleep(std::uint32_t ms) { return CoStep{CoWait::kTimer, ms}; }
+    // target 경로를 `--proxy` 업스트림에 GET 으로 보내고 응답 본문까지 받은 뒤 재개한다.
+    static CoStep fetch() { return CoStep{CoWait::kUpstream, 0}; }
+
+    // 핸들러가 채우는 값: fetch 가 보낼 경로와 CO_RETURN 의 상태와 함께 보낼 응답 본문.
+    std::string target;
+    std::string body;
+
+    // 재개할 때 핸들러가 읽는 값.
+    std::string_view slice;
+    bool body_end = false;
+    int upstream_status = 0;
+    std::string upstream_body;
+
+    // 워커가 쓰는 값.
+    FrameArena arena;
+    Coroutine *frame = nullptr;
+    CoWait wait = CoWait::kNone;
+    bool ready = false;  // 기다리던 타이머가 만료되었다
+    int status = 0;
+    ContentCoding coding = ContentCoding::kIdentity;
+
+    bool active() const { return frame != nullptr; }
+    // 프레임을 부수고 다음 요청을 위해 비운다.
+    void reset();
+};
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <memory>
+
+#include "event_loop.hpp"
+#include "io_backend.hpp"
+
+/**
+ * [모듈] webserv-cpp17/include/epoll_backend.hpp
+ * 설명:
+ *   - EventLoop(epoll 엣지 트리거)와 논블로킹 accept/recv/send 로 IoBackend 를 구현한다.
+ * 버전: v1.25.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.1.0-epoll-reactor.md
+ *   - design/webserv-cpp17/v1.11.0-io-uring-backend.md
+ *   - design/webserv-cpp17/v1.22.0-tls.md
+ *   - design/webserv-cpp17/v1.25.0-config-reload.md
+ * 변경 이력:
+ *   - v1.11.0: Worker 의 수락/수신/관심사 변경 코드를 옮겨 기본 백엔드로 분리
+ *   - v1.22.0: TLS 연결의 수신/송신을 TlsStream 으로 돌리고 scratch 버퍼 추가
+ *   - v1.25.0: unwatchListener 재정의
+ * 테스트:
+ *   - tests/test_webserv_epoll_many.sh
+ *   - tests/test_webserv_slow_reader.sh
+ *   - tests/test_webserv_tls.sh
+ *   - tests/test_webserv_reload.sh
+ */
+
+/**
+ * EpollBackend (v1.11.0)
+ * 역할:
+ *   - v1.10.0 까지 워커가 직접 하던 동작 그대로다. 준비 통지를 받고 시스템 호출을 바로 부른다.
+ * 주의 사항:
+ *   - 쓰기 관심사는 출력 큐가 남아 있을 때만 켜고, 바뀔 때만 epoll_ctl 을 호출한다(Connection::interest).
+ *   - TLS 연결(Connection::tls)은 recv/flush 를 TlsStream 에 맡긴다. 핸드셰이크가 소켓 쓰기를 기다리는 동안에도
+ *     쓰기 관심사를 켠다. 파일 구간을 읽어 암호화할 scratch 버퍼는 워커마다 하나를 처음 쓸 때 만든다(v1.22.0).
+ */
+class EpollBackend : public IoBackend {
+ public:
+    EpollBackend() = default;
+
+    bool valid() const { return loop_.valid(); }
+
+    const char *name() const override { return "epoll"; }
+    bool watchListener(int listen_fd) override;
+    bool watchReadable(int fd) override;
+    void unwatchListener(int listen_fd) override;
+    int accept(int listen_fd) override;
+    bool addConnection(Connection &conn) override;
+    ssize_t recv(Connection &conn, char *destination, std::size_t capacity) override;
+    FlushResult flush(Connection &conn, std::size_t &sent_out) override;
+    bool updateInterest(Connection &conn) override;
+    void closeConnection(Connection &conn) override;
+    int wait(std::vector<IoEvent> &out, int timeout_ms) override;
+
+ private:
+    EventLoop loop_;
+    std::unique_ptr<char[]> tls_scratch_;
+};
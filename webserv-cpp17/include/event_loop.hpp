@@ -0,0 +1,83 @@
+#pragma once
+
+#include <sys/epoll.h>
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * [모듈] webserv-cpp17/include/event_loop.hpp
+ * 설명:
+ *   - epoll 기반 엣지 트리거(edge-triggered) 리액터 선언부를 제공한다.
+ *   - 준비된 FD만 돌려주므로 연결 수와 무관하게 O(ready) 로 이벤트를 분배한다.
+ * 버전: v1.1.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.1.0-epoll-reactor.md
+ * 변경 이력:
+ *   - v1.1.0: select 루프를 대체하는 epoll 리액터 추가
+ * 테스트:
+ *   - tests/test_webserv_epoll_many.sh
+ */
+
+// 이벤트 관심사/발생 비트. epoll 플래그를 직접 노출하지 않아 상위 코드가 백엔드에 묶이지 않게 한다.
+constexpr std::uint32_t EVENT_READ = 1u << 0;
+constexpr std::uint32_t EVENT_WRITE = 1u << 1;
+constexpr std::uint32_t EVENT_ERROR = 1u << 2;
+
+/**
+ * IoEvent
+ * 설명:
+ *   - wait 한 번으로 수집된 준비 이벤트 하나를 나타낸다.
+ *   - token 은 등록 시 넘긴 값(기본은 FD)을 그대로 돌려준다.
+ */
+struct IoEvent {
+    std::uint64_t token;
+    std::uint32_t events;
+};
+
+/**
+ * EventLoop (v1.1.0)
+ * 역할:
+ *   - epoll 인스턴스를 소유하고 FD 등록/관심사 변경/해제/대기를 제공한다.
+ *   - 모든 FD를 EPOLLET 로 등록하므로 호출자는 EAGAIN 까지 읽고/써야 한다.
+ * 설계:
+ *   - design/webserv-cpp17/v1.1.0-epoll-reactor.md
+ * 주의 사항:
+ *   - 복사 불가. epoll FD는 소멸자에서 닫는다.
+ *   - 닫기 전에 remove 를 호출하지 않아도 커널이 자동으로 해제하지만,
+ *     FD 재사용 경쟁을 피하기 위해 호출자가 명시적으로 remove 하는 것을 권장한다.
+ */
+class EventLoop {
+ public:
+    explicit EventLoop(std::size_t max_events = 1024);
+    ~EventLoop();
+
+    EventLoop(const EventLoop &) = delete;
+    EventLoop &operator=(const EventLoop &) = delete;
+
+    bool valid() const { return epoll_fd_ >= 0; }
+
+    /**
+     * add / modify / remove
+     * 설명:
+     *   - FD 를 엣지 트리거 모드로 등록하거나 관심사(EVENT_READ/EVENT_WRITE)를 바꾼다.
+     * 출력:
+     *   - 성공 시 true, epoll_ctl 실패 시 false (errno 유지)
+     */
+    bool add(int fd, std::uint64_t token, std::uint32_t interest);
+    bool modify(int fd, std::uint64_t token, std::uint32_t interest);
+    void remove(int fd);
+
+    /**
+     * wait
+     * 설명:
+     *   - 최대 timeout_ms 동안 대기하고 준비된 이벤트를 out 에 채운다.
+     * 출력:
+     *   - 준비된 이벤트 수, EINTR 이면 0, 그 밖의 실패는 -1
+     */
+    int wait(std::vector<IoEvent> &out, int timeout_ms);
+
+ private:
+    int epoll_fd_;
+    std::vector<epoll_event> ready_;
+};
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "io_buffer.hpp"
+
+/**
+ * [모듈] webserv-cpp17/include/file_cache.hpp
+ * 설명:
+ *   - 문서 루트 아래 정적 파일의 열린 FD 와 메타데이터(크기, ETag, Content-Type)를 경로별로 보관하는
+ *     LRU 캐시 선언부.
+ *   - 캐시된 파일이 있는 디렉터리를 inotify 로 감시해 수정/삭제/교체 시 항목을 무효화한다.
+ * 버전: v1.10.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.6.0-static-files.md
+ *   - design/webserv-cpp17/v1.10.0-zero-alloc-responses.md
+ * 변경 이력:
+ *   - v1.6.0: 정적 파일 FD/메타데이터 캐시 추가
+ *   - v1.10.0: 조회용 파일 시스템 경로를 멤버 버퍼에 만들어 캐시 적중 시 할당 제거
+ * 테스트:
+ *   - tests/test_webserv_static_files.sh
+ *   - tests/test_webserv_alloc_free.sh
+ */
+
+/**
+ * FileInfo
+ * 설명:
+ *   - 응답 헤더 작성과 sendfile 에 필요한 정보. file 은 출력 큐와 공유된다.
+ */
+struct FileInfo {
+    std::shared_ptr<const FileHandle> file;
+    std::size_t size = 0;
+    std::string etag;
+    std::string_view content_type;
+};
+
+/**
+ * FileCache (v1.6.0)
+ * 역할:
+ *   - URL 경로를 문서 루트 기준 파일 경로로 바꾸고(`..` 거부, `/` 로 끝나면 index.html),
+ *     열린 FD 와 fstat 결과를 LRU 로 보관해 반복 요청에서 open/fstat 을 생략한다.
+ *   - inotify FD 를 워커의 EventLoop 에 등록하고, 읽기 가능해지면 handleNotifications() 로 무효화한다.
+ * 설계:
+ *   - design/webserv-cpp17/v1.6.0-static-files.md
+ * 주의 사항:
+ *   - 워커마다 하나씩 두며 잠금이 없다. 다른 스레드에서 호출하면 안 된다.
+ *   - capacity 가 0 이면 캐시하지 않고 요청마다 open/fstat 한다(비교 측정용).
+ *   - lookup() 이 돌려준 포인터는 다음 lookup()/handleNotifications() 호출 전까지만 유효하다.
+ */
+class FileCache {
+ public:
+    FileCache(std::string root, std::size_t capacity);
+    ~FileCache();
+
+    FileCache(const FileCache &) = delete;
+    FileCache &operator=(const FileCache &) = delete;
+
+    /**
+     * start
+     * 설명:
+     *   - 논블로킹 inotify 인스턴스를 만든다.
+     * 출력:
+     *   - 성공 시 true, inotify_init1 실패 시 false (errno 유지)
+     */
+    bool start();
+    int notifyFd() const { return notify_fd_; }
+
+    /**
+     * lookup
+     * 설명:
+     *   - URL 경로(쿼리 문자열 제외)에 해당하는 일반 파일을 찾는다.
+     * 출력:
+     *   - 파일 정보 포인터, 경로가 잘못되었거나 일반 파일이 아니면 nullptr
+     */
+    const FileInfo *lookup(std::string_view url_path);
+
+    /**
+     * handleNotifications
+     * 설명:
+     *   - 쌓인 inotify 이벤트를 모두 읽고, 변경된 파일의 항목을 버린다.
+     *   - 디렉터리 자체가 삭제/이동되면 그 디렉터리의 항목을 모두 버린다.
+     */
+    void handleNotifications();
+
+    std::size_t size() const { return index_.size(); }
+
+ private:
+    struct Entry {
+        std::string path;
+        FileInfo info;
+        int watch;
+    };
+    using EntryList = std::list<Entry>;
+
+    bool resolve(std::string_view url_path, std::string &fs_path) const;
+    bool openFile(const std::string &fs_path, FileInfo &info) const;
+    int watchDirectory(const std::string &fs_path);
+    void evict(EntryList::iterator it);
+    void invalidate(const std::string &fs_path);
+    void invalidateDirectory(int watch);
+
+    std::string root_;
+    std::size_t capacity_;
+    int notify_fd_;
+    EntryList lru_;
+    std::unordered_map<std::string, EntryList::iterator> index_;
+    // inotify watch 디스크립터 -> 감시 중인 디렉터리 경로와 그 디렉터리에 속한 캐시 항목 수
+    std::unordered_map<int, std::pair<std::string, std::size_t>> watches_;
+    FileInfo scratch_;
+    // lookup 이 URL 경로를 파일 시스템 경로로 바꿔 쓰는 버퍼. 용량을 남겨 두어 캐시 적중 시 할당하지 않는다.
+    std::string path_;
+};
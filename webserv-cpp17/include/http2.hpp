@@ -0,0 +1,380 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "access_log.hpp"
+#include "compression.hpp"
+#include "http_parser.hpp"
+#include "io_buffer.hpp"
+#include "metrics.hpp"
+#include "request_body.hpp"
+
+/**
+ * [모듈] webserv-cpp17/include/http2.hpp
+ * 설명:
+ *   - HTTP/2(RFC 9113) 프레임 계층과 HPACK(RFC 7541) 헤더 압축 선언부.
+ *   - 연결 하나의 스트림 다중화, 스트림/연결 흐름 제어, 응답 DATA 프레임의 스트림 간 끼워 넣기를 맡는다.
+ *   - 요청은 HttpRequestView 로, 응답은 기존 핸들러가 쓴 HTTP/1.1 응답 바이트를 받아 HEADERS/DATA 로 옮긴다.
+ *     라우터와 핸들러는 HTTP/2 를 모른다.
+ * 버전: v1.23.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.23.0-http2.md
+ * 변경 이력:
+ *   - v1.23.0: HpackDecoder, HpackEncoder, Http2Session 추가
+ * 테스트:
+ *   - tests/test_webserv_http2.sh
+ */
+
+// 클라이언트 연결 프리페이스(RFC 9113 3.4). 평문 prior knowledge 연결은 이 24바이트로 시작한다.
+constexpr std::string_view HTTP2_PREFACE = "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n";
+
+// RST_STREAM / GOAWAY 오류 코드(RFC 9113 7).
+enum class Http2Error : std::uint32_t {
+    kNoError = 0x0,
+    kProtocolError = 0x1,
+    kInternalError = 0x2,
+    kFlowControlError = 0x3,
+    kSettingsTimeout = 0x4,
+    kStreamClosed = 0x5,
+    kFrameSizeError = 0x6,
+    kRefusedStream = 0x7,
+    kCancel = 0x8,
+    kCompressionError = 0x9,
+    kConnectError = 0xa,
+    kEnhanceYourCalm = 0xb,
+    kInadequateSecurity = 0xc,
+    kHttp11Required = 0xd,
+};
+
+/**
+ * HpackTable (v1.23.0)
+ * 역할:
+ *   - HPACK 동적 테이블. 새 항목이 앞(색인 0)에 들어가고 크기(이름+값+32 의 합)가 상한을 넘으면 가장 오래된
+ *     항목부터 뺀다. 항목 문자열은 슬롯을 돌려쓰므로 테이블이 한 바퀴 돈 뒤에는 할당이 없다.
+ *   - 슬롯은 처음 항목을 넣을 때 잡는다. HTTP/2 를 쓰지 않는 연결 슬롯은 테이블 메모리를 갖지 않는다.
+ */
+class HpackTable {
+ public:
+    // 항목 하나의 크기에 더하는 고정 비용(RFC 7541 4.1).
+    static constexpr std::size_t ENTRY_OVERHEAD = 32;
+
+    void resize(std::size_t capacity);
+    void insert(std::string_view name, std::string_view value);
+    void clear();
+
+    std::size_t count() const { return count_; }
+    std::size_t capacity() const { return capacity_; }
+    // index 0 이 가장 최근 항목이다.
+    std::string_view name(std::size_t index) const { return slots_[(first_ + index) % slots_.size()].name; }
+    std::string_view value(std::size_t index) const { return slots_[(first_ + index) % slots_.size()].value; }
+
+ private:
+    struct Entry {
+        std::string name;
+        std::string value;
+    };
+
+    void evictOldest();
+
+    std::vector<Entry> slots_;
+    std::size_t first_ = 0;
+    std::size_t count_ = 0;
+    std::size_t size_ = 0;
+    std::size_t capacity_ = 4096;
+};
+
+/**
+ * HpackDecoder (v1.23.0)
+ * 역할:
+ *   - 요청 헤더 블록을 헤더 목록으로 푼다. 허프만 문자열, 동적 테이블, 테이블 크기 갱신을 지원한다.
+ * 주의 사항:
+ *   - 동적 테이블 상한은 서버가 광고한 SETTINGS_HEADER_TABLE_SIZE(기본 4096)다. 이를 넘는 크기 갱신은 오류다.
+ *   - 헤더 목록 크기가 limit 를 넘어도 동적 테이블을 상대와 맞추기 위해 블록 끝까지 푼다. 넘친 뒤의 헤더는 담지 않는다.
+ */
+class HpackDecoder {
+ public:
+    static constexpr std::size_t TABLE_SIZE = 4096;
+
+    HpackDecoder() { table_.resize(TABLE_SIZE); }
+
+    /**
+     * decode
+     * 설명:
+     *   - block 의 헤더들을 순서대로 storage 에 복사하고 headers 가 그 안을 가리키게 한다.
+     * 출력:
+     *   - 성공 시 true, 형식 오류(COMPRESSION_ERROR 로 연결을 닫아야 함)면 false
+     *   - too_large: 헤더 목록 크기(이름+값+32 의 합)가 limit 를 넘었다
+     */
+    bool decode(std::string_view block, std::size_t limit, std::string &storage, std::vector<HeaderField> &headers,
+                bool &too_large);
+
+    void reset() {
+        table_.clear();
+        table_.resize(TABLE_SIZE);
+    }
+
+ private:
+    struct Span {
+        std::size_t name = 0;
+        std::size_t name_length = 0;
+        std::size_t value = 0;
+        std::size_t value_length = 0;
+    };
+
+    HpackTable table_;
+    std::vector<Span> spans_;
+};
+
+/**
+ * HpackEncoder (v1.23.0)
+ * 역할:
+ *   - 응답 헤더를 HPACK 으로 쓴다. 자주 반복되는 헤더(content-type, date, vary 등)만 동적 테이블에 넣고,
+ *     나머지는 정적 테이블의 이름 색인과 리터럴 값으로 쓴다. 허프만이 더 짧을 때만 허프만으로 쓴다.
+ * 주의 사항:
+ *   - 동적 테이블은 상대의 SETTINGS_HEADER_TABLE_SIZE 와 4096 중 작은 값을 넘지 않는다. 상한이 바뀌면
+ *     다음 블록 맨 앞에 크기 갱신을 넣는다.
+ */
+class HpackEncoder {
+ public:
+    static constexpr std::size_t MAX_TABLE_SIZE = 4096;
+
+    HpackEncoder() { table_.resize(MAX_TABLE_SIZE); }
+
+    void setPeerTableSize(std::size_t bytes);
+    void beginBlock(std::string &out);
+    void status(int code, std::string &out);
+    // name 은 소문자여야 한다.
+    void header(std::string_view name, std::string_view value, std::string &out);
+
+    void reset() {
+        table_.clear();
+        table_.resize(MAX_TABLE_SIZE);
+        size_update_ = false;
+    }
+
+ private:
+    HpackTable table_;
+    bool size_update_ = false;
+};
+
+// 스트림 응답의 마지막 바이트(END_STREAM 이 붙은 프레임)가 출력 큐에 들어간 위치. 지연 측정에 쓴다.
+struct Http2Finished {
+    std::uint64_t end_mark = 0;
+    std::chrono::steady_clock::time_point start;
+};
+
+/**
+ * Http2Stream (v1.23.0)
+ * 역할:
+ *   - 스트림 하나의 프로토콜 상태(흐름 제어 창, 남은 응답 본문)와 워커가 요청을 처리하는 동안 두는 상태.
+ * 주의 사항:
+ *   - id 가 0 이면 빈 슬롯이다. 스트림이 닫히면 슬롯은 다음 스트림이 돌려쓴다. 작업 스레드 결과처럼 나중에 오는
+ *     값은 슬롯이 아니라 스트림 id 로 다시 찾아야 한다.
+ *   - pending/file: 흐름 제어 창이 모자라 아직 DATA 로 내보내지 못한 응답 본문. 버퍼 바이트가 먼저, 파일 구간이 뒤다.
+ *   - 아래쪽 필드는 워커가 쓴다. label/route/status/upload/coding 은 RequestBody 와 같은 뜻이고, waiting 은
+ *     작업 스레드 결과를 기다리는 중, result 는 돌아온 결과 본문, access 는 접근 로그 레코드다.
+ */
+struct Http2Stream {
+    std::uint32_t id = 0;
+    bool remote_closed = false;
+    bool responded = false;
+    std::int64_t send_window = 0;
+    std::uint32_t recv_unacked = 0;
+    std::int64_t expected_length = -1;
+    std::uint64_t received = 0;
+    std::string pending;
+    std::size_t pending_offset = 0;
+    std::shared_ptr<const FileHandle> file;
+    std::size_t file_offset = 0;
+    std::size_t file_remaining = 0;
+    std::uint64_t response_bytes = 0;
+
+    std::chrono::steady_clock::time_point start;
+    RouteLabel label = RouteLabel::kError;
+    BodyRoute route = BodyRoute::kDiscard;
+    int status = 0;
+    UploadDigest upload;
+    ContentCoding coding = ContentCoding::kIdentity;
+    bool waiting = false;
+    std::string result;
+    AccessRecord access;
+
+    bool sending() const { return pending_offset < pending.size() || file_remaining > 0; }
+};
+
+struct Http2Settings {
+    std::size_t max_streams = 128;
+    std::size_t window = 1024 * 1024;
+    std::size_t max_header_bytes = 16 * 1024;
+};
+
+enum class Http2Event {
+    kNeedMore,  // 프레임이 덜 왔다. consumed 만큼은 처리했다
+    kRequest,   // stream()/request() 에 새 요청이 있다
+    kData,      // stream() 의 요청 본문 조각 data() 가 있다. dataEnd() 면 본문 끝이다
+    kError,     // 연결 오류. GOAWAY 를 출력 큐에 넣었으니 보내고 닫는다
+};
+
+/**
+ * Http2Session (v1.23.0)
+ * 역할:
+ *   - 연결 하나의 HTTP/2 상태. BodyDecoder 처럼 next 가 입력 버퍼의 바이트를 그 자리에서 해석해 사건 하나씩
+ *     돌려주고, SETTINGS/PING/WINDOW_UPDATE/PRIORITY/CONTINUATION 같은 연결 관리 프레임은 안에서 처리한다.
+ *   - respond 는 핸들러가 쓴 HTTP/1.1 응답(상태 줄, 헤더, 본문 바이트, 파일 구간)을 HEADERS 와 DATA 프레임으로
+ *     옮긴다. 파일 구간은 복사하지 않고 프레임 헤더 뒤에 그대로 이어 붙인다(sendfile 경로가 그대로 산다).
+ *   - flush 는 흐름 제어 창과 출력 큐 상한 안에서 남은 응답 본문을 스트림마다 프레임 하나씩 돌아가며 내보낸다.
+ * 설계:
+ *   - design/webserv-cpp17/v1.23.0-http2.md
+ * 주의 사항:
+ *   - 요청 본문 DATA 는 next 가 돌려주는 즉시 소비된다고 보고, 창의 절반을 받을 때마다 WINDOW_UPDATE 로 돌려준다.
+ *   - 동시 스트림 상한을 넘는 새 스트림은 REFUSED_STREAM 으로 닫는다(클라이언트가 다시 보내도 안전하다).
+ *   - 요청에는 HTTP/1.1 keep-alive 요청처럼 보이도록 version 을 "HTTP/1.1" 로, Host 가 없으면 :authority 를
+ *     host 헤더로 채운다. 핸들러의 응답은 연결 헤더(Connection, Keep-Alive, Transfer-Encoding, Upgrade)를 빼고 옮긴다.
+ */
+class Http2Session {
+ public:
+    // 서버가 받는 프레임 본문 최대 크기(SETTINGS_MAX_FRAME_SIZE 기본값).
+    static constexpr std::size_t MAX_FRAME = 16384;
+
+    bool active() const { return active_; }
+
+    /**
+     * start / startUpgrade
+     * 설명:
+     *   - 세션을 시작하고 서버 SETTINGS 를 출력 큐에 넣는다. 이후 첫 입력은 클라이언트 프리페이스여야 한다.
+     *   - startUpgrade 는 `Upgrade: h2c` 요청의 HTTP2-Settings(base64url) 값을 상대 설정으로 반영하고,
+     *     101 응답과 서버 SETTINGS 를 넣은 뒤 그 요청을 반쯤 닫힌 스트림 1로 만든다. 값이 잘못되었으면 아무것도
+     *     쓰지 않고 nullptr 를 돌려준다(호출자는 업그레이드 없이 HTTP/1.1 로 답한다).
+     */
+    void start(const Http2Settings &settings, WorkerMetrics &metrics, OutputQueue &output);
+    Http2Stream *startUpgrade(const Http2Settings &settings, WorkerMetrics &metrics, std::string_view encoded,
+                              OutputQueue &output);
+
+    /**
+     * next
+     * 설명:
+     *   - data[0..size) 에서 다음 사건을 찾는다. 응답할 프레임(SETTINGS ACK, PING ACK, WINDOW_UPDATE,
+     *     RST_STREAM, GOAWAY)은 output 에 바로 넣는다.
+     * 출력:
+     *   - consumed: 해석을 마친 바이트 수. kData 의 조각은 data 안을 가리키므로 쓴 뒤에 소비한다.
+     */
+    Http2Event next(const char *data, std::size_t size, std::size_t &consumed, OutputQueue &output);
+
+    Http2Stream &stream() { return streams_[event_slot_]; }
+    const HttpRequestView &request() const { return request_; }
+    // 헤더 목록이 max_header_bytes 를 넘었다(431). request() 의 헤더는 일부만 있다.
+    bool headersTooLarge() const { return headers_too_large_; }
+    std::string_view data() const { return data_; }
+    bool dataEnd() const { return data_end_; }
+
+    Http2Stream *find(std::uint32_t id);
+
+    /**
+     * respond
+     * 설명:
+     *   - reply 에 쓰인 HTTP/1.1 응답 하나를 스트림 응답으로 옮기고 reply 를 비운다. 창이 허락하는 만큼은 바로
+     *     DATA 로 내보내고, 나머지는 스트림에 남겨 flush 가 보낸다. head_only 면 본문을 보내지 않는다.
+     * 출력:
+     *   - 응답을 옮겼으면 true. 응답 형식을 해석하지 못하면 INTERNAL_ERROR 로 스트림을 닫고 false
+     */
+    bool respond(Http2Stream &stream, OutputQueue &reply, bool head_only, OutputQueue &output, std::size_t limit);
+
+    // 스트림을 오류 코드로 닫는다(RST_STREAM). 슬롯은 바로 비워진다.
+    void resetStream(Http2Stream &stream, Http2Error code, OutputQueue &output);
+
+    // 남은 응답 본문을 output.bytes() 가 limit 에 닿거나 창이 닫힐 때까지 내보낸다.
+    void flush(OutputQueue &output, std::size_t limit);
+
+    // 새 스트림을 더 받지 않겠다고 알린다(GOAWAY NO_ERROR). 진행 중인 스트림은 끝까지 처리한다.
+    void goAway(OutputQueue &output);
+
+    // 창만 열리면 보낼 응답 본문이 남은 스트림이 있다.
+    bool sending() const;
+    // 작업 스레드 결과를 기다리는 스트림 수.
+    std::size_t waiting() const;
+    std::size_t openStreams() const { return open_; }
+    // 상대가 GOAWAY 를 보냈거나 서버가 goAway 를 불렀다. 열린 스트림이 없으면 연결을 닫아도 된다.
+    bool closing() const { return peer_goaway_ || goaway_sent_; }
+
+    // 응답을 끝낸 스트림들(flush/respond 가 채우고 워커가 비운다).
+    std::vector<Http2Finished> &finished() { return finished_; }
+    // 작업 스레드 결과가 돌아와 응답을 쓸 차례인 스트림 id(워커가 채우고 비운다).
+    std::vector<std::uint32_t> &ready() { return ready_; }
+
+    // 연결 풀이 슬롯을 돌려받을 때 부른다. 버퍼 용량은 남긴다.
+    void reset();
+
+ private:
+    enum class FrameResult {
+        kContinue,  // 다음 프레임을 본다
+        kEvent,     // 사건 하나를 돌려준다
+        kError,     // 연결 오류(GOAWAY 를 넣었다)
+    };
+
+    FrameResult handleFrame(std::uint8_t type, std::uint8_t flags, std::uint32_t id, const char *payload,
+                            std::size_t length, OutputQueue &output);
+    FrameResult handleData(std::uint8_t flags, std::uint32_t id, const char *payload, std::size_t length,
+                           OutputQueue &output);
+    FrameResult handleHeaders(std::uint8_t flags, std::uint32_t id, const char *payload, std::size_t length,
+                              OutputQueue &output);
+    FrameResult finishHeaders(OutputQueue &output);
+    FrameResult applySettings(const char *payload, std::size_t length, bool acknowledge, OutputQueue &output);
+    FrameResult fail(Http2Error code, OutputQueue &output);
+    bool buildRequest(Http2Stream &stream);
+
+    Http2Stream *openStream(std::uint32_t id);
+    void closeStream(Http2Stream &stream);
+    void writeHeaders(Http2Stream &stream, bool end_stream, OutputQueue &output);
+    bool sendFrame(Http2Stream &stream, OutputQueue &output);
+    void finishStream(Http2Stream &stream, OutputQueue &output);
+    void writeServerPreface(OutputQueue &output);
+    void count(Http2StreamLabel label);
+
+    bool active_ = false;
+    bool preface_pending_ = false;
+    bool settings_pending_ = false;
+    bool peer_goaway_ = false;
+    bool goaway_sent_ = false;
+    Http2Settings settings_;
+    WorkerMetrics *metrics_ = nullptr;
+
+    HpackDecoder decoder_;
+    HpackEncoder encoder_;
+
+    std::vector<Http2Stream> streams_;
+    std::size_t open_ = 0;
+    std::size_t cursor_ = 0;
+    std::uint32_t last_peer_stream_ = 0;
+
+    std::int64_t send_window_ = 65535;
+    std::uint32_t recv_unacked_ = 0;
+    std::int64_t peer_initial_window_ = 65535;
+    std::size_t peer_max_frame_ = MAX_FRAME;
+
+    // 모으는 중인 헤더 블록(HEADERS + CONTINUATION)과 그 스트림.
+    std::uint32_t header_stream_ = 0;
+    bool header_new_ = false;
+    bool header_end_stream_ = false;
+    bool continuation_ = false;
+    std::string header_block_;
+
+    Http2Event event_ = Http2Event::kNeedMore;
+    std::size_t event_slot_ = 0;
+    HttpRequestView request_;
+    bool headers_too_large_ = false;
+    std::string header_storage_;
+    std::vector<HeaderField> header_list_;
+    std::string_view data_;
+    bool data_end_ = false;
+
+    std::string block_;
+    std::string lower_;
+    std::vector<Http2Finished> finished_;
+    std::vector<std::uint32_t> ready_;
+};
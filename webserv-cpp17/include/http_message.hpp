@@ -0,0 +1,188 @@
+#pragma once
+
+#include <cstddef>
+#include <ctime>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+
+#include "io_buffer.hpp"
+
+/**
+ * [모듈] webserv-cpp17/include/http_message.hpp
+ * 설명:
+ *   - HTTP 응답 직렬화 함수 선언부를 제공한다.
+ *   - v1.10.0부터 응답은 임시 문자열 없이 출력 큐 버퍼에 바로 직렬화하고, 고정 응답은 미리 만든 바이트열을 복사한다.
+ * 버전: v1.17.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v0.3.0-http11-core.md
+ *   - design/webserv-cpp17/v1.1.0-epoll-reactor.md
+ *   - design/webserv-cpp17/v1.3.0-incremental-parser.md
+ *   - design/webserv-cpp17/v1.6.0-static-files.md
+ *   - design/webserv-cpp17/v1.10.0-zero-alloc-responses.md
+ *   - design/webserv-cpp17/v1.12.0-streaming-request-body.md
+ *   - design/webserv-cpp17/v1.14.0-response-compression.md
+ *   - design/webserv-cpp17/v1.15.0-response-cache.md
+ *   - design/webserv-cpp17/v1.16.0-reverse-proxy.md
+ *   - design/webserv-cpp17/v1.17.0-handler-offload.md
+ * 변경 이력:
+ *   - v0.3.0: Host/keep-alive 처리용 요청 파서와 응답 생성기 추가
+ *   - v1.1.0: main.cpp 에서 분리해 독립 모듈로 정리
+ *   - v1.3.0: 요청 파싱을 http_parser 모듈로 옮기고 응답 직렬화만 남김
+ *   - v1.6.0: 본문을 따로 보내는 정적 파일 응답 헤더 직렬화 추가
+ *   - v1.10.0: 문자열 조합(buildResponse/buildFileResponseHeader)을 출력 큐 직접 직렬화로 교체,
+ *     Date 헤더 캐시와 미리 만든 고정 응답(ResponseTemplates) 추가
+ *   - v1.12.0: 헤더/본문 제한과 본문 길이 오류용 고정 응답, 100 Continue 중간 응답 추가
+ *   - v1.14.0: 응답 직렬화에 추가 헤더 줄(Content-Encoding, Vary) 인자 추가
+ *   - v1.15.0: 304 Not Modified 직렬화, HTTP 날짜(IMF-fixdate) 쓰기/읽기 추가
+ *   - v1.16.0: 프록시 업스트림 실패용 502/504 고정 응답 추가
+ *   - v1.17.0: 작업 스레드 큐가 찼을 때의 503 고정 응답 추가
+ * 테스트:
+ *   - tests/test_webserv_keepalive.sh
+ *   - tests/test_webserv_static_files.sh
+ *   - tests/test_webserv_alloc_free.sh
+ *   - tests/test_webserv_request_body.sh
+ *   - tests/test_webserv_compression.sh
+ *   - tests/test_webserv_response_cache.sh
+ *   - tests/test_webserv_proxy.sh
+ *   - tests/test_webserv_offload.sh
+ */
+
+/**
+ * CannedReply
+ * 설명:
+ *   - 본문과 상태가 고정된 응답. ResponseTemplates 가 keep-alive/close 두 가지로 미리 만들어 둔다.
+ */
+enum class CannedReply {
+    kHealth,
+    kMethodNotAllowed,
+    kNotFound,
+    kMissingHost,
+    kMalformed,
+    kHeaderTooLarge,
+    kBodyTooLarge,
+    kBadFraming,
+    kUnsupportedEncoding,
+    kBadGateway,
+    kGatewayTimeout,
+    kServiceUnavailable,
+    kCount,
+};
+
+// `Expect: 100-continue` 요청에 본문을 보내라고 알리는 중간 응답. 최종 응답 앞에 그대로 붙인다.
+constexpr std::string_view CONTINUE_RESPONSE = "HTTP/1.1 100 Continue\r\n\r\n";
+
+/**
+ * ResponseTemplates (v1.10.0)
+ * 역할:
+ *   - `Date` 헤더 줄(IMF-fixdate)을 초 단위로 캐시하고, CannedReply 응답 전체를 바이트열로 미리 만들어 둔다.
+ *   - refresh 는 초가 바뀌었을 때만 Date 줄과 고정 응답을 다시 쓴다. 길이가 같으므로 재할당이 없다.
+ * 설계:
+ *   - design/webserv-cpp17/v1.10.0-zero-alloc-responses.md
+ * 주의 사항:
+ *   - 워커마다 하나씩 둔다. 스레드 안전하지 않다.
+ */
+class ResponseTemplates {
+ public:
+    explicit ResponseTemplates(std::time_t now = std::time(nullptr));
+
+    // now 가 다른 초로 넘어갔을 때만 다시 만든다.
+    void refresh(std::time_t now);
+
+    // "Date: Sun, 06 Nov 1994 08:49:37 GMT\r\n"
+    std::string_view dateLine() const { return std::string_view(date_line_, DATE_LINE_LENGTH); }
+
+    std::string_view canned(CannedReply reply, bool keep_alive) const {
+        return rendered_[static_cast<std::size_t>(reply)][keep_alive ? 1 : 0];
+    }
+
+    // 마지막 refresh 의 유닉스 시각(초). Date 줄과 같은 값이다.
+    std::time_t second() const { return second_; }
+
+ private:
+    static constexpr std::size_t DATE_LINE_LENGTH = 37;
+
+    void render();
+
+    std::time_t second_;
+    char date_line_[DATE_LINE_LENGTH + 1];
+    std::string rendered_[static_cast<std::size_t>(CannedReply::kCount)][2];
+};
+
+// "Sun, 06 Nov 1994 08:49:37 GMT" 길이.
+constexpr std::size_t HTTP_DATE_LENGTH = 29;
+
+/**
+ * formatHttpDate
+ * 설명:
+ *   - 유닉스 시각을 IMF-fixdate(RFC 9110 5.6.7)로 out 에 HTTP_DATE_LENGTH 바이트 쓴다. 끝에 NUL 은 붙이지 않는다.
+ */
+void formatHttpDate(std::time_t when, char *out);
+
+/**
+ * parseHttpDate
+ * 설명:
+ *   - `If-Modified-Since` 같은 헤더 값의 IMF-fixdate 를 유닉스 시각으로 읽는다.
+ *   - 폐지된 RFC 850/asctime 형식은 받지 않는다. 해석하지 못한 조건부 헤더는 무시하면 되므로 거짓을 돌려준다.
+ */
+bool parseHttpDate(std::string_view text, std::time_t &out);
+
+/**
+ * writeResponse
+ * 설명:
+ *   - 상태 줄, 헤더, 본문 조각들을 출력 큐 버퍼에 바로 직렬화한다. Content-Length 는 조각 길이의 합이다.
+ *   - 본문을 조각으로 받으므로 호출자가 본문을 문자열로 이어 붙이지 않아도 된다.
+ * 입력:
+ *   - status: HTTP 상태 코드
+ *   - body: 본문 조각들(순서대로 이어진다)
+ *   - keep_alive: 연결을 유지할지 여부
+ *   - date_line: ResponseTemplates::dateLine()
+ *   - extra_headers: 그대로 덧붙일 헤더 줄들(각 줄이 CRLF 로 끝난다). 예: codingHeaders()
+ * 출력:
+ *   - output 에 응답 하나가 추가된다. 버퍼 용량이 충분하면 힙 할당이 없다.
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.10.0-zero-alloc-responses.md
+ * 관련 테스트:
+ *   - tests/test_webserv_keepalive.sh
+ *   - tests/test_webserv_alloc_free.sh
+ */
+void writeResponse(OutputQueue &output, int status, std::initializer_list<std::string_view> body, bool keep_alive,
+                   std::string_view date_line, std::string_view extra_headers = std::string_view());
+
+/**
+ * writeFileResponseHeader
+ * 설명:
+ *   - 정적 파일용 200 응답의 상태 줄과 헤더(빈 줄 포함)만 출력 큐에 직렬화한다. 본문은 호출자가 넣는다.
+ * 입력:
+ *   - length: 본문 길이(Content-Length)
+ *   - content_type: Content-Type 값
+ *   - etag: ETag 값(따옴표 포함)
+ *   - keep_alive: 연결을 유지할지 여부
+ *   - date_line: ResponseTemplates::dateLine()
+ *   - extra_headers: 그대로 덧붙일 헤더 줄들(각 줄이 CRLF 로 끝난다)
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.6.0-static-files.md
+ *   - design/webserv-cpp17/v1.10.0-zero-alloc-responses.md
+ * 관련 테스트:
+ *   - tests/test_webserv_static_files.sh
+ */
+void writeFileResponseHeader(OutputQueue &output, std::size_t length, std::string_view content_type,
+                             std::string_view etag, bool keep_alive, std::string_view date_line,
+                             std::string_view extra_headers = std::string_view());
+
+/**
+ * writeNotModified
+ * 설명:
+ *   - 본문 없는 `304 Not Modified` 응답을 직렬화한다. 200 응답에 실었을 검증자/Vary 헤더를 validator_headers 로 받는다.
+ *   - 304 에는 본문이 없으므로 Content-Type/Content-Length 를 쓰지 않는다(RFC 9110 15.4.5).
+ * 입력:
+ *   - keep_alive: 연결을 유지할지 여부
+ *   - date_line: ResponseTemplates::dateLine()
+ *   - validator_headers: `ETag: ...\r\n` 등 CRLF 로 끝나는 헤더 줄들
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.15.0-response-cache.md
+ * 관련 테스트:
+ *   - tests/test_webserv_response_cache.sh
+ */
+void writeNotModified(OutputQueue &output, bool keep_alive, std::string_view date_line,
+                      std::string_view validator_headers);
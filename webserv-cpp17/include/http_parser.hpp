@@ -0,0 +1,134 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * [모듈] webserv-cpp17/include/http_parser.hpp
+ * 설명:
+ *   - 재개 가능한(resumable) 상태 머신 HTTP/1.x 요청 파서 선언부.
+ *   - 결과는 연결 버퍼를 가리키는 string_view 조각으로 제공해 요청당 문자열 복사를 없앤다.
+ * 버전: v1.3.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.3.0-incremental-parser.md
+ * 변경 이력:
+ *   - v1.3.0: istringstream/std::map 기반 parseHttpRequest 를 대체하는 증분 파서 추가
+ * 테스트:
+ *   - tests/test_webserv_incremental_parse.sh
+ *   - tests/test_webserv_host_header.sh
+ */
+
+// 요청 하나에서 보관하는 최대 헤더 수. 초과하면 형식 오류로 처리한다.
+constexpr std::size_t MAX_HEADERS = 32;
+
+struct HeaderField {
+    std::string_view name;
+    std::string_view value;
+};
+
+/**
+ * HttpRequestView (v1.3.0)
+ * 역할:
+ *   - 완성된 요청의 메서드/경로/버전/헤더를 버퍼 내부 조각으로 담는다.
+ *   - 헤더는 작은 고정 배열에 저장하고 선형 탐색으로 찾는다(헤더 수가 적어 map 보다 빠르다).
+ * 주의 사항:
+ *   - 조각이 가리키는 버퍼를 수정/해제하면 무효가 된다. 응답을 만든 뒤에 버퍼를 소비해야 한다.
+ */
+struct HttpRequestView {
+    std::string_view method;
+    std::string_view path;
+    std::string_view version;
+    std::array<HeaderField, MAX_HEADERS> headers;
+    std::size_t header_count = 0;
+
+    /**
+     * findHeader
+     * 설명:
+     *   - 대소문자를 구분하지 않고 헤더를 찾는다.
+     * 출력:
+     *   - 찾으면 해당 HeaderField 포인터, 없으면 nullptr
+     */
+    const HeaderField *findHeader(std::string_view name) const;
+};
+
+enum class ParseStatus {
+    kIncomplete,
+    kComplete,
+    kError,
+};
+
+/**
+ * equalsIgnoreCase
+ * 설명:
+ *   - ASCII 기준으로 대소문자를 무시하고 두 문자열을 비교한다(할당 없음).
+ */
+bool equalsIgnoreCase(std::string_view lhs, std::string_view rhs);
+
+/**
+ * HttpParser (v1.3.0)
+ * 역할:
+ *   - 연결 버퍼에 데이터가 추가될 때마다 parse 를 다시 호출하면, 이전에 훑은 위치부터 이어서
+ *     줄 단위로 요청 라인과 헤더를 해석한다. 같은 바이트를 두 번 훑지 않는다.
+ *   - 줄 끝('\n') 탐색은 SSE2 로 16바이트씩 비교한다(SSE2 가 없으면 memchr).
+ * 설계:
+ *   - design/webserv-cpp17/v1.3.0-incremental-parser.md
+ * 주의 사항:
+ *   - 완성 전까지는 버퍼 시작 기준 오프셋만 저장하므로, 버퍼가 재할당되어도 안전하다.
+ *     단, kIncomplete 이후 다음 호출까지 버퍼 앞부분을 지우거나 옮기면 안 된다.
+ *   - kComplete 후 consumed() 만큼 버퍼를 소비하고 reset() 을 호출해 다음 요청을 받는다.
+ */
+class HttpParser {
+ public:
+    HttpParser() { reset(); }
+
+    /**
+     * parse
+     * 설명:
+     *   - data[0..size) 가 현재까지 누적된 요청 바이트라고 보고 파싱을 이어간다.
+     * 입력:
+     *   - data/size: 연결 버퍼의 미소비 영역 (호출 간 시작 위치가 같아야 한다)
+     * 출력:
+     *   - kIncomplete: 더 많은 데이터가 필요함
+     *   - kComplete: request()/consumed() 사용 가능
+     *   - kError: 요청 라인 형식 오류 또는 헤더 수 초과
+     * 관련 테스트:
+     *   - tests/test_webserv_incremental_parse.sh
+     */
+    ParseStatus parse(const char *data, std::size_t size);
+
+    const HttpRequestView &request() const { return request_; }
+    std::size_t consumed() const { return consumed_; }
+    void reset();
+
+ private:
+    struct Span {
+        std::uint32_t offset;
+        std::uint32_t length;
+    };
+    struct HeaderSpan {
+        Span name;
+        Span value;
+    };
+
+    enum class State {
+        kRequestLine,
+        kHeaderLine,
+    };
+
+    bool parseRequestLine(const char *data, std::size_t begin, std::size_t end);
+    bool parseHeaderLine(const char *data, std::size_t begin, std::size_t end);
+    void materialize(const char *data);
+
+    State state_;
+    std::size_t scan_pos_;
+    std::size_t line_start_;
+    std::size_t consumed_;
+    Span method_;
+    Span path_;
+    Span version_;
+    std::array<HeaderSpan, MAX_HEADERS> header_spans_;
+    std::size_t header_count_;
+    HttpRequestView request_;
+};
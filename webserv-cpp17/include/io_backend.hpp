@@ -0,0 +1,110 @@
+#pragma once
+
+#include <sys/types.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "connection_pool.hpp"
+#include "event_loop.hpp"
+#include "io_buffer.hpp"
+#include "server_config.hpp"
+
+/**
+ * [모듈] webserv-cpp17/include/io_backend.hpp
+ * 설명:
+ *   - 워커가 소켓 수락/수신/송신과 이벤트 대기에 쓰는 I/O 백엔드 인터페이스 선언부.
+ *   - epoll 준비 통지 루프(EpollBackend)와 io_uring 완료 큐(IoUringBackend)가 같은 인터페이스를 구현한다.
+ * 버전: v1.25.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.11.0-io-uring-backend.md
+ *   - design/webserv-cpp17/v1.25.0-config-reload.md
+ * 변경 이력:
+ *   - v1.11.0: 워커의 EventLoop 직접 사용을 백엔드 인터페이스로 분리
+ *   - v1.25.0: 리슨 소켓을 백엔드에서 빼는 unwatchListener 추가(drain)
+ * 테스트:
+ *   - tests/test_webserv_io_uring.sh
+ *   - tests/test_webserv_reload.sh
+ */
+
+/**
+ * IoBackend (v1.11.0)
+ * 역할:
+ *   - 워커 루프는 "이벤트를 받으면 EAGAIN 까지 recv, 출력 큐 flush" 라는 준비 통지 모델로 짜여 있다.
+ *     이 인터페이스는 그 모델을 유지한 채 실제 시스템 호출 방식만 바꿀 수 있게 한다.
+ *   - 완료 기반 백엔드는 recv/flush 를 커널에 맡긴 작업으로 바꾸고, 완료를 wait 에서 이벤트로 돌려준다.
+ * 설계:
+ *   - design/webserv-cpp17/v1.11.0-io-uring-backend.md
+ * 주의 사항:
+ *   - 리슨 소켓/보조 FD 이벤트의 토큰은 FD 값, 연결 이벤트의 토큰은 연결 풀 핸들이다.
+ *   - recv 는 ::recv 와 같은 규약을 따른다(받은 바이트 수, 원격 종료 0, 실패 -1 과 errno). 더 받을 것이 없으면
+ *     -1/EAGAIN 이며, 이때 새 데이터가 오면 EVENT_READ 를 다시 올려야 한다.
+ *   - flush 가 kBlocked 를 돌려주면 송신이 진척될 때 EVENT_WRITE 를 다시 올려야 한다.
+ *   - closeConnection 은 FD 를 닫는다. 호출자는 그 뒤에 연결 슬롯을 풀에 돌려준다.
+ */
+class IoBackend {
+ public:
+    virtual ~IoBackend() = default;
+
+    virtual const char *name() const = 0;
+
+    /**
+     * watchListener / watchReadable
+     * 설명:
+     *   - 리슨 소켓은 새 연결이 있을 때, 보조 FD(inotify)는 읽을 것이 있을 때 FD 값을 토큰으로 EVENT_READ 를 올린다.
+     * 출력:
+     *   - 성공 시 true, 실패 시 false (errno 유지)
+     */
+    virtual bool watchListener(int listen_fd) = 0;
+    virtual bool watchReadable(int fd) = 0;
+
+    /**
+     * unwatchListener (v1.25.0)
+     * 설명:
+     *   - 리슨 소켓의 새 연결 통지를 끈다. FD 는 닫지 않는다. 리슨 소켓을 다른 프로세스에 넘긴 뒤 drain 할 때 쓴다.
+     *   - 백엔드가 이미 수락해 둔 연결은 accept 로 계속 꺼낼 수 있다. 그동안은 리슨 이벤트도 계속 올린다.
+     */
+    virtual void unwatchListener(int listen_fd) = 0;
+
+    /**
+     * accept
+     * 설명:
+     *   - 수락된 논블로킹 연결 FD 하나를 돌려준다. 더 없으면 -1 과 errno EAGAIN.
+     */
+    virtual int accept(int listen_fd) = 0;
+
+    virtual bool addConnection(Connection &conn) = 0;
+    virtual ssize_t recv(Connection &conn, char *destination, std::size_t capacity) = 0;
+    virtual FlushResult flush(Connection &conn, std::size_t &sent_out) = 0;
+
+    /**
+     * updateInterest
+     * 설명:
+     *   - 출력 큐 상태에 맞게 쓰기 가능 통지 관심사를 맞춘다.
+     * 출력:
+     *   - 실패 시 false (errno 유지). 호출자가 연결을 닫는다.
+     */
+    virtual bool updateInterest(Connection &conn) = 0;
+    virtual void closeConnection(Connection &conn) = 0;
+
+    /**
+     * wait
+     * 설명:
+     *   - 최대 timeout_ms 동안 대기하고 준비/완료된 이벤트를 out 에 채운다.
+     * 출력:
+     *   - 이벤트 수, EINTR 이면 0, 그 밖의 실패는 -1
+     */
+    virtual int wait(std::vector<IoEvent> &out, int timeout_ms) = 0;
+};
+
+/**
+ * makeIoBackend
+ * 설명:
+ *   - kind 에 맞는 백엔드를 만든다. io_uring 준비가 실패하면(커널 미지원, 권한, 메모리 제한) 이유를 남기고
+ *     epoll 백엔드로 대신한다.
+ * 출력:
+ *   - 백엔드, epoll 인스턴스조차 만들지 못하면 nullptr (errno 유지)
+ */
+std::unique_ptr<IoBackend> makeIoBackend(IoBackendKind kind, ConnectionPool &connections);
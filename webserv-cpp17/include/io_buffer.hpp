@@ -0,0 +1,259 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+#include "ring_queue.hpp"
+
+/**
+ * [모듈] webserv-cpp17/include/io_buffer.hpp
+ * 설명:
+ *   - 연결별 입력 버퍼(읽기 커서 방식)와 출력 큐 선언부.
+ *   - 소비는 커서 이동(O(1))으로 처리하고, 앞부분 정리(compaction)는 꼬리 공간이 모자랄 때만 한다.
+ *   - 출력 큐는 쌓인 응답을 writev 한 번으로 합쳐 보내고, 부분 송신 위치를 기억해 이어서 보낸다.
+ *   - v1.6.0부터 출력 큐에 파일 구간을 넣으면 sendfile 로 사용자 공간 복사 없이 보낸다.
+ *   - v1.10.0부터 출력 큐는 응답 바이트를 연결별 연속 버퍼에 직접 직렬화해 받는다(요청당 힙 할당 없음).
+ * 버전: v1.23.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.4.0-input-cursor-buffer.md
+ *   - design/webserv-cpp17/v1.5.0-output-queue.md
+ *   - design/webserv-cpp17/v1.6.0-static-files.md
+ *   - design/webserv-cpp17/v1.7.0-worker-metrics.md
+ *   - design/webserv-cpp17/v1.9.0-connection-pool.md
+ *   - design/webserv-cpp17/v1.10.0-zero-alloc-responses.md
+ *   - design/webserv-cpp17/v1.11.0-io-uring-backend.md
+ *   - design/webserv-cpp17/v1.20.0-accept-path.md
+ *   - design/webserv-cpp17/v1.22.0-tls.md
+ *   - design/webserv-cpp17/v1.23.0-http2.md
+ * 변경 이력:
+ *   - v1.4.0: 요청마다 std::string::erase 로 앞부분을 당기던 방식을 대체
+ *   - v1.5.0: 논블로킹 송신용 OutputQueue 추가
+ *   - v1.6.0: FileHandle 과 출력 큐 파일 구간(sendfile) 추가
+ *   - v1.7.0: 지연 측정용 누적 송신/적재 바이트 카운터 추가
+ *   - v1.9.0: 연결 풀 재사용을 위한 OutputQueue::clear 추가
+ *   - v1.10.0: OutputQueue 의 문자열 조각 deque 를 연속 바이트 버퍼(prepare/commit 직접 직렬화)와 파일 구간 링으로 교체
+ *   - v1.11.0: 완료 기반 송신용 sendable/markSent 추가
+ *   - v1.20.0: 파이프라이닝된 파일 응답을 묶어 보내는 flush 단위 TCP_CORK 추가
+ *   - v1.22.0: 파일 구간을 직접 읽어 보내는 TLS 송신용 pendingFile/markFileSent 추가
+ *   - v1.23.0: HTTP/2 변환용 frontFile(맨 앞 파일 구간의 핸들과 범위) 추가
+ * 테스트:
+ *   - tests/test_webserv_pipeline_depth.sh
+ *   - tests/test_webserv_slow_reader.sh
+ *   - tests/test_webserv_static_files.sh
+ *   - tests/test_webserv_connection_churn.sh
+ *   - tests/test_webserv_alloc_free.sh
+ *   - tests/test_webserv_io_uring.sh
+ *   - tests/test_webserv_tls.sh
+ *   - tests/test_webserv_http2.sh
+ */
+
+/**
+ * InputBuffer (v1.4.0)
+ * 역할:
+ *   - [read_pos_, write_pos_) 구간이 아직 소비하지 않은 수신 데이터다.
+ *   - recv 는 prepare() 로 얻은 꼬리 영역에 직접 쓰고 commit() 으로 확정한다(중간 복사 없음).
+ *   - 파이프라이닝된 요청 N개를 처리해도 consume() 은 커서만 옮기므로 전체 비용이 O(N) 이다.
+ * 설계:
+ *   - design/webserv-cpp17/v1.4.0-input-cursor-buffer.md
+ * 주의 사항:
+ *   - prepare() 는 정리/확장으로 data() 주소를 바꿀 수 있다. 미소비 구간 안에서의 상대 오프셋은
+ *     유지되므로 HttpParser 의 오프셋 상태는 그대로 유효하다.
+ *   - 완전히 소비되면 커서를 0 으로 되돌려 정리 비용 없이 공간을 재사용한다.
+ */
+class InputBuffer {
+ public:
+    explicit InputBuffer(std::size_t initial_capacity = 4096);
+
+    InputBuffer(InputBuffer &&) noexcept = default;
+    InputBuffer &operator=(InputBuffer &&) noexcept = default;
+
+    const char *data() const { return storage_.get() + read_pos_; }
+    std::size_t size() const { return write_pos_ - read_pos_; }
+    bool empty() const { return read_pos_ == write_pos_; }
+    std::size_t capacity() const { return capacity_; }
+    std::size_t writable() const { return capacity_ - write_pos_; }
+
+    /**
+     * prepare
+     * 설명:
+     *   - 꼬리에 최소 min_space 바이트의 쓰기 공간을 확보하고 그 시작 주소를 돌려준다.
+     *   - 공간이 모자라면 먼저 앞부분 정리를 시도하고, 그래도 모자라면 두 배로 확장한다.
+     */
+    char *prepare(std::size_t min_space);
+
+    void commit(std::size_t bytes) { write_pos_ += bytes; }
+
+    /**
+     * consume
+     * 설명:
+     *   - 앞에서 bytes 만큼 소비한다. 데이터 이동 없이 커서만 옮긴다.
+     */
+    void consume(std::size_t bytes);
+
+    void clear() { read_pos_ = write_pos_ = 0; }
+
+ private:
+    std::unique_ptr<char[]> storage_;
+    std::size_t capacity_;
+    std::size_t read_pos_;
+    std::size_t write_pos_;
+};
+
+/**
+ * FileHandle (v1.6.0)
+ * 역할:
+ *   - 열린 파일 FD 하나를 소유하고 소멸 시 닫는다.
+ * 주의 사항:
+ *   - 파일 캐시와 출력 큐가 shared_ptr 로 함께 소유한다. 캐시에서 밀려나거나 무효화되어도
+ *     송신 중인 응답이 끝날 때까지 FD 가 유지된다.
+ */
+class FileHandle {
+ public:
+    explicit FileHandle(int fd) : fd_(fd) {}
+    ~FileHandle();
+
+    FileHandle(const FileHandle &) = delete;
+    FileHandle &operator=(const FileHandle &) = delete;
+
+    int fd() const { return fd_; }
+
+ private:
+    int fd_;
+};
+
+enum class FlushResult {
+    kDrained,
+    kBlocked,
+    kError,
+};
+
+/**
+ * OutputQueue (v1.5.0)
+ * 역할:
+ *   - 연결에서 아직 보내지 못한 응답 바이트를 순서대로 보관한다.
+ *   - v1.10.0부터 헤더와 본문 바이트는 조각별 std::string 대신 연속 버퍼 하나에 쌓는다.
+ *     응답 직렬화는 prepare() 로 얻은 꼬리 영역에 바로 쓰고 commit() 으로 확정하므로 요청마다 할당이 없다.
+ *     파이프라이닝된 응답 N개가 이미 연속해 있으므로 send 한 번으로 나간다.
+ *   - 파일 구간은 별도 링에 두고, 그 앞까지 쌓인 버퍼 바이트 위치(mark)로 순서를 맞춘다.
+ * 설계:
+ *   - design/webserv-cpp17/v1.5.0-output-queue.md
+ *   - design/webserv-cpp17/v1.10.0-zero-alloc-responses.md
+ * 주의 사항:
+ *   - 부분 송신은 버퍼 읽기 커서(InputBuffer::consume)와 파일 구간 안 오프셋(file_sent_)으로 이어 간다.
+ *   - bytes() 는 백프레셔 판단(high/low water mark)에 쓰인다. 파일 구간도 길이만큼 포함한다.
+ *   - 파일 구간은 sendfile 로 보내며, 바로 앞의 버퍼 바이트(헤더)는 MSG_MORE 로 보내 한 세그먼트로 합쳐지게 한다.
+ *   - 파일 구간 뒤에 더 보낼 바이트가 있으면(파이프라이닝된 응답) flush 동안 TCP_CORK 를 건다. sendfile 은 호출마다
+ *     남은 조각을 밀어내므로 코르크 없이는 응답 경계마다 작은 세그먼트가 생긴다(v1.20.0).
+ *   - sendfile 은 SIGPIPE 를 막는 플래그가 없으므로 프로세스에서 SIGPIPE 를 무시해야 한다(main.cpp).
+ */
+class OutputQueue {
+ public:
+    // 연결마다 처음 잡아 두는 버퍼 크기. 작은 응답 몇 개가 파이프라이닝되어도 늘어나지 않는 정도다.
+    static constexpr std::size_t INITIAL_CAPACITY = 1024;
+
+    OutputQueue()
+        : pending_(INITIAL_CAPACITY),
+          file_sent_(0),
+          buffered_total_(0),
+          bytes_(0),
+          pushed_total_(0),
+          sent_total_(0) {}
+
+    OutputQueue(OutputQueue &&) noexcept = default;
+    OutputQueue &operator=(OutputQueue &&) noexcept = default;
+
+    /**
+     * prepare / commit
+     * 설명:
+     *   - 꼬리에 최소 min_space 바이트의 쓰기 공간을 확보해 돌려주고, 실제로 쓴 바이트 수를 commit 으로 확정한다.
+     *   - 응답 직렬화가 임시 문자열 없이 출력 버퍼에 바로 쓰는 경로다.
+     */
+    char *prepare(std::size_t min_space) { return pending_.prepare(min_space); }
+    void commit(std::size_t bytes);
+
+    // 바이트를 버퍼 꼬리에 복사한다. 미리 만든 응답 블롭처럼 이미 완성된 바이트열에 쓴다.
+    void append(std::string_view bytes);
+    void pushFile(std::shared_ptr<const FileHandle> file, std::size_t offset, std::size_t length);
+    bool empty() const { return bytes_ == 0; }
+    std::size_t bytes() const { return bytes_; }
+    // 바이트 버퍼의 현재 용량. 연결 풀이 너무 커진 버퍼를 반납 시 줄이는 데 쓴다.
+    std::size_t capacity() const { return pending_.capacity(); }
+
+    // 연결 수명 동안 넣은/보낸 누적 바이트. 응답별 완료 시점(마지막 바이트 송신)을 판단하는 데 쓴다.
+    std::uint64_t pushedTotal() const { return pushed_total_; }
+    std::uint64_t sentTotal() const { return sent_total_; }
+
+    /**
+     * flush
+     * 설명:
+     *   - 소켓 송신 버퍼가 찰 때까지(EAGAIN) 또는 큐가 빌 때까지 보낸다.
+     * 출력:
+     *   - kDrained: 모두 송신, kBlocked: 쓰기 가능 이벤트를 기다려야 함, kError: 연결 오류
+     *   - sent_out: 이번 호출에서 보낸 바이트 수
+     */
+    FlushResult flush(int fd, std::size_t &sent_out);
+
+    /**
+     * sendable / markSent (v1.11.0)
+     * 설명:
+     *   - sendable 은 다음에 보낼 버퍼 구간(맨 앞 파일 구간이 있으면 그 mark 까지)을 돌려준다.
+     *     큐가 비어 있지 않은데 빈 구간이면 파일 구간 차례다. file_follows 는 뒤에 파일 구간이 이어지는지 알려 준다.
+     *   - markSent 는 그 구간에서 bytes 만큼 송신이 끝났음을 반영한다.
+     *   - 송신을 커널에 맡기고 완료를 나중에 받는 백엔드(io_uring)가 쓴다. flush 도 같은 두 함수로 구현한다.
+     * 주의 사항:
+     *   - 돌려준 구간은 다음 prepare/append/clear 전까지만 유효하다.
+     */
+    std::string_view sendable(bool &file_follows) const;
+    void markSent(std::size_t bytes);
+
+    // 맨 앞 파일 구간에서 아직 보내지 않은 부분. fd 는 큐가 소유한 FileHandle 의 것이다.
+    struct FileRange {
+        int fd = -1;
+        std::size_t offset = 0;
+        std::size_t length = 0;
+    };
+
+    /**
+     * pendingFile / markFileSent (v1.22.0)
+     * 설명:
+     *   - sendable 이 빈 구간을 돌려준 뒤(파일 차례) 맨 앞 파일 구간의 남은 범위를 돌려주고, bytes 만큼 송신을 반영한다.
+     *     구간을 다 보내면 큐에서 빠진다.
+     *   - 파일 내용을 직접 읽어 암호화해 보내는 TLS 스트림이 쓴다. flush 의 sendfile 경로도 같은 두 함수로 구현한다.
+     */
+    FileRange pendingFile() const;
+    void markFileSent(std::size_t bytes);
+
+    /**
+     * frontFile (v1.23.0)
+     * 설명:
+     *   - 맨 앞 파일 구간의 파일 핸들과 범위를 돌려준다. 없으면 nullptr 이다.
+     *   - HTTP/1 응답을 HTTP/2 DATA 프레임으로 옮길 때 파일 구간을 복사하지 않고 다른 큐로 넘기는 데 쓴다.
+     */
+    std::shared_ptr<const FileHandle> frontFile(std::size_t &offset, std::size_t &length) const;
+
+    // 남은 바이트와 파일 구간을 버리고 누적 카운터를 0 으로 되돌린다. 버퍼 용량은 남긴다.
+    void clear();
+
+ private:
+    struct FileSegment {
+        std::uint64_t mark = 0;  // 이 구간보다 먼저 나가야 하는 버퍼 바이트의 누적 위치
+        std::shared_ptr<const FileHandle> file;
+        std::size_t offset = 0;
+        std::size_t length = 0;
+    };
+
+    FlushResult flushQueued(int fd, std::size_t &sent_out);
+    FlushResult flushFile(int fd, std::size_t &sent_out);
+    static void setCork(int fd, bool on);
+
+    // 송신 대기 중인 헤더/본문 바이트. 입력 버퍼와 같은 읽기 커서 버퍼를 그대로 쓴다.
+    InputBuffer pending_;
+    RingQueue<FileSegment> files_;
+    std::size_t file_sent_;          // 맨 앞 파일 구간에서 이미 보낸 바이트
+    std::uint64_t buffered_total_;   // 버퍼에 넣은 누적 바이트(파일 구간 제외)
+    std::size_t bytes_;
+    std::uint64_t pushed_total_;
+    std::uint64_t sent_total_;
+};
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+/**
+ * [모듈] webserv-cpp17/include/listener_handoff.hpp
+ * 설명:
+ *   - 무중단 업그레이드에서 실행 중인 프로세스가 리슨 소켓을 새 프로세스에 넘기는 유닉스 도메인 소켓 통로 선언부.
+ *   - 이전 프로세스는 제어 소켓(`--control-socket`)을 열어 두고, 새 프로세스(`--takeover`)가 붙으면 리슨 FD 를
+ *     SCM_RIGHTS 로 보낸다. 새 프로세스는 워커를 다 띄운 뒤 같은 연결로 준비 바이트 하나를 돌려준다.
+ * 버전: v1.25.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.25.0-config-reload.md
+ * 변경 이력:
+ *   - v1.25.0: 제어 소켓 열기, 리슨 FD 보내기/받기, 준비 알림 추가
+ * 테스트:
+ *   - tests/test_webserv_reload.sh
+ */
+
+/**
+ * openControlSocket
+ * 설명:
+ *   - path 에 논블로킹 유닉스 스트림 소켓을 바인드하고 리슨한다. 파일 권한은 0600 이다.
+ *   - 같은 경로에 남은 파일(이전 프로세스의 제어 소켓이나 비정상 종료 흔적)은 먼저 지운다. 이전 프로세스는
+ *     이미 연 소켓으로 계속 받을 수 있지만, 경로로 새로 붙는 쪽은 이 소켓으로 온다.
+ * 출력:
+ *   - 리슨 FD, 실패 시 -1 과 error
+ */
+int openControlSocket(const std::string &path, std::string &error);
+
+/**
+ * sendListeners
+ * 설명:
+ *   - channel 로 리슨 FD 목록을 보낸다. 첫 메시지는 머리(매직, 전체 개수)이고, FD 는 SCM_MAX_FD 보다 작은
+ *     묶음으로 나눠 보낸다. 보낸 FD 는 이 프로세스에도 그대로 열려 있다.
+ * 출력:
+ *   - 다 보냈으면 true, 아니면 false 와 error
+ */
+bool sendListeners(int channel, const std::vector<int> &fds, std::string &error);
+
+/**
+ * receiveListeners
+ * 설명:
+ *   - path 의 제어 소켓에 붙어 리슨 FD 목록을 받는다. 받은 FD 에는 close-on-exec 가 걸린다.
+ *   - 이전 프로세스가 HANDOFF_TIMEOUT 안에 보내지 않으면 실패한다.
+ * 출력:
+ *   - 성공 시 true, channel(준비 알림을 보낼 연결)과 fds. 실패 시 false 와 error(받은 FD 는 닫는다)
+ */
+bool receiveListeners(const std::string &path, int &channel, std::vector<int> &fds, std::string &error);
+
+/**
+ * sendReady
+ * 설명:
+ *   - 새 프로세스가 워커를 다 띄웠음을 알린다. 이전 프로세스는 이 바이트를 받아야 drain 을 시작한다.
+ *     바이트 없이 연결이 끊기면(새 프로세스 시작 실패) 이전 프로세스는 그대로 계속 받는다.
+ */
+bool sendReady(int channel);
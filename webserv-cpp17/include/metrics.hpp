@@ -0,0 +1,321 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/**
+ * [모듈] webserv-cpp17/include/metrics.hpp
+ * 설명:
+ *   - 워커별 계측 값(경로/상태별 요청 수, 송수신 바이트, 연결 수, 지연 히스토그램)과
+ *     스크랩 시 합산해 Prometheus 텍스트 형식으로 내보내는 레지스트리 선언부.
+ * 버전: v1.25.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.7.0-worker-metrics.md
+ *   - design/webserv-cpp17/v1.8.0-timer-wheel.md
+ *   - design/webserv-cpp17/v1.12.0-streaming-request-body.md
+ *   - design/webserv-cpp17/v1.13.0-router.md
+ *   - design/webserv-cpp17/v1.14.0-response-compression.md
+ *   - design/webserv-cpp17/v1.15.0-response-cache.md
+ *   - design/webserv-cpp17/v1.16.0-reverse-proxy.md
+ *   - design/webserv-cpp17/v1.17.0-handler-offload.md
+ *   - design/webserv-cpp17/v1.18.0-coroutine-handlers.md
+ *   - design/webserv-cpp17/v1.20.0-accept-path.md
+ *   - design/webserv-cpp17/v1.21.0-access-log.md
+ *   - design/webserv-cpp17/v1.22.0-tls.md
+ *   - design/webserv-cpp17/v1.23.0-http2.md
+ *   - design/webserv-cpp17/v1.24.0-client-limits.md
+ *   - design/webserv-cpp17/v1.25.0-config-reload.md
+ * 변경 이력:
+ *   - v1.7.0: 고정 문자열 `requests_total 1` 을 실제 계측으로 대체
+ *   - v1.8.0: 단계별 연결 타임아웃 수 추가
+ *   - v1.12.0: upload 경로, 413/431 상태, 본문 수신 타임아웃 단계 라벨 추가
+ *   - v1.13.0: 워커 하나의 값만 직렬화하는 renderWorker 추가
+ *   - v1.14.0: 압축 응답 수(본문 출처별)와 미리 압축 횟수 추가
+ *   - v1.15.0: 304 상태 라벨과 응답 캐시 적중/실패 수 추가
+ *   - v1.16.0: proxy 경로, 502/504 상태, 업스트림 타임아웃 단계 라벨과 업스트림 연결 결과 수 추가
+ *   - v1.17.0: delay 경로, 503 상태 라벨과 작업 스레드에 맡긴 핸들러 작업 결과 수 추가
+ *   - v1.18.0: sleep/echo/fetch 경로 라벨과 코루틴 핸들러가 멈춘 횟수(기다린 것별) 추가
+ *   - v1.20.0: 수락 예산에 걸려 멈춘 횟수 추가
+ *   - v1.21.0: 접근 로그 레코드 수(링에 넣음/링이 차서 버림) 추가
+ *   - v1.22.0: TLS 핸드셰이크 결과 라벨(TlsHandshakeLabel)과 kTLS 송신 연결 카운터 추가
+ *   - v1.23.0: HTTP/2 연결 시작 방식(Http2ConnectionLabel)과 스트림 종료 결과(Http2StreamLabel) 카운터 추가
+ *   - v1.24.0: code="429" 라벨, ShedLabel 과 클라이언트 한도/과부하 계측 추가
+ *   - v1.25.0: ReloadLabel, config_generation/draining 게이지, countReload 추가
+ * 테스트:
+ *   - tests/test_webserv_metrics.sh
+ *   - tests/test_webserv_timeouts.sh
+ *   - tests/test_webserv_request_body.sh
+ *   - tests/test_webserv_router.sh
+ *   - tests/test_webserv_compression.sh
+ *   - tests/test_webserv_response_cache.sh
+ *   - tests/test_webserv_proxy.sh
+ *   - tests/test_webserv_offload.sh
+ *   - tests/test_webserv_coroutine.sh
+ *   - tests/test_webserv_accept.sh
+ *   - tests/test_webserv_access_log.sh
+ *   - tests/test_webserv_tls.sh
+ *   - tests/test_webserv_http2.sh
+ *   - tests/test_webserv_client_limits.sh
+ *   - tests/test_webserv_reload.sh
+ */
+
+// 요청 경로 라벨. 라벨 조합이 고정되어 있어 카운터를 배열 색인으로 바로 찾는다.
+enum class RouteLabel : std::uint8_t {
+    kHealth,
+    kMetrics,
+    kStatic,
+    kDefault,
+    kError,
+    kUpload,
+    kProxy,
+    kDelay,
+    kSleep,
+    kEcho,
+    kFetch,
+    kCount,
+};
+
+// 상태 코드 라벨. 목록에 없는 코드는 kOther 로 모은다.
+enum class StatusLabel : std::uint8_t {
+    k200,
+    k304,
+    k400,
+    k404,
+    k405,
+    k413,
+    k429,
+    k431,
+    k502,
+    k503,
+    k504,
+    kOther,
+    kCount,
+};
+
+StatusLabel statusLabelFor(int status);
+
+// 연결 타임아웃 단계. 요청 헤더 수신 중, 요청 사이 유휴(keep-alive), 응답 송신 정체, 요청 본문 수신 정체,
+// 프록시 업스트림 정체(연결/요청 송신/응답 대기).
+enum class TimeoutLabel : std::uint8_t {
+    kHeader,
+    kIdle,
+    kWrite,
+    kBody,
+    kUpstream,
+    kCount,
+};
+
+// 압축해 보낸 응답 본문의 출처. 요청마다 압축한 동적 본문과 미리 압축 캐시에서 꺼낸 정적 파일.
+enum class CompressionLabel : std::uint8_t {
+    kDynamic,
+    kCache,
+    kCount,
+};
+
+// 응답 캐시 조회 결과. 적중은 핸들러를 부르지 않은 응답, 실패는 핸들러를 불러 캐시를 채운 응답이다.
+enum class CacheLabel : std::uint8_t {
+    kHit,
+    kMiss,
+    kCount,
+};
+
+// 프록시 요청이 업스트림 연결을 얻은 방식과 실패. 재시도는 재사용한 연결이 응답 전에 끊겨 새 연결로 다시 보낸 경우다.
+enum class UpstreamLabel : std::uint8_t {
+    kConnected,
+    kReused,
+    kRetried,
+    kFailed,
+    kCount,
+};
+
+// HTTP/2 연결이 시작된 방식(v1.23.0). prior_knowledge 는 평문에서 바로 프리페이스를 보낸 연결, upgrade 는
+// HTTP/1.1 `Upgrade: h2c` 로 바꾼 연결, alpn 은 TLS 핸드셰이크에서 h2 를 고른 연결이다.
+enum class Http2ConnectionLabel : std::uint8_t {
+    kPriorKnowledge,
+    kUpgrade,
+    kAlpn,
+    kCount,
+};
+
+// HTTP/2 스트림이 끝난 방식(v1.23.0). refused 는 동시 스트림 상한에 걸려 REFUSED_STREAM 으로 거절한 스트림,
+// local_reset 은 서버가 오류 코드로 닫은 스트림(HTTP_1_1_REQUIRED 포함)이다.
+enum class Http2StreamLabel : std::uint8_t {
+    kCompleted,
+    kPeerReset,
+    kLocalReset,
+    kRefused,
+    kCount,
+};
+
+// 블로킹 핸들러 작업의 결과. 완료는 작업 스레드가 끝내 워커로 돌려준 작업, 거절은 큐가 차서 503 으로 답한 요청이다.
+enum class OffloadLabel : std::uint8_t {
+    kCompleted,
+    kRejected,
+    kCount,
+};
+
+// 코루틴 핸들러가 멈추며 기다린 것. 본문 조각, 타이머, 업스트림 응답.
+enum class CoroutineLabel : std::uint8_t {
+    kBody,
+    kTimer,
+    kUpstream,
+    kCount,
+};
+
+// 접근 로그 레코드의 처리. 넣음은 기록 스레드에 넘긴 레코드, 버림은 링이 차서 남기지 못한 레코드다(표본에서 빠진 요청은 세지 않는다).
+enum class AccessLogLabel : std::uint8_t {
+    kQueued,
+    kDropped,
+    kCount,
+};
+
+// TLS 핸드셰이크 결과. 재개는 세션 티켓이나 세션 캐시로 인증서 교환 없이 끝난 핸드셰이크다.
+enum class TlsHandshakeLabel : std::uint8_t {
+    kFull,
+    kResumed,
+    kFailed,
+    kCount,
+};
+
+// 한도나 과부하로 처리하지 않고 돌려보낸 것(v1.24.0). rate 는 주소별 토큰 버킷이 비어 429 로 답한 요청,
+// connections 는 주소별 동시 연결 한도를 넘어 수락하자마자 닫은 연결, overload 는 과부하 상태에서 503 으로 답한 요청이다.
+enum class ShedLabel : std::uint8_t {
+    kRate,
+    kConnections,
+    kOverload,
+    kCount,
+};
+
+// 설정 다시 읽기(SIGHUP) 결과(v1.25.0). failed 는 파일/옵션 오류나 업스트림 주소 해석 실패로 이전 설정을 유지한 경우다.
+enum class ReloadLabel : std::uint8_t {
+    kApplied,
+    kFailed,
+    kCount,
+};
+
+/**
+ * LatencyHistogram (v1.7.0)
+ * 역할:
+ *   - HDR 방식의 로그-선형 버킷으로 나노초 지연을 기록한다. 2의 거듭제곱 구간마다 16개 하위 버킷을 두어
+ *     상대 오차가 6.25% 이하이고, 1ns ~ 약 137초(2^37ns)를 544개 버킷으로 덮는다.
+ * 주의 사항:
+ *   - record() 는 소유 워커 스레드만 호출한다(단일 작성자). 다른 스레드는 relaxed 로 읽기만 한다.
+ */
+class LatencyHistogram {
+ public:
+    static constexpr unsigned SUB_BITS = 4;
+    static constexpr unsigned SUB_COUNT = 1u << SUB_BITS;
+    static constexpr unsigned MAX_BIT = 36;
+    static constexpr std::size_t BUCKETS = (MAX_BIT - SUB_BITS + 2) * SUB_COUNT;
+
+    void record(std::uint64_t nanos);
+
+    static std::size_t bucketFor(std::uint64_t nanos);
+    // 버킷이 담는 값 구간 [lower, upper) 의 상한(ns).
+    static std::uint64_t bucketUpper(std::size_t index);
+
+    std::uint64_t count(std::size_t index) const { return counts_[index].load(std::memory_order_relaxed); }
+    std::uint64_t sumNanos() const { return sum_nanos_.load(std::memory_order_relaxed); }
+
+ private:
+    std::atomic<std::uint64_t> counts_[BUCKETS] = {};
+    std::atomic<std::uint64_t> sum_nanos_{0};
+};
+
+/**
+ * WorkerMetrics (v1.7.0)
+ * 역할:
+ *   - 워커 하나의 계측 값. 워커 스레드만 갱신하므로 lock 접두 명령(fetch_add) 없이
+ *     relaxed load + store 로 더한다. 기록 비용은 일반 메모리 증가와 같다.
+ * 주의 사항:
+ *   - alignas(64) 로 워커마다 다른 캐시 라인에서 시작하게 해 거짓 공유를 막는다.
+ *   - 스크랩 스레드는 relaxed 로 읽으므로 필드 사이의 순간 일관성은 보장하지 않는다(단조 카운터라 무방).
+ */
+struct alignas(64) WorkerMetrics {
+    std::atomic<std::uint64_t> requests[static_cast<std::size_t>(RouteLabel::kCount)]
+                                       [static_cast<std::size_t>(StatusLabel::kCount)] = {};
+    std::atomic<std::uint64_t> bytes_in{0};
+    std::atomic<std::uint64_t> bytes_out{0};
+    std::atomic<std::uint64_t> accepted{0};
+    std::atomic<std::uint64_t> closed{0};
+    std::atomic<std::uint64_t> accept_budget_exhausted{0};
+    std::atomic<std::uint64_t> timeouts[static_cast<std::size_t>(TimeoutLabel::kCount)] = {};
+    std::atomic<std::uint64_t> compressed[static_cast<std::size_t>(CompressionLabel::kCount)] = {};
+    std::atomic<std::uint64_t> precompressed{0};
+    std::atomic<std::uint64_t> cache[static_cast<std::size_t>(CacheLabel::kCount)] = {};
+    std::atomic<std::uint64_t> upstream[static_cast<std::size_t>(UpstreamLabel::kCount)] = {};
+    std::atomic<std::uint64_t> offload[static_cast<std::size_t>(OffloadLabel::kCount)] = {};
+    std::atomic<std::uint64_t> coroutine[static_cast<std::size_t>(CoroutineLabel::kCount)] = {};
+    std::atomic<std::uint64_t> access_log[static_cast<std::size_t>(AccessLogLabel::kCount)] = {};
+    std::atomic<std::uint64_t> tls_handshakes[static_cast<std::size_t>(TlsHandshakeLabel::kCount)] = {};
+    std::atomic<std::uint64_t> tls_ktls_send{0};
+    std::atomic<std::uint64_t> http2_connections[static_cast<std::size_t>(Http2ConnectionLabel::kCount)] = {};
+    std::atomic<std::uint64_t> http2_streams[static_cast<std::size_t>(Http2StreamLabel::kCount)] = {};
+    std::atomic<std::uint64_t> shed[static_cast<std::size_t>(ShedLabel::kCount)] = {};
+    std::atomic<std::uint64_t> client_untracked{0};
+    std::atomic<std::uint64_t> overload_entered{0};
+    // 게이지: 워커가 지금 과부하 상태면 1.
+    std::atomic<std::uint64_t> overloaded{0};
+    // 게이지: 워커가 적용한 설정 세대(v1.25.0). 시작 설정이 0 이고 다시 읽을 때마다 1 씩 오른다.
+    std::atomic<std::uint64_t> config_generation{0};
+    // 게이지: 워커가 새 연결을 받지 않고 남은 연결을 마무리하는 중이면 1(v1.25.0).
+    std::atomic<std::uint64_t> draining{0};
+    LatencyHistogram latency;
+
+    static void add(std::atomic<std::uint64_t> &counter, std::uint64_t value) {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    void countRequest(RouteLabel route, int status) {
+        add(requests[static_cast<std::size_t>(route)][static_cast<std::size_t>(statusLabelFor(status))], 1);
+    }
+};
+
+/**
+ * MetricsRegistry (v1.7.0)
+ * 역할:
+ *   - 워커 수만큼 WorkerMetrics 를 소유하고, 스크랩 요청 시에만 합산해 Prometheus 텍스트를 만든다.
+ * 설계:
+ *   - design/webserv-cpp17/v1.7.0-worker-metrics.md
+ */
+class MetricsRegistry {
+ public:
+    explicit MetricsRegistry(std::size_t workers);
+
+    MetricsRegistry(const MetricsRegistry &) = delete;
+    MetricsRegistry &operator=(const MetricsRegistry &) = delete;
+
+    WorkerMetrics &worker(std::size_t id) { return workers_[id]; }
+
+    // 설정 다시 읽기 결과를 센다(v1.25.0). Server 의 제어 스레드만 부른다.
+    void countReload(ReloadLabel result) {
+        WorkerMetrics::add(reloads_[static_cast<std::size_t>(result)], 1);
+    }
+
+    /**
+     * render
+     * 설명:
+     *   - 모든 워커의 값을 합산해 Prometheus 텍스트 노출 형식(0.0.4)으로 직렬화한다.
+     */
+    std::string render() const;
+
+    /**
+     * renderWorker
+     * 설명:
+     *   - 워커 id 하나의 값만 같은 형식으로 직렬화한다(`/metrics/workers/:id`).
+     */
+    std::string renderWorker(std::size_t id) const;
+
+    std::size_t workerCount() const { return count_; }
+
+ private:
+    std::string renderRange(std::size_t first, std::size_t last) const;
+
+    std::size_t count_;
+    std::unique_ptr<WorkerMetrics[]> workers_;
+    // 워커가 아니라 프로세스 단위 값이므로 render() 에만 싣는다.
+    std::atomic<std::uint64_t> reloads_[static_cast<std::size_t>(ReloadLabel::kCount)] = {};
+};
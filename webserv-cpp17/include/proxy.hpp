@@ -0,0 +1,198 @@
+#pragma once
+
+#include <sys/socket.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "http_parser.hpp"
+#include "io_buffer.hpp"
+#include "request_body.hpp"
+#include "server_config.hpp"
+
+/**
+ * [모듈] webserv-cpp17/include/proxy.hpp
+ * 설명:
+ *   - 리버스 프록시 모드의 업스트림 응답 헤더 해석, 요청/응답 헤더 재작성, 워커별 업스트림 연결 풀 선언부.
+ *   - 업스트림 연결도 클라이언트 연결과 같은 Connection 슬롯과 I/O 백엔드로 돌린다. 이 모듈은 소켓을 만지지 않는다.
+ * 버전: v1.25.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.16.0-reverse-proxy.md
+ *   - design/webserv-cpp17/v1.18.0-coroutine-handlers.md
+ *   - design/webserv-cpp17/v1.25.0-config-reload.md
+ * 변경 이력:
+ *   - v1.16.0: ResponseHead, writeProxyRequest, writeProxyResponseHead, UpstreamPool 추가
+ *   - v1.18.0: 코루틴 핸들러가 업스트림에 보내는 GET 요청 헤더(writeFetchRequest) 추가
+ *   - v1.25.0: serverCount, busy 추가(다시 읽기 뒤 이전 풀 정리)
+ * 테스트:
+ *   - tests/test_webserv_proxy.sh
+ *   - tests/test_webserv_coroutine.sh
+ *   - tests/test_webserv_reload.sh
+ */
+
+/**
+ * ResponseHead
+ * 설명:
+ *   - 업스트림 응답의 상태 줄과 헤더. fields 는 version 과 헤더만 채우고 method/path 는 비운다.
+ *     bodySpecFor 를 응답에도 그대로 쓰기 위해 요청과 같은 HttpRequestView 를 쓴다.
+ *   - length 는 헤더 끝 빈 줄까지의 바이트 수다. 조각은 업스트림 입력 버퍼를 가리키므로 length 를 소비하기 전에만 쓴다.
+ */
+struct ResponseHead {
+    int status = 0;
+    std::string_view reason;
+    HttpRequestView fields;
+    std::size_t length = 0;
+};
+
+/**
+ * parseResponseHead
+ * 설명:
+ *   - data[0..size) 에서 응답 헤더 끝(빈 줄)을 찾아 상태 줄과 헤더를 나눈다.
+ *   - scan 은 이전 호출이 빈 줄을 찾아 훑은 위치다. 같은 바이트를 두 번 훑지 않도록 호출 사이에 보관하고,
+ *     응답 하나를 다 읽으면 0 으로 되돌린다.
+ * 출력:
+ *   - kIncomplete: 빈 줄이 아직 없음, kComplete: head 사용 가능, kError: 상태 줄/헤더 형식 오류 또는 헤더 수 초과
+ */
+ParseStatus parseResponseHead(const char *data, std::size_t size, std::size_t &scan, ResponseHead &head);
+
+// 업스트림 응답 본문의 끝을 정하는 방식(RFC 9112 6.3).
+enum class ResponseFraming {
+    kNone,        // 본문 없음(HEAD 요청, 1xx/204/304, Content-Length: 0)
+    kLength,      // Content-Length
+    kChunked,     // Transfer-Encoding: chunked
+    kUntilClose,  // 길이 헤더가 없어 업스트림이 연결을 닫을 때까지가 본문
+    kInvalid,     // 길이를 믿을 수 없음 -> 502
+};
+
+/**
+ * responseFramingFor
+ * 설명:
+ *   - 요청 메서드와 응답 헤더로 본문 길이 결정 방식을 고른다. kLength/kChunked 면 spec 에 디코더 시작 값을 채운다.
+ */
+ResponseFraming responseFramingFor(const ResponseHead &head, bool head_request, BodySpec &spec);
+
+/**
+ * upstreamKeepsAlive
+ * 설명:
+ *   - 응답 뒤에 업스트림 연결을 다시 써도 되는지 본다. HTTP/1.1 은 `Connection: close` 가 없으면,
+ *     HTTP/1.0 은 `Connection: keep-alive` 가 있으면 참이다.
+ */
+bool upstreamKeepsAlive(const ResponseHead &head);
+
+/**
+ * writeProxyRequest
+ * 설명:
+ *   - 클라이언트 요청 헤더를 업스트림으로 보낼 HTTP/1.1 요청 헤더로 다시 쓴다. 본문은 호출자가 뒤에 그대로 흘려 보낸다.
+ *   - 홉 단위 헤더(Connection 과 그 값에 적힌 이름, Keep-Alive, Proxy-Connection, TE, Upgrade)와 Expect 는 빼고
+ *     `Connection: keep-alive` 를 붙인다. 100-continue 는 프록시가 클라이언트에 직접 답한다.
+ *   - nginx 설정(`proxy_set_header Host $host`, `X-Real-IP $remote_addr`)과 같이 Host 는 그대로 두고
+ *     `X-Real-IP` 를 클라이언트 주소로 바꾼다. `X-Forwarded-For` 에는 클라이언트 주소를 덧붙인다.
+ *   - Host 가 없는 HTTP/1.0 요청에는 default_host(업스트림 `HOST:PORT`)를 넣는다.
+ * 출력:
+ *   - out 을 비우고 헤더 전체(빈 줄 포함)를 쓴다. 용량은 남겨 다음 요청이 재사용한다.
+ */
+void writeProxyRequest(std::string &out, const HttpRequestView &request, std::string_view client_ip,
+                       std::string_view default_host);
+
+/**
+ * writeFetchRequest (v1.18.0)
+ * 설명:
+ *   - 코루틴 핸들러가 업스트림에서 target 을 가져오는 본문 없는 GET 요청 헤더를 쓴다.
+ *     Host 는 업스트림 `HOST:PORT`, X-Real-IP 는 원래 요청을 보낸 클라이언트 주소다.
+ * 출력:
+ *   - out 을 비우고 헤더 전체(빈 줄 포함)를 쓴다. 용량은 남겨 다음 요청이 재사용한다.
+ */
+void writeFetchRequest(std::string &out, std::string_view target, std::string_view host, std::string_view client_ip);
+
+/**
+ * writeProxyResponseHead
+ * 설명:
+ *   - 업스트림 응답 헤더를 클라이언트로 보낼 헤더로 다시 써서 출력 큐에 넣는다.
+ *   - 홉 단위 헤더를 빼고 클라이언트 연결 유지 여부로 `Connection` 을 붙인다.
+ *   - dechunk 가 참이면(chunked 를 모르는 HTTP/1.0 클라이언트) `Transfer-Encoding` 을 빼고 본문은 풀어서 보낸다.
+ *     이때 본문 끝은 연결 종료로 알리므로 keep_alive 는 거짓이어야 한다.
+ */
+void writeProxyResponseHead(OutputQueue &output, const ResponseHead &head, bool keep_alive, bool dechunk);
+
+/**
+ * UpstreamPool (v1.16.0)
+ * 역할:
+ *   - `--proxy` 경로 표와 업스트림 서버 주소, 서버별 유휴 keep-alive 연결 목록, 진행 중 요청 수를 보관한다.
+ *   - match 는 가장 긴 접두사 경로를, pick 은 라운드 로빈 또는 진행 중 요청이 가장 적은 서버를 고른다.
+ *   - 유휴 연결은 Connection 핸들로 보관하며 가장 최근에 돌려준 연결부터 꺼낸다(LIFO). 오래 쉰 연결이
+ *     목록 아래에 남아 유휴 타임아웃으로 먼저 정리된다.
+ * 설계:
+ *   - design/webserv-cpp17/v1.16.0-reverse-proxy.md
+ * 주의 사항:
+ *   - 워커마다 하나씩 두어 잠금 없이 쓴다. 연결 풀과 진행 중 요청 수도 워커별이라 least-conn 은
+ *     워커 안에서의 최소다.
+ *   - 같은 `HOST:PORT` 가 여러 경로에 나오면 서버 하나로 합쳐 연결을 같이 쓴다.
+ *   - 핸들이 가리키는 연결의 수명은 워커가 관리한다. 풀에 있는 연결을 닫을 때는 forget 으로 빼야 한다.
+ */
+class UpstreamPool {
+ public:
+    UpstreamPool(const std::vector<ProxyTarget> &targets, ProxyBalance balance, std::size_t keepalive);
+
+    UpstreamPool(const UpstreamPool &) = delete;
+    UpstreamPool &operator=(const UpstreamPool &) = delete;
+
+    /**
+     * resolve
+     * 설명:
+     *   - 업스트림 `HOST:PORT` 를 getaddrinfo 로 주소 하나씩 해석한다. 워커 시작 시 한 번 부른다.
+     * 출력:
+     *   - 모두 해석하면 true, 아니면 false 와 error
+     */
+    bool resolve(std::string &error);
+
+    // 쿼리 문자열을 뗀 path 에 맞는 가장 긴 접두사 경로 번호. 없으면 -1.
+    int match(std::string_view path) const;
+
+    // 경로의 업스트림 서버 중 요청을 보낼 서버 번호.
+    std::size_t pick(std::size_t route);
+
+    const sockaddr *address(std::size_t server) const {
+        return reinterpret_cast<const sockaddr *>(&servers_[server].address);
+    }
+    socklen_t addressLength(std::size_t server) const { return servers_[server].address_length; }
+    int family(std::size_t server) const { return servers_[server].address.ss_family; }
+    const std::string &name(std::size_t server) const { return servers_[server].name; }
+    // Host 가 없는 HTTP/1.0 요청에 넣을 이름. 경로의 첫 업스트림 `HOST:PORT` 다.
+    const std::string &defaultHost(std::size_t route) const { return servers_[routes_[route].servers.front()].name; }
+
+    // 유휴 연결 핸들을 하나 꺼낸다. 없으면 0.
+    std::uint64_t takeIdle(std::size_t server);
+    // 응답을 마친 연결을 유휴 목록에 넣는다. 목록이 keepalive 개로 차 있으면 false(호출자가 닫는다).
+    bool park(std::size_t server, std::uint64_t handle);
+    // 유휴 목록에 있으면 뺀다. 쉬는 동안 업스트림이 닫았거나 타임아웃된 연결이다.
+    void forget(std::size_t server, std::uint64_t handle);
+
+    void started(std::size_t server) { ++servers_[server].active; }
+    void finished(std::size_t server) { --servers_[server].active; }
+    std::size_t active(std::size_t server) const { return servers_[server].active; }
+    std::size_t serverCount() const { return servers_.size(); }
+    // 진행 중 요청이 하나라도 있으면 참. 설정을 다시 읽어 물러난 풀을 언제 지워도 되는지 보는 데 쓴다(v1.25.0).
+    bool busy() const;
+
+ private:
+    struct Server {
+        std::string name;
+        sockaddr_storage address{};
+        socklen_t address_length = 0;
+        std::size_t active = 0;
+        std::vector<std::uint64_t> idle;
+    };
+    struct Route {
+        std::string prefix;
+        std::vector<std::size_t> servers;
+        std::size_t next = 0;
+    };
+
+    std::vector<Server> servers_;
+    std::vector<Route> routes_;
+    ProxyBalance balance_;
+    std::size_t keepalive_;
+};
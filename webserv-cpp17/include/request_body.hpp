@@ -0,0 +1,147 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "http_parser.hpp"
+
+/**
+ * [모듈] webserv-cpp17/include/request_body.hpp
+ * 설명:
+ *   - 요청 본문의 길이 결정(Content-Length / Transfer-Encoding: chunked)과 증분 본문 디코더,
+ *     본문 조각을 받는 업로드 핸들러(UploadDigest) 선언부.
+ *   - 디코더는 입력 버퍼에 들어온 바이트를 그 자리에서 조각(string_view)으로 돌려준다. 본문 전체를 모으지 않는다.
+ * 버전: v1.18.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.12.0-streaming-request-body.md
+ *   - design/webserv-cpp17/v1.16.0-reverse-proxy.md
+ *   - design/webserv-cpp17/v1.17.0-handler-offload.md
+ *   - design/webserv-cpp17/v1.18.0-coroutine-handlers.md
+ * 변경 이력:
+ *   - v1.12.0: 요청 본문 스트리밍 처리 추가
+ *   - v1.16.0: 업스트림으로 넘기는 본문 경로(BodyRoute::kProxy) 추가
+ *   - v1.17.0: 응답을 작업 스레드가 만드는 요청의 본문 경로(BodyRoute::kOffload) 추가
+ *   - v1.18.0: 본문 조각을 코루틴 핸들러에 넘기는 경로(BodyRoute::kCoroutine) 추가
+ * 테스트:
+ *   - tests/test_webserv_request_body.sh
+ *   - tests/test_webserv_proxy.sh
+ *   - tests/test_webserv_offload.sh
+ *   - tests/test_webserv_coroutine.sh
+ */
+
+// 본문 길이를 정하는 방식. 헤더가 완성될 때 한 번 정한다(RFC 9112 6.3).
+enum class BodyFraming {
+    kNone,         // 본문 없음
+    kLength,       // Content-Length
+    kChunked,      // Transfer-Encoding: chunked
+    kInvalid,      // 길이를 믿을 수 없음(잘못된/충돌하는 Content-Length, TE+CL 동시 사용 등) -> 400
+    kUnsupported,  // chunked 외의 전송 코딩 -> 501
+};
+
+struct BodySpec {
+    BodyFraming framing = BodyFraming::kNone;
+    std::uint64_t length = 0;  // kLength 일 때만 의미가 있다
+};
+
+/**
+ * bodySpecFor
+ * 설명:
+ *   - 요청 헤더에서 본문 길이 결정 방식을 고른다.
+ *   - Transfer-Encoding 과 Content-Length 가 함께 오거나 Content-Length 값이 서로 다르면 요청 밀반입
+ *     (request smuggling) 여지가 있으므로 kInvalid 로 거절한다.
+ *   - HTTP/1.0 요청의 Transfer-Encoding 도 kInvalid 다.
+ */
+BodySpec bodySpecFor(const HttpRequestView &request);
+
+enum class BodyStatus {
+    kSlice,     // slice 에 본문 조각 하나가 있다
+    kNeedMore,  // 더 받아야 한다
+    kDone,      // 본문 끝(chunked 는 트레일러까지 읽음)
+    kTooLarge,  // 본문이 제한을 넘는다
+    kError,     // chunked 형식 오류
+};
+
+/**
+ * BodyDecoder (v1.12.0)
+ * 역할:
+ *   - 고정 길이와 chunked 본문을 바이트가 들어오는 대로 해석한다. next 는 호출될 때마다 조각 하나를 돌려주고,
+ *     그 조각과 그 앞의 틀(청크 크기 줄, CRLF)을 합친 길이를 consumed 로 알려 준다.
+ *   - 호출자는 조각을 핸들러에 넘긴 뒤 consumed 만큼 입력 버퍼를 소비한다. 그래서 입력 버퍼에는
+ *     덜 들어온 청크 크기 줄/트레일러 줄만 남고, 본문 크기와 무관하게 메모리가 일정하다.
+ * 설계:
+ *   - design/webserv-cpp17/v1.12.0-streaming-request-body.md
+ * 주의 사항:
+ *   - 청크 크기 줄과 트레일러 줄 하나는 MAX_LINE 바이트, 트레일러 전체는 MAX_TRAILER 바이트를 넘을 수 없다.
+ *   - 청크 확장(`;name=value`)과 트레일러 필드는 읽고 버린다.
+ *   - chunked 본문은 청크 크기 줄을 읽는 시점에 제한을 검사하므로 넘치는 청크의 데이터를 받기 전에 kTooLarge 가 된다.
+ */
+class BodyDecoder {
+ public:
+    static constexpr std::size_t MAX_LINE = 4096;
+    static constexpr std::size_t MAX_TRAILER = 8192;
+
+    /**
+     * start
+     * 설명:
+     *   - 새 본문 해석을 시작한다. kNone/kInvalid/kUnsupported 는 받지 않는다.
+     * 입력:
+     *   - spec: bodySpecFor 의 결과(kLength 또는 kChunked)
+     *   - limit: 허용하는 최대 본문 바이트
+     */
+    void start(const BodySpec &spec, std::uint64_t limit);
+
+    /**
+     * next
+     * 설명:
+     *   - data[0..size) 에서 다음 본문 조각을 찾는다.
+     * 출력:
+     *   - 반환값: BodyStatus
+     *   - consumed: 이번 호출이 해석을 마친 바이트 수(조각 포함). kNeedMore 여도 0 이 아닐 수 있다.
+     *   - slice: kSlice 일 때 data 안의 본문 조각
+     */
+    BodyStatus next(const char *data, std::size_t size, std::size_t &consumed, std::string_view &slice);
+
+    bool active() const { return state_ != State::kIdle; }
+    // 지금까지 돌려준 본문 바이트 수
+    std::uint64_t received() const { return received_; }
+    void reset() { state_ = State::kIdle; }
+
+ private:
+    enum class State {
+        kIdle,
+        kFixed,      // 고정 길이 본문
+        kChunkSize,  // 청크 크기 줄
+        kChunkData,  // 청크 데이터
+        kChunkEnd,   // 청크 데이터 뒤 CRLF
+        kTrailer,    // 마지막 청크 뒤 트레일러 줄들
+    };
+
+    State state_ = State::kIdle;
+    std::uint64_t remaining_ = 0;
+    std::uint64_t received_ = 0;
+    std::uint64_t limit_ = 0;
+    std::size_t trailer_bytes_ = 0;
+};
+
+/**
+ * UploadDigest (v1.12.0)
+ * 역할:
+ *   - `POST /upload` 핸들러. 본문 조각을 받는 대로 바이트 수와 CRC-32(IEEE) 를 갱신한다.
+ *     본문을 저장하지 않으므로 업로드 크기와 무관하게 연결당 상태가 몇 바이트다.
+ */
+struct UploadDigest {
+    std::uint64_t bytes = 0;
+    std::uint32_t crc = 0;
+
+    void update(std::string_view slice);
+};
+
+// 본문 조각을 받는 핸들러 종류. 요청 헤더가 완성될 때 경로로 정한다.
+enum class BodyRoute : std::uint8_t {
+    kDiscard,  // 응답은 이미 정해졌고 본문은 다음 요청 경계를 찾기 위해 읽고 버린다
+    kUpload,   // UploadDigest 에 넘기고, 본문 끝에서 응답한다
+    kProxy,    // 틀(청크 크기 줄 포함) 그대로 업스트림 연결 출력에 넘기고, 응답은 업스트림에서 온다(v1.16.0)
+    kOffload,  // 읽고 버린다. 응답은 작업 스레드의 핸들러 결과가 돌아온 뒤 쓴다(v1.17.0)
+    kCoroutine,  // 조각마다 코루틴 핸들러를 재개하고, 응답은 코루틴이 끝날 때 쓴다(v1.18.0)
+};
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "compression.hpp"
+#include "http_parser.hpp"
+#include "metrics.hpp"
+
+/**
+ * [모듈] webserv-cpp17/include/response_cache.hpp
+ * 설명:
+ *   - 라우트 핸들러가 만든 200 본문을 메서드 + Host + 요청 대상 키로 보관하는 응답 캐시와
+ *     `If-None-Match`/`If-Modified-Since` 조건부 요청 판정 선언부.
+ *   - 신선한 항목이 있으면 핸들러를 부르지 않고 캐시 본문이나 304 로 바로 응답한다.
+ * 버전: v1.15.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.15.0-response-cache.md
+ * 변경 이력:
+ *   - v1.15.0: ResponseCache, etagMatches, isNotModified 추가
+ * 테스트:
+ *   - tests/test_webserv_response_cache.sh
+ */
+
+/**
+ * etagMatches
+ * 설명:
+ *   - `If-None-Match` 값(쉼표로 구분한 엔터티 태그 목록 또는 `*`)이 etag 와 맞는지 약한 비교로 확인한다.
+ *     `W/` 접두사는 떼고 따옴표 안의 값만 비교한다(RFC 9110 8.8.3.2).
+ */
+bool etagMatches(std::string_view if_none_match, std::string_view etag);
+
+/**
+ * isNotModified
+ * 설명:
+ *   - 요청의 조건부 헤더로 보아 304 로 답해도 되는지 판정한다.
+ *   - `If-None-Match` 가 있으면 그것만 보고 `If-Modified-Since` 는 무시한다(RFC 9110 13.2.2).
+ *   - last_modified 가 음수면 수정 시각이 없는 응답이라 `If-Modified-Since` 로는 304 를 내지 않는다.
+ */
+bool isNotModified(const HttpRequestView &request, std::string_view etag, std::time_t last_modified);
+
+/**
+ * CachedResponse
+ * 설명:
+ *   - 캐시된 200 응답 하나. 배열은 ContentCoding 순서(identity, gzip, deflate)다.
+ *   - etags/headers 는 코딩별 검증자와 응답에 붙일 헤더 줄(ETag, Last-Modified, 압축 시 Content-Encoding/Vary)이다.
+ *   - bodies[0] 은 원본 본문, 나머지는 처음 요청될 때 만드는 압축본이다(ready 로 표시).
+ */
+struct CachedResponse {
+    RouteLabel route = RouteLabel::kDefault;
+    std::uint64_t hash = 0;
+    std::time_t last_modified = 0;
+    std::string etags[3];
+    std::string headers[3];
+    std::string bodies[3];
+    bool ready[3] = {true, false, false};
+};
+
+/**
+ * ResponseCache (v1.15.0)
+ * 역할:
+ *   - `메서드 \0 Host \0 요청 대상` 키로 CachedResponse 를 LRU 로 보관한다. 항목 바이트 합이 capacity 를 넘으면
+ *     가장 오래 안 쓴 항목부터 버린다. 항목은 ttl 동안 신선하고, 지나면 핸들러를 다시 불러 갱신한다.
+ *   - ETag 는 본문의 64비트 FNV-1a 해시다. 갱신한 본문이 같으면 ETag 와 Last-Modified 를 그대로 두어
+ *     폴링 클라이언트가 계속 304 를 받는다.
+ * 설계:
+ *   - design/webserv-cpp17/v1.15.0-response-cache.md
+ * 주의 사항:
+ *   - 워커마다 하나씩 두어 잠금 없이 쓴다(워커가 곧 캐시 샤드다). 같은 URL 이 워커마다 따로 캐시된다.
+ *   - store/encode 는 직전 find 의 키를 쓴다. find -> (store) -> encode 순서로 부른다.
+ *   - 돌려준 포인터는 다음 find 전까지만 유효하다.
+ *   - ttl 이 0 이면 항목이 늘 만료 상태라 핸들러는 매번 불리지만 검증자와 304 는 그대로 동작한다.
+ */
+class ResponseCache {
+ public:
+    /**
+     * 입력:
+     *   - capacity: 워커당 바이트 한도(키 + 본문 + 압축본 + 헤더 줄)
+     *   - ttl: 항목이 신선한 시간
+     *   - vary: 압축을 켠 서버인지. 참이면 모든 변형에 `Vary: Accept-Encoding` 을 붙인다.
+     */
+    ResponseCache(std::size_t capacity, std::chrono::milliseconds ttl, bool vary);
+
+    ResponseCache(const ResponseCache &) = delete;
+    ResponseCache &operator=(const ResponseCache &) = delete;
+
+    /**
+     * find
+     * 설명:
+     *   - 키를 만들고 신선한 항목을 찾는다. 찾으면 LRU 앞으로 옮긴다.
+     * 출력:
+     *   - 신선한 항목, 없거나 만료되었으면 nullptr
+     */
+    CachedResponse *find(std::string_view method, std::string_view host, std::string_view target,
+                         std::chrono::steady_clock::time_point now);
+
+    /**
+     * store
+     * 설명:
+     *   - 직전 find 의 키로 본문을 넣거나 만료된 항목을 갱신한다. 본문 해시가 같으면 검증자를 유지한다.
+     *   - wall_now 는 본문이 바뀌었을 때의 Last-Modified 값이다.
+     * 출력:
+     *   - 저장된 항목, 본문이 capacity 보다 커서 캐시하지 않았으면 nullptr
+     */
+    CachedResponse *store(std::string_view body, RouteLabel route, std::time_t wall_now,
+                          std::chrono::steady_clock::time_point now);
+
+    /**
+     * encode
+     * 설명:
+     *   - 직전 find/store 항목의 coding 본문을 돌려준다. 압축본이 없으면 compressor 로 한 번 만들어 둔다.
+     *   - 본문이 MIN_COMPRESS_BYTES 보다 작거나 압축에 실패하면 coding 을 identity 로 바꾸고 원본을 돌려준다.
+     */
+    std::string_view encode(CachedResponse &entry, ContentCoding &coding, Compressor *compressor);
+
+    // 핸들러가 캐시에 넣을 본문을 쓰는 버퍼. 용량을 남겨 재사용한다.
+    std::string &scratch() { return scratch_; }
+
+    std::size_t size() const { return index_.size(); }
+    std::size_t bytes() const { return bytes_; }
+
+ private:
+    struct Entry {
+        std::string key;
+        std::chrono::steady_clock::time_point expires;
+        std::size_t bytes = 0;
+        CachedResponse response;
+    };
+    using EntryList = std::list<Entry>;
+
+    void renderValidators(CachedResponse &response) const;
+    void account(Entry &entry);
+    void evict(EntryList::iterator it);
+
+    std::size_t capacity_;
+    std::chrono::milliseconds ttl_;
+    bool vary_;
+    EntryList lru_;
+    std::unordered_map<std::string, EntryList::iterator> index_;
+    std::size_t bytes_ = 0;
+    // 조회 키를 만드는 버퍼. 용량을 남겨 캐시 적중 시 할당하지 않는다.
+    std::string key_;
+    std::string scratch_;
+};
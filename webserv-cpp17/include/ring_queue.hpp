@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * [모듈] webserv-cpp17/include/ring_queue.hpp
+ * 설명:
+ *   - 앞에서 꺼내고 뒤에 넣기만 하는 FIFO 를 2의 거듭제곱 크기 원형 배열로 구현한다.
+ *   - std::deque 는 블록 경계를 넘을 때마다 블록을 새로 할당/해제하므로, 원소 하나를 넣고 빼기를 반복하는
+ *     keep-alive 요청 경로에서도 주기적으로 힙 할당이 일어난다. 이 큐는 용량이 한 번 잡히면 할당하지 않는다.
+ * 버전: v1.10.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.10.0-zero-alloc-responses.md
+ * 변경 이력:
+ *   - v1.10.0: 출력 큐 파일 구간과 연결별 지연 측정 목록용으로 추가
+ * 테스트:
+ *   - tests/test_webserv_alloc_free.sh
+ */
+
+/**
+ * RingQueue
+ * 주의 사항:
+ *   - T 는 기본 생성과 이동 대입이 가능해야 한다. pop_front 는 빈 칸에 T() 를 대입해
+ *     shared_ptr 같은 소유 자원을 바로 놓는다.
+ *   - clear 는 용량을 남긴다.
+ */
+template <typename T>
+class RingQueue {
+ public:
+    bool empty() const { return size_ == 0; }
+    std::size_t size() const { return size_; }
+
+    T &front() { return slots_[head_]; }
+    const T &front() const { return slots_[head_]; }
+
+    void push_back(T value) {
+        if (size_ == slots_.size()) {
+            grow();
+        }
+        slots_[(head_ + size_) & (slots_.size() - 1)] = std::move(value);
+        ++size_;
+    }
+
+    void pop_front() {
+        slots_[head_] = T();
+        head_ = (head_ + 1) & (slots_.size() - 1);
+        --size_;
+    }
+
+    void clear() {
+        while (!empty()) {
+            pop_front();
+        }
+        head_ = 0;
+    }
+
+ private:
+    static constexpr std::size_t MIN_CAPACITY = 8;
+
+    void grow() {
+        std::vector<T> grown(slots_.empty() ? MIN_CAPACITY : slots_.size() * 2);
+        for (std::size_t i = 0; i < size_; ++i) {
+            grown[i] = std::move(slots_[(head_ + i) & (slots_.size() - 1)]);
+        }
+        slots_.swap(grown);
+        head_ = 0;
+    }
+
+    std::vector<T> slots_;
+    std::size_t head_ = 0;
+    std::size_t size_ = 0;
+};
@@ -0,0 +1,311 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * [모듈] webserv-cpp17/include/router.hpp
+ * 설명:
+ *   - 메서드 + 경로 패턴으로 핸들러 번호를 찾는 라우터 선언부.
+ *   - 매개변수(`/users/:id`)나 나머지 경로(`*path`)가 있는 패턴은 실행 중에 등록하는 기수 트리(RadixRouter)로,
+ *     고정 경로 집합은 컴파일 타임에 만드는 완전 해시 표(FixedRouteSet)로 찾는다.
+ *   - 두 구조 모두 조회 비용이 등록된 경로 수가 아니라 요청 경로 길이에 비례한다. 조회 중 힙 할당이 없다.
+ * 버전: v1.13.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.13.0-router.md
+ * 변경 이력:
+ *   - v1.13.0: 기수 트리 라우터와 constexpr 완전 해시 고정 경로 표 추가
+ * 테스트:
+ *   - tests/test_webserv_router.sh
+ */
+
+enum class HttpMethod : std::uint8_t {
+    kGet,
+    kHead,
+    kPost,
+    kPut,
+    kDelete,
+    kPatch,
+    kOptions,
+    kOther,  // 그 밖의 토큰. 라우트에 등록할 수 없어 항상 405/404 로 끝난다.
+    kCount,
+};
+
+constexpr std::size_t METHOD_COUNT = static_cast<std::size_t>(HttpMethod::kCount);
+
+/**
+ * parseHttpMethod
+ * 설명:
+ *   - 요청 줄의 메서드 토큰을 HttpMethod 로 바꾼다. 메서드는 대소문자를 구분한다(RFC 9110 9.1).
+ */
+HttpMethod parseHttpMethod(std::string_view method);
+
+// 라우트에 등록된 핸들러 번호. 번호가 어떤 핸들러인지는 등록한 쪽이 정한다.
+using RouteId = std::uint16_t;
+constexpr RouteId NO_ROUTE = 0xffff;
+
+enum class RouteStatus {
+    kFound,
+    kMethodNotAllowed,  // 경로는 있지만 이 메서드로 등록된 핸들러가 없다
+    kNotFound,
+};
+
+/**
+ * RouteParams (v1.13.0)
+ * 역할:
+ *   - 패턴 매개변수 이름과 요청 경로 조각을 담는 고정 배열. 조각은 요청 버퍼를 가리킨다.
+ */
+struct RouteParams {
+    static constexpr std::size_t MAX_PARAMS = 8;
+
+    std::array<std::pair<std::string_view, std::string_view>, MAX_PARAMS> items{};
+    std::size_t count = 0;
+
+    // 이름으로 값을 찾는다. 없으면 빈 조각이다.
+    std::string_view get(std::string_view name) const {
+        for (std::size_t i = 0; i < count; ++i) {
+            if (items[i].first == name) {
+                return items[i].second;
+            }
+        }
+        return std::string_view();
+    }
+};
+
+/**
+ * RadixRouter (v1.13.0)
+ * 역할:
+ *   - 경로 패턴을 공통 접두사로 압축한 기수 트리에 넣고, 요청 경로를 한 번 훑어 핸들러 번호를 찾는다.
+ *   - 패턴 문법
+ *     - `/users/:id`: `:이름` 은 다음 `/` 전까지의 비지 않은 구간 하나에 맞는다.
+ *     - `*이름`: 패턴 끝 구간에만 올 수 있고 나머지 경로 전체(빈 문자열 포함)에 맞는다. 예: `/files/` 뒤에 `*path`.
+ *   - 같은 위치에서는 고정 문자열 > 매개변수 > 나머지 경로 순서로 시도하고, 막히면 되돌아가 다음 후보를 본다.
+ * 설계:
+ *   - design/webserv-cpp17/v1.13.0-router.md
+ * 주의 사항:
+ *   - 등록(add)은 워커가 요청을 받기 전에 끝낸다. 조회(match)는 const 이며 할당하지 않는다.
+ *   - 같은 위치의 매개변수 이름이 서로 다르거나 같은 메서드 + 패턴을 두 번 넣으면 add 가 실패한다.
+ *   - 등록 비용은 패턴 길이에 비례하고, 노드는 std::vector 에 번호로 담아 조회 때 포인터를 따라가지 않는다.
+ */
+class RadixRouter {
+ public:
+    RadixRouter();
+
+    /**
+     * add
+     * 설명:
+     *   - method + pattern 에 핸들러 번호 id 를 등록한다.
+     * 출력:
+     *   - 성공 시 true. 패턴 문법 오류, 이름 충돌, 중복 등록이면 false 이고 조회 결과는 바뀌지 않는다.
+     */
+    bool add(HttpMethod method, std::string_view pattern, RouteId id);
+
+    /**
+     * match
+     * 설명:
+     *   - 요청 경로(쿼리 문자열 제외)에 맞는 패턴을 찾는다.
+     * 출력:
+     *   - kFound 이면 id 와 params 가 채워진다.
+     *   - 경로에 맞는 패턴은 있지만 이 메서드가 없으면 kMethodNotAllowed 다.
+     */
+    RouteStatus match(HttpMethod method, std::string_view path, RouteId &id, RouteParams &params) const;
+
+    std::size_t routeCount() const { return routes_; }
+
+ private:
+    static constexpr std::uint32_t NO_NODE = 0xffffffffu;
+
+    // 고정 노드는 prefix 에 맞는다. 매개변수/나머지 경로 노드는 prefix 가 비어 있고 param_name 으로 값을 남긴다.
+    struct Node {
+        std::string prefix;
+        std::string param_name;
+        // 고정 자식의 첫 글자와 노드 번호. 같은 첫 글자를 가진 자식은 하나뿐이다.
+        std::string child_keys;
+        std::vector<std::uint32_t> children;
+        std::uint32_t param_child = NO_NODE;
+        std::uint32_t catch_all_child = NO_NODE;
+        std::array<RouteId, METHOD_COUNT> handlers;
+        bool terminal = false;
+    };
+
+    std::uint32_t insertStatic(std::uint32_t node, std::string_view text);
+    std::uint32_t find(std::uint32_t node, std::string_view rest, RouteParams &params) const;
+
+    std::vector<Node> nodes_;
+    std::size_t routes_ = 0;
+};
+
+/**
+ * FixedRoute
+ * 설명:
+ *   - FixedRouteSet 에 넣는 매개변수 없는 고정 경로 하나.
+ */
+struct FixedRoute {
+    HttpMethod method;
+    std::string_view path;
+    RouteId id;
+};
+
+/**
+ * routeHash
+ * 설명:
+ *   - 경로의 64비트 FNV-1a 해시. FixedRouteSet 이 컴파일 타임과 실행 중에 같은 값을 쓴다.
+ */
+constexpr std::uint64_t routeHash(std::string_view text) {
+    std::uint64_t hash = 0xcbf29ce484222325ull;
+    for (char c : text) {
+        hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001b3ull;
+    }
+    return hash;
+}
+
+constexpr std::size_t ceilPowerOfTwo(std::size_t value) {
+    std::size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+/**
+ * FixedRouteSet (v1.13.0)
+ * 역할:
+ *   - 고정 경로 N 개를 constexpr 생성자에서 완전 해시(hash-and-displace) 표로 만든다.
+ *     조회는 해시 한 번, 슬롯 하나 비교로 끝나며 경로 수와 무관하다.
+ * 설계:
+ *   - 경로 해시의 상위 비트로 버킷을 고르고, 키가 많은 버킷부터 모든 키가 빈 슬롯에 떨어지는
+ *     변위(displacement) d 를 찾아 버킷마다 기록한다. 슬롯 = (하위 32비트 + d * (상위 32비트 | 1)) mod SLOTS.
+ *   - 같은 경로의 여러 메서드는 한 슬롯에 메서드별 번호로 모은다.
+ *   - design/webserv-cpp17/v1.13.0-router.md
+ * 주의 사항:
+ *   - 변위를 찾지 못하면 valid() 가 거짓이다. constexpr 변수로 만들고 static_assert 로 확인한다.
+ *   - 같은 메서드 + 경로가 두 번 나오면 valid() 가 거짓이다.
+ */
+template <std::size_t N>
+class FixedRouteSet {
+ public:
+    static constexpr std::size_t SLOTS = ceilPowerOfTwo(N * 2);
+    static constexpr std::size_t BUCKETS = ceilPowerOfTwo((N + 1) / 2);
+
+    constexpr explicit FixedRouteSet(const std::array<FixedRoute, N> &routes) {
+        std::array<std::uint64_t, N> hashes{};
+        std::array<std::size_t, BUCKETS + 1> starts{};
+        for (std::size_t i = 0; i < N; ++i) {
+            hashes[i] = routeHash(routes[i].path);
+            ++starts[bucketOf(hashes[i]) + 1];
+        }
+        std::size_t largest = 0;
+        for (std::size_t b = 0; b < BUCKETS; ++b) {
+            largest = starts[b + 1] > largest ? starts[b + 1] : largest;
+            starts[b + 1] += starts[b];
+        }
+        // 버킷별로 경로 번호를 모은다(계수 정렬).
+        std::array<std::size_t, N> members{};
+        std::array<std::size_t, BUCKETS> filled{};
+        for (std::size_t i = 0; i < N; ++i) {
+            std::size_t b = bucketOf(hashes[i]);
+            members[starts[b] + filled[b]++] = i;
+        }
+
+        valid_ = true;
+        for (std::size_t size = largest; size > 0 && valid_; --size) {
+            for (std::size_t b = 0; b < BUCKETS && valid_; ++b) {
+                if (starts[b + 1] - starts[b] == size) {
+                    valid_ = place(routes, hashes, members, starts[b], starts[b + 1], b);
+                }
+            }
+        }
+    }
+
+    constexpr bool valid() const { return valid_; }
+
+    /**
+     * find
+     * 설명:
+     *   - 경로를 찾아 메서드의 핸들러 번호를 돌려준다.
+     */
+    constexpr RouteStatus find(HttpMethod method, std::string_view path, RouteId &id) const {
+        std::uint64_t hash = routeHash(path);
+        const Slot &slot = slots_[slotOf(hash, displacements_[bucketOf(hash)])];
+        if (!slot.used || slot.path != path) {
+            return RouteStatus::kNotFound;
+        }
+        id = slot.ids[static_cast<std::size_t>(method)];
+        return id == NO_ROUTE ? RouteStatus::kMethodNotAllowed : RouteStatus::kFound;
+    }
+
+ private:
+    struct Slot {
+        std::string_view path;
+        std::array<RouteId, METHOD_COUNT> ids{};
+        bool used = false;
+    };
+
+    // 변위를 이만큼 시도해도 자리가 없으면 포기한다. SLOTS 가 2의 거듭제곱이고 보폭이 홀수라
+    // 키 하나짜리 버킷은 SLOTS 번 안에 반드시 빈 슬롯을 찾는다.
+    static constexpr std::uint32_t MAX_DISPLACEMENT = static_cast<std::uint32_t>(SLOTS * 4);
+
+    static constexpr std::size_t bucketOf(std::uint64_t hash) {
+        return static_cast<std::size_t>(hash >> 40) & (BUCKETS - 1);
+    }
+
+    static constexpr std::size_t slotOf(std::uint64_t hash, std::uint32_t displacement) {
+        std::uint32_t base = static_cast<std::uint32_t>(hash);
+        std::uint32_t step = static_cast<std::uint32_t>(hash >> 32) | 1u;
+        return static_cast<std::size_t>(base + displacement * step) & (SLOTS - 1);
+    }
+
+    constexpr bool place(const std::array<FixedRoute, N> &routes, const std::array<std::uint64_t, N> &hashes,
+                         const std::array<std::size_t, N> &members, std::size_t begin, std::size_t end,
+                         std::size_t bucket) {
+        for (std::uint32_t d = 0; d < MAX_DISPLACEMENT; ++d) {
+            bool fits = true;
+            for (std::size_t i = begin; i < end && fits; ++i) {
+                std::size_t slot = slotOf(hashes[members[i]], d);
+                if (slots_[slot].used) {
+                    fits = false;
+                    break;
+                }
+                // 같은 버킷의 앞선 키와 슬롯이 겹치면 같은 경로(다른 메서드)일 때만 허용한다.
+                for (std::size_t j = begin; j < i; ++j) {
+                    if (slotOf(hashes[members[j]], d) == slot && routes[members[j]].path != routes[members[i]].path) {
+                        fits = false;
+                        break;
+                    }
+                }
+            }
+            if (!fits) {
+                continue;
+            }
+            for (std::size_t i = begin; i < end; ++i) {
+                Slot &slot = slots_[slotOf(hashes[members[i]], d)];
+                if (slot.path.data() == nullptr) {
+                    slot.path = routes[members[i]].path;
+                    for (std::size_t m = 0; m < METHOD_COUNT; ++m) {
+                        slot.ids[m] = NO_ROUTE;
+                    }
+                }
+                std::size_t method = static_cast<std::size_t>(routes[members[i]].method);
+                if (slot.ids[method] != NO_ROUTE) {
+                    return false;  // 같은 메서드 + 경로 중복
+                }
+                slot.ids[method] = routes[members[i]].id;
+            }
+            for (std::size_t i = begin; i < end; ++i) {
+                slots_[slotOf(hashes[members[i]], d)].used = true;
+            }
+            displacements_[bucket] = d;
+            return true;
+        }
+        return false;
+    }
+
+    std::array<Slot, SLOTS> slots_{};
+    std::array<std::uint32_t, BUCKETS> displacements_{};
+    bool valid_ = false;
+};
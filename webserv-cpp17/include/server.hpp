@@ -0,0 +1,135 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "access_log.hpp"
+#include "client_limit.hpp"
+#include "server_config.hpp"
+#include "thread_pool.hpp"
+#include "tls.hpp"
+#include "worker.hpp"
+
+/**
+ * [모듈] webserv-cpp17/include/server.hpp
+ * 설명:
+ *   - 설정된 수만큼 Worker 를 만들고 워커마다 스레드 하나를 배정하는 Server 선언부.
+ * 버전: v1.25.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.2.0-reuseport-workers.md
+ *   - design/webserv-cpp17/v1.7.0-worker-metrics.md
+ *   - design/webserv-cpp17/v1.14.0-response-compression.md
+ *   - design/webserv-cpp17/v1.17.0-handler-offload.md
+ *   - design/webserv-cpp17/v1.21.0-access-log.md
+ *   - design/webserv-cpp17/v1.22.0-tls.md
+ *   - design/webserv-cpp17/v1.24.0-client-limits.md
+ *   - design/webserv-cpp17/v1.25.0-config-reload.md
+ * 변경 이력:
+ *   - v1.2.0: `--workers N` 멀티 코어 실행을 위한 워커 그룹 추가
+ *   - v1.7.0: 워커별 계측 슬롯을 담는 MetricsRegistry 소유
+ *   - v1.14.0: 워커들이 함께 쓰는 압축 작업 스레드 풀 소유
+ *   - v1.17.0: 블로킹 핸들러를 맡는 핸들러 작업 스레드 풀 소유
+ *   - v1.21.0: 워커마다 링을 두는 접근 로그(AccessLog)와 기록 스레드 소유
+ *   - v1.22.0: 워커들이 함께 쓰는 TLS 컨텍스트(TlsContext) 소유
+ *   - v1.24.0: 워커들이 함께 쓰는 클라이언트 한도 표(ClientLimiter) 소유
+ *   - v1.25.0: ConfigLoader, 제어 스레드(SIGHUP/SIGQUIT signalfd, 제어 소켓), takeover 추가
+ * 테스트:
+ *   - tests/test_webserv_workers.sh
+ *   - tests/test_webserv_metrics.sh
+ *   - tests/test_webserv_compression.sh
+ *   - tests/test_webserv_offload.sh
+ *   - tests/test_webserv_access_log.sh
+ *   - tests/test_webserv_tls.sh
+ *   - tests/test_webserv_client_limits.sh
+ *   - tests/test_webserv_reload.sh
+ */
+
+/**
+ * Server (v1.2.0)
+ * 역할:
+ *   - 워커 생성/시작/종료 대기를 총괄한다.
+ *   - 워커가 하나면 별도 스레드 없이 호출 스레드에서 바로 루프를 돈다(v1.1.0 과 동일한 동작).
+ * 설계:
+ *   - design/webserv-cpp17/v1.2.0-reuseport-workers.md
+ * 주의 사항:
+ *   - 모든 워커의 리슨 소켓을 스레드 시작 전에 열어, 바인드 실패 시 스레드 없이 즉시 실패한다.
+ *   - pool_ 은 workers_ 뒤에 선언해 워커보다 먼저 파괴된다. 작업 스레드가 모두 끝난 뒤에 워커를 없앤다.
+ *   - handler_pool_ 은 블로킹 핸들러 전용이다(v1.17.0). 느린 핸들러가 미리 압축 작업을 밀어내지 않도록 pool_ 과 나누고,
+ *     워커 수만큼 deque 를 둔다.
+ *   - access_log_ 는 workers_ 앞에 선언해 워커보다 나중에 파괴된다(v1.21.0). 소멸자가 링에 남은 레코드까지 쓴다.
+ *   - tls_ 는 모든 워커가 함께 쓰는 TLS 컨텍스트다(v1.22.0). 워커의 연결이 SSL 객체로 참조하므로 workers_ 앞에 선언한다.
+ *   - limiter_ 는 모든 워커가 함께 쓰는 클라이언트 한도 표다(v1.24.0). 워커 소멸자가 연결을 닫기 전에 없어지지 않도록
+ *     workers_ 앞에 선언한다.
+ *   - v1.25.0부터 run 은 워커와 별도로 제어 스레드를 하나 띄운다. 제어 스레드는 signalfd 로 SIGHUP(설정 다시 읽기)과
+ *     SIGQUIT(drain)을 받고, `--control-socket` 으로 온 새 프로세스에 리슨 소켓을 넘긴다. 두 시그널은 start 가
+ *     다른 스레드를 만들기 전에 막으므로 워커/작업 스레드에는 배달되지 않는다.
+ *   - 워커와는 RunControl(draining, generation, config)로만 주고받는다. 제어 스레드는 워커 상태를 직접 만지지 않는다.
+ */
+class Server {
+ public:
+    /**
+     * ConfigLoader (v1.25.0)
+     * 설명:
+     *   - SIGHUP 에 설정을 처음부터 다시 만든다. main 은 시작할 때와 같은 명령행(`--config` 파일 포함)을 다시
+     *     해석하는 함수를 넘긴다. 실패하면 false 와 error. 비어 있으면 SIGHUP 을 무시한다.
+     */
+    using ConfigLoader = std::function<bool(ServerConfig &, std::string &)>;
+
+    explicit Server(const ServerConfig &config, ConfigLoader loader = ConfigLoader());
+    ~Server();
+
+    Server(const Server &) = delete;
+    Server &operator=(const Server &) = delete;
+
+    /**
+     * start
+     * 설명:
+     *   - 워커를 생성하고 각 워커의 리슨 소켓/EventLoop 를 준비한다.
+     *   - `--takeover` 면 워커를 만들기 전에 이전 프로세스에서 리슨 소켓을 받아 워커에 나눠 주고, 워커가 모두
+     *     준비되면 제어 소켓을 연 뒤 이전 프로세스에 준비를 알린다(v1.25.0).
+     * 출력:
+     *   - 모든 워커가 준비되면 true, 하나라도 실패하면 false
+     */
+    bool start();
+
+    /**
+     * run
+     * 설명:
+     *   - 워커 루프를 실행하고 모두 끝날 때까지 기다린다. 그동안 제어 스레드가 시그널과 제어 소켓을 본다(v1.25.0).
+     * 출력:
+     *   - 모든 워커가 정상 종료하면 true
+     */
+    bool run();
+
+ private:
+    bool runWorkers();
+    bool takeOver(std::vector<int> &plain, std::vector<int> &secure);
+    void supervise();
+    void reload();
+    void handOff();
+    void finishHandOff();
+    void drain(const char *reason);
+    void closeControlSocket();
+
+    ServerConfig config_;
+    ConfigLoader loader_;
+    RunControl control_;
+    MetricsRegistry metrics_;
+    std::unique_ptr<AccessLog> access_log_;
+    std::unique_ptr<TlsContext> tls_;
+    std::unique_ptr<ClientLimiter> limiter_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::unique_ptr<ThreadPool> pool_;
+    std::unique_ptr<HandlerPool> handler_pool_;
+    // 제어 스레드가 보는 FD(v1.25.0). 쓰지 않으면 -1 이다.
+    int signal_fd_;
+    int control_fd_;   // 업그레이드 요청을 받는 유닉스 소켓(`--control-socket`)
+    int peer_fd_;      // 리슨 소켓을 넘긴 새 프로세스와의 연결. 준비 바이트나 끊김을 기다린다
+    int takeover_fd_;  // 새 프로세스 쪽에서 이전 프로세스와의 연결. start 끝에서 준비 바이트를 보내고 닫는다
+    // 제어 소켓 경로를 새 프로세스가 다시 바인드했으므로 지우지 않는다.
+    bool handed_off_;
+    std::atomic<bool> finished_;
+};
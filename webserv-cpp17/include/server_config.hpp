@@ -0,0 +1,259 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * [모듈] webserv-cpp17/include/server_config.hpp
+ * 설명:
+ *   - 서버 실행 설정 구조체와 명령행 인자 파서 선언부를 제공한다.
+ * 버전: v1.25.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.1.0-epoll-reactor.md
+ *   - design/webserv-cpp17/v1.2.0-reuseport-workers.md
+ *   - design/webserv-cpp17/v1.6.0-static-files.md
+ *   - design/webserv-cpp17/v1.8.0-timer-wheel.md
+ *   - design/webserv-cpp17/v1.11.0-io-uring-backend.md
+ *   - design/webserv-cpp17/v1.12.0-streaming-request-body.md
+ *   - design/webserv-cpp17/v1.14.0-response-compression.md
+ *   - design/webserv-cpp17/v1.15.0-response-cache.md
+ *   - design/webserv-cpp17/v1.16.0-reverse-proxy.md
+ *   - design/webserv-cpp17/v1.17.0-handler-offload.md
+ *   - design/webserv-cpp17/v1.19.0-load-generator.md
+ *   - design/webserv-cpp17/v1.20.0-accept-path.md
+ *   - design/webserv-cpp17/v1.21.0-access-log.md
+ *   - design/webserv-cpp17/v1.22.0-tls.md
+ *   - design/webserv-cpp17/v1.23.0-http2.md
+ *   - design/webserv-cpp17/v1.24.0-client-limits.md
+ *   - design/webserv-cpp17/v1.25.0-config-reload.md
+ * 변경 이력:
+ *   - v1.1.0: main() 에 하드코딩된 타임아웃/런타임 제한을 설정 구조체로 분리
+ *   - v1.2.0: 워커 수(`--workers`) 추가
+ *   - v1.6.0: 정적 파일 옵션(`--root`, `--file-cache-entries`, `--static-copy`) 추가
+ *   - v1.8.0: 헤더 수신/송신 타임아웃(`--header-timeout-ms`, `--write-timeout-ms`) 추가
+ *   - v1.11.0: I/O 백엔드 선택(`--io-backend epoll|uring`) 추가
+ *   - v1.12.0: 요청 헤더/본문 크기 제한(`--max-header-bytes`, `--max-body-bytes`), 예시 라우트 플래그(`--demo-routes`) 추가
+ *   - v1.14.0: 응답 압축 옵션(`--compression-level`, `--compression-cache-bytes`, `--compression-threads`) 추가
+ *   - v1.15.0: 응답 캐시 옵션(`--response-cache-bytes`, `--response-cache-ttl-ms`) 추가
+ *   - v1.16.0: 리버스 프록시 옵션(`--proxy`, `--proxy-balance`, `--upstream-keepalive`, `--proxy-timeout-ms`) 추가
+ *   - v1.17.0: 블로킹 핸들러 작업 스레드 옵션(`--handler-threads`, `--handler-queue`) 추가
+ *   - v1.19.0: 요청 수/런타임 제한을 모두 끄는 `--unlimited` 추가
+ *   - v1.20.0: 수락 경로 옵션(`--listen-backlog`, `--accept-batch`, `--defer-accept-sec`, `--tcp-fastopen`, `--tcp-nodelay`) 추가
+ *   - v1.21.0: 접근 로그 옵션(`--access-log`, `--access-log-sample`, `--access-log-buffer`) 추가
+ *   - v1.22.0: TLS 옵션(`--tls-port`, `--tls-cert`, `--tls-key`, `--tls-session-cache`, `--tls-tickets`, `--tls-ktls`) 추가
+ *   - v1.23.0: HTTP/2 옵션(`--http2`, `--http2-max-streams`, `--http2-window`) 추가
+ *   - v1.24.0: 클라이언트 한도 옵션(`--client-rate`, `--client-burst`, `--client-connections`, `--client-table`)과 `--overload-lag-ms` 추가
+ *   - v1.25.0: config_file/control_socket/takeover/drain_timeout, copyReloadable, restartOnlyChanges 추가
+ * 테스트:
+ *   - tests/test_webserv_epoll_many.sh
+ *   - tests/test_webserv_workers.sh
+ *   - tests/test_webserv_static_files.sh
+ *   - tests/test_webserv_timeouts.sh
+ *   - tests/test_webserv_io_uring.sh
+ *   - tests/test_webserv_request_body.sh
+ *   - tests/test_webserv_compression.sh
+ *   - tests/test_webserv_response_cache.sh
+ *   - tests/test_webserv_proxy.sh
+ *   - tests/test_webserv_offload.sh
+ *   - tests/test_webserv_bench.sh
+ *   - tests/test_webserv_accept.sh
+ *   - tests/test_webserv_access_log.sh
+ *   - tests/test_webserv_tls.sh
+ *   - tests/test_webserv_http2.sh
+ *   - tests/test_webserv_client_limits.sh
+ *   - tests/test_webserv_reload.sh
+ */
+
+// 워커가 소켓 I/O 에 쓰는 엔진. epoll 준비 통지 루프가 기본이며 io_uring 은 완료 기반 대안이다(v1.11.0).
+enum class IoBackendKind {
+    kEpoll,
+    kIoUring,
+};
+
+// 프록시 경로 하나에 묶인 업스트림 서버 중 요청을 보낼 서버를 고르는 방식(v1.16.0).
+enum class ProxyBalance {
+    kRoundRobin,
+    kLeastConnections,
+};
+
+/**
+ * ProxyTarget (v1.16.0)
+ * 설명:
+ *   - `--proxy PREFIX=HOST:PORT[,HOST:PORT...]` 한 개. 경로가 prefix 로 시작하는 요청을 upstreams 중 하나로 넘긴다.
+ *   - upstreams 항목은 `HOST:PORT` 문자열 그대로다. 주소 해석은 워커가 시작할 때 한다.
+ */
+struct ProxyTarget {
+    std::string prefix;
+    std::vector<std::string> upstreams;
+};
+
+// 설정을 다시 읽었을 때 프록시 경로 표가 바뀌었는지 보는 데 쓴다(v1.25.0).
+inline bool operator==(const ProxyTarget &lhs, const ProxyTarget &rhs) {
+    return lhs.prefix == rhs.prefix && lhs.upstreams == rhs.upstreams;
+}
+
+/**
+ * ServerConfig (v1.2.0)
+ * 역할:
+ *   - 포트, 최대 처리 요청 수, 타임아웃 등 실행 파라미터를 한곳에 모은다.
+ * 설계:
+ *   - design/webserv-cpp17/v1.1.0-epoll-reactor.md
+ * 주의 사항:
+ *   - 기본값은 v0.4.0 동작(8080 포트, 3건, 1.5초 타임아웃, 10초 런타임)과 같다.
+ *   - max_runtime 이 0 이면 런타임 제한을 두지 않는다.
+ *   - max_requests 는 모든 워커의 처리 건수 합계에 적용된다.
+ *     벤치마크용 `--unlimited` 는 위치 인자 순서와 상관없이 max_requests 를 SIZE_MAX, max_runtime 을 0 으로 둔다.
+ *   - root 가 비어 있으면 정적 파일을 서빙하지 않고 기존 인사 본문으로 응답한다.
+ *   - static_copy 는 sendfile 대신 read() 로 본문을 읽어 보내는 비교 측정용 경로다.
+ *   - idle_timeout 은 요청 사이(keep-alive 유휴), header_timeout 은 요청 첫 바이트부터 헤더 완성까지,
+ *     write_timeout 은 응답 송신이 진척 없이 멈춘 시간에 적용한다.
+ *     header_timeout/write_timeout 이 0 이면 idle_timeout 값을 따른다(v1.7.0 까지의 단일 타임아웃 동작).
+ *   - io_backend 가 kIoUring 이어도 커널이 필요한 기능을 지원하지 않으면 워커는 epoll 로 대신한다.
+ *   - max_header_bytes 는 요청 라인부터 헤더 끝 빈 줄까지의 크기 제한(넘으면 431),
+ *     max_body_bytes 는 본문 크기 제한(넘으면 413)이다. 본문은 버퍼에 모으지 않으므로 이 값이 메모리 사용량을 정하지는 않는다.
+ *   - demo_routes 가 참일 때만 예시 핸들러(`POST /upload`, `GET /delay/:ms`, `GET /sleep/:ms`, `POST /upload/echo`,
+ *     `GET /fetch/<경로>`)를 등록한다. 기본은 꺼져 있어 없는 경로와 같다.
+ *   - compression_level 은 zlib 압축 수준(1~9)이며 0 이면 응답 압축을 끈다.
+ *     compression_cache_bytes 는 워커마다 두는 정적 파일 압축본 캐시 한도이고 0 이면 정적 파일은 압축하지 않는다.
+ *     compression_threads 가 0 이면 미리 압축도 워커 스레드에서 바로 한다.
+ *   - response_cache_bytes 는 워커마다 두는 라우트 응답 캐시 한도이고 0(기본)이면 캐시하지 않는다.
+ *     response_cache_ttl 동안은 핸들러를 부르지 않고 캐시 본문으로 응답한다.
+ *   - proxies 가 비어 있으면(기본) 프록시를 쓰지 않는다. upstream_keepalive 는 워커마다 업스트림 서버 하나에
+ *     남겨 두는 유휴 연결 수이고 0 이면 응답마다 업스트림 연결을 닫는다. proxy_timeout 은 업스트림이 진척 없이
+ *     멈춘 시간(연결, 요청 송신, 응답 대기 모두)에 적용하며 넘기면 504 다.
+ *   - handler_threads 는 블로킹 핸들러(`/delay/:ms` 등)를 맡는 작업 스레드 수다. 0 이면 풀을 만들지 않고
+ *     블로킹 핸들러 요청에 503 으로 답한다. 이벤트 루프에서 부르면 같은 워커의 모든 연결이 멈추기 때문이다.
+ *     handler_queue 는 모든 스레드가 바쁠 때 기다릴 수 있는 작업 수다. 넘치면 줄 세우지 않고 503 으로 답한다.
+ *   - listen_backlog 는 리슨 소켓 수락 대기열 길이다. 커널이 net.core.somaxconn 으로 자른다.
+ *     accept_batch 는 리슨 이벤트 한 번에 받는 최대 연결 수이고 0 이면 대기열이 빌 때까지 받는다.
+ *   - defer_accept 가 0 이 아니면 첫 데이터가 올 때까지(최대 그 시간) 커널이 수락을 미룬다(TCP_DEFER_ACCEPT).
+ *     tcp_fastopen 은 TFO 쿠키 요청 대기열 길이이고 0 이면 끈다. 서버 쪽 TFO 는 net.ipv4.tcp_fastopen 의 2번 비트도 필요하다.
+ *   - tcp_nodelay 가 참(기본)이면 응답을 Nagle 지연 없이 보낸다. 파일 본문 앞 헤더는 이 값과 상관없이 MSG_MORE 로 합친다.
+ *   - access_log 가 비어 있으면(기본) 접근 로그를 남기지 않는다. access_log_sample 이 N 이면 워커마다 요청 N 개 중
+ *     하나만 남긴다. access_log_buffer 는 워커마다 두는 레코드 링 크기(2의 거듭제곱으로 올림)이고, 차면 레코드를 버린다.
+ *   - tls_port 가 0 이 아니면 평문 포트와 함께 TLS 리스너를 연다. tls_cert(PEM 인증서 사슬)와 tls_key(PEM 개인 키)가
+ *     필요하다. tls_session_cache 는 모든 워커가 함께 쓰는 서버 쪽 세션 캐시 항목 수이고 0 이면 캐시하지 않는다.
+ *     tls_tickets 를 끄면 세션 티켓 대신 세션 캐시로만 재개한다. tls_ktls 가 참이면 커널과 OpenSSL 이 지원할 때
+ *     송신을 커널 TLS 에 맡겨 정적 파일을 sendfile 로 보낸다. TLS 리스너를 열면 io_backend 는 epoll 로 돈다.
+ *   - http2 가 참(기본)이면 평문 포트에서 HTTP/2 프리페이스(prior knowledge)와 `Upgrade: h2c` 를 받고,
+ *     TLS 리스너에서는 ALPN 으로 h2 를 고른다. http2_max_streams 는 연결 하나에 동시에 열 수 있는 스트림 수
+ *     (SETTINGS_MAX_CONCURRENT_STREAMS)이고, http2_window 는 스트림과 연결의 수신 흐름 제어 창 크기다.
+ *   - client_rate 가 0 이 아니면 클라이언트 주소(IPv4 주소, IPv6 /64)마다 초당 요청 수를 토큰 버킷으로 제한하고,
+ *     넘친 요청에 429 와 Retry-After 로 답한다. client_burst 는 버킷 크기이고 0 이면 client_rate 와 같다.
+ *     client_connections 가 0 이 아니면 주소마다 동시 연결 수를 넘는 연결을 수락하자마자 닫는다.
+ *     client_table 은 모든 워커가 함께 쓰는 주소 표의 칸 수(2의 거듭제곱으로 올림)다.
+ *   - overload_lag 가 0 이 아니면 워커 루프 한 바퀴의 처리 시간이 그 값을 넘을 때 과부하 상태로 들어가
+ *     새 요청에 503 과 Retry-After 로 답한다. 처리 시간이 절반 아래로 내려오면 빠져나온다.
+ *   - config_file 은 `--config` 로 읽은 설정 파일 경로다. SIGHUP 을 받으면 파일과 명령행을 처음부터 다시 읽어
+ *     copyReloadable 에 있는 값만 실행 중인 워커에 반영한다. 나머지(리슨 포트, 워커 수, 표/캐시 크기 등)는
+ *     무중단 업그레이드로 바꾼다.
+ *   - control_socket 이 비어 있지 않으면 그 경로에 유닉스 소켓을 열어 두고, 붙은 새 프로세스에 리슨 소켓을 넘긴다.
+ *     takeover 는 새 프로세스 쪽 옵션으로, 그 경로에 붙어 리슨 소켓을 받아 쓴다. 새 프로세스가 준비를 알리면
+ *     이전 프로세스는 새 연결을 받지 않고 열린 연결을 마저 처리한 뒤(drain) 끝난다. drain_timeout 이 지나도
+ *     남은 연결은 닫는다. SIGQUIT 도 같은 방식으로 끝낸다.
+ */
+struct ServerConfig {
+    std::uint16_t port = 8080;
+    std::size_t max_requests = 3;
+    std::chrono::milliseconds idle_timeout{1500};
+    std::chrono::milliseconds header_timeout{0};
+    std::chrono::milliseconds write_timeout{0};
+    std::chrono::seconds max_runtime{10};
+    std::size_t workers = 1;
+    std::string root;
+    std::size_t file_cache_entries = 1024;
+    bool static_copy = false;
+    IoBackendKind io_backend = IoBackendKind::kEpoll;
+    std::size_t max_header_bytes = 16 * 1024;
+    std::uint64_t max_body_bytes = 1024 * 1024;
+    bool demo_routes = false;
+    int compression_level = 6;
+    std::size_t compression_cache_bytes = 16 * 1024 * 1024;
+    std::size_t compression_threads = 1;
+    std::size_t response_cache_bytes = 0;
+    std::chrono::milliseconds response_cache_ttl{1000};
+    std::vector<ProxyTarget> proxies;
+    ProxyBalance proxy_balance = ProxyBalance::kRoundRobin;
+    std::size_t upstream_keepalive = 32;
+    std::chrono::milliseconds proxy_timeout{10000};
+    std::size_t handler_threads = 4;
+    std::size_t handler_queue = 64;
+    std::size_t listen_backlog = 4096;
+    std::size_t accept_batch = 64;
+    std::chrono::seconds defer_accept{0};
+    std::size_t tcp_fastopen = 0;
+    bool tcp_nodelay = true;
+    std::string access_log;
+    std::size_t access_log_sample = 1;
+    std::size_t access_log_buffer = 8192;
+    std::uint16_t tls_port = 0;
+    std::string tls_cert;
+    std::string tls_key;
+    std::size_t tls_session_cache = 20480;
+    bool tls_tickets = true;
+    bool tls_ktls = true;
+    bool http2 = true;
+    std::size_t http2_max_streams = 128;
+    std::size_t http2_window = 1024 * 1024;
+    std::uint32_t client_rate = 0;
+    std::uint32_t client_burst = 0;
+    std::uint32_t client_connections = 0;
+    std::size_t client_table = 65536;
+    std::chrono::milliseconds overload_lag{0};
+    std::string config_file;
+    std::string control_socket;
+    std::string takeover;
+    std::chrono::milliseconds drain_timeout{10000};
+};
+
+/**
+ * parseCommandLine
+ * 설명:
+ *   - `<port> [max_requests] [--idle-timeout-ms N] [--header-timeout-ms N] [--write-timeout-ms N]
+ *     [--max-runtime-sec N] [--workers N] [--root DIR] [--file-cache-entries N] [--static-copy]
+ *     [--io-backend epoll|uring] [--max-header-bytes N] [--max-body-bytes N] [--demo-routes] [--compression-level N]
+ *     [--compression-cache-bytes N] [--compression-threads N] [--response-cache-bytes N]
+ *     [--response-cache-ttl-ms N] [--proxy PREFIX=HOST:PORT[,HOST:PORT...]]
+ *     [--proxy-balance round-robin|least-conn] [--upstream-keepalive N] [--proxy-timeout-ms N]
+ *     [--handler-threads N] [--handler-queue N] [--unlimited] [--listen-backlog N] [--accept-batch N]
+ *     [--defer-accept-sec N] [--tcp-fastopen N] [--tcp-nodelay on|off] [--access-log PATH]
+ *     [--access-log-sample N] [--access-log-buffer N] [--tls-port N] [--tls-cert FILE] [--tls-key FILE]
+ *     [--tls-session-cache N] [--tls-tickets on|off] [--tls-ktls on|off]
+ *     [--http2 on|off] [--http2-max-streams N] [--http2-window N] [--client-rate N] [--client-burst N]
+ *     [--client-connections N] [--client-table N] [--overload-lag-ms N] [--config FILE] [--port N]
+ *     [--max-requests N] [--control-socket PATH] [--takeover PATH] [--drain-timeout-ms N]` 형식을 해석한다.
+ *   - `--proxy` 는 여러 번 줄 수 있다.
+ *   - `--config FILE` 이 있으면 그 파일을 먼저 읽고 나머지 명령행 옵션으로 덮는다(v1.25.0). 파일은 한 줄에
+ *     `이름 [값]` 하나이며 이름은 명령행 옵션에서 `--` 를 뗀 것이다(`port 8080`, `proxy /api=127.0.0.1:9000`).
+ *   - `--tls-port` 는 `--tls-cert`, `--tls-key` 와 함께 주어야 하고 평문 포트와 달라야 한다.
+ * 입력:
+ *   - argc/argv: main() 인자
+ * 출력:
+ *   - 성공 시 true 와 채워진 config, 실패 시 false 와 error 메시지
+ * 에러:
+ *   - 알 수 없는 옵션이나 값 누락 시 false 를 반환한다.
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.1.0-epoll-reactor.md
+ * 관련 테스트:
+ *   - tests/test_webserv_epoll_many.sh
+ */
+bool parseCommandLine(int argc, char *argv[], ServerConfig &config, std::string &error);
+
+/**
+ * copyReloadable (v1.25.0)
+ * 설명:
+ *   - 워커가 루프 회차 사이에 바꿔 끼울 수 있는 값(타임아웃, 헤더/본문 한도, 프록시 경로와 업스트림, 수락 예산,
+ *     핸들러 대기열, 접근 로그 표본, HTTP/2 스트림/창, 과부하 기준, drain 시간)만 from 에서 to 로 옮긴다.
+ */
+void copyReloadable(const ServerConfig &from, ServerConfig &to);
+
+/**
+ * restartOnlyChanges (v1.25.0)
+ * 설명:
+ *   - 다시 읽은 설정(loaded)에서 바뀌었지만 실행 중에는 반영할 수 없는 옵션 이름을 모은다.
+ *     SIGHUP 은 이 값들을 무시하고 경고만 남긴다.
+ */
+std::vector<std::string> restartOnlyChanges(const ServerConfig &running, const ServerConfig &loaded);
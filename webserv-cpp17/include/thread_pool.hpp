@@ -0,0 +1,174 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * [모듈] webserv-cpp17/include/thread_pool.hpp
+ * 설명:
+ *   - 이벤트 루프를 막을 수 있는 작업(압축 등)을 맡기는 작업 스레드 풀과,
+ *     작업 결과를 워커 스레드로 돌려보내는 완료 큐 선언부.
+ * 버전: v1.17.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.14.0-response-compression.md
+ *   - design/webserv-cpp17/v1.17.0-handler-offload.md
+ * 변경 이력:
+ *   - v1.14.0: 미리 압축 작업용 ThreadPool 과 eventfd 기반 CompletionQueue 추가
+ *   - v1.17.0: 대기 작업 수 한도를 넘으면 거절하는 trySubmit 추가,
+ *              블로킹 핸들러용 워커별 deque + work-stealing 풀(HandlerPool) 추가
+ * 테스트:
+ *   - tests/test_webserv_compression.sh
+ *   - tests/test_webserv_offload.sh
+ */
+
+/**
+ * ThreadPool (v1.14.0)
+ * 역할:
+ *   - 고정 개수의 작업 스레드가 공유 FIFO 에서 작업을 꺼내 실행한다. 모든 워커가 하나를 같이 쓴다.
+ * 주의 사항:
+ *   - 작업은 워커 상태를 직접 건드리지 않는다. 결과는 CompletionQueue::post 로 워커에 넘긴다.
+ *   - 소멸자는 실행 중인 작업이 끝나기를 기다리고, 아직 시작하지 않은 작업은 버린다.
+ *     작업이 가리키는 워커 객체보다 먼저 파괴되어야 한다(Server 가 순서를 보장한다).
+ */
+class ThreadPool {
+ public:
+    explicit ThreadPool(std::size_t threads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /**
+     * submit
+     * 설명:
+     *   - 작업을 큐 끝에 넣고 쉬고 있는 스레드 하나를 깨운다. 어느 스레드에서 불러도 된다.
+     */
+    void submit(std::function<void()> task);
+
+    /**
+     * trySubmit (v1.17.0)
+     * 설명:
+     *   - 쉬는 스레드가 없고 스레드를 기다리는 작업이 이미 max_waiting 개면 넣지 않고 거짓을 돌려준다.
+     *     큐를 한없이 늘려 지연을 키우는 대신 호출자가 바로 거절(503)하게 한다.
+     * 출력:
+     *   - 작업을 넣었으면 true
+     */
+    bool trySubmit(std::function<void()> task, std::size_t max_waiting);
+
+    std::size_t threads() const { return threads_.size(); }
+
+ private:
+    void runLoop();
+
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::deque<std::function<void()>> tasks_;
+    std::size_t busy_ = 0;
+    bool stopping_ = false;
+    std::vector<std::thread> threads_;
+};
+
+/**
+ * HandlerPool (v1.17.0)
+ * 역할:
+ *   - 블로킹 핸들러를 돌리는 작업 스레드 풀. 이벤트 루프 워커마다 deque 하나를 두고, 워커는 자기 deque 에만 넣는다.
+ *   - 작업 스레드 i 는 deque i % 워커 수를 먼저 비우고, 비어 있으면 다른 deque 앞에서 훔쳐 온다.
+ *     워커끼리 잠금을 나눠 갖지 않고, 한 워커에 몰린 작업도 놀고 있는 스레드가 모두 나눠 맡는다.
+ * 주의 사항:
+ *   - 요청 작업은 서로 독립이므로 주인과 도둑 모두 가장 오래된 작업(앞)부터 꺼낸다. 대기 시간이 큐 길이로 묶인다.
+ *   - 받은 작업 수(대기 + 실행 중)는 원자 카운터 하나로 세어 모든 deque 에 걸친 한도를 지킨다.
+ *   - 소멸 규칙은 ThreadPool 과 같다. 실행 중인 작업은 기다리고 시작하지 않은 작업은 버린다.
+ */
+class HandlerPool {
+ public:
+    HandlerPool(std::size_t threads, std::size_t queues);
+    ~HandlerPool();
+
+    HandlerPool(const HandlerPool &) = delete;
+    HandlerPool &operator=(const HandlerPool &) = delete;
+
+    /**
+     * trySubmit
+     * 설명:
+     *   - 작업을 queue 번 deque 끝에 넣는다. 받은 작업이 이미 스레드 수 + max_waiting 개면 넣지 않는다.
+     *     잠든 스레드가 있을 때만 조건 변수를 건드리므로, 모든 스레드가 바쁜 동안에는 워커별 잠금 하나로 끝난다.
+     * 입력:
+     *   - queue: 호출한 워커 번호(deque 수로 나눈 나머지를 쓴다)
+     * 출력:
+     *   - 작업을 넣었으면 true
+     */
+    bool trySubmit(std::size_t queue, std::function<void()> task, std::size_t max_waiting);
+
+    std::size_t threads() const { return threads_.size(); }
+
+ private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void runLoop(std::size_t home);
+    bool takeTask(std::size_t home, std::function<void()> &task);
+
+    std::unique_ptr<Queue[]> queues_;
+    std::size_t queue_count_;
+    std::atomic<std::size_t> accepted_{0};
+    std::atomic<std::size_t> queued_{0};
+    std::atomic<std::size_t> sleepers_{0};
+    std::atomic<bool> stopping_{false};
+    std::mutex sleep_mutex_;
+    std::condition_variable ready_;
+    std::vector<std::thread> threads_;
+};
+
+/**
+ * CompletionQueue (v1.14.0)
+ * 역할:
+ *   - 다른 스레드가 post 한 콜백을 모아 두고 eventfd 로 워커 루프를 깨운다.
+ *     워커는 eventfd 를 I/O 백엔드에 읽기 감시로 등록하고, 준비되면 drain 으로 콜백을 자기 스레드에서 실행한다.
+ * 주의 사항:
+ *   - drain 은 소유 워커 스레드만 부른다. 콜백 안에서 다시 post 해도 된다(다음 drain 에서 실행된다).
+ *   - 두 목록을 맞바꿔 쓰므로 용량을 잃지 않는다.
+ */
+class CompletionQueue {
+ public:
+    CompletionQueue() = default;
+    ~CompletionQueue();
+
+    CompletionQueue(const CompletionQueue &) = delete;
+    CompletionQueue &operator=(const CompletionQueue &) = delete;
+
+    /**
+     * start
+     * 설명:
+     *   - 논블로킹 eventfd 를 만든다.
+     * 출력:
+     *   - 성공 시 true, eventfd 실패 시 false (errno 유지)
+     */
+    bool start();
+    int fd() const { return event_fd_; }
+
+    void post(std::function<void()> callback);
+
+    /**
+     * drain
+     * 설명:
+     *   - eventfd 카운터를 비우고 지금까지 들어온 콜백을 순서대로 실행한다.
+     * 출력:
+     *   - 실행한 콜백 수
+     */
+    std::size_t drain();
+
+ private:
+    int event_fd_ = -1;
+    std::mutex mutex_;
+    std::vector<std::function<void()>> posted_;
+    std::vector<std::function<void()>> running_;
+};
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * [모듈] webserv-cpp17/include/timer_wheel.hpp
+ * 설명:
+ *   - 연결별 마감 시각을 담는 계층형 타이밍 휠(hierarchical timing wheel) 선언부.
+ *   - 예약/취소는 O(1) 이고, 시간을 진행할 때는 만료된 항목과 상위 단계에서 내려오는 항목만 건드린다.
+ * 버전: v1.8.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.8.0-timer-wheel.md
+ * 변경 이력:
+ *   - v1.8.0: 전체 연결을 훑던 유휴 타임아웃 점검을 대체하는 타이밍 휠 추가
+ * 테스트:
+ *   - tests/test_webserv_timeouts.sh
+ */
+
+/**
+ * TimerNode
+ * 설명:
+ *   - 타이머를 거는 객체에 직접 넣어 두는 침습형(intrusive) 리스트 노드. 휠은 노드를 할당하지 않는다.
+ *   - token 은 만료 시 돌려받을 식별자(워커에서는 연결 FD)다.
+ * 주의 사항:
+ *   - 예약된 노드는 메모리 위치가 바뀌면 안 되므로 복사/이동을 막는다. 해제 전에 cancel 해야 한다.
+ */
+struct TimerNode {
+    TimerNode() = default;
+    TimerNode(const TimerNode &) = delete;
+    TimerNode &operator=(const TimerNode &) = delete;
+
+    bool scheduled() const { return next != nullptr; }
+
+    TimerNode *prev = nullptr;
+    TimerNode *next = nullptr;
+    std::uint64_t expires = 0;  // 만료 틱(휠 기준 시각부터의 틱 수)
+    std::uint64_t token = 0;
+};
+
+/**
+ * TimerWheel (v1.8.0)
+ * 역할:
+ *   - 1ms 틱, 단계당 64칸, 4단계로 약 4.6시간까지의 마감을 보관한다. 더 먼 마감은 최대 범위로 줄인다.
+ *   - 0단계는 64ms 를 1ms 단위로, 1단계는 4.096초를 64ms 단위로 나눈다. 상위 칸은 차례가 오면 하위 단계로 다시 나뉜다.
+ *   - 단계마다 비어 있지 않은 칸의 비트맵을 두어 빈 구간은 건너뛰고 다음 마감을 빠르게 찾는다.
+ * 설계:
+ *   - design/webserv-cpp17/v1.8.0-timer-wheel.md
+ * 주의 사항:
+ *   - 스레드 안전하지 않다. 워커 하나가 소유한다.
+ *   - 마감은 틱 단위로 올림하므로 최대 1ms 늦게 만료될 수 있고, 일찍 만료되지는 않는다.
+ */
+class TimerWheel {
+ public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit TimerWheel(Clock::time_point origin = Clock::now());
+
+    TimerWheel(const TimerWheel &) = delete;
+    TimerWheel &operator=(const TimerWheel &) = delete;
+
+    /**
+     * schedule
+     * 설명:
+     *   - 노드를 deadline 에 만료되도록 건다. 이미 걸려 있으면 옮긴다. 지난 시각이면 다음 advance 에서 만료된다.
+     */
+    void schedule(TimerNode &node, Clock::time_point deadline);
+
+    // 걸려 있지 않은 노드에 호출해도 된다.
+    void cancel(TimerNode &node);
+
+    /**
+     * advance
+     * 설명:
+     *   - now 까지 시간을 진행하며 만료된 노드를 떼어 내고 token 을 expired 뒤에 붙인다.
+     *   - 비용은 만료된 노드 수와 지나간 칸 수(빈 칸은 비트맵으로 건너뜀)에 비례하며 걸린 타이머 수와 무관하다.
+     */
+    void advance(Clock::time_point now, std::vector<std::uint64_t> &expired);
+
+    /**
+     * nextTimeout
+     * 설명:
+     *   - 다음 advance 가 할 일이 생길 때까지 남은 시간(ms, 올림)을 limit 안에서 돌려준다.
+     *   - 상위 단계에만 항목이 있으면 다음 칸 경계까지를 돌려준다(그때 하위 단계로 내려온 뒤 다시 계산한다).
+     */
+    int nextTimeout(Clock::time_point now, int limit_ms) const;
+
+    std::size_t size() const { return count_; }
+
+ private:
+    static constexpr unsigned SLOT_BITS = 6;
+    static constexpr unsigned SLOTS = 1u << SLOT_BITS;
+    static constexpr unsigned LEVELS = 4;
+    static constexpr std::uint64_t MAX_SPAN = (std::uint64_t{1} << (SLOT_BITS * LEVELS)) - 1;
+
+    std::uint64_t tickOf(Clock::time_point time, bool round_up) const;
+    void link(TimerNode &node);
+    void unlink(TimerNode &node);
+    void cascade(unsigned level);
+
+    Clock::time_point origin_;
+    std::uint64_t next_ = 0;  // 아직 처리하지 않은 첫 틱
+    std::size_t count_ = 0;
+    std::uint64_t occupied_[LEVELS] = {};
+    // 칸마다 원형 이중 연결 리스트의 머리(센티널) 노드.
+    TimerNode heads_[LEVELS][SLOTS];
+};
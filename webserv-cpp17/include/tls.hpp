@@ -0,0 +1,133 @@
+#pragma once
+
+#include <sys/types.h>
+
+#include <cstddef>
+#include <string>
+
+#include "io_buffer.hpp"
+#include "metrics.hpp"
+#include "server_config.hpp"
+
+/**
+ * [모듈] webserv-cpp17/include/tls.hpp
+ * 설명:
+ *   - OpenSSL 로 TLS 를 종단하는 서버 컨텍스트(TlsContext)와 연결마다 두는 논블로킹 TLS 스트림(TlsStream) 선언부.
+ *   - OpenSSL 헤더는 tls.cpp 에서만 포함한다. 여기서는 SSL/SSL_CTX 구조체를 앞 선언으로만 쓴다.
+ * 버전: v1.23.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.22.0-tls.md
+ *   - design/webserv-cpp17/v1.23.0-http2.md
+ * 변경 이력:
+ *   - v1.22.0: TLS 컨텍스트(인증서, 세션 캐시/티켓, kTLS)와 연결별 TLS 스트림 추가
+ *   - v1.23.0: ALPN 으로 h2 를 골랐는지 알려 주는 TlsStream::alpnHttp2 추가
+ * 테스트:
+ *   - tests/test_webserv_tls.sh
+ *   - tests/test_webserv_http2.sh
+ */
+
+struct ssl_st;
+struct ssl_ctx_st;
+
+/**
+ * TlsContext (v1.22.0)
+ * 역할:
+ *   - 인증서 사슬/개인 키, 서버 쪽 세션 캐시, 세션 티켓 키, kTLS 사용 여부를 담은 SSL_CTX 하나를 소유한다.
+ * 설계:
+ *   - design/webserv-cpp17/v1.22.0-tls.md
+ * 주의 사항:
+ *   - Server 가 하나 만들어 모든 워커가 함께 쓴다. 한 워커에서 받은 세션 티켓이나 캐시된 세션으로 다른 워커에
+ *     붙어도 재개된다. 세션 캐시는 OpenSSL 이 내부 잠금으로 보호한다.
+ *   - 티켓 암호화 키는 OpenSSL 이 컨텍스트를 만들 때 무작위로 만든다. 프로세스가 다시 뜨면 이전 티켓은 풀 수 없다.
+ */
+class TlsContext {
+ public:
+    TlsContext() = default;
+    ~TlsContext();
+
+    TlsContext(const TlsContext &) = delete;
+    TlsContext &operator=(const TlsContext &) = delete;
+
+    /**
+     * load
+     * 설명:
+     *   - TLS 1.2 이상 서버 컨텍스트를 만들고 config 의 인증서 사슬과 개인 키를 읽는다.
+     *   - config.http2 가 참이면 ALPN 에서 h2 를 http/1.1 보다 먼저 고른다(v1.23.0).
+     * 출력:
+     *   - 성공 시 true, 실패 시 false 와 OpenSSL 오류를 담은 error
+     */
+    bool load(const ServerConfig &config, std::string &error);
+
+    ssl_ctx_st *native() const { return ctx_; }
+
+ private:
+    ssl_ctx_st *ctx_ = nullptr;
+};
+
+/**
+ * TlsStream (v1.22.0)
+ * 역할:
+ *   - 연결 하나의 SSL 객체. 논블로킹 소켓 위에서 핸드셰이크와 레코드 암복호화를 맡고, 워커에는 평문 바이트만 보인다.
+ *   - read 는 ::recv 와 같은 규약(받은 바이트, 종료 0, 실패 -1 과 errno)을, flush 는 OutputQueue::flush 와 같은
+ *     결과를 따른다. EpollBackend 가 TLS 연결이면 소켓 시스템 호출 대신 이쪽을 부른다.
+ * 설계:
+ *   - design/webserv-cpp17/v1.22.0-tls.md
+ * 주의 사항:
+ *   - 핸드셰이크를 따로 부르지 않는다. 수락 상태로 둔 SSL 에 첫 read 가 핸드셰이크를 진행하고, 끝나면 그 자리에서
+ *     평문을 읽는다. 핸드셰이크 바이트만 오가는 동안 read 는 -1/EAGAIN 이다.
+ *   - read 가 소켓 쓰기를 기다려야 하면(핸드셰이크 응답이나 세션 티켓이 송신 버퍼에 다 들어가지 않음) wantsWrite 가
+ *     참이다. 백엔드는 쓰기 관심사를 켜고, 워커는 쓰기 이벤트에도 읽기를 다시 시도한다.
+ *   - 보낸 바이트(sent_out)는 평문 기준이다. 응답 완료 판정과 송신 바이트 계측은 평문 누적 위치를 그대로 쓴다.
+ *   - SSL_write 는 부분 쓰기 모드라 레코드 하나를 보내면 돌아온다. 막힌 쓰기를 다시 부를 때는 같은 바이트를 같거나
+ *     더 긴 길이로 넘긴다(출력 큐 앞부분은 보낼 때까지 그대로이고, 버퍼 주소는 바뀌어도 된다).
+ *   - 커널 TLS 송신이 켜지면(ktlsSend) 파일 구간은 SSL_sendfile 로 페이지 캐시에서 바로 보낸다. 아니면 파일을
+ *     레코드 크기만큼 scratch 에 읽어 암호화하고, 파일 바로 앞의 헤더도 같은 레코드에 넣는다.
+ */
+class TlsStream {
+ public:
+    // TLS 레코드 하나에 담기는 평문 최대 크기. 파일 구간을 읽어 암호화하는 scratch 버퍼 크기이기도 하다.
+    static constexpr std::size_t RECORD_BYTES = 16384;
+
+    TlsStream() = default;
+    ~TlsStream();
+
+    TlsStream(const TlsStream &) = delete;
+    TlsStream &operator=(const TlsStream &) = delete;
+
+    bool active() const { return ssl_ != nullptr; }
+    bool wantsWrite() const { return read_wants_write_; }
+    bool ktlsSend() const { return ktls_send_; }
+    // 핸드셰이크에서 ALPN 으로 h2 를 골랐는지(v1.23.0). 참이면 워커는 첫 바이트부터 HTTP/2 로 읽는다.
+    bool alpnHttp2() const { return alpn_h2_; }
+
+    /**
+     * attach
+     * 설명:
+     *   - 수락한 소켓 fd 에 서버 쪽 SSL 객체를 붙인다. 핸드셰이크 결과와 kTLS 사용 여부는 metrics 에 센다.
+     * 출력:
+     *   - 성공 시 true, SSL 객체를 만들지 못하면 false
+     */
+    bool attach(const TlsContext &context, int fd, WorkerMetrics &metrics);
+
+    ssize_t read(char *destination, std::size_t capacity);
+    FlushResult flush(OutputQueue &output, char *scratch, std::size_t &sent_out);
+
+    // 핸드셰이크를 마친 연결이면 close_notify 를 한 번 보내 본다. 답을 기다리지 않는다.
+    void shutdown();
+
+    // SSL 객체를 풀고 초기 상태로 되돌린다. 연결 풀이 슬롯을 돌려받을 때 부른다.
+    void reset();
+
+ private:
+    void finishHandshake();
+    int failure(int result, bool reading);
+    FlushResult writeFailure(int result);
+
+    ssl_st *ssl_ = nullptr;
+    WorkerMetrics *metrics_ = nullptr;
+    bool handshake_done_ = false;
+    bool read_wants_write_ = false;
+    bool ktls_send_ = false;
+    bool alpn_h2_ = false;
+    bool failed_ = false;
+};
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <linux/io_uring.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "io_backend.hpp"
+#include "ring_queue.hpp"
+
+/**
+ * [모듈] webserv-cpp17/include/uring_backend.hpp
+ * 설명:
+ *   - io_uring 완료 큐로 IoBackend 를 구현한다. liburing 없이 io_uring_setup/enter/register 시스템 호출과
+ *     mmap 한 SQ/CQ 링을 직접 다룬다.
+ *   - 수락은 multishot accept, 수신은 제공 버퍼 링(provided buffer ring)에서 커널이 고른 버퍼로,
+ *     송신은 SEND 작업으로 맡긴다. 루프 한 회차에 쌓인 작업은 io_uring_enter 한 번으로 함께 제출한다.
+ * 버전: v1.25.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.11.0-io-uring-backend.md
+ *   - design/webserv-cpp17/v1.25.0-config-reload.md
+ * 변경 이력:
+ *   - v1.11.0: io_uring 백엔드 추가
+ *   - v1.25.0: unwatchListener 재정의, Op::kCancel 과 accept_stopped_ 추가
+ * 테스트:
+ *   - tests/test_webserv_io_uring.sh
+ *   - tests/test_webserv_reload.sh
+ */
+
+/**
+ * IoUringBackend (v1.11.0)
+ * 역할:
+ *   - 워커의 준비 통지 모델을 완료 모델 위에 흉내 낸다.
+ *     - recv: 받아 둔 버퍼가 있으면 복사해 돌려주고, 없으면 RECV 작업을 걸고 EAGAIN 을 돌려준다.
+ *       완료되면 버퍼를 연결에 붙이고 EVENT_READ 를 올린다.
+ *     - flush: 출력 큐의 다음 버퍼 구간을 가리키는 SEND 작업을 걸고 kBlocked 를 돌려준다.
+ *       완료되면 출력 큐에 송신을 반영하고 EVENT_WRITE 를 올린다. 다음 flush 가 그 바이트 수를 보고한다.
+ *     - accept: multishot accept 가 채운 FD 대기열에서 하나씩 꺼낸다.
+ * 설계:
+ *   - design/webserv-cpp17/v1.11.0-io-uring-backend.md
+ * 주의 사항:
+ *   - user_data 는 상위 8비트에 작업 종류, 하위 56비트에 연결 풀 핸들(또는 FD)을 싣는다.
+ *     닫힌 연결의 늦은 완료는 세대 비교로 걸러지고, 그 완료가 가진 버퍼는 링에 돌려준다.
+ *   - RECV 는 한 번에 하나만 건다(single-shot). 연결 하나가 붙잡는 제공 버퍼는 최대 하나이고,
+ *     워커가 수신을 멈춘(백프레셔) 연결은 새 버퍼를 가져가지 않는다.
+ *   - SEND 가 걸려 있는 동안 출력 큐 버퍼가 옮겨지면 안 되므로 워커는 응답을 더 쌓지 않는다(ConnectionIo::send_armed).
+ *     그 상태로 연결을 닫으면 출력 큐를 완료가 올 때까지 orphans_ 에 맡긴다.
+ *   - 제공 버퍼 링 등록(5.19)이 안 되는 커널에서는 준비를 실패로 돌려 epoll 로 대신한다(multishot accept 도 5.19).
+ *   - 파일 구간(sendfile)은 io_uring 작업이 없으므로 동기 sendfile 로 보내고, 막히면 POLLOUT 한 번을 건다.
+ *   - 걸린 작업이 소켓 참조를 쥐고 있어 close 만으로는 연결이 끊기지 않는다. 닫을 때 shutdown 을 먼저 한다.
+ */
+class IoUringBackend : public IoBackend {
+ public:
+    // SQ 크기. 루프 한 회차에 쌓는 작업(연결당 RECV/SEND 하나씩)이 넘치면 중간에 한 번 더 제출한다.
+    static constexpr unsigned SQ_ENTRIES = 1024;
+    // CQ 크기. 넘치더라도 커널(IORING_FEAT_NODROP)이 보관하지만, 보통은 한 번에 다 수거되는 크기로 둔다.
+    static constexpr unsigned CQ_ENTRIES = 8192;
+    // 제공 버퍼 개수와 크기. 워커의 RECV_CHUNK 와 같은 4KB 로 두어 수신 한 번이 복사 한 번이 된다.
+    static constexpr unsigned BUFFER_COUNT = 1024;
+    static constexpr std::size_t BUFFER_SIZE = 4096;
+
+    explicit IoUringBackend(ConnectionPool &connections);
+    ~IoUringBackend() override;
+
+    IoUringBackend(const IoUringBackend &) = delete;
+    IoUringBackend &operator=(const IoUringBackend &) = delete;
+
+    bool valid() const { return ring_fd_ >= 0; }
+    // 준비가 실패했을 때의 errno. 팩토리가 epoll 로 대신하면서 이유를 남기는 데 쓴다.
+    int setupError() const { return setup_error_; }
+
+    const char *name() const override { return "io_uring"; }
+    bool watchListener(int listen_fd) override;
+    bool watchReadable(int fd) override;
+    void unwatchListener(int listen_fd) override;
+    int accept(int listen_fd) override;
+    bool addConnection(Connection &conn) override;
+    ssize_t recv(Connection &conn, char *destination, std::size_t capacity) override;
+    FlushResult flush(Connection &conn, std::size_t &sent_out) override;
+    bool updateInterest(Connection &conn) override;
+    void closeConnection(Connection &conn) override;
+    int wait(std::vector<IoEvent> &out, int timeout_ms) override;
+
+ private:
+    enum class Op : std::uint8_t {
+        kAccept = 1,
+        kPollIn,
+        kRecv,
+        kSend,
+        kPollOut,
+        kCancel,
+    };
+
+    bool setup();
+    void teardown();
+    io_uring_sqe *nextSqe();
+    int enter(unsigned to_submit, unsigned min_complete, unsigned flags, const void *arg, std::size_t arg_size);
+    unsigned unsubmitted() const;
+    void handleCompletion(const io_uring_cqe &cqe, std::vector<IoEvent> &out);
+    bool armAccept(int listen_fd);
+    bool armPollIn(int fd);
+    bool armRecv(Connection &conn);
+    bool armPollOut(Connection &conn);
+    void publishBuffer(int buffer_id);
+    void recycleBuffer(int buffer_id);
+
+    ConnectionPool &connections_;
+    int ring_fd_;
+    int setup_error_;
+
+    // SQ/CQ 링(커널과 공유하는 mmap 영역)
+    void *sq_ring_;
+    std::size_t sq_ring_size_;
+    void *cq_ring_;
+    std::size_t cq_ring_size_;
+    io_uring_sqe *sqes_;
+    std::size_t sqes_size_;
+    unsigned *sq_head_;
+    unsigned *sq_tail_;
+    unsigned sq_mask_;
+    unsigned sq_entries_;
+    unsigned sq_local_tail_;  // 채웠지만 아직 커널에 공개하지 않은 꼬리
+    unsigned *cq_head_;
+    unsigned *cq_tail_;
+    unsigned cq_mask_;
+    io_uring_cqe *cqes_;
+
+    // 제공 버퍼 링(그룹 0)과 버퍼 메모리
+    io_uring_buf_ring *buffer_ring_;
+    std::size_t buffer_ring_size_;
+    char *buffers_;
+    std::uint16_t buffer_tail_;
+
+    int listen_fd_;
+    bool accept_stopped_;  // unwatchListener 뒤에는 다중 수락이 끝나도 다시 걸지 않는다
+    RingQueue<int> accepted_;             // 수락된 FD, 음수는 -errno
+    RingQueue<std::uint64_t> starved_;    // 빈 제공 버퍼가 없어(-ENOBUFS) RECV 를 다시 걸어야 하는 연결
+    std::unordered_map<std::uint64_t, OutputQueue> orphans_;
+};
@@ -0,0 +1,329 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "access_log.hpp"
+#include "client_limit.hpp"
+#include "compression.hpp"
+#include "connection_pool.hpp"
+#include "file_cache.hpp"
+#include "http2.hpp"
+#include "http_message.hpp"
+#include "io_backend.hpp"
+#include "metrics.hpp"
+#include "proxy.hpp"
+#include "response_cache.hpp"
+#include "router.hpp"
+#include "server_config.hpp"
+#include "thread_pool.hpp"
+#include "timer_wheel.hpp"
+#include "tls.hpp"
+
+/**
+ * [모듈] webserv-cpp17/include/worker.hpp
+ * 설명:
+ *   - 연결 상태 구조체와 이벤트 루프 하나를 구동하는 Worker 클래스 선언부.
+ * 버전: v1.25.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v0.2.0-multi-connection-loop.md
+ *   - design/webserv-cpp17/v1.1.0-epoll-reactor.md
+ *   - design/webserv-cpp17/v1.2.0-reuseport-workers.md
+ *   - design/webserv-cpp17/v1.3.0-incremental-parser.md
+ *   - design/webserv-cpp17/v1.4.0-input-cursor-buffer.md
+ *   - design/webserv-cpp17/v1.5.0-output-queue.md
+ *   - design/webserv-cpp17/v1.6.0-static-files.md
+ *   - design/webserv-cpp17/v1.7.0-worker-metrics.md
+ *   - design/webserv-cpp17/v1.8.0-timer-wheel.md
+ *   - design/webserv-cpp17/v1.9.0-connection-pool.md
+ *   - design/webserv-cpp17/v1.10.0-zero-alloc-responses.md
+ *   - design/webserv-cpp17/v1.11.0-io-uring-backend.md
+ *   - design/webserv-cpp17/v1.12.0-streaming-request-body.md
+ *   - design/webserv-cpp17/v1.13.0-router.md
+ *   - design/webserv-cpp17/v1.14.0-response-compression.md
+ *   - design/webserv-cpp17/v1.15.0-response-cache.md
+ *   - design/webserv-cpp17/v1.16.0-reverse-proxy.md
+ *   - design/webserv-cpp17/v1.17.0-handler-offload.md
+ *   - design/webserv-cpp17/v1.18.0-coroutine-handlers.md
+ *   - design/webserv-cpp17/v1.20.0-accept-path.md
+ *   - design/webserv-cpp17/v1.21.0-access-log.md
+ *   - design/webserv-cpp17/v1.22.0-tls.md
+ *   - design/webserv-cpp17/v1.23.0-http2.md
+ *   - design/webserv-cpp17/v1.24.0-client-limits.md
+ *   - design/webserv-cpp17/v1.25.0-config-reload.md
+ * 변경 이력:
+ *   - v0.2.0: 다중 연결 루프와 타임아웃 관리 추가
+ *   - v0.3.0: Host 헤더 검증, keep-alive 처리 추가
+ *   - v0.4.0: 동적 엔드포인트(/health, /metrics) 라우팅 추가
+ *   - v1.1.0: select 루프를 epoll 엣지 트리거 리액터와 FD 색인 연결 테이블로 교체
+ *   - v1.2.0: Server 를 Worker 로 바꾸고 워커별 리슨 소켓/루프/연결 테이블을 갖도록 분리
+ *   - v1.3.0: 연결마다 증분 파서 상태를 보관
+ *   - v1.4.0: 연결 입력을 std::string 대신 읽기 커서 InputBuffer 로 관리
+ *   - v1.5.0: 연결별 출력 큐, 쓰기 가능 이벤트 대기, 출력량 기반 수신 일시 중지(백프레셔) 추가
+ *   - v1.6.0: 워커별 정적 파일 캐시(FileCache)와 inotify FD 등록 추가
+ *   - v1.7.0: 워커별 계측(WorkerMetrics)과 요청별 지연 측정 상태 추가
+ *   - v1.8.0: 주기적 전체 점검 대신 타이밍 휠로 단계별(헤더 수신/유휴/송신) 연결 마감 관리
+ *   - v1.9.0: Connection 을 connection_pool.hpp 로 옮기고, 연결 테이블을 세대 태그 핸들 슬랩 풀로 교체
+ *   - v1.10.0: 워커별 응답 템플릿(Date 캐시, 고정 응답)과 용량을 잃지 않는 지연 목록 교대 버퍼 추가
+ *   - v1.11.0: EventLoop 대신 설정으로 고르는 I/O 백엔드(IoBackend) 소유
+ *   - v1.12.0: 연결별 요청 본문 상태(RequestBody)를 다루는 본문 수신/거절 단계 추가
+ *   - v1.13.0: 매개변수 경로를 등록하는 워커별 RadixRouter 소유
+ *   - v1.14.0: 동적 본문용 Compressor, 정적 파일 압축본 캐시(CompressedCache)와 완료 큐(CompletionQueue) 소유
+ *   - v1.15.0: 라우트 응답을 보관하는 워커별 ResponseCache 소유
+ *   - v1.16.0: 워커별 업스트림 연결 풀(UpstreamPool)과 클라이언트/업스트림 연결을 잇는 프록시 단계 추가
+ *   - v1.17.0: 블로킹 핸들러를 맡기는 핸들러 작업 스레드 풀(handlers)과 작업 결과 응답 단계 추가
+ *   - v1.18.0: 코루틴 핸들러의 시작/재개/업스트림 요청/응답 단계 추가
+ *   - v1.20.0: 리슨 대기열에 남긴 연결을 다음 회차에 이어 받는 accept_pending_ 추가
+ *   - v1.21.0: Server 가 넘긴 접근 로그 링(access_log)과 표본 간격 카운터 추가
+ *   - v1.22.0: TLS 컨텍스트와 TLS 리스너(tls_listen_fd_, tls_accept_pending_) 추가
+ *   - v1.23.0: HTTP/2 세션 시작(ALPN, prior knowledge, h2c 업그레이드)과 스트림 처리 단계, 스트림 응답 자리(h2_reply_) 추가
+ *   - v1.24.0: Server 가 넘긴 클라이언트 한도 표(limiter)와 요청 거절 단계, 루프 지연으로 켜고 끄는 과부하 상태(overloaded_) 추가
+ *   - v1.25.0: RunControl 의 draining/generation/config, adoptListeners, applyConfig, beginDrain 추가
+ * 테스트:
+ *   - tests/test_webserv_multi.sh
+ *   - tests/test_webserv_keepalive.sh
+ *   - tests/test_webserv_epoll_many.sh
+ *   - tests/test_webserv_workers.sh
+ *   - tests/test_webserv_slow_reader.sh
+ *   - tests/test_webserv_static_files.sh
+ *   - tests/test_webserv_metrics.sh
+ *   - tests/test_webserv_timeouts.sh
+ *   - tests/test_webserv_connection_churn.sh
+ *   - tests/test_webserv_alloc_free.sh
+ *   - tests/test_webserv_request_body.sh
+ *   - tests/test_webserv_router.sh
+ *   - tests/test_webserv_compression.sh
+ *   - tests/test_webserv_response_cache.sh
+ *   - tests/test_webserv_proxy.sh
+ *   - tests/test_webserv_offload.sh
+ *   - tests/test_webserv_coroutine.sh
+ *   - tests/test_webserv_io_uring.sh
+ *   - tests/test_webserv_accept.sh
+ *   - tests/test_webserv_access_log.sh
+ *   - tests/test_webserv_tls.sh
+ *   - tests/test_webserv_http2.sh
+ *   - tests/test_webserv_client_limits.sh
+ *   - tests/test_webserv_reload.sh
+ */
+
+/**
+ * RunControl (v1.2.0)
+ * 역할:
+ *   - 모든 워커가 공유하는 종료 플래그와 전체 처리 건수를 담는다.
+ *   - v1.25.0부터 Server 의 제어 스레드가 바꾸는 drain 플래그와 설정 세대, 다시 읽은 설정(config)도 담는다.
+ * 주의 사항:
+ *   - 요청 경로에서 쓰이는 유일한 공유 상태이며 잠금 없이 원자 연산만 사용한다.
+ *   - 두 필드를 서로 다른 캐시 라인에 두어 종료 플래그 읽기가 카운터 갱신과 충돌하지 않게 한다.
+ *     draining/generation 은 stop 처럼 드물게 바뀌고 루프마다 읽기만 하므로 stop 과 같은 줄에 둔다.
+ *   - config 는 std::atomic_store 로 바꾼 뒤 generation 을 release 로 올린다. 워커는 세대가 바뀐 것을 본 뒤에만
+ *     std::atomic_load 로 읽는다.
+ */
+struct RunControl {
+    alignas(64) std::atomic<bool> stop{false};
+    std::atomic<bool> draining{false};
+    std::atomic<std::uint64_t> generation{0};
+    alignas(64) std::atomic<std::size_t> handled{0};
+    std::shared_ptr<const ServerConfig> config;
+};
+
+/**
+ * Worker (v1.2.0)
+ * 역할:
+ *   - 자신의 리슨 소켓과 I/O 백엔드, 연결 테이블을 소유하고 수락/수신/응답/타임아웃 정리를 수행한다.
+ *   - 연결은 FD 를 키로 하는 테이블에 보관해 준비된 이벤트만 O(1) 로 찾아 처리한다.
+ *     v1.9.0부터는 연결 풀(ConnectionPool)의 세대 태그 핸들을 이벤트 토큰으로 써서, 닫힌 뒤 재사용된 FD 로
+ *     늦게 도착한 이벤트나 미뤄 둔 작업이 새 연결에 잘못 적용되지 않는다.
+ * 설계:
+ *   - design/webserv-cpp17/v1.1.0-epoll-reactor.md
+ *   - design/webserv-cpp17/v1.2.0-reuseport-workers.md
+ * 주의 사항:
+ *   - 엣지 트리거 모드이므로 수락/수신은 항상 EAGAIN 까지 반복한다.
+ *   - 응답은 출력 큐에 쌓은 뒤 한 번에 송신한다. 송신 버퍼가 차면 EVENT_WRITE 를 켜고 기다리며,
+ *     큐가 high water mark 를 넘으면 그 연결의 수신/요청 처리를 멈춘다.
+ *   - 타임아웃으로 닫힌 연결도 처리 건수에 포함한다(v0.2.0 동작 유지).
+ *     마감은 연결마다 타이밍 휠에 하나씩 걸며, 루프는 만료된 연결만 닫고 가장 가까운 마감까지만 기다린다.
+ *   - 한 워커는 한 스레드에서만 구동한다. 다른 워커와는 RunControl 외에 상태를 공유하지 않는다.
+ *     정적 파일 캐시도 워커마다 따로 두어 잠금 없이 쓴다.
+ *   - v1.10.0부터 keep-alive 요청 경로(/health, 기본 응답, 오류 응답, 캐시된 정적 파일)는 힙 할당 없이 처리한다.
+ *     요청마다 쓰는 컨테이너는 모두 용량을 남기고 재사용한다.
+ *   - v1.11.0부터 소켓 I/O 는 IoBackend 를 거친다. epoll 이 기본이고 `--io-backend uring` 이면 io_uring 을 쓴다.
+ *     루프는 어느 쪽이든 "이벤트 -> EAGAIN 까지 수신 -> flush" 모델 그대로다.
+ *   - v1.14.0부터 정적 파일 압축은 Server 가 넘긴 작업 스레드 풀(pool)에 맡긴다. 결과는 워커의 완료 큐
+ *     eventfd 로 돌아와 루프 안에서 압축본 캐시에 반영되므로, 캐시는 여전히 워커 스레드만 만진다.
+ *   - v1.16.0부터 업스트림 연결도 같은 연결 풀 슬롯과 I/O 백엔드에 올린다. 클라이언트와 업스트림 연결은
+ *     ProxyLink 의 핸들로 서로를 가리키고, 받는 쪽 출력 큐가 high water mark 를 넘으면 보내는 쪽이
+ *     수신을 멈춘다(stalled). 받는 쪽이 비우면 wakeProxyPeer 가 보내는 쪽을 지연 목록에 다시 넣는다.
+ *   - v1.17.0부터 블로킹 핸들러는 Server 가 넘긴 핸들러 작업 스레드 풀(handlers)에서 돈다. 워커는 풀의 자기 번호
+ *     deque 에 작업을 넣고, 결과는 완료 큐로 돌아온다. 그동안 그 연결만 다음 요청을 읽지 않는다.
+ *     풀이 없으면 블로킹 핸들러를 루프에서 부르지 않고 503 으로 답한다.
+ *   - v1.18.0부터 코루틴 핸들러는 워커 스레드에서 돈다. 본문 조각, 타이머, 업스트림 응답을 기다리는 동안
+ *     프레임(연결의 아레나)만 남기고 루프로 돌아오며, 기다리던 것이 오면 지연 목록을 거쳐 재개한다.
+ *   - v1.21.0부터 접근 로그를 켜면 응답마다 고정 크기 레코드를 Server 가 넘긴 링(access_log)에 복사만 한다.
+ *     서식화와 파일 쓰기는 기록 스레드가 하고, 링이 차면 기다리지 않고 버린 뒤 센다.
+ *   - v1.22.0부터 TLS 컨텍스트(tls)를 받으면 `--tls-port` 에 리슨 소켓을 하나 더 연다. 그 소켓으로 받은 연결에는
+ *     SSL 객체를 붙이고, 이후 처리는 평문 연결과 같다. 핸드셰이크와 암복호화는 백엔드의 recv/flush 안에서 일어난다.
+ *   - v1.24.0부터 Server 가 넘긴 클라이언트 한도 표(limiter)가 있으면 수락할 때 원격 주소의 칸을 잡고,
+ *     요청마다 그 칸의 토큰 버킷을 본다. 루프 한 바퀴의 처리 시간이 `--overload-lag-ms` 를 넘으면 과부하 상태로
+ *     들어가 새 요청을 처리하지 않고 503 으로 돌려보낸다. 어느 쪽도 연결을 닫지 않고 keep-alive 로 답한다.
+ *   - v1.25.0부터 루프 회차마다 RunControl 의 설정 세대를 보고, 바뀌었으면 다시 읽을 수 있는 설정만 제 사본에 옮긴다
+ *     (applyConfig). 업스트림 풀은 새로 만들고, 이전 풀은 진행 중 요청이 끝날 때까지 retired_upstreams_ 에 둔다.
+ *     drain 플래그가 켜지면 리슨 소켓을 닫고, 이후 응답은 모두 `Connection: close` 로 보내며, 연결이 다 닫히거나
+ *     drain_timeout 이 지나면 루프를 끝낸다.
+ */
+class Worker {
+ public:
+    Worker(const ServerConfig &config, std::size_t id, RunControl &control, MetricsRegistry &metrics,
+           ThreadPool *pool = nullptr, HandlerPool *handlers = nullptr, AccessRing *access_log = nullptr,
+           TlsContext *tls = nullptr, ClientLimiter *limiter = nullptr);
+    ~Worker();
+
+    Worker(const Worker &) = delete;
+    Worker &operator=(const Worker &) = delete;
+
+    /**
+     * start
+     * 설명:
+     *   - I/O 백엔드를 만들고 리슨 소켓을 열어 등록한다. 워커가 여럿이면 SO_REUSEPORT 로 같은 포트를 공유한다.
+     *   - TLS 컨텍스트가 있으면 TLS 포트의 리슨 소켓도 같은 방식으로 연다(v1.22.0).
+     * 출력:
+     *   - 성공 시 true, 소켓/백엔드 준비 실패 시 false
+     */
+    bool start();
+
+    /**
+     * adoptListeners (v1.25.0)
+     * 설명:
+     *   - start 전에 부른다. 이전 프로세스에서 받은 리슨 소켓을 새로 열지 않고 쓴다. -1 이면 그 포트는 평소처럼 연다.
+     *   - 받은 소켓의 옵션은 이전 프로세스가 건 그대로이고, 백로그만 이 설정으로 다시 건다.
+     */
+    void adoptListeners(int plain, int tls);
+
+    // 리슨 소켓 FD(v1.25.0). 제어 스레드가 업그레이드하는 새 프로세스에 넘긴다. start 뒤에는 바뀌지 않는다.
+    int listenFd() const { return listen_fd_; }
+    int tlsListenFd() const { return tls_listen_fd_; }
+
+    /**
+     * run
+     * 설명:
+     *   - 전체 처리 건수가 max_requests 에 도달하거나 런타임 제한을 넘을 때까지 루프를 돈다.
+     *   - drain 중이면 연결이 다 닫히거나 drain_timeout 이 지날 때 끝난다(v1.25.0).
+     * 출력:
+     *   - 정상 종료 시 true, 치명적 오류 시 false
+     */
+    bool run();
+
+ private:
+    bool handleConnections();
+    void acceptClients(std::chrono::steady_clock::time_point now, bool tls);
+    void serviceConnection(std::uint64_t handle, std::uint32_t events, std::chrono::steady_clock::time_point now);
+    std::size_t receiveInput(Connection &conn, std::chrono::steady_clock::time_point now);
+    void processRequests(Connection &conn, std::chrono::steady_clock::time_point now);
+    void beginRequest(Connection &conn, std::chrono::steady_clock::time_point now);
+    bool readBody(Connection &conn, std::chrono::steady_clock::time_point now);
+    void completeRequest(Connection &conn, std::chrono::steady_clock::time_point now);
+    void rejectRequest(Connection &conn, CannedReply reply, int status, std::chrono::steady_clock::time_point now);
+    void finishRequest(Connection &conn, RouteLabel route, int status, bool keep_alive,
+                       std::chrono::steady_clock::time_point now);
+    int shedStatus(const Connection &conn, std::chrono::steady_clock::time_point now, std::uint32_t &retry_after);
+    void writeShedReply(OutputQueue &output, int status, std::uint32_t retry_after, bool keep_alive);
+    void releaseClient(Connection &conn);
+    void updateOverload(std::chrono::steady_clock::time_point start);
+    void applyConfig(std::uint64_t generation);
+    void beginDrain(std::chrono::steady_clock::time_point now);
+    void closeIdleUpstreams();
+    bool keepAlive(const HttpRequestView &request) const;
+    void recordSent(Connection &conn, std::size_t sent);
+    void logAccess(Connection &conn, int status);
+    void sampleAccess(AccessRecord &record, std::uint64_t connection, std::uint64_t bytes,
+                      std::chrono::steady_clock::time_point start, int status);
+    bool updateInterest(Connection &conn);
+    void armTimeout(Connection &conn, std::chrono::steady_clock::time_point now, bool progressed);
+    void expireTimeouts(std::chrono::steady_clock::time_point now);
+    void drainOutputs();
+    void closeConnection(Connection &conn);
+    void countHandled();
+    void startProxy(Connection &conn, std::size_t route, bool has_body, bool body_waiting);
+    bool dispatchUpstream(Connection &client, bool fresh);
+    Connection *connectUpstream(UpstreamPool &pool, std::size_t server);
+    bool forwardBody(Connection &conn);
+    void relayResponse(Connection &up, std::chrono::steady_clock::time_point now);
+    void finishProxy(Connection &up, Connection &client, std::chrono::steady_clock::time_point now);
+    void abandonUpstream(Connection &up, int status);
+    void replyProxyError(Connection &conn, std::chrono::steady_clock::time_point now);
+    void unlinkProxy(Connection &client, Connection &up);
+    void detachProxy(Connection &conn);
+    void wakeProxyPeer(Connection &conn);
+    void startOffload(Connection &conn, RouteId route, const RouteParams &params);
+    void completeOffload(std::uint64_t handle, int status, std::string &result);
+    void writeOffloadReply(Connection &conn, std::chrono::steady_clock::time_point now);
+    bool startCoroutine(Connection &conn, RouteId route, const RouteParams &params);
+    bool driveCoroutine(Connection &conn, std::chrono::steady_clock::time_point now);
+    void resumeCoroutine(Connection &conn, std::chrono::steady_clock::time_point now);
+    void startFetch(Connection &conn);
+    void writeCoroutineReply(Connection &conn, std::chrono::steady_clock::time_point now);
+    void startHttp2(Connection &conn, Http2ConnectionLabel mode);
+    bool upgradeHttp2(Connection &conn, std::string_view settings, std::chrono::steady_clock::time_point now);
+    Http2Settings http2Settings() const;
+    void processHttp2(Connection &conn, std::chrono::steady_clock::time_point now);
+    void beginStream(Connection &conn, Http2Stream &stream, const HttpRequestView &request, bool too_large,
+                     std::chrono::steady_clock::time_point now);
+    void streamBody(Connection &conn, Http2Stream &stream);
+    void respondStream(Connection &conn, Http2Stream &stream, bool head_only);
+    void startStreamOffload(Connection &conn, Http2Stream &stream, const HttpRequestView &request, RouteId route,
+                            const RouteParams &params);
+    void completeStreamOffload(std::uint64_t handle, std::uint32_t id, int status, std::string &result);
+    bool stopping() const { return control_.stop.load(std::memory_order_relaxed); }
+
+    ServerConfig config_;
+    std::size_t id_;
+    RunControl &control_;
+    MetricsRegistry &registry_;
+    WorkerMetrics &metrics_;
+    int listen_fd_;
+    // 수락 예산을 다 써서 리슨 대기열에 연결이 남아 있을 수 있다. 다음 루프 회차에서 기다리지 않고 이어 받는다.
+    bool accept_pending_;
+    // TLS 리스너. tls_ 가 없으면 -1 이다. 수락 예산은 평문 리스너와 따로 센다.
+    TlsContext *tls_;
+    int tls_listen_fd_;
+    bool tls_accept_pending_;
+    std::unique_ptr<FileCache> files_;
+    ThreadPool *pool_;
+    HandlerPool *handlers_;
+    AccessRing *access_log_;
+    // 표본 간격(access_log_sample)마다 0 에 닿는다. 0 이 되는 요청만 링에 넣는다.
+    std::size_t access_countdown_;
+    // 모든 워커가 함께 쓰는 클라이언트 한도 표. 한도를 하나도 켜지 않았으면 nullptr 이다.
+    ClientLimiter *limiter_;
+    // 과부하 상태. 루프 한 바퀴 처리 시간이 overload_lag 이상이면 켜고 그 절반 아래면 끈다.
+    bool overloaded_;
+    // 적용한 설정 세대(v1.25.0). RunControl::generation 과 다르면 루프 회차 첫머리에서 applyConfig 를 부른다.
+    std::uint64_t generation_;
+    // drain 중이면 참(v1.25.0). 리슨 소켓은 beginDrain 이 이미 닫았으므로 소멸자가 다시 닫지 않는다.
+    bool draining_;
+    std::chrono::steady_clock::time_point drain_deadline_;
+    CompletionQueue completions_;
+    std::unique_ptr<CompressedCache> compressed_;
+    std::unique_ptr<Compressor> compressor_;
+    std::unique_ptr<ResponseCache> response_cache_;
+    std::unique_ptr<UpstreamPool> upstreams_;
+    // 설정을 다시 읽어 물러난 업스트림 풀(v1.25.0). 진행 중 요청의 ProxyLink 가 가리키므로 다 끝나면 지운다.
+    std::vector<std::unique_ptr<UpstreamPool>> retired_upstreams_;
+    TimerWheel timers_;
+    ConnectionPool connections_;
+    // 연결 풀을 참조하므로 풀보다 뒤에 선언해 먼저 파괴되게 한다.
+    std::unique_ptr<IoBackend> io_;
+    ResponseTemplates responses_;
+    // HTTP/2 스트림 응답을 핸들러가 HTTP/1.1 형식으로 쓰는 자리. respondStream 이 프레임으로 옮기고 비운다.
+    OutputQueue h2_reply_;
+    RadixRouter routes_;
+    std::vector<IoEvent> events_;
+    std::vector<std::uint64_t> deferred_;
+    std::vector<std::uint64_t> deferred_scratch_;
+    std::vector<std::uint64_t> expired_;
+};
@@ -0,0 +1,224 @@
+#include "access_log.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+
+/**
+ * [모듈] webserv-cpp17/src/access_log.cpp
+ * 설명:
+ *   - 접근 로그 레코드 채우기, SPSC 링 생성, 기록 스레드의 링 비우기/서식화/일괄 쓰기를 구현한다.
+ * 버전: v1.21.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.21.0-access-log.md
+ * 변경 이력:
+ *   - v1.21.0: AccessRecord, AccessRing, AccessLog 추가
+ * 테스트:
+ *   - tests/test_webserv_access_log.sh
+ */
+
+namespace {
+
+constexpr char HEX_DIGITS[] = "0123456789abcdef";
+
+// 경로는 요청 바이트 그대로다. 따옴표, 역슬래시, 공백, 제어 문자, 비 ASCII 바이트는 \xHH 로 바꿔 한 줄과 필드 경계를 지킨다.
+void appendEscaped(std::string &out, const char *data, std::size_t length) {
+    for (std::size_t i = 0; i < length; ++i) {
+        auto byte = static_cast<unsigned char>(data[i]);
+        if (byte > 0x20 && byte < 0x7f && byte != '"' && byte != '\\') {
+            out.push_back(static_cast<char>(byte));
+            continue;
+        }
+        out += "\\x";
+        out.push_back(HEX_DIGITS[byte >> 4]);
+        out.push_back(HEX_DIGITS[byte & 0x0f]);
+    }
+}
+
+// 줄마다 부르는 snprintf 두 번이 기록 스레드 CPU 의 큰 몫이라 숫자는 직접 적는다. width 보다 짧으면 0 으로 채운다.
+void appendDecimal(std::string &out, std::uint64_t value, std::size_t width = 0) {
+    char digits[20];
+    std::size_t count = 0;
+    do {
+        digits[count++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+    for (; count < width; ++count) {
+        digits[count] = '0';
+    }
+    while (count > 0) {
+        out.push_back(digits[--count]);
+    }
+}
+
+}  // namespace
+
+void AccessRecord::setRequest(std::string_view request_method, std::string_view request_path) {
+    std::size_t method_bytes = request_method.size() < METHOD_CAPACITY ? request_method.size() : METHOD_CAPACITY;
+    std::memcpy(method, request_method.data(), method_bytes);
+    method_length = static_cast<std::uint8_t>(method_bytes);
+    path_truncated = request_path.size() > PATH_CAPACITY;
+    std::size_t path_bytes = path_truncated ? PATH_CAPACITY : request_path.size();
+    std::memcpy(path, request_path.data(), path_bytes);
+    path_length = static_cast<std::uint8_t>(path_bytes);
+}
+
+AccessRing::AccessRing(std::size_t capacity) {
+    std::size_t rounded = 1;
+    while (rounded < capacity) {
+        rounded <<= 1;
+    }
+    mask_ = rounded - 1;
+    slots_.reset(new AccessRecord[rounded]);
+}
+
+AccessLog::AccessLog(std::size_t workers, std::size_t ring_capacity) {
+    rings_.reserve(workers);
+    for (std::size_t i = 0; i < workers; ++i) {
+        rings_.push_back(std::make_unique<AccessRing>(ring_capacity));
+    }
+}
+
+AccessLog::~AccessLog() {
+    if (thread_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_one();
+        thread_.join();
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+bool AccessLog::open(const std::string &path) {
+    fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        return false;
+    }
+    buffer_.reserve(WRITE_BATCH + 1024);
+    thread_ = std::thread([this]() { run(); });
+    return true;
+}
+
+/**
+ * AccessLog::run
+ * 설명:
+ *   - 멈추라는 요청이 올 때까지 링을 비우고 FLUSH_INTERVAL 만큼 쉰다. 링이 반 넘게 차 있었으면 쉬지 않는다.
+ *   - 멈출 때 한 번 더 비워, 워커가 끝나기 전에 넣은 레코드를 모두 쓴다.
+ */
+void AccessLog::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopping_) {
+        lock.unlock();
+        bool busy = drain() * 2 > rings_.front()->capacity();
+        lock.lock();
+        if (!busy) {
+            wake_.wait_for(lock, FLUSH_INTERVAL, [this]() { return stopping_; });
+        }
+    }
+    lock.unlock();
+    drain();
+}
+
+/**
+ * AccessLog::drain
+ * 설명:
+ *   - 모든 링의 레코드를 서식화해 버퍼에 모으고, WRITE_BATCH 가 찰 때마다, 그리고 끝에 한 번 쓴다.
+ *   - steady_clock 과 벽시계의 차이는 한 번 비울 때마다 한 번만 잰다.
+ * 출력:
+ *   - 링 하나에서 꺼낸 레코드 수의 최댓값
+ */
+std::size_t AccessLog::drain() {
+    auto wall = std::chrono::system_clock::now().time_since_epoch();
+    auto steady = std::chrono::steady_clock::now().time_since_epoch();
+    std::int64_t wall_offset_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(wall).count() -
+                                  std::chrono::duration_cast<std::chrono::nanoseconds>(steady).count();
+    std::size_t most = 0;
+    for (std::size_t worker = 0; worker < rings_.size(); ++worker) {
+        std::size_t count = rings_[worker]->consume(
+            [this, worker, wall_offset_ns](const AccessRecord &record) { format(worker, record, wall_offset_ns); });
+        if (count > most) {
+            most = count;
+        }
+    }
+    if (!buffer_.empty()) {
+        writeOut();
+    }
+    return most;
+}
+
+/**
+ * AccessLog::format
+ * 설명:
+ *   - 레코드 하나를 `시각 worker= conn= method= path="" status= bytes= latency_us=` 한 줄로 버퍼에 붙인다.
+ *   - 시각은 UTC 마이크로초(ISO 8601)다. 메서드/경로가 없으면 `-`, 잘린 경로는 닫는 따옴표 앞에 `...` 를 붙인다.
+ */
+void AccessLog::format(std::size_t worker, const AccessRecord &record, std::int64_t wall_offset_ns) {
+    std::int64_t wall_ns = record.finished_ns + wall_offset_ns;
+    std::int64_t second = wall_ns / 1000000000;
+    if (second != cached_second_) {
+        cached_second_ = second;
+        std::time_t seconds = static_cast<std::time_t>(second);
+        std::tm parts{};
+        gmtime_r(&seconds, &parts);
+        std::strftime(cached_stamp_, sizeof(cached_stamp_), "%Y-%m-%dT%H:%M:%S", &parts);
+    }
+
+    buffer_ += cached_stamp_;
+    buffer_.push_back('.');
+    appendDecimal(buffer_, static_cast<std::uint64_t>((wall_ns % 1000000000) / 1000), 6);
+    buffer_ += "Z worker=";
+    appendDecimal(buffer_, worker);
+    buffer_ += " conn=";
+    appendDecimal(buffer_, record.connection);
+    buffer_ += " method=";
+    if (record.method_length == 0) {
+        buffer_ += "- path=-";
+    } else {
+        appendEscaped(buffer_, record.method, record.method_length);
+        buffer_ += " path=\"";
+        appendEscaped(buffer_, record.path, record.path_length);
+        buffer_ += record.path_truncated ? "...\"" : "\"";
+    }
+    buffer_ += " status=";
+    appendDecimal(buffer_, record.status);
+    buffer_ += " bytes=";
+    appendDecimal(buffer_, record.bytes);
+    buffer_ += " latency_us=";
+    appendDecimal(buffer_, record.latency_us);
+    buffer_.push_back('\n');
+    if (buffer_.size() >= WRITE_BATCH) {
+        writeOut();
+    }
+}
+
+/**
+ * AccessLog::writeOut
+ * 설명:
+ *   - 버퍼를 끝까지 쓰고 비운다. 쓰기 실패는 처음 한 번만 알리고 그 버퍼는 버린다. 워커에는 영향이 없다.
+ */
+void AccessLog::writeOut() {
+    std::size_t offset = 0;
+    while (offset < buffer_.size()) {
+        ssize_t written = ::write(fd_, buffer_.data() + offset, buffer_.size() - offset);
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written <= 0) {
+            if (!write_failed_) {
+                write_failed_ = true;
+                std::cerr << "접근 로그 쓰기 실패: " << std::strerror(errno) << std::endl;
+            }
+            break;
+        }
+        offset += static_cast<std::size_t>(written);
+    }
+    buffer_.clear();
+}
@@ -0,0 +1,210 @@
+#include "client_limit.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+
+#include <algorithm>
+
+/**
+ * [모듈] webserv-cpp17/src/client_limit.cpp
+ * 설명:
+ *   - 클라이언트 키 만들기, 개방 주소 표의 칸 찾기/만들기/가져가기, GCRA 토큰 버킷을 구현한다.
+ * 버전: v1.24.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.24.0-client-limits.md
+ * 변경 이력:
+ *   - v1.24.0: clientKey, ClientLimiter 추가
+ * 테스트:
+ *   - tests/test_webserv_client_limits.sh
+ */
+
+namespace {
+
+// IPv4 주소는 IPv4 매핑 IPv6 주소(::ffff:a.b.c.d)의 아래 64비트와 같은 값으로 둔다.
+constexpr std::uint64_t IPV4_TAG = 0x0000ffff00000000ull;
+
+// 같은 충돌 횟수 안에서 칸을 못 잡으면 포기하고 세지 않는다. 경합이 계속될 때 수락 경로가 돌지 않게 한다.
+constexpr int MAX_ATTEMPTS = 4;
+
+std::uint64_t readBigEndian64(const unsigned char *bytes) {
+    std::uint64_t value = 0;
+    for (int i = 0; i < 8; ++i) {
+        value = (value << 8) | bytes[i];
+    }
+    return value;
+}
+
+}  // namespace
+
+std::uint64_t clientKey(const sockaddr_storage &address) {
+    if (address.ss_family == AF_INET) {
+        const auto &in = reinterpret_cast<const sockaddr_in &>(address);
+        return IPV4_TAG | ntohl(in.sin_addr.s_addr);
+    }
+    if (address.ss_family == AF_INET6) {
+        const auto &in6 = reinterpret_cast<const sockaddr_in6 &>(address);
+        const unsigned char *bytes = in6.sin6_addr.s6_addr;
+        if (IN6_IS_ADDR_V4MAPPED(&in6.sin6_addr)) {
+            return IPV4_TAG | (static_cast<std::uint64_t>(bytes[12]) << 24) |
+                   (static_cast<std::uint64_t>(bytes[13]) << 16) | (static_cast<std::uint64_t>(bytes[14]) << 8) |
+                   bytes[15];
+        }
+        std::uint64_t prefix = readBigEndian64(bytes);
+        // ::/64(::1 등)은 0 이 되므로 빈 칸 표시와 겹치지 않게 1 로 둔다.
+        return prefix != 0 ? prefix : 1;
+    }
+    return 0;
+}
+
+ClientLimiter::ClientLimiter(std::size_t slots, std::uint32_t rate, std::uint32_t burst, std::uint32_t connections)
+    : mask_(0),
+      interval_ns_(rate == 0 ? 0 : 1000000000ull / rate),
+      burst_ns_(0),
+      max_connections_(connections),
+      epoch_(std::chrono::steady_clock::now()) {
+    std::size_t capacity = PROBE_WINDOW;
+    while (capacity < slots) {
+        capacity <<= 1;
+    }
+    mask_ = capacity - 1;
+    burst_ns_ = interval_ns_ * (burst == 0 ? rate : burst);
+    slots_ = std::make_unique<Slot[]>(capacity);
+}
+
+std::uint64_t ClientLimiter::elapsed(std::chrono::steady_clock::time_point now) const {
+    auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(now - epoch_).count();
+    return nanos > 0 ? static_cast<std::uint64_t>(nanos) : 0;
+}
+
+std::size_t ClientLimiter::home(std::uint64_t key) const {
+    // splitmix64 마무리 섞기. IPv4 키는 아래 32비트만 다르므로 그대로 자르면 한 구역에 몰린다.
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ull;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebull;
+    key ^= key >> 31;
+    return static_cast<std::size_t>(key) & mask_;
+}
+
+int ClientLimiter::enter(Slot &slot, std::uint64_t key) {
+    std::uint32_t before = slot.connections.fetch_add(1, std::memory_order_acq_rel);
+    if ((before & RECLAIMING) != 0 || slot.key.load(std::memory_order_acquire) != key) {
+        slot.connections.fetch_sub(1, std::memory_order_acq_rel);
+        return -1;
+    }
+    if (max_connections_ != 0 && before >= max_connections_) {
+        slot.connections.fetch_sub(1, std::memory_order_acq_rel);
+        return 0;
+    }
+    return 1;
+}
+
+bool ClientLimiter::idle(const Slot &slot, std::uint64_t now) const {
+    return slot.connections.load(std::memory_order_acquire) == 0 && slot.tat.load(std::memory_order_relaxed) <= now;
+}
+
+ClientAdmission ClientLimiter::admit(std::uint64_t key, std::chrono::steady_clock::time_point now,
+                                     std::uint32_t &slot) {
+    slot = NO_SLOT;
+    if (key == 0) {
+        return ClientAdmission::kUntracked;
+    }
+    const std::uint64_t at = elapsed(now);
+    const std::size_t start = home(key);
+    for (int attempt = 0; attempt < MAX_ATTEMPTS; ++attempt) {
+        // 1. 창 안에서 처음 나오는 같은 키 칸을 쓴다.
+        bool raced = false;
+        std::size_t found = PROBE_WINDOW;
+        for (std::size_t i = 0; i < PROBE_WINDOW; ++i) {
+            if (slots_[(start + i) & mask_].key.load(std::memory_order_acquire) == key) {
+                found = i;
+                break;
+            }
+        }
+        if (found < PROBE_WINDOW) {
+            std::size_t index = (start + found) & mask_;
+            int entered = enter(slots_[index], key);
+            if (entered == 0) {
+                return ClientAdmission::kRejected;
+            }
+            if (entered > 0) {
+                slot = static_cast<std::uint32_t>(index);
+                return ClientAdmission::kAdmitted;
+            }
+            continue;
+        }
+
+        // 2. 없으면 빈 칸을, 빈 칸도 없으면 쉬는 칸을 가져간다.
+        for (std::size_t i = 0; i < PROBE_WINDOW && !raced; ++i) {
+            std::size_t index = (start + i) & mask_;
+            Slot &candidate = slots_[index];
+            std::uint64_t current = candidate.key.load(std::memory_order_acquire);
+            if (current == 0) {
+                if (!candidate.key.compare_exchange_strong(current, key, std::memory_order_acq_rel)) {
+                    raced = true;
+                    break;
+                }
+            } else {
+                if (!idle(candidate, at)) {
+                    continue;
+                }
+                std::uint32_t zero = 0;
+                if (!candidate.connections.compare_exchange_strong(zero, RECLAIMING, std::memory_order_acq_rel)) {
+                    continue;
+                }
+                if (candidate.tat.load(std::memory_order_relaxed) > at) {
+                    candidate.connections.fetch_sub(RECLAIMING, std::memory_order_acq_rel);
+                    continue;
+                }
+                candidate.key.store(key, std::memory_order_release);
+                candidate.tat.store(0, std::memory_order_relaxed);
+                candidate.connections.fetch_sub(RECLAIMING, std::memory_order_acq_rel);
+            }
+            // 같은 키를 동시에 넣은 다른 워커가 창 앞쪽 칸을 잡았으면 그 칸을 쓴다. 이 칸은 쉬는 칸으로 남는다.
+            for (std::size_t j = 0; j < i; ++j) {
+                if (slots_[(start + j) & mask_].key.load(std::memory_order_acquire) == key) {
+                    raced = true;
+                    break;
+                }
+            }
+            if (raced) {
+                break;
+            }
+            int entered = enter(candidate, key);
+            if (entered == 0) {
+                return ClientAdmission::kRejected;
+            }
+            if (entered > 0) {
+                slot = static_cast<std::uint32_t>(index);
+                return ClientAdmission::kAdmitted;
+            }
+            raced = true;
+        }
+        if (!raced) {
+            // 창 안의 칸이 모두 연결을 가진 다른 주소다.
+            return ClientAdmission::kUntracked;
+        }
+    }
+    return ClientAdmission::kUntracked;
+}
+
+bool ClientLimiter::allowRequest(std::uint32_t slot, std::chrono::steady_clock::time_point now,
+                                 std::uint32_t &retry_after) {
+    if (interval_ns_ == 0) {
+        return true;
+    }
+    const std::uint64_t at = elapsed(now);
+    std::atomic<std::uint64_t> &tat = slots_[slot].tat;
+    std::uint64_t current = tat.load(std::memory_order_relaxed);
+    while (true) {
+        std::uint64_t next = std::max(current, at) + interval_ns_;
+        if (next - at > burst_ns_) {
+            std::uint64_t wait = next - at - burst_ns_;
+            retry_after = static_cast<std::uint32_t>(std::max<std::uint64_t>(1, (wait + 999999999ull) / 1000000000ull));
+            return false;
+        }
+        if (tat.compare_exchange_weak(current, next, std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+}
@@ -0,0 +1,367 @@
+#include "compression.hpp"
+
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <iterator>
+
+/**
+ * [모듈] webserv-cpp17/src/compression.cpp
+ * 설명:
+ *   - Accept-Encoding 협상, zlib 스트리밍 압축, 정적 파일 미리 압축 캐시를 구현한다.
+ * 버전: v1.14.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.14.0-response-compression.md
+ * 변경 이력:
+ *   - v1.14.0: 응답 압축 추가
+ * 테스트:
+ *   - tests/test_webserv_compression.sh
+ */
+
+namespace {
+
+// zlib 창 크기(2^15). gzip 은 16 을 더하면 zlib 헤더 대신 gzip 헤더/트레일러를 쓴다.
+constexpr int WINDOW_BITS = 15;
+constexpr int GZIP_WINDOW_BITS = WINDOW_BITS + 16;
+constexpr int MEMORY_LEVEL = 8;
+
+// 파일을 압축할 때 한 번에 읽는 크기.
+constexpr std::size_t READ_CHUNK = 64 * 1024;
+
+std::string_view trim(std::string_view text) {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t')) {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+/**
+ * parseQuality
+ * 설명:
+ *   - `q=0.5` 형식의 가중치를 0~1000 정수로 바꾼다(RFC 9110 12.4.2, 소수점 아래 세 자리).
+ *   - 형식이 틀리면 1000 으로 본다.
+ */
+int parseQuality(std::string_view params) {
+    while (!params.empty()) {
+        std::size_t semi = params.find(';');
+        std::string_view param = trim(params.substr(0, semi));
+        params = semi == std::string_view::npos ? std::string_view() : params.substr(semi + 1);
+        if (param.size() < 2 || (param[0] != 'q' && param[0] != 'Q') || param[1] != '=') {
+            continue;
+        }
+        std::string_view value = param.substr(2);
+        if (value.empty() || (value[0] != '0' && value[0] != '1')) {
+            return 1000;
+        }
+        int quality = (value[0] - '0') * 1000;
+        if (value.size() > 1 && value[1] == '.') {
+            int scale = 100;
+            for (std::size_t i = 2; i < value.size() && i < 5; ++i) {
+                if (value[i] < '0' || value[i] > '9') {
+                    return 1000;
+                }
+                quality += (value[i] - '0') * scale;
+                scale /= 10;
+            }
+        }
+        return quality > 1000 ? 1000 : quality;
+    }
+    return 1000;
+}
+
+// 원본 ETag `"a-b"` 에 코딩 이름을 붙여 압축본의 강한 검증자 `"a-b-gzip"` 을 만든다.
+std::string variantEtag(const std::string &source, ContentCoding coding) {
+    std::string_view suffix = coding == ContentCoding::kGzip ? "-gzip" : "-deflate";
+    std::string etag = source;
+    std::size_t insert = !etag.empty() && etag.back() == '"' ? etag.size() - 1 : etag.size();
+    etag.insert(insert, suffix.data(), suffix.size());
+    return etag;
+}
+
+/**
+ * compressFile
+ * 설명:
+ *   - 파일을 READ_CHUNK 씩 pread 해 압축기에 흘려 넣는다. 파일 전체를 메모리에 올리지 않는다.
+ * 출력:
+ *   - 성공 시 true. 읽는 도중 파일이 줄어들었거나 zlib 오류면 false
+ */
+bool compressFile(int fd, std::size_t size, ContentCoding coding, Compressor &compressor) {
+    if (!compressor.begin(coding)) {
+        return false;
+    }
+    char buffer[READ_CHUNK];
+    std::size_t done = 0;
+    while (done < size) {
+        std::size_t want = size - done < sizeof(buffer) ? size - done : sizeof(buffer);
+        ssize_t n = ::pread(fd, buffer, want, static_cast<off_t>(done));
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        if (!compressor.update(std::string_view(buffer, static_cast<std::size_t>(n)))) {
+            return false;
+        }
+        done += static_cast<std::size_t>(n);
+    }
+    return compressor.finish();
+}
+
+}  // namespace
+
+ContentCoding negotiateCoding(const HttpRequestView &request) {
+    const HeaderField *header = request.findHeader("accept-encoding");
+    if (header == nullptr) {
+        return ContentCoding::kIdentity;
+    }
+
+    // -1 은 목록에 없음. `*` 는 목록에 없는 코딩에만 적용한다.
+    int gzip = -1;
+    int deflate = -1;
+    int wildcard = -1;
+    std::string_view list = header->value;
+    while (!list.empty()) {
+        std::size_t comma = list.find(',');
+        std::string_view item = list.substr(0, comma);
+        list = comma == std::string_view::npos ? std::string_view() : list.substr(comma + 1);
+
+        std::size_t semi = item.find(';');
+        std::string_view name = trim(item.substr(0, semi));
+        int quality = semi == std::string_view::npos ? 1000 : parseQuality(item.substr(semi + 1));
+        if (equalsIgnoreCase(name, "gzip") || equalsIgnoreCase(name, "x-gzip")) {
+            gzip = quality;
+        } else if (equalsIgnoreCase(name, "deflate")) {
+            deflate = quality;
+        } else if (name == "*") {
+            wildcard = quality;
+        }
+    }
+    if (gzip < 0) {
+        gzip = wildcard;
+    }
+    if (deflate < 0) {
+        deflate = wildcard;
+    }
+    if (gzip <= 0 && deflate <= 0) {
+        return ContentCoding::kIdentity;
+    }
+    return gzip >= deflate ? ContentCoding::kGzip : ContentCoding::kDeflate;
+}
+
+std::string_view codingHeaders(ContentCoding coding) {
+    switch (coding) {
+        case ContentCoding::kGzip:
+            return "Content-Encoding: gzip\r\nVary: Accept-Encoding\r\n";
+        case ContentCoding::kDeflate:
+            return "Content-Encoding: deflate\r\nVary: Accept-Encoding\r\n";
+        default:
+            return "Vary: Accept-Encoding\r\n";
+    }
+}
+
+bool isCompressibleType(std::string_view content_type) {
+    if (content_type.compare(0, 5, "text/") == 0) {
+        return true;
+    }
+    return content_type == "application/json" || content_type == "image/svg+xml" ||
+           content_type == "application/wasm";
+}
+
+Compressor::Compressor(int level) : level_(level) {
+    std::memset(streams_, 0, sizeof(streams_));
+}
+
+Compressor::~Compressor() {
+    for (int i = 0; i < 2; ++i) {
+        if (ready_[i]) {
+            deflateEnd(&streams_[i]);
+        }
+    }
+}
+
+bool Compressor::begin(ContentCoding coding) {
+    int slot = coding == ContentCoding::kGzip ? 0 : 1;
+    z_stream &stream = streams_[slot];
+    if (!ready_[slot]) {
+        int bits = coding == ContentCoding::kGzip ? GZIP_WINDOW_BITS : WINDOW_BITS;
+        if (deflateInit2(&stream, level_, Z_DEFLATED, bits, MEMORY_LEVEL, Z_DEFAULT_STRATEGY) != Z_OK) {
+            return false;
+        }
+        ready_[slot] = true;
+    } else if (deflateReset(&stream) != Z_OK) {
+        return false;
+    }
+    active_ = &stream;
+    produced_ = 0;
+    return true;
+}
+
+/**
+ * Compressor::run
+ * 설명:
+ *   - input 을 모두 넘길 때까지 deflate 를 부르고, 출력 자리가 모자라면 버퍼를 두 배로 늘린다.
+ *   - Z_FINISH 면 스트림 끝(Z_STREAM_END)까지 돌린다.
+ */
+bool Compressor::run(std::string_view input, int flush) {
+    if (active_ == nullptr) {
+        return false;
+    }
+    z_stream &stream = *active_;
+    stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(input.data()));
+    stream.avail_in = static_cast<uInt>(input.size());
+    while (true) {
+        if (produced_ == output_.size()) {
+            // 첫 조각은 deflateBound 로 잡아 작은 본문이 한 번에 끝나게 한다.
+            std::size_t bound = deflateBound(&stream, static_cast<uLong>(input.size()));
+            output_.resize(output_.size() + (bound > output_.size() ? bound : output_.size()));
+        }
+        stream.next_out = reinterpret_cast<Bytef *>(&output_[produced_]);
+        stream.avail_out = static_cast<uInt>(output_.size() - produced_);
+        int result = deflate(&stream, flush);
+        produced_ = output_.size() - stream.avail_out;
+        if (result == Z_STREAM_END) {
+            active_ = nullptr;
+            return true;
+        }
+        if (result != Z_OK && result != Z_BUF_ERROR) {
+            active_ = nullptr;
+            return false;
+        }
+        if (flush != Z_FINISH && stream.avail_in == 0 && stream.avail_out != 0) {
+            return true;
+        }
+    }
+}
+
+bool Compressor::update(std::string_view input) {
+    return input.empty() || run(input, Z_NO_FLUSH);
+}
+
+bool Compressor::finish() {
+    return run(std::string_view(), Z_FINISH);
+}
+
+bool Compressor::compress(ContentCoding coding, std::initializer_list<std::string_view> parts) {
+    if (!begin(coding)) {
+        return false;
+    }
+    for (std::string_view part : parts) {
+        if (!update(part)) {
+            return false;
+        }
+    }
+    return finish();
+}
+
+CompressedCache::CompressedCache(std::size_t capacity, int level, ThreadPool *pool, CompletionQueue &completions,
+                                 WorkerMetrics &metrics)
+    : capacity_(capacity), level_(level), pool_(pool), completions_(completions), metrics_(metrics) {}
+
+const CompressedVariant *CompressedCache::find(std::string_view url_path, ContentCoding coding,
+                                               const FileInfo &file) {
+    if (coding == ContentCoding::kIdentity || file.size < MIN_COMPRESS_BYTES || file.size > MAX_SOURCE_BYTES) {
+        return nullptr;
+    }
+    key_.assign(url_path.data(), url_path.size());
+    key_.push_back(coding == ContentCoding::kGzip ? '\x01' : '\x02');
+
+    auto found = index_.find(key_);
+    if (found != index_.end()) {
+        Entry &entry = *found->second;
+        if (entry.source_etag == file.etag) {
+            if (!entry.ready) {
+                return nullptr;  // 압축 중
+            }
+            lru_.splice(lru_.begin(), lru_, found->second);
+            return &entry.variant;
+        }
+        // 파일이 바뀌었다. 옛 압축본을 버리고 다시 만든다.
+        evict(found->second);
+    }
+
+    lru_.push_front(Entry{key_, file.etag, CompressedVariant(), false});
+    index_.emplace(key_, lru_.begin());
+    bytes_ += cost(lru_.front());
+    evictOverflow(lru_.begin());
+
+    if (pool_ == nullptr) {
+        // 작업 스레드가 없으면 이 워커가 바로 압축한다. 파일당 한 번뿐이다.
+        Compressor compressor(level_);
+        bool ok = compressFile(file.file->fd(), file.size, coding, compressor);
+        auto body = std::make_shared<std::string>(compressor.output());
+        std::string key = key_;
+        complete(key, file.etag, coding, std::move(body), file.size, ok);
+        auto done = index_.find(key);
+        return done != index_.end() && done->second->ready ? &done->second->variant : nullptr;
+    }
+
+    // 작업 스레드가 쥐는 FileHandle 이 FD 를 살려 두므로 캐시에서 밀려나도 안전하게 읽는다.
+    pool_->submit([this, key = key_, etag = file.etag, handle = file.file, size = file.size, coding,
+                   level = level_]() {
+        Compressor compressor(level);
+        bool ok = compressFile(handle->fd(), size, coding, compressor);
+        auto body = std::make_shared<std::string>(compressor.output());
+        completions_.post([this, key, etag, coding, body, size, ok]() {
+            complete(key, etag, coding, body, size, ok);
+        });
+    });
+    return nullptr;
+}
+
+/**
+ * CompressedCache::complete
+ * 설명:
+ *   - 압축 결과를 대기 중인 항목에 채운다. 워커 스레드에서만 불린다.
+ *   - 그 사이 항목이 밀려났거나 파일이 바뀌어 다시 등록되었으면 결과를 버린다.
+ *   - 압축이 실패했거나 줄지 않았으면 compressed=false 로 남겨 원본을 보내고 다시 압축하지 않는다.
+ */
+void CompressedCache::complete(const std::string &key, const std::string &source_etag, ContentCoding coding,
+                               std::shared_ptr<std::string> body, std::size_t source_size, bool ok) {
+    auto found = index_.find(key);
+    if (found == index_.end() || found->second->ready || found->second->source_etag != source_etag) {
+        return;
+    }
+    Entry &entry = *found->second;
+    entry.ready = true;
+    WorkerMetrics::add(metrics_.precompressed, 1);
+    if (!ok || body->size() >= source_size || body->size() + cost(entry) > capacity_) {
+        return;
+    }
+    body->shrink_to_fit();
+    bytes_ -= cost(entry);
+    entry.variant.compressed = true;
+    entry.variant.etag = variantEtag(source_etag, coding);
+    entry.variant.body = std::move(body);
+    bytes_ += cost(entry);
+
+    lru_.splice(lru_.begin(), lru_, found->second);
+    evictOverflow(found->second);
+}
+
+// 항목이 한도에서 차지하는 몫. 본문은 압축본을 보관할 때만 생긴다.
+std::size_t CompressedCache::cost(const Entry &entry) {
+    return ENTRY_OVERHEAD + entry.key.size() + (entry.variant.body ? entry.variant.body->size() : 0);
+}
+
+/**
+ * CompressedCache::evictOverflow
+ * 설명:
+ *   - 한도를 넘는 동안 LRU 꼬리부터 버린다. 압축 중인 항목도 버리며, 그 결과는 complete 가 찾지 못해 버려진다.
+ *   - keep(방금 넣거나 맨 앞으로 옮긴 항목)은 남긴다.
+ */
+void CompressedCache::evictOverflow(EntryList::iterator keep) {
+    while (bytes_ > capacity_ && std::prev(lru_.end()) != keep) {
+        evict(std::prev(lru_.end()));
+    }
+}
+
+void CompressedCache::evict(EntryList::iterator it) {
+    bytes_ -= cost(*it);
+    index_.erase(it->key);
+    lru_.erase(it);
+}
@@ -0,0 +1,129 @@
+#include "connection_pool.hpp"
+
+/**
+ * [모듈] webserv-cpp17/src/connection_pool.cpp
+ * 설명:
+ *   - 슬랩 확장, 자유 목록 기반 슬롯 할당/반납, 세대 태그 핸들 검증을 구현한다.
+ * 버전: v1.24.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.9.0-connection-pool.md
+ *   - design/webserv-cpp17/v1.10.0-zero-alloc-responses.md
+ *   - design/webserv-cpp17/v1.11.0-io-uring-backend.md
+ *   - design/webserv-cpp17/v1.12.0-streaming-request-body.md
+ *   - design/webserv-cpp17/v1.16.0-reverse-proxy.md
+ *   - design/webserv-cpp17/v1.17.0-handler-offload.md
+ *   - design/webserv-cpp17/v1.18.0-coroutine-handlers.md
+ *   - design/webserv-cpp17/v1.21.0-access-log.md
+ *   - design/webserv-cpp17/v1.22.0-tls.md
+ *   - design/webserv-cpp17/v1.23.0-http2.md
+ *   - design/webserv-cpp17/v1.24.0-client-limits.md
+ * 변경 이력:
+ *   - v1.9.0: 연결 풀 추가
+ *   - v1.10.0: 반납 시 RETAINED_OUTPUT_CAPACITY 를 넘은 출력 버퍼 축소
+ *   - v1.11.0: 세대를 GENERATION_MASK(24비트) 안에서 돌리고 반납 시 ConnectionIo 초기화
+ *   - v1.12.0: 반납 시 RequestBody 초기화
+ *   - v1.16.0: 반납 시 ProxyLink 초기화(요청 헤더 버퍼 용량은 유지)
+ *   - v1.17.0: 반납 시 OffloadSlot 초기화(결과 본문 버퍼 용량은 유지)
+ *   - v1.18.0: 반납 시 코루틴 프레임 파괴(프레임 아레나 용량은 유지)
+ *   - v1.21.0: 반납 시 접근 로그 레코드의 요청 정보와 응답 시작 위치 초기화
+ *   - v1.22.0: 반납 시 TLS 스트림(SSL 객체) 해제
+ *   - v1.23.0: 반납 시 HTTP/2 세션을 되돌림(세션 메모리는 슬롯에 남김)
+ *   - v1.24.0: 반납 시 클라이언트 한도 표의 칸 번호 초기화
+ * 테스트:
+ *   - tests/test_webserv_connection_churn.sh
+ *   - tests/test_webserv_access_log.sh
+ *   - tests/test_webserv_tls.sh
+ *   - tests/test_webserv_http2.sh
+ *   - tests/test_webserv_client_limits.sh
+ */
+
+void ConnectionPool::grow() {
+    std::size_t base = capacity();
+    slabs_.emplace_back(new Slot[SLAB_SIZE]);
+    // 낮은 번호부터 꺼내지도록 역순으로 넣는다.
+    for (std::size_t i = SLAB_SIZE; i > 0; --i) {
+        free_.push_back(static_cast<std::uint32_t>(base + i - 1));
+    }
+}
+
+Connection &ConnectionPool::acquire(int fd) {
+    if (free_.empty()) {
+        grow();
+    }
+    std::uint32_t index = free_.back();
+    free_.pop_back();
+
+    Slot &slot = slotAt(index);
+    slot.live = true;
+    ++live_;
+    slot.conn.fd = fd;
+    slot.conn.handle = (static_cast<std::uint64_t>(slot.generation) << 32) | index;
+    slot.conn.timer.token = slot.conn.handle;
+    return slot.conn;
+}
+
+/**
+ * ConnectionPool::release
+ * 설명:
+ *   - 다음 연결이 바로 쓸 수 있도록 상태를 초기값으로 되돌린다. 버퍼/큐는 비우기만 하고 용량은 남긴다.
+ */
+void ConnectionPool::release(Connection &conn) {
+    auto index = static_cast<std::uint32_t>(conn.handle & 0xffffffffu);
+    Slot &slot = slotAt(index);
+    if (!slot.live || &slot.conn != &conn) {
+        return;
+    }
+
+    if (conn.input.capacity() > RETAINED_INPUT_CAPACITY) {
+        conn.input = InputBuffer();
+    } else {
+        conn.input.clear();
+    }
+    if (conn.output.capacity() > RETAINED_OUTPUT_CAPACITY) {
+        conn.output = OutputQueue();
+    } else {
+        conn.output.clear();
+    }
+    conn.parser.reset();
+    conn.in_flight.clear();
+    conn.fd = -1;
+    conn.should_close = false;
+    conn.interest = EVENT_READ;
+    conn.read_ready = false;
+    conn.peer_closed = false;
+    conn.reading_paused = false;
+    conn.timeout_phase = TimeoutLabel::kIdle;
+    conn.io = ConnectionIo();
+    conn.body = RequestBody();
+    conn.proxy.reset();
+    conn.offload.reset();
+    conn.co.reset();
+    conn.access.clearRequest();
+    conn.reply_mark = 0;
+    conn.tls.reset();
+    if (conn.http2) {
+        conn.http2->reset();
+    }
+    conn.client_slot = ClientLimiter::NO_SLOT;
+
+    // 세대 0 은 연결이 아닌 토큰용으로 남겨 둔다.
+    if (++slot.generation > GENERATION_MASK) {
+        slot.generation = 1;
+    }
+    conn.handle = 0;
+    slot.live = false;
+    --live_;
+    free_.push_back(index);
+}
+
+Connection *ConnectionPool::find(std::uint64_t handle) {
+    std::size_t index = static_cast<std::size_t>(handle & 0xffffffffu);
+    if (index >= capacity()) {
+        return nullptr;
+    }
+    Slot &slot = slotAt(index);
+    if (!slot.live || slot.generation != static_cast<std::uint32_t>(handle >> 32)) {
+        return nullptr;
+    }
+    return &slot.conn;
+}
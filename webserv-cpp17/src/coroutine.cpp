@@ -0,0 +1,90 @@
+#include "coroutine.hpp"
+
+/**
+ * [모듈] webserv-cpp17/src/coroutine.cpp
+ * 설명:
+ *   - 코루틴 프레임 아레나와 연결별 코루틴 상태 정리를 구현한다.
+ * 버전: v1.18.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.18.0-coroutine-handlers.md
+ * 변경 이력:
+ *   - v1.18.0: FrameArena, CoContext::reset 추가
+ * 테스트:
+ *   - tests/test_webserv_coroutine.sh
+ *   - tests/test_webserv_alloc_free.sh
+ */
+
+namespace {
+
+constexpr std::size_t ALIGN = alignof(std::max_align_t);
+
+constexpr std::size_t roundUp(std::size_t size) {
+    return (size + ALIGN - 1) / ALIGN * ALIGN;
+}
+
+// 문자열 용량이 limit 를 넘으면 놓고, 아니면 내용만 비운다.
+void clearRetained(std::string &text, std::size_t limit) {
+    if (text.capacity() > limit) {
+        std::string().swap(text);
+    } else {
+        text.clear();
+    }
+}
+
+}  // namespace
+
+/**
+ * FrameArena::allocate
+ * 설명:
+ *   - 남은 자리에서 size 바이트(max_align_t 배수로 올림)를 떼어 준다.
+ *   - 비어 있는데 모자라면 2의 거듭제곱으로 키워 새로 잡는다. 프레임이 살아 있으면 키우지 않고 nullptr 이다.
+ */
+void *FrameArena::allocate(std::size_t size) {
+    size = roundUp(size);
+    if (used_ + size > capacity_) {
+        if (used_ != 0) {
+            return nullptr;
+        }
+        std::size_t capacity = capacity_ == 0 ? INITIAL_BYTES : capacity_;
+        while (capacity < size) {
+            capacity *= 2;
+        }
+        storage_.reset(new std::max_align_t[capacity / sizeof(std::max_align_t)]);
+        capacity_ = capacity;
+    }
+    void *memory = reinterpret_cast<unsigned char *>(storage_.get()) + used_;
+    used_ += size;
+    return memory;
+}
+
+void FrameArena::shrink(std::size_t retained) {
+    used_ = 0;
+    if (capacity_ > retained) {
+        storage_.reset();
+        capacity_ = 0;
+    }
+}
+
+/**
+ * CoContext::reset
+ * 설명:
+ *   - 살아 있는 프레임을 부수고 아레나를 비운다. 다음 요청이 같은 아레나와 버퍼 용량을 그대로 쓴다.
+ *   - 본문을 되돌려 주는 핸들러(POST /upload/echo)가 키운 버퍼는 RETAINED_CAPACITY 를 넘으면 놓는다.
+ */
+void CoContext::reset() {
+    if (frame != nullptr) {
+        frame->~Coroutine();
+        frame = nullptr;
+    }
+    arena.shrink(RETAINED_CAPACITY);
+    clearRetained(target, RETAINED_CAPACITY);
+    clearRetained(body, RETAINED_CAPACITY);
+    clearRetained(upstream_body, RETAINED_CAPACITY);
+    slice = std::string_view();
+    body_end = false;
+    upstream_status = 0;
+    wait = CoWait::kNone;
+    ready = false;
+    status = 0;
+    coding = ContentCoding::kIdentity;
+}
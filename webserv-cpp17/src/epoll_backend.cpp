@@ -0,0 +1,90 @@
+#include "epoll_backend.hpp"
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+/**
+ * [모듈] webserv-cpp17/src/epoll_backend.cpp
+ * 설명:
+ *   - epoll 준비 통지 백엔드 구현. 논블로킹 수락, 엣지 트리거 등록, 쓰기 관심사 토글을 맡는다.
+ * 버전: v1.25.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.1.0-epoll-reactor.md
+ *   - design/webserv-cpp17/v1.5.0-output-queue.md
+ *   - design/webserv-cpp17/v1.11.0-io-uring-backend.md
+ *   - design/webserv-cpp17/v1.20.0-accept-path.md
+ *   - design/webserv-cpp17/v1.22.0-tls.md
+ *   - design/webserv-cpp17/v1.25.0-config-reload.md
+ * 변경 이력:
+ *   - v1.11.0: worker.cpp 의 accept/fcntl, loop_.add/modify/remove 호출을 옮김
+ *   - v1.20.0: accept + fcntl 두 번을 accept4(SOCK_NONBLOCK | SOCK_CLOEXEC) 한 번으로 바꿈
+ *   - v1.22.0: TLS 연결 recv/flush 위임, 핸드셰이크 쓰기 대기 관심사, 닫기 전 close_notify
+ *   - v1.25.0: unwatchListener: 리슨 FD 를 epoll 에서 제거
+ * 테스트:
+ *   - tests/test_webserv_epoll_many.sh
+ *   - tests/test_webserv_slow_reader.sh
+ *   - tests/test_webserv_accept.sh
+ *   - tests/test_webserv_tls.sh
+ *   - tests/test_webserv_reload.sh
+ */
+
+bool EpollBackend::watchListener(int listen_fd) {
+    return loop_.add(listen_fd, static_cast<std::uint64_t>(listen_fd), EVENT_READ);
+}
+
+bool EpollBackend::watchReadable(int fd) {
+    return loop_.add(fd, static_cast<std::uint64_t>(fd), EVENT_READ);
+}
+
+void EpollBackend::unwatchListener(int listen_fd) {
+    loop_.remove(listen_fd);
+}
+
+int EpollBackend::accept(int listen_fd) {
+    // 상대 주소는 쓰지 않으므로 받지 않는다. 논블로킹/close-on-exec 는 수락과 같은 시스템 호출에서 건다.
+    return ::accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+}
+
+bool EpollBackend::addConnection(Connection &conn) {
+    return loop_.add(conn.fd, conn.handle, EVENT_READ);
+}
+
+ssize_t EpollBackend::recv(Connection &conn, char *destination, std::size_t capacity) {
+    if (conn.tls.active()) {
+        return conn.tls.read(destination, capacity);
+    }
+    return ::recv(conn.fd, destination, capacity, 0);
+}
+
+FlushResult EpollBackend::flush(Connection &conn, std::size_t &sent_out) {
+    if (conn.tls.active()) {
+        if (!tls_scratch_) {
+            tls_scratch_.reset(new char[TlsStream::RECORD_BYTES]);
+        }
+        return conn.tls.flush(conn.output, tls_scratch_.get(), sent_out);
+    }
+    return conn.output.flush(conn.fd, sent_out);
+}
+
+bool EpollBackend::updateInterest(Connection &conn) {
+    bool writing = !conn.output.empty() || conn.tls.wantsWrite();
+    std::uint32_t wanted = writing ? (EVENT_READ | EVENT_WRITE) : EVENT_READ;
+    if (wanted == conn.interest) {
+        return true;
+    }
+    if (!loop_.modify(conn.fd, conn.handle, wanted)) {
+        return false;
+    }
+    conn.interest = wanted;
+    return true;
+}
+
+void EpollBackend::closeConnection(Connection &conn) {
+    conn.tls.shutdown();
+    loop_.remove(conn.fd);
+    ::close(conn.fd);
+}
+
+int EpollBackend::wait(std::vector<IoEvent> &out, int timeout_ms) {
+    return loop_.wait(out, timeout_ms);
+}
@@ -0,0 +1,88 @@
+#include "event_loop.hpp"
+
+#include <unistd.h>
+
+#include <cerrno>
+
+/**
+ * [모듈] webserv-cpp17/src/event_loop.cpp
+ * 설명:
+ *   - epoll_create1/epoll_ctl/epoll_wait 를 감싼 엣지 트리거 리액터 구현.
+ * 버전: v1.1.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.1.0-epoll-reactor.md
+ * 변경 이력:
+ *   - v1.1.0: select 루프를 대체하는 epoll 리액터 추가
+ * 테스트:
+ *   - tests/test_webserv_epoll_many.sh
+ */
+
+namespace {
+
+std::uint32_t toEpollMask(std::uint32_t interest) {
+    std::uint32_t mask = EPOLLET | EPOLLRDHUP;
+    if (interest & EVENT_READ) {
+        mask |= EPOLLIN;
+    }
+    if (interest & EVENT_WRITE) {
+        mask |= EPOLLOUT;
+    }
+    return mask;
+}
+
+std::uint32_t fromEpollMask(std::uint32_t mask) {
+    std::uint32_t events = 0;
+    // 원격 종료(RDHUP)도 읽기 이벤트로 올려 recv 가 0 을 돌려주도록 한다.
+    if (mask & (EPOLLIN | EPOLLRDHUP)) {
+        events |= EVENT_READ;
+    }
+    if (mask & EPOLLOUT) {
+        events |= EVENT_WRITE;
+    }
+    if (mask & (EPOLLERR | EPOLLHUP)) {
+        events |= EVENT_ERROR;
+    }
+    return events;
+}
+
+}  // namespace
+
+EventLoop::EventLoop(std::size_t max_events)
+    : epoll_fd_(::epoll_create1(EPOLL_CLOEXEC)), ready_(max_events == 0 ? 1 : max_events) {}
+
+EventLoop::~EventLoop() {
+    if (epoll_fd_ >= 0) {
+        ::close(epoll_fd_);
+    }
+}
+
+bool EventLoop::add(int fd, std::uint64_t token, std::uint32_t interest) {
+    epoll_event ev{};
+    ev.events = toEpollMask(interest);
+    ev.data.u64 = token;
+    return ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev) == 0;
+}
+
+bool EventLoop::modify(int fd, std::uint64_t token, std::uint32_t interest) {
+    epoll_event ev{};
+    ev.events = toEpollMask(interest);
+    ev.data.u64 = token;
+    return ::epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, fd, &ev) == 0;
+}
+
+void EventLoop::remove(int fd) {
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+}
+
+int EventLoop::wait(std::vector<IoEvent> &out, int timeout_ms) {
+    out.clear();
+    int ready = ::epoll_wait(epoll_fd_, ready_.data(), static_cast<int>(ready_.size()), timeout_ms);
+    if (ready < 0) {
+        return errno == EINTR ? 0 : -1;
+    }
+    for (int i = 0; i < ready; ++i) {
+        out.push_back(IoEvent{ready_[static_cast<std::size_t>(i)].data.u64,
+                              fromEpollMask(ready_[static_cast<std::size_t>(i)].events)});
+    }
+    return ready;
+}
@@ -0,0 +1,254 @@
+#include "file_cache.hpp"
+
+#include <fcntl.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+
+/**
+ * [모듈] webserv-cpp17/src/file_cache.cpp
+ * 설명:
+ *   - URL 경로 해석, 정적 파일 열기/메타데이터 계산, LRU 보관, inotify 기반 무효화를 구현한다.
+ * 버전: v1.10.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.6.0-static-files.md
+ *   - design/webserv-cpp17/v1.10.0-zero-alloc-responses.md
+ * 변경 이력:
+ *   - v1.6.0: 정적 파일 FD/메타데이터 캐시 추가
+ *   - v1.10.0: 조회용 파일 시스템 경로를 멤버 버퍼에 만들어 캐시 적중 시 할당 제거
+ * 테스트:
+ *   - tests/test_webserv_static_files.sh
+ *   - tests/test_webserv_alloc_free.sh
+ */
+
+namespace {
+
+// 캐시된 파일의 내용/이름이 바뀌는 모든 경우. IN_ATTRIB 는 교체(rename) 로 링크 수가 바뀔 때도 온다.
+constexpr std::uint32_t WATCH_MASK = IN_MODIFY | IN_ATTRIB | IN_CLOSE_WRITE | IN_CREATE | IN_DELETE |
+                                     IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF;
+
+std::string_view contentTypeFor(std::string_view path) {
+    std::size_t dot = path.rfind('.');
+    std::size_t slash = path.rfind('/');
+    if (dot == std::string_view::npos || (slash != std::string_view::npos && dot < slash)) {
+        return "application/octet-stream";
+    }
+    std::string_view ext = path.substr(dot + 1);
+    if (ext == "html" || ext == "htm") return "text/html; charset=utf-8";
+    if (ext == "css") return "text/css; charset=utf-8";
+    if (ext == "js" || ext == "mjs") return "text/javascript; charset=utf-8";
+    if (ext == "json") return "application/json";
+    if (ext == "txt") return "text/plain; charset=utf-8";
+    if (ext == "svg") return "image/svg+xml";
+    if (ext == "png") return "image/png";
+    if (ext == "jpg" || ext == "jpeg") return "image/jpeg";
+    if (ext == "gif") return "image/gif";
+    if (ext == "webp") return "image/webp";
+    if (ext == "ico") return "image/x-icon";
+    if (ext == "wasm") return "application/wasm";
+    if (ext == "pdf") return "application/pdf";
+    return "application/octet-stream";
+}
+
+std::string parentDirectory(const std::string &fs_path) {
+    std::size_t slash = fs_path.rfind('/');
+    return slash == std::string::npos ? std::string(".") : fs_path.substr(0, slash);
+}
+
+}  // namespace
+
+FileCache::FileCache(std::string root, std::size_t capacity)
+    : root_(std::move(root)), capacity_(capacity), notify_fd_(-1) {
+    while (root_.size() > 1 && root_.back() == '/') {
+        root_.pop_back();
+    }
+}
+
+FileCache::~FileCache() {
+    if (notify_fd_ >= 0) {
+        ::close(notify_fd_);
+    }
+}
+
+bool FileCache::start() {
+    notify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    return notify_fd_ >= 0;
+}
+
+/**
+ * FileCache::resolve
+ * 설명:
+ *   - 쿼리 문자열을 떼고, `.`/`..` 세그먼트나 NUL 이 있는 경로는 거부한 뒤 문서 루트에 붙인다.
+ *   - 퍼센트 인코딩은 해석하지 않는다(인코딩된 `..` 도 그대로 파일명으로 취급되어 루트를 벗어나지 않는다).
+ */
+bool FileCache::resolve(std::string_view url_path, std::string &fs_path) const {
+    std::size_t query = url_path.find('?');
+    if (query != std::string_view::npos) {
+        url_path = url_path.substr(0, query);
+    }
+    if (url_path.empty() || url_path.front() != '/') {
+        return false;
+    }
+
+    std::size_t pos = 1;
+    while (pos <= url_path.size()) {
+        std::size_t next = url_path.find('/', pos);
+        if (next == std::string_view::npos) {
+            next = url_path.size();
+        }
+        std::string_view segment = url_path.substr(pos, next - pos);
+        if (segment == "." || segment == ".." || segment.find('\0') != std::string_view::npos) {
+            return false;
+        }
+        pos = next + 1;
+    }
+
+    fs_path.assign(root_);
+    fs_path.append(url_path.data(), url_path.size());
+    if (fs_path.back() == '/') {
+        fs_path += "index.html";
+    }
+    return true;
+}
+
+bool FileCache::openFile(const std::string &fs_path, FileInfo &info) const {
+    int fd = ::open(fs_path.c_str(), O_RDONLY | O_CLOEXEC | O_NONBLOCK);
+    if (fd < 0) {
+        return false;
+    }
+    auto handle = std::make_shared<const FileHandle>(fd);
+
+    struct stat st;
+    if (::fstat(fd, &st) < 0 || !S_ISREG(st.st_mode)) {
+        return false;
+    }
+
+    // 크기와 수정 시각(ns)으로 만든 검증자. 내용 해시보다 약하지만 파일을 읽지 않고 계산할 수 있다.
+    char etag[64];
+    std::snprintf(etag, sizeof(etag), "\"%llx-%llx\"", static_cast<unsigned long long>(st.st_size),
+                  static_cast<unsigned long long>(st.st_mtim.tv_sec) * 1000000000ull +
+                      static_cast<unsigned long long>(st.st_mtim.tv_nsec));
+
+    info.file = std::move(handle);
+    info.size = static_cast<std::size_t>(st.st_size);
+    info.etag = etag;
+    info.content_type = contentTypeFor(fs_path);
+    return true;
+}
+
+int FileCache::watchDirectory(const std::string &fs_path) {
+    std::string directory = parentDirectory(fs_path);
+    // 같은 디렉터리(아이노드)는 inotify 가 같은 watch 디스크립터를 돌려준다.
+    int watch = inotify_add_watch(notify_fd_, directory.c_str(), WATCH_MASK);
+    if (watch < 0) {
+        return -1;
+    }
+    auto &slot = watches_[watch];
+    if (slot.second == 0) {
+        slot.first = std::move(directory);
+    }
+    ++slot.second;
+    return watch;
+}
+
+const FileInfo *FileCache::lookup(std::string_view url_path) {
+    std::string &fs_path = path_;
+    if (!resolve(url_path, fs_path)) {
+        return nullptr;
+    }
+
+    auto found = index_.find(fs_path);
+    if (found != index_.end()) {
+        lru_.splice(lru_.begin(), lru_, found->second);
+        return &found->second->info;
+    }
+
+    FileInfo info;
+    if (!openFile(fs_path, info)) {
+        return nullptr;
+    }
+
+    // 감시를 걸 수 없으면 무효화를 보장할 수 없으므로 캐시하지 않고 이번 요청에만 쓴다.
+    int watch = (capacity_ > 0 && notify_fd_ >= 0) ? watchDirectory(fs_path) : -1;
+    if (watch < 0) {
+        scratch_ = std::move(info);
+        return &scratch_;
+    }
+
+    if (index_.size() >= capacity_) {
+        evict(std::prev(lru_.end()));
+    }
+    lru_.push_front(Entry{fs_path, std::move(info), watch});
+    index_.emplace(fs_path, lru_.begin());
+    return &lru_.front().info;
+}
+
+void FileCache::evict(EntryList::iterator it) {
+    auto watch = watches_.find(it->watch);
+    if (watch != watches_.end() && --watch->second.second == 0) {
+        inotify_rm_watch(notify_fd_, watch->first);
+        watches_.erase(watch);
+    }
+    index_.erase(it->path);
+    lru_.erase(it);
+}
+
+void FileCache::invalidate(const std::string &fs_path) {
+    auto found = index_.find(fs_path);
+    if (found != index_.end()) {
+        evict(found->second);
+    }
+}
+
+void FileCache::invalidateDirectory(int watch) {
+    for (auto it = lru_.begin(); it != lru_.end();) {
+        auto current = it++;
+        if (current->watch == watch) {
+            evict(current);
+        }
+    }
+    watches_.erase(watch);
+}
+
+void FileCache::handleNotifications() {
+    alignas(inotify_event) char buffer[8192];
+    while (true) {
+        ssize_t length = ::read(notify_fd_, buffer, sizeof(buffer));
+        if (length < 0 && errno == EINTR) {
+            continue;
+        }
+        if (length <= 0) {
+            return;
+        }
+
+        for (ssize_t offset = 0; offset < length;) {
+            const auto *event = reinterpret_cast<const inotify_event *>(buffer + offset);
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                // 이벤트가 유실되었으므로 어떤 항목이 바뀌었는지 알 수 없다. 전부 버린다.
+                while (!lru_.empty()) {
+                    evict(lru_.begin());
+                }
+                continue;
+            }
+            if (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)) {
+                // evict() 가 직접 해제한 watch 의 IN_IGNORED 는 이미 watches_ 에서 빠져 있어 건너뛴다.
+                if (watches_.count(event->wd) != 0) {
+                    invalidateDirectory(event->wd);
+                }
+                continue;
+            }
+            auto watch = watches_.find(event->wd);
+            if (watch == watches_.end() || event->len == 0) {
+                continue;
+            }
+            invalidate(watch->second.first + "/" + event->name);
+        }
+    }
+}
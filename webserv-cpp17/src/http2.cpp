@@ -0,0 +1,1425 @@
+#include "http2.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "proxy.hpp"
+
+/**
+ * [모듈] webserv-cpp17/src/http2.cpp
+ * 설명:
+ *   - HPACK 정적/동적 테이블, 정수/허프만 문자열 부호화, 헤더 블록 복호화와 응답 헤더 부호화를 구현한다.
+ *   - HTTP/2 프레임 해석(연결 관리 프레임, 요청 HEADERS/DATA), 흐름 제어, 응답 HEADERS/DATA 송신을 구현한다.
+ * 버전: v1.23.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.23.0-http2.md
+ * 변경 이력:
+ *   - v1.23.0: HPACK 부호화/복호화와 Http2Session 추가
+ * 테스트:
+ *   - tests/test_webserv_http2.sh
+ */
+
+namespace {
+
+// 프레임 종류(RFC 9113 6).
+constexpr std::uint8_t FRAME_DATA = 0x0;
+constexpr std::uint8_t FRAME_HEADERS = 0x1;
+constexpr std::uint8_t FRAME_PRIORITY = 0x2;
+constexpr std::uint8_t FRAME_RST_STREAM = 0x3;
+constexpr std::uint8_t FRAME_SETTINGS = 0x4;
+constexpr std::uint8_t FRAME_PUSH_PROMISE = 0x5;
+constexpr std::uint8_t FRAME_PING = 0x6;
+constexpr std::uint8_t FRAME_GOAWAY = 0x7;
+constexpr std::uint8_t FRAME_WINDOW_UPDATE = 0x8;
+constexpr std::uint8_t FRAME_CONTINUATION = 0x9;
+
+constexpr std::uint8_t FLAG_END_STREAM = 0x1;
+constexpr std::uint8_t FLAG_ACK = 0x1;
+constexpr std::uint8_t FLAG_END_HEADERS = 0x4;
+constexpr std::uint8_t FLAG_PADDED = 0x8;
+constexpr std::uint8_t FLAG_PRIORITY = 0x20;
+
+constexpr std::uint16_t SETTINGS_HEADER_TABLE_SIZE = 0x1;
+constexpr std::uint16_t SETTINGS_ENABLE_PUSH = 0x2;
+constexpr std::uint16_t SETTINGS_MAX_CONCURRENT_STREAMS = 0x3;
+constexpr std::uint16_t SETTINGS_INITIAL_WINDOW_SIZE = 0x4;
+constexpr std::uint16_t SETTINGS_MAX_FRAME_SIZE = 0x5;
+constexpr std::uint16_t SETTINGS_MAX_HEADER_LIST_SIZE = 0x6;
+
+constexpr std::size_t FRAME_HEADER = 9;
+constexpr std::int64_t MAX_WINDOW = 0x7fffffff;
+constexpr std::int64_t DEFAULT_WINDOW = 65535;
+constexpr std::size_t MAX_FRAME_LIMIT = 16777215;
+
+struct StaticEntry {
+    std::string_view name;
+    std::string_view value;
+};
+
+// HPACK 정적 테이블(RFC 7541 부록 A). 색인은 1부터다.
+constexpr StaticEntry STATIC_TABLE[] = {
+    {":authority", ""},
+    {":method", "GET"},
+    {":method", "POST"},
+    {":path", "/"},
+    {":path", "/index.html"},
+    {":scheme", "http"},
+    {":scheme", "https"},
+    {":status", "200"},
+    {":status", "204"},
+    {":status", "206"},
+    {":status", "304"},
+    {":status", "400"},
+    {":status", "404"},
+    {":status", "500"},
+    {"accept-charset", ""},
+    {"accept-encoding", "gzip, deflate"},
+    {"accept-language", ""},
+    {"accept-ranges", ""},
+    {"accept", ""},
+    {"access-control-allow-origin", ""},
+    {"age", ""},
+    {"allow", ""},
+    {"authorization", ""},
+    {"cache-control", ""},
+    {"content-disposition", ""},
+    {"content-encoding", ""},
+    {"content-language", ""},
+    {"content-length", ""},
+    {"content-location", ""},
+    {"content-range", ""},
+    {"content-type", ""},
+    {"cookie", ""},
+    {"date", ""},
+    {"etag", ""},
+    {"expect", ""},
+    {"expires", ""},
+    {"from", ""},
+    {"host", ""},
+    {"if-match", ""},
+    {"if-modified-since", ""},
+    {"if-none-match", ""},
+    {"if-range", ""},
+    {"if-unmodified-since", ""},
+    {"last-modified", ""},
+    {"link", ""},
+    {"location", ""},
+    {"max-forwards", ""},
+    {"proxy-authenticate", ""},
+    {"proxy-authorization", ""},
+    {"range", ""},
+    {"referer", ""},
+    {"refresh", ""},
+    {"retry-after", ""},
+    {"server", ""},
+    {"set-cookie", ""},
+    {"strict-transport-security", ""},
+    {"transfer-encoding", ""},
+    {"user-agent", ""},
+    {"vary", ""},
+    {"via", ""},
+    {"www-authenticate", ""},
+};
+
+constexpr std::size_t STATIC_COUNT = sizeof(STATIC_TABLE) / sizeof(STATIC_TABLE[0]);
+
+// 허프만 부호(RFC 7541 부록 B). 색인이 기호(256 은 EOS)이고 부호는 오른쪽 정렬이다.
+constexpr std::uint32_t HUFFMAN_CODES[257] = {
+    0x1ff8, 0x7fffd8, 0xfffffe2, 0xfffffe3, 0xfffffe4, 0xfffffe5, 0xfffffe6, 0xfffffe7,
+    0xfffffe8, 0xffffea, 0x3ffffffc, 0xfffffe9, 0xfffffea, 0x3ffffffd, 0xfffffeb, 0xfffffec,
+    0xfffffed, 0xfffffee, 0xfffffef, 0xffffff0, 0xffffff1, 0xffffff2, 0x3ffffffe, 0xffffff3,
+    0xffffff4, 0xffffff5, 0xffffff6, 0xffffff7, 0xffffff8, 0xffffff9, 0xffffffa, 0xffffffb,
+    0x14, 0x3f8, 0x3f9, 0xffa, 0x1ff9, 0x15, 0xf8, 0x7fa,
+    0x3fa, 0x3fb, 0xf9, 0x7fb, 0xfa, 0x16, 0x17, 0x18,
+    0x0, 0x1, 0x2, 0x19, 0x1a, 0x1b, 0x1c, 0x1d,
+    0x1e, 0x1f, 0x5c, 0xfb, 0x7ffc, 0x20, 0xffb, 0x3fc,
+    0x1ffa, 0x21, 0x5d, 0x5e, 0x5f, 0x60, 0x61, 0x62,
+    0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6a,
+    0x6b, 0x6c, 0x6d, 0x6e, 0x6f, 0x70, 0x71, 0x72,
+    0xfc, 0x73, 0xfd, 0x1ffb, 0x7fff0, 0x1ffc, 0x3ffc, 0x22,
+    0x7ffd, 0x3, 0x23, 0x4, 0x24, 0x5, 0x25, 0x26,
+    0x27, 0x6, 0x74, 0x75, 0x28, 0x29, 0x2a, 0x7,
+    0x2b, 0x76, 0x2c, 0x8, 0x9, 0x2d, 0x77, 0x78,
+    0x79, 0x7a, 0x7b, 0x7ffe, 0x7fc, 0x3ffd, 0x1ffd, 0xffffffc,
+    0xfffe6, 0x3fffd2, 0xfffe7, 0xfffe8, 0x3fffd3, 0x3fffd4, 0x3fffd5, 0x7fffd9,
+    0x3fffd6, 0x7fffda, 0x7fffdb, 0x7fffdc, 0x7fffdd, 0x7fffde, 0xffffeb, 0x7fffdf,
+    0xffffec, 0xffffed, 0x3fffd7, 0x7fffe0, 0xffffee, 0x7fffe1, 0x7fffe2, 0x7fffe3,
+    0x7fffe4, 0x1fffdc, 0x3fffd8, 0x7fffe5, 0x3fffd9, 0x7fffe6, 0x7fffe7, 0xffffef,
+    0x3fffda, 0x1fffdd, 0xfffe9, 0x3fffdb, 0x3fffdc, 0x7fffe8, 0x7fffe9, 0x1fffde,
+    0x7fffea, 0x3fffdd, 0x3fffde, 0xfffff0, 0x1fffdf, 0x3fffdf, 0x7fffeb, 0x7fffec,
+    0x1fffe0, 0x1fffe1, 0x3fffe0, 0x1fffe2, 0x7fffed, 0x3fffe1, 0x7fffee, 0x7fffef,
+    0xfffea, 0x3fffe2, 0x3fffe3, 0x3fffe4, 0x7ffff0, 0x3fffe5, 0x3fffe6, 0x7ffff1,
+    0x3ffffe0, 0x3ffffe1, 0xfffeb, 0x7fff1, 0x3fffe7, 0x7ffff2, 0x3fffe8, 0x1ffffec,
+    0x3ffffe2, 0x3ffffe3, 0x3ffffe4, 0x7ffffde, 0x7ffffdf, 0x3ffffe5, 0xfffff1, 0x1ffffed,
+    0x7fff2, 0x1fffe3, 0x3ffffe6, 0x7ffffe0, 0x7ffffe1, 0x3ffffe7, 0x7ffffe2, 0xfffff2,
+    0x1fffe4, 0x1fffe5, 0x3ffffe8, 0x3ffffe9, 0xffffffd, 0x7ffffe3, 0x7ffffe4, 0x7ffffe5,
+    0xfffec, 0xfffff3, 0xfffed, 0x1fffe6, 0x3fffe9, 0x1fffe7, 0x1fffe8, 0x7ffff3,
+    0x3fffea, 0x3fffeb, 0x1ffffee, 0x1ffffef, 0xfffff4, 0xfffff5, 0x3ffffea, 0x7ffff4,
+    0x3ffffeb, 0x7ffffe6, 0x3ffffec, 0x3ffffed, 0x7ffffe7, 0x7ffffe8, 0x7ffffe9, 0x7ffffea,
+    0x7ffffeb, 0xffffffe, 0x7ffffec, 0x7ffffed, 0x7ffffee, 0x7ffffef, 0x7fffff0, 0x3ffffee,
+    0x3fffffff,
+};
+constexpr std::uint8_t HUFFMAN_BITS[257] = {
+    13, 23, 28, 28, 28, 28, 28, 28, 28, 24, 30, 28, 28, 30, 28, 28,
+    28, 28, 28, 28, 28, 28, 30, 28, 28, 28, 28, 28, 28, 28, 28, 28,
+    6, 10, 10, 12, 13, 6, 8, 11, 10, 10, 8, 11, 8, 6, 6, 6,
+    5, 5, 5, 6, 6, 6, 6, 6, 6, 6, 7, 8, 15, 6, 12, 10,
+    13, 6, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+    7, 7, 7, 7, 7, 7, 7, 7, 8, 7, 8, 13, 19, 13, 14, 6,
+    15, 5, 6, 5, 6, 5, 6, 6, 6, 5, 7, 7, 6, 6, 6, 5,
+    6, 7, 6, 5, 5, 6, 7, 7, 7, 7, 7, 15, 11, 14, 13, 28,
+    20, 22, 20, 20, 22, 22, 22, 23, 22, 23, 23, 23, 23, 23, 24, 23,
+    24, 24, 22, 23, 24, 23, 23, 23, 23, 21, 22, 23, 22, 23, 23, 24,
+    22, 21, 20, 22, 22, 23, 23, 21, 23, 22, 22, 24, 21, 22, 23, 23,
+    21, 21, 22, 21, 23, 22, 23, 23, 20, 22, 22, 22, 23, 22, 22, 23,
+    26, 26, 20, 19, 22, 23, 22, 25, 26, 26, 26, 27, 27, 26, 24, 25,
+    19, 21, 26, 27, 27, 26, 27, 24, 21, 21, 26, 26, 28, 27, 27, 27,
+    20, 24, 20, 21, 22, 21, 21, 23, 22, 22, 25, 25, 24, 24, 26, 23,
+    26, 27, 26, 26, 27, 27, 27, 27, 27, 28, 27, 27, 27, 27, 27, 26,
+    30,
+};
+
+/**
+ * HuffmanTree
+ * 설명:
+ *   - 허프만 부호를 비트 하나씩 따라가는 이진 트리. 잎은 -(기호 + 1), 내부 노드는 양수 색인이다.
+ *     부호가 완전(prefix-free, 빈 가지 없음)하므로 내부 노드는 정확히 256개다.
+ */
+struct HuffmanTree {
+    std::int16_t child[256][2] = {};
+
+    HuffmanTree() {
+        std::size_t nodes = 1;
+        for (int symbol = 0; symbol < 257; ++symbol) {
+            std::uint32_t code = HUFFMAN_CODES[symbol];
+            int bits = HUFFMAN_BITS[symbol];
+            std::size_t node = 0;
+            for (int bit = bits - 1; bit > 0; --bit) {
+                int branch = (code >> bit) & 1;
+                if (child[node][branch] == 0) {
+                    child[node][branch] = static_cast<std::int16_t>(nodes++);
+                }
+                node = static_cast<std::size_t>(child[node][branch]);
+            }
+            child[node][code & 1] = static_cast<std::int16_t>(-(symbol + 1));
+        }
+    }
+};
+
+const HuffmanTree &huffmanTree() {
+    static const HuffmanTree tree;
+    return tree;
+}
+
+// 허프만 문자열을 풀어 out 에 붙인다. EOS 기호, 7비트를 넘거나 1 이 아닌 채움 비트는 오류다(RFC 7541 5.2).
+bool huffmanDecode(const unsigned char *data, std::size_t size, std::string &out) {
+    const HuffmanTree &tree = huffmanTree();
+    std::size_t node = 0;
+    int depth = 0;
+    bool ones = true;
+    for (std::size_t i = 0; i < size; ++i) {
+        for (int bit = 7; bit >= 0; --bit) {
+            int branch = (data[i] >> bit) & 1;
+            std::int16_t next = tree.child[node][branch];
+            ++depth;
+            ones = ones && branch == 1;
+            if (next < 0) {
+                int symbol = -next - 1;
+                if (symbol == 256) {
+                    return false;
+                }
+                out.push_back(static_cast<char>(symbol));
+                node = 0;
+                depth = 0;
+                ones = true;
+            } else {
+                node = static_cast<std::size_t>(next);
+            }
+        }
+    }
+    return depth <= 7 && ones;
+}
+
+std::size_t huffmanLength(std::string_view text) {
+    std::size_t bits = 0;
+    for (char c : text) {
+        bits += HUFFMAN_BITS[static_cast<unsigned char>(c)];
+    }
+    return (bits + 7) / 8;
+}
+
+void huffmanEncode(std::string_view text, std::string &out) {
+    std::uint64_t pending = 0;
+    int bits = 0;
+    for (char c : text) {
+        auto symbol = static_cast<unsigned char>(c);
+        pending = (pending << HUFFMAN_BITS[symbol]) | HUFFMAN_CODES[symbol];
+        bits += HUFFMAN_BITS[symbol];
+        while (bits >= 8) {
+            bits -= 8;
+            out.push_back(static_cast<char>((pending >> bits) & 0xff));
+        }
+        pending &= (std::uint64_t{1} << bits) - 1;
+    }
+    if (bits > 0) {
+        // 남은 비트는 EOS 부호의 앞부분(모두 1)으로 채운다.
+        out.push_back(static_cast<char>((pending << (8 - bits)) | ((1u << (8 - bits)) - 1)));
+    }
+}
+
+// HPACK 정수(RFC 7541 5.1). first 는 접두 비트 앞의 플래그 비트다.
+void encodeInteger(std::string &out, std::uint8_t first, int prefix, std::size_t value) {
+    std::size_t limit = (std::size_t{1} << prefix) - 1;
+    if (value < limit) {
+        out.push_back(static_cast<char>(first | value));
+        return;
+    }
+    out.push_back(static_cast<char>(first | limit));
+    value -= limit;
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+bool decodeInteger(const unsigned char *data, std::size_t size, std::size_t &pos, int prefix, std::size_t &value) {
+    std::size_t limit = (std::size_t{1} << prefix) - 1;
+    value = data[pos++] & limit;
+    if (value < limit) {
+        return true;
+    }
+    for (int shift = 0; shift <= 28; shift += 7) {
+        if (pos >= size) {
+            return false;
+        }
+        std::uint8_t byte = data[pos++];
+        value += static_cast<std::size_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    // 2^35 을 넘는 정수는 헤더 블록 안에서 의미가 없다.
+    return false;
+}
+
+void encodeString(std::string &out, std::string_view text) {
+    std::size_t huffman = huffmanLength(text);
+    if (huffman < text.size()) {
+        encodeInteger(out, 0x80, 7, huffman);
+        huffmanEncode(text, out);
+        return;
+    }
+    encodeInteger(out, 0x00, 7, text.size());
+    out.append(text);
+}
+
+bool decodeString(const unsigned char *data, std::size_t size, std::size_t &pos, std::string &out) {
+    if (pos >= size) {
+        return false;
+    }
+    bool huffman = (data[pos] & 0x80) != 0;
+    std::size_t length = 0;
+    if (!decodeInteger(data, size, pos, 7, length) || length > size - pos) {
+        return false;
+    }
+    const unsigned char *text = data + pos;
+    pos += length;
+    if (huffman) {
+        return huffmanDecode(text, length, out);
+    }
+    out.append(reinterpret_cast<const char *>(text), length);
+    return true;
+}
+
+std::size_t staticNameIndex(std::string_view name) {
+    for (std::size_t i = 0; i < STATIC_COUNT; ++i) {
+        if (STATIC_TABLE[i].name == name) {
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+// 값이 응답마다 반복되어 동적 테이블에 넣을 가치가 있는 응답 헤더.
+bool worthIndexing(std::string_view name) {
+    return name == "content-type" || name == "date" || name == "vary" || name == "content-encoding" ||
+           name == "cache-control" || name == "server" || name == "accept-ranges";
+}
+
+// HTTP/2 에서 쓰면 안 되는 연결 헤더(RFC 9113 8.2.2).
+bool connectionSpecific(std::string_view name) {
+    return name == "connection" || name == "keep-alive" || name == "proxy-connection" ||
+           name == "transfer-encoding" || name == "upgrade";
+}
+
+std::uint32_t readU32(const char *p) {
+    auto *u = reinterpret_cast<const unsigned char *>(p);
+    return (std::uint32_t{u[0]} << 24) | (std::uint32_t{u[1]} << 16) | (std::uint32_t{u[2]} << 8) | u[3];
+}
+
+void writeU32(char *p, std::uint32_t value) {
+    p[0] = static_cast<char>(value >> 24);
+    p[1] = static_cast<char>(value >> 16);
+    p[2] = static_cast<char>(value >> 8);
+    p[3] = static_cast<char>(value);
+}
+
+void writeFrameHeader(char *p, std::size_t length, std::uint8_t type, std::uint8_t flags, std::uint32_t id) {
+    p[0] = static_cast<char>(length >> 16);
+    p[1] = static_cast<char>(length >> 8);
+    p[2] = static_cast<char>(length);
+    p[3] = static_cast<char>(type);
+    p[4] = static_cast<char>(flags);
+    writeU32(p + 5, id);
+}
+
+// 본문이 payload 인 프레임 하나를 출력 큐에 쓴다.
+void writeFrame(OutputQueue &output, std::uint8_t type, std::uint8_t flags, std::uint32_t id,
+                std::string_view payload) {
+    char *p = output.prepare(FRAME_HEADER + payload.size());
+    writeFrameHeader(p, payload.size(), type, flags, id);
+    std::memcpy(p + FRAME_HEADER, payload.data(), payload.size());
+    output.commit(FRAME_HEADER + payload.size());
+}
+
+void writeU32Frame(OutputQueue &output, std::uint8_t type, std::uint32_t id, std::uint32_t value) {
+    char payload[4];
+    writeU32(payload, value);
+    writeFrame(output, type, 0, id, std::string_view(payload, sizeof(payload)));
+}
+
+void writeGoaway(OutputQueue &output, std::uint32_t last_stream, Http2Error code) {
+    char payload[8];
+    writeU32(payload, last_stream);
+    writeU32(payload + 4, static_cast<std::uint32_t>(code));
+    writeFrame(output, FRAME_GOAWAY, 0, 0, std::string_view(payload, sizeof(payload)));
+}
+
+void appendSetting(std::string &out, std::uint16_t id, std::uint32_t value) {
+    out.push_back(static_cast<char>(id >> 8));
+    out.push_back(static_cast<char>(id));
+    char bytes[4];
+    writeU32(bytes, value);
+    out.append(bytes, sizeof(bytes));
+}
+
+// 설정 값 하나의 유효성(RFC 9113 6.5.2). 틀리면 연결 오류 코드를 돌려준다.
+Http2Error checkSetting(std::uint16_t id, std::uint32_t value) {
+    if (id == SETTINGS_ENABLE_PUSH && value > 1) {
+        return Http2Error::kProtocolError;
+    }
+    if (id == SETTINGS_INITIAL_WINDOW_SIZE && value > MAX_WINDOW) {
+        return Http2Error::kFlowControlError;
+    }
+    if (id == SETTINGS_MAX_FRAME_SIZE && (value < Http2Session::MAX_FRAME || value > MAX_FRAME_LIMIT)) {
+        return Http2Error::kProtocolError;
+    }
+    return Http2Error::kNoError;
+}
+
+// HTTP2-Settings 헤더 값(패딩 없는 base64url, RFC 7540 3.2.1)을 푼다.
+bool decodeBase64Url(std::string_view text, std::string &out) {
+    out.clear();
+    while (!text.empty() && text.back() == '=') {
+        text.remove_suffix(1);
+    }
+    std::uint32_t pending = 0;
+    int bits = 0;
+    for (char c : text) {
+        int value;
+        if (c >= 'A' && c <= 'Z') {
+            value = c - 'A';
+        } else if (c >= 'a' && c <= 'z') {
+            value = c - 'a' + 26;
+        } else if (c >= '0' && c <= '9') {
+            value = c - '0' + 52;
+        } else if (c == '-') {
+            value = 62;
+        } else if (c == '_') {
+            value = 63;
+        } else {
+            return false;
+        }
+        pending = (pending << 6) | static_cast<std::uint32_t>(value);
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            out.push_back(static_cast<char>((pending >> bits) & 0xff));
+        }
+    }
+    return bits < 6;
+}
+
+bool parseLength(std::string_view text, std::int64_t &value) {
+    if (text.empty() || text.size() > 18) {
+        return false;
+    }
+    value = 0;
+    for (char c : text) {
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        value = value * 10 + (c - '0');
+    }
+    return true;
+}
+
+}  // namespace
+
+void HpackTable::resize(std::size_t capacity) {
+    capacity_ = capacity;
+    while (size_ > capacity_) {
+        evictOldest();
+    }
+}
+
+void HpackTable::insert(std::string_view name, std::string_view value) {
+    std::size_t entry = name.size() + value.size() + ENTRY_OVERHEAD;
+    if (entry > capacity_) {
+        // 테이블보다 큰 항목은 테이블을 비우기만 한다(RFC 7541 4.4).
+        clear();
+        return;
+    }
+    while (size_ + entry > capacity_) {
+        evictOldest();
+    }
+    if (count_ == slots_.size()) {
+        // 슬롯은 처음 쓸 때 늘린다. 항목 하나가 최소 32바이트이므로 capacity / 32 개를 넘지 않는다.
+        std::vector<Entry> grown(std::max<std::size_t>(8, slots_.size() * 2));
+        for (std::size_t i = 0; i < count_; ++i) {
+            grown[i] = std::move(slots_[(first_ + i) % slots_.size()]);
+        }
+        slots_.swap(grown);
+        first_ = 0;
+    }
+    first_ = (first_ + slots_.size() - 1) % slots_.size();
+    slots_[first_].name.assign(name);
+    slots_[first_].value.assign(value);
+    ++count_;
+    size_ += entry;
+}
+
+void HpackTable::clear() {
+    first_ = 0;
+    count_ = 0;
+    size_ = 0;
+}
+
+void HpackTable::evictOldest() {
+    const Entry &oldest = slots_[(first_ + count_ - 1) % slots_.size()];
+    size_ -= oldest.name.size() + oldest.value.size() + ENTRY_OVERHEAD;
+    --count_;
+}
+
+/**
+ * HpackDecoder::decode
+ * 설명:
+ *   - 헤더 표현(색인, 색인 추가 리터럴, 색인 없는 리터럴, 테이블 크기 갱신)을 차례로 푼다.
+ *   - storage 는 풀어 가며 늘어나 주소가 바뀔 수 있으므로 위치(Span)만 모았다가 끝에서 HeaderField 로 바꾼다.
+ */
+bool HpackDecoder::decode(std::string_view block, std::size_t limit, std::string &storage,
+                          std::vector<HeaderField> &headers, bool &too_large) {
+    const auto *data = reinterpret_cast<const unsigned char *>(block.data());
+    std::size_t size = block.size();
+    std::size_t pos = 0;
+    std::size_t list_size = 0;
+    bool fields_started = false;
+    too_large = false;
+    spans_.clear();
+
+    while (pos < size) {
+        std::uint8_t first = data[pos];
+        if ((first & 0xe0) == 0x20) {
+            // 동적 테이블 크기 갱신은 블록 맨 앞에만 올 수 있다.
+            std::size_t capacity = 0;
+            if (fields_started || !decodeInteger(data, size, pos, 5, capacity) || capacity > TABLE_SIZE) {
+                return false;
+            }
+            table_.resize(capacity);
+            continue;
+        }
+        fields_started = true;
+
+        Span span;
+        std::size_t mark = storage.size();
+        std::size_t index = 0;
+        bool add = false;
+        if (first & 0x80) {
+            if (!decodeInteger(data, size, pos, 7, index) || index == 0) {
+                return false;
+            }
+        } else {
+            add = (first & 0x40) != 0;
+            if (!decodeInteger(data, size, pos, add ? 6 : 4, index)) {
+                return false;
+            }
+        }
+
+        span.name = storage.size();
+        if (index == 0) {
+            if (!decodeString(data, size, pos, storage)) {
+                return false;
+            }
+        } else if (index <= STATIC_COUNT) {
+            storage.append(STATIC_TABLE[index - 1].name);
+        } else if (index - STATIC_COUNT - 1 < table_.count()) {
+            storage.append(table_.name(index - STATIC_COUNT - 1));
+        } else {
+            return false;
+        }
+        span.name_length = storage.size() - span.name;
+
+        span.value = storage.size();
+        if (first & 0x80) {
+            storage.append(index <= STATIC_COUNT ? STATIC_TABLE[index - 1].value
+                                                 : table_.value(index - STATIC_COUNT - 1));
+        } else if (!decodeString(data, size, pos, storage)) {
+            return false;
+        }
+        span.value_length = storage.size() - span.value;
+
+        if (add) {
+            table_.insert(std::string_view(storage).substr(span.name, span.name_length),
+                          std::string_view(storage).substr(span.value, span.value_length));
+        }
+        list_size += span.name_length + span.value_length + HpackTable::ENTRY_OVERHEAD;
+        if (list_size > limit) {
+            too_large = true;
+        }
+        if (too_large) {
+            // 넘친 뒤로는 테이블만 맞추고 헤더는 담지 않는다.
+            storage.resize(mark);
+            continue;
+        }
+        spans_.push_back(span);
+    }
+
+    headers.clear();
+    std::string_view text(storage);
+    for (const Span &span : spans_) {
+        headers.push_back(
+            HeaderField{text.substr(span.name, span.name_length), text.substr(span.value, span.value_length)});
+    }
+    return true;
+}
+
+void HpackEncoder::setPeerTableSize(std::size_t bytes) {
+    std::size_t capacity = std::min(bytes, MAX_TABLE_SIZE);
+    if (capacity != table_.capacity()) {
+        table_.resize(capacity);
+        size_update_ = true;
+    }
+}
+
+void HpackEncoder::beginBlock(std::string &out) {
+    if (size_update_) {
+        encodeInteger(out, 0x20, 5, table_.capacity());
+        size_update_ = false;
+    }
+}
+
+void HpackEncoder::status(int code, std::string &out) {
+    // 정적 테이블 8~14 번이 :status 200/204/206/304/400/404/500 이다.
+    static constexpr int INDEXED[] = {200, 204, 206, 304, 400, 404, 500};
+    for (std::size_t i = 0; i < sizeof(INDEXED) / sizeof(INDEXED[0]); ++i) {
+        if (INDEXED[i] == code) {
+            encodeInteger(out, 0x80, 7, 8 + i);
+            return;
+        }
+    }
+    char digits[3] = {static_cast<char>('0' + code / 100 % 10), static_cast<char>('0' + code / 10 % 10),
+                      static_cast<char>('0' + code % 10)};
+    encodeInteger(out, 0x00, 4, 8);
+    encodeString(out, std::string_view(digits, sizeof(digits)));
+}
+
+void HpackEncoder::header(std::string_view name, std::string_view value, std::string &out) {
+    bool indexing = worthIndexing(name);
+    if (indexing) {
+        for (std::size_t i = 0; i < table_.count(); ++i) {
+            if (table_.name(i) == name && table_.value(i) == value) {
+                encodeInteger(out, 0x80, 7, STATIC_COUNT + 1 + i);
+                return;
+            }
+        }
+    }
+    std::size_t name_index = staticNameIndex(name);
+    if (indexing) {
+        encodeInteger(out, 0x40, 6, name_index);
+    } else {
+        encodeInteger(out, 0x00, 4, name_index);
+    }
+    if (name_index == 0) {
+        encodeString(out, name);
+    }
+    encodeString(out, value);
+    if (indexing) {
+        table_.insert(name, value);
+    }
+}
+
+void Http2Session::start(const Http2Settings &settings, WorkerMetrics &metrics, OutputQueue &output) {
+    reset();
+    active_ = true;
+    preface_pending_ = true;
+    settings_ = settings;
+    metrics_ = &metrics;
+    writeServerPreface(output);
+}
+
+Http2Stream *Http2Session::startUpgrade(const Http2Settings &settings, WorkerMetrics &metrics,
+                                        std::string_view encoded, OutputQueue &output) {
+    std::string payload;
+    if (!decodeBase64Url(encoded, payload) || payload.size() % 6 != 0) {
+        return nullptr;
+    }
+    for (std::size_t offset = 0; offset < payload.size(); offset += 6) {
+        auto id = static_cast<std::uint16_t>((static_cast<unsigned char>(payload[offset]) << 8) |
+                                             static_cast<unsigned char>(payload[offset + 1]));
+        if (checkSetting(id, readU32(payload.data() + offset + 2)) != Http2Error::kNoError) {
+            return nullptr;
+        }
+    }
+    output.append("HTTP/1.1 101 Switching Protocols\r\nConnection: Upgrade\r\nUpgrade: h2c\r\n\r\n");
+    start(settings, metrics, output);
+    // 헤더로 받은 설정은 101 이 확인을 대신하므로 SETTINGS ACK 를 보내지 않는다.
+    applySettings(payload.data(), payload.size(), false, output);
+    last_peer_stream_ = 1;
+    Http2Stream *stream = openStream(1);
+    stream->remote_closed = true;
+    return stream;
+}
+
+void Http2Session::writeServerPreface(OutputQueue &output) {
+    block_.clear();
+    appendSetting(block_, SETTINGS_MAX_CONCURRENT_STREAMS, static_cast<std::uint32_t>(settings_.max_streams));
+    appendSetting(block_, SETTINGS_INITIAL_WINDOW_SIZE, static_cast<std::uint32_t>(settings_.window));
+    appendSetting(block_, SETTINGS_MAX_HEADER_LIST_SIZE, static_cast<std::uint32_t>(settings_.max_header_bytes));
+    writeFrame(output, FRAME_SETTINGS, 0, 0, block_);
+    // 연결 창은 SETTINGS 로 바꿀 수 없어 65535 에서 시작한다. 스트림 창과 같은 크기로 바로 넓힌다.
+    if (static_cast<std::int64_t>(settings_.window) > DEFAULT_WINDOW) {
+        writeU32Frame(output, FRAME_WINDOW_UPDATE, 0,
+                      static_cast<std::uint32_t>(static_cast<std::int64_t>(settings_.window) - DEFAULT_WINDOW));
+    }
+}
+
+Http2Event Http2Session::next(const char *data, std::size_t size, std::size_t &consumed, OutputQueue &output) {
+    consumed = 0;
+    if (preface_pending_) {
+        std::size_t compare = std::min(size, HTTP2_PREFACE.size());
+        if (std::string_view(data, compare) != HTTP2_PREFACE.substr(0, compare)) {
+            fail(Http2Error::kProtocolError, output);
+            return Http2Event::kError;
+        }
+        if (size < HTTP2_PREFACE.size()) {
+            return Http2Event::kNeedMore;
+        }
+        consumed = HTTP2_PREFACE.size();
+        preface_pending_ = false;
+        settings_pending_ = true;
+    }
+
+    while (size - consumed >= FRAME_HEADER) {
+        const char *frame = data + consumed;
+        std::size_t length = (std::size_t{static_cast<unsigned char>(frame[0])} << 16) |
+                             (std::size_t{static_cast<unsigned char>(frame[1])} << 8) |
+                             static_cast<unsigned char>(frame[2]);
+        auto type = static_cast<std::uint8_t>(frame[3]);
+        auto flags = static_cast<std::uint8_t>(frame[4]);
+        std::uint32_t id = readU32(frame + 5) & 0x7fffffff;
+        if (length > MAX_FRAME) {
+            fail(Http2Error::kFrameSizeError, output);
+            return Http2Event::kError;
+        }
+        if (size - consumed - FRAME_HEADER < length) {
+            break;
+        }
+        consumed += FRAME_HEADER + length;
+
+        // 프리페이스 뒤 첫 프레임은 SETTINGS 여야 하고, 헤더 블록 사이에는 같은 스트림의 CONTINUATION 만 온다.
+        if (settings_pending_) {
+            if (type != FRAME_SETTINGS || (flags & FLAG_ACK) != 0) {
+                fail(Http2Error::kProtocolError, output);
+                return Http2Event::kError;
+            }
+            settings_pending_ = false;
+        }
+        if (continuation_ && (type != FRAME_CONTINUATION || id != header_stream_)) {
+            fail(Http2Error::kProtocolError, output);
+            return Http2Event::kError;
+        }
+
+        FrameResult result = handleFrame(type, flags, id, frame + FRAME_HEADER, length, output);
+        if (result == FrameResult::kEvent) {
+            return event_;
+        }
+        if (result == FrameResult::kError) {
+            return Http2Event::kError;
+        }
+    }
+    return Http2Event::kNeedMore;
+}
+
+Http2Session::FrameResult Http2Session::handleFrame(std::uint8_t type, std::uint8_t flags, std::uint32_t id,
+                                                    const char *payload, std::size_t length, OutputQueue &output) {
+    switch (type) {
+        case FRAME_DATA:
+            return handleData(flags, id, payload, length, output);
+        case FRAME_HEADERS:
+            return handleHeaders(flags, id, payload, length, output);
+        case FRAME_PRIORITY:
+            // 우선순위 신호는 RFC 9113 에서 폐기되었다. 형식만 확인하고 따르지 않는다.
+            if (id == 0) {
+                return fail(Http2Error::kProtocolError, output);
+            }
+            if (length != 5) {
+                writeU32Frame(output, FRAME_RST_STREAM, id, static_cast<std::uint32_t>(Http2Error::kFrameSizeError));
+            }
+            return FrameResult::kContinue;
+        case FRAME_RST_STREAM: {
+            if (id == 0 || id > last_peer_stream_) {
+                return fail(Http2Error::kProtocolError, output);
+            }
+            if (length != 4) {
+                return fail(Http2Error::kFrameSizeError, output);
+            }
+            Http2Stream *stream = find(id);
+            if (stream != nullptr) {
+                count(Http2StreamLabel::kPeerReset);
+                closeStream(*stream);
+            }
+            return FrameResult::kContinue;
+        }
+        case FRAME_SETTINGS:
+            if (id != 0) {
+                return fail(Http2Error::kProtocolError, output);
+            }
+            if ((flags & FLAG_ACK) != 0) {
+                return length == 0 ? FrameResult::kContinue : fail(Http2Error::kFrameSizeError, output);
+            }
+            return applySettings(payload, length, true, output);
+        case FRAME_PUSH_PROMISE:
+            // 클라이언트는 푸시를 보낼 수 없다.
+            return fail(Http2Error::kProtocolError, output);
+        case FRAME_PING:
+            if (id != 0) {
+                return fail(Http2Error::kProtocolError, output);
+            }
+            if (length != 8) {
+                return fail(Http2Error::kFrameSizeError, output);
+            }
+            if ((flags & FLAG_ACK) == 0) {
+                writeFrame(output, FRAME_PING, FLAG_ACK, 0, std::string_view(payload, length));
+            }
+            return FrameResult::kContinue;
+        case FRAME_GOAWAY:
+            if (id != 0) {
+                return fail(Http2Error::kProtocolError, output);
+            }
+            if (length < 8) {
+                return fail(Http2Error::kFrameSizeError, output);
+            }
+            peer_goaway_ = true;
+            return FrameResult::kContinue;
+        case FRAME_WINDOW_UPDATE: {
+            if (length != 4) {
+                return fail(Http2Error::kFrameSizeError, output);
+            }
+            std::int64_t increment = readU32(payload) & 0x7fffffff;
+            if (id == 0) {
+                if (increment == 0) {
+                    return fail(Http2Error::kProtocolError, output);
+                }
+                send_window_ += increment;
+                return send_window_ > MAX_WINDOW ? fail(Http2Error::kFlowControlError, output)
+                                                 : FrameResult::kContinue;
+            }
+            if (id > last_peer_stream_) {
+                return fail(Http2Error::kProtocolError, output);
+            }
+            Http2Stream *stream = find(id);
+            if (stream == nullptr) {
+                return FrameResult::kContinue;
+            }
+            if (increment == 0) {
+                resetStream(*stream, Http2Error::kProtocolError, output);
+                return FrameResult::kContinue;
+            }
+            stream->send_window += increment;
+            if (stream->send_window > MAX_WINDOW) {
+                resetStream(*stream, Http2Error::kFlowControlError, output);
+            }
+            return FrameResult::kContinue;
+        }
+        case FRAME_CONTINUATION:
+            if (!continuation_) {
+                return fail(Http2Error::kProtocolError, output);
+            }
+            header_block_.append(payload, length);
+            if (header_block_.size() > settings_.max_header_bytes) {
+                return fail(Http2Error::kEnhanceYourCalm, output);
+            }
+            if ((flags & FLAG_END_HEADERS) != 0) {
+                return finishHeaders(output);
+            }
+            return FrameResult::kContinue;
+        default:
+            // 모르는 프레임 종류는 무시한다(RFC 9113 5.5).
+            return FrameResult::kContinue;
+    }
+}
+
+/**
+ * Http2Session::handleData
+ * 설명:
+ *   - 연결 창은 패딩까지 포함해 모든 DATA 가 쓴다. 닫힌 스트림의 DATA 도 창만 돌려주고 버린다
+ *     (서버가 RST_STREAM 으로 닫은 직후 상대가 이미 보낸 프레임일 수 있다).
+ *   - Content-Length 가 있으면 받은 본문 길이가 넘치거나 END_STREAM 에서 모자라면 스트림 오류다.
+ */
+Http2Session::FrameResult Http2Session::handleData(std::uint8_t flags, std::uint32_t id, const char *payload,
+                                                   std::size_t length, OutputQueue &output) {
+    if (id == 0 || id > last_peer_stream_) {
+        return fail(Http2Error::kProtocolError, output);
+    }
+    std::size_t offset = 0;
+    std::size_t padding = 0;
+    if ((flags & FLAG_PADDED) != 0) {
+        if (length == 0 || static_cast<unsigned char>(payload[0]) >= length) {
+            return fail(Http2Error::kProtocolError, output);
+        }
+        padding = static_cast<unsigned char>(payload[0]);
+        offset = 1;
+    }
+
+    recv_unacked_ += static_cast<std::uint32_t>(length);
+    if (recv_unacked_ > settings_.window) {
+        return fail(Http2Error::kFlowControlError, output);
+    }
+    if (recv_unacked_ >= settings_.window / 2) {
+        writeU32Frame(output, FRAME_WINDOW_UPDATE, 0, recv_unacked_);
+        recv_unacked_ = 0;
+    }
+
+    Http2Stream *stream = find(id);
+    if (stream == nullptr) {
+        return FrameResult::kContinue;
+    }
+    if (stream->remote_closed) {
+        resetStream(*stream, Http2Error::kStreamClosed, output);
+        return FrameResult::kContinue;
+    }
+    stream->recv_unacked += static_cast<std::uint32_t>(length);
+    if (stream->recv_unacked > settings_.window) {
+        resetStream(*stream, Http2Error::kFlowControlError, output);
+        return FrameResult::kContinue;
+    }
+
+    std::size_t body = length - offset - padding;
+    bool end = (flags & FLAG_END_STREAM) != 0;
+    stream->received += body;
+    if (stream->expected_length >= 0 &&
+        (stream->received > static_cast<std::uint64_t>(stream->expected_length) ||
+         (end && stream->received != static_cast<std::uint64_t>(stream->expected_length)))) {
+        resetStream(*stream, Http2Error::kProtocolError, output);
+        return FrameResult::kContinue;
+    }
+    if (end) {
+        stream->remote_closed = true;
+    } else if (stream->recv_unacked >= settings_.window / 2) {
+        writeU32Frame(output, FRAME_WINDOW_UPDATE, id, stream->recv_unacked);
+        stream->recv_unacked = 0;
+    }
+    if (body == 0 && !end) {
+        return FrameResult::kContinue;
+    }
+    data_ = std::string_view(payload + offset, body);
+    data_end_ = end;
+    event_slot_ = static_cast<std::size_t>(stream - streams_.data());
+    event_ = Http2Event::kData;
+    return FrameResult::kEvent;
+}
+
+Http2Session::FrameResult Http2Session::handleHeaders(std::uint8_t flags, std::uint32_t id, const char *payload,
+                                                      std::size_t length, OutputQueue &output) {
+    if (id == 0 || id % 2 == 0) {
+        return fail(Http2Error::kProtocolError, output);
+    }
+    std::size_t offset = 0;
+    std::size_t padding = 0;
+    if ((flags & FLAG_PADDED) != 0) {
+        if (length == 0) {
+            return fail(Http2Error::kProtocolError, output);
+        }
+        padding = static_cast<unsigned char>(payload[0]);
+        offset = 1;
+    }
+    if ((flags & FLAG_PRIORITY) != 0) {
+        offset += 5;
+    }
+    if (offset + padding > length) {
+        return fail(Http2Error::kProtocolError, output);
+    }
+
+    Http2Stream *stream = find(id);
+    if (stream != nullptr) {
+        // 이미 열린 스트림의 HEADERS 는 트레일러다. 본문을 끝내야 한다.
+        if ((flags & FLAG_END_STREAM) == 0) {
+            return fail(Http2Error::kProtocolError, output);
+        }
+        if (stream->remote_closed) {
+            return fail(Http2Error::kStreamClosed, output);
+        }
+    }
+    header_new_ = stream == nullptr && id > last_peer_stream_;
+    if (header_new_) {
+        last_peer_stream_ = id;
+    }
+    header_stream_ = id;
+    header_end_stream_ = (flags & FLAG_END_STREAM) != 0;
+    header_block_.assign(payload + offset, length - offset - padding);
+    if ((flags & FLAG_END_HEADERS) == 0) {
+        continuation_ = true;
+        return FrameResult::kContinue;
+    }
+    return finishHeaders(output);
+}
+
+/**
+ * Http2Session::finishHeaders
+ * 설명:
+ *   - 다 모인 헤더 블록을 푼다. 닫힌 스트림의 블록이나 거절한 스트림의 블록도 HPACK 상태를 맞추려 반드시 푼다.
+ *   - 새 스트림이면 동시 스트림 상한을 확인하고 요청을 만든다. 형식이 틀린 요청은 PROTOCOL_ERROR 로 스트림만 닫는다.
+ */
+Http2Session::FrameResult Http2Session::finishHeaders(OutputQueue &output) {
+    continuation_ = false;
+    bool too_large = false;
+    header_storage_.clear();
+    if (!decoder_.decode(header_block_, settings_.max_header_bytes, header_storage_, header_list_, too_large)) {
+        return fail(Http2Error::kCompressionError, output);
+    }
+
+    Http2Stream *stream = find(header_stream_);
+    if (stream != nullptr) {
+        if (stream->expected_length >= 0 && stream->received != static_cast<std::uint64_t>(stream->expected_length)) {
+            resetStream(*stream, Http2Error::kProtocolError, output);
+            return FrameResult::kContinue;
+        }
+        stream->remote_closed = true;
+        data_ = std::string_view();
+        data_end_ = true;
+        event_slot_ = static_cast<std::size_t>(stream - streams_.data());
+        event_ = Http2Event::kData;
+        return FrameResult::kEvent;
+    }
+    if (!header_new_) {
+        return FrameResult::kContinue;
+    }
+    if (goaway_sent_ || open_ >= settings_.max_streams) {
+        writeU32Frame(output, FRAME_RST_STREAM, header_stream_, static_cast<std::uint32_t>(Http2Error::kRefusedStream));
+        count(Http2StreamLabel::kRefused);
+        return FrameResult::kContinue;
+    }
+
+    stream = openStream(header_stream_);
+    stream->remote_closed = header_end_stream_;
+    headers_too_large_ = too_large;
+    if (!buildRequest(*stream)) {
+        resetStream(*stream, Http2Error::kProtocolError, output);
+        return FrameResult::kContinue;
+    }
+    event_slot_ = static_cast<std::size_t>(stream - streams_.data());
+    event_ = Http2Event::kRequest;
+    return FrameResult::kEvent;
+}
+
+/**
+ * Http2Session::buildRequest
+ * 설명:
+ *   - 헤더 목록을 HttpRequestView 로 옮기며 요청 형식을 검사한다(RFC 9113 8.3): 가상 헤더는 일반 헤더 앞에 한 번씩,
+ *     :method/:scheme/:path 는 필수, 헤더 이름은 소문자, 연결 헤더 금지, te 는 trailers 만.
+ *   - 헤더 목록이 너무 크면 일부만 풀렸으므로 검사하지 않는다. 워커는 431 로 답한다.
+ */
+bool Http2Session::buildRequest(Http2Stream &stream) {
+    request_.method = std::string_view();
+    request_.path = std::string_view();
+    request_.version = "HTTP/1.1";
+    request_.header_count = 0;
+    if (headers_too_large_) {
+        return true;
+    }
+
+    std::string_view authority;
+    bool scheme = false;
+    bool regular = false;
+    for (const HeaderField &field : header_list_) {
+        if (field.name.empty()) {
+            return false;
+        }
+        if (field.name[0] == ':') {
+            std::string_view *target = nullptr;
+            if (regular) {
+                return false;
+            }
+            if (field.name == ":method") {
+                target = &request_.method;
+            } else if (field.name == ":path") {
+                target = &request_.path;
+            } else if (field.name == ":authority") {
+                target = &authority;
+            } else if (field.name == ":scheme") {
+                if (scheme) {
+                    return false;
+                }
+                scheme = true;
+                continue;
+            } else {
+                return false;
+            }
+            if (!target->empty() || field.value.empty()) {
+                return false;
+            }
+            *target = field.value;
+            continue;
+        }
+        regular = true;
+        for (char c : field.name) {
+            if (c >= 'A' && c <= 'Z') {
+                return false;
+            }
+        }
+        if (connectionSpecific(field.name) || (field.name == "te" && field.value != "trailers")) {
+            return false;
+        }
+        if (field.name == "content-length") {
+            std::int64_t length = 0;
+            if (!parseLength(field.value, length) ||
+                (stream.expected_length >= 0 && stream.expected_length != length)) {
+                return false;
+            }
+            stream.expected_length = length;
+        }
+        if (request_.header_count == MAX_HEADERS) {
+            headers_too_large_ = true;
+            return true;
+        }
+        request_.headers[request_.header_count++] = field;
+    }
+    if (request_.method.empty() || request_.path.empty() || !scheme) {
+        return false;
+    }
+    if (stream.remote_closed && stream.expected_length > 0) {
+        return false;
+    }
+    // 핸들러는 Host 로 가상 호스트와 기본 응답을 정한다. HTTP/2 에서는 :authority 가 그 자리다.
+    if (!authority.empty() && request_.findHeader("host") == nullptr) {
+        if (request_.header_count == MAX_HEADERS) {
+            headers_too_large_ = true;
+            return true;
+        }
+        request_.headers[request_.header_count++] = HeaderField{"host", authority};
+    }
+    return true;
+}
+
+Http2Session::FrameResult Http2Session::applySettings(const char *payload, std::size_t length, bool acknowledge,
+                                                      OutputQueue &output) {
+    if (length % 6 != 0) {
+        return fail(Http2Error::kFrameSizeError, output);
+    }
+    for (std::size_t offset = 0; offset < length; offset += 6) {
+        auto id = static_cast<std::uint16_t>((static_cast<unsigned char>(payload[offset]) << 8) |
+                                             static_cast<unsigned char>(payload[offset + 1]));
+        std::uint32_t value = readU32(payload + offset + 2);
+        Http2Error error = checkSetting(id, value);
+        if (error != Http2Error::kNoError) {
+            return fail(error, output);
+        }
+        if (id == SETTINGS_HEADER_TABLE_SIZE) {
+            encoder_.setPeerTableSize(value);
+        } else if (id == SETTINGS_INITIAL_WINDOW_SIZE) {
+            // 초기 창이 바뀌면 열린 스트림의 송신 창도 차이만큼 바뀐다(음수가 될 수 있다).
+            std::int64_t delta = static_cast<std::int64_t>(value) - peer_initial_window_;
+            peer_initial_window_ = value;
+            for (Http2Stream &stream : streams_) {
+                if (stream.id == 0) {
+                    continue;
+                }
+                stream.send_window += delta;
+                if (stream.send_window > MAX_WINDOW) {
+                    return fail(Http2Error::kFlowControlError, output);
+                }
+            }
+        } else if (id == SETTINGS_MAX_FRAME_SIZE) {
+            peer_max_frame_ = value;
+        }
+    }
+    if (acknowledge) {
+        writeFrame(output, FRAME_SETTINGS, FLAG_ACK, 0, std::string_view());
+    }
+    return FrameResult::kContinue;
+}
+
+Http2Session::FrameResult Http2Session::fail(Http2Error code, OutputQueue &output) {
+    if (!goaway_sent_) {
+        writeGoaway(output, last_peer_stream_, code);
+        goaway_sent_ = true;
+    }
+    return FrameResult::kError;
+}
+
+Http2Stream *Http2Session::find(std::uint32_t id) {
+    if (id == 0) {
+        return nullptr;
+    }
+    for (Http2Stream &stream : streams_) {
+        if (stream.id == id) {
+            return &stream;
+        }
+    }
+    return nullptr;
+}
+
+Http2Stream *Http2Session::openStream(std::uint32_t id) {
+    Http2Stream *stream = nullptr;
+    for (Http2Stream &slot : streams_) {
+        if (slot.id == 0) {
+            stream = &slot;
+            break;
+        }
+    }
+    if (stream == nullptr) {
+        stream = &streams_.emplace_back();
+    }
+    stream->id = id;
+    stream->remote_closed = false;
+    stream->responded = false;
+    stream->send_window = peer_initial_window_;
+    stream->recv_unacked = 0;
+    stream->expected_length = -1;
+    stream->received = 0;
+    stream->response_bytes = 0;
+    stream->label = RouteLabel::kError;
+    stream->route = BodyRoute::kDiscard;
+    stream->status = 0;
+    stream->upload = UploadDigest{};
+    stream->coding = ContentCoding::kIdentity;
+    stream->waiting = false;
+    stream->access.clearRequest();
+    ++open_;
+    return stream;
+}
+
+void Http2Session::closeStream(Http2Stream &stream) {
+    stream.id = 0;
+    stream.pending.clear();
+    stream.pending_offset = 0;
+    stream.file.reset();
+    stream.file_remaining = 0;
+    stream.waiting = false;
+    stream.result.clear();
+    --open_;
+}
+
+void Http2Session::resetStream(Http2Stream &stream, Http2Error code, OutputQueue &output) {
+    writeU32Frame(output, FRAME_RST_STREAM, stream.id, static_cast<std::uint32_t>(code));
+    count(Http2StreamLabel::kLocalReset);
+    closeStream(stream);
+}
+
+/**
+ * Http2Session::respond
+ * 설명:
+ *   - 상태 줄과 헤더를 HPACK 블록으로 바꾸고, 본문 바이트는 스트림에 복사하고 파일 구간은 핸들만 옮긴다.
+ *   - 출력 큐 상한 안에서 창이 허락하는 만큼 DATA 를 바로 보낸다. 작은 응답은 여기서 끝난다.
+ */
+bool Http2Session::respond(Http2Stream &stream, OutputQueue &reply, bool head_only, OutputQueue &output,
+                           std::size_t limit) {
+    bool file_follows = false;
+    std::string_view bytes = reply.sendable(file_follows);
+    std::size_t scan = 0;
+    ResponseHead head;
+    if (parseResponseHead(bytes.data(), bytes.size(), scan, head) != ParseStatus::kComplete) {
+        reply.clear();
+        resetStream(stream, Http2Error::kInternalError, output);
+        return false;
+    }
+
+    block_.clear();
+    encoder_.beginBlock(block_);
+    encoder_.status(head.status, block_);
+    for (std::size_t i = 0; i < head.fields.header_count; ++i) {
+        const HeaderField &field = head.fields.headers[i];
+        lower_.assign(field.name);
+        std::transform(lower_.begin(), lower_.end(), lower_.begin(),
+                       [](char c) { return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c; });
+        if (connectionSpecific(lower_)) {
+            continue;
+        }
+        encoder_.header(lower_, field.value, block_);
+    }
+
+    stream.pending.clear();
+    stream.pending_offset = 0;
+    if (!head_only) {
+        stream.pending.assign(bytes.substr(head.length));
+        if (file_follows) {
+            stream.file = reply.frontFile(stream.file_offset, stream.file_remaining);
+        }
+    }
+    stream.response_bytes = block_.size() + stream.pending.size() + stream.file_remaining;
+    reply.clear();
+    stream.responded = true;
+
+    bool end = !stream.sending();
+    writeHeaders(stream, end, output);
+    if (end) {
+        finishStream(stream, output);
+        return true;
+    }
+    while (output.bytes() < limit && sendFrame(stream, output)) {
+    }
+    return true;
+}
+
+void Http2Session::writeHeaders(Http2Stream &stream, bool end_stream, OutputQueue &output) {
+    std::string_view block(block_);
+    std::uint8_t type = FRAME_HEADERS;
+    std::uint8_t flags = end_stream ? FLAG_END_STREAM : 0;
+    do {
+        std::string_view fragment = block.substr(0, peer_max_frame_);
+        block.remove_prefix(fragment.size());
+        writeFrame(output, type, static_cast<std::uint8_t>(flags | (block.empty() ? FLAG_END_HEADERS : 0)),
+                   stream.id, fragment);
+        type = FRAME_CONTINUATION;
+        flags = 0;
+    } while (!block.empty());
+}
+
+/**
+ * Http2Session::sendFrame
+ * 설명:
+ *   - 스트림의 남은 본문에서 DATA 프레임 하나(연결 창, 스트림 창, 상대 최대 프레임 크기 중 작은 값)를 내보낸다.
+ *   - 파일 구간은 프레임 헤더 9바이트만 버퍼에 쓰고 본문은 파일 구간으로 붙인다.
+ * 출력:
+ *   - 프레임을 보냈으면 true, 보낼 본문이 없거나 창이 닫혔으면 false
+ */
+bool Http2Session::sendFrame(Http2Stream &stream, OutputQueue &output) {
+    if (!stream.sending()) {
+        return false;
+    }
+    std::int64_t window = std::min(send_window_, stream.send_window);
+    if (window <= 0) {
+        return false;
+    }
+    std::size_t budget = std::min(static_cast<std::size_t>(window), peer_max_frame_);
+    std::size_t length;
+    bool last;
+    if (stream.pending_offset < stream.pending.size()) {
+        length = std::min(budget, stream.pending.size() - stream.pending_offset);
+        last = stream.pending_offset + length == stream.pending.size() && stream.file_remaining == 0;
+        writeFrame(output, FRAME_DATA, last ? FLAG_END_STREAM : 0, stream.id,
+                   std::string_view(stream.pending).substr(stream.pending_offset, length));
+        stream.pending_offset += length;
+    } else {
+        length = std::min(budget, stream.file_remaining);
+        last = length == stream.file_remaining;
+        char *p = output.prepare(FRAME_HEADER);
+        writeFrameHeader(p, length, FRAME_DATA, last ? FLAG_END_STREAM : 0, stream.id);
+        output.commit(FRAME_HEADER);
+        output.pushFile(stream.file, stream.file_offset, length);
+        stream.file_offset += length;
+        stream.file_remaining -= length;
+    }
+    send_window_ -= static_cast<std::int64_t>(length);
+    stream.send_window -= static_cast<std::int64_t>(length);
+    if (last) {
+        finishStream(stream, output);
+    }
+    return true;
+}
+
+// 응답의 마지막 프레임을 넣었다. 요청 본문이 아직 오는 중이면 NO_ERROR 로 그만 보내라고 알린다(RFC 9113 8.1).
+void Http2Session::finishStream(Http2Stream &stream, OutputQueue &output) {
+    finished_.push_back(Http2Finished{output.pushedTotal(), stream.start});
+    count(Http2StreamLabel::kCompleted);
+    if (!stream.remote_closed) {
+        writeU32Frame(output, FRAME_RST_STREAM, stream.id, static_cast<std::uint32_t>(Http2Error::kNoError));
+    }
+    closeStream(stream);
+}
+
+void Http2Session::flush(OutputQueue &output, std::size_t limit) {
+    if (streams_.empty()) {
+        return;
+    }
+    // 한 바퀴에 스트림마다 프레임 하나씩. 큰 응답 하나가 작은 응답들을 가로막지 않는다.
+    bool progressed = true;
+    while (progressed && output.bytes() < limit && send_window_ > 0) {
+        progressed = false;
+        for (std::size_t n = 0; n < streams_.size() && output.bytes() < limit; ++n) {
+            Http2Stream &stream = streams_[cursor_];
+            cursor_ = (cursor_ + 1) % streams_.size();
+            if (stream.id != 0 && sendFrame(stream, output)) {
+                progressed = true;
+            }
+        }
+    }
+}
+
+void Http2Session::goAway(OutputQueue &output) {
+    if (!goaway_sent_) {
+        writeGoaway(output, last_peer_stream_, Http2Error::kNoError);
+        goaway_sent_ = true;
+    }
+}
+
+bool Http2Session::sending() const {
+    for (const Http2Stream &stream : streams_) {
+        if (stream.id != 0 && stream.sending()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::size_t Http2Session::waiting() const {
+    std::size_t count = 0;
+    for (const Http2Stream &stream : streams_) {
+        if (stream.id != 0 && stream.waiting) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+void Http2Session::count(Http2StreamLabel label) {
+    WorkerMetrics::add(metrics_->http2_streams[static_cast<std::size_t>(label)], 1);
+}
+
+void Http2Session::reset() {
+    active_ = false;
+    preface_pending_ = false;
+    settings_pending_ = false;
+    peer_goaway_ = false;
+    goaway_sent_ = false;
+    metrics_ = nullptr;
+    decoder_.reset();
+    encoder_.reset();
+    streams_.clear();
+    open_ = 0;
+    cursor_ = 0;
+    last_peer_stream_ = 0;
+    send_window_ = DEFAULT_WINDOW;
+    recv_unacked_ = 0;
+    peer_initial_window_ = DEFAULT_WINDOW;
+    peer_max_frame_ = MAX_FRAME;
+    header_stream_ = 0;
+    header_new_ = false;
+    header_end_stream_ = false;
+    continuation_ = false;
+    header_block_.clear();
+    headers_too_large_ = false;
+    finished_.clear();
+    ready_.clear();
+}
@@ -0,0 +1,350 @@
+#include "http_message.hpp"
+
+#include <charconv>
+#include <cstring>
+#include <iterator>
+
+/**
+ * [모듈] webserv-cpp17/src/http_message.cpp
+ * 설명:
+ *   - HTTP/1.x 응답 직렬화를 구현한다.
+ *   - v1.10.0부터 상태 줄/헤더 조각은 컴파일 타임 표에서 꺼내 출력 큐 버퍼에 바로 복사한다.
+ * 버전: v1.24.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v0.3.0-http11-core.md
+ *   - design/webserv-cpp17/v1.1.0-epoll-reactor.md
+ *   - design/webserv-cpp17/v1.3.0-incremental-parser.md
+ *   - design/webserv-cpp17/v1.6.0-static-files.md
+ *   - design/webserv-cpp17/v1.10.0-zero-alloc-responses.md
+ *   - design/webserv-cpp17/v1.12.0-streaming-request-body.md
+ *   - design/webserv-cpp17/v1.14.0-response-compression.md
+ *   - design/webserv-cpp17/v1.15.0-response-cache.md
+ *   - design/webserv-cpp17/v1.16.0-reverse-proxy.md
+ *   - design/webserv-cpp17/v1.17.0-handler-offload.md
+ *   - design/webserv-cpp17/v1.24.0-client-limits.md
+ * 변경 이력:
+ *   - v0.3.0: Host/keep-alive 처리용 요청 파서와 응답 생성기 추가
+ *   - v1.1.0: main.cpp 에서 분리해 독립 모듈로 정리
+ *   - v1.3.0: 요청 파싱을 http_parser 모듈로 이전
+ *   - v1.6.0: 정적 파일 응답 헤더 직렬화 추가
+ *   - v1.10.0: constexpr 상태 줄/헤더 표, Date 헤더 캐시, 출력 큐 직접 직렬화, 고정 응답 미리 만들기
+ *   - v1.12.0: 413/431/501 상태 줄과 본문/헤더 제한 고정 응답 추가
+ *   - v1.14.0: Date 줄 뒤에 추가 헤더 줄을 넣는 extra_headers 인자 추가
+ *   - v1.15.0: 304 상태 줄과 writeNotModified, formatHttpDate/parseHttpDate 추가
+ *   - v1.16.0: 502/504 상태 줄과 업스트림 실패 고정 응답 추가
+ *   - v1.17.0: 503 상태 줄과 작업 큐 초과 고정 응답 추가
+ *   - v1.24.0: 429 상태 줄 추가
+ * 테스트:
+ *   - tests/test_webserv_keepalive.sh
+ *   - tests/test_webserv_static_files.sh
+ *   - tests/test_webserv_alloc_free.sh
+ *   - tests/test_webserv_request_body.sh
+ *   - tests/test_webserv_compression.sh
+ *   - tests/test_webserv_response_cache.sh
+ *   - tests/test_webserv_proxy.sh
+ *   - tests/test_webserv_offload.sh
+ *   - tests/test_webserv_client_limits.sh
+ */
+
+namespace {
+
+struct StatusLine {
+    int status;
+    std::string_view line;
+};
+
+// 알 수 없는 코드는 마지막 항목(400)으로 직렬화한다.
+constexpr StatusLine STATUS_LINES[] = {
+    {200, "HTTP/1.1 200 OK\r\n"},
+    {304, "HTTP/1.1 304 Not Modified\r\n"},
+    {404, "HTTP/1.1 404 Not Found\r\n"},
+    {405, "HTTP/1.1 405 Method Not Allowed\r\n"},
+    {413, "HTTP/1.1 413 Content Too Large\r\n"},
+    {429, "HTTP/1.1 429 Too Many Requests\r\n"},
+    {431, "HTTP/1.1 431 Request Header Fields Too Large\r\n"},
+    {501, "HTTP/1.1 501 Not Implemented\r\n"},
+    {502, "HTTP/1.1 502 Bad Gateway\r\n"},
+    {503, "HTTP/1.1 503 Service Unavailable\r\n"},
+    {504, "HTTP/1.1 504 Gateway Timeout\r\n"},
+    {400, "HTTP/1.1 400 Bad Request\r\n"},
+};
+
+constexpr std::string_view statusLine(int status) {
+    for (const StatusLine &entry : STATUS_LINES) {
+        if (entry.status == status) {
+            return entry.line;
+        }
+    }
+    return STATUS_LINES[std::size(STATUS_LINES) - 1].line;
+}
+
+static_assert(statusLine(200) == "HTTP/1.1 200 OK\r\n", "상태 줄 표는 컴파일 타임에 조회된다");
+static_assert(statusLine(999) == "HTTP/1.1 400 Bad Request\r\n", "알 수 없는 상태는 400 으로 직렬화한다");
+
+constexpr std::string_view TEXT_HEADERS = "Content-Type: text/plain; charset=utf-8\r\nContent-Length: ";
+constexpr std::string_view FILE_TYPE_HEADER = "Content-Type: ";
+constexpr std::string_view LENGTH_HEADER = "\r\nContent-Length: ";
+constexpr std::string_view ETAG_HEADER = "\r\nETag: ";
+constexpr std::string_view CRLF = "\r\n";
+constexpr std::string_view KEEP_ALIVE_TAIL = "Connection: keep-alive\r\n\r\n";
+constexpr std::string_view CLOSE_TAIL = "Connection: close\r\n\r\n";
+
+// size_t 십진수 최대 자릿수(2^64 - 1 은 20자리).
+constexpr std::size_t MAX_DIGITS = 20;
+
+struct CannedSpec {
+    int status;
+    std::string_view body;
+};
+
+// CannedReply 순서와 같다.
+constexpr CannedSpec CANNED_SPECS[] = {
+    {200, "status: ok\n"},
+    {405, "Method not allowed\n"},
+    {404, "Not found\n"},
+    {400, "Missing Host header\n"},
+    {400, "Malformed request\n"},
+    {431, "Request header too large\n"},
+    {413, "Request body too large\n"},
+    {400, "Invalid request body framing\n"},
+    {501, "Transfer-Encoding not supported\n"},
+    {502, "Bad gateway\n"},
+    {504, "Gateway timeout\n"},
+    {503, "Service unavailable\n"},
+};
+static_assert(std::size(CANNED_SPECS) == static_cast<std::size_t>(CannedReply::kCount),
+              "CannedReply 와 CANNED_SPECS 는 항목 수가 같아야 한다");
+
+constexpr const char *WEEKDAYS[] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+constexpr const char *MONTHS[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun",
+                                  "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+
+/**
+ * ByteWriter
+ * 설명:
+ *   - prepare 로 확보한 영역에 조각을 차례로 복사하는 커서. 길이는 호출자가 미리 계산해 확보한다.
+ */
+struct ByteWriter {
+    char *cursor;
+
+    void put(std::string_view bytes) {
+        std::memcpy(cursor, bytes.data(), bytes.size());
+        cursor += bytes.size();
+    }
+
+    void putNumber(std::size_t value) { cursor = std::to_chars(cursor, cursor + MAX_DIGITS, value).ptr; }
+};
+
+void writeTwoDigits(char *out, int value) {
+    out[0] = static_cast<char>('0' + value / 10);
+    out[1] = static_cast<char>('0' + value % 10);
+}
+
+/**
+ * daysFromCivil
+ * 설명:
+ *   - 그레고리력 날짜를 1970-01-01 부터의 일수로 바꾼다. 아래 formatHttpDate 계산의 역이다.
+ */
+long long daysFromCivil(long long year, int month, int day) {
+    year -= month <= 2 ? 1 : 0;
+    long long era = (year >= 0 ? year : year - 399) / 400;
+    long long yoe = year - era * 400;
+    long long doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    long long doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+bool parseDigits(std::string_view text, std::size_t pos, std::size_t count, int &out) {
+    out = 0;
+    for (std::size_t i = pos; i < pos + count; ++i) {
+        if (text[i] < '0' || text[i] > '9') {
+            return false;
+        }
+        out = out * 10 + (text[i] - '0');
+    }
+    return true;
+}
+
+/**
+ * formatDateLine
+ * 설명:
+ *   - 유닉스 시각을 "Date: Sun, 06 Nov 1994 08:49:37 GMT\r\n" 형식으로 쓴다.
+ */
+void formatDateLine(std::time_t now, char *out) {
+    std::memcpy(out, "Date: ", 6);
+    formatHttpDate(now, out + 6);
+    std::memcpy(out + 6 + HTTP_DATE_LENGTH, "\r\n", 2);
+}
+
+}  // namespace
+
+/**
+ * formatHttpDate
+ * 설명:
+ *   - 로캘/시간대에 의존하는 strftime/gmtime 대신 일수에서 그레고리력 날짜를 직접 계산한다.
+ */
+void formatHttpDate(std::time_t when, char *out) {
+    long long seconds = static_cast<long long>(when);
+    long long days = seconds / 86400;
+    long long rest = seconds % 86400;
+    if (rest < 0) {
+        rest += 86400;
+        --days;
+    }
+    int weekday = static_cast<int>(((days % 7) + 11) % 7);  // 1970-01-01 은 목요일
+
+    // 3월 1일 시작 400년 주기(era)로 바꿔 윤년 처리를 단순화한다.
+    long long z = days + 719468;
+    long long era = (z >= 0 ? z : z - 146096) / 146097;
+    long long doe = z - era * 146097;
+    long long yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    long long doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    long long mp = (5 * doy + 2) / 153;
+    int day = static_cast<int>(doy - (153 * mp + 2) / 5 + 1);
+    int month = static_cast<int>(mp < 10 ? mp + 3 : mp - 9);
+    long long year = yoe + era * 400 + (month <= 2 ? 1 : 0);
+
+    std::memcpy(out, WEEKDAYS[weekday], 3);
+    std::memcpy(out + 3, ", ", 2);
+    writeTwoDigits(out + 5, day);
+    out[7] = ' ';
+    std::memcpy(out + 8, MONTHS[month - 1], 3);
+    out[11] = ' ';
+    int y = static_cast<int>(year % 10000);
+    writeTwoDigits(out + 12, y / 100);
+    writeTwoDigits(out + 14, y % 100);
+    out[16] = ' ';
+    writeTwoDigits(out + 17, static_cast<int>(rest / 3600));
+    out[19] = ':';
+    writeTwoDigits(out + 20, static_cast<int>(rest / 60 % 60));
+    out[22] = ':';
+    writeTwoDigits(out + 23, static_cast<int>(rest % 60));
+    std::memcpy(out + 25, " GMT", 4);
+}
+
+bool parseHttpDate(std::string_view text, std::time_t &out) {
+    // "Sun, 06 Nov 1994 08:49:37 GMT": 요일은 검증하지 않는다(날짜에서 정해진다).
+    if (text.size() != HTTP_DATE_LENGTH || text.compare(3, 2, ", ") != 0 || text[7] != ' ' || text[11] != ' ' ||
+        text[16] != ' ' || text[19] != ':' || text[22] != ':' || text.compare(25, 4, " GMT") != 0) {
+        return false;
+    }
+    int month = 0;
+    for (int m = 0; m < 12; ++m) {
+        if (text.compare(8, 3, MONTHS[m]) == 0) {
+            month = m + 1;
+            break;
+        }
+    }
+    int day = 0;
+    int year = 0;
+    int hour = 0;
+    int minute = 0;
+    int second = 0;
+    if (month == 0 || !parseDigits(text, 5, 2, day) || !parseDigits(text, 12, 4, year) ||
+        !parseDigits(text, 17, 2, hour) || !parseDigits(text, 20, 2, minute) || !parseDigits(text, 23, 2, second) ||
+        day < 1 || day > 31 || hour > 23 || minute > 59 || second > 60) {
+        return false;
+    }
+    long long days = daysFromCivil(year, month, day);
+    out = static_cast<std::time_t>(days * 86400 + hour * 3600 + minute * 60 + second);
+    return true;
+}
+
+ResponseTemplates::ResponseTemplates(std::time_t now) : second_(now), date_line_{} {
+    render();
+}
+
+void ResponseTemplates::refresh(std::time_t now) {
+    if (now == second_) {
+        return;
+    }
+    second_ = now;
+    render();
+}
+
+void ResponseTemplates::render() {
+    formatDateLine(second_, date_line_);
+    for (std::size_t i = 0; i < std::size(CANNED_SPECS); ++i) {
+        const CannedSpec &spec = CANNED_SPECS[i];
+        for (int keep_alive = 0; keep_alive < 2; ++keep_alive) {
+            // 길이가 매번 같으므로 처음 한 번만 할당되고 이후에는 같은 용량을 다시 쓴다.
+            std::string &blob = rendered_[i][keep_alive];
+            blob.clear();
+            blob.append(statusLine(spec.status));
+            blob.append(TEXT_HEADERS);
+            char digits[MAX_DIGITS];
+            blob.append(digits, static_cast<std::size_t>(
+                                    std::to_chars(digits, digits + MAX_DIGITS, spec.body.size()).ptr - digits));
+            blob.append(CRLF);
+            blob.append(dateLine());
+            blob.append(keep_alive ? KEEP_ALIVE_TAIL : CLOSE_TAIL);
+            blob.append(spec.body);
+        }
+    }
+}
+
+void writeResponse(OutputQueue &output, int status, std::initializer_list<std::string_view> body, bool keep_alive,
+                   std::string_view date_line, std::string_view extra_headers) {
+    std::size_t body_size = 0;
+    for (std::string_view part : body) {
+        body_size += part.size();
+    }
+    std::string_view status_line = statusLine(status);
+    std::string_view tail = keep_alive ? KEEP_ALIVE_TAIL : CLOSE_TAIL;
+    std::size_t reserve = status_line.size() + TEXT_HEADERS.size() + MAX_DIGITS + CRLF.size() + date_line.size() +
+                          extra_headers.size() + tail.size() + body_size;
+
+    char *begin = output.prepare(reserve);
+    ByteWriter writer{begin};
+    writer.put(status_line);
+    writer.put(TEXT_HEADERS);
+    writer.putNumber(body_size);
+    writer.put(CRLF);
+    writer.put(date_line);
+    writer.put(extra_headers);
+    writer.put(tail);
+    for (std::string_view part : body) {
+        writer.put(part);
+    }
+    output.commit(static_cast<std::size_t>(writer.cursor - begin));
+}
+
+void writeFileResponseHeader(OutputQueue &output, std::size_t length, std::string_view content_type,
+                             std::string_view etag, bool keep_alive, std::string_view date_line,
+                             std::string_view extra_headers) {
+    std::string_view status_line = statusLine(200);
+    std::string_view tail = keep_alive ? KEEP_ALIVE_TAIL : CLOSE_TAIL;
+    std::size_t reserve = status_line.size() + FILE_TYPE_HEADER.size() + content_type.size() + LENGTH_HEADER.size() +
+                          MAX_DIGITS + ETAG_HEADER.size() + etag.size() + CRLF.size() + date_line.size() +
+                          extra_headers.size() + tail.size();
+
+    char *begin = output.prepare(reserve);
+    ByteWriter writer{begin};
+    writer.put(status_line);
+    writer.put(FILE_TYPE_HEADER);
+    writer.put(content_type);
+    writer.put(LENGTH_HEADER);
+    writer.putNumber(length);
+    writer.put(ETAG_HEADER);
+    writer.put(etag);
+    writer.put(CRLF);
+    writer.put(date_line);
+    writer.put(extra_headers);
+    writer.put(tail);
+    output.commit(static_cast<std::size_t>(writer.cursor - begin));
+}
+
+void writeNotModified(OutputQueue &output, bool keep_alive, std::string_view date_line,
+                      std::string_view validator_headers) {
+    std::string_view status_line = statusLine(304);
+    std::string_view tail = keep_alive ? KEEP_ALIVE_TAIL : CLOSE_TAIL;
+    std::size_t reserve = status_line.size() + date_line.size() + validator_headers.size() + tail.size();
+
+    char *begin = output.prepare(reserve);
+    ByteWriter writer{begin};
+    writer.put(status_line);
+    writer.put(date_line);
+    writer.put(validator_headers);
+    writer.put(tail);
+    output.commit(static_cast<std::size_t>(writer.cursor - begin));
+}
@@ -0,0 +1,210 @@
+#include "http_parser.hpp"
+
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ * [모듈] webserv-cpp17/src/http_parser.cpp
+ * 설명:
+ *   - 오프셋 기반 상태 머신으로 요청 라인과 헤더를 증분 파싱한다.
+ *   - 줄 끝 탐색은 SSE2 16바이트 비교, 헤더 조회는 고정 배열 선형 탐색으로 처리한다.
+ * 버전: v1.3.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.3.0-incremental-parser.md
+ * 변경 이력:
+ *   - v1.3.0: 증분 파서 추가
+ * 테스트:
+ *   - tests/test_webserv_incremental_parse.sh
+ */
+
+namespace {
+
+/**
+ * findNewline
+ * 설명:
+ *   - [begin, end) 구간에서 첫 '\n' 위치를 찾는다. 없으면 nullptr.
+ */
+const char *findNewline(const char *begin, const char *end) {
+#if defined(__SSE2__)
+    const __m128i needle = _mm_set1_epi8('\n');
+    while (end - begin >= 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle));
+        if (mask != 0) {
+            return begin + __builtin_ctz(static_cast<unsigned int>(mask));
+        }
+        begin += 16;
+    }
+    for (; begin < end; ++begin) {
+        if (*begin == '\n') {
+            return begin;
+        }
+    }
+    return nullptr;
+#else
+    return static_cast<const char *>(std::memchr(begin, '\n', static_cast<std::size_t>(end - begin)));
+#endif
+}
+
+inline char asciiLower(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+inline bool isSpace(char c) {
+    return c == ' ' || c == '\t';
+}
+
+}  // namespace
+
+bool equalsIgnoreCase(std::string_view lhs, std::string_view rhs) {
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < lhs.size(); ++i) {
+        if (asciiLower(lhs[i]) != asciiLower(rhs[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const HeaderField *HttpRequestView::findHeader(std::string_view name) const {
+    for (std::size_t i = 0; i < header_count; ++i) {
+        if (equalsIgnoreCase(headers[i].name, name)) {
+            return &headers[i];
+        }
+    }
+    return nullptr;
+}
+
+void HttpParser::reset() {
+    state_ = State::kRequestLine;
+    scan_pos_ = 0;
+    line_start_ = 0;
+    consumed_ = 0;
+    method_ = Span{0, 0};
+    path_ = Span{0, 0};
+    version_ = Span{0, 0};
+    header_count_ = 0;
+    request_.header_count = 0;
+}
+
+ParseStatus HttpParser::parse(const char *data, std::size_t size) {
+    while (scan_pos_ < size) {
+        const char *newline = findNewline(data + scan_pos_, data + size);
+        if (newline == nullptr) {
+            // 다음 호출은 이미 훑은 구간을 건너뛰고 새로 들어온 바이트부터 본다.
+            scan_pos_ = size;
+            return ParseStatus::kIncomplete;
+        }
+
+        std::size_t line_end = static_cast<std::size_t>(newline - data);
+        std::size_t content_end = line_end;
+        if (content_end > line_start_ && data[content_end - 1] == '\r') {
+            --content_end;
+        }
+        scan_pos_ = line_end + 1;
+
+        if (state_ == State::kRequestLine) {
+            if (content_end == line_start_) {
+                // 요청 사이의 빈 줄은 RFC 9112 권고대로 무시한다.
+                line_start_ = scan_pos_;
+                continue;
+            }
+            if (!parseRequestLine(data, line_start_, content_end)) {
+                return ParseStatus::kError;
+            }
+            state_ = State::kHeaderLine;
+        } else {
+            if (content_end == line_start_) {
+                consumed_ = scan_pos_;
+                materialize(data);
+                return ParseStatus::kComplete;
+            }
+            if (!parseHeaderLine(data, line_start_, content_end)) {
+                return ParseStatus::kError;
+            }
+        }
+        line_start_ = scan_pos_;
+    }
+    return ParseStatus::kIncomplete;
+}
+
+/**
+ * HttpParser::parseRequestLine
+ * 설명:
+ *   - "METHOD SP PATH SP VERSION" 을 공백 구간 기준으로 나눈다(연속 공백 허용).
+ *   - 세 토큰이 정확히 있어야 하며, 아니면 false.
+ */
+bool HttpParser::parseRequestLine(const char *data, std::size_t begin, std::size_t end) {
+    Span *targets[3] = {&method_, &path_, &version_};
+    std::size_t token = 0;
+    std::size_t i = begin;
+    while (i < end) {
+        while (i < end && isSpace(data[i])) {
+            ++i;
+        }
+        if (i == end) {
+            break;
+        }
+        std::size_t start = i;
+        while (i < end && !isSpace(data[i])) {
+            ++i;
+        }
+        if (token == 3) {
+            return false;
+        }
+        *targets[token++] = Span{static_cast<std::uint32_t>(start), static_cast<std::uint32_t>(i - start)};
+    }
+    return token == 3;
+}
+
+/**
+ * HttpParser::parseHeaderLine
+ * 설명:
+ *   - "name: value" 에서 값 앞뒤 공백을 제거해 저장한다.
+ *   - 콜론이 없는 줄은 v0.3.0 파서와 같이 무시한다. 헤더 수가 MAX_HEADERS 를 넘으면 false.
+ */
+bool HttpParser::parseHeaderLine(const char *data, std::size_t begin, std::size_t end) {
+    const char *colon = static_cast<const char *>(std::memchr(data + begin, ':', end - begin));
+    if (colon == nullptr) {
+        return true;
+    }
+    if (header_count_ == MAX_HEADERS) {
+        return false;
+    }
+
+    std::size_t name_end = static_cast<std::size_t>(colon - data);
+    std::size_t value_begin = name_end + 1;
+    while (value_begin < end && isSpace(data[value_begin])) {
+        ++value_begin;
+    }
+    std::size_t value_end = end;
+    while (value_end > value_begin && isSpace(data[value_end - 1])) {
+        --value_end;
+    }
+
+    header_spans_[header_count_++] = HeaderSpan{
+        Span{static_cast<std::uint32_t>(begin), static_cast<std::uint32_t>(name_end - begin)},
+        Span{static_cast<std::uint32_t>(value_begin), static_cast<std::uint32_t>(value_end - value_begin)}};
+    return true;
+}
+
+/**
+ * HttpParser::materialize
+ * 설명:
+ *   - 완성 시점의 버퍼 주소로 오프셋을 string_view 로 변환한다.
+ */
+void HttpParser::materialize(const char *data) {
+    auto view = [data](const Span &span) { return std::string_view(data + span.offset, span.length); };
+    request_.method = view(method_);
+    request_.path = view(path_);
+    request_.version = view(version_);
+    for (std::size_t i = 0; i < header_count_; ++i) {
+        request_.headers[i] = HeaderField{view(header_spans_[i].name), view(header_spans_[i].value)};
+    }
+    request_.header_count = header_count_;
+}
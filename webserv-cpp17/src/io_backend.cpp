@@ -0,0 +1,39 @@
+#include "io_backend.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#include "epoll_backend.hpp"
+#include "uring_backend.hpp"
+
+/**
+ * [모듈] webserv-cpp17/src/io_backend.cpp
+ * 설명:
+ *   - 설정에 맞는 I/O 백엔드를 만들고, io_uring 을 쓸 수 없으면 epoll 로 대신한다.
+ * 버전: v1.11.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.11.0-io-uring-backend.md
+ * 변경 이력:
+ *   - v1.11.0: 백엔드 팩토리 추가
+ * 테스트:
+ *   - tests/test_webserv_io_uring.sh
+ */
+
+std::unique_ptr<IoBackend> makeIoBackend(IoBackendKind kind, ConnectionPool &connections) {
+    if (kind == IoBackendKind::kIoUring) {
+        auto uring = std::make_unique<IoUringBackend>(connections);
+        if (uring->valid()) {
+            return uring;
+        }
+        // 컨테이너의 seccomp 정책이나 오래된 커널에서는 io_uring 을 못 쓴다. 서버는 그대로 띄운다.
+        std::cerr << "io_uring 준비 실패: " << std::strerror(uring->setupError()) << ", epoll 로 대신합니다."
+                  << std::endl;
+    }
+
+    auto epoll = std::make_unique<EpollBackend>();
+    if (!epoll->valid()) {
+        return nullptr;
+    }
+    return epoll;
+}
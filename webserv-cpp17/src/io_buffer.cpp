@@ -0,0 +1,251 @@
+#include "io_buffer.hpp"
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/sendfile.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+/**
+ * [모듈] webserv-cpp17/src/io_buffer.cpp
+ * 설명:
+ *   - 읽기 커서 입력 버퍼의 공간 확보(정리/확장)와 소비를 구현한다.
+ *   - 출력 큐의 묶음 송신과 부분 송신 이어 보내기를 구현한다.
+ *   - 출력 큐의 파일 구간을 sendfile 로 보낸다.
+ * 버전: v1.23.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.4.0-input-cursor-buffer.md
+ *   - design/webserv-cpp17/v1.5.0-output-queue.md
+ *   - design/webserv-cpp17/v1.6.0-static-files.md
+ *   - design/webserv-cpp17/v1.9.0-connection-pool.md
+ *   - design/webserv-cpp17/v1.10.0-zero-alloc-responses.md
+ *   - design/webserv-cpp17/v1.11.0-io-uring-backend.md
+ *   - design/webserv-cpp17/v1.20.0-accept-path.md
+ *   - design/webserv-cpp17/v1.22.0-tls.md
+ *   - design/webserv-cpp17/v1.23.0-http2.md
+ * 변경 이력:
+ *   - v1.4.0: InputBuffer 추가
+ *   - v1.5.0: OutputQueue 추가
+ *   - v1.6.0: FileHandle, sendfile 파일 구간 송신 추가
+ *   - v1.9.0: OutputQueue::clear 추가
+ *   - v1.10.0: 조각별 iovec 묶음 대신 연속 바이트 버퍼를 send 한 번으로 송신
+ *   - v1.11.0: 송신 구간 계산과 송신 반영을 sendable/markSent 로 분리
+ *   - v1.20.0: 파일 구간 뒤로 더 보낼 응답이 있으면 송신 동안 TCP_CORK 를 걸었다 풂
+ *   - v1.22.0: flushFile 을 pendingFile/markFileSent 위에 다시 씀
+ *   - v1.23.0: OutputQueue::frontFile 추가
+ * 테스트:
+ *   - tests/test_webserv_pipeline_depth.sh
+ *   - tests/test_webserv_slow_reader.sh
+ *   - tests/test_webserv_static_files.sh
+ *   - tests/test_webserv_alloc_free.sh
+ *   - tests/test_webserv_io_uring.sh
+ *   - tests/test_webserv_tls.sh
+ *   - tests/test_webserv_http2.sh
+ */
+
+InputBuffer::InputBuffer(std::size_t initial_capacity)
+    : storage_(new char[initial_capacity == 0 ? 1 : initial_capacity]),
+      capacity_(initial_capacity == 0 ? 1 : initial_capacity),
+      read_pos_(0),
+      write_pos_(0) {}
+
+char *InputBuffer::prepare(std::size_t min_space) {
+    if (writable() >= min_space) {
+        return storage_.get() + write_pos_;
+    }
+
+    std::size_t pending = size();
+    if (capacity_ - pending >= min_space) {
+        // 꼬리 공간만 모자라므로 미소비 구간을 앞으로 한 번 당긴다.
+        // 버퍼가 가득 찰 때만 일어나므로 바이트당 이동 비용은 상수로 상각된다.
+        std::memmove(storage_.get(), storage_.get() + read_pos_, pending);
+    } else {
+        std::size_t new_capacity = capacity_ * 2;
+        if (new_capacity < pending + min_space) {
+            new_capacity = pending + min_space;
+        }
+        std::unique_ptr<char[]> grown(new char[new_capacity]);
+        std::memcpy(grown.get(), storage_.get() + read_pos_, pending);
+        storage_ = std::move(grown);
+        capacity_ = new_capacity;
+    }
+    read_pos_ = 0;
+    write_pos_ = pending;
+    return storage_.get() + write_pos_;
+}
+
+void InputBuffer::consume(std::size_t bytes) {
+    read_pos_ += bytes;
+    if (read_pos_ >= write_pos_) {
+        read_pos_ = write_pos_ = 0;
+    }
+}
+
+FileHandle::~FileHandle() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+void OutputQueue::commit(std::size_t bytes) {
+    pending_.commit(bytes);
+    buffered_total_ += bytes;
+    bytes_ += bytes;
+    pushed_total_ += bytes;
+}
+
+void OutputQueue::append(std::string_view bytes) {
+    if (bytes.empty()) {
+        return;
+    }
+    std::memcpy(prepare(bytes.size()), bytes.data(), bytes.size());
+    commit(bytes.size());
+}
+
+void OutputQueue::pushFile(std::shared_ptr<const FileHandle> file, std::size_t offset, std::size_t length) {
+    if (length == 0) {
+        return;
+    }
+    bytes_ += length;
+    pushed_total_ += length;
+    files_.push_back(FileSegment{buffered_total_, std::move(file), offset, length});
+}
+
+std::string_view OutputQueue::sendable(bool &file_follows) const {
+    file_follows = !files_.empty();
+    std::size_t length = pending_.size();
+    if (file_follows) {
+        // 버퍼에서 이미 나간 바이트의 누적 위치. 맨 앞 파일 구간의 mark 에 닿으면 파일 차례다.
+        std::uint64_t buffered_sent = buffered_total_ - pending_.size();
+        length = static_cast<std::size_t>(files_.front().mark - buffered_sent);
+    }
+    return std::string_view(pending_.data(), length);
+}
+
+void OutputQueue::markSent(std::size_t bytes) {
+    pending_.consume(bytes);
+    bytes_ -= bytes;
+    sent_total_ += static_cast<std::uint64_t>(bytes);
+}
+
+FlushResult OutputQueue::flush(int fd, std::size_t &sent_out) {
+    sent_out = 0;
+    // 파이프라이닝된 파일 응답 여럿은 sendfile 마다 세그먼트가 끊겨 나간다. 큐에 파일 구간 뒤로 더 보낼 것이 있으면
+    // 이번 송신 동안 TCP_CORK 를 걸어 응답 경계에서 밀어내지 않고, 끝나면 풀어 남은 조각을 한 번에 내보낸다.
+    bool file_follows = false;
+    std::size_t before_file = sendable(file_follows).size();
+    bool cork = file_follows && bytes_ > before_file + (files_.front().length - file_sent_);
+    if (cork) {
+        setCork(fd, true);
+    }
+    FlushResult result = flushQueued(fd, sent_out);
+    if (cork) {
+        setCork(fd, false);
+    }
+    return result;
+}
+
+FlushResult OutputQueue::flushQueued(int fd, std::size_t &sent_out) {
+    while (bytes_ > 0) {
+        bool file_follows = false;
+        std::string_view chunk = sendable(file_follows);
+        if (chunk.empty()) {
+            FlushResult result = flushFile(fd, sent_out);
+            if (result != FlushResult::kDrained) {
+                return result;
+            }
+            continue;
+        }
+
+        // 뒤따르는 파일 본문과 헤더가 한 세그먼트로 나가도록 커널에 더 보낼 데이터가 있음을 알린다.
+        ssize_t sent = ::send(fd, chunk.data(), chunk.size(), MSG_NOSIGNAL | (file_follows ? MSG_MORE : 0));
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                return FlushResult::kBlocked;
+            }
+            return FlushResult::kError;
+        }
+        markSent(static_cast<std::size_t>(sent));
+        sent_out += static_cast<std::size_t>(sent);
+    }
+    return FlushResult::kDrained;
+}
+
+void OutputQueue::setCork(int fd, bool on) {
+    int value = on ? 1 : 0;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_CORK, &value, sizeof(value));
+}
+
+/**
+ * OutputQueue::flushFile
+ * 설명:
+ *   - 맨 앞 파일 구간을 sendfile 로 보낸다. 파일 내용은 페이지 캐시에서 소켓으로 바로 복사된다.
+ * 에러:
+ *   - 송신 도중 파일이 잘려 sendfile 이 0 을 돌려주면 응답 길이를 지킬 수 없으므로 kError 로 처리한다.
+ */
+FlushResult OutputQueue::flushFile(int fd, std::size_t &sent_out) {
+    for (;;) {
+        FileRange range = pendingFile();
+        off_t offset = static_cast<off_t>(range.offset);
+        ssize_t sent = ::sendfile(fd, range.fd, &offset, range.length);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                return FlushResult::kBlocked;
+            }
+            return FlushResult::kError;
+        }
+        if (sent == 0) {
+            errno = EIO;
+            return FlushResult::kError;
+        }
+        markFileSent(static_cast<std::size_t>(sent));
+        sent_out += static_cast<std::size_t>(sent);
+        if (static_cast<std::size_t>(sent) == range.length) {
+            return FlushResult::kDrained;
+        }
+    }
+}
+
+OutputQueue::FileRange OutputQueue::pendingFile() const {
+    const FileSegment &head = files_.front();
+    return FileRange{head.file->fd(), head.offset + file_sent_, head.length - file_sent_};
+}
+
+std::shared_ptr<const FileHandle> OutputQueue::frontFile(std::size_t &offset, std::size_t &length) const {
+    if (files_.empty()) {
+        return nullptr;
+    }
+    const FileSegment &head = files_.front();
+    offset = head.offset + file_sent_;
+    length = head.length - file_sent_;
+    return head.file;
+}
+
+void OutputQueue::markFileSent(std::size_t bytes) {
+    file_sent_ += bytes;
+    bytes_ -= bytes;
+    sent_total_ += static_cast<std::uint64_t>(bytes);
+    if (file_sent_ == files_.front().length) {
+        files_.pop_front();
+        file_sent_ = 0;
+    }
+}
+
+void OutputQueue::clear() {
+    pending_.clear();
+    files_.clear();
+    file_sent_ = 0;
+    buffered_total_ = 0;
+    bytes_ = 0;
+    pushed_total_ = 0;
+    sent_total_ = 0;
+}
@@ -0,0 +1,183 @@
+#include "listener_handoff.hpp"
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * [모듈] webserv-cpp17/src/listener_handoff.cpp
+ * 설명:
+ *   - 제어 소켓과 SCM_RIGHTS 로 리슨 FD 를 주고받는 통로를 구현한다.
+ * 버전: v1.25.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.25.0-config-reload.md
+ * 변경 이력:
+ *   - v1.25.0: openControlSocket, sendListeners, receiveListeners, sendReady 추가
+ * 테스트:
+ *   - tests/test_webserv_reload.sh
+ */
+
+namespace {
+
+// 머리 메시지. 다른 프로그램의 소켓에 잘못 붙었을 때 FD 를 받기 전에 알아챈다.
+struct HandoffHeader {
+    char magic[8];
+    std::uint32_t count;
+};
+
+constexpr char HANDOFF_MAGIC[8] = {'W', 'E', 'B', 'S', 'V', 'F', 'D', '1'};
+// 메시지 하나에 싣는 FD 수. 커널 한도(SCM_MAX_FD, 253)보다 작게 잡는다.
+constexpr std::size_t FD_BATCH = 64;
+constexpr char READY_BYTE = 'R';
+// 이전 프로세스가 FD 를 보내기까지 기다리는 시간. 제어 스레드의 poll 주기보다 넉넉히 길다.
+constexpr int HANDOFF_TIMEOUT_SEC = 5;
+
+bool fillAddress(const std::string &path, sockaddr_un &address, std::string &error) {
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+        error = "유닉스 소켓 경로가 비었거나 너무 깁니다: " + path;
+        return false;
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    return true;
+}
+
+void setTimeout(int fd, int option, int seconds) {
+    timeval timeout{};
+    timeout.tv_sec = seconds;
+    ::setsockopt(fd, SOL_SOCKET, option, &timeout, sizeof(timeout));
+}
+
+void closeAll(std::vector<int> &fds) {
+    for (int fd : fds) {
+        ::close(fd);
+    }
+    fds.clear();
+}
+
+}  // namespace
+
+int openControlSocket(const std::string &path, std::string &error) {
+    sockaddr_un address;
+    if (!fillAddress(path, address, error)) {
+        return -1;
+    }
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        error = std::string("제어 소켓 생성 실패: ") + std::strerror(errno);
+        return -1;
+    }
+    ::unlink(path.c_str());
+    // 바인드와 chmod 사이에 다른 사용자가 붙지 못하도록 만들 때부터 0600 으로 만든다.
+    mode_t previous = ::umask(0077);
+    int rc = ::bind(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address));
+    ::umask(previous);
+    if (rc != 0 || ::listen(fd, 4) != 0) {
+        error = "제어 소켓 바인드 실패 (" + path + "): " + std::strerror(errno);
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+bool sendListeners(int channel, const std::vector<int> &fds, std::string &error) {
+    setTimeout(channel, SO_SNDTIMEO, HANDOFF_TIMEOUT_SEC);
+    HandoffHeader header{};
+    std::memcpy(header.magic, HANDOFF_MAGIC, sizeof(header.magic));
+    header.count = static_cast<std::uint32_t>(fds.size());
+    if (::send(channel, &header, sizeof(header), MSG_NOSIGNAL) != static_cast<ssize_t>(sizeof(header))) {
+        error = std::string("리슨 소켓 목록 송신 실패: ") + std::strerror(errno);
+        return false;
+    }
+    for (std::size_t first = 0; first < fds.size(); first += FD_BATCH) {
+        std::size_t count = std::min(FD_BATCH, fds.size() - first);
+        char payload = 'F';
+        iovec iov{&payload, 1};
+        alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * FD_BATCH)];
+        msghdr message{};
+        message.msg_iov = &iov;
+        message.msg_iovlen = 1;
+        message.msg_control = control;
+        message.msg_controllen = CMSG_SPACE(sizeof(int) * count);
+        cmsghdr *cmsg = CMSG_FIRSTHDR(&message);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int) * count);
+        std::memcpy(CMSG_DATA(cmsg), fds.data() + first, sizeof(int) * count);
+        if (::sendmsg(channel, &message, MSG_NOSIGNAL) != 1) {
+            error = std::string("리슨 소켓 송신 실패: ") + std::strerror(errno);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool receiveListeners(const std::string &path, int &channel, std::vector<int> &fds, std::string &error) {
+    sockaddr_un address;
+    if (!fillAddress(path, address, error)) {
+        return false;
+    }
+    channel = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (channel < 0) {
+        error = std::string("제어 소켓 생성 실패: ") + std::strerror(errno);
+        return false;
+    }
+    auto fail = [&](const std::string &reason) {
+        error = reason;
+        closeAll(fds);
+        ::close(channel);
+        channel = -1;
+        return false;
+    };
+    if (::connect(channel, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0) {
+        return fail("이전 프로세스의 제어 소켓에 붙지 못했습니다 (" + path + "): " + std::strerror(errno));
+    }
+    setTimeout(channel, SO_RCVTIMEO, HANDOFF_TIMEOUT_SEC);
+
+    HandoffHeader header{};
+    if (::recv(channel, &header, sizeof(header), MSG_WAITALL) != static_cast<ssize_t>(sizeof(header)) ||
+        std::memcmp(header.magic, HANDOFF_MAGIC, sizeof(header.magic)) != 0) {
+        return fail("리슨 소켓 목록을 받지 못했습니다 (" + path + ")");
+    }
+    while (fds.size() < header.count) {
+        char payload = 0;
+        iovec iov{&payload, 1};
+        alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * FD_BATCH)];
+        msghdr message{};
+        message.msg_iov = &iov;
+        message.msg_iovlen = 1;
+        message.msg_control = control;
+        message.msg_controllen = sizeof(control);
+        ssize_t received = ::recvmsg(channel, &message, MSG_CMSG_CLOEXEC);
+        if (received != 1) {
+            return fail("리슨 소켓을 받는 중에 연결이 끊겼습니다 (" + path + ")");
+        }
+        for (cmsghdr *cmsg = CMSG_FIRSTHDR(&message); cmsg != nullptr; cmsg = CMSG_NXTHDR(&message, cmsg)) {
+            if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS) {
+                continue;
+            }
+            std::size_t count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+            const unsigned char *data = CMSG_DATA(cmsg);
+            for (std::size_t i = 0; i < count; ++i) {
+                int fd = -1;
+                std::memcpy(&fd, data + i * sizeof(int), sizeof(int));
+                fds.push_back(fd);
+            }
+        }
+        if ((message.msg_flags & MSG_CTRUNC) != 0) {
+            return fail("리슨 소켓 일부가 잘렸습니다(FD 한도를 확인하세요)");
+        }
+    }
+    return true;
+}
+
+bool sendReady(int channel) {
+    return ::send(channel, &READY_BYTE, 1, MSG_NOSIGNAL) == 1;
+}
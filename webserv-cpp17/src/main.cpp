@@ -1,467 +1,137 @@
 /**
  * [모듈] webserv-cpp17/src/main.cpp
  * 설명:
- *   - HTTP/1.1 Host 헤더와 keep-alive를 지원하는 단일 스레드 이벤트 루프를 제공한다.
- *   - v0.4.0에서 /health, /metrics 등 동적 라우팅 핸들러를 추가한다.
- * 버전: v0.4.0
+ *   - 명령행 인자를 ServerConfig 로 해석하고 Server 이벤트 루프를 실행하는 진입점.
+ * 버전: v1.25.0
  * 관련 설계문서:
- *   - design/webserv-cpp17/v0.1.0-basic-http-server.md
- *   - design/webserv-cpp17/v0.2.0-multi-connection-loop.md
- *   - design/webserv-cpp17/v0.3.0-http11-core.md
- *   - design/webserv-cpp17/v0.4.0-dynamic-handlers.md
+ *   - design/webserv-cpp17/v1.0.0-overview.md
+ *   - design/webserv-cpp17/v1.1.0-epoll-reactor.md
+ *   - design/webserv-cpp17/v1.2.0-reuseport-workers.md
+ *   - design/webserv-cpp17/v1.6.0-static-files.md
+ *   - design/webserv-cpp17/v1.8.0-timer-wheel.md
+ *   - design/webserv-cpp17/v1.11.0-io-uring-backend.md
+ *   - design/webserv-cpp17/v1.12.0-streaming-request-body.md
+ *   - design/webserv-cpp17/v1.14.0-response-compression.md
+ *   - design/webserv-cpp17/v1.15.0-response-cache.md
+ *   - design/webserv-cpp17/v1.16.0-reverse-proxy.md
+ *   - design/webserv-cpp17/v1.17.0-handler-offload.md
+ *   - design/webserv-cpp17/v1.19.0-load-generator.md
+ *   - design/webserv-cpp17/v1.20.0-accept-path.md
+ *   - design/webserv-cpp17/v1.21.0-access-log.md
+ *   - design/webserv-cpp17/v1.22.0-tls.md
+ *   - design/webserv-cpp17/v1.23.0-http2.md
+ *   - design/webserv-cpp17/v1.24.0-client-limits.md
+ *   - design/webserv-cpp17/v1.25.0-config-reload.md
  * 변경 이력:
  *   - v0.1.0: 단일 연결 처리 및 고정 응답 송신 기능 추가
  *   - v0.2.0: 비동기 다중 연결 루프와 타임아웃 관리 추가
  *   - v0.3.0: Host 헤더 검증, keep-alive 처리, 요청 파싱 개선
  *   - v0.4.0: 동적 엔드포인트(/health, /metrics) 라우팅 추가
+ *   - v1.1.0: 루프/파서를 모듈로 분리하고 epoll 리액터와 FD 한도 상향 추가
+ *   - v1.2.0: `--workers N` 멀티 워커 실행 추가
+ *   - v1.6.0: 정적 파일 옵션 안내와 SIGPIPE 무시(sendfile 송신 보호) 추가
+ *   - v1.8.0: 헤더 수신/송신 타임아웃 옵션 안내 추가
+ *   - v1.11.0: `--io-backend` 옵션 안내 추가
+ *   - v1.12.0: 헤더/본문 크기 제한 옵션과 `--demo-routes` 안내 추가
+ *   - v1.14.0: 응답 압축 옵션 안내 추가
+ *   - v1.15.0: 응답 캐시 옵션 안내 추가
+ *   - v1.16.0: 리버스 프록시 옵션 안내 추가
+ *   - v1.17.0: 블로킹 핸들러 작업 스레드 옵션 안내 추가
+ *   - v1.19.0: `--unlimited` 옵션 안내 추가
+ *   - v1.20.0: 수락 경로 옵션 안내 추가
+ *   - v1.21.0: 접근 로그 옵션 안내 추가
+ *   - v1.22.0: 사용법에 TLS 옵션 추가
+ *   - v1.23.0: 사용법에 HTTP/2 옵션 추가
+ *   - v1.24.0: 사용법에 클라이언트 한도와 과부하 옵션 추가
+ *   - v1.25.0: SIGHUP 다시 읽기용 ConfigLoader 를 Server 에 넘기고 새 옵션을 사용법에 추가
  * 테스트:
  *   - tests/test_webserv.sh
  *   - tests/test_webserv_multi.sh
  *   - tests/test_webserv_host_header.sh
  *   - tests/test_webserv_keepalive.sh
  *   - tests/test_webserv_dynamic.sh
+ *   - tests/test_webserv_epoll_many.sh
+ *   - tests/test_webserv_workers.sh
+ *   - tests/test_webserv_static_files.sh
+ *   - tests/test_webserv_timeouts.sh
+ *   - tests/test_webserv_io_uring.sh
+ *   - tests/test_webserv_request_body.sh
+ *   - tests/test_webserv_compression.sh
+ *   - tests/test_webserv_response_cache.sh
+ *   - tests/test_webserv_proxy.sh
+ *   - tests/test_webserv_offload.sh
+ *   - tests/test_webserv_bench.sh
+ *   - tests/test_webserv_accept.sh
+ *   - tests/test_webserv_access_log.sh
+ *   - tests/test_webserv_tls.sh
+ *   - tests/test_webserv_http2.sh
+ *   - tests/test_webserv_client_limits.sh
+ *   - tests/test_webserv_reload.sh
  */
 
-#include <arpa/inet.h>
-#include <fcntl.h>
-#include <netinet/in.h>
-#include <sys/socket.h>
-#include <unistd.h>
+#include <sys/resource.h>
 
-#include <cerrno>
 #include <csignal>
 #include <cstdlib>
-#include <cstring>
 #include <iostream>
-#include <map>
-#include <sstream>
 #include <string>
-#include <vector>
-#include <chrono>
 
-namespace {
-
-struct HttpRequest {
-    std::string method;
-    std::string path;
-    std::string version;
-    std::map<std::string, std::string> headers;
-};
-
-struct Connection {
-    int fd;
-    std::string buffer;
-    std::chrono::steady_clock::time_point last_active;
-    bool should_close;
-};
-
-/**
- * createListenSocket
- * 설명:
- *   - IPv4 TCP 소켓을 생성하고 지정된 포트로 바인드한 뒤 리슨 상태로 전환한다.
- * 입력:
- *   - port: 수신 포트 번호
- * 출력:
- *   - 성공 시 수신 소켓 FD, 실패 시 -1
- * 에러:
- *   - 소켓 생성/바인드/리슨 과정 실패 시 stderr에 한국어 메시지 출력 후 -1 반환
- * 관련 설계문서:
- *   - design/webserv-cpp17/v0.2.0-multi-connection-loop.md
- * 관련 테스트:
- *   - tests/test_webserv_multi.sh
- */
-int createListenSocket(uint16_t port) {
-    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
-    if (fd < 0) {
-        std::cerr << "소켓 생성 실패: " << std::strerror(errno) << std::endl;
-        return -1;
-    }
-
-    int opt = 1;
-    if (setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt)) < 0) {
-        std::cerr << "SO_REUSEADDR 설정 실패: " << std::strerror(errno) << std::endl;
-        ::close(fd);
-        return -1;
-    }
-
-    sockaddr_in addr;
-    std::memset(&addr, 0, sizeof(addr));
-    addr.sin_family = AF_INET;
-    addr.sin_addr.s_addr = htonl(INADDR_ANY);
-    addr.sin_port = htons(port);
-
-    if (bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0) {
-        std::cerr << "포트 바인드 실패: " << std::strerror(errno) << std::endl;
-        ::close(fd);
-        return -1;
-    }
-
-    if (listen(fd, 16) < 0) {
-        std::cerr << "리슨 실패: " << std::strerror(errno) << std::endl;
-        ::close(fd);
-        return -1;
-    }
-
-    int flags = fcntl(fd, F_GETFL, 0);
-    if (flags >= 0) {
-        fcntl(fd, F_SETFL, flags | O_NONBLOCK);
-    }
-
-    return fd;
-}
-
-/**
- * toLower
- * 설명:
- *   - 헤더 키 비교를 단순화하기 위해 소문자로 변환한다.
- */
-std::string toLower(const std::string &input) {
-    std::string lowered;
-    lowered.reserve(input.size());
-    for (char c : input) {
-        lowered.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(c))));
-    }
-    return lowered;
-}
-
-/**
- * parseHttpRequest
- * 설명:
- *   - 수신 버퍼에서 HTTP 요청 라인과 헤더를 파싱하고 소모한 길이를 반환한다.
- * 입력:
- *   - buffer: 현재까지 누적된 원시 요청 문자열
- * 출력:
- *   - 성공 시 HttpRequest와 소모 길이, 실패 시 false
- * 에러:
- *   - 헤더 구분자가 없으면 false를 반환하여 추가 데이터를 기다린다.
- *   - 형식 오류 시 false를 반환하고 호출자가 연결을 종료하도록 한다.
- * 관련 설계문서:
- *   - design/webserv-cpp17/v0.3.0-http11-core.md
- * 관련 테스트:
- *   - tests/test_webserv_host_header.sh
- */
-bool parseHttpRequest(const std::string &buffer, HttpRequest &out, std::size_t &consumed) {
-    std::size_t header_end = buffer.find("\r\n\r\n");
-    if (header_end == std::string::npos) {
-        return false;
-    }
-
-    std::istringstream stream(buffer.substr(0, header_end));
-    std::string request_line;
-    if (!std::getline(stream, request_line)) {
-        consumed = header_end + 4;
-        return false;
-    }
-
-    if (!request_line.empty() && request_line.back() == '\r') {
-        request_line.pop_back();
-    }
-
-    std::istringstream line_stream(request_line);
-    if (!(line_stream >> out.method >> out.path >> out.version)) {
-        consumed = header_end + 4;
-        return false;
-    }
-
-    std::string header_line;
-    while (std::getline(stream, header_line)) {
-        if (!header_line.empty() && header_line.back() == '\r') {
-            header_line.pop_back();
-        }
-        if (header_line.empty()) {
-            continue;
-        }
-        std::size_t colon = header_line.find(':');
-        if (colon == std::string::npos) {
-            continue;
-        }
-        std::string key = header_line.substr(0, colon);
-        std::string value = header_line.substr(colon + 1);
-        while (!value.empty() && value.front() == ' ') {
-            value.erase(value.begin());
-        }
-        out.headers[toLower(key)] = value;
-    }
-
-    consumed = header_end + 4;
-    return true;
-}
-
-/**
- * buildResponse
- * 설명:
- *   - 상태 코드, 본문, keep-alive 여부에 맞춰 HTTP 응답을 구성한다.
- * 입력:
- *   - status: HTTP 상태 코드
- *   - message: 본문 문자열
- *   - keep_alive: 연결을 유지할지 여부
- * 출력:
- *   - 직렬화된 HTTP 응답 문자열
- * 에러:
- *   - 없음 (고정 문자열 조합)
- * 관련 설계문서:
- *   - design/webserv-cpp17/v0.3.0-http11-core.md
- * 관련 테스트:
- *   - tests/test_webserv_keepalive.sh
- */
-std::string buildResponse(int status, const std::string &message, bool keep_alive) {
-    std::string status_line;
-    switch (status) {
-        case 200: status_line = "HTTP/1.1 200 OK\r\n"; break;
-        case 404: status_line = "HTTP/1.1 404 Not Found\r\n"; break;
-        case 405: status_line = "HTTP/1.1 405 Method Not Allowed\r\n"; break;
-        default: status_line = "HTTP/1.1 400 Bad Request\r\n"; break;
-    }
-
-    std::string connection_header = keep_alive ? "keep-alive" : "close";
-    std::string body = message;
-    std::string response = status_line +
-        "Content-Type: text/plain; charset=utf-8\r\n" +
-        "Content-Length: " + std::to_string(body.size()) + "\r\n" +
-        "Connection: " + connection_header + "\r\n\r\n" + body;
-
-    return response;
-}
-
-bool handleDynamicRoute(const HttpRequest &request, std::string &body, int &status) {
-    if (request.method != "GET") {
-        status = 405;
-        body = "Method not allowed\n";
-        return true;
-    }
+#include "server.hpp"
+#include "server_config.hpp"
 
-    if (request.path == "/health") {
-        status = 200;
-        body = "status: ok\n";
-        return true;
-    }
-
-    if (request.path == "/metrics") {
-        status = 200;
-        body = "requests_total 1\n";
-        return true;
-    }
-
-    return false;
-}
+namespace {
 
 /**
- * closeConnection
+ * raiseFdLimit
  * 설명:
- *   - 연결 FD를 닫고 목록에서 제거한다.
+ *   - 수만 개의 유휴 연결을 수용할 수 있도록 RLIMIT_NOFILE 소프트 한도를 하드 한도까지 올린다.
+ *   - 실패해도 기존 한도로 계속 동작하므로 오류를 무시한다.
  */
-void closeConnection(std::vector<Connection> &connections, std::size_t index) {
-    if (index >= connections.size()) {
-        return;
+void raiseFdLimit() {
+    rlimit limit{};
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
     }
-
-    ::close(connections[index].fd);
-    connections.erase(connections.begin() + static_cast<std::ptrdiff_t>(index));
-}
-
-/**
- * handleConnections
- * 설명:
- *   - select를 사용해 다중 연결을 감시하고, 요청 파싱/응답 전송을 수행한다.
- * 입력:
- *   - listen_fd: 수신 소켓 FD
- *   - connections: 현재 열린 연결 목록
- *   - timeout: 비활성 타임아웃
- *   - max_requests: 처리할 최대 요청 수
- *   - handled: 이미 처리한 요청 수
- * 출력:
- *   - 에러 없이 루프를 유지하면 true, 치명적 오류 시 false
- * 에러:
- *   - select/recv/send 실패 시 stderr에 한국어 메시지를 남기고 false를 반환한다.
- * 관련 설계문서:
- *   - design/webserv-cpp17/v0.3.0-http11-core.md
- * 관련 테스트:
- *   - tests/test_webserv_keepalive.sh
- */
-bool handleConnections(
-    int listen_fd,
-    std::vector<Connection> &connections,
-    const std::chrono::milliseconds &timeout,
-    std::size_t max_requests,
-    std::size_t &handled) {
-    fd_set read_set;
-    FD_ZERO(&read_set);
-    FD_SET(listen_fd, &read_set);
-
-    int max_fd = listen_fd;
-    for (const Connection &conn : connections) {
-        FD_SET(conn.fd, &read_set);
-        if (conn.fd > max_fd) {
-            max_fd = conn.fd;
-        }
-    }
-
-    timeval tv;
-    tv.tv_sec = timeout.count() / 1000;
-    tv.tv_usec = (timeout.count() % 1000) * 1000;
-
-    int ready = select(max_fd + 1, &read_set, nullptr, nullptr, &tv);
-    auto now = std::chrono::steady_clock::now();
-    if (ready < 0) {
-        if (errno == EINTR) {
-            return true;
-        }
-        std::cerr << "select 호출 실패: " << std::strerror(errno) << std::endl;
-        return false;
-    }
-
-    if (FD_ISSET(listen_fd, &read_set)) {
-        while (true) {
-            sockaddr_in client_addr;
-            socklen_t client_len = sizeof(client_addr);
-            int client_fd = accept(listen_fd, reinterpret_cast<sockaddr *>(&client_addr), &client_len);
-            if (client_fd < 0) {
-                if (errno == EAGAIN || errno == EWOULDBLOCK) {
-                    break;
-                }
-                std::cerr << "연결 수락 실패: " << std::strerror(errno) << std::endl;
-                break;
-            }
-
-            int flags = fcntl(client_fd, F_GETFL, 0);
-            if (flags >= 0) {
-                fcntl(client_fd, F_SETFL, flags | O_NONBLOCK);
-            }
-
-            connections.push_back(Connection{client_fd, std::string(), now, false});
-        }
-    }
-
-    for (std::size_t i = 0; i < connections.size();) {
-        bool erased = false;
-        Connection &conn = connections[i];
-        if (FD_ISSET(conn.fd, &read_set)) {
-            char buffer[4096];
-            ssize_t received = recv(conn.fd, buffer, sizeof(buffer), 0);
-            if (received <= 0) {
-                closeConnection(connections, i);
-                erased = true;
-            } else {
-                conn.buffer.append(buffer, static_cast<std::size_t>(received));
-                conn.last_active = now;
-
-                while (true) {
-                    HttpRequest request;
-                    std::size_t consumed = 0;
-                    if (!parseHttpRequest(conn.buffer, request, consumed)) {
-                        break;
-                    }
-
-                    bool is_http11 = (request.version == "HTTP/1.1");
-                    bool has_host = request.headers.find("host") != request.headers.end();
-
-                    bool keep_alive = false;
-                    if (is_http11) {
-                        keep_alive = request.headers.find("connection") == request.headers.end() ||
-                                     toLower(request.headers.find("connection")->second) != "close";
-                    } else if (request.version == "HTTP/1.0") {
-                        auto it = request.headers.find("connection");
-                        if (it != request.headers.end() && toLower(it->second) == "keep-alive") {
-                            keep_alive = true;
-                        }
-                    }
-
-                    std::string body;
-                    int status = 200;
-                    if (is_http11 && !has_host) {
-                        status = 400;
-                        keep_alive = false;
-                        body = "Missing Host header\n";
-                    } else if (!handleDynamicRoute(request, body, status)) {
-                        std::string host_value = has_host ? request.headers["host"] : "host-not-set";
-                        body = "Hello from webserv v0.4.0\nHost: " + host_value + "\n";
-                        body += keep_alive ? "Connection: keep-alive\n" : "Connection: close\n";
-                    }
-
-                    std::string response = buildResponse(status, body, keep_alive);
-                    ssize_t sent = send(conn.fd, response.c_str(), response.size(), 0);
-                    if (sent < 0) {
-                        std::cerr << "응답 송신 실패: " << std::strerror(errno) << std::endl;
-                        closeConnection(connections, i);
-                        erased = true;
-                        break;
-                    }
-
-                    handled++;
-                    conn.buffer.erase(0, consumed);
-                    if (!keep_alive || handled >= max_requests) {
-                        closeConnection(connections, i);
-                        erased = true;
-                        break;
-                    }
-                }
-            }
-        }
-
-        if (!erased) {
-            if (std::chrono::duration_cast<std::chrono::milliseconds>(now - conn.last_active) > timeout) {
-                std::cerr << "연결 타임아웃 발생" << std::endl;
-                closeConnection(connections, i);
-                erased = true;
-                ++handled;
-                if (handled >= max_requests) {
-                    break;
-                }
-            }
-        }
-
-        if (!erased) {
-            ++i;
-        }
-    }
-
-    return true;
 }
 
 }  // namespace
 
 int main(int argc, char *argv[]) {
-    uint16_t port = 8080;
-    if (argc >= 2) {
-        port = static_cast<uint16_t>(std::atoi(argv[1]));
-    }
-
-    std::size_t max_requests = 3;
-    if (argc >= 3) {
-        max_requests = static_cast<std::size_t>(std::strtoul(argv[2], nullptr, 10));
-        if (max_requests == 0) {
-            max_requests = 1;
-        }
-    }
-
-    int listen_fd = createListenSocket(port);
-    if (listen_fd < 0) {
+    ServerConfig config;
+    std::string error;
+    if (!parseCommandLine(argc, argv, config, error)) {
+        std::cerr << error << std::endl;
+        std::cerr << "사용법: webserv <port> [max_requests] [--idle-timeout-ms N] [--header-timeout-ms N]"
+                     " [--write-timeout-ms N] [--max-runtime-sec N] [--workers N] [--root DIR]"
+                     " [--file-cache-entries N] [--static-copy] [--io-backend epoll|uring]"
+                     " [--max-header-bytes N] [--max-body-bytes N] [--demo-routes] [--compression-level N]"
+                     " [--compression-cache-bytes N] [--compression-threads N] [--response-cache-bytes N]"
+                     " [--response-cache-ttl-ms N] [--proxy PREFIX=HOST:PORT[,HOST:PORT...]]"
+                     " [--proxy-balance round-robin|least-conn] [--upstream-keepalive N] [--proxy-timeout-ms N]"
+                     " [--handler-threads N] [--handler-queue N] [--unlimited] [--listen-backlog N]"
+                     " [--accept-batch N] [--defer-accept-sec N] [--tcp-fastopen N] [--tcp-nodelay on|off]"
+                     " [--access-log PATH] [--access-log-sample N] [--access-log-buffer N]"
+                     " [--tls-port N] [--tls-cert FILE] [--tls-key FILE] [--tls-session-cache N]"
+                     " [--tls-tickets on|off] [--tls-ktls on|off] [--http2 on|off] [--http2-max-streams N]"
+                     " [--http2-window N] [--client-rate N] [--client-burst N] [--client-connections N]"
+                     " [--client-table N] [--overload-lag-ms N] [--config FILE] [--port N] [--max-requests N]"
+                     " [--control-socket PATH] [--takeover PATH] [--drain-timeout-ms N]"
+                  << std::endl;
         return EXIT_FAILURE;
     }
 
-    std::vector<Connection> connections;
-    std::size_t handled = 0;
-    const std::chrono::milliseconds timeout(1500);
-    const auto start_time = std::chrono::steady_clock::now();
-
-    bool ok = true;
-    while (handled < max_requests) {
-        ok = handleConnections(listen_fd, connections, timeout, max_requests, handled);
-        if (!ok) {
-            break;
-        }
+    raiseFdLimit();
+    // sendfile 은 MSG_NOSIGNAL 같은 플래그가 없어 끊긴 연결에 쓰면 SIGPIPE 로 프로세스가 종료된다.
+    std::signal(SIGPIPE, SIG_IGN);
 
-        auto now = std::chrono::steady_clock::now();
-        if (std::chrono::duration_cast<std::chrono::seconds>(now - start_time).count() > 10) {
-            std::cerr << "최대 런타임을 초과하여 루프를 종료합니다." << std::endl;
-            break;
-        }
-    }
-
-    for (Connection &conn : connections) {
-        ::close(conn.fd);
+    // SIGHUP 에는 시작할 때와 같은 명령행을 다시 해석한다. `--config` 파일도 다시 읽는다.
+    Server server(config, [argc, argv](ServerConfig &loaded, std::string &reload_error) {
+        return parseCommandLine(argc, argv, loaded, reload_error);
+    });
+    if (!server.start()) {
+        return EXIT_FAILURE;
     }
-    ::close(listen_fd);
 
-    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+    return server.run() ? EXIT_SUCCESS : EXIT_FAILURE;
 }
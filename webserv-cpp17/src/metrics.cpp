@@ -0,0 +1,453 @@
+#include "metrics.hpp"
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <vector>
+
+/**
+ * [모듈] webserv-cpp17/src/metrics.cpp
+ * 설명:
+ *   - 로그-선형 지연 히스토그램과 워커별 계측 값의 합산/Prometheus 직렬화를 구현한다.
+ * 버전: v1.25.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.7.0-worker-metrics.md
+ *   - design/webserv-cpp17/v1.8.0-timer-wheel.md
+ *   - design/webserv-cpp17/v1.12.0-streaming-request-body.md
+ *   - design/webserv-cpp17/v1.13.0-router.md
+ *   - design/webserv-cpp17/v1.14.0-response-compression.md
+ *   - design/webserv-cpp17/v1.15.0-response-cache.md
+ *   - design/webserv-cpp17/v1.16.0-reverse-proxy.md
+ *   - design/webserv-cpp17/v1.17.0-handler-offload.md
+ *   - design/webserv-cpp17/v1.18.0-coroutine-handlers.md
+ *   - design/webserv-cpp17/v1.20.0-accept-path.md
+ *   - design/webserv-cpp17/v1.21.0-access-log.md
+ *   - design/webserv-cpp17/v1.22.0-tls.md
+ *   - design/webserv-cpp17/v1.23.0-http2.md
+ *   - design/webserv-cpp17/v1.24.0-client-limits.md
+ *   - design/webserv-cpp17/v1.25.0-config-reload.md
+ * 변경 이력:
+ *   - v1.7.0: 워커별 계측과 /metrics 직렬화 추가
+ *   - v1.8.0: `webserv_connection_timeouts_total{phase}` 추가
+ *   - v1.12.0: route="upload", code="413"/"431", phase="body" 라벨 추가
+ *   - v1.13.0: 워커 범위를 받아 합산하는 renderRange 로 나누고 renderWorker 추가
+ *   - v1.14.0: `webserv_compressed_responses_total{source}`, `webserv_precompressions_total` 추가
+ *   - v1.15.0: code="304" 라벨과 `webserv_response_cache_total{result}` 추가
+ *   - v1.16.0: route="proxy", code="502"/"504", phase="upstream" 라벨과 `webserv_upstream_connections_total{result}` 추가
+ *   - v1.17.0: route="delay", code="503" 라벨과 `webserv_offload_jobs_total{result}` 추가
+ *   - v1.18.0: route="sleep"/"echo"/"fetch" 라벨과 `webserv_coroutine_awaits_total{wait}` 추가
+ *   - v1.20.0: `webserv_accept_budget_exhausted_total` 추가
+ *   - v1.21.0: `webserv_access_log_records_total{result}` 추가
+ *   - v1.22.0: `webserv_tls_handshakes_total{result}`, `webserv_tls_ktls_send_total` 추가
+ *   - v1.23.0: `webserv_http2_connections_total{mode}`, `webserv_http2_streams_total{result}` 추가
+ *   - v1.24.0: code="429" 라벨과 `webserv_shed_total{reason}`, `webserv_client_untracked_total`, `webserv_overload_entered_total`, `webserv_overloaded_workers` 추가
+ *   - v1.25.0: webserv_config_generation, webserv_draining_workers, webserv_config_reloads_total{result} 렌더링
+ * 테스트:
+ *   - tests/test_webserv_metrics.sh
+ *   - tests/test_webserv_timeouts.sh
+ *   - tests/test_webserv_request_body.sh
+ *   - tests/test_webserv_router.sh
+ *   - tests/test_webserv_compression.sh
+ *   - tests/test_webserv_response_cache.sh
+ *   - tests/test_webserv_proxy.sh
+ *   - tests/test_webserv_offload.sh
+ *   - tests/test_webserv_coroutine.sh
+ *   - tests/test_webserv_accept.sh
+ *   - tests/test_webserv_access_log.sh
+ *   - tests/test_webserv_tls.sh
+ *   - tests/test_webserv_http2.sh
+ *   - tests/test_webserv_client_limits.sh
+ *   - tests/test_webserv_reload.sh
+ */
+
+namespace {
+
+const char *const ROUTE_NAMES[] = {"health", "metrics", "static", "default", "error", "upload", "proxy", "delay",
+                                   "sleep",  "echo",    "fetch"};
+const char *const STATUS_NAMES[] = {"200", "304", "400", "404", "405", "413",
+                                    "429", "431", "502", "503", "504", "other"};
+const char *const TIMEOUT_NAMES[] = {"header", "idle", "write", "body", "upstream"};
+const char *const COMPRESSION_NAMES[] = {"dynamic", "cache"};
+const char *const CACHE_NAMES[] = {"hit", "miss"};
+const char *const UPSTREAM_NAMES[] = {"connected", "reused", "retried", "failed"};
+const char *const OFFLOAD_NAMES[] = {"completed", "rejected"};
+const char *const COROUTINE_NAMES[] = {"body", "timer", "upstream"};
+const char *const ACCESS_LOG_NAMES[] = {"queued", "dropped"};
+const char *const TLS_HANDSHAKE_NAMES[] = {"full", "resumed", "failed"};
+const char *const HTTP2_CONNECTION_NAMES[] = {"prior_knowledge", "upgrade", "alpn"};
+const char *const HTTP2_STREAM_NAMES[] = {"completed", "peer_reset", "local_reset", "refused"};
+const char *const SHED_NAMES[] = {"rate", "connections", "overload"};
+const char *const RELOAD_NAMES[] = {"applied", "failed"};
+
+// Prometheus 히스토그램 경계(초). 내부 버킷은 더 촘촘하며, 상한이 경계 이하인 내부 버킷을 누적한다.
+const double EXPORT_BOUNDS[] = {0.00001, 0.000025, 0.00005, 0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005,
+                                0.01,    0.025,    0.05,    0.1,    0.25,    0.5,    1.0,   2.5,    5.0,   10.0};
+
+const double QUANTILES[] = {0.5, 0.9, 0.99, 0.999};
+
+void appendLine(std::string &out, const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+void appendLine(std::string &out, const char *format, ...) {
+    char line[256];
+    va_list args;
+    va_start(args, format);
+    int length = std::vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+    if (length > 0) {
+        out.append(line, static_cast<std::size_t>(length) < sizeof(line) ? static_cast<std::size_t>(length)
+                                                                          : sizeof(line) - 1);
+    }
+}
+
+}  // namespace
+
+StatusLabel statusLabelFor(int status) {
+    switch (status) {
+        case 200: return StatusLabel::k200;
+        case 304: return StatusLabel::k304;
+        case 400: return StatusLabel::k400;
+        case 404: return StatusLabel::k404;
+        case 405: return StatusLabel::k405;
+        case 413: return StatusLabel::k413;
+        case 429: return StatusLabel::k429;
+        case 431: return StatusLabel::k431;
+        case 502: return StatusLabel::k502;
+        case 503: return StatusLabel::k503;
+        case 504: return StatusLabel::k504;
+        default: return StatusLabel::kOther;
+    }
+}
+
+std::size_t LatencyHistogram::bucketFor(std::uint64_t nanos) {
+    if (nanos < SUB_COUNT) {
+        return static_cast<std::size_t>(nanos);
+    }
+    unsigned msb = 63u - static_cast<unsigned>(__builtin_clzll(nanos));
+    if (msb > MAX_BIT) {
+        return BUCKETS - 1;
+    }
+    unsigned shift = msb - SUB_BITS;
+    std::size_t sub = static_cast<std::size_t>(nanos >> shift) - SUB_COUNT;
+    return static_cast<std::size_t>(shift + 1) * SUB_COUNT + sub;
+}
+
+std::uint64_t LatencyHistogram::bucketUpper(std::size_t index) {
+    if (index < SUB_COUNT) {
+        return index + 1;
+    }
+    std::size_t group = index / SUB_COUNT;
+    std::size_t sub = index % SUB_COUNT;
+    return static_cast<std::uint64_t>(SUB_COUNT + sub + 1) << (group - 1);
+}
+
+void LatencyHistogram::record(std::uint64_t nanos) {
+    std::atomic<std::uint64_t> &bucket = counts_[bucketFor(nanos)];
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    sum_nanos_.store(sum_nanos_.load(std::memory_order_relaxed) + nanos, std::memory_order_relaxed);
+}
+
+MetricsRegistry::MetricsRegistry(std::size_t workers)
+    : count_(workers == 0 ? 1 : workers), workers_(new WorkerMetrics[count_]) {}
+
+std::string MetricsRegistry::render() const {
+    std::string out = renderRange(0, count_);
+    out += "# HELP webserv_config_reloads_total Configuration reloads requested by SIGHUP, by result.\n"
+           "# TYPE webserv_config_reloads_total counter\n";
+    for (std::size_t r = 0; r < static_cast<std::size_t>(ReloadLabel::kCount); ++r) {
+        appendLine(out, "webserv_config_reloads_total{result=\"%s\"} %llu\n", RELOAD_NAMES[r],
+                   static_cast<unsigned long long>(reloads_[r].load(std::memory_order_relaxed)));
+    }
+    return out;
+}
+
+std::string MetricsRegistry::renderWorker(std::size_t id) const {
+    return renderRange(id, id + 1);
+}
+
+std::string MetricsRegistry::renderRange(std::size_t first, std::size_t last) const {
+    constexpr std::size_t ROUTES = static_cast<std::size_t>(RouteLabel::kCount);
+    constexpr std::size_t STATUSES = static_cast<std::size_t>(StatusLabel::kCount);
+    constexpr std::size_t TIMEOUTS = static_cast<std::size_t>(TimeoutLabel::kCount);
+    constexpr std::size_t COMPRESSIONS = static_cast<std::size_t>(CompressionLabel::kCount);
+    constexpr std::size_t CACHE_RESULTS = static_cast<std::size_t>(CacheLabel::kCount);
+    constexpr std::size_t UPSTREAM_RESULTS = static_cast<std::size_t>(UpstreamLabel::kCount);
+    constexpr std::size_t OFFLOAD_RESULTS = static_cast<std::size_t>(OffloadLabel::kCount);
+    constexpr std::size_t COROUTINE_WAITS = static_cast<std::size_t>(CoroutineLabel::kCount);
+    constexpr std::size_t ACCESS_LOG_RESULTS = static_cast<std::size_t>(AccessLogLabel::kCount);
+    constexpr std::size_t TLS_HANDSHAKE_RESULTS = static_cast<std::size_t>(TlsHandshakeLabel::kCount);
+    constexpr std::size_t HTTP2_MODES = static_cast<std::size_t>(Http2ConnectionLabel::kCount);
+    constexpr std::size_t HTTP2_STREAM_RESULTS = static_cast<std::size_t>(Http2StreamLabel::kCount);
+    constexpr std::size_t SHED_REASONS = static_cast<std::size_t>(ShedLabel::kCount);
+
+    std::uint64_t requests[ROUTES][STATUSES] = {};
+    std::uint64_t bytes_in = 0;
+    std::uint64_t bytes_out = 0;
+    std::uint64_t accepted = 0;
+    std::uint64_t closed = 0;
+    std::uint64_t accept_budget_exhausted = 0;
+    std::uint64_t timeouts[TIMEOUTS] = {};
+    std::uint64_t compressed[COMPRESSIONS] = {};
+    std::uint64_t precompressed = 0;
+    std::uint64_t cache[CACHE_RESULTS] = {};
+    std::uint64_t upstream[UPSTREAM_RESULTS] = {};
+    std::uint64_t offload[OFFLOAD_RESULTS] = {};
+    std::uint64_t coroutine[COROUTINE_WAITS] = {};
+    std::uint64_t access_log[ACCESS_LOG_RESULTS] = {};
+    std::uint64_t tls_handshakes[TLS_HANDSHAKE_RESULTS] = {};
+    std::uint64_t tls_ktls_send = 0;
+    std::uint64_t http2_connections[HTTP2_MODES] = {};
+    std::uint64_t http2_streams[HTTP2_STREAM_RESULTS] = {};
+    std::uint64_t shed[SHED_REASONS] = {};
+    std::uint64_t client_untracked = 0;
+    std::uint64_t overload_entered = 0;
+    std::uint64_t overloaded = 0;
+    std::uint64_t config_generation = ~std::uint64_t{0};
+    std::uint64_t draining = 0;
+    std::uint64_t latency_sum = 0;
+    std::vector<std::uint64_t> buckets(LatencyHistogram::BUCKETS, 0);
+
+    for (std::size_t w = first; w < last; ++w) {
+        const WorkerMetrics &metrics = workers_[w];
+        for (std::size_t r = 0; r < ROUTES; ++r) {
+            for (std::size_t s = 0; s < STATUSES; ++s) {
+                requests[r][s] += metrics.requests[r][s].load(std::memory_order_relaxed);
+            }
+        }
+        bytes_in += metrics.bytes_in.load(std::memory_order_relaxed);
+        bytes_out += metrics.bytes_out.load(std::memory_order_relaxed);
+        accepted += metrics.accepted.load(std::memory_order_relaxed);
+        closed += metrics.closed.load(std::memory_order_relaxed);
+        accept_budget_exhausted += metrics.accept_budget_exhausted.load(std::memory_order_relaxed);
+        for (std::size_t t = 0; t < TIMEOUTS; ++t) {
+            timeouts[t] += metrics.timeouts[t].load(std::memory_order_relaxed);
+        }
+        for (std::size_t c = 0; c < COMPRESSIONS; ++c) {
+            compressed[c] += metrics.compressed[c].load(std::memory_order_relaxed);
+        }
+        precompressed += metrics.precompressed.load(std::memory_order_relaxed);
+        for (std::size_t c = 0; c < CACHE_RESULTS; ++c) {
+            cache[c] += metrics.cache[c].load(std::memory_order_relaxed);
+        }
+        for (std::size_t u = 0; u < UPSTREAM_RESULTS; ++u) {
+            upstream[u] += metrics.upstream[u].load(std::memory_order_relaxed);
+        }
+        for (std::size_t o = 0; o < OFFLOAD_RESULTS; ++o) {
+            offload[o] += metrics.offload[o].load(std::memory_order_relaxed);
+        }
+        for (std::size_t c = 0; c < COROUTINE_WAITS; ++c) {
+            coroutine[c] += metrics.coroutine[c].load(std::memory_order_relaxed);
+        }
+        for (std::size_t a = 0; a < ACCESS_LOG_RESULTS; ++a) {
+            access_log[a] += metrics.access_log[a].load(std::memory_order_relaxed);
+        }
+        for (std::size_t t = 0; t < TLS_HANDSHAKE_RESULTS; ++t) {
+            tls_handshakes[t] += metrics.tls_handshakes[t].load(std::memory_order_relaxed);
+        }
+        tls_ktls_send += metrics.tls_ktls_send.load(std::memory_order_relaxed);
+        for (std::size_t h = 0; h < HTTP2_MODES; ++h) {
+            http2_connections[h] += metrics.http2_connections[h].load(std::memory_order_relaxed);
+        }
+        for (std::size_t h = 0; h < HTTP2_STREAM_RESULTS; ++h) {
+            http2_streams[h] += metrics.http2_streams[h].load(std::memory_order_relaxed);
+        }
+        for (std::size_t r = 0; r < SHED_REASONS; ++r) {
+            shed[r] += metrics.shed[r].load(std::memory_order_relaxed);
+        }
+        client_untracked += metrics.client_untracked.load(std::memory_order_relaxed);
+        overload_entered += metrics.overload_entered.load(std::memory_order_relaxed);
+        overloaded += metrics.overloaded.load(std::memory_order_relaxed);
+        config_generation = std::min(config_generation, metrics.config_generation.load(std::memory_order_relaxed));
+        draining += metrics.draining.load(std::memory_order_relaxed);
+        latency_sum += metrics.latency.sumNanos();
+        for (std::size_t b = 0; b < LatencyHistogram::BUCKETS; ++b) {
+            buckets[b] += metrics.latency.count(b);
+        }
+    }
+
+    std::string out;
+    out.reserve(4096);
+
+    out += "# HELP webserv_requests_total Requests answered, by route and status code.\n"
+           "# TYPE webserv_requests_total counter\n";
+    for (std::size_t r = 0; r < ROUTES; ++r) {
+        for (std::size_t s = 0; s < STATUSES; ++s) {
+            if (requests[r][s] != 0) {
+                appendLine(out, "webserv_requests_total{route=\"%s\",code=\"%s\"} %llu\n", ROUTE_NAMES[r],
+                           STATUS_NAMES[s], static_cast<unsigned long long>(requests[r][s]));
+            }
+        }
+    }
+
+    appendLine(out,
+               "# HELP webserv_received_bytes_total Bytes read from client sockets.\n"
+               "# TYPE webserv_received_bytes_total counter\n"
+               "webserv_received_bytes_total %llu\n",
+               static_cast<unsigned long long>(bytes_in));
+    appendLine(out,
+               "# HELP webserv_sent_bytes_total Bytes written to client sockets.\n"
+               "# TYPE webserv_sent_bytes_total counter\n"
+               "webserv_sent_bytes_total %llu\n",
+               static_cast<unsigned long long>(bytes_out));
+    appendLine(out,
+               "# HELP webserv_connections_accepted_total Accepted client connections.\n"
+               "# TYPE webserv_connections_accepted_total counter\n"
+               "webserv_connections_accepted_total %llu\n",
+               static_cast<unsigned long long>(accepted));
+    appendLine(out,
+               "# HELP webserv_connections_active Currently open client connections.\n"
+               "# TYPE webserv_connections_active gauge\n"
+               "webserv_connections_active %llu\n",
+               static_cast<unsigned long long>(accepted >= closed ? accepted - closed : 0));
+    appendLine(out,
+               "# HELP webserv_accept_budget_exhausted_total Accept loops stopped by --accept-batch before the listen "
+               "queue was drained.\n"
+               "# TYPE webserv_accept_budget_exhausted_total counter\n"
+               "webserv_accept_budget_exhausted_total %llu\n",
+               static_cast<unsigned long long>(accept_budget_exhausted));
+    out += "# HELP webserv_connection_timeouts_total Connections closed by a timeout, by phase.\n"
+           "# TYPE webserv_connection_timeouts_total counter\n";
+    for (std::size_t t = 0; t < TIMEOUTS; ++t) {
+        appendLine(out, "webserv_connection_timeouts_total{phase=\"%s\"} %llu\n", TIMEOUT_NAMES[t],
+                   static_cast<unsigned long long>(timeouts[t]));
+    }
+    out += "# HELP webserv_compressed_responses_total Responses sent with a content coding, by body source.\n"
+           "# TYPE webserv_compressed_responses_total counter\n";
+    for (std::size_t c = 0; c < COMPRESSIONS; ++c) {
+        appendLine(out, "webserv_compressed_responses_total{source=\"%s\"} %llu\n", COMPRESSION_NAMES[c],
+                   static_cast<unsigned long long>(compressed[c]));
+    }
+    appendLine(out,
+               "# HELP webserv_precompressions_total Static file variants compressed for the precompressed cache.\n"
+               "# TYPE webserv_precompressions_total counter\n"
+               "webserv_precompressions_total %llu\n",
+               static_cast<unsigned long long>(precompressed));
+    out += "# HELP webserv_response_cache_total Cacheable route responses, by response cache lookup result.\n"
+           "# TYPE webserv_response_cache_total counter\n";
+    for (std::size_t c = 0; c < CACHE_RESULTS; ++c) {
+        appendLine(out, "webserv_response_cache_total{result=\"%s\"} %llu\n", CACHE_NAMES[c],
+                   static_cast<unsigned long long>(cache[c]));
+    }
+    out += "# HELP webserv_upstream_connections_total Proxied requests by how the upstream connection was obtained.\n"
+           "# TYPE webserv_upstream_connections_total counter\n";
+    for (std::size_t u = 0; u < UPSTREAM_RESULTS; ++u) {
+        appendLine(out, "webserv_upstream_connections_total{result=\"%s\"} %llu\n", UPSTREAM_NAMES[u],
+                   static_cast<unsigned long long>(upstream[u]));
+    }
+    out += "# HELP webserv_offload_jobs_total Blocking handler jobs, by handler thread result or queue rejection.\n"
+           "# TYPE webserv_offload_jobs_total counter\n";
+    for (std::size_t o = 0; o < OFFLOAD_RESULTS; ++o) {
+        appendLine(out, "webserv_offload_jobs_total{result=\"%s\"} %llu\n", OFFLOAD_NAMES[o],
+                   static_cast<unsigned long long>(offload[o]));
+    }
+    out += "# HELP webserv_coroutine_awaits_total Coroutine handler suspensions, by what the handler waited for.\n"
+           "# TYPE webserv_coroutine_awaits_total counter\n";
+    for (std::size_t c = 0; c < COROUTINE_WAITS; ++c) {
+        appendLine(out, "webserv_coroutine_awaits_total{wait=\"%s\"} %llu\n", COROUTINE_NAMES[c],
+                   static_cast<unsigned long long>(coroutine[c]));
+    }
+    out += "# HELP webserv_access_log_records_total Access log records queued for the writer thread or dropped on a "
+           "full ring.\n"
+           "# TYPE webserv_access_log_records_total counter\n";
+    for (std::size_t a = 0; a < ACCESS_LOG_RESULTS; ++a) {
+        appendLine(out, "webserv_access_log_records_total{result=\"%s\"} %llu\n", ACCESS_LOG_NAMES[a],
+                   static_cast<unsigned long long>(access_log[a]));
+    }
+    out += "# HELP webserv_tls_handshakes_total TLS handshakes on the TLS listener, by outcome (full, resumed from a "
+           "session ticket or cache, failed).\n"
+           "# TYPE webserv_tls_handshakes_total counter\n";
+    for (std::size_t t = 0; t < TLS_HANDSHAKE_RESULTS; ++t) {
+        appendLine(out, "webserv_tls_handshakes_total{result=\"%s\"} %llu\n", TLS_HANDSHAKE_NAMES[t],
+                   static_cast<unsigned long long>(tls_handshakes[t]));
+    }
+    appendLine(out,
+               "# HELP webserv_tls_ktls_send_total TLS connections whose send path was handed to kernel TLS.\n"
+               "# TYPE webserv_tls_ktls_send_total counter\n"
+               "webserv_tls_ktls_send_total %llu\n",
+               static_cast<unsigned long long>(tls_ktls_send));
+    out += "# HELP webserv_http2_connections_total HTTP/2 connections, by how they started (prior knowledge preface, "
+           "h2c upgrade, TLS ALPN).\n"
+           "# TYPE webserv_http2_connections_total counter\n";
+    for (std::size_t h = 0; h < HTTP2_MODES; ++h) {
+        appendLine(out, "webserv_http2_connections_total{mode=\"%s\"} %llu\n", HTTP2_CONNECTION_NAMES[h],
+                   static_cast<unsigned long long>(http2_connections[h]));
+    }
+    out += "# HELP webserv_http2_streams_total HTTP/2 streams, by how they ended (response completed, reset by the "
+           "client, reset by the server, refused over the concurrency limit).\n"
+           "# TYPE webserv_http2_streams_total counter\n";
+    for (std::size_t h = 0; h < HTTP2_STREAM_RESULTS; ++h) {
+        appendLine(out, "webserv_http2_streams_total{result=\"%s\"} %llu\n", HTTP2_STREAM_NAMES[h],
+                   static_cast<unsigned long long>(http2_streams[h]));
+    }
+    out += "# HELP webserv_shed_total Requests or connections turned away without being served, by reason (per-client "
+           "request rate, per-client connection limit, worker overload).\n"
+           "# TYPE webserv_shed_total counter\n";
+    for (std::size_t r = 0; r < SHED_REASONS; ++r) {
+        appendLine(out, "webserv_shed_total{reason=\"%s\"} %llu\n", SHED_NAMES[r],
+                   static_cast<unsigned long long>(shed[r]));
+    }
+    out += "# HELP webserv_client_untracked_total Connections accepted without a client table slot (table full), "
+           "so no per-client limit applied.\n"
+           "# TYPE webserv_client_untracked_total counter\n";
+    appendLine(out, "webserv_client_untracked_total %llu\n", static_cast<unsigned long long>(client_untracked));
+    out += "# HELP webserv_overload_entered_total Times a worker entered overload mode (event loop lag over "
+           "--overload-lag-ms).\n"
+           "# TYPE webserv_overload_entered_total counter\n";
+    appendLine(out, "webserv_overload_entered_total %llu\n", static_cast<unsigned long long>(overload_entered));
+    out += "# HELP webserv_overloaded_workers Workers currently in overload mode.\n"
+           "# TYPE webserv_overloaded_workers gauge\n";
+    appendLine(out, "webserv_overloaded_workers %llu\n", static_cast<unsigned long long>(overloaded));
+    out += "# HELP webserv_config_generation Oldest configuration generation still in use by a worker (0 = startup "
+           "config, +1 per SIGHUP reload).\n"
+           "# TYPE webserv_config_generation gauge\n";
+    appendLine(out, "webserv_config_generation %llu\n", static_cast<unsigned long long>(config_generation));
+    out += "# HELP webserv_draining_workers Workers that stopped accepting and are finishing open connections.\n"
+           "# TYPE webserv_draining_workers gauge\n";
+    appendLine(out, "webserv_draining_workers %llu\n", static_cast<unsigned long long>(draining));
+
+    std::uint64_t total = 0;
+    for (std::uint64_t count : buckets) {
+        total += count;
+    }
+
+    out += "# HELP webserv_request_duration_seconds Time from first request byte read to last response byte sent.\n"
+           "# TYPE webserv_request_duration_seconds histogram\n";
+    std::size_t next = 0;
+    std::uint64_t cumulative = 0;
+    for (double bound : EXPORT_BOUNDS) {
+        auto limit = static_cast<std::uint64_t>(bound * 1e9);
+        while (next < buckets.size() && LatencyHistogram::bucketUpper(next) <= limit) {
+            cumulative += buckets[next++];
+        }
+        appendLine(out, "webserv_request_duration_seconds_bucket{le=\"%g\"} %llu\n", bound,
+                   static_cast<unsigned long long>(cumulative));
+    }
+    appendLine(out,
+               "webserv_request_duration_seconds_bucket{le=\"+Inf\"} %llu\n"
+               "webserv_request_duration_seconds_sum %.9f\n"
+               "webserv_request_duration_seconds_count %llu\n",
+               static_cast<unsigned long long>(total), static_cast<double>(latency_sum) / 1e9,
+               static_cast<unsigned long long>(total));
+
+    // 내부 버킷 해상도로 계산한 분위수. 버킷 상한을 쓰므로 실제 값보다 최대 6.25% 크게 보고한다.
+    out += "# HELP webserv_request_duration_quantile_seconds Latency quantiles from the HDR histogram.\n"
+           "# TYPE webserv_request_duration_quantile_seconds gauge\n";
+    for (double quantile : QUANTILES) {
+        double value = 0.0;
+        if (total != 0) {
+            auto rank = static_cast<std::uint64_t>(quantile * static_cast<double>(total));
+            if (rank >= total) {
+                rank = total - 1;
+            }
+            std::uint64_t seen = 0;
+            for (std::size_t b = 0; b < buckets.size(); ++b) {
+                seen += buckets[b];
+                if (seen > rank) {
+                    value = static_cast<double>(LatencyHistogram::bucketUpper(b)) / 1e9;
+                    break;
+                }
+            }
+        }
+        appendLine(out, "webserv_request_duration_quantile_seconds{quantile=\"%g\"} %.9f\n", quantile, value);
+    }
+    return out;
+}
@@ -0,0 +1,383 @@
+#include "proxy.hpp"
+
+#include <netdb.h>
+
+#include <charconv>
+#include <cstring>
+
+/**
+ * [모듈] webserv-cpp17/src/proxy.cpp
+ * 설명:
+ *   - 업스트림 응답 헤더 해석, 프록시 요청/응답 헤더 재작성, 워커별 업스트림 연결 풀을 구현한다.
+ * 버전: v1.25.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.16.0-reverse-proxy.md
+ *   - design/webserv-cpp17/v1.18.0-coroutine-handlers.md
+ *   - design/webserv-cpp17/v1.25.0-config-reload.md
+ * 변경 이력:
+ *   - v1.16.0: ResponseHead, writeProxyRequest, writeProxyResponseHead, UpstreamPool 추가
+ *   - v1.18.0: 코루틴 핸들러가 업스트림에 보내는 GET 요청 헤더(writeFetchRequest) 추가
+ *   - v1.25.0: serverCount, busy 구현
+ * 테스트:
+ *   - tests/test_webserv_proxy.sh
+ *   - tests/test_webserv_coroutine.sh
+ *   - tests/test_webserv_reload.sh
+ */
+
+namespace {
+
+constexpr std::string_view CRLF = "\r\n";
+
+std::string_view trim(std::string_view text) {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t')) {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+/**
+ * hasToken
+ * 설명:
+ *   - 쉼표로 구분한 헤더 값(`Connection: close, Upgrade`)에 token 이 있는지 대소문자 없이 찾는다.
+ */
+bool hasToken(std::string_view list, std::string_view token) {
+    std::size_t pos = 0;
+    while (pos <= list.size()) {
+        std::size_t comma = list.find(',', pos);
+        if (comma == std::string_view::npos) {
+            comma = list.size();
+        }
+        if (equalsIgnoreCase(trim(list.substr(pos, comma - pos)), token)) {
+            return true;
+        }
+        pos = comma + 1;
+    }
+    return false;
+}
+
+/**
+ * isHopByHop
+ * 설명:
+ *   - 다음 홉으로 넘기지 않는 헤더인지 본다(RFC 9110 7.6.1). connection 은 같은 메시지의 Connection 값이다.
+ */
+bool isHopByHop(std::string_view name, const HeaderField *connection) {
+    for (std::string_view hop : {"connection", "keep-alive", "proxy-connection", "te", "upgrade"}) {
+        if (equalsIgnoreCase(name, hop)) {
+            return true;
+        }
+    }
+    return connection != nullptr && hasToken(connection->value, name);
+}
+
+void appendHeader(std::string &out, std::string_view name, std::string_view value) {
+    out.append(name);
+    out.append(": ");
+    out.append(value);
+    out.append(CRLF);
+}
+
+/**
+ * parseStatusLine
+ * 설명:
+ *   - `HTTP/1.x SP 3DIGIT [SP reason]` 을 나눈다. 이유 구절은 비어 있어도 된다.
+ */
+bool parseStatusLine(std::string_view line, ResponseHead &head) {
+    if (line.size() < 12 || line.compare(0, 7, "HTTP/1.") != 0 || line[8] != ' ') {
+        return false;
+    }
+    head.fields.version = line.substr(0, 8);
+    int status = 0;
+    auto parsed = std::from_chars(line.data() + 9, line.data() + 12, status);
+    if (parsed.ec != std::errc() || parsed.ptr != line.data() + 12 || status < 100) {
+        return false;
+    }
+    if (line.size() > 12 && line[12] != ' ') {
+        return false;
+    }
+    head.status = status;
+    head.reason = line.size() > 13 ? line.substr(13) : std::string_view();
+    return true;
+}
+
+}  // namespace
+
+ParseStatus parseResponseHead(const char *data, std::size_t size, std::size_t &scan, ResponseHead &head) {
+    // 빈 줄(LF 바로 뒤의 LF 또는 CRLF)을 찾는다. 뒤 바이트가 아직 없으면 그 LF 부터 다시 본다.
+    std::size_t end = 0;
+    while (scan < size) {
+        const char *newline = static_cast<const char *>(std::memchr(data + scan, '\n', size - scan));
+        if (newline == nullptr) {
+            scan = size;
+            return ParseStatus::kIncomplete;
+        }
+        std::size_t at = static_cast<std::size_t>(newline - data);
+        if (at + 1 >= size || (data[at + 1] == '\r' && at + 2 >= size)) {
+            scan = at;
+            return ParseStatus::kIncomplete;
+        }
+        if (data[at + 1] == '\n') {
+            end = at + 2;
+            break;
+        }
+        if (data[at + 1] == '\r' && data[at + 2] == '\n') {
+            end = at + 3;
+            break;
+        }
+        scan = at + 1;
+    }
+    if (end == 0) {
+        return ParseStatus::kIncomplete;
+    }
+
+    head.fields.method = std::string_view();
+    head.fields.path = std::string_view();
+    head.fields.header_count = 0;
+    head.length = end;
+    std::string_view rest(data, end);
+    bool first = true;
+    while (!rest.empty()) {
+        std::size_t newline = rest.find('\n');
+        std::string_view line = rest.substr(0, newline);
+        rest.remove_prefix(newline + 1);
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        if (first) {
+            if (!parseStatusLine(line, head)) {
+                return ParseStatus::kError;
+            }
+            first = false;
+            continue;
+        }
+        if (line.empty()) {
+            break;
+        }
+        std::size_t colon = line.find(':');
+        // 접힌 줄(obs-fold)과 이름 없는 줄은 받지 않는다(RFC 9112 5.2).
+        if (colon == std::string_view::npos || colon == 0 || line[0] == ' ' || line[0] == '\t' ||
+            line[colon - 1] == ' ' || line[colon - 1] == '\t') {
+            return ParseStatus::kError;
+        }
+        if (head.fields.header_count == MAX_HEADERS) {
+            return ParseStatus::kError;
+        }
+        head.fields.headers[head.fields.header_count++] = HeaderField{line.substr(0, colon),
+                                                                      trim(line.substr(colon + 1))};
+    }
+    return ParseStatus::kComplete;
+}
+
+ResponseFraming responseFramingFor(const ResponseHead &head, bool head_request, BodySpec &spec) {
+    if (head_request || head.status < 200 || head.status == 204 || head.status == 304) {
+        return ResponseFraming::kNone;
+    }
+    spec = bodySpecFor(head.fields);
+    switch (spec.framing) {
+        case BodyFraming::kLength:
+            return spec.length == 0 ? ResponseFraming::kNone : ResponseFraming::kLength;
+        case BodyFraming::kChunked:
+            return ResponseFraming::kChunked;
+        case BodyFraming::kNone:
+            return ResponseFraming::kUntilClose;
+        default:
+            return ResponseFraming::kInvalid;
+    }
+}
+
+bool upstreamKeepsAlive(const ResponseHead &head) {
+    const HeaderField *connection = head.fields.findHeader("connection");
+    if (head.fields.version == "HTTP/1.1") {
+        return connection == nullptr || !hasToken(connection->value, "close");
+    }
+    return connection != nullptr && hasToken(connection->value, "keep-alive");
+}
+
+void writeProxyRequest(std::string &out, const HttpRequestView &request, std::string_view client_ip,
+                       std::string_view default_host) {
+    const HeaderField *connection = request.findHeader("connection");
+    out.clear();
+    out.append(request.method);
+    out.push_back(' ');
+    out.append(request.path);
+    out.append(" HTTP/1.1\r\n");
+
+    bool has_host = false;
+    std::string_view forwarded_for;
+    for (std::size_t i = 0; i < request.header_count; ++i) {
+        const HeaderField &field = request.headers[i];
+        if (isHopByHop(field.name, connection) || equalsIgnoreCase(field.name, "expect") ||
+            equalsIgnoreCase(field.name, "x-real-ip")) {
+            continue;
+        }
+        if (equalsIgnoreCase(field.name, "x-forwarded-for")) {
+            // 여러 줄이면 마지막 줄 뒤에 붙인다. 앞 줄들은 그대로 넘긴다.
+            if (!forwarded_for.empty()) {
+                appendHeader(out, "X-Forwarded-For", forwarded_for);
+            }
+            forwarded_for = field.value;
+            continue;
+        }
+        has_host = has_host || equalsIgnoreCase(field.name, "host");
+        appendHeader(out, field.name, field.value);
+    }
+    if (!has_host) {
+        appendHeader(out, "Host", default_host);
+    }
+    appendHeader(out, "X-Real-IP", client_ip);
+    out.append("X-Forwarded-For: ");
+    if (!forwarded_for.empty()) {
+        out.append(forwarded_for);
+        out.append(", ");
+    }
+    out.append(client_ip);
+    out.append("\r\nConnection: keep-alive\r\n\r\n");
+}
+
+void writeFetchRequest(std::string &out, std::string_view target, std::string_view host, std::string_view client_ip) {
+    out.clear();
+    out.append("GET ");
+    out.append(target);
+    out.append(" HTTP/1.1\r\n");
+    appendHeader(out, "Host", host);
+    appendHeader(out, "X-Real-IP", client_ip);
+    out.append("Connection: keep-alive\r\n\r\n");
+}
+
+void writeProxyResponseHead(OutputQueue &output, const ResponseHead &head, bool keep_alive, bool dechunk) {
+    const HeaderField *connection = head.fields.findHeader("connection");
+    char digits[3];
+    std::to_chars(digits, digits + sizeof(digits), head.status);
+    output.append("HTTP/1.1 ");
+    output.append(std::string_view(digits, sizeof(digits)));
+    output.append(" ");
+    output.append(head.reason);
+    output.append(CRLF);
+    for (std::size_t i = 0; i < head.fields.header_count; ++i) {
+        const HeaderField &field = head.fields.headers[i];
+        if (isHopByHop(field.name, connection) || (dechunk && equalsIgnoreCase(field.name, "transfer-encoding"))) {
+            continue;
+        }
+        output.append(field.name);
+        output.append(": ");
+        output.append(field.value);
+        output.append(CRLF);
+    }
+    output.append(keep_alive ? "Connection: keep-alive\r\n\r\n" : "Connection: close\r\n\r\n");
+}
+
+UpstreamPool::UpstreamPool(const std::vector<ProxyTarget> &targets, ProxyBalance balance, std::size_t keepalive)
+    : balance_(balance), keepalive_(keepalive) {
+    for (const ProxyTarget &target : targets) {
+        Route route;
+        route.prefix = target.prefix;
+        for (const std::string &upstream : target.upstreams) {
+            std::size_t server = 0;
+            while (server < servers_.size() && servers_[server].name != upstream) {
+                ++server;
+            }
+            if (server == servers_.size()) {
+                servers_.emplace_back();
+                servers_.back().name = upstream;
+            }
+            route.servers.push_back(server);
+        }
+        routes_.push_back(std::move(route));
+    }
+}
+
+bool UpstreamPool::resolve(std::string &error) {
+    for (Server &server : servers_) {
+        std::size_t colon = server.name.rfind(':');
+        std::string host = server.name.substr(0, colon);
+        std::string port = server.name.substr(colon + 1);
+        if (host.size() >= 2 && host.front() == '[' && host.back() == ']') {
+            host = host.substr(1, host.size() - 2);
+        }
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo *found = nullptr;
+        int rc = ::getaddrinfo(host.c_str(), port.c_str(), &hints, &found);
+        if (rc != 0 || found == nullptr) {
+            error = "업스트림 주소 해석 실패: " + server.name + " (" + ::gai_strerror(rc) + ")";
+            return false;
+        }
+        std::memcpy(&server.address, found->ai_addr, found->ai_addrlen);
+        server.address_length = found->ai_addrlen;
+        ::freeaddrinfo(found);
+    }
+    return true;
+}
+
+int UpstreamPool::match(std::string_view path) const {
+    int best = -1;
+    std::size_t best_length = 0;
+    for (std::size_t i = 0; i < routes_.size(); ++i) {
+        const std::string &prefix = routes_[i].prefix;
+        if ((best < 0 || prefix.size() > best_length) && path.compare(0, prefix.size(), prefix) == 0) {
+            best = static_cast<int>(i);
+            best_length = prefix.size();
+        }
+    }
+    return best;
+}
+
+std::size_t UpstreamPool::pick(std::size_t route) {
+    Route &entry = routes_[route];
+    std::size_t count = entry.servers.size();
+    std::size_t start = entry.next;
+    entry.next = (entry.next + 1) % count;
+    if (balance_ == ProxyBalance::kRoundRobin) {
+        return entry.servers[start];
+    }
+    // 진행 중 요청이 가장 적은 서버. 같으면 라운드 로빈 순서로 먼저 오는 서버라 부하가 고르게 돈다.
+    std::size_t best = entry.servers[start];
+    for (std::size_t i = 1; i < count; ++i) {
+        std::size_t server = entry.servers[(start + i) % count];
+        if (servers_[server].active < servers_[best].active) {
+            best = server;
+        }
+    }
+    return best;
+}
+
+std::uint64_t UpstreamPool::takeIdle(std::size_t server) {
+    std::vector<std::uint64_t> &idle = servers_[server].idle;
+    if (idle.empty()) {
+        return 0;
+    }
+    std::uint64_t handle = idle.back();
+    idle.pop_back();
+    return handle;
+}
+
+bool UpstreamPool::park(std::size_t server, std::uint64_t handle) {
+    std::vector<std::uint64_t> &idle = servers_[server].idle;
+    if (idle.size() >= keepalive_) {
+        return false;
+    }
+    idle.push_back(handle);
+    return true;
+}
+
+void UpstreamPool::forget(std::size_t server, std::uint64_t handle) {
+    std::vector<std::uint64_t> &idle = servers_[server].idle;
+    for (std::size_t i = 0; i < idle.size(); ++i) {
+        if (idle[i] == handle) {
+            idle.erase(idle.begin() + static_cast<std::ptrdiff_t>(i));
+            return;
+        }
+    }
+}
+
+bool UpstreamPool::busy() const {
+    for (const Server &server : servers_) {
+        if (server.active != 0) {
+            return true;
+        }
+    }
+    return false;
+}
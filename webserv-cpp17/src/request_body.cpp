@@ -0,0 +1,276 @@
+#include "request_body.hpp"
+
+#include <array>
+#include <cstring>
+
+/**
+ * [모듈] webserv-cpp17/src/request_body.cpp
+ * 설명:
+ *   - Content-Length/Transfer-Encoding 해석, chunked 증분 디코더, 업로드 CRC-32 핸들러를 구현한다.
+ * 버전: v1.12.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.12.0-streaming-request-body.md
+ * 변경 이력:
+ *   - v1.12.0: 요청 본문 스트리밍 처리 추가
+ * 테스트:
+ *   - tests/test_webserv_request_body.sh
+ */
+
+namespace {
+
+// 청크 크기는 16진수 15자리(2^60 미만)까지 받는다. 더 길면 형식 오류로 본다.
+constexpr std::size_t MAX_CHUNK_SIZE_DIGITS = 15;
+
+constexpr std::array<std::uint32_t, 256> makeCrcTable() {
+    std::array<std::uint32_t, 256> table{};
+    for (std::uint32_t i = 0; i < 256; ++i) {
+        std::uint32_t value = i;
+        for (int bit = 0; bit < 8; ++bit) {
+            value = (value & 1u) != 0 ? (value >> 1) ^ 0xedb88320u : value >> 1;
+        }
+        table[i] = value;
+    }
+    return table;
+}
+
+constexpr std::array<std::uint32_t, 256> CRC_TABLE = makeCrcTable();
+static_assert(CRC_TABLE[1] == 0x77073096u, "CRC-32 표는 컴파일 타임에 만든다");
+
+std::string_view trim(std::string_view value) {
+    while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) {
+        value.remove_prefix(1);
+    }
+    while (!value.empty() && (value.back() == ' ' || value.back() == '\t')) {
+        value.remove_suffix(1);
+    }
+    return value;
+}
+
+/**
+ * parseContentLength
+ * 설명:
+ *   - 1*DIGIT 만 받는다. 부호, 공백, 쉼표 목록은 거절한다. 20자리를 넘는 값은 최댓값으로 둔다(어차피 제한 초과).
+ */
+bool parseContentLength(std::string_view text, std::uint64_t &out) {
+    if (text.empty()) {
+        return false;
+    }
+    std::uint64_t value = 0;
+    for (char c : text) {
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        std::uint64_t digit = static_cast<std::uint64_t>(c - '0');
+        value = value > (UINT64_MAX - digit) / 10 ? UINT64_MAX : value * 10 + digit;
+    }
+    out = value;
+    return true;
+}
+
+int hexValue(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+/**
+ * takeLine
+ * 설명:
+ *   - data[0..size) 에서 LF 로 끝나는 줄 하나를 찾는다. 줄 끝 CR 은 내용에서 뺀다.
+ * 출력:
+ *   - 찾으면 줄 전체 길이(LF 포함), 아직 없으면 0. line 에 CR/LF 를 뺀 내용
+ */
+std::size_t takeLine(const char *data, std::size_t size, std::string_view &line) {
+    const char *newline = static_cast<const char *>(std::memchr(data, '\n', size));
+    if (newline == nullptr) {
+        return 0;
+    }
+    std::size_t length = static_cast<std::size_t>(newline - data);
+    std::size_t content = length;
+    if (content > 0 && data[content - 1] == '\r') {
+        --content;
+    }
+    line = std::string_view(data, content);
+    return length + 1;
+}
+
+}  // namespace
+
+BodySpec bodySpecFor(const HttpRequestView &request) {
+    BodySpec spec;
+    const HeaderField *transfer_encoding = nullptr;
+    bool has_length = false;
+    for (std::size_t i = 0; i < request.header_count; ++i) {
+        const HeaderField &field = request.headers[i];
+        if (equalsIgnoreCase(field.name, "content-length")) {
+            std::uint64_t value = 0;
+            if (!parseContentLength(field.value, value) || (has_length && value != spec.length)) {
+                spec.framing = BodyFraming::kInvalid;
+                return spec;
+            }
+            has_length = true;
+            spec.length = value;
+        } else if (equalsIgnoreCase(field.name, "transfer-encoding")) {
+            if (transfer_encoding != nullptr) {
+                // 여러 줄로 나뉜 전송 코딩 목록은 chunked 하나만 지원하는 이 서버에서는 의미가 없다.
+                spec.framing = BodyFraming::kUnsupported;
+                return spec;
+            }
+            transfer_encoding = &field;
+        }
+    }
+
+    if (transfer_encoding != nullptr) {
+        if (has_length || request.version != "HTTP/1.1") {
+            spec.framing = BodyFraming::kInvalid;
+            return spec;
+        }
+        std::string_view codings = transfer_encoding->value;
+        std::size_t comma = codings.rfind(',');
+        std::string_view last = trim(comma == std::string_view::npos ? codings : codings.substr(comma + 1));
+        if (!equalsIgnoreCase(last, "chunked")) {
+            // 마지막 코딩이 chunked 가 아니면 본문 끝을 알 수 없다(RFC 9112 6.3).
+            spec.framing = BodyFraming::kInvalid;
+        } else if (comma != std::string_view::npos) {
+            spec.framing = BodyFraming::kUnsupported;
+        } else {
+            spec.framing = BodyFraming::kChunked;
+        }
+        return spec;
+    }
+    if (has_length) {
+        spec.framing = BodyFraming::kLength;
+    }
+    return spec;
+}
+
+void BodyDecoder::start(const BodySpec &spec, std::uint64_t limit) {
+    received_ = 0;
+    limit_ = limit;
+    trailer_bytes_ = 0;
+    if (spec.framing == BodyFraming::kChunked) {
+        state_ = State::kChunkSize;
+        remaining_ = 0;
+    } else {
+        state_ = State::kFixed;
+        remaining_ = spec.length;
+    }
+}
+
+BodyStatus BodyDecoder::next(const char *data, std::size_t size, std::size_t &consumed, std::string_view &slice) {
+    consumed = 0;
+    while (true) {
+        const char *cursor = data + consumed;
+        std::size_t available = size - consumed;
+        switch (state_) {
+            case State::kIdle:
+                return BodyStatus::kDone;
+
+            case State::kFixed:
+            case State::kChunkData: {
+                if (remaining_ == 0) {
+                    if (state_ == State::kFixed) {
+                        state_ = State::kIdle;
+                        return BodyStatus::kDone;
+                    }
+                    state_ = State::kChunkEnd;
+                    continue;
+                }
+                if (available == 0) {
+                    return BodyStatus::kNeedMore;
+                }
+                std::size_t take = remaining_ < available ? static_cast<std::size_t>(remaining_) : available;
+                slice = std::string_view(cursor, take);
+                remaining_ -= take;
+                received_ += take;
+                consumed += take;
+                return BodyStatus::kSlice;
+            }
+
+            case State::kChunkSize: {
+                std::string_view line;
+                std::size_t length = takeLine(cursor, available, line);
+                if (length == 0) {
+                    return available > MAX_LINE ? BodyStatus::kError : BodyStatus::kNeedMore;
+                }
+                if (length > MAX_LINE) {
+                    return BodyStatus::kError;
+                }
+                std::uint64_t chunk = 0;
+                std::size_t digits = 0;
+                while (digits < line.size() && hexValue(line[digits]) >= 0) {
+                    chunk = (chunk << 4) | static_cast<std::uint64_t>(hexValue(line[digits]));
+                    ++digits;
+                }
+                std::string_view rest = trim(line.substr(digits));
+                if (digits == 0 || digits > MAX_CHUNK_SIZE_DIGITS || (!rest.empty() && rest.front() != ';')) {
+                    return BodyStatus::kError;
+                }
+                consumed += length;
+                if (chunk == 0) {
+                    state_ = State::kTrailer;
+                    continue;
+                }
+                if (chunk > limit_ - received_) {
+                    return BodyStatus::kTooLarge;
+                }
+                remaining_ = chunk;
+                state_ = State::kChunkData;
+                continue;
+            }
+
+            case State::kChunkEnd: {
+                if (available == 0) {
+                    return BodyStatus::kNeedMore;
+                }
+                if (cursor[0] == '\n') {
+                    consumed += 1;
+                } else if (cursor[0] != '\r') {
+                    return BodyStatus::kError;
+                } else if (available < 2) {
+                    return BodyStatus::kNeedMore;
+                } else if (cursor[1] != '\n') {
+                    return BodyStatus::kError;
+                } else {
+                    consumed += 2;
+                }
+                state_ = State::kChunkSize;
+                continue;
+            }
+
+            case State::kTrailer: {
+                std::string_view line;
+                std::size_t length = takeLine(cursor, available, line);
+                if (length == 0) {
+                    return available > MAX_LINE ? BodyStatus::kError : BodyStatus::kNeedMore;
+                }
+                trailer_bytes_ += length;
+                if (length > MAX_LINE || trailer_bytes_ > MAX_TRAILER) {
+                    return BodyStatus::kError;
+                }
+                consumed += length;
+                if (line.empty()) {
+                    state_ = State::kIdle;
+                    return BodyStatus::kDone;
+                }
+                continue;
+            }
+        }
+    }
+}
+
+void UploadDigest::update(std::string_view slice) {
+    std::uint32_t value = ~crc;
+    for (char c : slice) {
+        value = CRC_TABLE[(value ^ static_cast<unsigned char>(c)) & 0xffu] ^ (value >> 8);
+    }
+    crc = ~value;
+    bytes += slice.size();
+}
@@ -0,0 +1,214 @@
+#include "response_cache.hpp"
+
+#include <iterator>
+
+#include "http_message.hpp"
+
+/**
+ * [모듈] webserv-cpp17/src/response_cache.cpp
+ * 설명:
+ *   - 워커별 응답 캐시(LRU + TTL + 바이트 한도)와 조건부 요청 판정을 구현한다.
+ * 버전: v1.15.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.15.0-response-cache.md
+ * 변경 이력:
+ *   - v1.15.0: ResponseCache, etagMatches, isNotModified 추가
+ * 테스트:
+ *   - tests/test_webserv_response_cache.sh
+ */
+
+namespace {
+
+constexpr std::string_view ETAG_PREFIX = "ETag: ";
+constexpr std::string_view LAST_MODIFIED_PREFIX = "\r\nLast-Modified: ";
+constexpr std::string_view CODING_SUFFIXES[] = {"", "-gzip", "-deflate"};
+
+std::uint64_t fnv1a(std::string_view bytes) {
+    std::uint64_t hash = 0xcbf29ce484222325ull;
+    for (unsigned char c : bytes) {
+        hash ^= c;
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+std::string_view trim(std::string_view text) {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t')) {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+std::string_view stripWeak(std::string_view tag) {
+    if (tag.size() >= 2 && tag[0] == 'W' && tag[1] == '/') {
+        tag.remove_prefix(2);
+    }
+    return tag;
+}
+
+}  // namespace
+
+bool etagMatches(std::string_view if_none_match, std::string_view etag) {
+    std::string_view target = stripWeak(etag);
+    std::size_t pos = 0;
+    while (pos <= if_none_match.size()) {
+        std::size_t comma = if_none_match.find(',', pos);
+        if (comma == std::string_view::npos) {
+            comma = if_none_match.size();
+        }
+        std::string_view item = trim(if_none_match.substr(pos, comma - pos));
+        if (item == "*" || (!item.empty() && stripWeak(item) == target)) {
+            return true;
+        }
+        pos = comma + 1;
+    }
+    return false;
+}
+
+bool isNotModified(const HttpRequestView &request, std::string_view etag, std::time_t last_modified) {
+    if (const HeaderField *if_none_match = request.findHeader("if-none-match")) {
+        return etagMatches(if_none_match->value, etag);
+    }
+    const HeaderField *if_modified_since = request.findHeader("if-modified-since");
+    std::time_t since = 0;
+    return last_modified >= 0 && if_modified_since != nullptr && parseHttpDate(if_modified_since->value, since) &&
+           last_modified <= since;
+}
+
+ResponseCache::ResponseCache(std::size_t capacity, std::chrono::milliseconds ttl, bool vary)
+    : capacity_(capacity), ttl_(ttl), vary_(vary) {}
+
+CachedResponse *ResponseCache::find(std::string_view method, std::string_view host, std::string_view target,
+                                    std::chrono::steady_clock::time_point now) {
+    key_.clear();
+    key_.append(method);
+    key_.push_back('\0');
+    key_.append(host);
+    key_.push_back('\0');
+    key_.append(target);
+
+    auto found = index_.find(key_);
+    if (found == index_.end() || now >= found->second->expires) {
+        return nullptr;
+    }
+    lru_.splice(lru_.begin(), lru_, found->second);
+    return &found->second->response;
+}
+
+CachedResponse *ResponseCache::store(std::string_view body, RouteLabel route, std::time_t wall_now,
+                                     std::chrono::steady_clock::time_point now) {
+    auto found = index_.find(key_);
+    if (key_.size() + body.size() > capacity_) {
+        if (found != index_.end()) {
+            evict(found->second);
+        }
+        return nullptr;
+    }
+
+    bool created = found == index_.end();
+    if (created) {
+        lru_.emplace_front();
+        lru_.front().key = key_;
+        index_.emplace(key_, lru_.begin());
+    } else {
+        lru_.splice(lru_.begin(), lru_, found->second);
+    }
+    Entry &entry = lru_.front();
+    entry.expires = now + ttl_;
+
+    CachedResponse &response = entry.response;
+    response.route = route;
+    std::uint64_t hash = fnv1a(body);
+    if (created || hash != response.hash || response.bodies[0] != body) {
+        response.hash = hash;
+        response.last_modified = wall_now;
+        response.bodies[0].assign(body.data(), body.size());
+        for (std::size_t i = 1; i < 3; ++i) {
+            response.bodies[i].clear();
+            response.ready[i] = false;
+        }
+        renderValidators(response);
+    }
+    account(entry);
+    while (bytes_ > capacity_ && lru_.size() > 1) {
+        evict(std::prev(lru_.end()));
+    }
+    return &response;
+}
+
+std::string_view ResponseCache::encode(CachedResponse &entry, ContentCoding &coding, Compressor *compressor) {
+    auto index = static_cast<std::size_t>(coding);
+    if (coding == ContentCoding::kIdentity || entry.ready[index]) {
+        return entry.bodies[index];
+    }
+    if (compressor == nullptr || entry.bodies[0].size() < MIN_COMPRESS_BYTES ||
+        !compressor->compress(coding, {entry.bodies[0]})) {
+        coding = ContentCoding::kIdentity;
+        return entry.bodies[0];
+    }
+
+    auto found = index_.find(key_);
+    if (found == index_.end() || found->second->bytes + compressor->output().size() > capacity_) {
+        // 압축본까지 넣으면 한도를 넘는다. 이번 응답만 압축 결과를 쓰고 보관하지 않는다.
+        return compressor->output();
+    }
+    entry.bodies[index].assign(compressor->output().data(), compressor->output().size());
+    entry.ready[index] = true;
+    account(*found->second);
+    while (bytes_ > capacity_ && lru_.size() > 1) {
+        evict(std::prev(lru_.end()));
+    }
+    return entry.bodies[index];
+}
+
+/**
+ * ResponseCache::renderValidators
+ * 설명:
+ *   - 해시로 코딩별 ETag 를 만들고, 응답에 붙일 헤더 줄을 미리 이어 둔다. 본문이 바뀔 때만 부른다.
+ */
+void ResponseCache::renderValidators(CachedResponse &response) const {
+    char hex[16];
+    for (int i = 15; i >= 0; --i) {
+        hex[15 - i] = "0123456789abcdef"[(response.hash >> (i * 4)) & 0xfu];
+    }
+    char date[HTTP_DATE_LENGTH];
+    formatHttpDate(response.last_modified, date);
+
+    for (std::size_t i = 0; i < 3; ++i) {
+        std::string &etag = response.etags[i];
+        etag.clear();
+        etag.push_back('"');
+        etag.append(hex, sizeof(hex));
+        etag.append(CODING_SUFFIXES[i]);
+        etag.push_back('"');
+
+        std::string &headers = response.headers[i];
+        headers.clear();
+        headers.append(ETAG_PREFIX);
+        headers.append(etag);
+        headers.append(LAST_MODIFIED_PREFIX);
+        headers.append(date, sizeof(date));
+        headers.append("\r\n");
+        if (vary_) {
+            headers.append(codingHeaders(static_cast<ContentCoding>(i)));
+        }
+    }
+}
+
+void ResponseCache::account(Entry &entry) {
+    std::size_t bytes = entry.key.size();
+    for (std::size_t i = 0; i < 3; ++i) {
+        bytes += entry.response.etags[i].size() + entry.response.headers[i].size() + entry.response.bodies[i].size();
+    }
+    bytes_ = bytes_ - entry.bytes + bytes;
+    entry.bytes = bytes;
+}
+
+void ResponseCache::evict(EntryList::iterator it) {
+    bytes_ -= it->bytes;
+    index_.erase(it->key);
+    lru_.erase(it);
+}
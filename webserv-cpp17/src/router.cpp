@@ -0,0 +1,255 @@
+#include "router.hpp"
+
+/**
+ * [모듈] webserv-cpp17/src/router.cpp
+ * 설명:
+ *   - 메서드 토큰 해석과 기수 트리 라우터(RadixRouter)의 등록/조회를 구현한다.
+ * 버전: v1.13.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.13.0-router.md
+ * 변경 이력:
+ *   - v1.13.0: 기수 트리 라우터 추가
+ * 테스트:
+ *   - tests/test_webserv_router.sh
+ */
+
+namespace {
+
+std::size_t commonPrefix(std::string_view lhs, std::string_view rhs) {
+    std::size_t length = lhs.size() < rhs.size() ? lhs.size() : rhs.size();
+    std::size_t i = 0;
+    while (i < length && lhs[i] == rhs[i]) {
+        ++i;
+    }
+    return i;
+}
+
+}  // namespace
+
+HttpMethod parseHttpMethod(std::string_view method) {
+    switch (method.size()) {
+        case 3:
+            if (method == "GET") {
+                return HttpMethod::kGet;
+            }
+            if (method == "PUT") {
+                return HttpMethod::kPut;
+            }
+            break;
+        case 4:
+            if (method == "HEAD") {
+                return HttpMethod::kHead;
+            }
+            if (method == "POST") {
+                return HttpMethod::kPost;
+            }
+            break;
+        case 5:
+            if (method == "PATCH") {
+                return HttpMethod::kPatch;
+            }
+            break;
+        case 6:
+            if (method == "DELETE") {
+                return HttpMethod::kDelete;
+            }
+            break;
+        case 7:
+            if (method == "OPTIONS") {
+                return HttpMethod::kOptions;
+            }
+            break;
+        default:
+            break;
+    }
+    return HttpMethod::kOther;
+}
+
+RadixRouter::RadixRouter() {
+    nodes_.emplace_back();
+    nodes_.back().handlers.fill(NO_ROUTE);
+}
+
+/**
+ * RadixRouter::insertStatic
+ * 설명:
+ *   - node 아래에 고정 문자열 text 를 넣고 text 끝에 해당하는 노드를 돌려준다.
+ *   - 기존 자식과 공통 접두사만 겹치면 자식을 둘로 나눈다. 이때 자식 노드 번호는 앞부분이 그대로 갖고,
+ *     뒷부분을 새 노드로 옮겨 부모의 자식 목록을 고칠 필요가 없게 한다.
+ */
+std::uint32_t RadixRouter::insertStatic(std::uint32_t node, std::string_view text) {
+    while (!text.empty()) {
+        std::size_t slot = nodes_[node].child_keys.find(text.front());
+        if (slot == std::string::npos) {
+            Node child;
+            child.prefix = std::string(text);
+            child.handlers.fill(NO_ROUTE);
+            std::uint32_t index = static_cast<std::uint32_t>(nodes_.size());
+            nodes_.push_back(std::move(child));
+            nodes_[node].child_keys.push_back(text.front());
+            nodes_[node].children.push_back(index);
+            return index;
+        }
+
+        std::uint32_t child = nodes_[node].children[slot];
+        std::size_t common = commonPrefix(nodes_[child].prefix, text);
+        if (common < nodes_[child].prefix.size()) {
+            Node tail = std::move(nodes_[child]);
+            Node &head = nodes_[child];
+            head = Node();
+            head.prefix = tail.prefix.substr(0, common);
+            head.handlers.fill(NO_ROUTE);
+            tail.prefix.erase(0, common);
+            std::uint32_t index = static_cast<std::uint32_t>(nodes_.size());
+            head.child_keys.push_back(tail.prefix.front());
+            head.children.push_back(index);
+            nodes_.push_back(std::move(tail));
+        }
+        node = child;
+        text.remove_prefix(common);
+    }
+    return node;
+}
+
+bool RadixRouter::add(HttpMethod method, std::string_view pattern, RouteId id) {
+    if (method == HttpMethod::kOther || method == HttpMethod::kCount || id == NO_ROUTE || pattern.empty() ||
+        pattern.front() != '/') {
+        return false;
+    }
+
+    // 먼저 패턴 전체를 검사해 실패할 때 트리를 건드리지 않게 한다.
+    std::size_t params = 0;
+    for (std::size_t i = 0; i < pattern.size(); ++i) {
+        char c = pattern[i];
+        if (c != ':' && c != '*') {
+            continue;
+        }
+        if (pattern[i - 1] != '/') {
+            return false;  // 매개변수는 구간 시작에만 올 수 있다
+        }
+        std::size_t end = pattern.find('/', i);
+        if (end == std::string_view::npos) {
+            end = pattern.size();
+        }
+        if (end == i + 1 || (c == '*' && end != pattern.size()) ||
+            pattern.substr(i + 1, end - i - 1).find_first_of(":*") != std::string_view::npos) {
+            return false;
+        }
+        if (++params > RouteParams::MAX_PARAMS) {
+            return false;
+        }
+        i = end;
+    }
+
+    // 이름 충돌과 중복은 트리를 따라가며 알게 된다. 그 전에 만든 노드 나누기와 빈 중간 노드는
+    // 핸들러가 없어 조회 결과를 바꾸지 않으므로 되돌리지 않는다.
+    std::uint32_t node = 0;
+    std::size_t position = 0;
+    bool ok = true;
+    while (position < pattern.size() && ok) {
+        std::size_t special = pattern.find_first_of(":*", position);
+        std::size_t static_end = special == std::string_view::npos ? pattern.size() : special;
+        if (static_end > position) {
+            node = insertStatic(node, pattern.substr(position, static_end - position));
+        }
+        if (special == std::string_view::npos) {
+            break;
+        }
+        std::size_t end = pattern.find('/', special);
+        if (end == std::string_view::npos) {
+            end = pattern.size();
+        }
+        std::string_view name = pattern.substr(special + 1, end - special - 1);
+        bool catch_all = pattern[special] == '*';
+        std::uint32_t existing = catch_all ? nodes_[node].catch_all_child : nodes_[node].param_child;
+        if (existing == NO_NODE) {
+            Node child;
+            child.param_name = std::string(name);
+            child.handlers.fill(NO_ROUTE);
+            existing = static_cast<std::uint32_t>(nodes_.size());
+            nodes_.push_back(std::move(child));
+            (catch_all ? nodes_[node].catch_all_child : nodes_[node].param_child) = existing;
+        } else if (nodes_[existing].param_name != name) {
+            ok = false;
+        }
+        node = existing;
+        position = end;
+    }
+
+    std::size_t slot = static_cast<std::size_t>(method);
+    if (!ok || nodes_[node].handlers[slot] != NO_ROUTE) {
+        return false;
+    }
+    nodes_[node].handlers[slot] = id;
+    nodes_[node].terminal = true;
+    ++routes_;
+    return true;
+}
+
+/**
+ * RadixRouter::find
+ * 설명:
+ *   - node 의 prefix 까지 맞은 상태에서 남은 경로 rest 에 맞는 종단 노드를 찾는다.
+ *   - 고정 자식 > 매개변수 자식 > 나머지 경로 자식 순으로 시도하고, 실패하면 넣었던 매개변수를 되돌린다.
+ * 출력:
+ *   - 종단 노드 번호, 없으면 NO_NODE
+ */
+std::uint32_t RadixRouter::find(std::uint32_t index, std::string_view rest, RouteParams &params) const {
+    const Node &node = nodes_[index];
+    if (rest.empty()) {
+        if (node.terminal) {
+            return index;
+        }
+    } else {
+        std::size_t slot = node.child_keys.find(rest.front());
+        if (slot != std::string::npos) {
+            std::uint32_t child = node.children[slot];
+            const std::string &prefix = nodes_[child].prefix;
+            if (rest.size() >= prefix.size() && rest.compare(0, prefix.size(), prefix) == 0) {
+                std::uint32_t found = find(child, rest.substr(prefix.size()), params);
+                if (found != NO_NODE) {
+                    return found;
+                }
+            }
+        }
+
+        if (node.param_child != NO_NODE && rest.front() != '/') {
+            std::size_t end = rest.find('/');
+            if (end == std::string_view::npos) {
+                end = rest.size();
+            }
+            std::size_t saved = params.count;
+            params.items[params.count++] = {nodes_[node.param_child].param_name, rest.substr(0, end)};
+            std::uint32_t found = find(node.param_child, rest.substr(end), params);
+            if (found != NO_NODE) {
+                return found;
+            }
+            params.count = saved;
+        }
+    }
+
+    if (node.catch_all_child != NO_NODE && nodes_[node.catch_all_child].terminal) {
+        params.items[params.count++] = {nodes_[node.catch_all_child].param_name, rest};
+        return node.catch_all_child;
+    }
+    return NO_NODE;
+}
+
+RouteStatus RadixRouter::match(HttpMethod method, std::string_view path, RouteId &id, RouteParams &params) const {
+    params.count = 0;
+    if (path.empty() || path.front() != '/' || nodes_.size() == 1) {
+        return RouteStatus::kNotFound;
+    }
+    // 뿌리 노드는 prefix 가 비어 있다.
+    std::uint32_t found = find(0, path, params);
+    if (found == NO_NODE) {
+        params.count = 0;
+        return RouteStatus::kNotFound;
+    }
+    id = nodes_[found].handlers[static_cast<std::size_t>(method)];
+    if (id == NO_ROUTE) {
+        params.count = 0;
+        return RouteStatus::kMethodNotAllowed;
+    }
+    return RouteStatus::kFound;
+}
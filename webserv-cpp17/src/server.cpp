@@ -0,0 +1,382 @@
+#include "server.hpp"
+
+#include <netinet/in.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "listener_handoff.hpp"
+#include "proxy.hpp"
+
+/**
+ * [모듈] webserv-cpp17/src/server.cpp
+ * 설명:
+ *   - 워커 그룹을 구성하고 워커마다 스레드를 띄워 독립 이벤트 루프를 실행한다.
+ *   - 워커 사이에는 잠금이 없으며, 연결 분배는 SO_REUSEPORT 로 커널에 맡긴다.
+ * 버전: v1.25.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.2.0-reuseport-workers.md
+ *   - design/webserv-cpp17/v1.7.0-worker-metrics.md
+ *   - design/webserv-cpp17/v1.14.0-response-compression.md
+ *   - design/webserv-cpp17/v1.17.0-handler-offload.md
+ *   - design/webserv-cpp17/v1.21.0-access-log.md
+ *   - design/webserv-cpp17/v1.22.0-tls.md
+ *   - design/webserv-cpp17/v1.24.0-client-limits.md
+ *   - design/webserv-cpp17/v1.25.0-config-reload.md
+ * 변경 이력:
+ *   - v1.2.0: 워커 그룹과 스레드 실행 추가
+ *   - v1.7.0: 워커별 계측 슬롯을 담는 MetricsRegistry 소유
+ *   - v1.14.0: 정적 파일 미리 압축용 작업 스레드 풀 생성
+ *   - v1.17.0: `--handler-threads` 만큼 핸들러 작업 스레드 풀 생성(워커마다 deque 하나)
+ *   - v1.21.0: `--access-log` 이면 로그 파일을 열고 워커마다 접근 로그 링을 넘김
+ *   - v1.22.0: `--tls-port` 이면 TLS 컨텍스트를 읽어 워커에 넘기고, io_uring 설정은 epoll 로 바꿈
+ *   - v1.24.0: `--client-rate` 나 `--client-connections` 이면 클라이언트 한도 표를 만들어 워커에 넘김
+ *   - v1.25.0: 제어 스레드, 설정 다시 읽기, 리슨 소켓 넘기기/넘겨받기, drain
+ * 테스트:
+ *   - tests/test_webserv_workers.sh
+ *   - tests/test_webserv_metrics.sh
+ *   - tests/test_webserv_compression.sh
+ *   - tests/test_webserv_offload.sh
+ *   - tests/test_webserv_access_log.sh
+ *   - tests/test_webserv_tls.sh
+ *   - tests/test_webserv_client_limits.sh
+ *   - tests/test_webserv_reload.sh
+ */
+
+namespace {
+
+// 제어 스레드가 시그널과 제어 소켓을 기다리는 최대 시간. 워커가 모두 끝났는지도 이 주기로 본다.
+constexpr int SUPERVISE_INTERVAL_MS = 100;
+
+// 리슨 소켓이 바인드된 포트. 넘겨받은 소켓을 평문/TLS 포트로 가르는 데 쓴다.
+std::uint16_t localPort(int fd) {
+    sockaddr_storage address{};
+    socklen_t length = sizeof(address);
+    if (::getsockname(fd, reinterpret_cast<sockaddr *>(&address), &length) != 0) {
+        return 0;
+    }
+    if (address.ss_family == AF_INET) {
+        return ntohs(reinterpret_cast<const sockaddr_in *>(&address)->sin_port);
+    }
+    if (address.ss_family == AF_INET6) {
+        return ntohs(reinterpret_cast<const sockaddr_in6 *>(&address)->sin6_port);
+    }
+    return 0;
+}
+
+}  // namespace
+
+Server::Server(const ServerConfig &config, ConfigLoader loader)
+    : config_(config),
+      loader_(std::move(loader)),
+      metrics_(config.workers == 0 ? 1 : config.workers),
+      signal_fd_(-1),
+      control_fd_(-1),
+      peer_fd_(-1),
+      takeover_fd_(-1),
+      handed_off_(false),
+      finished_(false) {}
+
+Server::~Server() {
+    closeControlSocket();
+    for (int fd : {signal_fd_, peer_fd_, takeover_fd_}) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+}
+
+bool Server::start() {
+    // SIGHUP/SIGQUIT 는 제어 스레드의 signalfd 로만 받는다. 막은 상태는 이후에 만드는 모든 스레드가 물려받는다.
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGHUP);
+    sigaddset(&signals, SIGQUIT);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+    signal_fd_ = ::signalfd(-1, &signals, SFD_NONBLOCK | SFD_CLOEXEC);
+    if (signal_fd_ < 0) {
+        std::cerr << "signalfd 생성 실패: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    std::size_t count = config_.workers == 0 ? 1 : config_.workers;
+    // 압축할 정적 파일이 있을 때만 작업 스레드를 띄운다.
+    if (config_.compression_threads > 0 && config_.compression_level > 0 && config_.compression_cache_bytes > 0 &&
+        !config_.root.empty()) {
+        pool_ = std::make_unique<ThreadPool>(config_.compression_threads);
+    }
+    if (config_.handler_threads > 0) {
+        handler_pool_ = std::make_unique<HandlerPool>(config_.handler_threads, count);
+    }
+    if (!config_.access_log.empty()) {
+        access_log_ = std::make_unique<AccessLog>(count, config_.access_log_buffer);
+        if (!access_log_->open(config_.access_log)) {
+            std::cerr << "접근 로그 파일 열기 실패 (" << config_.access_log << "): " << std::strerror(errno) << std::endl;
+            return false;
+        }
+    }
+    if (config_.tls_port != 0) {
+        tls_ = std::make_unique<TlsContext>();
+        std::string error;
+        if (!tls_->load(config_, error)) {
+            std::cerr << "TLS 설정 실패: " << error << std::endl;
+            return false;
+        }
+        // TLS 레코드 처리는 준비 통지 백엔드 위에서만 한다. 워커마다 같은 경고를 남기지 않도록 여기서 한 번 바꾼다.
+        if (config_.io_backend == IoBackendKind::kIoUring) {
+            std::cerr << "TLS 리스너는 io_uring 백엔드를 지원하지 않아 epoll 로 대신합니다." << std::endl;
+            config_.io_backend = IoBackendKind::kEpoll;
+        }
+    }
+    if (config_.client_rate != 0 || config_.client_connections != 0) {
+        limiter_ = std::make_unique<ClientLimiter>(config_.client_table, config_.client_rate, config_.client_burst,
+                                                   config_.client_connections);
+    }
+    std::vector<int> plain;
+    std::vector<int> secure;
+    if (!config_.takeover.empty() && !takeOver(plain, secure)) {
+        return false;
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        AccessRing *ring = access_log_ ? &access_log_->ring(i) : nullptr;
+        workers_.push_back(std::make_unique<Worker>(config_, i, control_, metrics_, pool_.get(), handler_pool_.get(),
+                                                    ring, tls_.get(), limiter_.get()));
+        workers_.back()->adoptListeners(i < plain.size() ? plain[i] : -1, i < secure.size() ? secure[i] : -1);
+        if (!workers_.back()->start()) {
+            return false;
+        }
+    }
+
+    if (!config_.control_socket.empty()) {
+        std::string error;
+        control_fd_ = openControlSocket(config_.control_socket, error);
+        if (control_fd_ < 0) {
+            std::cerr << error << std::endl;
+            return false;
+        }
+    }
+    if (takeover_fd_ >= 0) {
+        // 워커가 모두 리슨 중이므로 이전 프로세스가 drain 을 시작해도 새 연결을 놓치지 않는다.
+        if (!sendReady(takeover_fd_)) {
+            std::cerr << "이전 프로세스에 준비 알림을 보내지 못했습니다: " << std::strerror(errno) << std::endl;
+        }
+        ::close(takeover_fd_);
+        takeover_fd_ = -1;
+    }
+    return true;
+}
+
+
+bool Server::runWorkers() {
+    if (workers_.size() == 1) {
+        return workers_.front()->run();
+    }
+
+    std::vector<char> results(workers_.size(), 0);
+    std::vector<std::thread> threads;
+    threads.reserve(workers_.size());
+    for (std::size_t i = 0; i < workers_.size(); ++i) {
+        threads.emplace_back([this, i, &results]() { results[i] = workers_[i]->run() ? 1 : 0; });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    for (char ok : results) {
+        if (!ok) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Server::takeOver (v1.25.0)
+ * 설명:
+ *   - `--takeover` 경로의 이전 프로세스에서 리슨 소켓을 받아 바인드된 포트로 평문/TLS 로 가른다.
+ *     워커 i 가 i 번째 소켓을 맡는다. 워커보다 많이 받은 소켓과 포트가 맞지 않는 소켓은 닫는다.
+ *     이전 프로세스도 drain 을 시작하며 자기 사본을 닫으므로, 그 소켓의 대기열에 있던 연결은 끊긴다.
+ * 출력:
+ *   - 받았으면 true, 이전 프로세스에 붙지 못했거나 받는 중 끊겼으면 false
+ */
+bool Server::takeOver(std::vector<int> &plain, std::vector<int> &secure) {
+    std::vector<int> inherited;
+    std::string error;
+    if (!receiveListeners(config_.takeover, takeover_fd_, inherited, error)) {
+        std::cerr << error << std::endl;
+        return false;
+    }
+    std::size_t count = config_.workers == 0 ? 1 : config_.workers;
+    std::size_t dropped = 0;
+    for (int fd : inherited) {
+        std::uint16_t port = localPort(fd);
+        if (port == config_.port && plain.size() < count) {
+            plain.push_back(fd);
+        } else if (tls_ && port == config_.tls_port && secure.size() < count) {
+            secure.push_back(fd);
+        } else {
+            ::close(fd);
+            ++dropped;
+        }
+    }
+    std::cerr << "이전 프로세스에서 리슨 소켓 " << plain.size() + secure.size() << "개를 넘겨받았습니다." << std::endl;
+    if (dropped > 0) {
+        std::cerr << "워커 수나 포트가 맞지 않는 리슨 소켓 " << dropped << "개를 닫습니다." << std::endl;
+    }
+    return true;
+}
+
+bool Server::run() {
+    std::thread supervisor([this]() { supervise(); });
+    bool ok = runWorkers();
+    finished_.store(true, std::memory_order_relaxed);
+    supervisor.join();
+    return ok;
+}
+
+/**
+ * Server::supervise (v1.25.0)
+ * 설명:
+ *   - 제어 스레드 루프. signalfd, 제어 소켓, 리슨 소켓을 넘긴 새 프로세스와의 연결을 poll 로 기다린다.
+ *   - 소켓을 넘긴 뒤 새 프로세스의 답을 기다리는 동안은 다른 업그레이드 요청을 받지 않는다.
+ */
+void Server::supervise() {
+    while (!finished_.load(std::memory_order_relaxed)) {
+        pollfd fds[3] = {{signal_fd_, POLLIN, 0}, {peer_fd_ < 0 ? control_fd_ : -1, POLLIN, 0}, {peer_fd_, POLLIN, 0}};
+        if (::poll(fds, 3, SUPERVISE_INTERVAL_MS) <= 0) {
+            continue;
+        }
+        if (fds[0].revents & POLLIN) {
+            signalfd_siginfo info;
+            while (::read(signal_fd_, &info, sizeof(info)) == static_cast<ssize_t>(sizeof(info))) {
+                if (info.ssi_signo == SIGHUP) {
+                    reload();
+                } else if (info.ssi_signo == SIGQUIT) {
+                    drain("SIGQUIT");
+                }
+            }
+        }
+        if (fds[1].revents & POLLIN) {
+            handOff();
+        }
+        if (fds[2].revents & (POLLIN | POLLHUP | POLLERR)) {
+            finishHandOff();
+        }
+    }
+}
+
+/**
+ * Server::reload (v1.25.0)
+ * 설명:
+ *   - 설정을 처음부터 다시 만들고(loader_), 실행 중인 설정에 다시 읽을 수 있는 값만 옮겨 워커에 알린다.
+ *   - 재시작해야 바뀌는 값은 경고만 남긴다. 업스트림 주소는 워커에 알리기 전에 한 번 해석해 보고, 실패하면
+ *     설정 전체를 버리고 이전 설정을 유지한다.
+ */
+void Server::reload() {
+    ServerConfig loaded;
+    std::string error;
+    if (!loader_) {
+        return;
+    }
+    if (!loader_(loaded, error)) {
+        std::cerr << "설정을 다시 읽지 못해 이전 설정을 유지합니다: " << error << std::endl;
+        metrics_.countReload(ReloadLabel::kFailed);
+        return;
+    }
+    for (const std::string &name : restartOnlyChanges(config_, loaded)) {
+        std::cerr << "--" << name << ": 재시작(업그레이드)해야 바뀌는 옵션이라 무시합니다." << std::endl;
+    }
+    ServerConfig next = config_;
+    copyReloadable(loaded, next);
+    if (!next.proxies.empty()) {
+        UpstreamPool trial(next.proxies, next.proxy_balance, next.upstream_keepalive);
+        if (!trial.resolve(error)) {
+            std::cerr << "설정을 다시 읽지 못해 이전 설정을 유지합니다: " << error << std::endl;
+            metrics_.countReload(ReloadLabel::kFailed);
+            return;
+        }
+    }
+    config_ = next;
+    std::atomic_store(&control_.config, std::make_shared<const ServerConfig>(std::move(next)));
+    std::uint64_t generation = control_.generation.fetch_add(1, std::memory_order_release) + 1;
+    metrics_.countReload(ReloadLabel::kApplied);
+    std::cerr << "설정을 다시 읽었습니다 (세대 " << generation << ")." << std::endl;
+}
+
+/**
+ * Server::handOff (v1.25.0)
+ * 설명:
+ *   - 제어 소켓에 붙은 새 프로세스에 모든 워커의 리슨 소켓을 보낸다. 보낸 뒤에도 이 프로세스는 계속 받는다.
+ *     두 프로세스가 같은 소켓에서 받다가, 새 프로세스가 준비를 알리면 drain 한다(finishHandOff).
+ */
+void Server::handOff() {
+    int peer = ::accept4(control_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+    if (peer < 0) {
+        return;
+    }
+    std::vector<int> fds;
+    for (const std::unique_ptr<Worker> &worker : workers_) {
+        fds.push_back(worker->listenFd());
+        if (worker->tlsListenFd() >= 0) {
+            fds.push_back(worker->tlsListenFd());
+        }
+    }
+    std::string error;
+    if (!sendListeners(peer, fds, error)) {
+        std::cerr << error << std::endl;
+        ::close(peer);
+        return;
+    }
+    std::cerr << "새 프로세스에 리슨 소켓 " << fds.size() << "개를 넘겼습니다. 준비 알림을 기다립니다." << std::endl;
+    peer_fd_ = peer;
+}
+
+// 새 프로세스의 답을 읽는다. 준비 바이트면 drain 하고, 그 전에 끊겼으면 업그레이드를 취소한다.
+void Server::finishHandOff() {
+    char ready = 0;
+    ssize_t received = ::recv(peer_fd_, &ready, 1, MSG_DONTWAIT);
+    if (received < 0 && (errno == EAGAIN || errno == EINTR)) {
+        return;
+    }
+    ::close(peer_fd_);
+    peer_fd_ = -1;
+    if (received != 1) {
+        std::cerr << "새 프로세스가 준비 알림 없이 끊었습니다. 업그레이드를 취소하고 계속 받습니다." << std::endl;
+        return;
+    }
+    // 새 프로세스가 같은 경로에 제어 소켓을 다시 바인드했으므로 경로는 이제 새 프로세스의 것이다.
+    handed_off_ = true;
+    drain("업그레이드");
+}
+
+// 워커에 drain 을 알린다. 더 이상 업그레이드 요청을 받지 않도록 제어 소켓도 닫는다.
+void Server::drain(const char *reason) {
+    if (control_.draining.exchange(true, std::memory_order_relaxed)) {
+        return;
+    }
+    closeControlSocket();
+    std::cerr << reason << ": 새 연결을 받지 않고 남은 연결을 마무리합니다 (최대 " << config_.drain_timeout.count()
+              << "ms)." << std::endl;
+}
+
+void Server::closeControlSocket() {
+    if (control_fd_ < 0) {
+        return;
+    }
+    ::close(control_fd_);
+    control_fd_ = -1;
+    if (!handed_off_) {
+        ::unlink(config_.control_socket.c_str());
+    }
+}
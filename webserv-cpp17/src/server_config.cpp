@@ -0,0 +1,569 @@
+#include "server_config.hpp"
+
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string_view>
+#include <utility>
+
+/**
+ * [모듈] webserv-cpp17/src/server_config.cpp
+ * 설명:
+ *   - 위치 인자(포트, 최대 요청 수)와 `--이름 값` 형식 옵션을 ServerConfig 로 변환한다.
+ * 버전: v1.25.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.1.0-epoll-reactor.md
+ *   - design/webserv-cpp17/v1.2.0-reuseport-workers.md
+ *   - design/webserv-cpp17/v1.6.0-static-files.md
+ *   - design/webserv-cpp17/v1.8.0-timer-wheel.md
+ *   - design/webserv-cpp17/v1.11.0-io-uring-backend.md
+ *   - design/webserv-cpp17/v1.12.0-streaming-request-body.md
+ *   - design/webserv-cpp17/v1.14.0-response-compression.md
+ *   - design/webserv-cpp17/v1.15.0-response-cache.md
+ *   - design/webserv-cpp17/v1.16.0-reverse-proxy.md
+ *   - design/webserv-cpp17/v1.17.0-handler-offload.md
+ *   - design/webserv-cpp17/v1.19.0-load-generator.md
+ *   - design/webserv-cpp17/v1.20.0-accept-path.md
+ *   - design/webserv-cpp17/v1.21.0-access-log.md
+ *   - design/webserv-cpp17/v1.22.0-tls.md
+ *   - design/webserv-cpp17/v1.23.0-http2.md
+ *   - design/webserv-cpp17/v1.24.0-client-limits.md
+ *   - design/webserv-cpp17/v1.25.0-config-reload.md
+ * 변경 이력:
+ *   - v1.1.0: 타임아웃/런타임 제한 옵션 추가
+ *   - v1.2.0: `--workers` 옵션 추가
+ *   - v1.6.0: 문자열 값 옵션(`--root`)과 값 없는 플래그(`--static-copy`), `--file-cache-entries` 추가
+ *   - v1.8.0: `--header-timeout-ms`, `--write-timeout-ms` 옵션 추가
+ *   - v1.11.0: `--io-backend` 옵션 추가
+ *   - v1.12.0: `--max-header-bytes`, `--max-body-bytes` 옵션, `--demo-routes` 플래그 추가
+ *   - v1.14.0: `--compression-level`, `--compression-cache-bytes`, `--compression-threads` 옵션 추가
+ *   - v1.15.0: `--response-cache-bytes`, `--response-cache-ttl-ms` 옵션 추가
+ *   - v1.16.0: `--proxy`, `--proxy-balance`, `--upstream-keepalive`, `--proxy-timeout-ms` 옵션 추가
+ *   - v1.17.0: `--handler-threads`, `--handler-queue` 옵션 추가
+ *   - v1.19.0: `--unlimited` 플래그 추가
+ *   - v1.20.0: `--listen-backlog`, `--accept-batch`, `--defer-accept-sec`, `--tcp-fastopen`, `--tcp-nodelay` 옵션 추가
+ *   - v1.21.0: `--access-log`, `--access-log-sample`, `--access-log-buffer` 옵션 추가
+ *   - v1.22.0: `--tls-port`, `--tls-cert`, `--tls-key`, `--tls-session-cache`, `--tls-tickets`, `--tls-ktls` 옵션 추가
+ *   - v1.23.0: `--http2`, `--http2-max-streams`, `--http2-window` 옵션 추가
+ *   - v1.24.0: `--client-rate`, `--client-burst`, `--client-connections`, `--client-table`, `--overload-lag-ms` 옵션 추가
+ *   - v1.25.0: --config 설정 파일, --port/--max-requests/--control-socket/--takeover/--drain-timeout-ms, copyReloadable, restartOnlyChanges
+ * 테스트:
+ *   - tests/test_webserv_epoll_many.sh
+ *   - tests/test_webserv_workers.sh
+ *   - tests/test_webserv_static_files.sh
+ *   - tests/test_webserv_timeouts.sh
+ *   - tests/test_webserv_io_uring.sh
+ *   - tests/test_webserv_request_body.sh
+ *   - tests/test_webserv_compression.sh
+ *   - tests/test_webserv_response_cache.sh
+ *   - tests/test_webserv_proxy.sh
+ *   - tests/test_webserv_offload.sh
+ *   - tests/test_webserv_bench.sh
+ *   - tests/test_webserv_accept.sh
+ *   - tests/test_webserv_access_log.sh
+ *   - tests/test_webserv_tls.sh
+ *   - tests/test_webserv_http2.sh
+ *   - tests/test_webserv_client_limits.sh
+ *   - tests/test_webserv_reload.sh
+ */
+
+namespace {
+
+bool parseUnsigned(const char *text, unsigned long &out) {
+    if (text == nullptr || *text == '\0') {
+        return false;
+    }
+    char *end = nullptr;
+    out = std::strtoul(text, &end, 10);
+    return end != nullptr && *end == '\0';
+}
+
+/**
+ * parseProxyTarget
+ * 설명:
+ *   - `PREFIX=HOST:PORT[,HOST:PORT...]` 를 나눈다. 접두사는 '/' 로 시작해야 하고, 업스트림마다 포트가 있어야 한다.
+ */
+bool parseProxyTarget(const char *text, ProxyTarget &target) {
+    std::string spec = text;
+    std::size_t equals = spec.find('=');
+    if (equals == std::string::npos || equals == 0 || spec[0] != '/') {
+        return false;
+    }
+    target.prefix = spec.substr(0, equals);
+    std::size_t pos = equals + 1;
+    while (pos <= spec.size()) {
+        std::size_t comma = spec.find(',', pos);
+        if (comma == std::string::npos) {
+            comma = spec.size();
+        }
+        std::string upstream = spec.substr(pos, comma - pos);
+        std::size_t colon = upstream.rfind(':');
+        unsigned long port = 0;
+        if (colon == std::string::npos || colon == 0 || !parseUnsigned(upstream.c_str() + colon + 1, port) ||
+            port == 0 || port > 65535) {
+            return false;
+        }
+        target.upstreams.push_back(upstream);
+        pos = comma + 1;
+    }
+    return !target.upstreams.empty();
+}
+
+// on/off 스위치 값. 둘 중 하나가 아니면 false 다.
+bool parseSwitch(const char *text, bool &out) {
+    if (std::strcmp(text, "on") == 0) {
+        out = true;
+        return true;
+    }
+    if (std::strcmp(text, "off") == 0) {
+        out = false;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * parseOption
+ * 설명:
+ *   - argv[i] 의 `--이름 [값]` 옵션 하나를 config 에 반영하고 i 를 마지막으로 쓴 인자로 옮긴다.
+ *     명령행과 설정 파일(v1.25.0)이 같은 함수를 거치므로 두 곳의 옵션 이름과 검사가 같다.
+ */
+bool parseOption(int argc, const char *const argv[], int &i, ServerConfig &config, bool &unlimited,
+                 std::string &error) {
+    const char *arg = argv[i];
+    if (std::strcmp(arg, "--static-copy") == 0) {
+        config.static_copy = true;
+        return true;
+    }
+    if (std::strcmp(arg, "--unlimited") == 0) {
+        unlimited = true;
+        return true;
+    }
+    if (std::strcmp(arg, "--demo-routes") == 0) {
+        config.demo_routes = true;
+        return true;
+    }
+    if (std::strcmp(arg, "--root") == 0) {
+        if (i + 1 >= argc || argv[i + 1][0] == '\0') {
+            error = "--root 옵션에 문서 루트 경로가 없습니다.";
+            return false;
+        }
+        config.root = argv[++i];
+        return true;
+    }
+    if (std::strcmp(arg, "--access-log") == 0) {
+        if (i + 1 >= argc || argv[i + 1][0] == '\0') {
+            error = "--access-log 옵션에 로그 파일 경로가 없습니다.";
+            return false;
+        }
+        config.access_log = argv[++i];
+        return true;
+    }
+    if (std::strcmp(arg, "--control-socket") == 0 || std::strcmp(arg, "--takeover") == 0) {
+        if (i + 1 >= argc || argv[i + 1][0] == '\0') {
+            error = std::string(arg) + " 옵션에 유닉스 소켓 경로가 없습니다.";
+            return false;
+        }
+        (std::strcmp(arg, "--control-socket") == 0 ? config.control_socket : config.takeover) = argv[++i];
+        return true;
+    }
+    if (std::strcmp(arg, "--io-backend") == 0) {
+        const char *name = i + 1 < argc ? argv[i + 1] : "";
+        if (std::strcmp(name, "epoll") == 0) {
+            config.io_backend = IoBackendKind::kEpoll;
+        } else if (std::strcmp(name, "uring") == 0) {
+            config.io_backend = IoBackendKind::kIoUring;
+        } else {
+            error = "--io-backend 옵션 값은 epoll 또는 uring 이어야 합니다.";
+            return false;
+        }
+        ++i;
+        return true;
+    }
+    if (std::strcmp(arg, "--tcp-nodelay") == 0 || std::strcmp(arg, "--tls-tickets") == 0 ||
+        std::strcmp(arg, "--tls-ktls") == 0 || std::strcmp(arg, "--http2") == 0) {
+        bool *flag = &config.tcp_nodelay;
+        if (std::strcmp(arg, "--tls-tickets") == 0) {
+            flag = &config.tls_tickets;
+        } else if (std::strcmp(arg, "--tls-ktls") == 0) {
+            flag = &config.tls_ktls;
+        } else if (std::strcmp(arg, "--http2") == 0) {
+            flag = &config.http2;
+        }
+        if (!parseSwitch(i + 1 < argc ? argv[i + 1] : "", *flag)) {
+            error = std::string(arg) + " 옵션 값은 on 또는 off 여야 합니다.";
+            return false;
+        }
+        ++i;
+        return true;
+    }
+    if (std::strcmp(arg, "--tls-cert") == 0 || std::strcmp(arg, "--tls-key") == 0) {
+        if (i + 1 >= argc || argv[i + 1][0] == '\0') {
+            error = std::string(arg) + " 옵션에 PEM 파일 경로가 없습니다.";
+            return false;
+        }
+        (std::strcmp(arg, "--tls-cert") == 0 ? config.tls_cert : config.tls_key) = argv[++i];
+        return true;
+    }
+    if (std::strcmp(arg, "--proxy") == 0) {
+        ProxyTarget target;
+        if (i + 1 >= argc || !parseProxyTarget(argv[i + 1], target)) {
+            error = "--proxy 옵션 값은 /접두사=호스트:포트[,호스트:포트...] 형식이어야 합니다.";
+            return false;
+        }
+        config.proxies.push_back(std::move(target));
+        ++i;
+        return true;
+    }
+    if (std::strcmp(arg, "--proxy-balance") == 0) {
+        const char *name = i + 1 < argc ? argv[i + 1] : "";
+        if (std::strcmp(name, "round-robin") == 0) {
+            config.proxy_balance = ProxyBalance::kRoundRobin;
+        } else if (std::strcmp(name, "least-conn") == 0) {
+            config.proxy_balance = ProxyBalance::kLeastConnections;
+        } else {
+            error = "--proxy-balance 옵션 값은 round-robin 또는 least-conn 이어야 합니다.";
+            return false;
+        }
+        ++i;
+        return true;
+    }
+
+    unsigned long value = 0;
+    if (i + 1 >= argc || !parseUnsigned(argv[i + 1], value)) {
+        error = std::string("옵션 값이 없거나 숫자가 아닙니다: ") + arg;
+        return false;
+    }
+    ++i;
+
+    if (std::strcmp(arg, "--port") == 0) {
+        if (value == 0 || value > 65535) {
+            error = "포트는 1~65535 사이여야 합니다.";
+            return false;
+        }
+        config.port = static_cast<std::uint16_t>(value);
+    } else if (std::strcmp(arg, "--max-requests") == 0) {
+        config.max_requests = value == 0 ? 1 : static_cast<std::size_t>(value);
+    } else if (std::strcmp(arg, "--idle-timeout-ms") == 0) {
+        config.idle_timeout = std::chrono::milliseconds(value);
+    } else if (std::strcmp(arg, "--header-timeout-ms") == 0) {
+        config.header_timeout = std::chrono::milliseconds(value);
+    } else if (std::strcmp(arg, "--write-timeout-ms") == 0) {
+        config.write_timeout = std::chrono::milliseconds(value);
+    } else if (std::strcmp(arg, "--max-runtime-sec") == 0) {
+        config.max_runtime = std::chrono::seconds(value);
+    } else if (std::strcmp(arg, "--workers") == 0) {
+        if (value == 0) {
+            error = "워커 수는 1 이상이어야 합니다.";
+            return false;
+        }
+        config.workers = static_cast<std::size_t>(value);
+    } else if (std::strcmp(arg, "--file-cache-entries") == 0) {
+        config.file_cache_entries = static_cast<std::size_t>(value);
+    } else if (std::strcmp(arg, "--max-header-bytes") == 0) {
+        if (value == 0) {
+            error = "헤더 크기 제한은 1 이상이어야 합니다.";
+            return false;
+        }
+        config.max_header_bytes = static_cast<std::size_t>(value);
+    } else if (std::strcmp(arg, "--max-body-bytes") == 0) {
+        config.max_body_bytes = static_cast<std::uint64_t>(value);
+    } else if (std::strcmp(arg, "--compression-level") == 0) {
+        if (value > 9) {
+            error = "압축 수준은 0~9 사이여야 합니다.";
+            return false;
+        }
+        config.compression_level = static_cast<int>(value);
+    } else if (std::strcmp(arg, "--compression-cache-bytes") == 0) {
+        config.compression_cache_bytes = static_cast<std::size_t>(value);
+    } else if (std::strcmp(arg, "--compression-threads") == 0) {
+        config.compression_threads = static_cast<std::size_t>(value);
+    } else if (std::strcmp(arg, "--response-cache-bytes") == 0) {
+        config.response_cache_bytes = static_cast<std::size_t>(value);
+    } else if (std::strcmp(arg, "--response-cache-ttl-ms") == 0) {
+        config.response_cache_ttl = std::chrono::milliseconds(value);
+    } else if (std::strcmp(arg, "--upstream-keepalive") == 0) {
+        config.upstream_keepalive = static_cast<std::size_t>(value);
+    } else if (std::strcmp(arg, "--proxy-timeout-ms") == 0) {
+        if (value == 0) {
+            error = "프록시 타임아웃은 1 이상이어야 합니다.";
+            return false;
+        }
+        config.proxy_timeout = std::chrono::milliseconds(value);
+    } else if (std::strcmp(arg, "--handler-threads") == 0) {
+        config.handler_threads = static_cast<std::size_t>(value);
+    } else if (std::strcmp(arg, "--handler-queue") == 0) {
+        config.handler_queue = static_cast<std::size_t>(value);
+    } else if (std::strcmp(arg, "--listen-backlog") == 0) {
+        if (value == 0 || value > INT_MAX) {
+            error = "리슨 백로그는 1 이상이어야 합니다.";
+            return false;
+        }
+        config.listen_backlog = static_cast<std::size_t>(value);
+    } else if (std::strcmp(arg, "--accept-batch") == 0) {
+        config.accept_batch = static_cast<std::size_t>(value);
+    } else if (std::strcmp(arg, "--defer-accept-sec") == 0) {
+        if (value > INT_MAX) {
+            error = "수락 지연 시간이 너무 큽니다.";
+            return false;
+        }
+        config.defer_accept = std::chrono::seconds(value);
+    } else if (std::strcmp(arg, "--tcp-fastopen") == 0) {
+        if (value > INT_MAX) {
+            error = "TCP_FASTOPEN 대기열 길이가 너무 큽니다.";
+            return false;
+        }
+        config.tcp_fastopen = static_cast<std::size_t>(value);
+    } else if (std::strcmp(arg, "--access-log-sample") == 0) {
+        if (value == 0) {
+            error = "접근 로그 표본 간격은 1 이상이어야 합니다.";
+            return false;
+        }
+        config.access_log_sample = static_cast<std::size_t>(value);
+    } else if (std::strcmp(arg, "--access-log-buffer") == 0) {
+        if (value == 0 || value > (1ul << 24)) {
+            error = "접근 로그 링 크기는 1 이상 16777216 이하여야 합니다.";
+            return false;
+        }
+        config.access_log_buffer = static_cast<std::size_t>(value);
+    } else if (std::strcmp(arg, "--tls-port") == 0) {
+        if (value == 0 || value > 65535) {
+            error = "TLS 포트는 1~65535 사이여야 합니다.";
+            return false;
+        }
+        config.tls_port = static_cast<std::uint16_t>(value);
+    } else if (std::strcmp(arg, "--tls-session-cache") == 0) {
+        if (value > INT_MAX) {
+            error = "TLS 세션 캐시 크기가 너무 큽니다.";
+            return false;
+        }
+        config.tls_session_cache = static_cast<std::size_t>(value);
+    } else if (std::strcmp(arg, "--http2-max-streams") == 0) {
+        if (value == 0 || value > 65536) {
+            error = "HTTP/2 동시 스트림 수는 1~65536 사이여야 합니다.";
+            return false;
+        }
+        config.http2_max_streams = static_cast<std::size_t>(value);
+    } else if (std::strcmp(arg, "--http2-window") == 0) {
+        // 65535 는 RFC 9113 의 초기 창 크기, 2^31-1 은 창 크기 상한이다.
+        if (value < 65535 || value > 0x7fffffff) {
+            error = "HTTP/2 흐름 제어 창 크기는 65535~2147483647 사이여야 합니다.";
+            return false;
+        }
+        config.http2_window = static_cast<std::size_t>(value);
+    } else if (std::strcmp(arg, "--client-rate") == 0) {
+        if (value > 1000000000ul) {
+            error = "클라이언트 초당 요청 수는 1000000000 이하여야 합니다.";
+            return false;
+        }
+        config.client_rate = static_cast<std::uint32_t>(value);
+    } else if (std::strcmp(arg, "--client-burst") == 0) {
+        if (value > 1000000ul) {
+            error = "클라이언트 버킷 크기는 1000000 이하여야 합니다.";
+            return false;
+        }
+        config.client_burst = static_cast<std::uint32_t>(value);
+    } else if (std::strcmp(arg, "--client-connections") == 0) {
+        if (value > 1000000ul) {
+            error = "클라이언트 동시 연결 한도는 1000000 이하여야 합니다.";
+            return false;
+        }
+        config.client_connections = static_cast<std::uint32_t>(value);
+    } else if (std::strcmp(arg, "--client-table") == 0) {
+        if (value == 0 || value > (1ul << 24)) {
+            error = "클라이언트 표 크기는 1 이상 16777216 이하여야 합니다.";
+            return false;
+        }
+        config.client_table = static_cast<std::size_t>(value);
+    } else if (std::strcmp(arg, "--overload-lag-ms") == 0) {
+        config.overload_lag = std::chrono::milliseconds(value);
+    } else if (std::strcmp(arg, "--drain-timeout-ms") == 0) {
+        config.drain_timeout = std::chrono::milliseconds(value);
+    } else {
+        error = std::string("알 수 없는 옵션: ") + arg;
+        return false;
+    }
+    return true;
+}
+
+// 앞뒤 공백과 탭을 뗀다.
+std::string_view trim(std::string_view text) {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t' || text.front() == '\r')) {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r')) {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+/**
+ * loadConfigFile (v1.25.0)
+ * 설명:
+ *   - 한 줄에 지시어 하나(`이름 [값]`)를 읽어 `--이름 [값]` 옵션으로 parseOption 에 넘긴다.
+ *     값은 이름 뒤 공백 다음부터 줄 끝까지라 경로에 공백이 있어도 된다.
+ *   - 빈 줄과 `#` 으로 시작하는 줄은 건너뛴다. 줄 중간의 `#` 은 값의 일부다.
+ *   - 파일 안에서 `config` 는 쓸 수 없다(다른 파일을 끌어오지 않는다).
+ * 에러:
+ *   - 파일을 열 수 없거나 지시어가 틀리면 `경로:줄: 이유` 형식의 error 와 false
+ */
+bool loadConfigFile(const std::string &path, ServerConfig &config, bool &unlimited, std::string &error) {
+    std::ifstream file(path);
+    if (!file) {
+        error = "설정 파일을 열 수 없습니다: " + path + " (" + std::strerror(errno) + ")";
+        return false;
+    }
+    std::string line;
+    for (int number = 1; std::getline(file, line); ++number) {
+        std::string_view text = trim(line);
+        if (text.empty() || text.front() == '#') {
+            continue;
+        }
+        std::size_t space = text.find_first_of(" \t");
+        std::string name = "--" + std::string(text.substr(0, space));
+        std::string value = space == std::string_view::npos ? std::string() : std::string(trim(text.substr(space)));
+        std::string where = path + ":" + std::to_string(number) + ": ";
+        if (name == "--config") {
+            error = where + "설정 파일 안에서는 config 를 쓸 수 없습니다.";
+            return false;
+        }
+        const char *args[] = {name.c_str(), value.c_str()};
+        int count = value.empty() ? 1 : 2;
+        int i = 0;
+        if (!parseOption(count, args, i, config, unlimited, error)) {
+            error = where + error;
+            return false;
+        }
+        if (i + 1 != count) {
+            error = where + "값을 받지 않는 지시어입니다: " + std::string(text.substr(0, space));
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+bool parseCommandLine(int argc, char *argv[], ServerConfig &config, std::string &error) {
+    int positional = 0;
+    bool unlimited = false;
+    // 설정 파일을 먼저 읽고 명령행 옵션을 그 위에 덮는다. `--config` 의 위치와 상관없이 명령행이 이긴다.
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], "--config") == 0) {
+            config.config_file = argv[i + 1];
+            if (!loadConfigFile(config.config_file, config, unlimited, error)) {
+                return false;
+            }
+            break;
+        }
+    }
+    for (int i = 1; i < argc; ++i) {
+        const char *arg = argv[i];
+        if (std::strncmp(arg, "--", 2) != 0) {
+            // 기존 실행 방식(`webserv 8080 3`)과의 호환을 위해 위치 인자를 그대로 받는다.
+            if (positional == 0) {
+                config.port = static_cast<std::uint16_t>(std::atoi(arg));
+            } else if (positional == 1) {
+                config.max_requests = static_cast<std::size_t>(std::strtoul(arg, nullptr, 10));
+                if (config.max_requests == 0) {
+                    config.max_requests = 1;
+                }
+            } else {
+                error = std::string("알 수 없는 위치 인자: ") + arg;
+                return false;
+            }
+            ++positional;
+            continue;
+        }
+        if (std::strcmp(arg, "--config") == 0) {
+            if (i + 1 >= argc || argv[i + 1][0] == '\0') {
+                error = "--config 옵션에 설정 파일 경로가 없습니다.";
+                return false;
+            }
+            ++i;
+            continue;
+        }
+        if (!parseOption(argc, argv, i, config, unlimited, error)) {
+            return false;
+        }
+    }
+    if (config.tls_port != 0 && (config.tls_cert.empty() || config.tls_key.empty())) {
+        error = "--tls-port 에는 --tls-cert 와 --tls-key 가 필요합니다.";
+        return false;
+    }
+    if (config.tls_port != 0 && config.tls_port == config.port) {
+        error = "TLS 포트는 평문 포트와 달라야 합니다.";
+        return false;
+    }
+    if (unlimited) {
+        // 벤치마크가 도는 동안 서버가 먼저 끝나지 않도록 두 제한을 모두 끈다. 종료는 시그널로 한다.
+        config.max_requests = SIZE_MAX;
+        config.max_runtime = std::chrono::seconds(0);
+    }
+    return true;
+}
+
+void copyReloadable(const ServerConfig &from, ServerConfig &to) {
+    to.max_requests = from.max_requests;
+    to.idle_timeout = from.idle_timeout;
+    to.header_timeout = from.header_timeout;
+    to.write_timeout = from.write_timeout;
+    to.max_header_bytes = from.max_header_bytes;
+    to.max_body_bytes = from.max_body_bytes;
+    to.proxies = from.proxies;
+    to.proxy_balance = from.proxy_balance;
+    to.upstream_keepalive = from.upstream_keepalive;
+    to.proxy_timeout = from.proxy_timeout;
+    to.handler_queue = from.handler_queue;
+    to.accept_batch = from.accept_batch;
+    to.access_log_sample = from.access_log_sample;
+    to.http2_max_streams = from.http2_max_streams;
+    to.http2_window = from.http2_window;
+    to.overload_lag = from.overload_lag;
+    to.drain_timeout = from.drain_timeout;
+}
+
+std::vector<std::string> restartOnlyChanges(const ServerConfig &running, const ServerConfig &loaded) {
+    std::vector<std::string> changed;
+    auto check = [&changed](bool differs, const char *name) {
+        if (differs) {
+            changed.emplace_back(name);
+        }
+    };
+    check(running.port != loaded.port, "port");
+    check(running.tls_port != loaded.tls_port, "tls-port");
+    check(running.workers != loaded.workers, "workers");
+    check(running.max_runtime != loaded.max_runtime, "max-runtime-sec");
+    // TLS 리스너가 있으면 Server 가 io_uring 설정을 epoll 로 바꿔 두므로 그때는 비교하지 않는다.
+    check(running.tls_port == 0 && running.io_backend != loaded.io_backend, "io-backend");
+    check(running.root != loaded.root, "root");
+    check(running.file_cache_entries != loaded.file_cache_entries, "file-cache-entries");
+    check(running.static_copy != loaded.static_copy, "static-copy");
+    check(running.demo_routes != loaded.demo_routes, "demo-routes");
+    check(running.compression_level != loaded.compression_level, "compression-level");
+    check(running.compression_cache_bytes != loaded.compression_cache_bytes, "compression-cache-bytes");
+    check(running.compression_threads != loaded.compression_threads, "compression-threads");
+    check(running.response_cache_bytes != loaded.response_cache_bytes, "response-cache-bytes");
+    check(running.response_cache_ttl != loaded.response_cache_ttl, "response-cache-ttl-ms");
+    check(running.handler_threads != loaded.handler_threads, "handler-threads");
+    check(running.listen_backlog != loaded.listen_backlog, "listen-backlog");
+    check(running.defer_accept != loaded.defer_accept, "defer-accept-sec");
+    check(running.tcp_fastopen != loaded.tcp_fastopen, "tcp-fastopen");
+    check(running.tcp_nodelay != loaded.tcp_nodelay, "tcp-nodelay");
+    check(running.access_log != loaded.access_log, "access-log");
+    check(running.access_log_buffer != loaded.access_log_buffer, "access-log-buffer");
+    check(running.tls_cert != loaded.tls_cert || running.tls_key != loaded.tls_key, "tls-cert/tls-key");
+    check(running.tls_session_cache != loaded.tls_session_cache, "tls-session-cache");
+    check(running.tls_tickets != loaded.tls_tickets, "tls-tickets");
+    check(running.tls_ktls != loaded.tls_ktls, "tls-ktls");
+    check(running.http2 != loaded.http2, "http2");
+    check(running.client_rate != loaded.client_rate, "client-rate");
+    check(running.client_burst != loaded.client_burst, "client-burst");
+    check(running.client_connections != loaded.client_connections, "client-connections");
+    check(running.client_table != loaded.client_table, "client-table");
+    check(running.control_socket != loaded.control_socket, "control-socket");
+    return changed;
+}
@@ -0,0 +1,203 @@
+#include "thread_pool.hpp"
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+
+/**
+ * [모듈] webserv-cpp17/src/thread_pool.cpp
+ * 설명:
+ *   - 작업 스레드 풀과 eventfd 완료 큐를 구현한다.
+ * 버전: v1.17.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.14.0-response-compression.md
+ *   - design/webserv-cpp17/v1.17.0-handler-offload.md
+ * 변경 이력:
+ *   - v1.14.0: ThreadPool, CompletionQueue 추가
+ *   - v1.17.0: 실행 중 작업 수(busy_)를 세고 대기 한도로 거절하는 trySubmit 추가,
+ *              워커별 deque 에서 훔쳐 오는 HandlerPool 추가
+ * 테스트:
+ *   - tests/test_webserv_compression.sh
+ *   - tests/test_webserv_offload.sh
+ */
+
+ThreadPool::ThreadPool(std::size_t threads) {
+    threads_.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+        threads_.emplace_back([this]() { runLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        tasks_.clear();
+    }
+    ready_.notify_all();
+    for (std::thread &thread : threads_) {
+        thread.join();
+    }
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) {
+            return;
+        }
+        tasks_.push_back(std::move(task));
+    }
+    ready_.notify_one();
+}
+
+bool ThreadPool::trySubmit(std::function<void()> task, std::size_t max_waiting) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // 실행 중인 작업과 기다리는 작업이 스레드 수 + max_waiting 에 닿았으면
+        // 새 작업 앞에 이미 max_waiting 개가 스레드를 기다린다.
+        if (stopping_ || tasks_.size() + busy_ >= threads_.size() + max_waiting) {
+            return false;
+        }
+        tasks_.push_back(std::move(task));
+    }
+    ready_.notify_one();
+    return true;
+}
+
+void ThreadPool::runLoop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            ready_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+            if (stopping_) {
+                return;
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+            ++busy_;
+        }
+        task();
+        std::lock_guard<std::mutex> lock(mutex_);
+        --busy_;
+    }
+}
+
+HandlerPool::HandlerPool(std::size_t threads, std::size_t queues)
+    : queues_(std::make_unique<Queue[]>(queues == 0 ? 1 : queues)), queue_count_(queues == 0 ? 1 : queues) {
+    threads_.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+        threads_.emplace_back([this, i]() { runLoop(i % queue_count_); });
+    }
+}
+
+HandlerPool::~HandlerPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        stopping_.store(true);
+    }
+    ready_.notify_all();
+    for (std::size_t i = 0; i < queue_count_; ++i) {
+        std::lock_guard<std::mutex> lock(queues_[i].mutex);
+        queues_[i].tasks.clear();
+    }
+    for (std::thread &thread : threads_) {
+        thread.join();
+    }
+}
+
+bool HandlerPool::trySubmit(std::size_t queue, std::function<void()> task, std::size_t max_waiting) {
+    std::size_t limit = threads_.size() + max_waiting;
+    std::size_t accepted = accepted_.load(std::memory_order_relaxed);
+    do {
+        if (accepted >= limit || stopping_.load(std::memory_order_relaxed)) {
+            return false;
+        }
+    } while (!accepted_.compare_exchange_weak(accepted, accepted + 1, std::memory_order_relaxed));
+
+    Queue &target = queues_[queue % queue_count_];
+    {
+        std::lock_guard<std::mutex> lock(target.mutex);
+        target.tasks.push_back(std::move(task));
+        // 꺼내는 쪽도 같은 잠금 안에서 빼므로 queued_ 가 잠깐이라도 음수가 되지 않는다.
+        queued_.fetch_add(1);
+    }
+    // 잠들려는 스레드는 sleepers_ 를 올린 뒤 queued_ 를 보고, 여기서는 queued_ 를 올린 뒤 sleepers_ 를 본다.
+    // 둘 다 순차 일관 연산이라 어느 한쪽은 반드시 상대의 변경을 보므로 깨우기를 놓치지 않는다.
+    if (sleepers_.load() > 0) {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        ready_.notify_one();
+    }
+    return true;
+}
+
+bool HandlerPool::takeTask(std::size_t home, std::function<void()> &task) {
+    for (std::size_t step = 0; step < queue_count_; ++step) {
+        Queue &source = queues_[(home + step) % queue_count_];
+        std::lock_guard<std::mutex> lock(source.mutex);
+        if (!source.tasks.empty()) {
+            task = std::move(source.tasks.front());
+            source.tasks.pop_front();
+            queued_.fetch_sub(1);
+            return true;
+        }
+    }
+    return false;
+}
+
+void HandlerPool::runLoop(std::size_t home) {
+    std::function<void()> task;
+    while (!stopping_.load()) {
+        if (takeTask(home, task)) {
+            task();
+            task = nullptr;
+            accepted_.fetch_sub(1);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        sleepers_.fetch_add(1);
+        ready_.wait(lock, [this]() { return stopping_.load() || queued_.load() > 0; });
+        sleepers_.fetch_sub(1);
+    }
+}
+
+CompletionQueue::~CompletionQueue() {
+    if (event_fd_ >= 0) {
+        ::close(event_fd_);
+    }
+}
+
+bool CompletionQueue::start() {
+    event_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    return event_fd_ >= 0;
+}
+
+void CompletionQueue::post(std::function<void()> callback) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        posted_.push_back(std::move(callback));
+    }
+    std::uint64_t one = 1;
+    // 카운터가 넘칠 일은 없고, 실패해도 이미 깨어 있는 워커가 다음 drain 에서 가져간다.
+    ssize_t written = ::write(event_fd_, &one, sizeof(one));
+    (void)written;
+}
+
+std::size_t CompletionQueue::drain() {
+    std::uint64_t count = 0;
+    while (::read(event_fd_, &count, sizeof(count)) < 0 && errno == EINTR) {
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_.swap(posted_);
+    }
+    std::size_t ran = running_.size();
+    for (std::function<void()> &callback : running_) {
+        callback();
+    }
+    running_.clear();
+    return ran;
+}
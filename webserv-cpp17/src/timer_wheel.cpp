@@ -0,0 +1,197 @@
+#include "timer_wheel.hpp"
+
+#include <algorithm>
+
+/**
+ * [모듈] webserv-cpp17/src/timer_wheel.cpp
+ * 설명:
+ *   - 계층형 타이밍 휠의 예약/취소, 상위 단계 칸을 하위 단계로 내리는 cascade, 만료 수거를 구현한다.
+ * 버전: v1.8.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.8.0-timer-wheel.md
+ * 변경 이력:
+ *   - v1.8.0: 타이밍 휠 추가
+ * 테스트:
+ *   - tests/test_webserv_timeouts.sh
+ */
+
+TimerWheel::TimerWheel(Clock::time_point origin) : origin_(origin) {
+    for (auto &level : heads_) {
+        for (TimerNode &head : level) {
+            head.prev = &head;
+            head.next = &head;
+        }
+    }
+}
+
+std::uint64_t TimerWheel::tickOf(Clock::time_point time, bool round_up) const {
+    if (time <= origin_) {
+        return 0;
+    }
+    auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(time - origin_).count();
+    auto ticks = static_cast<std::uint64_t>(nanos / 1000000);
+    if (round_up && nanos % 1000000 != 0) {
+        ++ticks;
+    }
+    return ticks;
+}
+
+void TimerWheel::schedule(TimerNode &node, Clock::time_point deadline) {
+    if (node.scheduled()) {
+        unlink(node);
+    } else {
+        ++count_;
+    }
+    // 올림해 두면 마감보다 일찍 만료되는 일이 없다.
+    node.expires = tickOf(deadline, true);
+    link(node);
+}
+
+void TimerWheel::cancel(TimerNode &node) {
+    if (!node.scheduled()) {
+        return;
+    }
+    unlink(node);
+    node.prev = nullptr;
+    node.next = nullptr;
+    --count_;
+}
+
+/**
+ * TimerWheel::link
+ * 설명:
+ *   - 남은 틱 수로 단계를 고른다. 남은 틱이 64^(L+1) 보다 작은 가장 낮은 단계 L 의 칸 (expires >> 6L) % 64 에 넣는다.
+ *   - next_ 는 아직 처리하지 않은 첫 틱이다. 이미 지난 마감은 next_ 로 당겨 다음 advance 에서 만료시킨다.
+ */
+void TimerWheel::link(TimerNode &node) {
+    if (node.expires < next_) {
+        node.expires = next_;
+    }
+    std::uint64_t delta = node.expires - next_;
+    if (delta > MAX_SPAN) {
+        node.expires = next_ + MAX_SPAN;
+        delta = MAX_SPAN;
+    }
+
+    unsigned level = 0;
+    while (level + 1 < LEVELS && delta >= (std::uint64_t{1} << (SLOT_BITS * (level + 1)))) {
+        ++level;
+    }
+    unsigned slot = static_cast<unsigned>(node.expires >> (SLOT_BITS * level)) & (SLOTS - 1);
+
+    TimerNode &head = heads_[level][slot];
+    node.prev = head.prev;
+    node.next = &head;
+    head.prev->next = &node;
+    head.prev = &node;
+    occupied_[level] |= std::uint64_t{1} << slot;
+}
+
+void TimerWheel::unlink(TimerNode &node) {
+    if (node.prev == node.next) {
+        // 칸의 유일한 항목이면 prev 가 칸 머리다. 머리 위치로 칸 번호를 찾아 비트맵을 지운다.
+        auto index = static_cast<std::size_t>(node.prev - &heads_[0][0]);
+        occupied_[index / SLOTS] &= ~(std::uint64_t{1} << (index % SLOTS));
+    }
+    node.prev->next = node.next;
+    node.next->prev = node.prev;
+}
+
+/**
+ * TimerWheel::cascade
+ * 설명:
+ *   - next_ 가 level 단계 칸의 경계에 닿았을 때 그 칸의 항목을 남은 틱 기준으로 다시 넣는다.
+ *   - 칸을 먼저 통째로 떼어 낸 뒤 다시 넣으므로, 한 바퀴 뒤의 항목이 같은 칸으로 돌아가도 안전하다.
+ */
+void TimerWheel::cascade(unsigned level) {
+    unsigned slot = static_cast<unsigned>(next_ >> (SLOT_BITS * level)) & (SLOTS - 1);
+    TimerNode &head = heads_[level][slot];
+    if (head.next == &head) {
+        return;
+    }
+    TimerNode *node = head.next;
+    head.prev->next = nullptr;
+    head.prev = &head;
+    head.next = &head;
+    occupied_[level] &= ~(std::uint64_t{1} << slot);
+
+    while (node != nullptr) {
+        TimerNode *following = node->next;
+        link(*node);
+        node = following;
+    }
+}
+
+void TimerWheel::advance(Clock::time_point now, std::vector<std::uint64_t> &expired) {
+    const std::uint64_t target = tickOf(now, false);
+    while (next_ <= target) {
+        if (count_ == 0) {
+            next_ = target + 1;
+            return;
+        }
+
+        unsigned index = static_cast<unsigned>(next_) & (SLOTS - 1);
+        if (index == 0) {
+            // 하위 비트가 모두 0 인 가장 높은 단계부터 내려오며 칸을 나눈다.
+            unsigned top = 1;
+            while (top + 1 < LEVELS && (next_ & ((std::uint64_t{1} << (SLOT_BITS * (top + 1))) - 1)) == 0) {
+                ++top;
+            }
+            for (unsigned level = top; level >= 1; --level) {
+                cascade(level);
+            }
+        }
+
+        std::uint64_t pending = occupied_[0] >> index;
+        if (pending == 0) {
+            // 이 64틱 구간에는 더 만료될 항목이 없다. 다음 경계로 건너뛴다.
+            next_ = std::min(target + 1, (next_ | (SLOTS - 1)) + 1);
+            continue;
+        }
+        std::uint64_t tick = next_ + static_cast<std::uint64_t>(__builtin_ctzll(pending));
+        if (tick > target) {
+            next_ = target + 1;
+            return;
+        }
+
+        TimerNode &head = heads_[0][tick & (SLOTS - 1)];
+        TimerNode *node = head.next;
+        head.prev->next = nullptr;
+        head.prev = &head;
+        head.next = &head;
+        occupied_[0] &= ~(std::uint64_t{1} << (tick & (SLOTS - 1)));
+        while (node != nullptr) {
+            TimerNode *following = node->next;
+            node->prev = nullptr;
+            node->next = nullptr;
+            --count_;
+            expired.push_back(node->token);
+            node = following;
+        }
+        next_ = tick + 1;
+    }
+}
+
+int TimerWheel::nextTimeout(Clock::time_point now, int limit_ms) const {
+    if (count_ == 0) {
+        return limit_ms;
+    }
+    unsigned index = static_cast<unsigned>(next_) & (SLOTS - 1);
+    std::uint64_t pending = occupied_[0] >> index;
+    std::uint64_t tick = next_;
+    if (pending != 0) {
+        tick += static_cast<std::uint64_t>(__builtin_ctzll(pending));
+    } else if (index != 0) {
+        // 0단계가 비었으면 상위 단계 칸이 내려올 수 있는 다음 경계까지 기다린다.
+        tick = (next_ | (SLOTS - 1)) + 1;
+    }
+
+    // tick 은 now 가 origin_ + tick(ms) 에 닿으면 처리된다.
+    auto due = origin_ + std::chrono::milliseconds(tick);
+    if (due <= now) {
+        return 0;
+    }
+    auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(due - now).count();
+    auto millis = (nanos + 999999) / 1000000;
+    return millis < limit_ms ? static_cast<int>(millis) : limit_ms;
+}
@@ -0,0 +1,313 @@
+#include "tls.hpp"
+
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <climits>
+#include <cstring>
+
+/**
+ * [모듈] webserv-cpp17/src/tls.cpp
+ * 설명:
+ *   - OpenSSL 서버 컨텍스트 설정(인증서, 세션 캐시/티켓, kTLS, ALPN)과 연결별 논블로킹 TLS 읽기/쓰기를 구현한다.
+ * 버전: v1.23.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.22.0-tls.md
+ *   - design/webserv-cpp17/v1.23.0-http2.md
+ * 변경 이력:
+ *   - v1.22.0: TlsContext, TlsStream 추가
+ *   - v1.23.0: ALPN 선택 콜백(h2 > http/1.1)과 핸드셰이크 끝의 ALPN 결과 기록 추가
+ * 테스트:
+ *   - tests/test_webserv_tls.sh
+ *   - tests/test_webserv_http2.sh
+ */
+
+namespace {
+
+// 세션 캐시에 든 세션을 이 서버의 것으로 묶는 식별자. 비어 있으면 OpenSSL 이 클라이언트 인증 없는 재개도 거절한다.
+constexpr unsigned char SESSION_ID_CONTEXT[] = "webserv";
+
+// OpenSSL 오류 큐에서 가장 최근 오류를 문자열로 꺼내고 큐를 비운다.
+std::string takeError() {
+    unsigned long code = ERR_peek_last_error();
+    ERR_clear_error();
+    if (code == 0) {
+        return "알 수 없는 오류";
+    }
+    char text[256];
+    ERR_error_string_n(code, text, sizeof(text));
+    return text;
+}
+
+// ALPN 에서 서버가 고르는 프로토콜 순서(길이 접두 목록). 클라이언트가 h2 를 내밀면 h2 를 먼저 고른다.
+constexpr unsigned char ALPN_PROTOCOLS[] = {2, 'h', '2', 8, 'h', 't', 't', 'p', '/', '1', '.', '1'};
+
+int selectAlpn(SSL *, const unsigned char **out, unsigned char *out_length, const unsigned char *in,
+               unsigned int in_length, void *) {
+    unsigned char *selected = nullptr;
+    if (SSL_select_next_proto(&selected, out_length, ALPN_PROTOCOLS, sizeof(ALPN_PROTOCOLS), in, in_length) !=
+        OPENSSL_NPN_NEGOTIATED) {
+        // 겹치는 프로토콜이 없으면 ALPN 확장 없이 핸드셰이크를 잇는다(HTTP/1.1 로 말한다).
+        return SSL_TLSEXT_ERR_NOACK;
+    }
+    *out = selected;
+    return SSL_TLSEXT_ERR_OK;
+}
+
+int clampInt(std::size_t bytes) {
+    return bytes > static_cast<std::size_t>(INT_MAX) ? INT_MAX : static_cast<int>(bytes);
+}
+
+}  // namespace
+
+TlsContext::~TlsContext() {
+    SSL_CTX_free(ctx_);
+}
+
+bool TlsContext::load(const ServerConfig &config, std::string &error) {
+    ctx_ = SSL_CTX_new(TLS_server_method());
+    if (ctx_ == nullptr) {
+        error = "TLS 컨텍스트를 만들지 못했습니다: " + takeError();
+        return false;
+    }
+    SSL_CTX_set_min_proto_version(ctx_, TLS1_2_VERSION);
+    // SSL_write 가 레코드 하나를 보내면 돌아오게 한다(부분 쓰기). 재시도 사이에 출력 버퍼 주소가 바뀌어도 된다.
+    SSL_CTX_set_mode(ctx_, SSL_MODE_ENABLE_PARTIAL_WRITE | SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
+    // 레코드 헤더와 본문을 따로 읽지 않고 소켓에 온 바이트를 한 번에 읽는다.
+    SSL_CTX_set_read_ahead(ctx_, 1);
+
+    // close_notify 없이 끊는 클라이언트가 흔하다. 그 EOF 를 오류 대신 정상 종료로 본다.
+    std::uint64_t options = SSL_OP_IGNORE_UNEXPECTED_EOF | SSL_OP_NO_RENEGOTIATION | SSL_OP_CIPHER_SERVER_PREFERENCE;
+    if (!config.tls_tickets) {
+        options |= SSL_OP_NO_TICKET;
+    }
+#ifdef SSL_OP_ENABLE_KTLS
+    if (config.tls_ktls) {
+        options |= SSL_OP_ENABLE_KTLS;
+    }
+#endif
+    SSL_CTX_set_options(ctx_, options);
+
+    if (SSL_CTX_use_certificate_chain_file(ctx_, config.tls_cert.c_str()) != 1) {
+        error = "TLS 인증서를 읽지 못했습니다 (" + config.tls_cert + "): " + takeError();
+        return false;
+    }
+    if (SSL_CTX_use_PrivateKey_file(ctx_, config.tls_key.c_str(), SSL_FILETYPE_PEM) != 1) {
+        error = "TLS 개인 키를 읽지 못했습니다 (" + config.tls_key + "): " + takeError();
+        return false;
+    }
+    if (SSL_CTX_check_private_key(ctx_) != 1) {
+        error = "TLS 개인 키가 인증서와 맞지 않습니다: " + takeError();
+        return false;
+    }
+
+    SSL_CTX_set_session_id_context(ctx_, SESSION_ID_CONTEXT, sizeof(SESSION_ID_CONTEXT) - 1);
+    if (config.tls_session_cache > 0) {
+        SSL_CTX_set_session_cache_mode(ctx_, SSL_SESS_CACHE_SERVER);
+        SSL_CTX_sess_set_cache_size(ctx_, static_cast<long>(config.tls_session_cache));
+    } else {
+        SSL_CTX_set_session_cache_mode(ctx_, SSL_SESS_CACHE_OFF);
+    }
+    // TLS 1.3 은 핸드셰이크 뒤 티켓을 기본 두 장 보낸다. 연결을 하나씩 여는 클라이언트에는 한 장이면 된다.
+    // 티켓을 끄면 TLS 1.3 티켓은 세션 캐시를 가리키는 식별자가 되므로, 캐시까지 꺼졌을 때만 보내지 않는다.
+    bool resumable = config.tls_tickets || config.tls_session_cache > 0;
+    SSL_CTX_set_num_tickets(ctx_, resumable ? 1 : 0);
+    if (config.http2) {
+        SSL_CTX_set_alpn_select_cb(ctx_, selectAlpn, nullptr);
+    }
+    return true;
+}
+
+TlsStream::~TlsStream() {
+    SSL_free(ssl_);
+}
+
+bool TlsStream::attach(const TlsContext &context, int fd, WorkerMetrics &metrics) {
+    ssl_ = SSL_new(context.native());
+    if (ssl_ == nullptr || SSL_set_fd(ssl_, fd) != 1) {
+        ERR_clear_error();
+        reset();
+        return false;
+    }
+    SSL_set_accept_state(ssl_);
+    metrics_ = &metrics;
+    return true;
+}
+
+/**
+ * TlsStream::read
+ * 설명:
+ *   - SSL_read 한 번. 핸드셰이크 중이면 그 다음 단계를 진행하고, 핸드셰이크가 끝나는 순간 결과를 센다.
+ * 출력:
+ *   - 읽은 평문 바이트 수, 상대가 닫았으면 0, 아니면 -1 과 errno(EAGAIN 이면 소켓을 더 기다린다)
+ */
+ssize_t TlsStream::read(char *destination, std::size_t capacity) {
+    read_wants_write_ = false;
+    int result = SSL_read(ssl_, destination, clampInt(capacity));
+    if (!handshake_done_ && SSL_is_init_finished(ssl_)) {
+        finishHandshake();
+    }
+    if (result > 0) {
+        return result;
+    }
+    int code = failure(result, true);
+    if (code == 0) {
+        return 0;
+    }
+    errno = code;
+    return -1;
+}
+
+void TlsStream::finishHandshake() {
+    handshake_done_ = true;
+    TlsHandshakeLabel label = SSL_session_reused(ssl_) ? TlsHandshakeLabel::kResumed : TlsHandshakeLabel::kFull;
+    WorkerMetrics::add(metrics_->tls_handshakes[static_cast<std::size_t>(label)], 1);
+#ifndef OPENSSL_NO_KTLS
+    ktls_send_ = BIO_get_ktls_send(SSL_get_wbio(ssl_)) != 0;
+#endif
+    if (ktls_send_) {
+        WorkerMetrics::add(metrics_->tls_ktls_send, 1);
+    }
+    const unsigned char *protocol = nullptr;
+    unsigned int length = 0;
+    SSL_get0_alpn_selected(ssl_, &protocol, &length);
+    alpn_h2_ = length == 2 && std::memcmp(protocol, "h2", 2) == 0;
+}
+
+/**
+ * TlsStream::failure
+ * 설명:
+ *   - 실패한 SSL_read/SSL_write/SSL_sendfile 의 OpenSSL 오류를 소켓 규약의 errno 로 옮기고 오류 큐를 비운다.
+ *   - 핸드셰이크 중 프로토콜 오류나 소켓 오류로 끝나면 failed 핸드셰이크로 센다. 조용히 끊긴 연결은 세지 않는다.
+ * 출력:
+ *   - EAGAIN(소켓을 더 기다림), 0(상대가 close_notify 나 EOF 로 닫음), 그 밖의 errno 값
+ */
+int TlsStream::failure(int result, bool reading) {
+    int saved_errno = errno;
+    int code = SSL_get_error(ssl_, result);
+    ERR_clear_error();
+    switch (code) {
+        case SSL_ERROR_WANT_READ:
+            return EAGAIN;
+        case SSL_ERROR_WANT_WRITE:
+            if (reading) {
+                read_wants_write_ = true;
+            }
+            return EAGAIN;
+        case SSL_ERROR_ZERO_RETURN:
+            return 0;
+        case SSL_ERROR_SYSCALL:
+            code = saved_errno != 0 ? saved_errno : ECONNRESET;
+            break;
+        default:
+            code = EPROTO;
+            break;
+    }
+    if (!handshake_done_ && !failed_) {
+        WorkerMetrics::add(metrics_->tls_handshakes[static_cast<std::size_t>(TlsHandshakeLabel::kFailed)], 1);
+    }
+    // 치명적 오류 뒤에는 SSL_shutdown 을 부르면 안 된다.
+    failed_ = true;
+    return code;
+}
+
+FlushResult TlsStream::writeFailure(int result) {
+    int code = failure(result, false);
+    if (code == EAGAIN) {
+        return FlushResult::kBlocked;
+    }
+    errno = code == 0 ? EPIPE : code;
+    return FlushResult::kError;
+}
+
+/**
+ * TlsStream::flush
+ * 설명:
+ *   - 출력 큐를 앞에서부터 암호화해 보낸다. 버퍼 바이트는 SSL_write 로 그대로 보낸다.
+ *   - 파일 구간은 kTLS 송신이 켜져 있으면 SSL_sendfile 로, 아니면 pread 로 scratch 에 읽어 SSL_write 로 보낸다.
+ *     이때 파일 앞 헤더(RECORD_BYTES 보다 작을 때)를 scratch 앞에 함께 넣어 헤더와 본문 첫 부분이 한 레코드로 나간다.
+ * 출력:
+ *   - OutputQueue::flush 와 같다. sent_out 은 평문 바이트 수다.
+ * 주의 사항:
+ *   - 막힌 SSL_write 를 다시 부를 때 앞 바이트가 같아야 한다. 다음 호출도 같은 큐 앞부분에서 같은 방식으로 만들므로
+ *     길이는 같거나 길다(파일을 읽는 중 파일이 바뀌지 않는다고 본다).
+ */
+FlushResult TlsStream::flush(OutputQueue &output, char *scratch, std::size_t &sent_out) {
+    sent_out = 0;
+    while (!output.empty()) {
+        bool file_follows = false;
+        std::string_view chunk = output.sendable(file_follows);
+        if (!file_follows || (!chunk.empty() && (ktls_send_ || chunk.size() >= RECORD_BYTES))) {
+            int written = SSL_write(ssl_, chunk.data(), clampInt(chunk.size()));
+            if (written <= 0) {
+                return writeFailure(written);
+            }
+            output.markSent(static_cast<std::size_t>(written));
+            sent_out += static_cast<std::size_t>(written);
+            continue;
+        }
+
+        OutputQueue::FileRange file = output.pendingFile();
+#ifndef OPENSSL_NO_KTLS
+        if (ktls_send_) {
+            // 레코드를 커널이 만들고 암호화하므로 파일 내용이 사용자 공간을 거치지 않는다.
+            ossl_ssize_t sent = SSL_sendfile(ssl_, file.fd, static_cast<off_t>(file.offset), file.length, 0);
+            if (sent <= 0) {
+                return writeFailure(static_cast<int>(sent));
+            }
+            output.markFileSent(static_cast<std::size_t>(sent));
+            sent_out += static_cast<std::size_t>(sent);
+            continue;
+        }
+#endif
+
+        std::size_t head = chunk.size();
+        std::memcpy(scratch, chunk.data(), head);
+        std::size_t want = file.length < RECORD_BYTES - head ? file.length : RECORD_BYTES - head;
+        ssize_t got = ::pread(file.fd, scratch + head, want, static_cast<off_t>(file.offset));
+        if (got < 0 && errno == EINTR) {
+            continue;
+        }
+        if (got <= 0) {
+            // 송신 도중 파일이 잘리면 응답 길이를 지킬 수 없다(sendfile 경로와 같다).
+            if (got == 0) {
+                errno = EIO;
+            }
+            return FlushResult::kError;
+        }
+        int written = SSL_write(ssl_, scratch, static_cast<int>(head + static_cast<std::size_t>(got)));
+        if (written <= 0) {
+            return writeFailure(written);
+        }
+        std::size_t from_head = static_cast<std::size_t>(written) < head ? static_cast<std::size_t>(written) : head;
+        if (from_head > 0) {
+            output.markSent(from_head);
+        }
+        if (static_cast<std::size_t>(written) > from_head) {
+            output.markFileSent(static_cast<std::size_t>(written) - from_head);
+        }
+        sent_out += static_cast<std::size_t>(written);
+    }
+    return FlushResult::kDrained;
+}
+
+void TlsStream::shutdown() {
+    if (ssl_ != nullptr && handshake_done_ && !failed_) {
+        // 보내지 못해도 기다리지 않는다. 상대는 TCP 종료로도 응답의 끝을 안다.
+        SSL_shutdown(ssl_);
+        ERR_clear_error();
+    }
+}
+
+void TlsStream::reset() {
+    SSL_free(ssl_);
+    ssl_ = nullptr;
+    metrics_ = nullptr;
+    handshake_done_ = false;
+    read_wants_write_ = false;
+    ktls_send_ = false;
+    alpn_h2_ = false;
+    failed_ = false;
+}
@@ -0,0 +1,619 @@
+#include "uring_backend.hpp"
+
+#include <linux/time_types.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+/**
+ * [모듈] webserv-cpp17/src/uring_backend.cpp
+ * 설명:
+ *   - io_uring 링 준비(mmap, 제공 버퍼 링 등록), 작업 제출, 완료 수거와 연결별 상태 전이를 구현한다.
+ * 버전: v1.25.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.11.0-io-uring-backend.md
+ *   - design/webserv-cpp17/v1.25.0-config-reload.md
+ * 변경 이력:
+ *   - v1.11.0: io_uring 백엔드 추가
+ *   - v1.25.0: unwatchListener: multishot accept 를 ASYNC_CANCEL 로 취소하고 다시 걸지 않음
+ * 테스트:
+ *   - tests/test_webserv_io_uring.sh
+ *   - tests/test_webserv_reload.sh
+ */
+
+namespace {
+
+constexpr unsigned OP_SHIFT = 56;
+constexpr std::uint64_t DATA_MASK = (std::uint64_t{1} << OP_SHIFT) - 1;
+constexpr std::uint16_t BUFFER_GROUP = 0;
+
+std::uint64_t userData(std::uint8_t op, std::uint64_t data) {
+    return (static_cast<std::uint64_t>(op) << OP_SHIFT) | (data & DATA_MASK);
+}
+
+}  // namespace
+
+IoUringBackend::IoUringBackend(ConnectionPool &connections)
+    : connections_(connections),
+      ring_fd_(-1),
+      setup_error_(0),
+      sq_ring_(MAP_FAILED),
+      sq_ring_size_(0),
+      cq_ring_(MAP_FAILED),
+      cq_ring_size_(0),
+      sqes_(nullptr),
+      sqes_size_(0),
+      sq_head_(nullptr),
+      sq_tail_(nullptr),
+      sq_mask_(0),
+      sq_entries_(0),
+      sq_local_tail_(0),
+      cq_head_(nullptr),
+      cq_tail_(nullptr),
+      cq_mask_(0),
+      cqes_(nullptr),
+      buffer_ring_(nullptr),
+      buffer_ring_size_(0),
+      buffers_(nullptr),
+      buffer_tail_(0),
+      listen_fd_(-1),
+      accept_stopped_(false) {
+    if (!setup()) {
+        setup_error_ = errno;
+        teardown();
+        errno = setup_error_;
+    }
+}
+
+IoUringBackend::~IoUringBackend() {
+    while (!accepted_.empty()) {
+        if (accepted_.front() >= 0) {
+            ::close(accepted_.front());
+        }
+        accepted_.pop_front();
+    }
+    teardown();
+}
+
+/**
+ * IoUringBackend::setup
+ * 설명:
+ *   - 링을 만들고 SQ/CQ/SQE 영역을 mmap 한 뒤, 제공 버퍼 링을 등록하고 모든 버퍼를 채워 둔다.
+ *   - SUBMIT_ALL(중간 SQE 실패에도 나머지 제출), COOP_TASKRUN(완료 처리를 다음 진입 때 몰아서)을 먼저 시도하고,
+ *     커널이 거부하면 기본 플래그로 다시 만든다.
+ *   - 제공 버퍼 링(5.19)을 등록할 수 있으면 multishot accept(5.19)도 있다고 본다.
+ * 출력:
+ *   - 성공 시 true, 실패 시 false (errno 유지)
+ */
+bool IoUringBackend::setup() {
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    params.flags = IORING_SETUP_CQSIZE | IORING_SETUP_SUBMIT_ALL | IORING_SETUP_COOP_TASKRUN;
+    params.cq_entries = CQ_ENTRIES;
+    ring_fd_ = static_cast<int>(::syscall(SYS_io_uring_setup, SQ_ENTRIES, &params));
+    if (ring_fd_ < 0 && errno == EINVAL) {
+        std::memset(&params, 0, sizeof(params));
+        params.flags = IORING_SETUP_CQSIZE;
+        params.cq_entries = CQ_ENTRIES;
+        ring_fd_ = static_cast<int>(::syscall(SYS_io_uring_setup, SQ_ENTRIES, &params));
+    }
+    if (ring_fd_ < 0) {
+        return false;
+    }
+
+    sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap) {
+        sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+    }
+    sq_ring_ = ::mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                      IORING_OFF_SQ_RING);
+    if (sq_ring_ == MAP_FAILED) {
+        return false;
+    }
+    if (single_mmap) {
+        cq_ring_ = sq_ring_;
+    } else {
+        cq_ring_ = ::mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                          IORING_OFF_CQ_RING);
+        if (cq_ring_ == MAP_FAILED) {
+            return false;
+        }
+    }
+    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+    void *sqes = ::mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                        IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+        return false;
+    }
+    sqes_ = static_cast<io_uring_sqe *>(sqes);
+
+    char *sq = static_cast<char *>(sq_ring_);
+    sq_head_ = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+    sq_tail_ = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+    sq_mask_ = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+    sq_entries_ = params.sq_entries;
+    sq_local_tail_ = *sq_tail_;
+    // SQ 색인 배열은 항등 사상으로 고정해 두고, 이후에는 꼬리만 올린다.
+    unsigned *array = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+    for (unsigned i = 0; i < sq_entries_; ++i) {
+        array[i] = i;
+    }
+
+    char *cq = static_cast<char *>(cq_ring_);
+    cq_head_ = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+    cq_mask_ = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+
+    buffer_ring_size_ = BUFFER_COUNT * sizeof(io_uring_buf);
+    void *ring = ::mmap(nullptr, buffer_ring_size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ring == MAP_FAILED) {
+        return false;
+    }
+    buffer_ring_ = static_cast<io_uring_buf_ring *>(ring);
+    void *buffers =
+        ::mmap(nullptr, BUFFER_COUNT * BUFFER_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (buffers == MAP_FAILED) {
+        return false;
+    }
+    buffers_ = static_cast<char *>(buffers);
+
+    // 링을 먼저 채운 뒤 등록한다. 등록 뒤에는 커널이 링 페이지를 고정해 읽는다.
+    for (unsigned i = 0; i < BUFFER_COUNT; ++i) {
+        publishBuffer(static_cast<int>(i));
+    }
+    io_uring_buf_reg reg;
+    std::memset(&reg, 0, sizeof(reg));
+    reg.ring_addr = reinterpret_cast<std::uint64_t>(buffer_ring_);
+    reg.ring_entries = BUFFER_COUNT;
+    reg.bgid = BUFFER_GROUP;
+    // 링 등록(5.19)이 안 되는 커널은 multishot accept 도 없으므로 PROVIDE_BUFFERS 로 대신하지 않고 실패한다.
+    // 팩토리가 epoll 로 대신한다.
+    return ::syscall(SYS_io_uring_register, ring_fd_, IORING_REGISTER_PBUF_RING, &reg, 1) == 0;
+}
+
+void IoUringBackend::teardown() {
+    if (ring_fd_ >= 0) {
+        ::close(ring_fd_);
+        ring_fd_ = -1;
+    }
+    if (buffers_ != nullptr) {
+        ::munmap(buffers_, BUFFER_COUNT * BUFFER_SIZE);
+        buffers_ = nullptr;
+    }
+    if (buffer_ring_ != nullptr) {
+        ::munmap(buffer_ring_, buffer_ring_size_);
+        buffer_ring_ = nullptr;
+    }
+    if (sqes_ != nullptr) {
+        ::munmap(sqes_, sqes_size_);
+        sqes_ = nullptr;
+    }
+    if (cq_ring_ != MAP_FAILED && cq_ring_ != sq_ring_) {
+        ::munmap(cq_ring_, cq_ring_size_);
+    }
+    cq_ring_ = MAP_FAILED;
+    if (sq_ring_ != MAP_FAILED) {
+        ::munmap(sq_ring_, sq_ring_size_);
+        sq_ring_ = MAP_FAILED;
+    }
+}
+
+int IoUringBackend::enter(unsigned to_submit, unsigned min_complete, unsigned flags, const void *arg,
+                          std::size_t arg_size) {
+    return static_cast<int>(
+        ::syscall(SYS_io_uring_enter, ring_fd_, to_submit, min_complete, flags, arg, arg_size));
+}
+
+unsigned IoUringBackend::unsubmitted() const {
+    return sq_local_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * IoUringBackend::nextSqe
+ * 설명:
+ *   - 빈 SQE 하나를 0 으로 채워 돌려준다. SQ 가 가득 차면 쌓인 작업을 먼저 제출해 자리를 만든다.
+ * 출력:
+ *   - SQE, 제출도 실패하면 nullptr (errno 유지)
+ */
+io_uring_sqe *IoUringBackend::nextSqe() {
+    if (unsubmitted() >= sq_entries_) {
+        __atomic_store_n(sq_tail_, sq_local_tail_, __ATOMIC_RELEASE);
+        if (enter(unsubmitted(), 0, 0, nullptr, 0) < 0 && errno != EBUSY && errno != EAGAIN) {
+            return nullptr;
+        }
+        if (unsubmitted() >= sq_entries_) {
+            errno = EBUSY;
+            return nullptr;
+        }
+    }
+    io_uring_sqe *sqe = &sqes_[sq_local_tail_ & sq_mask_];
+    std::memset(sqe, 0, sizeof(*sqe));
+    ++sq_local_tail_;
+    return sqe;
+}
+
+void IoUringBackend::publishBuffer(int buffer_id) {
+    // 커널 헤더의 bufs 는 __DECLARE_FLEX_ARRAY 로 선언되는데, C++ 에서는 앞의 빈 구조체가 1바이트를 차지해
+    // bufs 가 8바이트 밀린다. 링 시작 주소를 바로 io_uring_buf 배열로 본다(tail 은 첫 칸의 resv 자리라 그대로 쓴다).
+    io_uring_buf &slot = reinterpret_cast<io_uring_buf *>(buffer_ring_)[buffer_tail_ & (BUFFER_COUNT - 1)];
+    slot.addr = reinterpret_cast<std::uint64_t>(buffers_ + static_cast<std::size_t>(buffer_id) * BUFFER_SIZE);
+    slot.len = static_cast<std::uint32_t>(BUFFER_SIZE);
+    slot.bid = static_cast<std::uint16_t>(buffer_id);
+    ++buffer_tail_;
+    __atomic_store_n(&buffer_ring_->tail, buffer_tail_, __ATOMIC_RELEASE);
+}
+
+/**
+ * IoUringBackend::recycleBuffer
+ * 설명:
+ *   - 다 읽은 버퍼를 커널이 다시 고를 수 있게 돌려준다. 링 꼬리만 올리므로 시스템 호출이 없다.
+ *   - 버퍼가 없어 수신을 못 건 연결이 있으면 하나를 다시 건다.
+ */
+void IoUringBackend::recycleBuffer(int buffer_id) {
+    publishBuffer(buffer_id);
+
+    while (!starved_.empty()) {
+        std::uint64_t handle = starved_.front();
+        starved_.pop_front();
+        Connection *conn = connections_.find(handle);
+        if (conn != nullptr && !conn->io.recv_armed && conn->io.recv_buffer < 0) {
+            armRecv(*conn);
+            break;
+        }
+    }
+}
+
+bool IoUringBackend::armAccept(int listen_fd) {
+    io_uring_sqe *sqe = nextSqe();
+    if (sqe == nullptr) {
+        return false;
+    }
+    sqe->opcode = IORING_OP_ACCEPT;
+    sqe->fd = listen_fd;
+    sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+    sqe->accept_flags = SOCK_NONBLOCK | SOCK_CLOEXEC;
+    sqe->user_data = userData(static_cast<std::uint8_t>(Op::kAccept), static_cast<std::uint64_t>(listen_fd));
+    return true;
+}
+
+bool IoUringBackend::armPollIn(int fd) {
+    io_uring_sqe *sqe = nextSqe();
+    if (sqe == nullptr) {
+        return false;
+    }
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = fd;
+    sqe->poll32_events = POLLIN;
+    sqe->len = IORING_POLL_ADD_MULTI;
+    sqe->user_data = userData(static_cast<std::uint8_t>(Op::kPollIn), static_cast<std::uint64_t>(fd));
+    return true;
+}
+
+bool IoUringBackend::armRecv(Connection &conn) {
+    io_uring_sqe *sqe = nextSqe();
+    if (sqe == nullptr) {
+        return false;
+    }
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = conn.fd;
+    sqe->len = static_cast<std::uint32_t>(BUFFER_SIZE);
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = BUFFER_GROUP;
+    sqe->user_data = userData(static_cast<std::uint8_t>(Op::kRecv), conn.handle);
+    conn.io.recv_armed = true;
+    return true;
+}
+
+bool IoUringBackend::armPollOut(Connection &conn) {
+    io_uring_sqe *sqe = nextSqe();
+    if (sqe == nullptr) {
+        return false;
+    }
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = conn.fd;
+    sqe->poll32_events = POLLOUT;
+    sqe->user_data = userData(static_cast<std::uint8_t>(Op::kPollOut), conn.handle);
+    conn.io.poll_armed = true;
+    return true;
+}
+
+bool IoUringBackend::watchListener(int listen_fd) {
+    listen_fd_ = listen_fd;
+    return armAccept(listen_fd);
+}
+
+bool IoUringBackend::watchReadable(int fd) {
+    return armPollIn(fd);
+}
+
+/**
+ * IoUringBackend::unwatchListener
+ * 설명:
+ *   - 걸어 둔 다중 수락을 ASYNC_CANCEL 로 거둔다. 취소 완료(-ECANCELED)는 수락 실패로 넘기지 않는다.
+ *   - 이미 받아 둔 FD 는 accepted_ 에 남아 있으므로 워커가 계속 꺼내 간다.
+ */
+void IoUringBackend::unwatchListener(int listen_fd) {
+    accept_stopped_ = true;
+    io_uring_sqe *sqe = nextSqe();
+    if (sqe == nullptr) {
+        return;
+    }
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = -1;
+    sqe->addr = userData(static_cast<std::uint8_t>(Op::kAccept), static_cast<std::uint64_t>(listen_fd));
+    sqe->user_data = userData(static_cast<std::uint8_t>(Op::kCancel), 0);
+}
+
+int IoUringBackend::accept(int listen_fd) {
+    (void)listen_fd;
+    if (accepted_.empty()) {
+        errno = EAGAIN;
+        return -1;
+    }
+    int fd = accepted_.front();
+    accepted_.pop_front();
+    if (fd < 0) {
+        errno = -fd;
+        return -1;
+    }
+    return fd;
+}
+
+bool IoUringBackend::addConnection(Connection &conn) {
+    // 첫 요청을 기다리는 RECV 를 바로 걸어, 수락과 첫 수신이 같은 제출에 실리게 한다.
+    return armRecv(conn);
+}
+
+/**
+ * IoUringBackend::recv
+ * 설명:
+ *   - 완료된 수신 버퍼가 있으면 그 남은 부분을 복사해 돌려주고, 다 읽은 버퍼는 링에 돌려준다.
+ *   - 버퍼가 없으면 완료로 받아 둔 원격 종료/오류를 돌려주거나, RECV 를 걸고 EAGAIN 을 돌려준다.
+ */
+ssize_t IoUringBackend::recv(Connection &conn, char *destination, std::size_t capacity) {
+    ConnectionIo &io = conn.io;
+    if (io.recv_buffer >= 0) {
+        std::size_t length = std::min<std::size_t>(capacity, io.recv_length - io.recv_offset);
+        std::memcpy(destination,
+                    buffers_ + static_cast<std::size_t>(io.recv_buffer) * BUFFER_SIZE + io.recv_offset, length);
+        io.recv_offset += static_cast<std::uint32_t>(length);
+        if (io.recv_offset == io.recv_length) {
+            int buffer_id = io.recv_buffer;
+            io.recv_buffer = -1;
+            recycleBuffer(buffer_id);
+        }
+        return static_cast<ssize_t>(length);
+    }
+    if (io.recv_error != 0) {
+        errno = io.recv_error;
+        return -1;
+    }
+    if (io.recv_eof) {
+        return 0;
+    }
+    if (!io.recv_armed && !armRecv(conn)) {
+        return -1;
+    }
+    errno = EAGAIN;
+    return -1;
+}
+
+/**
+ * IoUringBackend::flush
+ * 설명:
+ *   - 지난 flush 이후 완료된 송신 바이트를 보고하고, 걸린 송신이 없으면 다음 버퍼 구간의 SEND 를 건다.
+ *   - 맨 앞이 파일 구간이면 OutputQueue::flush 로 바로 sendfile 하고, 막히면 POLLOUT 을 건다.
+ */
+FlushResult IoUringBackend::flush(Connection &conn, std::size_t &sent_out) {
+    ConnectionIo &io = conn.io;
+    sent_out = io.sent;
+    io.sent = 0;
+    if (io.send_error != 0) {
+        errno = io.send_error;
+        return FlushResult::kError;
+    }
+    if (io.send_armed || io.poll_armed) {
+        return FlushResult::kBlocked;
+    }
+    if (conn.output.empty()) {
+        return FlushResult::kDrained;
+    }
+
+    bool file_follows = false;
+    std::string_view chunk = conn.output.sendable(file_follows);
+    if (chunk.empty()) {
+        std::size_t sent = 0;
+        FlushResult result = conn.output.flush(conn.fd, sent);
+        sent_out += sent;
+        if (result == FlushResult::kBlocked && !armPollOut(conn)) {
+            return FlushResult::kError;
+        }
+        return result;
+    }
+
+    io_uring_sqe *sqe = nextSqe();
+    if (sqe == nullptr) {
+        return FlushResult::kError;
+    }
+    sqe->opcode = IORING_OP_SEND;
+    sqe->fd = conn.fd;
+    sqe->addr = reinterpret_cast<std::uint64_t>(chunk.data());
+    sqe->len = static_cast<std::uint32_t>(std::min<std::size_t>(chunk.size(), UINT32_MAX));
+    sqe->msg_flags = MSG_NOSIGNAL | (file_follows ? MSG_MORE : 0);
+    sqe->user_data = userData(static_cast<std::uint8_t>(Op::kSend), conn.handle);
+    io.send_armed = true;
+    return FlushResult::kBlocked;
+}
+
+bool IoUringBackend::updateInterest(Connection &conn) {
+    // 송신 진척은 SEND/POLLOUT 완료로 통지되므로 따로 바꿀 관심사가 없다.
+    (void)conn;
+    return true;
+}
+
+void IoUringBackend::closeConnection(Connection &conn) {
+    ConnectionIo &io = conn.io;
+    if (io.recv_buffer >= 0) {
+        int buffer_id = io.recv_buffer;
+        io.recv_buffer = -1;
+        recycleBuffer(buffer_id);
+    }
+    if (io.send_armed) {
+        // 커널이 아직 출력 버퍼를 읽을 수 있으므로 완료가 올 때까지 버퍼를 살려 둔다.
+        orphans_.emplace(userData(static_cast<std::uint8_t>(Op::kSend), conn.handle), std::move(conn.output));
+        conn.output = OutputQueue();
+    }
+    if (io.recv_armed || io.send_armed || io.poll_armed) {
+        // 걸린 작업이 소켓 참조를 쥐고 있으므로 close 전에 끊어 작업을 끝낸다.
+        ::shutdown(conn.fd, SHUT_RDWR);
+    }
+    ::close(conn.fd);
+}
+
+/**
+ * IoUringBackend::handleCompletion
+ * 설명:
+ *   - 완료 하나를 연결 상태에 반영하고, 워커가 처리할 이벤트를 out 에 더한다.
+ *   - 닫힌 연결의 완료는 무시하되, 고른 버퍼는 돌려주고 맡아 둔 출력 큐는 놓는다.
+ */
+void IoUringBackend::handleCompletion(const io_uring_cqe &cqe, std::vector<IoEvent> &out) {
+    Op op = static_cast<Op>(cqe.user_data >> OP_SHIFT);
+    std::uint64_t data = cqe.user_data & DATA_MASK;
+    bool more = (cqe.flags & IORING_CQE_F_MORE) != 0;
+
+    switch (op) {
+        case Op::kAccept:
+            if (cqe.res >= 0 || (cqe.res != -EAGAIN && cqe.res != -EINTR && cqe.res != -ECANCELED)) {
+                accepted_.push_back(cqe.res);
+            }
+            if (!more && !accept_stopped_) {
+                armAccept(static_cast<int>(data));
+            }
+            return;
+        case Op::kCancel:
+            return;
+        case Op::kPollIn:
+            out.push_back(IoEvent{data, EVENT_READ});
+            if (!more) {
+                armPollIn(static_cast<int>(data));
+            }
+            return;
+        default:
+            break;
+    }
+
+    Connection *conn = connections_.find(data);
+    if (op == Op::kRecv) {
+        bool has_buffer = (cqe.flags & IORING_CQE_F_BUFFER) != 0;
+        int buffer_id = static_cast<int>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+        if (conn == nullptr || !conn->io.recv_armed) {
+            if (has_buffer) {
+                recycleBuffer(buffer_id);
+            }
+            return;
+        }
+        ConnectionIo &io = conn->io;
+        io.recv_armed = false;
+        if (cqe.res > 0) {
+            io.recv_buffer = buffer_id;
+            io.recv_offset = 0;
+            io.recv_length = static_cast<std::uint32_t>(cqe.res);
+        } else {
+            if (has_buffer) {
+                recycleBuffer(buffer_id);
+            }
+            if (cqe.res == 0) {
+                io.recv_eof = true;
+            } else if (cqe.res == -ENOBUFS) {
+                // 제공 버퍼가 모두 다른 연결에 붙잡혀 있다. 버퍼가 돌아오면 다시 건다.
+                starved_.push_back(data);
+                return;
+            } else if (cqe.res != -EAGAIN && cqe.res != -EINTR) {
+                io.recv_error = -cqe.res;
+            }
+        }
+        out.push_back(IoEvent{data, EVENT_READ});
+        return;
+    }
+
+    if (op == Op::kSend) {
+        if (conn == nullptr || !conn->io.send_armed) {
+            orphans_.erase(cqe.user_data);
+            return;
+        }
+        ConnectionIo &io = conn->io;
+        io.send_armed = false;
+        if (cqe.res > 0) {
+            conn->output.markSent(static_cast<std::size_t>(cqe.res));
+            io.sent += static_cast<std::size_t>(cqe.res);
+        } else if (cqe.res < 0 && cqe.res != -EAGAIN && cqe.res != -EINTR) {
+            io.send_error = -cqe.res;
+        }
+        out.push_back(IoEvent{data, EVENT_WRITE});
+        return;
+    }
+
+    if (op == Op::kPollOut && conn != nullptr && conn->io.poll_armed) {
+        conn->io.poll_armed = false;
+        out.push_back(IoEvent{data, EVENT_WRITE});
+    }
+}
+
+/**
+ * IoUringBackend::wait
+ * 설명:
+ *   - 이번 회차에 쌓인 작업을 제출하면서 완료를 기다리는 io_uring_enter 한 번을 부른다.
+ *     이미 수거할 완료가 있거나 timeout_ms 가 0 이면 기다리지 않는다.
+ *   - CQ 의 완료를 모두 수거해 이벤트로 바꾸고, 수락된 연결이 있으면 리슨 소켓 이벤트 하나를 더한다.
+ * 출력:
+ *   - 이벤트 수, EINTR/시간 초과면 0, 그 밖의 실패는 -1
+ */
+int IoUringBackend::wait(std::vector<IoEvent> &out, int timeout_ms) {
+    out.clear();
+    __atomic_store_n(sq_tail_, sq_local_tail_, __ATOMIC_RELEASE);
+    unsigned to_submit = unsubmitted();
+    bool ready = *cq_head_ != __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+
+    int result = 0;
+    if (ready) {
+        if (to_submit > 0) {
+            result = enter(to_submit, 0, 0, nullptr, 0);
+        }
+    } else if (timeout_ms > 0) {
+        __kernel_timespec timeout;
+        timeout.tv_sec = timeout_ms / 1000;
+        timeout.tv_nsec = static_cast<long long>(timeout_ms % 1000) * 1000000;
+        io_uring_getevents_arg arg;
+        std::memset(&arg, 0, sizeof(arg));
+        arg.ts = reinterpret_cast<std::uint64_t>(&timeout);
+        result = enter(to_submit, 1, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+    } else {
+        // 기다리지 않더라도 진입해야 COOP_TASKRUN 으로 미뤄진 완료가 CQ 에 채워진다.
+        result = enter(to_submit, 0, IORING_ENTER_GETEVENTS, nullptr, 0);
+    }
+    if (result < 0 && errno != EINTR && errno != ETIME && errno != EBUSY && errno != EAGAIN) {
+        return -1;
+    }
+
+    unsigned head = *cq_head_;
+    unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    while (head != tail) {
+        handleCompletion(cqes_[head & cq_mask_], out);
+        ++head;
+    }
+    __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+
+    if (!accepted_.empty()) {
+        out.push_back(IoEvent{static_cast<std::uint64_t>(listen_fd_), EVENT_READ});
+    }
+    return static_cast<int>(out.size());
+}
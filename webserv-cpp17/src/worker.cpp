@@ -0,0 +1,3290 @@
+#include "worker.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "http2.hpp"
+#include "http_message.hpp"
+#include "http_parser.hpp"
+#include "proxy.hpp"
+#include "request_body.hpp"
+#include "response_cache.hpp"
+#include "router.hpp"
+
+/**
+ * [모듈] webserv-cpp17/src/worker.cpp
+ * 설명:
+ *   - HTTP/1.1 Host 헤더와 keep-alive를 지원하는 워커 하나의 이벤트 루프를 제공한다.
+ *   - v1.1.0에서 select 대신 epoll 엣지 트리거 리액터로 준비된 연결만 처리한다.
+ *   - v1.2.0부터 워커마다 SO_REUSEPORT 리슨 소켓을 따로 열어 커널이 연결을 분배한다.
+ * 버전: v1.25.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v0.2.0-multi-connection-loop.md
+ *   - design/webserv-cpp17/v0.3.0-http11-core.md
+ *   - design/webserv-cpp17/v0.4.0-dynamic-handlers.md
+ *   - design/webserv-cpp17/v1.1.0-epoll-reactor.md
+ *   - design/webserv-cpp17/v1.2.0-reuseport-workers.md
+ *   - design/webserv-cpp17/v1.3.0-incremental-parser.md
+ *   - design/webserv-cpp17/v1.4.0-input-cursor-buffer.md
+ *   - design/webserv-cpp17/v1.5.0-output-queue.md
+ *   - design/webserv-cpp17/v1.6.0-static-files.md
+ *   - design/webserv-cpp17/v1.7.0-worker-metrics.md
+ *   - design/webserv-cpp17/v1.8.0-timer-wheel.md
+ *   - design/webserv-cpp17/v1.9.0-connection-pool.md
+ *   - design/webserv-cpp17/v1.10.0-zero-alloc-responses.md
+ *   - design/webserv-cpp17/v1.11.0-io-uring-backend.md
+ *   - design/webserv-cpp17/v1.12.0-streaming-request-body.md
+ *   - design/webserv-cpp17/v1.13.0-router.md
+ *   - design/webserv-cpp17/v1.14.0-response-compression.md
+ *   - design/webserv-cpp17/v1.15.0-response-cache.md
+ *   - design/webserv-cpp17/v1.16.0-reverse-proxy.md
+ *   - design/webserv-cpp17/v1.17.0-handler-offload.md
+ *   - design/webserv-cpp17/v1.18.0-coroutine-handlers.md
+ *   - design/webserv-cpp17/v1.20.0-accept-path.md
+ *   - design/webserv-cpp17/v1.21.0-access-log.md
+ *   - design/webserv-cpp17/v1.22.0-tls.md
+ *   - design/webserv-cpp17/v1.23.0-http2.md
+ *   - design/webserv-cpp17/v1.24.0-client-limits.md
+ *   - design/webserv-cpp17/v1.25.0-config-reload.md
+ * 변경 이력:
+ *   - v0.1.0: 단일 연결 처리 및 고정 응답 송신 기능 추가
+ *   - v0.2.0: 비동기 다중 연결 루프와 타임아웃 관리 추가
+ *   - v0.3.0: Host 헤더 검증, keep-alive 처리, 요청 파싱 개선
+ *   - v0.4.0: 동적 엔드포인트(/health, /metrics) 라우팅 추가
+ *   - v1.1.0: epoll 리액터, FD 색인 연결 테이블, 주기적 타임아웃 점검으로 전환
+ *   - v1.2.0: Worker 로 분리, SO_REUSEPORT 리슨 소켓과 공유 RunControl 종료 조건 추가
+ *   - v1.3.0: 연결별 증분 파서(HttpParser)로 요청 파싱, 형식 오류 시 400 응답
+ *   - v1.4.0: 읽기 커서 입력 버퍼(InputBuffer)에 직접 recv 하고 커서 이동으로 요청을 소비
+ *   - v1.5.0: 논블로킹 송신 경로(출력 큐, writev 묶음 송신, EVENT_WRITE 재개, 백프레셔) 추가
+ *   - v1.6.0: `--root` 문서 루트 정적 파일 서빙(sendfile, FD/메타데이터 LRU 캐시, inotify 무효화)
+ *   - v1.7.0: /metrics 를 워커별 계측 합산(Prometheus 형식)으로 교체, 요청 지연 히스토그램 기록
+ *   - v1.8.0: 100ms 마다 전체 연결을 훑던 타임아웃 점검을 타이밍 휠로 교체, 헤더 수신/유휴/송신 타임아웃 분리
+ *   - v1.9.0: 연결 테이블을 슬랩 연결 풀로 교체, 이벤트/타이머/지연 목록 토큰을 세대 태그 핸들로 변경
+ *   - v1.10.0: 응답을 출력 큐 버퍼에 바로 직렬화하고 고정 응답은 미리 만든 바이트열로 보내 요청당 힙 할당 제거
+ *   - v1.11.0: 수락/수신/송신/대기를 I/O 백엔드(epoll, io_uring) 인터페이스로 위임
+ *   - v1.12.0: 요청 본문(Content-Length/chunked) 증분 수신, 헤더/본문 크기 제한, POST /upload, Expect: 100-continue 처리
+ *   - v1.13.0: 경로 비교 if 문 대신 고정 경로 완전 해시 표 + 기수 트리 라우터로 핸들러를 찾고, `/metrics/workers/:id` 추가
+ *   - v1.14.0: `Accept-Encoding` 협상으로 동적 본문은 바로 압축하고, 정적 파일은 작업 스레드가 미리 만든 압축본을 보냄
+ *   - v1.15.0: 라우트 응답 캐시(TTL, ETag/Last-Modified)와 `If-None-Match`/`If-Modified-Since` 304 응답, 정적 파일 `If-None-Match` 304
+ *   - v1.16.0: `--proxy` 경로 요청을 keep-alive 업스트림 연결 풀로 넘기는 리버스 프록시(본문 양방향 스트리밍, 라운드 로빈/least-conn)
+ *   - v1.17.0: 블로킹 핸들러(`--demo-routes` 의 `/delay/:ms`)를 작업 스레드 풀에 맡기고 eventfd 완료 큐로 응답,
+ *              큐가 차거나 풀이 없으면 503
+ *   - v1.18.0: 본문 조각/타이머/업스트림 응답을 기다리며 이벤트 루프 위에서 도는 코루틴 핸들러
+ *              (`--demo-routes` 의 `/sleep/:ms`, `POST /upload/echo`, `/fetch/<경로>`)
+ *   - v1.20.0: 리슨 소켓 옵션(백로그, TCP_DEFER_ACCEPT, TCP_FASTOPEN, TCP_NODELAY 상속)과 루프 회차당 수락 예산
+ *   - v1.21.0: 요청마다 접근 로그 레코드(메서드, 경로, 상태, 바이트, 처리 지연, 연결 핸들)를 표본 간격에 맞춰 워커 링에 넣기
+ *   - v1.22.0: TLS 포트 리슨 소켓, 수락 시 SSL 객체 연결, 핸드셰이크 쓰기 대기 이벤트를 읽기 경로로 넘김
+ *   - v1.23.0: HTTP/2 연결을 processHttp2 로 처리하고 스트림별 라우팅, 작업 스레드 위임, 업로드 본문, 접근 로그를 붙임
+ *   - v1.24.0: 수락 시 클라이언트 한도 표의 칸 잡기와 연결 한도, 요청마다 토큰 버킷(429)과 과부하(503) 거절, 루프 지연으로 과부하 상태 갱신
+ *   - v1.25.0: 설정 세대 적용(applyConfig), 업스트림 풀 교체와 이전 풀 보관, 넘겨받은 리슨 소켓, drain
+ * 테스트:
+ *   - tests/test_webserv.sh
+ *   - tests/test_webserv_multi.sh
+ *   - tests/test_webserv_host_header.sh
+ *   - tests/test_webserv_keepalive.sh
+ *   - tests/test_webserv_dynamic.sh
+ *   - tests/test_webserv_epoll_many.sh
+ *   - tests/test_webserv_workers.sh
+ *   - tests/test_webserv_incremental_parse.sh
+ *   - tests/test_webserv_pipeline_depth.sh
+ *   - tests/test_webserv_slow_reader.sh
+ *   - tests/test_webserv_static_files.sh
+ *   - tests/test_webserv_metrics.sh
+ *   - tests/test_webserv_timeouts.sh
+ *   - tests/test_webserv_connection_churn.sh
+ *   - tests/test_webserv_alloc_free.sh
+ *   - tests/test_webserv_request_body.sh
+ *   - tests/test_webserv_router.sh
+ *   - tests/test_webserv_compression.sh
+ *   - tests/test_webserv_response_cache.sh
+ *   - tests/test_webserv_proxy.sh
+ *   - tests/test_webserv_offload.sh
+ *   - tests/test_webserv_coroutine.sh
+ *   - tests/test_webserv_io_uring.sh
+ *   - tests/test_webserv_accept.sh
+ *   - tests/test_webserv_access_log.sh
+ *   - tests/test_webserv_tls.sh
+ *   - tests/test_webserv_http2.sh
+ *   - tests/test_webserv_client_limits.sh
+ *   - tests/test_webserv_reload.sh
+ */
+
+namespace {
+
+// 이벤트 대기의 최대 길이. 다른 워커가 올린 종료 플래그와 런타임 제한을 이 주기 안에 확인한다.
+constexpr std::chrono::milliseconds MAX_WAIT(100);
+
+// recv 한 번에 확보하는 최소 쓰기 공간.
+constexpr std::size_t RECV_CHUNK = 4096;
+
+// 한 번의 수신 단계에서 읽는 최대 바이트. 빠르게 밀어 넣는 클라이언트의 요청을 처리하기 전에
+// 전부 입력 버퍼로 끌어오지 않도록 제한한다. 남은 데이터는 read_ready 로 기억한다.
+constexpr std::size_t RECV_BUDGET = 256 * 1024;
+
+// 요청 본문을 읽는 동안의 한 번 수신 예산. 본문 바이트는 처리 단계에서 바로 소비되므로
+// 업로드 중인 연결의 입력 버퍼는 이 크기 근처에 머문다.
+constexpr std::size_t BODY_RECV_BUDGET = 64 * 1024;
+
+// 한 이벤트에서 수신/처리/송신을 반복하는 최대 횟수. 넘으면 다음 루프 회차로 미뤄 다른 연결과 공평하게 돈다.
+constexpr int MAX_SERVICE_PASSES = 8;
+
+// 출력 큐 백프레셔 기준. HIGH 를 넘으면 수신/요청 처리를 멈추고 LOW 이하로 비워지면 재개한다.
+constexpr std::size_t OUTPUT_HIGH_WATER = 256 * 1024;
+constexpr std::size_t OUTPUT_LOW_WATER = 64 * 1024;
+
+const char *const TIMEOUT_PHASE_NAMES[] = {"헤더 수신", "유휴", "송신", "본문 수신", "업스트림"};
+
+/**
+ * createListenSocket
+ * 설명:
+ *   - IPv4 TCP 소켓을 생성하고 지정된 포트로 바인드한 뒤 리슨 상태로 전환한다.
+ *   - reuse_port 가 참이면 SO_REUSEPORT 를 켜서 여러 워커가 같은 포트에 각자 바인드하게 한다.
+ *   - v1.20.0부터 백로그, TCP_DEFER_ACCEPT, TCP_FASTOPEN, TCP_NODELAY 를 설정에서 받는다.
+ *     TCP_NODELAY 는 리슨 소켓에 걸면 수락된 소켓이 물려받으므로 연결마다 setsockopt 를 부르지 않는다.
+ * 입력:
+ *   - config: 수락 경로 옵션
+ *   - port: 바인드할 포트. 평문 포트와 TLS 포트(v1.22.0)가 같은 옵션으로 열린다.
+ *   - reuse_port: SO_REUSEPORT 사용 여부
+ * 출력:
+ *   - 성공 시 수신 소켓 FD, 실패 시 -1
+ * 에러:
+ *   - 소켓 생성/바인드/리슨 과정 실패 시 stderr에 한국어 메시지 출력 후 -1 반환
+ *   - TCP_DEFER_ACCEPT/TCP_FASTOPEN 설정 실패는 경고만 남기고 그 기능 없이 계속한다.
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v0.2.0-multi-connection-loop.md
+ *   - design/webserv-cpp17/v1.2.0-reuseport-workers.md
+ *   - design/webserv-cpp17/v1.20.0-accept-path.md
+ * 관련 테스트:
+ *   - tests/test_webserv_multi.sh
+ *   - tests/test_webserv_workers.sh
+ *   - tests/test_webserv_accept.sh
+ */
+int createListenSocket(const ServerConfig &config, std::uint16_t port, bool reuse_port) {
+    int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        std::cerr << "소켓 생성 실패: " << std::strerror(errno) << std::endl;
+        return -1;
+    }
+
+    int opt = 1;
+    if (setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt)) < 0) {
+        std::cerr << "SO_REUSEADDR 설정 실패: " << std::strerror(errno) << std::endl;
+        ::close(fd);
+        return -1;
+    }
+
+    if (reuse_port && setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &opt, sizeof(opt)) < 0) {
+        std::cerr << "SO_REUSEPORT 설정 실패: " << std::strerror(errno) << std::endl;
+        ::close(fd);
+        return -1;
+    }
+
+    if (config.tcp_nodelay && setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &opt, sizeof(opt)) < 0) {
+        std::cerr << "TCP_NODELAY 설정 실패: " << std::strerror(errno) << std::endl;
+        ::close(fd);
+        return -1;
+    }
+
+    // 첫 데이터가 올 때까지 커널이 수락을 미룬다. 연결만 맺고 보내지 않는 클라이언트는 워커를 깨우지 않는다.
+    int defer = static_cast<int>(config.defer_accept.count());
+    if (defer > 0 && setsockopt(fd, IPPROTO_TCP, TCP_DEFER_ACCEPT, &defer, sizeof(defer)) < 0) {
+        std::cerr << "TCP_DEFER_ACCEPT 설정 실패, 수락을 미루지 않습니다: " << std::strerror(errno) << std::endl;
+    }
+
+    int fastopen = static_cast<int>(config.tcp_fastopen);
+    if (fastopen > 0 && setsockopt(fd, IPPROTO_TCP, TCP_FASTOPEN, &fastopen, sizeof(fastopen)) < 0) {
+        std::cerr << "TCP_FASTOPEN 설정 실패, TFO 없이 계속합니다: " << std::strerror(errno) << std::endl;
+    }
+
+    sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(port);
+
+    if (bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0) {
+        std::cerr << "포트 바인드 실패 (" << port << "): " << std::strerror(errno) << std::endl;
+        ::close(fd);
+        return -1;
+    }
+
+    // 커널은 백로그를 net.core.somaxconn 으로 자른다.
+    if (listen(fd, static_cast<int>(config.listen_backlog)) < 0) {
+        std::cerr << "리슨 실패: " << std::strerror(errno) << std::endl;
+        ::close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+/**
+ * sharesPort (v1.25.0)
+ * 설명:
+ *   - 리슨 소켓에 SO_REUSEPORT 를 켤지 정한다. 워커가 여럿일 때 말고도, 업그레이드로 소켓을 주고받는 설정이면
+ *     켠다. 새 프로세스가 받은 소켓보다 워커가 많아 소켓을 더 열 때 이전 소켓과 같은 포트에 바인드해야 한다.
+ */
+bool sharesPort(const ServerConfig &config) {
+    return config.workers > 1 || !config.control_socket.empty() || !config.takeover.empty();
+}
+
+/**
+ * openListener (v1.25.0)
+ * 설명:
+ *   - 이전 프로세스에서 받은 소켓(adopted >= 0)이면 백로그만 다시 걸어 그대로 쓰고, 아니면 새로 연다.
+ *     받은 소켓은 열린 파일 설명을 공유하므로 논블로킹 상태와 소켓 옵션이 이전 프로세스와 같다.
+ * 출력:
+ *   - 리슨 소켓 FD, 실패 시 -1
+ */
+int openListener(const ServerConfig &config, std::uint16_t port, int adopted) {
+    if (adopted < 0) {
+        return createListenSocket(config, port, sharesPort(config));
+    }
+    if (::listen(adopted, static_cast<int>(config.listen_backlog)) < 0) {
+        std::cerr << "넘겨받은 리슨 소켓 재설정 실패 (" << port << "): " << std::strerror(errno) << std::endl;
+        ::close(adopted);
+        return -1;
+    }
+    return adopted;
+}
+
+/**
+ * ReplyContext
+ * 설명:
+ *   - 응답 생성에 필요한 워커 자원 묶음. 문서 루트가 없으면 files 는 nullptr 이다.
+ *   - 압축을 끄면 compressor 가, 정적 파일 압축을 끄면 compressed 가 nullptr 이다(v1.14.0).
+ *   - 응답 캐시를 끄면 cache 가 nullptr 이다. now 는 캐시 항목의 신선도 판정 시각이다(v1.15.0).
+ *   - closing 은 워커가 drain 중이라는 뜻이다. 요청이 keep-alive 여도 `Connection: close` 로 답한다(v1.25.0).
+ */
+struct ReplyContext {
+    FileCache *files;
+    bool static_copy;
+    const MetricsRegistry &metrics;
+    const ResponseTemplates &responses;
+    CompressedCache *compressed;
+    Compressor *compressor;
+    WorkerMetrics &counters;
+    ResponseCache *cache;
+    std::chrono::steady_clock::time_point now;
+    bool closing;
+};
+
+/**
+ * HandlerId (v1.13.0)
+ * 설명:
+ *   - 워커가 라우터에 등록하는 핸들러 번호. ROUTE_HANDLERS 의 색인이다.
+ */
+enum class HandlerId : RouteId {
+    kHealth,
+    kMetrics,
+    kWorkerMetrics,
+    kUpload,  // 본문 핸들러(UploadDigest). beginRequest 가 본문 끝에서 응답한다.
+    kDelay,   // 블로킹 핸들러. beginRequest 가 작업 스레드 풀에 맡기고, 풀이 없으면 503 이다(v1.17.0).
+    kSleep,   // 코루틴 핸들러. beginRequest 가 연결의 프레임 아레나에 프레임을 만든다(v1.18.0).
+    kEcho,
+    kFetch,
+    kCount,
+};
+
+constexpr RouteId routeId(HandlerId handler) {
+    return static_cast<RouteId>(handler);
+}
+
+// 매개변수 없는 기본 경로. 컴파일 타임에 완전 해시 표로 만들어 조회가 해시 한 번으로 끝난다.
+// 예시 핸들러(`--demo-routes`)는 켤 때만 있어야 하므로 여기 두지 않고 Worker 생성자가 라우터에 등록한다.
+constexpr std::array<FixedRoute, 2> FIXED_ROUTES = {{
+    {HttpMethod::kGet, "/health", routeId(HandlerId::kHealth)},
+    {HttpMethod::kGet, "/metrics", routeId(HandlerId::kMetrics)},
+}};
+constexpr FixedRouteSet<FIXED_ROUTES.size()> FIXED_ROUTE_SET(FIXED_ROUTES);
+static_assert(FIXED_ROUTE_SET.valid(), "기본 경로의 완전 해시 표를 만들 수 없습니다");
+
+/**
+ * RouteMatch
+ * 설명:
+ *   - 요청 하나의 라우팅 결과. params 는 요청 버퍼를 가리키므로 헤더를 소비하기 전에만 쓴다.
+ */
+struct RouteMatch {
+    RouteStatus status = RouteStatus::kNotFound;
+    RouteId id = NO_ROUTE;
+    RouteParams params;
+};
+
+/**
+ * matchRoute
+ * 설명:
+ *   - 쿼리 문자열을 뗀 경로를 고정 경로 표에서 먼저 찾고, 없으면 패턴 라우터에서 찾는다.
+ *   - 둘 중 어디서든 경로는 맞았지만 메서드가 없으면 kMethodNotAllowed 다.
+ */
+void matchRoute(const HttpRequestView &request, const RadixRouter &routes, RouteMatch &match) {
+    std::string_view path = request.path.substr(0, request.path.find('?'));
+    HttpMethod method = parseHttpMethod(request.method);
+    RouteStatus fixed = FIXED_ROUTE_SET.find(method, path, match.id);
+    if (fixed == RouteStatus::kFound) {
+        match.status = fixed;
+        return;
+    }
+    RouteStatus pattern = routes.match(method, path, match.id, match.params);
+    if (pattern == RouteStatus::kFound) {
+        match.status = pattern;
+        return;
+    }
+    bool path_known = fixed == RouteStatus::kMethodNotAllowed || pattern == RouteStatus::kMethodNotAllowed;
+    match.status = path_known ? RouteStatus::kMethodNotAllowed : RouteStatus::kNotFound;
+}
+
+/**
+ * HandlerCall
+ * 설명:
+ *   - 라우트 핸들러 하나에 넘기는 요청, 경로 매개변수, 워커 자원, 응답 출력 위치.
+ *   - capture 가 있으면(응답 캐시 채우기, v1.15.0) 200 본문은 output 대신 capture 에 쓴다. 오류 응답은 그대로 output 이다.
+ */
+struct HandlerCall {
+    const HttpRequestView &request;
+    const RouteParams &params;
+    const ReplyContext &context;
+    bool keep_alive;
+    OutputQueue &output;
+    std::string *capture;
+};
+
+// 응답을 output 에 쓰고 상태 코드를 돌려준다. route 에 계측용 경로 라벨을 남긴다.
+using RouteHandler = int (*)(const HandlerCall &call, RouteLabel &route);
+
+// /health 본문. 캐시하지 않을 때는 같은 본문의 미리 만든 응답(CannedReply::kHealth)을 보낸다.
+constexpr std::string_view HEALTH_BODY = "status: ok\n";
+
+int handleHealth(const HandlerCall &call, RouteLabel &route) {
+    route = RouteLabel::kHealth;
+    if (call.capture != nullptr) {
+        call.capture->assign(HEALTH_BODY.data(), HEALTH_BODY.size());
+        return 200;
+    }
+    call.output.append(call.context.responses.canned(CannedReply::kHealth, call.keep_alive));
+    return 200;
+}
+
+/**
+ * writeEncodedReply
+ * 설명:
+ *   - 200 본문을 이미 고른 코딩으로 쓴다. 요청 헤더가 사라진 뒤에 응답하는 작업 스레드 결과도 이 경로를 쓴다(v1.17.0).
+ *   - 압축을 끄면(compressor 가 nullptr) Vary 없이 그대로 보낸다.
+ */
+void writeEncodedReply(const ReplyContext &context, OutputQueue &output, std::string_view body, bool keep_alive,
+                       ContentCoding coding) {
+    if (context.compressor == nullptr) {
+        writeResponse(output, 200, {body}, keep_alive, context.responses.dateLine());
+        return;
+    }
+    if (coding != ContentCoding::kIdentity && body.size() >= MIN_COMPRESS_BYTES &&
+        context.compressor->compress(coding, {body})) {
+        writeResponse(output, 200, {context.compressor->output()}, keep_alive, context.responses.dateLine(),
+                      codingHeaders(coding));
+        WorkerMetrics::add(context.counters.compressed[static_cast<std::size_t>(CompressionLabel::kDynamic)], 1);
+        return;
+    }
+    writeResponse(output, 200, {body}, keep_alive, context.responses.dateLine(),
+                  codingHeaders(ContentCoding::kIdentity));
+}
+
+/**
+ * writeDynamicReply
+ * 설명:
+ *   - 핸들러가 만든 200 본문을 쓴다. 클라이언트가 gzip/deflate 를 받고 본문이 MIN_COMPRESS_BYTES 이상이면
+ *     워커의 Compressor 로 바로 압축해 보낸다. 압축 결과는 Compressor 버퍼에 있어 추가 할당이 없다.
+ */
+void writeDynamicReply(const HandlerCall &call, std::string_view body) {
+    if (call.capture != nullptr) {
+        call.capture->assign(body.data(), body.size());
+        return;
+    }
+    ContentCoding coding =
+        call.context.compressor != nullptr ? negotiateCoding(call.request) : ContentCoding::kIdentity;
+    writeEncodedReply(call.context, call.output, body, call.keep_alive, coding);
+}
+
+int handleMetrics(const HandlerCall &call, RouteLabel &route) {
+    std::string body = call.context.metrics.render();
+    writeDynamicReply(call, body);
+    route = RouteLabel::kMetrics;
+    return 200;
+}
+
+/**
+ * handleWorkerMetrics
+ * 설명:
+ *   - `/metrics/workers/:id`: 워커 하나의 계측만 돌려준다. 없는 워커 번호는 404 다.
+ */
+int handleWorkerMetrics(const HandlerCall &call, RouteLabel &route) {
+    route = RouteLabel::kMetrics;
+    std::string_view text = call.params.get("id");
+    std::size_t worker = 0;
+    auto parsed = std::from_chars(text.data(), text.data() + text.size(), worker);
+    if (parsed.ec != std::errc() || parsed.ptr != text.data() + text.size() ||
+        worker >= call.context.metrics.workerCount()) {
+        call.output.append(call.context.responses.canned(CannedReply::kNotFound, call.keep_alive));
+        return 404;
+    }
+    std::string body = call.context.metrics.renderWorker(worker);
+    writeDynamicReply(call, body);
+    return 200;
+}
+
+/**
+ * BlockingArgs (v1.17.0)
+ * 설명:
+ *   - 작업 스레드로 넘기는 경로 매개변수 사본. RouteParams 는 요청 버퍼를 가리키는데, 그 버퍼는 핸들러가 도는 동안
+ *     다음 요청으로 덮일 수 있어 값을 복사해 둔다.
+ */
+struct BlockingArgs {
+    std::array<std::pair<std::string, std::string>, RouteParams::MAX_PARAMS> items;
+    std::size_t count = 0;
+
+    explicit BlockingArgs(const RouteParams &params) : count(params.count) {
+        for (std::size_t i = 0; i < count; ++i) {
+            items[i].first.assign(params.items[i].first.data(), params.items[i].first.size());
+            items[i].second.assign(params.items[i].second.data(), params.items[i].second.size());
+        }
+    }
+
+    std::string_view get(std::string_view name) const {
+        for (std::size_t i = 0; i < count; ++i) {
+            if (items[i].first == name) {
+                return items[i].second;
+            }
+        }
+        return std::string_view();
+    }
+};
+
+// 스레드를 붙잡는 핸들러(v1.17.0). 워커 자원을 만지지 않고 상태 코드와 본문만 만든다. 작업 스레드에서 돈다.
+using BlockingHandler = int (*)(const BlockingArgs &args, std::string &body);
+
+// `/delay/:ms` 가 잠들 수 있는 최대 시간.
+constexpr std::size_t MAX_DELAY_MS = 10000;
+
+// `/delay/:ms`, `/sleep/:ms` 의 ms 를 읽는다. 0~MAX_DELAY_MS 의 10진수만 받는다.
+bool parseDelay(std::string_view text, std::size_t &delay) {
+    auto parsed = std::from_chars(text.data(), text.data() + text.size(), delay);
+    return parsed.ec == std::errc() && parsed.ptr == text.data() + text.size() && delay <= MAX_DELAY_MS;
+}
+
+/**
+ * handleDelay (v1.17.0)
+ * 설명:
+ *   - `/delay/:ms`: ms 밀리초 동안 스레드를 재운 뒤 `delayed: N ms` 로 답한다. 디스크 I/O 나 외부 호출처럼
+ *     스레드를 붙잡는 핸들러를 흉내 낸다. 숫자가 아니거나 MAX_DELAY_MS 를 넘으면 404 다.
+ */
+int handleDelay(const BlockingArgs &args, std::string &body) {
+    std::string_view text = args.get("ms");
+    std::size_t delay = 0;
+    if (!parseDelay(text, delay)) {
+        body.assign("Not found\n");
+        return 404;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+    body.append("delayed: ").append(text.data(), text.size()).append(" ms\n");
+    return 200;
+}
+
+// 코루틴 핸들러 프레임을 연결의 아레나에 만든다(v1.18.0). 생성자에서 경로 매개변수를 복사해 둔다.
+using CoroutineFactory = Coroutine *(*)(const RouteParams &params, CoContext &co);
+
+template <typename Handler>
+Coroutine *makeCoroutine(const RouteParams &params, CoContext &co) {
+    return co.arena.create<Handler>(params, co);
+}
+
+void appendNumber(std::string &out, std::uint64_t value) {
+    char digits[20];
+    out.append(digits, static_cast<std::size_t>(std::to_chars(digits, digits + sizeof(digits), value).ptr - digits));
+}
+
+/**
+ * SleepHandler (v1.18.0)
+ * 설명:
+ *   - `/sleep/:ms`: 이벤트 루프 타이머로 ms 밀리초 뒤에 `slept: N ms` 로 답한다. `/delay` 와 같은 일을 하지만
+ *     스레드를 붙잡지 않으므로 잠든 요청 수가 작업 스레드 수에 묶이지 않는다. 잘못된 값은 404 다.
+ */
+class SleepHandler : public Coroutine {
+ public:
+    SleepHandler(const RouteParams &params, CoContext &) : valid_(parseDelay(params.get("ms"), delay_)) {}
+
+    CoStep resume(CoContext &co) override {
+        CO_BEGIN;
+        if (!valid_) {
+            co.body.assign("Not found\n");
+            CO_RETURN(404);
+        }
+        CO_AWAIT(co.sleep(static_cast<std::uint32_t>(delay_)));
+        co.body.assign("slept: ");
+        appendNumber(co.body, delay_);
+        co.body.append(" ms\n");
+        CO_RETURN(200);
+        CO_END;
+    }
+
+ private:
+    std::size_t delay_ = 0;
+    bool valid_;
+};
+
+/**
+ * EchoHandler (v1.18.0)
+ * 설명:
+ *   - `POST /upload/echo`: 요청 본문을 조각이 들어오는 대로 모아 그대로 돌려준다. 본문이 없으면 빈 200 이다.
+ */
+class EchoHandler : public Coroutine {
+ public:
+    EchoHandler(const RouteParams &, CoContext &) {}
+
+    CoStep resume(CoContext &co) override {
+        CO_BEGIN;
+        while (true) {
+            CO_AWAIT(co.readBody());
+            if (co.body_end) {
+                break;
+            }
+            co.body.append(co.slice.data(), co.slice.size());
+        }
+        CO_RETURN(200);
+        CO_END;
+    }
+};
+
+// `/fetch` 가 업스트림 실패(502 이상) 뒤 다시 보내기 전에 쉬는 시간과 최대 시도 횟수.
+constexpr std::uint32_t FETCH_RETRY_MS = 100;
+constexpr std::uint32_t FETCH_ATTEMPTS = 2;
+
+/**
+ * FetchHandler (v1.18.0)
+ * 설명:
+ *   - `/fetch/<경로>`: `/<경로>` 를 `--proxy` 업스트림에서 GET 으로 가져와 상태, 시도 횟수, 본문 길이를 앞에 붙여 답한다.
+ *     업스트림이 502 이상이거나 연결/응답에 실패하면 FETCH_RETRY_MS 쉰 뒤 한 번 더 보낸다.
+ *     콜백이었다면 두 번의 요청과 타이머를 이어 붙여야 했을 흐름이 한 함수의 순서대로 적힌다.
+ *   - 맞는 `--proxy` 접두사가 없으면 404, 두 번 모두 실패하면 502(응답 타임아웃이면 504)다.
+ */
+class FetchHandler : public Coroutine {
+ public:
+    FetchHandler(const RouteParams &params, CoContext &co) {
+        std::string_view path = params.get("path");
+        co.target.assign("/").append(path.data(), path.size());
+    }
+
+    CoStep resume(CoContext &co) override {
+        CO_BEGIN;
+        for (attempts_ = 1;; ++attempts_) {
+            CO_AWAIT(co.fetch());
+            if (co.upstream_status < 502 || attempts_ == FETCH_ATTEMPTS) {
+                break;
+            }
+            CO_AWAIT(co.sleep(FETCH_RETRY_MS));
+        }
+        if (co.upstream_status == 0) {
+            co.body.assign("Not found\n");
+            CO_RETURN(404);
+        }
+        if (co.upstream_status >= 502) {
+            bool timeout = co.upstream_status == 504;
+            co.body.assign(timeout ? "Gateway timeout\n" : "Bad gateway\n");
+            CO_RETURN(timeout ? 504 : 502);
+        }
+        co.body.assign("status: ");
+        appendNumber(co.body, static_cast<std::uint64_t>(co.upstream_status));
+        co.body.append("\nattempts: ");
+        appendNumber(co.body, attempts_);
+        co.body.append("\nbytes: ");
+        appendNumber(co.body, co.upstream_body.size());
+        co.body.append("\n\n").append(co.upstream_body);
+        CO_RETURN(200);
+        CO_END;
+    }
+
+ private:
+    std::uint32_t attempts_ = 0;
+};
+
+/**
+ * RouteSpec (v1.15.0)
+ * 설명:
+ *   - 핸들러와 응답 캐시 대상 여부. 캐시 대상 핸들러는 요청 본문이나 부수 효과 없이 200 본문만 만든다.
+ *   - blocking 이 있으면 handler 대신 그 함수를 작업 스레드에서 부르고, label 로 계측한다(v1.17.0).
+ *   - coroutine 이 있으면 그 프레임을 만들어 워커 스레드에서 멈췄다 재개하며 돌린다(v1.18.0).
+ */
+struct RouteSpec {
+    RouteHandler handler;
+    bool cacheable;
+    BlockingHandler blocking;
+    CoroutineFactory coroutine;
+    RouteLabel label;
+};
+
+// HandlerId 순서. 업로드는 본문을 받는 핸들러라 beginRequest 가 따로 처리하므로 여기로 오지 않는다.
+constexpr RouteSpec ROUTE_HANDLERS[] = {
+    {handleHealth, true, nullptr, nullptr, RouteLabel::kHealth},
+    {handleMetrics, true, nullptr, nullptr, RouteLabel::kMetrics},
+    {handleWorkerMetrics, true, nullptr, nullptr, RouteLabel::kMetrics},
+    {nullptr, false, nullptr, nullptr, RouteLabel::kUpload},
+    {nullptr, false, handleDelay, nullptr, RouteLabel::kDelay},
+    {nullptr, false, nullptr, makeCoroutine<SleepHandler>, RouteLabel::kSleep},
+    {nullptr, false, nullptr, makeCoroutine<EchoHandler>, RouteLabel::kEcho},
+    {nullptr, false, nullptr, makeCoroutine<FetchHandler>, RouteLabel::kFetch},
+};
+static_assert(sizeof(ROUTE_HANDLERS) / sizeof(ROUTE_HANDLERS[0]) == static_cast<std::size_t>(HandlerId::kCount),
+              "핸들러 표와 HandlerId 가 맞지 않습니다");
+
+/**
+ * queueFile
+ * 설명:
+ *   - 정적 파일 응답을 출력 큐에 넣는다. 헤더는 버퍼 바이트, 본문은 sendfile 로 보낼 파일 구간이다.
+ *   - copy 가 참이면 비교 측정용으로 pread 로 본문을 헤더 뒤 버퍼에 바로 읽어 붙인다(read()+send() 경로).
+ */
+void queueFile(const FileInfo &file, bool keep_alive, bool copy, std::string_view date_line, OutputQueue &output,
+               std::string_view extra_headers = std::string_view()) {
+    writeFileResponseHeader(output, file.size, file.content_type, file.etag, keep_alive, date_line, extra_headers);
+    if (!copy) {
+        output.pushFile(file.file, 0, file.size);
+        return;
+    }
+
+    char *body = output.prepare(file.size);
+    std::size_t done = 0;
+    while (done < file.size) {
+        ssize_t n = ::pread(file.file->fd(), body + done, file.size - done, static_cast<off_t>(done));
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;
+        }
+        done += static_cast<std::size_t>(n);
+    }
+    if (done < file.size) {
+        // 파일이 잘렸다면 Content-Length 를 지킬 수 없으므로 남은 자리를 0 으로 채운다.
+        std::fill(body + done, body + file.size, '\0');
+    }
+    output.commit(file.size);
+}
+
+/**
+ * wantsKeepAlive
+ * 설명:
+ *   - HTTP/1.1 은 `Connection: close` 가 없으면, HTTP/1.0 은 `Connection: keep-alive` 가 있으면 연결을 유지한다.
+ */
+bool wantsKeepAlive(const HttpRequestView &request) {
+    const HeaderField *connection = request.findHeader("connection");
+    if (request.version == "HTTP/1.1") {
+        return connection == nullptr || !equalsIgnoreCase(connection->value, "close");
+    }
+    if (request.version == "HTTP/1.0") {
+        return connection != nullptr && equalsIgnoreCase(connection->value, "keep-alive");
+    }
+    return false;
+}
+
+/**
+ * isUploadRequest
+ * 설명:
+ *   - 본문을 UploadDigest 핸들러로 스트리밍하는 `POST /upload` 요청인지 확인한다.
+ *     HTTP/1.1 인데 Host 가 없으면 buildReply 가 400 으로 응답하도록 여기서는 거짓이다.
+ */
+bool isUploadRequest(const HttpRequestView &request, const RouteMatch &match) {
+    if (match.status != RouteStatus::kFound || match.id != routeId(HandlerId::kUpload)) {
+        return false;
+    }
+    return request.version != "HTTP/1.1" || request.findHeader("host") != nullptr;
+}
+
+/**
+ * isBlockingRequest (v1.17.0)
+ * 설명:
+ *   - 작업 스레드에 맡길 블로킹 핸들러 요청인지 확인한다. Host 가 없는 HTTP/1.1 요청은 buildReply 의 400 으로 보낸다.
+ */
+bool isBlockingRequest(const HttpRequestView &request, const RouteMatch &match) {
+    if (match.status != RouteStatus::kFound || ROUTE_HANDLERS[match.id].blocking == nullptr) {
+        return false;
+    }
+    return request.version != "HTTP/1.1" || request.findHeader("host") != nullptr;
+}
+
+/**
+ * isCoroutineRequest (v1.18.0)
+ * 설명:
+ *   - 코루틴 핸들러 요청인지 확인한다. Host 가 없는 HTTP/1.1 요청은 buildReply 의 400 으로 보낸다.
+ */
+bool isCoroutineRequest(const HttpRequestView &request, const RouteMatch &match) {
+    if (match.status != RouteStatus::kFound || ROUTE_HANDLERS[match.id].coroutine == nullptr) {
+        return false;
+    }
+    return request.version != "HTTP/1.1" || request.findHeader("host") != nullptr;
+}
+
+/**
+ * writeBlockingReply (v1.17.0)
+ * 설명:
+ *   - 블로킹 핸들러가 돌려준 상태와 본문을 쓴다. 200 은 고른 코딩으로 압축할 수 있고, 오류는 본문 그대로다.
+ */
+void writeBlockingReply(const ReplyContext &context, OutputQueue &output, int status, std::string_view body,
+                        bool keep_alive, ContentCoding coding) {
+    keep_alive = keep_alive && !context.closing;
+    if (status == 200) {
+        writeEncodedReply(context, output, body, keep_alive, coding);
+        return;
+    }
+    writeResponse(output, status, {body}, keep_alive, context.responses.dateLine());
+}
+
+/**
+ * expectsContinue
+ * 설명:
+ *   - 클라이언트가 본문을 보내기 전에 `100 Continue` 를 기다리는지 확인한다(HTTP/1.1 `Expect: 100-continue`).
+ */
+bool expectsContinue(const HttpRequestView &request) {
+    const HeaderField *expect = request.findHeader("expect");
+    return request.version == "HTTP/1.1" && expect != nullptr && equalsIgnoreCase(expect->value, "100-continue");
+}
+
+/**
+ * writeUploadReply
+ * 설명:
+ *   - 업로드 본문의 바이트 수와 CRC-32 를 `received: N\ncrc32: xxxxxxxx\n` 본문으로 응답한다.
+ */
+void writeUploadReply(const UploadDigest &upload, bool keep_alive, std::string_view date_line, OutputQueue &output) {
+    char digits[20];
+    auto length = static_cast<std::size_t>(std::to_chars(digits, digits + sizeof(digits), upload.bytes).ptr - digits);
+    char crc[8];
+    for (int i = 7; i >= 0; --i) {
+        crc[7 - i] = "0123456789abcdef"[(upload.crc >> (i * 4)) & 0xfu];
+    }
+    writeResponse(output, 200,
+                  {"received: ", std::string_view(digits, length), "\ncrc32: ", std::string_view(crc, sizeof(crc)),
+                   "\n"},
+                  keep_alive, date_line);
+}
+
+/**
+ * validatorHeaders
+ * 설명:
+ *   - 정적 파일 304 에 붙일 `ETag` 줄과 extra(Vary) 줄을 buffer 에 이어 쓴다. 힙 할당이 없다.
+ */
+std::string_view validatorHeaders(std::string_view etag, std::string_view extra, char (&buffer)[256]) {
+    constexpr std::string_view PREFIX = "ETag: ";
+    if (PREFIX.size() + etag.size() + 2 + extra.size() > sizeof(buffer)) {
+        extra = std::string_view();
+    }
+    char *cursor = buffer;
+    for (std::string_view part : {PREFIX, etag, std::string_view("\r\n"), extra}) {
+        std::memcpy(cursor, part.data(), part.size());
+        cursor += part.size();
+    }
+    return std::string_view(buffer, static_cast<std::size_t>(cursor - buffer));
+}
+
+/**
+ * replyFromCache (v1.15.0)
+ * 설명:
+ *   - 캐시 대상 라우트의 응답. 신선한 항목이 있으면 핸들러를 부르지 않는다.
+ *   - 없으면 핸들러를 capture 로 불러 200 본문을 캐시에 넣는다. 핸들러가 오류(404 등)로 답하면 그 응답을 두고 캐시하지 않는다.
+ *   - 조건부 요청이 고른 코딩 변형의 검증자와 맞으면 본문 없이 304 로 답한다. 압축본도 항목에 한 번만 만든다.
+ */
+int replyFromCache(const HandlerCall &call, const RouteSpec &spec, std::string_view host, RouteLabel &route) {
+    const ReplyContext &context = call.context;
+    ResponseCache &cache = *context.cache;
+    CachedResponse *entry = cache.find(call.request.method, host, call.request.path, context.now);
+    if (entry != nullptr) {
+        route = entry->route;
+        WorkerMetrics::add(context.counters.cache[static_cast<std::size_t>(CacheLabel::kHit)], 1);
+    } else {
+        std::string &body = cache.scratch();
+        body.clear();
+        HandlerCall fill{call.request, call.params, context, call.keep_alive, call.output, &body};
+        int status = spec.handler(fill, route);
+        if (status != 200) {
+            return status;
+        }
+        WorkerMetrics::add(context.counters.cache[static_cast<std::size_t>(CacheLabel::kMiss)], 1);
+        entry = cache.store(body, route, context.responses.second(), context.now);
+        if (entry == nullptr) {
+            writeDynamicReply(call, body);
+            return 200;
+        }
+    }
+
+    ContentCoding coding = context.compressor != nullptr ? negotiateCoding(call.request) : ContentCoding::kIdentity;
+    if (entry->bodies[0].size() < MIN_COMPRESS_BYTES) {
+        coding = ContentCoding::kIdentity;
+    }
+    auto variant = static_cast<std::size_t>(coding);
+    if (isNotModified(call.request, entry->etags[variant], entry->last_modified)) {
+        writeNotModified(call.output, call.keep_alive, context.responses.dateLine(), entry->headers[variant]);
+        return 304;
+    }
+    std::string_view body = cache.encode(*entry, coding, context.compressor);
+    variant = static_cast<std::size_t>(coding);
+    writeResponse(call.output, 200, {body}, call.keep_alive, context.responses.dateLine(), entry->headers[variant]);
+    if (coding != ContentCoding::kIdentity) {
+        WorkerMetrics::add(context.counters.compressed[static_cast<std::size_t>(CompressionLabel::kDynamic)], 1);
+    }
+    return 200;
+}
+
+/**
+ * buildReply
+ * 설명:
+ *   - 파싱된 요청에서 keep-alive 여부를 결정하고 라우팅 결과로 만든 응답을 출력 큐에 넣는다.
+ *   - 라우트가 맞으면 등록된 핸들러가 응답한다. 경로는 있지만 메서드가 없거나, 라우트가 없는 GET 외 요청은 405 다.
+ *   - 라우트가 없는 GET 은 문서 루트가 설정되어 있으면 정적 파일로 응답하고, 없으면 404 를 돌려준다.
+ *   - 응답 캐시를 켜면 캐시 대상 라우트는 replyFromCache 를 거친다. 정적 파일은 `If-None-Match` 가 ETag 와 맞으면 304 다.
+ *   - 고정 응답은 미리 만든 바이트열을 복사하고, 나머지는 출력 큐 버퍼에 바로 직렬화한다(/metrics 제외 할당 없음).
+ * 입력:
+ *   - request: 파싱된 요청
+ *   - match: matchRoute 결과
+ *   - context: 정적 파일 캐시, 복사 모드, 계측 레지스트리, 응답 템플릿, 압축기, 응답 캐시
+ * 출력:
+ *   - output 에 추가된 응답, keep_alive (연결 유지 여부), route (계측용 경로 라벨)
+ *   - 반환값: 응답 상태 코드
+ */
+int buildReply(const HttpRequestView &request, const RouteMatch &match, const ReplyContext &context,
+               OutputQueue &output, bool &keep_alive, RouteLabel &route) {
+    bool is_http11 = (request.version == "HTTP/1.1");
+    const HeaderField *host = request.findHeader("host");
+    bool has_host = host != nullptr;
+
+    keep_alive = wantsKeepAlive(request) && !context.closing;
+    int status = 200;
+    route = RouteLabel::kDefault;
+    if (is_http11 && !has_host) {
+        keep_alive = false;
+        route = RouteLabel::kError;
+        output.append(context.responses.canned(CannedReply::kMissingHost, keep_alive));
+        return 400;
+    }
+    if (match.status == RouteStatus::kFound) {
+        HandlerCall call{request, match.params, context, keep_alive, output, nullptr};
+        const RouteSpec &spec = ROUTE_HANDLERS[match.id];
+        if (spec.blocking != nullptr) {
+            // 여기까지 왔으면 작업 스레드 풀이 없다(`--handler-threads 0`). 워커 스레드에서 부르면
+            // 이 워커의 다른 연결이 모두 멈추므로 부르지 않고 거절한다.
+            route = spec.label;
+            output.append(context.responses.canned(CannedReply::kServiceUnavailable, keep_alive));
+            return 503;
+        }
+        if (spec.cacheable && context.cache != nullptr && request.method == "GET") {
+            return replyFromCache(call, spec, has_host ? host->value : std::string_view(), route);
+        }
+        return spec.handler(call, route);
+    }
+    if (match.status == RouteStatus::kMethodNotAllowed || request.method != "GET") {
+        route = RouteLabel::kError;
+        output.append(context.responses.canned(CannedReply::kMethodNotAllowed, keep_alive));
+        return 405;
+    }
+    if (context.files != nullptr) {
+        route = RouteLabel::kStatic;
+        const FileInfo *file = context.files->lookup(request.path);
+        if (file == nullptr) {
+            output.append(context.responses.canned(CannedReply::kNotFound, keep_alive));
+            return 404;
+        }
+        // 압축본이 준비되어 있으면 버퍼로 복사해 보내고, 아직이면(압축 중) 이번에는 원본을 보낸다.
+        bool compressible = context.compressed != nullptr && isCompressibleType(file->content_type);
+        ContentCoding coding = ContentCoding::kIdentity;
+        const CompressedVariant *variant = nullptr;
+        if (compressible) {
+            coding = negotiateCoding(request);
+            std::string_view path = request.path.substr(0, request.path.find('?'));
+            variant = context.compressed->find(path, coding, *file);
+            if (variant != nullptr && !variant->compressed) {
+                variant = nullptr;
+            }
+        }
+        std::string_view extra =
+            compressible ? codingHeaders(variant != nullptr ? coding : ContentCoding::kIdentity) : std::string_view();
+        std::string_view etag = variant != nullptr ? std::string_view(variant->etag) : std::string_view(file->etag);
+        if (isNotModified(request, etag, -1)) {
+            char headers[256];
+            writeNotModified(output, keep_alive, context.responses.dateLine(), validatorHeaders(etag, extra, headers));
+            return 304;
+        }
+        if (variant != nullptr) {
+            writeFileResponseHeader(output, variant->body->size(), file->content_type, variant->etag, keep_alive,
+                                    context.responses.dateLine(), extra);
+            output.append(*variant->body);
+            WorkerMetrics::add(context.counters.compressed[static_cast<std::size_t>(CompressionLabel::kCache)], 1);
+            return status;
+        }
+        queueFile(*file, keep_alive, context.static_copy, context.responses.dateLine(), output, extra);
+        return status;
+    }
+
+    std::string_view host_value = has_host ? host->value : std::string_view("host-not-set");
+    writeResponse(output, status,
+                  {"Hello from webserv v0.4.0\nHost: ", host_value, "\n",
+                   keep_alive ? "Connection: keep-alive\n" : "Connection: close\n"},
+                  keep_alive, context.responses.dateLine());
+    return status;
+}
+
+/**
+ * peerAddress
+ * 설명:
+ *   - 클라이언트 소켓의 원격 주소를 문자열로 buffer 에 쓴다. 프록시 요청의 X-Real-IP 값이다.
+ */
+std::string_view peerAddress(int fd, char (&buffer)[INET6_ADDRSTRLEN]) {
+    sockaddr_storage address{};
+    socklen_t length = sizeof(address);
+    if (::getpeername(fd, reinterpret_cast<sockaddr *>(&address), &length) != 0) {
+        return "unknown";
+    }
+    const void *host = address.ss_family == AF_INET6
+                           ? static_cast<const void *>(&reinterpret_cast<sockaddr_in6 *>(&address)->sin6_addr)
+                           : static_cast<const void *>(&reinterpret_cast<sockaddr_in *>(&address)->sin_addr);
+    if (::inet_ntop(address.ss_family, host, buffer, sizeof(buffer)) == nullptr) {
+        return "unknown";
+    }
+    return std::string_view(buffer);
+}
+
+/**
+ * awaitingUpstream
+ * 설명:
+ *   - 요청(본문까지)을 업스트림에 넘기고 응답을 기다리는 클라이언트 연결인지 본다.
+ *     이 동안은 다음 요청을 읽지 않는다. 응답은 업스트림 연결이 이 연결의 출력 큐에 넣는다.
+ */
+bool awaitingUpstream(const Connection &conn) {
+    return conn.proxy.role == ProxyRole::kClient && conn.proxy.peer != 0 && !conn.body.decoder.active();
+}
+
+/**
+ * coroutineWaiting (v1.18.0)
+ * 설명:
+ *   - 코루틴 핸들러가 타이머 만료나 업스트림 응답을 기다리며 멈춘 연결인지 본다. 본문을 읽는 중이어도 참이다.
+ *     코루틴이 본문 조각을 기다리지 않는 동안에는 본문도 읽지 않는다.
+ */
+bool coroutineWaiting(const Connection &conn) {
+    const CoContext &co = conn.co;
+    return (co.wait == CoWait::kTimer && !co.ready) ||
+           (co.wait == CoWait::kUpstream && conn.proxy.role == ProxyRole::kClient && conn.proxy.error == 0);
+}
+
+/**
+ * awaitingReply (v1.17.0)
+ * 설명:
+ *   - 응답을 다른 곳(업스트림 연결, 작업 스레드)에서 기다리는 연결인지 본다. 본문을 다 읽은 뒤에만 참이다.
+ *   - 멈춘 코루틴 핸들러도 포함한다(v1.18.0).
+ */
+bool awaitingReply(const Connection &conn) {
+    return awaitingUpstream(conn) || (conn.offload.state == OffloadState::kRunning && !conn.body.decoder.active()) ||
+           coroutineWaiting(conn);
+}
+
+// 상대 연결이나 작업 스레드 때문에 수신과 처리를 멈춘 연결인지 본다. 풀어 줄 때까지 읽지 않는다.
+bool inputBlocked(const Connection &conn) {
+    return conn.proxy.stalled || awaitingReply(conn);
+}
+
+// HTTP/2 로 바뀐 연결인지 본다(v1.23.0). 세션 객체는 슬롯을 돌려써도 남아 있으므로 active 로 가린다.
+bool http2Active(const Connection &conn) {
+    return conn.http2 != nullptr && conn.http2->active();
+}
+
+/**
+ * http2Waiting (v1.23.0)
+ * 설명:
+ *   - 작업 스레드 결과를 기다리는 스트림이 있는 HTTP/2 연결인지 본다. awaitingReply 와 달리 입력은 계속 읽는다.
+ *     다른 스트림의 요청과 흐름 제어 프레임이 같은 연결로 오기 때문이다.
+ */
+bool http2Waiting(const Connection &conn) {
+    return http2Active(conn) && conn.http2->waiting() > 0;
+}
+
+// 쉼표로 나눈 헤더 값 목록(Connection, Upgrade)에 token 이 있는지 대소문자 구분 없이 본다.
+bool hasToken(std::string_view list, std::string_view token) {
+    while (!list.empty()) {
+        std::size_t comma = list.find(',');
+        std::string_view item = list.substr(0, comma);
+        list.remove_prefix(comma == std::string_view::npos ? list.size() : comma + 1);
+        while (!item.empty() && (item.front() == ' ' || item.front() == '\t')) {
+            item.remove_prefix(1);
+        }
+        while (!item.empty() && (item.back() == ' ' || item.back() == '\t')) {
+            item.remove_suffix(1);
+        }
+        if (equalsIgnoreCase(item, token)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * http2Upgrade (v1.23.0)
+ * 설명:
+ *   - HTTP/1.1 요청이 `Upgrade: h2c` 로 HTTP/2 전환을 청하는지 본다(RFC 7540 3.2). Connection 에 Upgrade 와
+ *     HTTP2-Settings 가 있고 HTTP2-Settings 헤더가 정확히 하나여야 한다.
+ * 출력:
+ *   - HTTP2-Settings 헤더. 전환 요청이 아니면 nullptr
+ */
+const HeaderField *http2Upgrade(const HttpRequestView &request) {
+    const HeaderField *upgrade = request.findHeader("upgrade");
+    const HeaderField *connection = request.findHeader("connection");
+    if (request.version != "HTTP/1.1" || upgrade == nullptr || connection == nullptr ||
+        !hasToken(upgrade->value, "h2c") || !hasToken(connection->value, "upgrade") ||
+        !hasToken(connection->value, "http2-settings")) {
+        return nullptr;
+    }
+    const HeaderField *settings = nullptr;
+    for (std::size_t i = 0; i < request.header_count; ++i) {
+        if (equalsIgnoreCase(request.headers[i].name, "http2-settings")) {
+            if (settings != nullptr) {
+                return nullptr;
+            }
+            settings = &request.headers[i];
+        }
+    }
+    return settings;
+}
+
+CannedReply proxyErrorReply(int status) {
+    switch (status) {
+        case 504: return CannedReply::kGatewayTimeout;
+        case 413: return CannedReply::kBodyTooLarge;
+        case 400: return CannedReply::kBadFraming;
+        default: return CannedReply::kBadGateway;
+    }
+}
+
+}  // namespace
+
+Worker::Worker(const ServerConfig &config, std::size_t id, RunControl &control, MetricsRegistry &metrics,
+               ThreadPool *pool, HandlerPool *handlers, AccessRing *access_log, TlsContext *tls,
+               ClientLimiter *limiter)
+    : config_(config),
+      id_(id),
+      control_(control),
+      registry_(metrics),
+      metrics_(metrics.worker(id)),
+      listen_fd_(-1),
+      accept_pending_(false),
+      tls_(tls),
+      tls_listen_fd_(-1),
+      tls_accept_pending_(false),
+      pool_(pool),
+      handlers_(handlers),
+      access_log_(access_log),
+      access_countdown_(1),
+      limiter_(limiter),
+      overloaded_(false),
+      generation_(0),
+      draining_(false) {
+    // 단계별 타임아웃을 따로 주지 않으면 기존처럼 idle_timeout 하나로 모든 단계를 제한한다.
+    if (config_.header_timeout.count() == 0) {
+        config_.header_timeout = config_.idle_timeout;
+    }
+    if (config_.write_timeout.count() == 0) {
+        config_.write_timeout = config_.idle_timeout;
+    }
+    // 매개변수가 있는 경로는 기수 트리 라우터에 등록한다. 고정 경로는 FIXED_ROUTE_SET 에 있다.
+    routes_.add(HttpMethod::kGet, "/metrics/workers/:id", routeId(HandlerId::kWorkerMetrics));
+    // 예시 핸들러는 운영 바이너리에서 누구나 부를 수 있는 경로가 되지 않도록 켤 때만 등록한다.
+    // `/fetch` 는 클라이언트가 업스트림에 GET 을 보내게 하므로 특히 기본으로 열어 두면 안 된다.
+    if (config_.demo_routes) {
+        routes_.add(HttpMethod::kGet, "/delay/:ms", routeId(HandlerId::kDelay));
+        routes_.add(HttpMethod::kPost, "/upload", routeId(HandlerId::kUpload));
+        routes_.add(HttpMethod::kGet, "/sleep/:ms", routeId(HandlerId::kSleep));
+        routes_.add(HttpMethod::kPost, "/upload/echo", routeId(HandlerId::kEcho));
+        routes_.add(HttpMethod::kGet, "/fetch/*path", routeId(HandlerId::kFetch));
+    }
+}
+
+Worker::~Worker() {
+    connections_.forEach([](Connection &conn) { ::close(conn.fd); });
+    if (listen_fd_ >= 0 && !draining_) {
+        ::close(listen_fd_);
+    }
+    if (tls_listen_fd_ >= 0 && !draining_) {
+        ::close(tls_listen_fd_);
+    }
+}
+
+void Worker::adoptListeners(int plain, int tls) {
+    listen_fd_ = plain;
+    tls_listen_fd_ = tls;
+}
+
+bool Worker::start() {
+    io_ = makeIoBackend(config_.io_backend, connections_);
+    if (!io_) {
+        std::cerr << "epoll 생성 실패: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    listen_fd_ = openListener(config_, config_.port, listen_fd_);
+    if (listen_fd_ < 0) {
+        return false;
+    }
+
+    if (!io_->watchListener(listen_fd_)) {
+        std::cerr << "리슨 소켓 등록 실패: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    if (tls_ != nullptr) {
+        tls_listen_fd_ = openListener(config_, config_.tls_port, tls_listen_fd_);
+        if (tls_listen_fd_ < 0) {
+            return false;
+        }
+        if (!io_->watchListener(tls_listen_fd_)) {
+            std::cerr << "TLS 리슨 소켓 등록 실패: " << std::strerror(errno) << std::endl;
+            return false;
+        }
+    }
+
+    if (!config_.root.empty()) {
+        files_ = std::make_unique<FileCache>(config_.root, config_.file_cache_entries);
+        if (!files_->start() || !io_->watchReadable(files_->notifyFd())) {
+            std::cerr << "inotify 준비 실패: " << std::strerror(errno) << std::endl;
+            return false;
+        }
+    }
+
+    // 미리 압축 결과와 블로킹 핸들러 결과는 같은 완료 큐로 돌아온다.
+    bool precompress = config_.compression_level > 0 && files_ && config_.compression_cache_bytes > 0;
+    if (precompress || handlers_ != nullptr) {
+        if (!completions_.start() || !io_->watchReadable(completions_.fd())) {
+            std::cerr << "완료 큐 준비 실패: " << std::strerror(errno) << std::endl;
+            return false;
+        }
+    }
+
+    if (config_.compression_level > 0) {
+        compressor_ = std::make_unique<Compressor>(config_.compression_level);
+        if (precompress) {
+            compressed_ = std::make_unique<CompressedCache>(config_.compression_cache_bytes,
+                                                            config_.compression_level, pool_, completions_, metrics_);
+        }
+    }
+
+    if (config_.response_cache_bytes > 0) {
+        response_cache_ = std::make_unique<ResponseCache>(config_.response_cache_bytes, config_.response_cache_ttl,
+                                                          compressor_ != nullptr);
+    }
+
+    if (!config_.proxies.empty()) {
+        upstreams_ = std::make_unique<UpstreamPool>(config_.proxies, config_.proxy_balance,
+                                                    config_.upstream_keepalive);
+        std::string error;
+        if (!upstreams_->resolve(error)) {
+            std::cerr << error << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Worker::run() {
+    const auto start_time = std::chrono::steady_clock::now();
+
+    bool ok = true;
+    while (!stopping()) {
+        std::uint64_t generation = control_.generation.load(std::memory_order_acquire);
+        if (generation != generation_) {
+            applyConfig(generation);
+        }
+        if (!draining_ && control_.draining.load(std::memory_order_relaxed)) {
+            beginDrain(std::chrono::steady_clock::now());
+        }
+
+        ok = handleConnections();
+        if (!ok) {
+            // 한 워커의 치명적 오류는 전체 서버 종료로 이어지게 한다.
+            control_.stop.store(true, std::memory_order_relaxed);
+            break;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (config_.max_runtime.count() > 0 && now - start_time > config_.max_runtime) {
+            if (!control_.stop.exchange(true, std::memory_order_relaxed)) {
+                std::cerr << "최대 런타임을 초과하여 루프를 종료합니다." << std::endl;
+            }
+            break;
+        }
+        if (draining_) {
+            if (connections_.size() == 0) {
+                break;
+            }
+            if (now >= drain_deadline_) {
+                std::cerr << "[워커 " << id_ << "] drain 마감이 지나 남은 연결 " << connections_.size()
+                          << "개를 닫습니다." << std::endl;
+                break;
+            }
+        }
+        if (!retired_upstreams_.empty()) {
+            retired_upstreams_.erase(std::remove_if(retired_upstreams_.begin(), retired_upstreams_.end(),
+                                                    [](const std::unique_ptr<UpstreamPool> &pool) {
+                                                        return !pool->busy();
+                                                    }),
+                                     retired_upstreams_.end());
+        }
+    }
+
+    drainOutputs();
+    return ok;
+}
+
+/**
+ * Worker::applyConfig (v1.25.0)
+ * 설명:
+ *   - 제어 스레드가 다시 읽은 설정에서 다시 읽을 수 있는 값(copyReloadable)만 워커 사본에 옮긴다.
+ *     바로 다음 요청, 다음 마감 계산부터 새 값을 쓴다. 이미 건 마감은 그대로 둔다.
+ *   - 업스트림 설정이 바뀌었으면 새 풀을 만들어 주소를 해석한다. 이전 풀의 유휴 연결은 닫고, 진행 중 요청이 있으면
+ *     그 요청이 끝날 때까지 retired_upstreams_ 에 둔다. 해석에 실패하면 업스트림 설정만 이전 값으로 되돌린다.
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.25.0-config-reload.md
+ */
+void Worker::applyConfig(std::uint64_t generation) {
+    generation_ = generation;
+    std::shared_ptr<const ServerConfig> next = std::atomic_load(&control_.config);
+    if (next) {
+        std::vector<ProxyTarget> proxies = config_.proxies;
+        ProxyBalance balance = config_.proxy_balance;
+        std::size_t keepalive = config_.upstream_keepalive;
+        copyReloadable(*next, config_);
+        if (config_.header_timeout.count() == 0) {
+            config_.header_timeout = config_.idle_timeout;
+        }
+        if (config_.write_timeout.count() == 0) {
+            config_.write_timeout = config_.idle_timeout;
+        }
+
+        if (config_.proxies != proxies || config_.proxy_balance != balance || config_.upstream_keepalive != keepalive) {
+            std::unique_ptr<UpstreamPool> fresh;
+            std::string error;
+            if (!config_.proxies.empty()) {
+                fresh = std::make_unique<UpstreamPool>(config_.proxies, config_.proxy_balance,
+                                                       config_.upstream_keepalive);
+            }
+            if (fresh && !fresh->resolve(error)) {
+                std::cerr << "[워커 " << id_ << "] 새 업스트림 설정을 쓰지 못해 이전 설정을 유지합니다: " << error
+                          << std::endl;
+                config_.proxies = std::move(proxies);
+                config_.proxy_balance = balance;
+                config_.upstream_keepalive = keepalive;
+            } else {
+                closeIdleUpstreams();
+                if (upstreams_ && upstreams_->busy()) {
+                    retired_upstreams_.push_back(std::move(upstreams_));
+                }
+                upstreams_ = std::move(fresh);
+            }
+        }
+    }
+    metrics_.config_generation.store(generation, std::memory_order_relaxed);
+}
+
+/**
+ * Worker::beginDrain (v1.25.0)
+ * 설명:
+ *   - 리슨 소켓을 백엔드에서 빼고 닫는다. 업그레이드라면 새 프로세스가 같은 소켓을 쥐고 있어 대기열의 연결을 받는다.
+ *     io_uring 이 이미 수락해 둔 연결은 리슨 이벤트로 계속 꺼내 처리한다.
+ *   - 유휴 업스트림 연결을 닫고, HTTP/2 연결은 GOAWAY 를 보내도록 지연 목록에 넣는다.
+ *   - 유휴 HTTP/1 연결은 건드리지 않는다. 다음 응답을 `Connection: close` 로 보내고 닫거나 유휴 타임아웃으로 닫는다.
+ *     요청이 막 도착한 연결을 끊는 경쟁을 피하기 위해서다.
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.25.0-config-reload.md
+ */
+void Worker::beginDrain(std::chrono::steady_clock::time_point now) {
+    draining_ = true;
+    drain_deadline_ = now + config_.drain_timeout;
+    metrics_.draining.store(1, std::memory_order_relaxed);
+    io_->unwatchListener(listen_fd_);
+    ::close(listen_fd_);
+    if (tls_listen_fd_ >= 0) {
+        io_->unwatchListener(tls_listen_fd_);
+        ::close(tls_listen_fd_);
+    }
+    accept_pending_ = false;
+    tls_accept_pending_ = false;
+    closeIdleUpstreams();
+    connections_.forEach([this](Connection &conn) {
+        if (http2Active(conn)) {
+            deferred_.push_back(conn.handle);
+        }
+    });
+}
+
+// 업스트림 풀에서 쉬는 연결을 모두 꺼내 닫는다.
+void Worker::closeIdleUpstreams() {
+    if (!upstreams_) {
+        return;
+    }
+    for (std::size_t server = 0; server < upstreams_->serverCount(); ++server) {
+        while (std::uint64_t handle = upstreams_->takeIdle(server)) {
+            if (Connection *conn = connections_.find(handle)) {
+                closeConnection(*conn);
+            }
+        }
+    }
+}
+
+// 요청이 연결 유지를 원하고 워커가 drain 중이 아니면 참(v1.25.0).
+bool Worker::keepAlive(const HttpRequestView &request) const {
+    return !draining_ && wantsKeepAlive(request);
+}
+
+/**
+ * Worker::countHandled
+ * 설명:
+ *   - 처리 건수를 전역 카운터에 더하고, max_requests 에 도달하면 모든 워커에 종료를 알린다.
+ */
+void Worker::countHandled() {
+    std::size_t total = control_.handled.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (total >= config_.max_requests) {
+        control_.stop.store(true, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * Worker::handleConnections
+ * 설명:
+ *   - I/O 백엔드가 돌려준 준비/완료 이벤트만 받아 수락/수신/응답을 처리하고, 마감이 지난 연결을 닫는다.
+ *   - 대기 시간은 타이밍 휠의 가장 가까운 마감까지로 정하되 MAX_WAIT 를 넘지 않는다.
+ * 출력:
+ *   - 에러 없이 루프를 유지하면 true, 치명적 오류 시 false
+ * 에러:
+ *   - 이벤트 대기(epoll_wait/io_uring_enter) 실패 시 stderr에 한국어 메시지를 남기고 false를 반환한다.
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.1.0-epoll-reactor.md
+ * 관련 테스트:
+ *   - tests/test_webserv_keepalive.sh
+ *   - tests/test_webserv_epoll_many.sh
+ *   - tests/test_webserv_timeouts.sh
+ */
+bool Worker::handleConnections() {
+    // 미뤄 둔 연결이나 수락 예산에 걸려 남긴 연결이 있으면 기다리지 않고 이벤트만 수거한다.
+    int timeout_ms = 0;
+    if (deferred_.empty() && !accept_pending_ && !tls_accept_pending_) {
+        timeout_ms = timers_.nextTimeout(std::chrono::steady_clock::now(), static_cast<int>(MAX_WAIT.count()));
+    }
+    int ready = io_->wait(events_, timeout_ms);
+    auto now = std::chrono::steady_clock::now();
+    // Date 헤더와 미리 만든 응답은 초가 바뀔 때만 다시 만든다.
+    responses_.refresh(std::time(nullptr));
+    if (ready < 0) {
+        std::cerr << "[워커 " << id_ << "] 이벤트 대기 실패 (" << io_->name() << "): " << std::strerror(errno)
+                  << std::endl;
+        return false;
+    }
+
+    bool accepted = false;
+    bool tls_accepted = false;
+    for (const IoEvent &event : events_) {
+        if (stopping()) {
+            break;
+        }
+        if (ConnectionPool::isConnectionToken(event.token)) {
+            serviceConnection(event.token, event.events, now);
+        } else if (static_cast<int>(event.token) == listen_fd_) {
+            acceptClients(now, false);
+            accepted = true;
+        } else if (tls_listen_fd_ >= 0 && static_cast<int>(event.token) == tls_listen_fd_) {
+            acceptClients(now, true);
+            tls_accepted = true;
+        } else if (files_ && static_cast<int>(event.token) == files_->notifyFd()) {
+            files_->handleNotifications();
+        } else if (completions_.fd() >= 0 && static_cast<int>(event.token) == completions_.fd()) {
+            completions_.drain();
+        }
+    }
+
+    if (!deferred_.empty()) {
+        // 두 목록을 맞바꿔 쓰므로 어느 쪽도 용량을 잃지 않는다.
+        deferred_scratch_.clear();
+        deferred_scratch_.swap(deferred_);
+        for (std::uint64_t handle : deferred_scratch_) {
+            if (stopping()) {
+                break;
+            }
+            serviceConnection(handle, 0, now);
+        }
+    }
+
+    // 엣지 트리거 리슨 소켓은 대기열을 EAGAIN 까지 비우지 않으면 새 연결이 오기 전까지 다시 알리지 않는다.
+    // 지난 회차에 예산으로 멈췄다면 이미 받은 연결을 한 바퀴 돌린 뒤 여기서 이어 받는다.
+    if (accept_pending_ && !accepted && !stopping()) {
+        acceptClients(now, false);
+    }
+    if (tls_accept_pending_ && !tls_accepted && !stopping()) {
+        acceptClients(now, true);
+    }
+
+    expireTimeouts(now);
+    if (config_.overload_lag.count() != 0) {
+        updateOverload(now);
+    }
+    return true;
+}
+
+/**
+ * Worker::updateOverload (v1.24.0)
+ * 설명:
+ *   - 이번 회차의 처리 시간(이벤트 대기에서 돌아온 뒤부터 지금까지)을 루프 지연으로 본다. 이 회차 동안 도착한
+ *     이벤트는 그만큼 늦게 처리된다. overload_lag 이상이면 과부하 상태로 들어가고, 절반 아래로 내려오면 나온다.
+ *   - 과부하 중에는 새 요청을 처리하지 않고 503 으로 답하므로 다음 회차가 짧아진다. 쌓인 요청을 한 회차에
+ *     돌려보낸 뒤 바로 빠져나오는 것이 의도한 동작이다.
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.24.0-client-limits.md
+ */
+void Worker::updateOverload(std::chrono::steady_clock::time_point start) {
+    auto lag = std::chrono::steady_clock::now() - start;
+    if (!overloaded_ && lag >= config_.overload_lag) {
+        overloaded_ = true;
+        WorkerMetrics::add(metrics_.overload_entered, 1);
+        metrics_.overloaded.store(1, std::memory_order_relaxed);
+    } else if (overloaded_ && lag * 2 < config_.overload_lag) {
+        overloaded_ = false;
+        metrics_.overloaded.store(0, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * Worker::acceptClients
+ * 설명:
+ *   - 리슨 소켓 대기열에서 연결을 받아 연결 풀에 등록하고 유휴 마감을 건다.
+ *   - 한 번에 `--accept-batch` 개까지만 받는다. 예산을 다 쓰면 accept_pending_ 을 올려 두고 돌아가,
+ *     연결 폭주 중에도 이미 맺은 연결의 요청이 다음 루프 회차에서 먼저 처리되게 한다. 0 이면 EAGAIN 까지 받는다.
+ *   - tls 가 참이면 TLS 리스너에서 받고 연결마다 SSL 객체를 붙인다. 핸드셰이크는 첫 수신에서 시작하고,
+ *     끝날 때까지는 첫 요청을 기다리는 연결과 같이 유휴 마감을 받는다(v1.22.0).
+ *   - 클라이언트 한도 표가 있으면 원격 주소의 칸을 잡는다. 주소의 동시 연결 한도를 넘으면 등록하지 않고 바로 닫는다.
+ *     표가 붐벼 칸을 얻지 못한 연결은 한도 없이 받는다(v1.24.0).
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.1.0-epoll-reactor.md
+ *   - design/webserv-cpp17/v1.20.0-accept-path.md
+ *   - design/webserv-cpp17/v1.22.0-tls.md
+ *   - design/webserv-cpp17/v1.24.0-client-limits.md
+ * 관련 테스트:
+ *   - tests/test_webserv_epoll_many.sh
+ *   - tests/test_webserv_accept.sh
+ *   - tests/test_webserv_tls.sh
+ *   - tests/test_webserv_client_limits.sh
+ */
+void Worker::acceptClients(std::chrono::steady_clock::time_point now, bool tls) {
+    const int listen_fd = tls ? tls_listen_fd_ : listen_fd_;
+    bool &pending = tls ? tls_accept_pending_ : accept_pending_;
+    pending = false;
+    std::size_t budget = config_.accept_batch;
+    while (true) {
+        if (config_.accept_batch != 0 && budget-- == 0) {
+            pending = true;
+            WorkerMetrics::add(metrics_.accept_budget_exhausted, 1);
+            break;
+        }
+        int client_fd = io_->accept(listen_fd);
+        if (client_fd < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                std::cerr << "연결 수락 실패: " << std::strerror(errno) << std::endl;
+            }
+            break;
+        }
+
+        std::uint32_t client_slot = ClientLimiter::NO_SLOT;
+        if (limiter_ != nullptr) {
+            sockaddr_storage address{};
+            socklen_t length = sizeof(address);
+            ClientAdmission admission = ClientAdmission::kUntracked;
+            if (::getpeername(client_fd, reinterpret_cast<sockaddr *>(&address), &length) == 0) {
+                admission = limiter_->admit(clientKey(address), now, client_slot);
+            }
+            if (admission == ClientAdmission::kRejected) {
+                WorkerMetrics::add(metrics_.shed[static_cast<std::size_t>(ShedLabel::kConnections)], 1);
+                ::close(client_fd);
+                continue;
+            }
+            if (admission == ClientAdmission::kUntracked) {
+                WorkerMetrics::add(metrics_.client_untracked, 1);
+            }
+        }
+
+        Connection &conn = connections_.acquire(client_fd);
+        conn.client_slot = client_slot;
+        if (tls && !conn.tls.attach(*tls_, client_fd, metrics_)) {
+            std::cerr << "TLS 연결 준비 실패" << std::endl;
+            releaseClient(conn);
+            connections_.release(conn);
+            ::close(client_fd);
+            continue;
+        }
+        if (!io_->addConnection(conn)) {
+            std::cerr << "연결 등록 실패: " << std::strerror(errno) << std::endl;
+            releaseClient(conn);
+            connections_.release(conn);
+            ::close(client_fd);
+            continue;
+        }
+        // 첫 요청을 기다리는 동안은 요청 사이 유휴 상태와 같게 본다(풀이 돌려주는 슬롯은 kIdle 로 초기화되어 있다).
+        timers_.schedule(conn.timer, now + config_.idle_timeout);
+        WorkerMetrics::add(metrics_.accepted, 1);
+    }
+}
+
+/**
+ * Worker::serviceConnection
+ * 설명:
+ *   - 이벤트 마스크에 따라 수신 -> 요청 처리 -> 출력 큐 송신을 진행한다.
+ *   - 출력 큐가 HIGH_WATER 를 넘으면 수신과 요청 처리를 멈추고(백프레셔), 쓰기 가능 이벤트로
+ *     LOW_WATER 아래까지 비워지면 남은 입력부터 다시 처리한다.
+ *   - 같은 이벤트에서 원격 종료(recv == 0)를 만나도 이미 받은 요청은 먼저 처리하고 응답을 모두 보낸 뒤 닫는다.
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.5.0-output-queue.md
+ * 관련 테스트:
+ *   - tests/test_webserv_slow_reader.sh
+ *   - tests/test_webserv_pipeline_depth.sh
+ */
+void Worker::serviceConnection(std::uint64_t handle, std::uint32_t events,
+                               std::chrono::steady_clock::time_point now) {
+    Connection *found = connections_.find(handle);
+    if (found == nullptr) {
+        // 이미 닫힌 연결에 늦게 도착한 이벤트나 미뤄 둔 작업이다. FD 가 재사용되었어도 세대가 달라 걸러진다.
+        return;
+    }
+    Connection &conn = *found;
+    if (events & (EVENT_READ | EVENT_ERROR)) {
+        // 오류 이벤트도 recv/send 가 errno 를 돌려주도록 읽기 경로로 넘긴다.
+        conn.read_ready = true;
+    }
+    if ((events & EVENT_WRITE) && conn.tls.wantsWrite()) {
+        // 핸드셰이크가 소켓 쓰기를 기다리며 멈춘 TLS 연결이다. 다음 단계는 읽기 경로(SSL_read)가 진행한다.
+        conn.read_ready = true;
+    }
+
+    bool progressed = false;
+    for (int pass = 0;; ++pass) {
+        // 완료 기반 송신(io_uring)이 출력 큐 버퍼를 가리키는 동안은 버퍼가 옮겨지지 않도록 응답을 쌓지 않고,
+        // 입력도 더 받지 않는다. 송신 완료 이벤트에서 이어 간다. epoll 백엔드에서는 항상 거짓이다.
+        // 프록시 중에는 상대 연결이 받아 줄 수 없으면(inputBlocked) 읽지 않는다. 상대가 비우면 다시 깨운다.
+        // 작업 스레드 결과를 기다리는 동안도 같다. 완료 큐 콜백이 지연 목록에 넣어 깨운다.
+        if (!conn.reading_paused && !conn.should_close && !conn.io.send_armed && !inputBlocked(conn)) {
+            if (conn.read_ready && !conn.peer_closed && receiveInput(conn, now) > 0) {
+                progressed = true;
+            }
+            if (conn.proxy.role == ProxyRole::kUpstream) {
+                relayResponse(conn, now);
+            } else {
+                processRequests(conn, now);
+            }
+        }
+
+        std::size_t sent = 0;
+        FlushResult result = io_->flush(conn, sent);
+        if (sent > 0) {
+            progressed = true;
+            recordSent(conn, sent);
+        }
+        if (result == FlushResult::kError) {
+            std::cerr << (conn.proxy.role == ProxyRole::kUpstream ? "업스트림 요청 송신 실패: " : "응답 송신 실패: ")
+                      << std::strerror(errno) << std::endl;
+            closeConnection(conn);
+            return;
+        }
+        wakeProxyPeer(conn);
+
+        bool resumed = false;
+        if (conn.reading_paused && conn.output.bytes() <= OUTPUT_LOW_WATER) {
+            // 멈춰 있던 동안 쌓인 입력과 소켓에 남은 데이터를 이어서 처리한다.
+            conn.reading_paused = false;
+            resumed = true;
+        }
+        bool more_input = conn.read_ready && !conn.peer_closed && !conn.io.send_armed && !inputBlocked(conn);
+        if (conn.reading_paused || conn.should_close || (!resumed && !more_input)) {
+            break;
+        }
+        if (pass + 1 >= MAX_SERVICE_PASSES) {
+            deferred_.push_back(handle);
+            break;
+        }
+    }
+
+    // 업스트림 연결은 보낼 요청이 남아 있어도 바로 닫는다. 응답을 기다리는 클라이언트는 업스트림 응답이 끝나거나
+    // 작업 스레드 결과를 쓸 때까지 둔다. HTTP/2 연결은 결과를 기다리는 스트림이 있으면 상대가 쓰기를 닫아도 둔다.
+    bool finished = conn.proxy.role == ProxyRole::kUpstream
+                        ? conn.should_close || (conn.peer_closed && conn.proxy.peer == 0)
+                        : conn.output.empty() && (conn.should_close || conn.peer_closed) && !awaitingReply(conn) &&
+                              (conn.should_close || !http2Waiting(conn));
+    if (finished) {
+        closeConnection(conn);
+        return;
+    }
+    if (updateInterest(conn)) {
+        armTimeout(conn, now, progressed);
+    }
+}
+
+/**
+ * Worker::receiveInput
+ * 설명:
+ *   - 엣지 트리거 규칙에 따라 EAGAIN 까지 입력 버퍼 꼬리에 직접 수신한다.
+ *   - RECV_BUDGET 을 다 쓰면 read_ready 를 남겨 둔 채 돌아가 먼저 요청을 처리하게 한다.
+ *     본문을 읽는 중이면 더 작은 BODY_RECV_BUDGET 을 써서 업로드가 입력 버퍼를 키우지 않게 한다.
+ *     업스트림 응답 본문도 같다. 클라이언트 출력 큐로 옮기는 단위가 작아야 백프레셔가 빨리 듣는다.
+ *   - 수신 바이트 계측은 클라이언트 연결만 센다.
+ * 출력:
+ *   - 이번에 받은 바이트 수
+ */
+std::size_t Worker::receiveInput(Connection &conn, std::chrono::steady_clock::time_point now) {
+    const bool upstream = conn.proxy.role == ProxyRole::kUpstream;
+    const std::size_t limit = conn.body.decoder.active() || conn.proxy.reading_body ? BODY_RECV_BUDGET : RECV_BUDGET;
+    std::size_t budget = limit;
+    while (budget > 0) {
+        char *destination = conn.input.prepare(RECV_CHUNK);
+        ssize_t received = io_->recv(conn, destination, conn.input.writable());
+        if (received > 0) {
+            if (conn.input.empty()) {
+                conn.request_start = now;
+            }
+            if (!upstream) {
+                WorkerMetrics::add(metrics_.bytes_in, static_cast<std::uint64_t>(received));
+            }
+            conn.input.commit(static_cast<std::size_t>(received));
+            budget -= std::min(budget, static_cast<std::size_t>(received));
+            continue;
+        }
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        conn.read_ready = false;
+        if (!(received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))) {
+            conn.peer_closed = true;
+        }
+        break;
+    }
+    return limit - budget;
+}
+
+/**
+ * Worker::processRequests
+ * 설명:
+ *   - 입력 버퍼에 완성된 요청을 순서대로 파싱해 응답을 출력 큐에 쌓는다.
+ *   - 본문이 있는 요청은 헤더 처리 뒤 본문을 다 읽을 때까지 입력 버퍼의 앞부분을 본문으로 해석한다(readBody).
+ *   - 헤더가 max_header_bytes 를 넘으면 431 로 응답하고 닫는다.
+ *   - 출력 큐가 OUTPUT_HIGH_WATER 에 닿으면 남은 요청은 입력 버퍼에 둔 채 수신을 멈춘다.
+ *   - 프록시 요청은 업스트림 응답이 끝날 때까지 다음 요청으로 넘어가지 않는다. 업스트림이 실패했으면
+ *     여기서 502/504 로 답한다(v1.16.0).
+ *   - 작업 스레드에 맡긴 요청도 결과가 돌아올 때까지 다음 요청으로 넘어가지 않고, 돌아오면 여기서 응답을 쓴다(v1.17.0).
+ *   - 코루틴 핸들러는 기다리던 것이 오면 여기서 재개하고, 끝나면 응답을 쓴다(driveCoroutine, v1.18.0).
+ *   - HTTP/2 로 바뀐 연결은 processHttp2 가 맡는다. TLS 에서 ALPN 이 h2 를 골랐거나, 평문 연결의 첫 바이트가
+ *     HTTP/2 프리페이스면 여기서 세션을 시작한다(v1.23.0). 프리페이스가 덜 왔으면 더 기다린다.
+ */
+void Worker::processRequests(Connection &conn, std::chrono::steady_clock::time_point now) {
+    while (!conn.should_close) {
+        if (http2Active(conn)) {
+            processHttp2(conn, now);
+            return;
+        }
+        if (config_.http2 && conn.tls.alpnHttp2()) {
+            startHttp2(conn, Http2ConnectionLabel::kAlpn);
+            continue;
+        }
+        if (config_.http2 && !conn.tls.active() && conn.output.pushedTotal() == 0 && !conn.input.empty() &&
+            conn.input.data()[0] == HTTP2_PREFACE[0]) {
+            std::size_t compare = std::min(conn.input.size(), HTTP2_PREFACE.size());
+            if (std::string_view(conn.input.data(), compare) == HTTP2_PREFACE.substr(0, compare)) {
+                if (compare < HTTP2_PREFACE.size()) {
+                    return;
+                }
+                startHttp2(conn, Http2ConnectionLabel::kPriorKnowledge);
+                continue;
+            }
+        }
+        if (conn.proxy.role == ProxyRole::kClient && !conn.proxy.capture) {
+            if (conn.proxy.error != 0) {
+                replyProxyError(conn, now);
+                continue;
+            }
+            if (!conn.body.decoder.active()) {
+                // 업스트림 응답을 기다린다. 파이프라이닝된 다음 요청은 응답이 끝난 뒤 처리한다.
+                return;
+            }
+        }
+        if (conn.offload.state == OffloadState::kRunning && !conn.body.decoder.active()) {
+            // 작업 스레드 결과를 기다린다. completeOffload 가 지연 목록에 넣어 다시 부른다.
+            return;
+        }
+        if (coroutineWaiting(conn)) {
+            // 타이머 만료(expireTimeouts)나 업스트림 응답(finishProxy/abandonUpstream)이 지연 목록에 넣어 다시 부른다.
+            return;
+        }
+        if (conn.output.bytes() >= OUTPUT_HIGH_WATER) {
+            conn.reading_paused = true;
+            return;
+        }
+        if (conn.offload.state == OffloadState::kDone && !conn.body.decoder.active()) {
+            writeOffloadReply(conn, now);
+            continue;
+        }
+        if (conn.co.active()) {
+            if (!driveCoroutine(conn, now)) {
+                return;
+            }
+            continue;
+        }
+        if (conn.body.decoder.active()) {
+            if (!readBody(conn, now)) {
+                return;
+            }
+            continue;
+        }
+
+        ParseStatus status = conn.parser.parse(conn.input.data(), conn.input.size());
+        if (status == ParseStatus::kIncomplete) {
+            if (conn.input.size() > config_.max_header_bytes) {
+                rejectRequest(conn, CannedReply::kHeaderTooLarge, 431, now);
+            }
+            return;
+        }
+        if (status == ParseStatus::kError) {
+            // 요청 라인 형식 오류는 더 읽어도 복구할 수 없으므로 400 으로 응답하고 닫는다.
+            rejectRequest(conn, CannedReply::kMalformed, 400, now);
+            return;
+        }
+        if (conn.parser.consumed() > config_.max_header_bytes) {
+            rejectRequest(conn, CannedReply::kHeaderTooLarge, 431, now);
+            return;
+        }
+        beginRequest(conn, now);
+    }
+}
+
+/**
+ * Worker::beginRequest
+ * 설명:
+ *   - 헤더가 완성된 요청의 본문 길이 결정 방식을 확인하고 응답 또는 본문 읽기를 시작한다.
+ *     - 길이를 믿을 수 없으면 400, chunked 외 전송 코딩이면 501, Content-Length 가 제한을 넘으면 413 으로 닫는다.
+ *     - `POST /upload` 는 본문을 UploadDigest 로 흘려보내고 본문 끝에서 응답한다.
+ *     - 내장 라우트에 없는 경로가 `--proxy` 접두사에 맞으면 업스트림으로 넘긴다(v1.16.0). 본문은 틀 그대로 흘려보낸다.
+ *     - 블로킹 핸들러 라우트는 작업 스레드 풀이 있으면 풀에 맡긴다(v1.17.0). 본문은 읽고 버린다.
+ *     - 코루틴 핸들러 라우트는 프레임을 만든다(v1.18.0). 본문 조각은 코루틴이 readBody 로 기다릴 때 넘긴다.
+ *     - 나머지 요청은 지금 응답을 만들고, 본문이 있으면 다음 요청 경계를 찾을 때까지 읽고 버린다.
+ *     - 본문 없는 평문 요청이 `Upgrade: h2c` 를 청하면 101 로 HTTP/2 로 바꾸고 그 요청을 스트림 1로 처리한다(v1.23.0).
+ *       본문이 있는 요청은 전환하지 않는다. 본문을 HTTP/1.1 로 다 읽은 뒤에야 바꿀 수 있어서다.
+ *     - 주소의 토큰 버킷이 비었으면 429, 워커가 과부하 상태면 503 으로 라우트를 찾지 않고 답한다(v1.24.0).
+ *       연결은 유지하고 본문이 있으면 읽고 버린다.
+ *   - 헤더 바이트는 여기서 소비한다. 헤더 조각은 이 함수 안에서만 쓴다.
+ */
+void Worker::beginRequest(Connection &conn, std::chrono::steady_clock::time_point now) {
+    const HttpRequestView &request = conn.parser.request();
+    if (access_log_ != nullptr) {
+        // 헤더 바이트는 이 함수 끝에서 소비되므로 메서드/경로를 지금 레코드에 복사해 둔다.
+        conn.access.setRequest(request.method, request.path);
+    }
+    BodySpec spec = bodySpecFor(request);
+    if (spec.framing == BodyFraming::kInvalid) {
+        rejectRequest(conn, CannedReply::kBadFraming, 400, now);
+        return;
+    }
+    if (spec.framing == BodyFraming::kUnsupported) {
+        rejectRequest(conn, CannedReply::kUnsupportedEncoding, 501, now);
+        return;
+    }
+    if (spec.framing == BodyFraming::kLength && spec.length > config_.max_body_bytes) {
+        rejectRequest(conn, CannedReply::kBodyTooLarge, 413, now);
+        return;
+    }
+
+    bool has_body = spec.framing == BodyFraming::kChunked || (spec.framing == BodyFraming::kLength && spec.length > 0);
+    std::uint32_t retry_after = 0;
+    int shed_status = shedStatus(conn, now, retry_after);
+    if (config_.http2 && shed_status == 0 && !has_body && !conn.tls.active()) {
+        const HeaderField *settings = http2Upgrade(request);
+        if (settings != nullptr && upgradeHttp2(conn, settings->value, now)) {
+            return;
+        }
+    }
+    bool body_waiting = has_body && expectsContinue(request) && conn.input.size() == conn.parser.consumed();
+    RequestBody &body = conn.body;
+    RouteMatch match;
+    int proxy_route = -1;
+    if (shed_status == 0) {
+        matchRoute(request, routes_, match);
+        if (upstreams_ && match.status == RouteStatus::kNotFound &&
+            (request.version != "HTTP/1.1" || request.findHeader("host") != nullptr)) {
+            proxy_route = upstreams_->match(request.path.substr(0, request.path.find('?')));
+        }
+    }
+    if (shed_status != 0) {
+        body.route = BodyRoute::kDiscard;
+        body.label = RouteLabel::kError;
+        body.status = shed_status;
+        body.keep_alive = keepAlive(request) && !body_waiting;
+        if (body_waiting) {
+            // 100 Continue 를 보내지 않으므로 본문이 오지 않을 수 있다. 응답 뒤 닫는다.
+            has_body = false;
+        }
+        writeShedReply(conn.output, shed_status, retry_after, body.keep_alive);
+    } else if (proxy_route >= 0) {
+        body.route = BodyRoute::kProxy;
+        body.label = RouteLabel::kProxy;
+        startProxy(conn, static_cast<std::size_t>(proxy_route), has_body, body_waiting);
+    } else if (handlers_ != nullptr && isBlockingRequest(request, match)) {
+        body.label = ROUTE_HANDLERS[match.id].label;
+        body.keep_alive = keepAlive(request);
+        if (body_waiting) {
+            // 100 Continue 를 보내지 않으므로 본문이 오지 않을 수 있다. 응답 뒤 닫는다.
+            body.keep_alive = false;
+            has_body = false;
+        }
+        startOffload(conn, match.id, match.params);
+    } else if (isCoroutineRequest(request, match)) {
+        body.label = ROUTE_HANDLERS[match.id].label;
+        body.keep_alive = keepAlive(request);
+        if (startCoroutine(conn, match.id, match.params) && body_waiting) {
+            conn.output.append(CONTINUE_RESPONSE);
+        }
+    } else if (isUploadRequest(request, match)) {
+        body.route = BodyRoute::kUpload;
+        body.label = RouteLabel::kUpload;
+        body.status = 200;
+        body.keep_alive = keepAlive(request);
+        body.upload = UploadDigest();
+        if (body_waiting) {
+            conn.output.append(CONTINUE_RESPONSE);
+        }
+    } else {
+        body.route = BodyRoute::kDiscard;
+        ReplyContext context{files_.get(),      config_.static_copy, registry_,
+                             responses_,        compressed_.get(),   compressor_.get(),
+                             metrics_,          response_cache_.get(), now,
+                             draining_};
+        body.status = buildReply(request, match, context, conn.output, body.keep_alive, body.label);
+        if (body_waiting) {
+            // 100 Continue 없이 최종 응답을 보냈으므로 클라이언트는 본문을 보내지 않을 수 있다. 기다리지 않고 닫는다.
+            body.keep_alive = false;
+            has_body = false;
+        }
+    }
+
+    conn.input.consume(conn.parser.consumed());
+    conn.parser.reset();
+    if (!has_body) {
+        completeRequest(conn, now);
+        return;
+    }
+    body.decoder.start(spec, config_.max_body_bytes);
+}
+
+/**
+ * Worker::readBody
+ * 설명:
+ *   - 입력 버퍼의 본문 바이트를 조각 단위로 핸들러에 넘기고 바로 소비한다. 본문 전체를 모으지 않는다.
+ *   - chunked 형식 오류는 400, 제한 초과는 413 으로 끝낸다. 버리던 본문이면 이미 보낸 응답 뒤에 연결만 닫는다.
+ * 출력:
+ *   - 본문을 끝까지 읽어 다음 요청을 처리할 수 있으면 true, 더 받아야 하거나 연결을 닫게 되었으면 false
+ */
+bool Worker::readBody(Connection &conn, std::chrono::steady_clock::time_point now) {
+    RequestBody &body = conn.body;
+    if (body.route == BodyRoute::kProxy) {
+        return forwardBody(conn);
+    }
+    while (true) {
+        std::size_t consumed = 0;
+        std::string_view slice;
+        BodyStatus status = body.decoder.next(conn.input.data(), conn.input.size(), consumed, slice);
+        if (status == BodyStatus::kSlice && body.route == BodyRoute::kUpload) {
+            body.upload.update(slice);
+        } else if (status == BodyStatus::kSlice && body.route == BodyRoute::kCoroutine) {
+            // 조각은 입력 버퍼를 가리키므로 소비하기 전에 코루틴을 재개한다.
+            conn.co.slice = slice;
+            conn.co.body_end = false;
+            resumeCoroutine(conn, now);
+        }
+        conn.input.consume(consumed);
+
+        switch (status) {
+            case BodyStatus::kSlice:
+                if (body.route == BodyRoute::kCoroutine && conn.co.wait != CoWait::kBody) {
+                    // 코루틴이 다른 것을 기다리거나 끝났다. driveCoroutine 이 이어 간다.
+                    return true;
+                }
+                continue;
+            case BodyStatus::kNeedMore:
+                return false;
+            case BodyStatus::kDone:
+                completeRequest(conn, now);
+                return true;
+            case BodyStatus::kTooLarge:
+            case BodyStatus::kError:
+                break;
+        }
+
+        body.decoder.reset();
+        body.keep_alive = false;
+        if (body.route != BodyRoute::kDiscard) {
+            // 업로드와 작업 스레드에 맡긴 요청은 아직 응답을 쓰지 않았다. 돌아올 작업 결과와 코루틴은 버린다.
+            conn.offload.reset();
+            conn.co.reset();
+            bool too_large = status == BodyStatus::kTooLarge;
+            conn.output.append(responses_.canned(too_large ? CannedReply::kBodyTooLarge : CannedReply::kBadFraming,
+                                                 false));
+            body.label = RouteLabel::kError;
+            body.status = too_large ? 413 : 400;
+        }
+        finishRequest(conn, body.label, body.status, false, now);
+        return false;
+    }
+}
+
+/**
+ * Worker::completeRequest
+ * 설명:
+ *   - 본문까지 다 읽은 요청을 마무리한다. 업로드 요청은 이때 응답을 만든다. 프록시 요청은 응답을 기다린다.
+ *   - 작업 스레드에 맡긴 요청은 결과가 돌아온 뒤 processRequests 가 마무리한다(v1.17.0).
+ *   - 코루틴 핸들러 요청은 코루틴이 끝난 뒤 writeCoroutineReply 가 마무리한다(v1.18.0).
+ */
+void Worker::completeRequest(Connection &conn, std::chrono::steady_clock::time_point now) {
+    RequestBody &body = conn.body;
+    if (body.route == BodyRoute::kProxy || body.route == BodyRoute::kOffload || body.route == BodyRoute::kCoroutine) {
+        // 응답은 업스트림이나 작업 스레드에서 온다. relayResponse/replyProxyError 나 writeOffloadReply 가 마무리한다.
+        return;
+    }
+    if (body.route == BodyRoute::kUpload) {
+        writeUploadReply(body.upload, body.keep_alive, responses_.dateLine(), conn.output);
+    }
+    finishRequest(conn, body.label, body.status, body.keep_alive, now);
+}
+
+/**
+ * Worker::rejectRequest
+ * 설명:
+ *   - 헤더 단계에서 더 읽지 않고 끝낼 요청(형식 오류, 크기 제한 초과)에 고정 응답을 보내고 연결을 닫게 한다.
+ */
+void Worker::rejectRequest(Connection &conn, CannedReply reply, int status,
+                           std::chrono::steady_clock::time_point now) {
+    conn.output.append(responses_.canned(reply, false));
+    finishRequest(conn, RouteLabel::kError, status, false, now);
+}
+
+/**
+ * Worker::shedStatus (v1.24.0)
+ * 설명:
+ *   - 새 요청을 처리하지 않고 돌려보낼지 정한다. 과부하 상태면 503(다시 시도는 1초 뒤), 연결이 잡은 칸의
+ *     토큰 버킷이 비었으면 429(다음 토큰까지 남은 초)다. 과부하를 먼저 보므로 돌려보낸 요청은 토큰을 쓰지 않는다.
+ * 출력:
+ *   - 돌려보낼 상태 코드와 retry_after(초). 처리할 요청이면 0
+ */
+int Worker::shedStatus(const Connection &conn, std::chrono::steady_clock::time_point now,
+                       std::uint32_t &retry_after) {
+    if (overloaded_) {
+        WorkerMetrics::add(metrics_.shed[static_cast<std::size_t>(ShedLabel::kOverload)], 1);
+        retry_after = 1;
+        return 503;
+    }
+    if (conn.client_slot != ClientLimiter::NO_SLOT && !limiter_->allowRequest(conn.client_slot, now, retry_after)) {
+        WorkerMetrics::add(metrics_.shed[static_cast<std::size_t>(ShedLabel::kRate)], 1);
+        return 429;
+    }
+    return 0;
+}
+
+/**
+ * Worker::writeShedReply (v1.24.0)
+ * 설명:
+ *   - shedStatus 가 정한 429/503 응답을 `Retry-After` 헤더와 함께 output 에 쓴다. 초 값이 매번 달라
+ *     고정 응답(CannedReply) 대신 writeResponse 로 직렬화한다.
+ */
+void Worker::writeShedReply(OutputQueue &output, int status, std::uint32_t retry_after, bool keep_alive) {
+    constexpr std::string_view RETRY_AFTER = "Retry-After: ";
+    char header[RETRY_AFTER.size() + 12];
+    std::memcpy(header, RETRY_AFTER.data(), RETRY_AFTER.size());
+    char *end = std::to_chars(header + RETRY_AFTER.size(), header + sizeof(header) - 2, retry_after).ptr;
+    *end++ = '\r';
+    *end++ = '\n';
+    writeResponse(output, status, {status == 429 ? "Too many requests\n" : "Service unavailable\n"}, keep_alive,
+                  responses_.dateLine(), std::string_view(header, static_cast<std::size_t>(end - header)));
+}
+
+/**
+ * Worker::releaseClient (v1.24.0)
+ * 설명:
+ *   - 연결이 클라이언트 한도 표에서 잡은 칸의 연결 수를 내려놓는다. 칸이 없으면 아무것도 하지 않는다.
+ */
+void Worker::releaseClient(Connection &conn) {
+    if (conn.client_slot != ClientLimiter::NO_SLOT) {
+        limiter_->release(conn.client_slot);
+        conn.client_slot = ClientLimiter::NO_SLOT;
+    }
+}
+
+/**
+ * Worker::finishRequest
+ * 설명:
+ *   - 응답이 출력 큐에 들어간 요청의 계측/지연 측정 위치/처리 건수를 기록하고 연결 유지 여부를 반영한다.
+ *   - 접근 로그를 켰으면 레코드를 워커 링에 넘긴다(v1.21.0).
+ */
+void Worker::finishRequest(Connection &conn, RouteLabel route, int status, bool keep_alive,
+                           std::chrono::steady_clock::time_point now) {
+    metrics_.countRequest(route, status);
+    conn.in_flight.push_back(PendingResponse{conn.output.pushedTotal(), conn.request_start});
+    if (access_log_ != nullptr) {
+        logAccess(conn, status);
+    }
+    countHandled();
+    if (!conn.input.empty()) {
+        // 파이프라이닝된 다음 요청은 이미 수신되어 있으므로 처리를 시작하는 지금부터 잰다.
+        conn.request_start = now;
+    }
+    if (!keep_alive || stopping() || draining_) {
+        conn.should_close = true;
+    }
+}
+
+/**
+ * Worker::logAccess
+ * 설명:
+ *   - 표본에 든 요청이면 연결의 접근 로그 레코드를 채워 워커 링에 복사한다. 링이 차 있으면 버리고 센다.
+ *     - bytes: 이 요청 몫으로 출력 큐에 넣은 바이트(100 Continue 포함). 이전 요청 응답 끝부터 잰다.
+ *     - latency_us: 요청 첫 바이트 수신부터 응답을 출력 큐에 다 넣기까지. 송신 완료까지의 지연은 히스토그램이 잰다.
+ *     - 레코드 시각(finished_ns)도 같은 시계 값이다.
+ *   - 표본에서 빠진 요청도 다음 요청의 시작 위치와 요청 정보는 되돌린다.
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.21.0-access-log.md
+ */
+void Worker::logAccess(Connection &conn, int status) {
+    std::uint64_t pushed = conn.output.pushedTotal();
+    sampleAccess(conn.access, conn.handle, pushed - conn.reply_mark, conn.request_start, status);
+    conn.reply_mark = pushed;
+    conn.access.clearRequest();
+}
+
+/**
+ * Worker::sampleAccess (v1.23.0)
+ * 설명:
+ *   - 표본 간격을 세고, 표본에 든 요청이면 레코드의 나머지 필드를 채워 워커 링에 복사한다.
+ *     HTTP/1.1 요청(logAccess)과 HTTP/2 스트림(respondStream)이 함께 쓴다. bytes 와 start 는 호출자가 정한다.
+ */
+void Worker::sampleAccess(AccessRecord &record, std::uint64_t connection, std::uint64_t bytes,
+                          std::chrono::steady_clock::time_point start, int status) {
+    if (--access_countdown_ != 0) {
+        return;
+    }
+    access_countdown_ = config_.access_log_sample;
+    // 루프 회차의 now 는 요청 시작 시각과 같은 값이라 한 회차에 끝난 요청의 지연이 0 이 된다.
+    // 표본에 든 요청만 시계를 새로 읽는다.
+    auto now = std::chrono::steady_clock::now();
+    auto latency = std::chrono::duration_cast<std::chrono::microseconds>(now - start).count();
+    record.finished_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count();
+    record.connection = connection;
+    record.bytes = bytes;
+    record.latency_us = latency > 0 ? static_cast<std::uint32_t>(latency) : 0;
+    record.status = static_cast<std::uint16_t>(status);
+    AccessLogLabel result = access_log_->tryPush(record) ? AccessLogLabel::kQueued : AccessLogLabel::kDropped;
+    WorkerMetrics::add(metrics_.access_log[static_cast<std::size_t>(result)], 1);
+}
+
+/**
+ * Worker::updateInterest
+ * 설명:
+ *   - 출력 큐 상태에 맞게 백엔드의 쓰기 가능 통지 관심사를 맞춘다(epoll 은 바뀔 때만 epoll_ctl 호출).
+ * 출력:
+ *   - 연결이 유지되면 true, 관심사 변경 실패로 연결을 닫았으면 false (conn 은 더 이상 유효하지 않다)
+ */
+bool Worker::updateInterest(Connection &conn) {
+    if (!io_->updateInterest(conn)) {
+        std::cerr << "연결 관심사 변경 실패: " << std::strerror(errno) << std::endl;
+        closeConnection(conn);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Worker::armTimeout
+ * 설명:
+ *   - 연결 상태로 타임아웃 단계를 정하고 타이밍 휠의 마감을 옮긴다.
+ *     - 송신할 응답이 남아 있음: 송신(write) 단계. 송신이 진척될 때마다 now + write_timeout 으로 민다.
+ *     - 본문을 읽는 중: 본문 수신(body) 단계. 본문이 들어올 때마다 now + idle_timeout 으로 민다.
+ *       업로드 길이에 비례해 걸리는 시간을 헤더 마감으로 자르지 않기 위해서다.
+ *     - 받다 만 요청이 있음: 헤더 수신(header) 단계. 마감은 요청 첫 바이트 시각 + header_timeout 으로 고정되어
+ *       바이트를 조금씩 흘려 보내도 늘어나지 않는다.
+ *     - 둘 다 없음: 유휴(idle) 단계. 마지막 활동 시각 + idle_timeout.
+ *     - 업스트림 연결: 요청을 맡은 동안은 업스트림(upstream) 단계로 주고받을 때마다 now + proxy_timeout,
+ *       풀에서 쉬는 동안은 유휴 단계다. 상대 때문에 멈춘 쪽과 응답을 기다리는 클라이언트는 마감을 걸지 않는다.
+ *     - 작업 스레드 결과를 기다리는 클라이언트도 마감을 걸지 않는다(v1.17.0).
+ *     - 잠든 코루틴(sleep)의 연결은 타이머 노드가 깨울 시각을 들고 있으므로 건드리지 않는다(v1.18.0).
+ *     - HTTP/2 연결(v1.23.0): 작업 스레드 결과를 기다리는 스트림이 있으면 마감을 걸지 않는다. 흐름 제어 창이 닫혀
+ *       못 보낸 응답 본문이 있으면 송신 단계, 열린 스트림이 있으면 본문 수신 단계로 본다.
+ *   - 단계가 같고 주고받은 바이트가 없으면 휠을 건드리지 않는다.
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.8.0-timer-wheel.md
+ */
+void Worker::armTimeout(Connection &conn, std::chrono::steady_clock::time_point now, bool progressed) {
+    if (conn.co.wait == CoWait::kTimer && !conn.co.ready) {
+        return;
+    }
+    if (conn.proxy.stalled || awaitingReply(conn) || http2Waiting(conn)) {
+        // 진행은 상대 연결이 정한다. 상대 연결의 마감(업스트림 또는 송신)이 대신 지킨다.
+        // 작업 스레드 결과를 기다리는 동안도 걸지 않는다. 핸들러 실행 시간은 핸들러가 스스로 묶는다(v1.17.0).
+        timers_.cancel(conn.timer);
+        return;
+    }
+    const bool http2 = http2Active(conn);
+    TimeoutLabel phase = TimeoutLabel::kIdle;
+    if (conn.proxy.role == ProxyRole::kUpstream) {
+        phase = conn.proxy.peer != 0 ? TimeoutLabel::kUpstream : TimeoutLabel::kIdle;
+    } else if (!conn.output.empty() || (http2 && conn.http2->sending())) {
+        phase = TimeoutLabel::kWrite;
+    } else if (conn.body.decoder.active() || (http2 && conn.http2->openStreams() > 0)) {
+        phase = TimeoutLabel::kBody;
+    } else if (!conn.input.empty()) {
+        phase = TimeoutLabel::kHeader;
+    }
+    if (phase == conn.timeout_phase && !progressed && conn.timer.scheduled()) {
+        return;
+    }
+    conn.timeout_phase = phase;
+
+    std::chrono::steady_clock::time_point deadline;
+    switch (phase) {
+        case TimeoutLabel::kWrite:
+            deadline = now + config_.write_timeout;
+            break;
+        case TimeoutLabel::kBody:
+            deadline = now + config_.idle_timeout;
+            break;
+        case TimeoutLabel::kHeader:
+            deadline = conn.request_start + config_.header_timeout;
+            break;
+        case TimeoutLabel::kUpstream:
+            deadline = now + config_.proxy_timeout;
+            break;
+        default:
+            deadline = now + config_.idle_timeout;
+            break;
+    }
+    timers_.schedule(conn.timer, deadline);
+}
+
+/**
+ * Worker::expireTimeouts
+ * 설명:
+ *   - 타이밍 휠을 now 까지 진행하고 마감이 지난 연결만 닫는다. 비용은 만료된 연결 수에 비례한다.
+ *   - 잠든 코루틴의 마감은 타임아웃이 아니라 깨울 시각이다. 지연 목록에 넣어 재개한다(v1.18.0).
+ */
+void Worker::expireTimeouts(std::chrono::steady_clock::time_point now) {
+    expired_.clear();
+    timers_.advance(now, expired_);
+    for (std::uint64_t token : expired_) {
+        if (stopping()) {
+            break;
+        }
+        Connection *conn = connections_.find(token);
+        if (conn == nullptr) {
+            continue;
+        }
+        if (conn->co.wait == CoWait::kTimer && !conn->co.ready) {
+            conn->co.ready = true;
+            deferred_.push_back(token);
+            continue;
+        }
+        if (conn->proxy.role == ProxyRole::kUpstream) {
+            // 쉬던 업스트림 연결은 조용히 닫는다. 요청을 맡은 연결이면 클라이언트에 504 로 답한다.
+            if (conn->proxy.peer != 0) {
+                std::cerr << "업스트림 응답 타임아웃 (" << conn->proxy.upstreams->name(conn->proxy.server) << ")"
+                          << std::endl;
+                WorkerMetrics::add(metrics_.timeouts[static_cast<std::size_t>(TimeoutLabel::kUpstream)], 1);
+                abandonUpstream(*conn, 504);
+            }
+            closeConnection(*conn);
+            continue;
+        }
+        std::size_t phase = static_cast<std::size_t>(conn->timeout_phase);
+        std::cerr << "연결 타임아웃 발생 (" << TIMEOUT_PHASE_NAMES[phase] << ")" << std::endl;
+        WorkerMetrics::add(metrics_.timeouts[phase], 1);
+        closeConnection(*conn);
+        countHandled();
+    }
+}
+
+/**
+ * Worker::drainOutputs
+ * 설명:
+ *   - 종료 조건을 만난 뒤, 출력 큐에 남은 응답을 write_timeout 안에서 마저 송신한다.
+ *   - 새 요청은 더 이상 처리하지 않으며, 큐가 빈 연결부터 닫는다.
+ */
+void Worker::drainOutputs() {
+    connections_.forEach([this](Connection &conn) {
+        std::size_t sent = 0;
+        FlushResult result = io_->flush(conn, sent);
+        recordSent(conn, sent);
+        if (result != FlushResult::kBlocked) {
+            closeConnection(conn);
+        } else {
+            updateInterest(conn);
+        }
+    });
+
+    const auto deadline = std::chrono::steady_clock::now() + config_.write_timeout;
+    while (connections_.size() != 0 && std::chrono::steady_clock::now() < deadline) {
+        if (io_->wait(events_, static_cast<int>(MAX_WAIT.count())) < 0) {
+            break;
+        }
+        for (const IoEvent &event : events_) {
+            Connection *conn = ConnectionPool::isConnectionToken(event.token) ? connections_.find(event.token)
+                                                                                : nullptr;
+            if (conn == nullptr) {
+                continue;
+            }
+            std::size_t sent = 0;
+            FlushResult result = io_->flush(*conn, sent);
+            recordSent(*conn, sent);
+            if (result != FlushResult::kBlocked) {
+                closeConnection(*conn);
+            }
+        }
+    }
+}
+
+/**
+ * Worker::closeConnection
+ * 설명:
+ *   - 타이머를 취소하고 백엔드가 등록 해제와 FD 닫기를 마친 뒤 슬롯을 풀에 돌려준다.
+ *   - 백엔드가 걸린 작업의 버퍼를 정리할 수 있도록 연결 상태는 반납 전에 넘긴다.
+ *   - 프록시로 이어진 연결이면 상대를 먼저 정리한다(detachProxy). 연결 계측은 클라이언트 연결만 센다.
+ *   - 클라이언트 한도 표의 칸을 잡은 연결이면 연결 수를 내려놓는다(v1.24.0).
+ */
+void Worker::closeConnection(Connection &conn) {
+    ProxyRole role = conn.proxy.role;
+    if (role != ProxyRole::kNone) {
+        detachProxy(conn);
+    }
+    releaseClient(conn);
+    timers_.cancel(conn.timer);
+    io_->closeConnection(conn);
+    connections_.release(conn);
+    if (role != ProxyRole::kUpstream) {
+        WorkerMetrics::add(metrics_.closed, 1);
+    }
+}
+
+/**
+ * Worker::recordSent
+ * 설명:
+ *   - 송신 바이트를 계측에 더하고, 마지막 바이트까지 송신된 응답의 지연(첫 바이트 수신 ~ 마지막 바이트 송신)을
+ *     히스토그램에 기록한다. 완료된 응답이 있을 때만 시계를 읽는다.
+ */
+void Worker::recordSent(Connection &conn, std::size_t sent) {
+    if (sent == 0) {
+        return;
+    }
+    if (conn.proxy.role != ProxyRole::kUpstream) {
+        WorkerMetrics::add(metrics_.bytes_out, sent);
+    }
+    std::uint64_t sent_total = conn.output.sentTotal();
+    if (conn.in_flight.empty() || conn.in_flight.front().end_mark > sent_total) {
+        return;
+    }
+    auto done = std::chrono::steady_clock::now();
+    while (!conn.in_flight.empty() && conn.in_flight.front().end_mark <= sent_total) {
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(done - conn.in_flight.front().start);
+        metrics_.latency.record(static_cast<std::uint64_t>(elapsed.count()));
+        conn.in_flight.pop_front();
+    }
+}
+
+/**
+ * Worker::startProxy
+ * 설명:
+ *   - 헤더가 완성된 프록시 요청의 업스트림 요청 헤더를 만들고 업스트림 연결에 맡긴다.
+ *   - 보낼 업스트림 연결을 못 만들면 link.error 에 502 를 남긴다. processRequests 가 바로 오류 응답을 쓴다.
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.16.0-reverse-proxy.md
+ */
+void Worker::startProxy(Connection &conn, std::size_t route, bool has_body, bool body_waiting) {
+    const HttpRequestView &request = conn.parser.request();
+    ProxyLink &link = conn.proxy;
+    link.reset();
+    link.role = ProxyRole::kClient;
+    link.upstreams = upstreams_.get();
+    link.route = route;
+    link.keep_alive = keepAlive(request);
+    link.head_only = request.method == "HEAD";
+    link.http10 = request.version != "HTTP/1.1";
+    link.has_body = has_body;
+    char address[INET6_ADDRSTRLEN];
+    writeProxyRequest(link.head, request, peerAddress(conn.fd, address), upstreams_->defaultHost(route));
+    if (body_waiting) {
+        // Expect 는 업스트림에 넘기지 않으므로 프록시가 본문을 받겠다고 답한다.
+        conn.output.append(CONTINUE_RESPONSE);
+    }
+    if (!dispatchUpstream(conn, false)) {
+        WorkerMetrics::add(metrics_.upstream[static_cast<std::size_t>(UpstreamLabel::kFailed)], 1);
+        link.error = 502;
+    }
+}
+
+/**
+ * Worker::dispatchUpstream
+ * 설명:
+ *   - 경로의 업스트림 서버를 고르고 유휴 연결(fresh 면 새 연결)에 요청 헤더를 넣는다.
+ *   - 풀에서 꺼낸 핸들이 이미 닫힌 연결이면 다음 것을 꺼낸다.
+ * 출력:
+ *   - 요청을 맡겼으면 true, 새 연결을 만들지 못했으면 false
+ */
+bool Worker::dispatchUpstream(Connection &client, bool fresh) {
+    ProxyLink &link = client.proxy;
+    UpstreamPool &pool = *link.upstreams;
+    std::size_t server = pool.pick(link.route);
+    Connection *up = nullptr;
+    bool reused = false;
+    if (!fresh) {
+        while (std::uint64_t handle = pool.takeIdle(server)) {
+            up = connections_.find(handle);
+            if (up != nullptr) {
+                reused = true;
+                break;
+            }
+        }
+    }
+    if (up == nullptr) {
+        up = connectUpstream(pool, server);
+        if (up == nullptr) {
+            return false;
+        }
+    }
+
+    ProxyLink &upstream = up->proxy;
+    upstream.peer = client.handle;
+    upstream.reused = reused;
+    upstream.received = false;
+    upstream.reading_body = false;
+    upstream.scan = 0;
+    upstream.stalled = false;
+    link.peer = up->handle;
+    pool.started(server);
+    up->output.append(link.head);
+    WorkerMetrics::add(metrics_.upstream[static_cast<std::size_t>(reused ? UpstreamLabel::kReused
+                                                                           : UpstreamLabel::kConnected)],
+                       1);
+    deferred_.push_back(up->handle);
+    return true;
+}
+
+/**
+ * Worker::connectUpstream
+ * 설명:
+ *   - 업스트림 서버에 논블로킹 connect 를 걸고 연결 슬롯을 받아 백엔드에 등록한다.
+ *     연결이 맺어지기 전에 쌓은 요청은 쓰기 가능해질 때 flush 가 보낸다.
+ *   - pool 은 요청을 시작할 때의 풀이다. 연결은 끝까지 이 풀에 속한다(v1.25.0).
+ * 출력:
+ *   - 등록한 연결, 소켓/connect/등록 실패 시 nullptr
+ */
+Connection *Worker::connectUpstream(UpstreamPool &pool, std::size_t server) {
+    int fd = ::socket(pool.family(server), SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        std::cerr << "업스트림 소켓 생성 실패: " << std::strerror(errno) << std::endl;
+        return nullptr;
+    }
+    int one = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    if (::connect(fd, pool.address(server), pool.addressLength(server)) != 0 && errno != EINPROGRESS) {
+        std::cerr << "업스트림 연결 실패 (" << pool.name(server) << "): " << std::strerror(errno) << std::endl;
+        ::close(fd);
+        return nullptr;
+    }
+
+    Connection &conn = connections_.acquire(fd);
+    if (!io_->addConnection(conn)) {
+        std::cerr << "업스트림 연결 등록 실패: " << std::strerror(errno) << std::endl;
+        connections_.release(conn);
+        ::close(fd);
+        return nullptr;
+    }
+    conn.proxy.role = ProxyRole::kUpstream;
+    conn.proxy.upstreams = &pool;
+    conn.proxy.server = server;
+    return &conn;
+}
+
+/**
+ * Worker::forwardBody
+ * 설명:
+ *   - 클라이언트 요청 본문을 틀(청크 크기 줄, 트레일러) 그대로 업스트림 출력 큐로 옮긴다.
+ *     디코더는 본문 끝과 제한만 확인한다.
+ *   - 업스트림 출력 큐가 차 있으면 멈추고(stalled) 업스트림이 비울 때까지 클라이언트에서 읽지 않는다.
+ *   - 형식 오류/제한 초과면 업스트림 연결을 닫고 400/413 을 남긴다.
+ * 출력:
+ *   - readBody 와 같다. 오류 응답을 쓸 차례면 true
+ */
+bool Worker::forwardBody(Connection &conn) {
+    ProxyLink &link = conn.proxy;
+    Connection *up = link.peer != 0 ? connections_.find(link.peer) : nullptr;
+    if (up == nullptr) {
+        if (link.error != 0) {
+            return true;
+        }
+        conn.body.decoder.reset();
+        conn.should_close = true;
+        return false;
+    }
+
+    bool forwarded = false;
+    BodyStatus status = BodyStatus::kNeedMore;
+    while (true) {
+        if (up->io.send_armed || up->output.bytes() >= OUTPUT_HIGH_WATER) {
+            link.stalled = true;
+            status = BodyStatus::kNeedMore;
+            break;
+        }
+        std::size_t consumed = 0;
+        std::string_view slice;
+        status = conn.body.decoder.next(conn.input.data(), conn.input.size(), consumed, slice);
+        if (consumed > 0) {
+            up->output.append(std::string_view(conn.input.data(), consumed));
+            conn.input.consume(consumed);
+            forwarded = true;
+        }
+        if (status != BodyStatus::kSlice) {
+            break;
+        }
+    }
+    if (forwarded) {
+        deferred_.push_back(up->handle);
+    }
+
+    switch (status) {
+        case BodyStatus::kDone:
+            return true;
+        case BodyStatus::kSlice:
+        case BodyStatus::kNeedMore:
+            return false;
+        case BodyStatus::kTooLarge:
+        case BodyStatus::kError:
+            break;
+    }
+    // 업스트림은 본문이 끊긴 요청을 받았으므로 다시 쓸 수 없다. 클라이언트 본문의 남은 경계도 믿을 수 없다.
+    conn.body.decoder.reset();
+    link.keep_alive = false;
+    link.error = status == BodyStatus::kTooLarge ? 413 : 400;
+    unlinkProxy(conn, *up);
+    closeConnection(*up);
+    return true;
+}
+
+/**
+ * Worker::relayResponse
+ * 설명:
+ *   - 업스트림 입력에서 응답 헤더를 읽어 다시 쓴 뒤 클라이언트 출력 큐에 넣고, 본문을 받는 대로 옮긴다.
+ *     1xx 중간 응답은 버린다. 본문은 Content-Length/chunked 면 디코더로 끝을 찾고, 길이 헤더가 없으면
+ *     업스트림이 닫을 때까지 옮긴다.
+ *   - 클라이언트 출력 큐가 차 있거나 송신 중(io_uring)이면 멈추고(stalled) 클라이언트가 비울 때까지 읽지 않는다.
+ *   - 형식 오류, 헤더 크기 초과, 응답 도중 종료는 업스트림 연결을 닫는다. 닫을 때 detachProxy 가 502 를 남긴다.
+ *   - 코루틴 핸들러의 fetch(capture)면 헤더를 쓰지 않고 본문을 풀어서 CoContext::upstream_body 에 모은다(v1.18.0).
+ *     클라이언트 출력 큐를 거치지 않으므로 멈추지 않고, 대신 max_body_bytes 를 넘으면 업스트림 연결을 닫는다.
+ */
+void Worker::relayResponse(Connection &up, std::chrono::steady_clock::time_point now) {
+    ProxyLink &link = up.proxy;
+    if (!up.input.empty()) {
+        link.received = true;
+    }
+    if (link.peer == 0) {
+        // 풀에서 쉬는 연결에 온 바이트는 맞는 요청이 없으므로 연결을 버린다.
+        if (!up.input.empty()) {
+            up.should_close = true;
+        }
+        return;
+    }
+    Connection *found = connections_.find(link.peer);
+    if (found == nullptr) {
+        up.should_close = true;
+        return;
+    }
+    Connection &client = *found;
+    ProxyLink &request = client.proxy;
+    std::string *captured = request.capture ? &client.co.upstream_body : nullptr;
+    auto deliver = [&client, captured](std::string_view bytes) {
+        if (captured != nullptr) {
+            captured->append(bytes.data(), bytes.size());
+        } else {
+            client.output.append(bytes);
+        }
+    };
+
+    while (!link.reading_body) {
+        ResponseHead head;
+        ParseStatus status = parseResponseHead(up.input.data(), up.input.size(), link.scan, head);
+        if (status == ParseStatus::kIncomplete) {
+            if (up.input.size() > config_.max_header_bytes || up.peer_closed) {
+                up.should_close = true;
+            }
+            return;
+        }
+        if (status == ParseStatus::kError || head.status == 101) {
+            // 프로토콜 전환(101)은 지원하지 않는다.
+            up.should_close = true;
+            return;
+        }
+        if (head.status < 200) {
+            up.input.consume(head.length);
+            link.scan = 0;
+            continue;
+        }
+        BodySpec spec;
+        ResponseFraming framing = responseFramingFor(head, request.head_only, spec);
+        if (framing == ResponseFraming::kInvalid) {
+            up.should_close = true;
+            return;
+        }
+        if (client.io.send_armed && captured == nullptr) {
+            link.stalled = true;
+            return;
+        }
+        // chunked 를 모르는 HTTP/1.0 클라이언트에는 풀어서 보내고 본문 끝을 연결 종료로 알린다.
+        link.dechunk = framing == ResponseFraming::kChunked && (request.http10 || captured != nullptr);
+        bool keep_alive =
+            request.keep_alive && framing != ResponseFraming::kUntilClose && !link.dechunk && !draining_;
+        if (captured == nullptr) {
+            writeProxyResponseHead(client.output, head, keep_alive, link.dechunk);
+        }
+        request.responded = true;
+        request.status = head.status;
+        request.keep_alive = keep_alive;
+        link.reusable = upstreamKeepsAlive(head) && framing != ResponseFraming::kUntilClose;
+        link.framing = framing;
+        up.input.consume(head.length);
+        link.scan = 0;
+        link.reading_body = true;
+        if (framing == ResponseFraming::kNone) {
+            finishProxy(up, client, now);
+            return;
+        }
+        if (framing != ResponseFraming::kUntilClose) {
+            link.decoder.start(spec, UINT64_MAX);
+        }
+        deferred_.push_back(client.handle);
+    }
+
+    bool relayed = false;
+    while (true) {
+        if (captured != nullptr) {
+            if (captured->size() > config_.max_body_bytes) {
+                up.should_close = true;
+                return;
+            }
+        } else if (client.io.send_armed || client.output.bytes() >= OUTPUT_HIGH_WATER) {
+            link.stalled = true;
+            break;
+        }
+        if (link.framing == ResponseFraming::kUntilClose) {
+            if (!up.input.empty()) {
+                deliver(std::string_view(up.input.data(), up.input.size()));
+                up.input.consume(up.input.size());
+                relayed = true;
+            }
+            if (up.peer_closed) {
+                finishProxy(up, client, now);
+                return;
+            }
+            break;
+        }
+        std::size_t consumed = 0;
+        std::string_view slice;
+        BodyStatus status = link.decoder.next(up.input.data(), up.input.size(), consumed, slice);
+        if (link.dechunk) {
+            if (status == BodyStatus::kSlice) {
+                deliver(slice);
+            }
+        } else if (consumed > 0) {
+            deliver(std::string_view(up.input.data(), consumed));
+        }
+        up.input.consume(consumed);
+        relayed = relayed || consumed > 0;
+        if (status == BodyStatus::kSlice) {
+            continue;
+        }
+        if (status == BodyStatus::kDone) {
+            finishProxy(up, client, now);
+            return;
+        }
+        if (status != BodyStatus::kNeedMore || up.peer_closed) {
+            up.should_close = true;
+        }
+        break;
+    }
+    if (relayed) {
+        deferred_.push_back(client.handle);
+    }
+}
+
+/**
+ * Worker::finishProxy
+ * 설명:
+ *   - 응답 본문 끝까지 옮긴 요청을 마무리하고 두 연결을 떼어 낸다.
+ *   - 업스트림 연결은 응답이 연결 유지를 허락하고 남은 바이트가 없으면 풀에 돌려준다. 아니면 닫는다.
+ *   - 클라이언트 본문을 다 넘기기 전에 응답이 끝났으면 남은 본문 경계를 믿을 수 없어 두 연결 모두 닫는다.
+ *   - 코루틴 핸들러의 fetch 면 응답 상태를 코루틴에 넘기고 재개하게 한다. 클라이언트 요청은 아직 끝나지 않았다(v1.18.0).
+ */
+void Worker::finishProxy(Connection &up, Connection &client, std::chrono::steady_clock::time_point now) {
+    ProxyLink &link = up.proxy;
+    bool reusable = link.reusable && up.input.empty() && up.output.empty() && !up.peer_closed && !stopping() &&
+                    !draining_;
+    if (client.proxy.capture) {
+        client.co.upstream_status = client.proxy.status;
+        unlinkProxy(client, up);
+        client.proxy.reset();
+    } else {
+        bool keep_alive = client.proxy.keep_alive;
+        int status = client.proxy.status;
+        if (client.body.decoder.active()) {
+            client.body.decoder.reset();
+            keep_alive = false;
+            reusable = false;
+        }
+        unlinkProxy(client, up);
+        client.proxy.reset();
+        finishRequest(client, RouteLabel::kProxy, status, keep_alive, now);
+    }
+    deferred_.push_back(client.handle);
+
+    link.reading_body = false;
+    link.received = false;
+    link.dechunk = false;
+    link.framing = ResponseFraming::kNone;
+    link.decoder.reset();
+    // 설정을 다시 읽어 물러난 풀의 연결은 새 풀에 섞지 않고 닫는다.
+    if (!reusable || link.upstreams != upstreams_.get() || !upstreams_->park(link.server, up.handle)) {
+        up.should_close = true;
+    }
+}
+
+/**
+ * Worker::abandonUpstream
+ * 설명:
+ *   - 요청을 맡은 업스트림 연결이 응답 없이 끝났을 때(닫힘, 타임아웃) 클라이언트를 떼어 낸다.
+ *   - 풀에서 꺼낸 연결이 응답 바이트 하나 없이 닫혔고 본문 없는 요청이면 새 연결로 한 번 다시 보낸다.
+ *     쉬는 동안 업스트림이 닫은 연결을 재사용하는 경쟁은 피할 수 없기 때문이다.
+ *   - 그 밖에는 클라이언트에 status(502/504)를 남긴다.
+ */
+void Worker::abandonUpstream(Connection &up, int status) {
+    ProxyLink &link = up.proxy;
+    Connection *client = connections_.find(link.peer);
+    if (client == nullptr) {
+        link.peer = 0;
+        link.upstreams->finished(link.server);
+        return;
+    }
+    bool retry = status == 502 && link.reused && !link.received && !client->proxy.has_body &&
+                 !client->proxy.retried && !stopping();
+    unlinkProxy(*client, up);
+    if (retry) {
+        client->proxy.retried = true;
+        WorkerMetrics::add(metrics_.upstream[static_cast<std::size_t>(UpstreamLabel::kRetried)], 1);
+        if (dispatchUpstream(*client, true)) {
+            return;
+        }
+    }
+    WorkerMetrics::add(metrics_.upstream[static_cast<std::size_t>(UpstreamLabel::kFailed)], 1);
+    client->proxy.error = status;
+    deferred_.push_back(client->handle);
+}
+
+/**
+ * Worker::replyProxyError
+ * 설명:
+ *   - 업스트림이 실패한 프록시 요청을 마무리한다. 응답 헤더를 아직 안 보냈으면 고정 응답(502/504/413/400)을 쓰고,
+ *     이미 보냈으면 본문이 끊긴 것을 연결 종료로 알린다.
+ */
+void Worker::replyProxyError(Connection &conn, std::chrono::steady_clock::time_point now) {
+    ProxyLink &link = conn.proxy;
+    int status = link.error;
+    bool keep_alive = false;
+    if (!link.responded) {
+        keep_alive = link.keep_alive && !conn.body.decoder.active();
+        conn.output.append(responses_.canned(proxyErrorReply(status), keep_alive));
+    } else {
+        status = link.status;
+    }
+    conn.body.decoder.reset();
+    link.reset();
+    finishRequest(conn, RouteLabel::kProxy, status, keep_alive, now);
+}
+
+// 두 연결의 링크를 끊는다. 멈춰 있던 쪽은 호출자가 다시 깨우거나 닫는다.
+void Worker::unlinkProxy(Connection &client, Connection &up) {
+    client.proxy.peer = 0;
+    client.proxy.stalled = false;
+    up.proxy.peer = 0;
+    up.proxy.stalled = false;
+    up.proxy.upstreams->finished(up.proxy.server);
+}
+
+/**
+ * Worker::detachProxy
+ * 설명:
+ *   - 닫히는 연결의 프록시 상대를 정리한다. 업스트림이 닫히면 클라이언트에 502 를 남기고(abandonUpstream),
+ *     클라이언트가 닫히면 응답 도중인 업스트림 연결도 닫는다. 풀에서 쉬던 업스트림은 풀에서 뺀다.
+ */
+void Worker::detachProxy(Connection &conn) {
+    ProxyLink &link = conn.proxy;
+    if (link.role == ProxyRole::kUpstream) {
+        if (link.peer != 0) {
+            abandonUpstream(conn, 502);
+        } else if (link.upstreams == upstreams_.get()) {
+            // 물러난 풀에는 쉬는 연결이 없고, 풀이 이미 지워졌을 수 있으므로 가리키는 값만 비교한다.
+            upstreams_->forget(link.server, conn.handle);
+        }
+        return;
+    }
+    if (link.peer == 0) {
+        return;
+    }
+    Connection *up = connections_.find(link.peer);
+    if (up != nullptr) {
+        unlinkProxy(conn, *up);
+        closeConnection(*up);
+    }
+}
+
+// 출력 큐를 비운 연결이 상대의 멈춤(stalled)을 푼다. 상대는 다음 지연 목록 처리에서 이어 간다.
+void Worker::wakeProxyPeer(Connection &conn) {
+    if (conn.proxy.peer == 0 || conn.io.send_armed || conn.output.bytes() > OUTPUT_LOW_WATER) {
+        return;
+    }
+    Connection *peer = connections_.find(conn.proxy.peer);
+    if (peer != nullptr && peer->proxy.stalled) {
+        peer->proxy.stalled = false;
+        deferred_.push_back(peer->handle);
+    }
+}
+
+/**
+ * Worker::startOffload
+ * 설명:
+ *   - 블로킹 핸들러 요청을 작업 스레드 풀에 맡긴다. 경로 매개변수와 응답 코딩은 지금 정해 둔다.
+ *     작업은 핸들러를 부른 뒤 결과를 이 워커의 완료 큐에 올리고, 완료 큐 콜백(completeOffload)이 워커 스레드에서 받는다.
+ *   - 모든 스레드가 바쁘고 기다리는 작업이 handler_queue 개면 줄 세우지 않고 바로 503 으로 답한다.
+ *     대기가 길어질수록 응답이 늦어질 뿐 처리량은 늘지 않으므로, 클라이언트가 빨리 물러나게 하는 편이 낫다.
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.17.0-handler-offload.md
+ */
+void Worker::startOffload(Connection &conn, RouteId route, const RouteParams &params) {
+    RequestBody &body = conn.body;
+    OffloadSlot &slot = conn.offload;
+    BlockingHandler handler = ROUTE_HANDLERS[route].blocking;
+    std::uint64_t handle = conn.handle;
+    bool queued = handlers_->trySubmit(
+        id_, [this, handle, handler, args = BlockingArgs(params)]() {
+            std::string result;
+            int status = handler(args, result);
+            completions_.post([this, handle, status, result = std::move(result)]() mutable {
+                completeOffload(handle, status, result);
+            });
+        },
+        config_.handler_queue);
+    if (!queued) {
+        WorkerMetrics::add(metrics_.offload[static_cast<std::size_t>(OffloadLabel::kRejected)], 1);
+        body.route = BodyRoute::kDiscard;
+        body.status = 503;
+        conn.output.append(responses_.canned(CannedReply::kServiceUnavailable, body.keep_alive));
+        return;
+    }
+    body.route = BodyRoute::kOffload;
+    body.status = 0;
+    slot.state = OffloadState::kRunning;
+    slot.keep_alive = body.keep_alive;
+    slot.coding = compressor_ ? negotiateCoding(conn.parser.request()) : ContentCoding::kIdentity;
+}
+
+/**
+ * Worker::completeOffload
+ * 설명:
+ *   - 완료 큐 콜백. 작업 스레드의 결과를 연결에 옮기고 지연 목록에 넣어 응답을 쓰게 한다.
+ *   - 그사이 연결이 닫혔으면(핸들 세대가 다르면) 결과를 버린다.
+ */
+void Worker::completeOffload(std::uint64_t handle, int status, std::string &result) {
+    WorkerMetrics::add(metrics_.offload[static_cast<std::size_t>(OffloadLabel::kCompleted)], 1);
+    Connection *conn = connections_.find(handle);
+    if (conn == nullptr || conn->offload.state != OffloadState::kRunning) {
+        return;
+    }
+    OffloadSlot &slot = conn->offload;
+    slot.state = OffloadState::kDone;
+    slot.status = status;
+    slot.body.swap(result);
+    deferred_.push_back(handle);
+}
+
+/**
+ * Worker::writeOffloadReply
+ * 설명:
+ *   - 돌아온 작업 결과로 응답을 쓰고 요청을 마무리한다. 200 본문은 요청 때 고른 코딩으로 압축한다.
+ */
+void Worker::writeOffloadReply(Connection &conn, std::chrono::steady_clock::time_point now) {
+    OffloadSlot &slot = conn.offload;
+    ReplyContext context{files_.get(),      config_.static_copy, registry_,
+                         responses_,        compressed_.get(),   compressor_.get(),
+                         metrics_,          response_cache_.get(), now,
+                         draining_};
+    writeBlockingReply(context, conn.output, slot.status, slot.body, slot.keep_alive, slot.coding);
+    int status = slot.status;
+    bool keep_alive = slot.keep_alive;
+    slot.reset();
+    finishRequest(conn, conn.body.label, status, keep_alive, now);
+}
+
+/**
+ * Worker::startCoroutine
+ * 설명:
+ *   - 라우트의 코루틴 프레임을 연결의 아레나에 만든다. 첫 resume 은 processRequests 의 driveCoroutine 이 부른다.
+ *     응답 코딩은 요청 헤더가 사라지기 전인 지금 정해 둔다.
+ *   - 프레임을 만들지 못하면(아레나에 이전 프레임이 남은 버그) 503 으로 답한다.
+ * 출력:
+ *   - 프레임을 만들었으면 true
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.18.0-coroutine-handlers.md
+ */
+bool Worker::startCoroutine(Connection &conn, RouteId route, const RouteParams &params) {
+    RequestBody &body = conn.body;
+    CoContext &co = conn.co;
+    co.coding = compressor_ ? negotiateCoding(conn.parser.request()) : ContentCoding::kIdentity;
+    co.frame = ROUTE_HANDLERS[route].coroutine(params, co);
+    if (co.frame == nullptr) {
+        co.reset();
+        body.route = BodyRoute::kDiscard;
+        body.status = 503;
+        conn.output.append(responses_.canned(CannedReply::kServiceUnavailable, body.keep_alive));
+        return false;
+    }
+    body.route = BodyRoute::kCoroutine;
+    body.status = 0;
+    return true;
+}
+
+/**
+ * Worker::driveCoroutine
+ * 설명:
+ *   - 코루틴이 기다리던 것이 왔으면 재개하고, 끝났으면 응답을 쓴다.
+ *     - 본문 조각: 본문을 읽는 중이면 readBody 가 조각마다 재개한다. 본문이 끝났거나 없으면 body_end 로 재개한다.
+ *     - 타이머: expireTimeouts 가 ready 를 올린 뒤에 재개한다.
+ *     - 업스트림 응답: finishProxy 가 상태를 넘긴 뒤, 또는 실패(502/504)가 남은 뒤에 재개한다.
+ * 출력:
+ *   - processRequests 가 이어서 돌아도 되면 true, 더 기다려야 하면 false
+ */
+bool Worker::driveCoroutine(Connection &conn, std::chrono::steady_clock::time_point now) {
+    CoContext &co = conn.co;
+    switch (co.wait) {
+        case CoWait::kBody:
+            if (conn.body.decoder.active()) {
+                return readBody(conn, now);
+            }
+            co.slice = std::string_view();
+            co.body_end = true;
+            break;
+        case CoWait::kTimer:
+            if (!co.ready) {
+                return false;
+            }
+            break;
+        case CoWait::kUpstream:
+            if (conn.proxy.role == ProxyRole::kClient) {
+                if (conn.proxy.error == 0) {
+                    return false;
+                }
+                co.upstream_status = conn.proxy.error;
+                co.upstream_body.clear();
+                conn.proxy.reset();
+            }
+            break;
+        case CoWait::kDone:
+            writeCoroutineReply(conn, now);
+            return true;
+        case CoWait::kNone:
+            break;
+    }
+    resumeCoroutine(conn, now);
+    return true;
+}
+
+/**
+ * Worker::resumeCoroutine
+ * 설명:
+ *   - 코루틴을 다음 CO_AWAIT/CO_RETURN 까지 돌리고, 새로 기다리는 것을 건다.
+ *     타이머는 연결의 타이머 노드를 깨울 시각에 걸고, 업스트림 요청은 프록시 연결 풀로 보낸다.
+ */
+void Worker::resumeCoroutine(Connection &conn, std::chrono::steady_clock::time_point now) {
+    CoContext &co = conn.co;
+    co.ready = false;
+    CoStep step = co.frame->resume(co);
+    co.wait = step.wait;
+    switch (step.wait) {
+        case CoWait::kBody:
+            WorkerMetrics::add(metrics_.coroutine[static_cast<std::size_t>(CoroutineLabel::kBody)], 1);
+            break;
+        case CoWait::kTimer:
+            WorkerMetrics::add(metrics_.coroutine[static_cast<std::size_t>(CoroutineLabel::kTimer)], 1);
+            timers_.schedule(conn.timer, now + std::chrono::milliseconds(step.value));
+            break;
+        case CoWait::kUpstream:
+            WorkerMetrics::add(metrics_.coroutine[static_cast<std::size_t>(CoroutineLabel::kUpstream)], 1);
+            startFetch(conn);
+            break;
+        case CoWait::kDone:
+            co.status = static_cast<int>(step.value);
+            break;
+        case CoWait::kNone:
+            break;
+    }
+}
+
+/**
+ * Worker::startFetch
+ * 설명:
+ *   - 코루틴의 CoContext::target 을 `--proxy` 업스트림에 GET 으로 보낸다. 응답은 relayResponse 가 capture 로 모은다.
+ *   - 맞는 접두사가 없으면 보내지 않고 upstream_status 0 으로 바로 재개하게 한다. 연결을 못 만들면 502 를 남긴다.
+ */
+void Worker::startFetch(Connection &conn) {
+    CoContext &co = conn.co;
+    co.upstream_status = 0;
+    co.upstream_body.clear();
+    int route = upstreams_ ? upstreams_->match(std::string_view(co.target).substr(0, co.target.find('?'))) : -1;
+    if (route < 0) {
+        return;
+    }
+    ProxyLink &link = conn.proxy;
+    link.reset();
+    link.role = ProxyRole::kClient;
+    link.upstreams = upstreams_.get();
+    link.capture = true;
+    link.route = static_cast<std::size_t>(route);
+    link.keep_alive = true;
+    char address[INET6_ADDRSTRLEN];
+    writeFetchRequest(link.head, co.target, upstreams_->defaultHost(link.route), peerAddress(conn.fd, address));
+    if (!dispatchUpstream(conn, false)) {
+        WorkerMetrics::add(metrics_.upstream[static_cast<std::size_t>(UpstreamLabel::kFailed)], 1);
+        link.error = 502;
+    }
+}
+
+/**
+ * Worker::writeCoroutineReply
+ * 설명:
+ *   - 끝난 코루틴의 상태와 본문으로 응답을 쓰고 프레임을 정리한다. 200 본문은 요청 때 고른 코딩으로 압축한다.
+ *   - 코루틴이 본문을 다 읽기 전에 답했으면 남은 본문은 다음 요청 경계를 찾기 위해 읽고 버린다.
+ */
+void Worker::writeCoroutineReply(Connection &conn, std::chrono::steady_clock::time_point now) {
+    CoContext &co = conn.co;
+    RequestBody &body = conn.body;
+    ReplyContext context{files_.get(),      config_.static_copy, registry_,
+                         responses_,        compressed_.get(),   compressor_.get(),
+                         metrics_,          response_cache_.get(), now,
+                         draining_};
+    writeBlockingReply(context, conn.output, co.status, co.body, body.keep_alive, co.coding);
+    int status = co.status;
+    co.reset();
+    if (body.decoder.active()) {
+        body.route = BodyRoute::kDiscard;
+        body.status = status;
+        return;
+    }
+    finishRequest(conn, body.label, status, body.keep_alive, now);
+}
+
+/**
+ * Worker::startHttp2
+ * 설명:
+ *   - 연결을 HTTP/2 세션으로 바꾸고 서버 SETTINGS 를 출력 큐에 넣는다. 세션 객체는 처음 한 번만 만들고
+ *     슬롯을 돌려쓰는 다음 연결이 그대로 쓴다.
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.23.0-http2.md
+ */
+void Worker::startHttp2(Connection &conn, Http2ConnectionLabel mode) {
+    if (conn.http2 == nullptr) {
+        conn.http2 = std::make_unique<Http2Session>();
+    }
+    conn.http2->start(http2Settings(), metrics_, conn.output);
+    WorkerMetrics::add(metrics_.http2_connections[static_cast<std::size_t>(mode)], 1);
+}
+
+/**
+ * Worker::upgradeHttp2
+ * 설명:
+ *   - `Upgrade: h2c` 요청에 101 로 답하고 세션을 시작한 뒤, 그 요청을 스트림 1로 처리한다.
+ *     요청 헤더는 파서 버퍼를 가리키므로 스트림 처리를 마친 뒤에 소비한다. 다음 입력은 클라이언트 프리페이스다.
+ * 출력:
+ *   - 전환했으면 true. HTTP2-Settings 값이 잘못되었으면 false 이고, 요청은 HTTP/1.1 로 처리한다.
+ */
+bool Worker::upgradeHttp2(Connection &conn, std::string_view settings, std::chrono::steady_clock::time_point now) {
+    if (conn.http2 == nullptr) {
+        conn.http2 = std::make_unique<Http2Session>();
+    }
+    Http2Stream *stream = conn.http2->startUpgrade(http2Settings(), metrics_, settings, conn.output);
+    if (stream == nullptr) {
+        return false;
+    }
+    WorkerMetrics::add(metrics_.http2_connections[static_cast<std::size_t>(Http2ConnectionLabel::kUpgrade)], 1);
+    conn.access.clearRequest();
+    beginStream(conn, *stream, conn.parser.request(), false, now);
+    conn.input.consume(conn.parser.consumed());
+    conn.parser.reset();
+    return true;
+}
+
+Http2Settings Worker::http2Settings() const {
+    return Http2Settings{config_.http2_max_streams, config_.http2_window, config_.max_header_bytes};
+}
+
+/**
+ * Worker::processHttp2
+ * 설명:
+ *   - HTTP/2 연결의 입력 프레임을 차례로 해석해 새 요청은 beginStream, 요청 본문 조각은 streamBody 로 넘긴다.
+ *     SETTINGS/PING/WINDOW_UPDATE 같은 연결 관리 프레임은 세션이 안에서 답한다.
+ *   - 작업 스레드 결과가 돌아온 스트림의 응답을 먼저 쓰고, 입력을 다 본 뒤 창이 허락하는 응답 본문을 내보낸다.
+ *   - 출력 큐가 OUTPUT_HIGH_WATER 에 닿으면 입력 해석을 멈춘다(HTTP/1.1 과 같은 백프레셔). 응답을 끝낸 스트림은
+ *     in_flight 에 넣어 마지막 바이트 송신까지의 지연을 잰다.
+ *   - 연결 오류면 GOAWAY 를 보낸 뒤 닫는다. 종료 중이면 GOAWAY 로 새 스트림을 막고 열린 스트림이 끝나면 닫는다.
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.23.0-http2.md
+ */
+void Worker::processHttp2(Connection &conn, std::chrono::steady_clock::time_point now) {
+    Http2Session &session = *conn.http2;
+    if (!session.ready().empty()) {
+        ReplyContext context{files_.get(),      config_.static_copy, registry_,
+                             responses_,        compressed_.get(),   compressor_.get(),
+                             metrics_,          response_cache_.get(), now,
+                             draining_};
+        for (std::uint32_t id : session.ready()) {
+            Http2Stream *stream = session.find(id);
+            if (stream == nullptr) {
+                // 결과를 기다리는 동안 상대가 스트림을 닫았다.
+                continue;
+            }
+            writeBlockingReply(context, h2_reply_, stream->status, stream->result, true, stream->coding);
+            stream->result.clear();
+            respondStream(conn, *stream, false);
+        }
+        session.ready().clear();
+    }
+
+    while (!conn.should_close && conn.output.bytes() < OUTPUT_HIGH_WATER) {
+        std::size_t consumed = 0;
+        Http2Event event = session.next(conn.input.data(), conn.input.size(), consumed, conn.output);
+        if (event == Http2Event::kRequest) {
+            beginStream(conn, session.stream(), session.request(), session.headersTooLarge(), now);
+        } else if (event == Http2Event::kData) {
+            // 조각은 입력 버퍼를 가리키므로 소비하기 전에 넘긴다.
+            streamBody(conn, session.stream());
+        }
+        conn.input.consume(consumed);
+        if (event == Http2Event::kError) {
+            conn.should_close = true;
+        }
+        if (event == Http2Event::kNeedMore || event == Http2Event::kError) {
+            break;
+        }
+    }
+
+    if (stopping() || draining_) {
+        session.goAway(conn.output);
+    }
+    session.flush(conn.output, OUTPUT_HIGH_WATER);
+    for (const Http2Finished &done : session.finished()) {
+        conn.in_flight.push_back(PendingResponse{done.end_mark, done.start});
+    }
+    session.finished().clear();
+    if (conn.output.bytes() >= OUTPUT_HIGH_WATER) {
+        conn.reading_paused = true;
+    }
+    if (session.closing() && session.openStreams() == 0) {
+        conn.should_close = true;
+    }
+}
+
+/**
+ * Worker::beginStream
+ * 설명:
+ *   - HTTP/2 스트림 요청 하나를 HTTP/1.1 의 beginRequest 와 같은 규칙으로 처리한다. 응답은 h2_reply_ 에
+ *     HTTP/1.1 형식으로 쓴 뒤 respondStream 이 프레임으로 옮긴다.
+ *     - 헤더 목록이 max_header_bytes 를 넘으면 431, Content-Length 가 max_body_bytes 를 넘으면 413 이다.
+ *     - 토큰 버킷이 비었거나 과부하 상태면 429/503 으로 답한다(v1.24.0). 버킷은 연결의 칸을 쓰므로 스트림이
+ *       아무리 많아도 주소 하나의 초당 요청 수는 같다.
+ *     - 블로킹 핸들러는 스트림마다 작업 스레드에 맡긴다. 결과를 기다리는 동안 다른 스트림을 계속 처리한다.
+ *     - `POST /upload` 는 본문 DATA 를 UploadDigest 로 흘려보내고 본문 끝에서 답한다.
+ *     - 프록시와 코루틴 핸들러 라우트는 연결 하나에 요청 하나를 묶는 상태(ProxyLink, CoContext)를 쓰므로
+ *       HTTP_1_1_REQUIRED 로 스트림을 닫는다. 클라이언트는 HTTP/1.1 연결로 다시 보낸다.
+ *     - 나머지는 지금 응답을 만든다. 요청 본문이 남아 있으면 응답을 끝낼 때 세션이 그만 보내라고 알린다.
+ */
+void Worker::beginStream(Connection &conn, Http2Stream &stream, const HttpRequestView &request, bool too_large,
+                         std::chrono::steady_clock::time_point now) {
+    stream.start = now;
+    if (access_log_ != nullptr) {
+        stream.access.setRequest(request.method, request.path);
+    }
+    if (too_large || (stream.expected_length >= 0 &&
+                      static_cast<std::uint64_t>(stream.expected_length) > config_.max_body_bytes)) {
+        h2_reply_.append(responses_.canned(too_large ? CannedReply::kHeaderTooLarge : CannedReply::kBodyTooLarge,
+                                           true));
+        stream.label = RouteLabel::kError;
+        stream.status = too_large ? 431 : 413;
+        respondStream(conn, stream, false);
+        return;
+    }
+    std::uint32_t retry_after = 0;
+    int shed_status = shedStatus(conn, now, retry_after);
+    if (shed_status != 0) {
+        writeShedReply(h2_reply_, shed_status, retry_after, true);
+        stream.label = RouteLabel::kError;
+        stream.status = shed_status;
+        respondStream(conn, stream, false);
+        return;
+    }
+
+    RouteMatch match;
+    matchRoute(request, routes_, match);
+    bool proxied = upstreams_ && match.status == RouteStatus::kNotFound &&
+                   upstreams_->match(request.path.substr(0, request.path.find('?'))) >= 0;
+    if (proxied || isCoroutineRequest(request, match)) {
+        conn.http2->resetStream(stream, Http2Error::kHttp11Required, conn.output);
+        return;
+    }
+    if (handlers_ != nullptr && isBlockingRequest(request, match)) {
+        startStreamOffload(conn, stream, request, match.id, match.params);
+        return;
+    }
+    if (isUploadRequest(request, match)) {
+        stream.route = BodyRoute::kUpload;
+        stream.label = RouteLabel::kUpload;
+        stream.status = 200;
+        stream.upload = UploadDigest();
+        if (stream.remote_closed) {
+            writeUploadReply(stream.upload, true, responses_.dateLine(), h2_reply_);
+            respondStream(conn, stream, false);
+        }
+        return;
+    }
+    ReplyContext context{files_.get(),      config_.static_copy, registry_,
+                         responses_,        compressed_.get(),   compressor_.get(),
+                         metrics_,          response_cache_.get(), now,
+                         draining_};
+    bool keep_alive = true;
+    stream.status = buildReply(request, match, context, h2_reply_, keep_alive, stream.label);
+    respondStream(conn, stream, request.method == "HEAD");
+}
+
+/**
+ * Worker::streamBody
+ * 설명:
+ *   - 스트림의 요청 본문 조각을 받는다. 업로드 스트림만 본문을 쓰고, 이미 답했거나 작업 스레드에 맡긴 스트림의
+ *     본문은 버린다(흐름 제어 창은 세션이 돌려준다).
+ *   - Content-Length 없이 보낸 본문이 max_body_bytes 를 넘으면 413 으로 답한다.
+ */
+void Worker::streamBody(Connection &conn, Http2Stream &stream) {
+    if (stream.route != BodyRoute::kUpload) {
+        return;
+    }
+    if (stream.received > config_.max_body_bytes) {
+        stream.route = BodyRoute::kDiscard;
+        h2_reply_.append(responses_.canned(CannedReply::kBodyTooLarge, true));
+        stream.label = RouteLabel::kError;
+        stream.status = 413;
+        respondStream(conn, stream, false);
+        return;
+    }
+    stream.upload.update(conn.http2->data());
+    if (conn.http2->dataEnd()) {
+        stream.route = BodyRoute::kDiscard;
+        writeUploadReply(stream.upload, true, responses_.dateLine(), h2_reply_);
+        respondStream(conn, stream, false);
+    }
+}
+
+/**
+ * Worker::respondStream
+ * 설명:
+ *   - h2_reply_ 에 쓴 응답을 스트림 응답으로 옮기고 요청 계측, 접근 로그, 처리 건수를 기록한다.
+ *     접근 로그의 bytes 는 HPACK 으로 줄인 헤더 블록과 본문 바이트의 합이다(프레임 헤더 제외).
+ *   - 응답을 옮기지 못하면(핸들러 응답 형식 오류) 세션이 INTERNAL_ERROR 로 스트림을 닫고 500 으로 센다.
+ */
+void Worker::respondStream(Connection &conn, Http2Stream &stream, bool head_only) {
+    if (!conn.http2->respond(stream, h2_reply_, head_only, conn.output, OUTPUT_HIGH_WATER)) {
+        stream.label = RouteLabel::kError;
+        stream.status = 500;
+    }
+    // 스트림이 이미 닫혔어도 슬롯 내용은 다음 스트림이 열릴 때까지 남아 있다.
+    metrics_.countRequest(stream.label, stream.status);
+    if (access_log_ != nullptr) {
+        sampleAccess(stream.access, conn.handle, stream.response_bytes, stream.start, stream.status);
+        stream.access.clearRequest();
+    }
+    countHandled();
+}
+
+/**
+ * Worker::startStreamOffload
+ * 설명:
+ *   - startOffload 의 HTTP/2 판. 결과는 연결 핸들과 스트림 id 로 돌아오고(completeStreamOffload), 그동안
+ *     같은 연결의 다른 스트림은 계속 처리된다. 큐가 차 있으면 이 스트림만 503 으로 답한다.
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.17.0-handler-offload.md
+ *   - design/webserv-cpp17/v1.23.0-http2.md
+ */
+void Worker::startStreamOffload(Connection &conn, Http2Stream &stream, const HttpRequestView &request, RouteId route,
+                                const RouteParams &params) {
+    BlockingHandler handler = ROUTE_HANDLERS[route].blocking;
+    std::uint64_t handle = conn.handle;
+    std::uint32_t id = stream.id;
+    stream.label = ROUTE_HANDLERS[route].label;
+    bool queued = handlers_->trySubmit(
+        id_, [this, handle, id, handler, args = BlockingArgs(params)]() {
+            std::string result;
+            int status = handler(args, result);
+            completions_.post([this, handle, id, status, result = std::move(result)]() mutable {
+                completeStreamOffload(handle, id, status, result);
+            });
+        },
+        config_.handler_queue);
+    if (!queued) {
+        WorkerMetrics::add(metrics_.offload[static_cast<std::size_t>(OffloadLabel::kRejected)], 1);
+        h2_reply_.append(responses_.canned(CannedReply::kServiceUnavailable, true));
+        stream.status = 503;
+        respondStream(conn, stream, false);
+        return;
+    }
+    stream.route = BodyRoute::kOffload;
+    stream.waiting = true;
+    stream.coding = compressor_ ? negotiateCoding(request) : ContentCoding::kIdentity;
+}
+
+/**
+ * Worker::completeStreamOffload
+ * 설명:
+ *   - 완료 큐 콜백. 결과를 스트림에 옮기고 ready 목록과 지연 목록에 넣어 processHttp2 가 응답을 쓰게 한다.
+ *   - 연결이 닫혔거나 스트림이 그사이 닫혔으면(RST_STREAM) 결과를 버린다.
+ */
+void Worker::completeStreamOffload(std::uint64_t handle, std::uint32_t id, int status, std::string &result) {
+    WorkerMetrics::add(metrics_.offload[static_cast<std::size_t>(OffloadLabel::kCompleted)], 1);
+    Connection *conn = connections_.find(handle);
+    if (conn == nullptr || !http2Active(*conn)) {
+        return;
+    }
+    Http2Stream *stream = conn->http2->find(id);
+    if (stream == nullptr || !stream->waiting) {
+        return;
+    }
+    stream->waiting = false;
+    stream->status = status;
+    stream->result.swap(result);
+    conn->http2->ready().push_back(id);
+    deferred_.push_back(handle);
+}
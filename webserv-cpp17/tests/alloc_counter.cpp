@@ -0,0 +1,126 @@
+/**
+ * [모듈] webserv-cpp17/tests/alloc_counter.cpp
+ * 설명:
+ *   - webserv 실행 파일에 함께 링크해 프로세스 전체의 힙 할당 횟수를 세는 테스트 전용 훅.
+ *   - malloc/calloc/realloc 과 모든 operator new 를 가로채 원자 카운터를 올린 뒤 glibc 할당기로 넘긴다.
+ *   - SIGUSR1 을 받으면 지금까지의 할당 횟수를 `alloc_count=N` 한 줄로 stderr 에 쓴다.
+ *     테스트는 요청 구간 앞뒤로 신호를 보내 그 사이 할당 횟수를 구한다.
+ * 버전: v1.10.0
+ * 관련 설계문서:
+ *   - design/webserv-cpp17/v1.10.0-zero-alloc-responses.md
+ * 변경 이력:
+ *   - v1.10.0: keep-alive 요청 경로 무할당 검증용 할당 카운터 추가
+ * 테스트:
+ *   - tests/test_webserv_alloc_free.sh
+ * 주의 사항:
+ *   - glibc 의 __libc_malloc 계열 심볼에 의존한다. 다른 libc 에서는 빌드하지 않는다.
+ */
+
+#include <signal.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+extern "C" {
+void *__libc_malloc(std::size_t size);
+void *__libc_calloc(std::size_t count, std::size_t size);
+void *__libc_realloc(void *pointer, std::size_t size);
+void __libc_free(void *pointer);
+}
+
+namespace {
+
+std::atomic<unsigned long> g_allocations{0};
+
+void countAllocation() { g_allocations.fetch_add(1, std::memory_order_relaxed); }
+
+void *allocateOrThrow(std::size_t size) {
+    countAllocation();
+    void *pointer = __libc_malloc(size == 0 ? 1 : size);
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void *allocateAlignedOrThrow(std::size_t size, std::align_val_t alignment) {
+    countAllocation();
+    void *pointer = nullptr;
+    if (::posix_memalign(&pointer, static_cast<std::size_t>(alignment), size == 0 ? 1 : size) != 0) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+// 신호 처리기 안에서는 write 만 쓴다(async-signal-safe).
+void reportAllocations(int) {
+    unsigned long value = g_allocations.load(std::memory_order_relaxed);
+    char line[48] = "alloc_count=";
+    char digits[24];
+    std::size_t count = 0;
+    do {
+        digits[count++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+    std::size_t length = 12;
+    while (count > 0) {
+        line[length++] = digits[--count];
+    }
+    line[length++] = '\n';
+    ssize_t ignored = ::write(STDERR_FILENO, line, length);
+    (void)ignored;
+}
+
+struct ReportOnSignal {
+    ReportOnSignal() {
+        struct sigaction action {};
+        action.sa_handler = reportAllocations;
+        action.sa_flags = SA_RESTART;
+        sigemptyset(&action.sa_mask);
+        ::sigaction(SIGUSR1, &action, nullptr);
+    }
+};
+
+ReportOnSignal g_report_on_signal;
+
+}  // namespace
+
+extern "C" {
+
+void *malloc(std::size_t size) {
+    countAllocation();
+    return __libc_malloc(size);
+}
+
+void *calloc(std::size_t count, std::size_t size) {
+    countAllocation();
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *pointer, std::size_t size) {
+    countAllocation();
+    return __libc_realloc(pointer, size);
+}
+
+void free(void *pointer) { __libc_free(pointer); }
+
+}  // extern "C"
+
+void *operator new(std::size_t size) { return allocateOrThrow(size); }
+void *operator new[](std::size_t size) { return allocateOrThrow(size); }
+void *operator new(std::size_t size, std::align_val_t alignment) { return allocateAlignedOrThrow(size, alignment); }
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+    return allocateAlignedOrThrow(size, alignment);
+}
+
+void operator delete(void *pointer) noexcept { std::free(pointer); }
+void operator delete[](void *pointer) noexcept { std::free(pointer); }
+void operator delete(void *pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete[](void *pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete(void *pointer, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete[](void *pointer, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete(void *pointer, std::size_t, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete[](void *pointer, std::size_t, std::align_val_t) noexcept { std::free(pointer); }
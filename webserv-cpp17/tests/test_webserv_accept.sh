@@ -0,0 +1,191 @@
+#!/usr/bin/env bash
+# webserv-cpp17 v1.20.0 테스트: 수락 경로 옵션을 검증한다.
+# - `--listen-backlog` 가 리슨 소켓 대기열 길이(ss 의 Send-Q)로 보이는지
+# - `--accept-batch 1` 이어도 한꺼번에 들어온 연결 300개를 빠짐없이 받아 응답하는지(엣지 트리거 재수락)와 예산 계측
+# - 파이프라이닝된 정적 파일 응답(flush 동안 TCP_CORK)이 멈춤 없이 순서대로 모두 오는지
+# - `--defer-accept-sec` 이면 아무것도 보내지 않는 연결은 수락되지 않다가 요청을 보내면 응답받는지
+# - `--tcp-fastopen`, `--tcp-nodelay off`, `--accept-batch 0` 으로도 정상 동작하는지, 잘못된 값은 거절하는지
+set -euo pipefail
+
+if [ "$#" -ne 1 ]; then
+  echo "사용법: test_webserv_accept.sh <webserv_binary>" >&2
+  exit 1
+fi
+
+binary="$1"
+port=9120
+defer_port=9121
+server_pid=""
+work_dir="$(mktemp -d)"
+
+cleanup() {
+  if [ -n "$server_pid" ] && kill -0 "$server_pid" 2>/dev/null; then
+    kill "$server_pid"
+    wait "$server_pid" || true
+  fi
+  rm -rf "$work_dir"
+}
+trap cleanup EXIT
+
+fail() {
+  echo "$1" >&2
+  exit 1
+}
+
+stop_server() {
+  kill "$server_pid"
+  wait "$server_pid" || true
+  server_pid=""
+}
+
+# 잘못된 값은 시작 전에 거절한다.
+if "$binary" "$port" --tcp-nodelay maybe 2>/dev/null; then
+  fail "--tcp-nodelay 에 on/off 가 아닌 값을 받아들였습니다"
+fi
+if "$binary" "$port" --listen-backlog 0 2>/dev/null; then
+  fail "--listen-backlog 0 을 받아들였습니다"
+fi
+
+mkdir -p "$work_dir/root"
+head -c 3000 /dev/urandom > "$work_dir/root/blob.bin"
+
+"$binary" "$port" --unlimited --workers 1 --listen-backlog 512 --accept-batch 1 --idle-timeout-ms 10000 \
+  --root "$work_dir/root" &
+server_pid=$!
+sleep 0.2
+
+if command -v ss >/dev/null 2>&1; then
+  backlog=$(ss -Hltn "sport = :$port" | awk '{print $3}' | head -n 1)
+  [ "$backlog" = 512 ] || fail "리슨 백로그가 512 가 아닙니다: $backlog"
+fi
+
+python - "$port" "$work_dir/root/blob.bin" <<'PY'
+import resource
+import selectors
+import socket
+import sys
+import time
+
+port = int(sys.argv[1])
+soft, hard = resource.getrlimit(resource.RLIMIT_NOFILE)
+resource.setrlimit(resource.RLIMIT_NOFILE, (hard, hard))
+
+# 논블로킹 connect 300개를 한꺼번에 걸어 리슨 대기열을 채운다. 서버는 이벤트마다 1개씩만 받는다.
+count = 300
+sel = selectors.DefaultSelector()
+for _ in range(count):
+    s = socket.socket()
+    s.setblocking(False)
+    s.connect_ex(("127.0.0.1", port))
+    sel.register(s, selectors.EVENT_WRITE, [False, b""])
+
+answered = 0
+deadline = time.time() + 5
+while answered < count and time.time() < deadline:
+    for key, _ in sel.select(timeout=0.1):
+        s, state = key.fileobj, key.data
+        if not state[0]:
+            s.send(b"GET /health HTTP/1.1\r\nHost: storm.test\r\n\r\n")
+            state[0] = True
+            sel.modify(s, selectors.EVENT_READ, state)
+            continue
+        chunk = s.recv(4096)
+        state[1] += chunk
+        if b"status: ok" in state[1] or not chunk:
+            if b"200 OK" in state[1]:
+                answered += 1
+            sel.unregister(s)
+            s.close()
+if answered != count:
+    sys.exit("수락 예산 1 에서 연결 %d개 중 %d개만 응답받았습니다" % (count, answered))
+
+# 파일 응답 20개를 한 번에 파이프라이닝한다. 코르크를 풀지 않으면 마지막 조각이 커널 코르크 시한(200ms)까지 묶인다.
+blob = open(sys.argv[2], "rb").read()
+with socket.create_connection(("127.0.0.1", port), timeout=5) as s:
+    s.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+    begin = time.time()
+    s.sendall(b"GET /blob.bin HTTP/1.1\r\nHost: storm.test\r\n\r\n" * 20)
+    data = b""
+    while data.count(blob) < 20:
+        chunk = s.recv(65536)
+        if not chunk:
+            break
+        data += chunk
+    elapsed = time.time() - begin
+if data.count(b"HTTP/1.1 200 OK") != 20 or data.count(blob) != 20:
+    sys.exit("파이프라이닝된 파일 응답이 모자랍니다: %d" % data.count(blob))
+if elapsed > 0.15:
+    sys.exit("파이프라이닝된 파일 응답이 늦었습니다(코르크가 풀리지 않음?): %.3fs" % elapsed)
+
+with socket.create_connection(("127.0.0.1", port), timeout=5) as s:
+    s.sendall(b"GET /metrics HTTP/1.1\r\nHost: storm.test\r\nConnection: close\r\n\r\n")
+    body = b""
+    while True:
+        chunk = s.recv(65536)
+        if not chunk:
+            break
+        body += chunk
+metrics = dict(line.split(" ", 1) for line in body.decode().splitlines() if line.startswith("webserv_accept"))
+if int(metrics.get("webserv_accept_budget_exhausted_total", "0")) == 0:
+    sys.exit("수락 예산에 걸린 횟수가 계측되지 않았습니다: %r" % metrics)
+PY
+stop_server
+
+# 수락 지연: 아무것도 보내지 않는 연결은 워커에 넘어오지 않는다.
+"$binary" "$defer_port" --unlimited --workers 1 --defer-accept-sec 5 --tcp-fastopen 16 --tcp-nodelay off \
+  --accept-batch 0 2> "$work_dir/defer.log" &
+server_pid=$!
+sleep 0.2
+
+python - "$defer_port" <<'PY'
+import socket
+import sys
+import time
+
+port = int(sys.argv[1])
+
+
+def request(sock, path, close):
+    sock.sendall(("GET %s HTTP/1.1\r\nHost: defer.test\r\n%s\r\n" % (path, "Connection: close\r\n" if close else "")).encode())
+    data = b""
+    while b"\r\n\r\n" not in data:
+        data += sock.recv(65536)
+    head, _, body = data.partition(b"\r\n\r\n")
+    length = int([l.split(b":")[1] for l in head.split(b"\r\n") if l.lower().startswith(b"content-length")][0])
+    while len(body) < length:
+        body += sock.recv(65536)
+    return head, body
+
+
+def accepted():
+    with socket.create_connection(("127.0.0.1", port), timeout=5) as s:
+        _, body = request(s, "/metrics", True)
+    for line in body.decode().splitlines():
+        if line.startswith("webserv_connections_accepted_total "):
+            return int(line.split()[1])
+    sys.exit("수락 계측이 없습니다")
+
+
+silent = socket.create_connection(("127.0.0.1", port), timeout=5)
+time.sleep(0.3)
+# 지금까지 수락된 것은 계측을 읽는 연결 하나뿐이어야 한다.
+before = accepted()
+if before != 1:
+    sys.exit("데이터를 보내지 않은 연결까지 수락되었습니다: accepted=%d" % before)
+head, body = request(silent, "/health", False)
+if not head.startswith(b"HTTP/1.1 200") or b"status: ok" not in body:
+    sys.exit("수락이 미뤄진 연결의 첫 요청 응답이 이상합니다: %r" % head)
+# keep-alive 로 한 번 더 보낸다.
+head, _ = request(silent, "/health", False)
+if not head.startswith(b"HTTP/1.1 200"):
+    sys.exit("수락이 미뤄진 연결의 두 번째 요청 응답이 이상합니다")
+silent.close()
+if accepted() != 3:
+    sys.exit("요청을 보낸 뒤에도 연결이 한 번만 수락되어야 합니다")
+PY
+
+if grep -q "설정 실패" "$work_dir/defer.log"; then
+  fail "리슨 소켓 옵션 설정이 실패했습니다: $(cat "$work_dir/defer.log")"
+fi
+
+echo "webserv v1.20.0 수락 경로 테스트 통과"
@@ -0,0 +1,256 @@
+#!/usr/bin/env bash
+# webserv-cpp17 v1.21.0 테스트: 비동기 접근 로그를 검증한다.
+# - 줄마다 시각, 워커, 연결 핸들, 메서드, 경로(이스케이프/잘림), 상태, 응답 바이트, 처리 지연이 맞게 남는지
+#   (파이프라이닝, 업로드 본문, 형식 오류 400, 코루틴 /sleep 지연, 워커 2개)
+# - `--access-log-sample 10` 이면 요청 10개 중 하나만 남는지
+# - 링이 작아(`--access-log-buffer 1`) 넘쳐도 요청은 모두 응답받고, 버린 레코드가 계측에 잡히며
+#   종료할 때 링에 남은 레코드까지 모두 쓰는지(요청 3개를 처리하고 바로 끝나는 서버도 3줄)
+# - 잘못된 옵션과 열 수 없는 로그 경로는 시작 전에 거절하는지
+set -euo pipefail
+
+if [ "$#" -ne 1 ]; then
+  echo "사용법: test_webserv_access_log.sh <webserv_binary>" >&2
+  exit 1
+fi
+
+binary="$1"
+port=9122
+sample_port=9123
+drop_port=9124
+server_pid=""
+work_dir="$(mktemp -d)"
+
+cleanup() {
+  if [ -n "$server_pid" ] && kill -0 "$server_pid" 2>/dev/null; then
+    kill "$server_pid"
+    wait "$server_pid" || true
+  fi
+  rm -rf "$work_dir"
+}
+trap cleanup EXIT
+
+fail() {
+  echo "$1" >&2
+  exit 1
+}
+
+stop_server() {
+  kill "$server_pid"
+  wait "$server_pid" || true
+  server_pid=""
+}
+
+if "$binary" "$port" --access-log-sample 0 2>/dev/null; then
+  fail "--access-log-sample 0 을 받아들였습니다"
+fi
+if "$binary" "$port" --access-log-buffer 0 2>/dev/null; then
+  fail "--access-log-buffer 0 을 받아들였습니다"
+fi
+if "$binary" "$port" --access-log "" 2>/dev/null; then
+  fail "경로 없는 --access-log 를 받아들였습니다"
+fi
+if "$binary" "$port" 1 --access-log "$work_dir/missing/access.log" 2> "$work_dir/open.log"; then
+  fail "열 수 없는 접근 로그 경로로 서버가 떴습니다"
+fi
+grep -q "접근 로그 파일 열기 실패" "$work_dir/open.log" || fail "로그 파일 열기 실패를 알리지 않았습니다"
+
+# 공용 클라이언트 도우미. 응답 하나의 헤더+본문 바이트를 그대로 돌려준다.
+cat > "$work_dir/client.py" <<'PY'
+import re
+import socket
+import time
+
+
+def read_response(sock, pending):
+    while b"\r\n\r\n" not in pending:
+        chunk = sock.recv(65536)
+        if not chunk:
+            raise SystemExit("응답 도중 연결이 닫혔습니다: %r" % pending)
+        pending += chunk
+    head, _, rest = pending.partition(b"\r\n\r\n")
+    length = int(re.search(rb"Content-Length: (\d+)", head, re.I).group(1))
+    while len(rest) < length:
+        rest += sock.recv(65536)
+    return head + b"\r\n\r\n" + rest[:length], rest[length:]
+
+
+def exchange(port, payload, count):
+    with socket.create_connection(("127.0.0.1", port), timeout=5) as sock:
+        sock.sendall(payload)
+        responses, pending = [], b""
+        for _ in range(count):
+            response, pending = read_response(sock, pending)
+            responses.append(response)
+        return responses
+
+
+def access_counts(port):
+    body = exchange(port, b"GET /metrics HTTP/1.1\r\nHost: log.test\r\nConnection: close\r\n\r\n", 1)[0].decode()
+    counts = {}
+    for line in body.splitlines():
+        match = re.match(r'webserv_access_log_records_total\{result="(\w+)"\} (\d+)$', line)
+        if match:
+            counts[match.group(1)] = int(match.group(2))
+    if set(counts) != {"queued", "dropped"}:
+        raise SystemExit("접근 로그 계측이 없습니다: %r" % counts)
+    return counts
+
+
+def log_lines(path, count, timeout=3.0):
+    deadline = time.time() + timeout
+    lines = []
+    while time.time() < deadline:
+        lines = open(path).read().splitlines()
+        if len(lines) >= count:
+            break
+        time.sleep(0.02)
+    return lines
+PY
+
+# 1) 필드: 워커 2개, 기본 표본(모든 요청)
+"$binary" "$port" --unlimited --workers 2 --demo-routes --access-log "$work_dir/access.log" &
+server_pid=$!
+sleep 0.2
+
+PYTHONPATH="$work_dir" python - "$port" "$work_dir/access.log" <<'PY'
+import re
+import socket
+import sys
+import time
+
+from client import exchange, log_lines
+
+port, path = int(sys.argv[1]), sys.argv[2]
+begin = time.time()
+
+LINE = re.compile(r'^(\d{4}-\d\d-\d\dT\d\d:\d\d:\d\d)\.\d{6}Z worker=(\d+) conn=(\d+) method=(\S+) path=(\S+) '
+                  r'status=(\d+) bytes=(\d+) latency_us=(\d+)$')
+
+# 한 연결에 파이프라이닝: /health, 따옴표와 역슬래시가 든 질의, 본문 있는 업로드
+pipelined = exchange(port, b"GET /health HTTP/1.1\r\nHost: log.test\r\n\r\n"
+                           b"GET /q?a=\"b\"&c=\\ HTTP/1.1\r\nHost: log.test\r\n\r\n"
+                           b"POST /upload HTTP/1.1\r\nHost: log.test\r\nContent-Length: 5\r\n\r\nhello", 3)
+long_path = "/" + "a" * 200
+long_reply = exchange(port, ("GET %s HTTP/1.1\r\nHost: log.test\r\nConnection: close\r\n\r\n" % long_path).encode(), 1)
+sleep_reply = exchange(port, b"GET /sleep/50 HTTP/1.1\r\nHost: log.test\r\nConnection: close\r\n\r\n", 1)
+with socket.create_connection(("127.0.0.1", port), timeout=5) as sock:
+    sock.sendall(b"GARBAGE\r\n\r\n")
+    malformed = b""
+    while True:
+        chunk = sock.recv(65536)
+        if not chunk:
+            break
+        malformed += chunk
+
+lines = log_lines(path, 6)
+if len(lines) != 6:
+    sys.exit("접근 로그 줄 수가 6 이 아닙니다: %r" % lines)
+records = []
+for line in lines:
+    match = LINE.match(line)
+    if not match:
+        sys.exit("접근 로그 형식이 다릅니다: %r" % line)
+    stamp, worker, conn, method, target, status, size, latency = match.groups()
+    when = time.mktime(time.strptime(stamp, "%Y-%m-%dT%H:%M:%S")) - time.timezone
+    if abs(when - begin) > 5:
+        sys.exit("접근 로그 시각이 UTC 현재 시각과 다릅니다: %r" % line)
+    if worker not in ("0", "1"):
+        sys.exit("워커 번호가 이상합니다: %r" % line)
+    # 연결 풀은 워커마다 따로라 핸들은 워커 안에서만 유일하다.
+    records.append(((worker, conn), method, target, int(status), int(size), int(latency)))
+
+by_target = {record[2]: record for record in records}
+expected = [
+    ('"/health"', "GET", 200, pipelined[0]),
+    ('"/q?a=\\x22b\\x22&c=\\x5c"', "GET", 200, pipelined[1]),
+    ('"/upload"', "POST", 200, pipelined[2]),
+    ('"/' + "a" * 79 + '..."', "GET", 200, long_reply[0]),
+    ('"/sleep/50"', "GET", 200, sleep_reply[0]),
+    ("-", "-", 400, malformed),
+]
+for target, method, status, response in expected:
+    record = by_target.get(target)
+    if record is None:
+        sys.exit("경로 %s 레코드가 없습니다: %r" % (target, lines))
+    if record[1] != method or record[3] != status:
+        sys.exit("메서드/상태가 다릅니다: %r" % (record,))
+    if record[4] != len(response):
+        sys.exit("응답 바이트가 다릅니다(%d != %d): %r" % (record[4], len(response), record))
+pipelined_conns = {by_target[t][0] for t in ('"/health"', '"/q?a=\\x22b\\x22&c=\\x5c"', '"/upload"')}
+if len(pipelined_conns) != 1 or by_target['"/sleep/50"'][0] in pipelined_conns:
+    sys.exit("연결 핸들이 연결마다 구분되지 않습니다: %r" % records)
+if not 50000 <= by_target['"/sleep/50"'][5] < 2000000:
+    sys.exit("/sleep/50 의 처리 지연이 50ms 근처가 아닙니다: %r" % (by_target['"/sleep/50"'],))
+PY
+stop_server
+
+# 2) 표본 추출: 요청 10개 중 하나
+"$binary" "$sample_port" --unlimited --workers 1 --access-log "$work_dir/sample.log" --access-log-sample 10 &
+server_pid=$!
+sleep 0.2
+
+PYTHONPATH="$work_dir" python - "$sample_port" "$work_dir/sample.log" <<'PY'
+import sys
+
+from client import access_counts, exchange, log_lines
+
+port, path = int(sys.argv[1]), sys.argv[2]
+exchange(port, b"GET /health HTTP/1.1\r\nHost: log.test\r\n\r\n" * 100, 100)
+queued = access_counts(port)["queued"]
+if queued != 10:
+    sys.exit("표본 간격 10 에서 요청 100개 중 %d개를 남겼습니다" % queued)
+# 101번째 요청인 /metrics 자신도 표본에 든다. 계측은 그 레코드를 넣기 전에 만들어졌다.
+lines = [line for line in log_lines(path, 11) if 'path="/metrics"' not in line]
+if len(lines) != 10 or any('path="/health"' not in line for line in lines):
+    sys.exit("표본 로그가 다릅니다: %r" % lines)
+PY
+stop_server
+
+# 3) 링이 넘칠 때: 요청은 모두 응답받고, 버린 수를 세며, 종료 시 남은 레코드까지 쓴다.
+#    요청 2000개 + /metrics 1개를 처리하면 서버가 스스로 끝난다.
+"$binary" "$drop_port" 2001 --max-runtime-sec 0 --workers 1 --access-log "$work_dir/drop.log" \
+  --access-log-buffer 1 &
+server_pid=$!
+sleep 0.2
+
+PYTHONPATH="$work_dir" python - "$drop_port" > "$work_dir/drop.out" <<'PY'
+import sys
+
+from client import access_counts, exchange
+
+port = int(sys.argv[1])
+replies = exchange(port, b"GET /health HTTP/1.1\r\nHost: log.test\r\n\r\n" * 2000, 2000)
+if len(replies) != 2000:
+    sys.exit("링이 넘치는 동안 응답을 잃었습니다")
+counts = access_counts(port)
+queued, dropped = counts["queued"], counts["dropped"]
+if queued + dropped != 2000 or dropped == 0:
+    sys.exit("넣은 레코드 %d + 버린 레코드 %d 가 맞지 않습니다" % (queued, dropped))
+print(queued)
+PY
+wait "$server_pid"
+server_pid=""
+queued=$(cat "$work_dir/drop.out")
+lines=$(wc -l < "$work_dir/drop.log")
+# /metrics 요청 자신의 레코드는 계측에 들어가기 전이라 하나 더 있을 수 있다.
+if [ "$lines" -ne "$queued" ] && [ "$lines" -ne $((queued + 1)) ]; then
+  fail "종료 후 접근 로그 줄 수($lines)가 링에 넣은 레코드 수($queued)와 맞지 않습니다"
+fi
+
+# 4) 종료 직전에 넣은 레코드: 요청 3개를 처리하고 바로 끝나는 서버도 3줄을 모두 남긴다.
+"$binary" "$drop_port" 3 --workers 1 --access-log "$work_dir/exit.log" &
+server_pid=$!
+sleep 0.2
+PYTHONPATH="$work_dir" python - "$drop_port" <<'PY'
+import sys
+
+from client import exchange
+
+exchange(int(sys.argv[1]), b"GET /health HTTP/1.1\r\nHost: log.test\r\n\r\n" * 3, 3)
+PY
+wait "$server_pid"
+server_pid=""
+lines=$(wc -l < "$work_dir/exit.log")
+[ "$lines" -eq 3 ] || fail "종료 직전 레코드를 잃었습니다: $lines 줄"
+
+echo "webserv v1.21.0 접근 로그 테스트 통과"
@@ -0,0 +1,149 @@
+#!/usr/bin/env bash
+# webserv-cpp17 v1.10.0 테스트: 할당 카운터를 링크한 webserv 로 keep-alive 요청 경로가 요청마다 힙 할당을
+# 하지 않는지 검증한다. /health(미리 만든 응답), 기본 응답(직접 직렬화), 405/404 오류, 캐시된 정적 파일,
+# 파이프라이닝 묶음을 워밍업한 뒤 같은 요청 수천 개 동안 할당 횟수가 0 인지 본다. Date 헤더 형식도 확인한다.
+# v1.18.0: 코루틴 핸들러(/sleep/0, POST /upload/echo)도 프레임을 연결의 아레나에 만들므로 요청마다 할당하지 않는다.
+# v1.21.0: 접근 로그를 켜도 레코드는 연결 슬롯과 미리 잡은 링에 복사되고, 기록 스레드도 버퍼를 재사용하므로 할당하지 않는다.
+set -euo pipefail
+
+if [ "$#" -ne 1 ]; then
+  echo "사용법: test_webserv_alloc_free.sh <webserv_alloc_probe_binary>" >&2
+  exit 1
+fi
+
+binary="$1"
+port=9103
+root_dir="$(mktemp -d)"
+log_file="$(mktemp)"
+access_log="$(mktemp)"
+server_pid=""
+
+printf '<h1>webserv static</h1>\n' > "$root_dir/index.html"
+
+cleanup() {
+  if [ -n "$server_pid" ] && kill -0 "$server_pid" 2>/dev/null; then
+    kill "$server_pid"
+    wait "$server_pid" || true
+  fi
+  rm -rf "$root_dir" "$log_file" "$access_log"
+}
+trap cleanup EXIT
+
+# mode: plain(문서 루트 없음) 또는 static(--root)
+run_probe() {
+  local mode="$1"
+  shift
+  : > "$log_file"
+  "$binary" "$port" 100000000 --idle-timeout-ms 10000 --max-runtime-sec 60 --demo-routes "$@" 2> "$log_file" &
+  server_pid=$!
+  sleep 0.2
+
+  python - "$mode" "$server_pid" "$log_file" <<PY
+import os
+import re
+import signal
+import socket
+import sys
+import time
+
+mode, pid, log_file = sys.argv[1], int(sys.argv[2]), sys.argv[3]
+
+def fail(message):
+    print(f"[{mode}] {message}", file=sys.stderr)
+    sys.exit(1)
+
+DATE = re.compile(rb"\r\nDate: (Mon|Tue|Wed|Thu|Fri|Sat|Sun), \d\d "
+                  rb"(Jan|Feb|Mar|Apr|May|Jun|Jul|Aug|Sep|Oct|Nov|Dec) \d{4} \d\d:\d\d:\d\d GMT\r\n")
+
+s = socket.create_connection(("127.0.0.1", ${port}), timeout=5)
+s.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+pending = b""
+
+def read_response():
+    global pending
+    while b"\r\n\r\n" not in pending:
+        chunk = s.recv(65536)
+        if not chunk:
+            fail("응답 도중 연결이 닫혔습니다.")
+        pending += chunk
+    head, _, rest = pending.partition(b"\r\n\r\n")
+    length = int(re.search(rb"Content-Length: (\d+)", head).group(1))
+    while len(rest) < length:
+        chunk = s.recv(65536)
+        if not chunk:
+            fail("본문 도중 연결이 닫혔습니다.")
+        rest += chunk
+    pending = rest[length:]
+    return head + b"\r\n\r\n", rest[:length]
+
+def roundtrip(request, status, body=None, count=1):
+    s.sendall(request * count)
+    for _ in range(count):
+        head, payload = read_response()
+        if not head.startswith(b"HTTP/1.1 " + status):
+            fail(f"상태가 다릅니다: {head!r}")
+        if b"Connection: keep-alive" not in head:
+            fail(f"keep-alive 응답이 아닙니다: {head!r}")
+        if not DATE.search(head):
+            fail(f"Date 헤더 형식이 잘못되었습니다: {head!r}")
+        if body is not None and payload != body:
+            fail(f"본문이 다릅니다: {payload!r}")
+
+if mode == "plain":
+    scenario = [
+        (b"GET /health HTTP/1.1\r\nHost: probe\r\n\r\n", b"200", b"status: ok\n", 1),
+        (b"GET / HTTP/1.1\r\nHost: alloc-probe.example\r\n\r\n", b"200",
+         b"Hello from webserv v0.4.0\nHost: alloc-probe.example\nConnection: keep-alive\n", 1),
+        (b"POST /health HTTP/1.1\r\nHost: probe\r\n\r\n", b"405", b"Method not allowed\n", 1),
+        (b"GET /sleep/0 HTTP/1.1\r\nHost: probe\r\n\r\n", b"200", b"slept: 0 ms\n", 1),
+        (b"POST /upload/echo HTTP/1.1\r\nHost: probe\r\nContent-Length: 5\r\n\r\nhello", b"200", b"hello", 1),
+        (b"GET /health HTTP/1.1\r\nHost: probe\r\n\r\n", b"200", b"status: ok\n", 16),
+    ]
+else:
+    scenario = [
+        (b"GET /health HTTP/1.1\r\nHost: probe\r\n\r\n", b"200", b"status: ok\n", 1),
+        (b"GET /index.html HTTP/1.1\r\nHost: probe\r\n\r\n", b"200", b"<h1>webserv static</h1>\n", 1),
+        (b"GET /missing.txt HTTP/1.1\r\nHost: probe\r\n\r\n", b"404", b"Not found\n", 1),
+        (b"GET /index.html HTTP/1.1\r\nHost: probe\r\n\r\n", b"200", b"<h1>webserv static</h1>\n", 16),
+    ]
+
+def run(rounds):
+    requests = 0
+    for _ in range(rounds):
+        for request, status, body, count in scenario:
+            roundtrip(request, status, body, count)
+            requests += count
+    return requests
+
+def allocations():
+    before = open(log_file, "rb").read().count(b"alloc_count=")
+    os.kill(pid, signal.SIGUSR1)
+    deadline = time.time() + 2
+    while time.time() < deadline:
+        found = re.findall(rb"alloc_count=(\d+)", open(log_file, "rb").read())
+        if len(found) > before:
+            return int(found[-1])
+        time.sleep(0.01)
+    fail("할당 카운터 출력이 없습니다.")
+
+# 버퍼/링/캐시 용량이 자리 잡도록 먼저 돌린다.
+run(50)
+before = allocations()
+requests = run(300)
+after = allocations()
+print(f"[{mode}] keep-alive 요청 {requests}개 동안 힙 할당 {after - before}회")
+if after != before:
+    fail(f"요청 경로에서 힙 할당이 {after - before}회 일어났습니다.")
+PY
+
+  kill "$server_pid"
+  wait "$server_pid" || true
+  server_pid=""
+}
+
+run_probe plain
+run_probe static --root "$root_dir"
+run_probe plain --access-log "$access_log"
+[ -s "$access_log" ] || { echo "접근 로그가 비어 있습니다" >&2; exit 1; }
+
+echo "keep-alive 요청 경로 무할당 테스트 통과"
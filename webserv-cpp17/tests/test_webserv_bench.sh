@@ -0,0 +1,103 @@
+#!/usr/bin/env bash
+# webserv-cpp17 v1.19.0 테스트: 부하 생성기(webserv_bench)와 서버의 --unlimited 플래그를 검증한다.
+# - --unlimited 면 위치 인자 요청 수(3)와 --max-runtime-sec 1 을 줘도 서버가 끝나지 않는지
+# - 폐쇄 루프(연결 16개, 파이프라이닝 4)가 오류 없이 응답을 세고 요약 줄을 내는지
+# - 고정 속도 모드가 요청한 속도만큼만 보내는지
+# - 느린 경로에서 고정 속도 모드의 지연이 보내야 했던 시각부터 재어져(coordinated omission 보정) 폐쇄 루프보다 크게 나오는지
+# - 2xx 가 아닌 응답, 서버가 닫는 연결(Connection: close)의 재연결, 닫힌 포트의 연결 오류를 구분해 세는지
+set -euo pipefail
+
+if [ "$#" -ne 2 ]; then
+  echo "사용법: test_webserv_bench.sh <webserv_binary> <webserv_bench_binary>" >&2
+  exit 1
+fi
+
+binary="$1"
+bench="$2"
+port=9118
+closed_port=9119
+server_pid=""
+work_dir="$(mktemp -d)"
+
+cleanup() {
+  if [ -n "$server_pid" ] && kill -0 "$server_pid" 2>/dev/null; then
+    kill "$server_pid"
+    wait "$server_pid" || true
+  fi
+  rm -rf "$work_dir"
+}
+trap cleanup EXIT
+
+fail() {
+  echo "$1" >&2
+  exit 1
+}
+
+# summary 줄에서 key=value 하나를 꺼낸다.
+field() {
+  grep '^summary ' "$1" | tr ' ' '\n' | grep "^$2=" | cut -d= -f2
+}
+
+"$binary" "$port" 3 --max-runtime-sec 1 --workers 1 --unlimited --demo-routes &
+server_pid=$!
+started=$(date +%s%N)
+sleep 0.2
+
+# 폐쇄 루프
+"$bench" --threads 2 --connections 16 --pipeline 4 --duration-sec 1 --warmup-sec 0 "127.0.0.1:$port" \
+  > "$work_dir/closed.log" || { cat "$work_dir/closed.log" >&2; fail "폐쇄 루프 부하가 실패했습니다"; }
+requests=$(field "$work_dir/closed.log" requests)
+[ "$requests" -gt 1000 ] || fail "폐쇄 루프 응답 수가 너무 적습니다: $requests"
+[ "$(field "$work_dir/closed.log" errors)" = 0 ] || fail "폐쇄 루프에 오류가 있습니다: $(cat "$work_dir/closed.log")"
+[ "$(field "$work_dir/closed.log" non2xx)" = 0 ] || fail "/health 가 2xx 가 아닙니다: $(cat "$work_dir/closed.log")"
+grep -q "99.2187" "$work_dir/closed.log" || fail "백분위 분포가 없습니다: $(cat "$work_dir/closed.log")"
+
+# 고정 속도: 초당 2000개
+"$bench" --threads 2 --connections 8 --rate 2000 --duration-sec 1 --warmup-sec 0 "127.0.0.1:$port" \
+  > "$work_dir/rate.log" || fail "고정 속도 부하가 실패했습니다"
+requests=$(field "$work_dir/rate.log" requests)
+if [ "$requests" -lt 1700 ] || [ "$requests" -gt 2200 ]; then
+  fail "고정 속도 2000 req/s 에서 1초 동안 응답 수가 이상합니다: $requests"
+fi
+[ "$(field "$work_dir/rate.log" mode)" = rate ] || fail "고정 속도 모드 요약이 아닙니다"
+
+# 느린 경로(50ms): 폐쇄 루프는 응답 시간만, 고정 속도(200 req/s, 연결 1개)는 밀린 대기 시간까지 잰다.
+"$bench" --threads 1 --connections 1 --duration-sec 1 --warmup-sec 0 --path /sleep/50 "127.0.0.1:$port" \
+  > "$work_dir/slow_closed.log" || fail "느린 경로 폐쇄 루프가 실패했습니다"
+"$bench" --threads 1 --connections 1 --rate 200 --duration-sec 1 --warmup-sec 0 --path /sleep/50 "127.0.0.1:$port" \
+  > "$work_dir/slow_rate.log" || fail "느린 경로 고정 속도가 실패했습니다"
+python - "$work_dir/slow_closed.log" "$work_dir/slow_rate.log" <<'PY'
+import sys
+def p99(path):
+    line = [l for l in open(path) if l.startswith("summary ")][0]
+    return float(dict(item.split("=") for item in line.split()[1:])["p99_us"])
+closed, rated = p99(sys.argv[1]), p99(sys.argv[2])
+if not 45000 < closed < 200000:
+    sys.exit("폐쇄 루프 p99 가 응답 시간(50ms)과 다릅니다: %.0f us" % closed)
+if rated < 500000:
+    sys.exit("고정 속도 p99 가 밀린 대기 시간을 반영하지 않습니다: %.0f us (폐쇄 루프 %.0f us)" % (rated, closed))
+PY
+
+# 2xx 가 아닌 응답과 서버가 닫는 연결
+"$bench" --threads 1 --connections 2 --duration-sec 1 --warmup-sec 0 --path /sleep/soon "127.0.0.1:$port" \
+  > "$work_dir/missing.log" || fail "404 경로 부하가 실패했습니다"
+[ "$(field "$work_dir/missing.log" non2xx)" = "$(field "$work_dir/missing.log" requests)" ] \
+  || fail "404 응답을 2xx 가 아닌 응답으로 세지 않았습니다: $(cat "$work_dir/missing.log")"
+"$bench" --threads 1 --connections 2 --duration-sec 1 --warmup-sec 0 --header "Connection: close" \
+  "127.0.0.1:$port" > "$work_dir/close.log" || fail "Connection: close 부하가 실패했습니다"
+[ "$(field "$work_dir/close.log" errors)" = 0 ] || fail "Connection: close 에서 오류가 났습니다: $(cat "$work_dir/close.log")"
+grep -q "서버 종료 후 재연결 [1-9]" "$work_dir/close.log" || fail "닫힌 연결을 다시 열지 않았습니다: $(cat "$work_dir/close.log")"
+
+# 닫힌 포트: 응답이 없으면 실패로 끝나고 연결 오류를 센다.
+if "$bench" --threads 1 --connections 1 --duration-sec 1 --warmup-sec 0 "127.0.0.1:$closed_port" \
+  > "$work_dir/refused.log"; then
+  fail "응답이 하나도 없는데 성공으로 끝났습니다"
+fi
+grep -q "오류 연결 [1-9]" "$work_dir/refused.log" || fail "연결 오류를 세지 않았습니다: $(cat "$work_dir/refused.log")"
+
+# 위치 인자 3건과 --max-runtime-sec 1 을 훨씬 넘겼어도 서버가 살아 있어야 한다.
+elapsed_ms=$(( ($(date +%s%N) - started) / 1000000 ))
+[ "$elapsed_ms" -gt 2000 ] || fail "런타임 제한을 확인하기에 시간이 짧습니다: ${elapsed_ms}ms"
+kill -0 "$server_pid" 2>/dev/null || fail "--unlimited 인데 서버가 끝났습니다"
+
+echo "webserv v1.19.0 부하 생성기 테스트 통과"
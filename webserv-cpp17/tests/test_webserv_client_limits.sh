@@ -0,0 +1,337 @@
+#!/usr/bin/env bash
+# webserv-cpp17 v1.24.0 테스트: 클라이언트 주소별 한도와 과부하 거절을 검증한다.
+# - `--client-rate/--client-burst`: 버킷을 다 쓰면 429 와 Retry-After 로 답하고 연결은 유지하는지, 다른 주소
+#   (127.0.0.2)는 따로 세는지, 워커 2개에 나뉜 같은 주소의 연결들이 버킷 하나를 나눠 쓰는지, 시간이 지나면
+#   다시 받는지, 한 HTTP/2 연결의 스트림들도 같은 버킷을 쓰는지
+# - `--client-connections`: 한도를 넘는 연결은 요청 전에 닫히고, 다른 주소는 받으며, 연결을 닫으면 자리가 나는지
+# - `--overload-lag-ms`: 루프가 밀린(큰 텍스트 파일을 워커에서 바로 미리 압축) 직후 도착한 요청은 503 과
+#   Retry-After: 1 을 받고, 루프가 풀리면 다시 200 인지
+# - 계측(webserv_shed_total{reason}, code="429", webserv_overload_entered_total, webserv_overloaded_workers)
+# - 잘못된 옵션은 시작 전에 거절하는지
+set -euo pipefail
+
+if [ "$#" -ne 1 ]; then
+  echo "사용법: test_webserv_client_limits.sh <webserv_binary>" >&2
+  exit 1
+fi
+
+binary="$1"
+rate_port=9130
+conn_port=9131
+overload_port=9132
+server_pid=""
+work_dir="$(mktemp -d)"
+
+cleanup() {
+  if [ -n "$server_pid" ] && kill -0 "$server_pid" 2>/dev/null; then
+    kill "$server_pid"
+    wait "$server_pid" || true
+  fi
+  rm -rf "$work_dir"
+}
+trap cleanup EXIT
+
+fail() {
+  echo "$1" >&2
+  exit 1
+}
+
+stop_server() {
+  kill "$server_pid"
+  wait "$server_pid" || true
+  server_pid=""
+}
+
+if "$binary" "$rate_port" --client-rate many 2>/dev/null; then
+  fail "숫자가 아닌 --client-rate 를 받아들였습니다"
+fi
+if "$binary" "$rate_port" --client-table 0 2>/dev/null; then
+  fail "--client-table 0 을 받아들였습니다"
+fi
+if "$binary" "$rate_port" --client-table 99999999 2>/dev/null; then
+  fail "너무 큰 --client-table 을 받아들였습니다"
+fi
+if "$binary" "$rate_port" --overload-lag-ms soon 2>/dev/null; then
+  fail "숫자가 아닌 --overload-lag-ms 를 받아들였습니다"
+fi
+
+# 공용 클라이언트 도우미. source 로 출발 주소를 골라 서버가 다른 클라이언트로 보게 한다(127.0.0.0/8 은 모두 루프백).
+cat > "$work_dir/client.py" <<'PY'
+import re
+import socket
+
+
+def connect(port, source="127.0.0.1"):
+    sock = socket.create_connection(("127.0.0.1", port), timeout=5, source_address=(source, 0))
+    sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+    return sock
+
+
+def read_response(sock, pending):
+    while b"\r\n\r\n" not in pending:
+        chunk = sock.recv(65536)
+        if not chunk:
+            raise SystemExit("응답 도중 연결이 닫혔습니다: %r" % pending)
+        pending += chunk
+    head, _, rest = pending.partition(b"\r\n\r\n")
+    length = int(re.search(rb"Content-Length: (\d+)", head, re.I).group(1))
+    while len(rest) < length:
+        rest += sock.recv(65536)
+    return head, rest[length:]
+
+
+def requests(sock, count, path="/health"):
+    sock.sendall(b"GET %s HTTP/1.1\r\nHost: limits.test\r\n\r\n" % path.encode() * count)
+    heads, pending = [], b""
+    for _ in range(count):
+        head, pending = read_response(sock, pending)
+        heads.append(head)
+    return heads
+
+
+def status(head):
+    return int(head.split(b" ", 2)[1])
+
+
+def metrics(port):
+    # 계측 요청도 한도를 받으므로 시험에 쓰지 않는 주소에서 보낸다.
+    with connect(port, "127.0.0.9") as sock:
+        sock.sendall(b"GET /metrics HTTP/1.1\r\nHost: limits.test\r\nConnection: close\r\n\r\n")
+        body = b""
+        while True:
+            chunk = sock.recv(65536)
+            if not chunk:
+                break
+            body += chunk
+    return body.decode()
+
+
+def metric(body, name):
+    match = re.search(r"^%s (\d+)$" % re.escape(name), body, re.M)
+    if match is None:
+        raise SystemExit("계측 %s 가 없습니다" % name)
+    return int(match.group(1))
+PY
+
+# 1) 요청 속도: 초당 5개, 버킷 3개. 워커 2개라 같은 주소의 연결이 다른 워커로 갈 수 있다.
+"$binary" "$rate_port" --unlimited --workers 2 --client-rate 5 --client-burst 3 &
+server_pid=$!
+sleep 0.2
+
+PYTHONPATH="$work_dir" python - "$rate_port" <<'PY'
+import re
+import sys
+import time
+
+from client import connect, metric, metrics, requests, status
+
+port = int(sys.argv[1])
+
+# 파이프라이닝 5개: 버킷 3개 뒤로는 429 와 Retry-After, 연결은 keep-alive 로 남는다.
+with connect(port) as sock:
+    heads = requests(sock, 5)
+    codes = [status(h) for h in heads]
+    if codes != [200, 200, 200, 429, 429]:
+        sys.exit("버킷 3개 뒤에 429 가 아닙니다: %r" % codes)
+    for head in heads[3:]:
+        retry = re.search(rb"\r\nRetry-After: (\d+)\r\n", head)
+        if retry is None or int(retry.group(1)) < 1:
+            sys.exit("429 에 Retry-After 가 없습니다: %r" % head)
+        if b"Connection: close" in head:
+            sys.exit("429 가 연결을 닫습니다: %r" % head)
+    # 같은 연결로 다시 보내도 응답은 온다(닫히지 않았다).
+    if status(requests(sock, 1)[0]) not in (200, 429):
+        sys.exit("429 뒤 같은 연결의 요청에 답하지 않았습니다")
+
+# 다른 주소는 버킷이 따로다.
+with connect(port, "127.0.0.2") as sock:
+    codes = [status(h) for h in requests(sock, 3)]
+    if codes != [200, 200, 200]:
+        sys.exit("다른 주소가 한도에 걸렸습니다: %r" % codes)
+
+# 같은 주소의 연결 4개(워커 2개에 나뉜다)가 버킷 하나를 나눠 쓴다: 합쳐서 3개만 200.
+socks = [connect(port, "127.0.0.3") for _ in range(4)]
+codes = []
+for sock in socks:
+    codes += [status(h) for h in requests(sock, 1)]
+for sock in socks:
+    sock.close()
+if sorted(codes) != [200, 200, 200, 429]:
+    sys.exit("연결을 나눠도 주소 하나의 버킷이 아닙니다: %r" % codes)
+
+# 1초 쉬면 토큰 5개가 차지만 버킷은 3개까지만 담는다.
+time.sleep(1.1)
+with connect(port) as sock:
+    codes = [status(h) for h in requests(sock, 4)]
+    if codes != [200, 200, 200, 429]:
+        sys.exit("쉬고 난 뒤 버킷이 3개로 다시 차지 않았습니다: %r" % codes)
+
+body = metrics(port)
+if metric(body, 'webserv_shed_total{reason="rate"}') < 4:
+    sys.exit("속도 거절 계측이 모자랍니다:\n" + body)
+if not re.search(r'code="429"\} [1-9]', body):
+    sys.exit("429 응답 계측이 없습니다:\n" + body)
+if metric(body, 'webserv_shed_total{reason="connections"}') != 0:
+    sys.exit("연결 한도가 없는데 연결 거절이 잡혔습니다")
+PY
+
+# HTTP/2 스트림도 연결의 칸을 쓴다. 한 연결에 스트림 4개를 한꺼번에 연다.
+PYTHONPATH="$work_dir" python - "$rate_port" <<'PY'
+import struct
+import sys
+
+from client import connect
+
+port = int(sys.argv[1])
+
+
+def frame(kind, flags, stream, payload=b""):
+    return struct.pack(">I", len(payload))[1:] + bytes([kind, flags]) + struct.pack(">I", stream) + payload
+
+
+# 헤더는 허프만/색인 없는 리터럴로만 보낸다.
+block = b"".join(bytes([0, len(n)]) + n + bytes([len(v)]) + v for n, v in
+                 ((b":method", b"GET"), (b":scheme", b"http"), (b":path", b"/health"), (b":authority", b"limits")))
+with connect(port, "127.0.0.4") as sock:
+    sock.sendall(b"PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n" + frame(4, 0, 0) +
+                 b"".join(frame(1, 0x5, stream, block) for stream in (1, 3, 5, 7)))
+    pending, statuses, done = b"", {}, 0
+    while done < 4:
+        while len(pending) < 9 or len(pending) < 9 + int.from_bytes(pending[:3], "big"):
+            chunk = sock.recv(65536)
+            if not chunk:
+                sys.exit("HTTP/2 연결이 닫혔습니다")
+            pending += chunk
+        length = int.from_bytes(pending[:3], "big")
+        kind, flags = pending[3], pending[4]
+        stream = int.from_bytes(pending[5:9], "big") & 0x7FFFFFFF
+        payload = pending[9:9 + length]
+        pending = pending[9 + length:]
+        if kind == 1:
+            # :status 200 은 정적 색인 0x88, 그 밖은 색인 없는 리터럴(0x08, 길이, 숫자 세 개)이다.
+            statuses[stream] = 200 if payload[0] == 0x88 else int(payload[2:5]) if payload[:2] == b"\x08\x03" else -1
+        if kind in (0, 1) and flags & 0x1:
+            done += 1
+        elif kind in (3, 7):
+            sys.exit("스트림/연결 오류 프레임을 받았습니다: %d" % kind)
+codes = [statuses.get(stream) for stream in (1, 3, 5, 7)]
+if codes != [200, 200, 200, 429]:
+    sys.exit("HTTP/2 스트림이 주소 한도를 따르지 않습니다: %r" % codes)
+PY
+stop_server
+
+# 2) 동시 연결: 주소마다 2개
+"$binary" "$conn_port" --unlimited --workers 2 --client-connections 2 &
+server_pid=$!
+sleep 0.2
+
+PYTHONPATH="$work_dir" python - "$conn_port" <<'PY'
+import sys
+import time
+
+from client import connect, metric, metrics, requests, status
+
+port = int(sys.argv[1])
+
+
+def refused(source="127.0.0.1"):
+    sock = connect(port, source)
+    try:
+        sock.sendall(b"GET /health HTTP/1.1\r\nHost: limits.test\r\n\r\n")
+        return sock.recv(65536) == b""
+    except ConnectionResetError:
+        return True
+    finally:
+        sock.close()
+
+
+first, second = connect(port), connect(port)
+for sock in (first, second):
+    if status(requests(sock, 1)[0]) != 200:
+        sys.exit("한도 안의 연결이 응답받지 못했습니다")
+if not refused():
+    sys.exit("세 번째 연결이 닫히지 않았습니다")
+with connect(port, "127.0.0.2") as other:
+    if status(requests(other, 1)[0]) != 200:
+        sys.exit("다른 주소의 연결이 거절됐습니다")
+
+# 하나를 닫으면 자리가 난다. 서버가 닫힘을 처리할 때까지 잠깐 기다린다.
+second.close()
+for _ in range(50):
+    time.sleep(0.02)
+    sock = connect(port)
+    try:
+        sock.sendall(b"GET /health HTTP/1.1\r\nHost: limits.test\r\n\r\n")
+        if sock.recv(65536).startswith(b"HTTP/1.1 200"):
+            break
+    except ConnectionResetError:
+        pass
+    finally:
+        sock.close()
+else:
+    sys.exit("연결을 닫은 뒤에도 자리가 나지 않았습니다")
+first.close()
+
+body = metrics(port)
+if metric(body, 'webserv_shed_total{reason="connections"}') < 1:
+    sys.exit("연결 거절 계측이 없습니다:\n" + body)
+if metric(body, "webserv_client_untracked_total") != 0:
+    sys.exit("빈 표에서 칸을 얻지 못한 연결이 있습니다")
+PY
+stop_server
+
+# 3) 과부하: 압축 작업 스레드 없이 3MB 텍스트 파일을 워커에서 바로 미리 압축해 루프를 수백 ms 막는다.
+#    압축이 잘 안 되는 base64 난수라 압축 수준과 상관없이 오래 걸린다.
+mkdir "$work_dir/root"
+head -c 2300000 /dev/urandom | base64 -w 76 > "$work_dir/root/big.txt"
+"$binary" "$overload_port" --unlimited --workers 1 --root "$work_dir/root" --compression-threads 0 \
+  --overload-lag-ms 20 &
+server_pid=$!
+sleep 0.2
+
+PYTHONPATH="$work_dir" python - "$overload_port" <<'PY'
+import re
+import sys
+import time
+
+from client import connect, metric, metrics, read_response, requests, status
+
+port = int(sys.argv[1])
+
+slow, probe = connect(port), connect(port)
+# 두 연결을 먼저 수락시킨다(수락 회차와 요청 회차를 떼어 놓는다).
+for sock in (slow, probe):
+    if status(requests(sock, 1)[0]) != 200:
+        sys.exit("과부하 전 요청이 실패했습니다")
+
+slow.sendall(b"GET /big.txt HTTP/1.1\r\nHost: limits.test\r\nAccept-Encoding: gzip\r\n\r\n")
+time.sleep(0.03)
+# 워커가 압축하는 동안 도착한 요청: 루프가 수백 ms 밀렸으므로 다음 회차에 503 을 받는다.
+head = requests(probe, 1)[0]
+if status(head) != 503 or b"\r\nRetry-After: 1\r\n" not in head:
+    sys.exit("밀린 루프 뒤 요청이 503 + Retry-After: 1 이 아닙니다: %r" % head)
+if b"Connection: close" in head:
+    sys.exit("503 이 연결을 닫습니다")
+head, _ = read_response(slow, b"")
+if status(head) != 200 or b"Content-Encoding: gzip" not in head:
+    sys.exit("압축 요청이 끝나지 않았습니다: %r" % head)
+
+# 거절 회차는 짧으므로 과부하에서 바로 빠져나온다.
+time.sleep(0.05)
+codes = [status(h) for h in requests(probe, 2)]
+if codes != [200, 200]:
+    sys.exit("루프가 풀린 뒤에도 거절합니다: %r" % codes)
+slow.close()
+probe.close()
+
+body = metrics(port)
+if metric(body, "webserv_overload_entered_total") < 1:
+    sys.exit("과부하 진입 계측이 없습니다:\n" + body)
+if metric(body, 'webserv_shed_total{reason="overload"}') < 1:
+    sys.exit("과부하 거절 계측이 없습니다")
+if metric(body, "webserv_overloaded_workers") != 0:
+    sys.exit("과부하 게이지가 풀리지 않았습니다")
+PY
+stop_server
+
+echo "클라이언트 한도 테스트 통과"
@@ -0,0 +1,260 @@
+#!/usr/bin/env bash
+# webserv-cpp17 v1.14.0 테스트: Accept-Encoding 협상으로 응답을 gzip/deflate 압축하는지 검증한다.
+# - 정적 파일은 작업 스레드가 미리 압축해 두고 다음 요청부터 압축본을 보내는지, 파일이 바뀌면 다시 압축하는지
+# - 작은 파일, 이미 압축된 형식, identity 만 받는 클라이언트에는 원본을 보내는지
+# - /metrics 같은 동적 본문은 요청마다 바로 압축하는지
+# - --compression-threads 0 이면 첫 요청부터, --compression-level 0 이면 압축하지 않는지
+# - 압축해도 줄지 않아 원본을 보내는 항목도 캐시 한도에 들어가 오래된 것부터 밀려나는지
+set -euo pipefail
+
+if [ "$#" -ne 1 ]; then
+  echo "사용법: test_webserv_compression.sh <webserv_binary>" >&2
+  exit 1
+fi
+
+binary="$1"
+port=9107
+root_dir="$(mktemp -d)"
+server_pid=""
+
+python - "$root_dir" <<'PY'
+import os
+import sys
+
+root = sys.argv[1]
+lines = ["<li>item %d: webserv compression test line</li>\n" % i for i in range(2000)]
+with open(os.path.join(root, "page.html"), "w") as f:
+    f.write("<ul>\n" + "".join(lines) + "</ul>\n")
+with open(os.path.join(root, "data.json"), "w") as f:
+    f.write("[" + ",".join('{"id": %d, "name": "entry"}' % i for i in range(500)) + "]")
+with open(os.path.join(root, "small.txt"), "w") as f:
+    f.write("short body\n")
+with open(os.path.join(root, "image.png"), "wb") as f:
+    f.write(b"\x89PNG\r\n\x1a\n" + b"\x00" * 8192)
+for i in range(40):
+    with open(os.path.join(root, "noise%d.txt" % i), "wb") as f:
+        f.write(os.urandom(1024))
+PY
+
+start_server() {
+  "$binary" "$port" 1000 --root "$root_dir" --max-runtime-sec 30 "$@" &
+  server_pid=$!
+  sleep 0.2
+}
+
+stop_server() {
+  if [ -n "$server_pid" ] && kill -0 "$server_pid" 2>/dev/null; then
+    kill "$server_pid"
+    wait "$server_pid" || true
+  fi
+  server_pid=""
+  # io_uring 백엔드는 프로세스가 끝난 뒤에 링을 정리하며 리슨 소켓을 닫는다. 다음 서버가 바인드하기 전에 기다린다.
+  for _ in $(seq 1 40); do
+    (exec 3<>"/dev/tcp/127.0.0.1/$port") 2>/dev/null || break
+    sleep 0.05
+  done
+}
+
+cleanup() {
+  stop_server
+  rm -rf "$root_dir"
+}
+trap cleanup EXIT
+
+start_server
+
+python - <<PY
+import gzip
+import http.client
+import os
+import sys
+import time
+import zlib
+
+root = "${root_dir}"
+conn = http.client.HTTPConnection("127.0.0.1", ${port}, timeout=5)
+
+def fail(message):
+    print(message, file=sys.stderr)
+    sys.exit(1)
+
+def get(path, encoding=None):
+    headers = {} if encoding is None else {"Accept-Encoding": encoding}
+    conn.request("GET", path, headers=headers)
+    response = conn.getresponse()
+    return response.status, {k.lower(): v for k, v in response.getheaders()}, response.read()
+
+def original(name):
+    with open(os.path.join(root, name.split("?")[0]), "rb") as f:
+        return f.read()
+
+def wait_compressed(path, encoding):
+    # 첫 요청은 압축을 맡기고 원본으로 응답한다. 작업 스레드가 끝나면 압축본이 나간다.
+    for _ in range(100):
+        status, headers, body = get(path, encoding)
+        if status != 200:
+            fail("%s 상태 %d" % (path, status))
+        if "content-encoding" in headers:
+            return headers, body
+        if body != original(path.lstrip("/")):
+            fail("%s 압축 전 원본 응답이 다릅니다" % path)
+        if headers.get("vary") != "Accept-Encoding":
+            fail("%s 원본 응답에 Vary 헤더가 없습니다: %r" % (path, headers))
+        time.sleep(0.02)
+    fail("%s 압축본이 준비되지 않았습니다" % path)
+
+status, headers, body = get("/page.html")
+if status != 200 or "content-encoding" in headers or body != original("page.html"):
+    fail("Accept-Encoding 없는 요청은 원본이어야 합니다: %r" % headers)
+plain_etag = headers["etag"]
+
+headers, body = wait_compressed("/page.html", "gzip, deflate")
+if headers["content-encoding"] != "gzip" or gzip.decompress(body) != original("page.html"):
+    fail("gzip 압축본이 원본과 다릅니다: %r" % headers)
+if int(headers["content-length"]) != len(body) or len(body) >= len(original("page.html")) // 4:
+    fail("gzip 압축본 크기가 이상합니다: %d" % len(body))
+if not headers["etag"].endswith('-gzip"') or headers["etag"] == plain_etag or headers.get("vary") != "Accept-Encoding":
+    fail("압축본 ETag/Vary 가 예상과 다릅니다: %r" % headers)
+
+headers, body = wait_compressed("/data.json?v=1", "deflate")
+if headers["content-encoding"] != "deflate" or zlib.decompress(body) != original("data.json"):
+    fail("deflate 압축본이 원본과 다릅니다: %r" % headers)
+
+# q 값: deflate 를 더 선호하면 deflate, gzip 을 거부하고 * 만 남으면 deflate, br 만 받으면 원본.
+headers, body = wait_compressed("/page.html", "gzip;q=0.5, deflate;q=0.8")
+if headers["content-encoding"] != "deflate" or zlib.decompress(body) != original("page.html"):
+    fail("q 값이 큰 deflate 를 골라야 합니다: %r" % headers)
+_, headers, _ = get("/page.html", "gzip;q=0, *")
+if headers.get("content-encoding") != "deflate":
+    fail("gzip;q=0, * 는 deflate 여야 합니다: %r" % headers)
+_, headers, body = get("/page.html", "br")
+if "content-encoding" in headers or body != original("page.html"):
+    fail("br 만 받는 클라이언트에는 원본을 보내야 합니다: %r" % headers)
+_, headers, body = get("/page.html", "x-gzip")
+if headers.get("content-encoding") != "gzip" or gzip.decompress(body) != original("page.html"):
+    fail("x-gzip 은 gzip 으로 응답해야 합니다: %r" % headers)
+
+for path in ("/small.txt", "/image.png"):
+    for _ in range(3):
+        _, headers, body = get(path, "gzip")
+        time.sleep(0.02)
+    if "content-encoding" in headers or body != original(path.lstrip("/")):
+        fail("%s 는 압축하지 않아야 합니다: %r" % (path, headers))
+
+status, headers, body = get("/metrics", "gzip")
+if status != 200 or headers.get("content-encoding") != "gzip" or b"webserv_requests_total" not in gzip.decompress(body):
+    fail("/metrics 는 첫 요청부터 gzip 이어야 합니다: %r" % headers)
+
+# 파일이 바뀌면 옛 압축본을 버리고 새 내용으로 다시 압축한다.
+with open(os.path.join(root, "page.html"), "a") as f:
+    f.write("<p>appended</p>\n")
+time.sleep(0.1)
+for _ in range(100):
+    _, headers, body = get("/page.html", "gzip")
+    if headers.get("content-encoding") == "gzip" and gzip.decompress(body) == original("page.html"):
+        break
+    if "content-encoding" in headers and gzip.decompress(body) != original("page.html"):
+        time.sleep(0.02)
+        continue
+    if "content-encoding" not in headers and body != original("page.html"):
+        fail("수정된 파일의 원본 응답이 다릅니다")
+    time.sleep(0.02)
+else:
+    fail("수정된 파일이 다시 압축되지 않았습니다")
+
+_, _, metrics = get("/metrics")
+values = {}
+for line in metrics.decode().splitlines():
+    if line and not line.startswith("#"):
+        name, value = line.rsplit(" ", 1)
+        values[name] = float(value)
+if values.get('webserv_compressed_responses_total{source="cache"}', 0) < 4:
+    fail("캐시 압축 응답 계측이 부족합니다: %r" % values)
+if values.get('webserv_compressed_responses_total{source="dynamic"}', 0) < 1:
+    fail("동적 압축 응답 계측이 없습니다: %r" % values)
+if values.get("webserv_precompressions_total", 0) < 4:
+    fail("미리 압축 횟수 계측이 부족합니다: %r" % values)
+PY
+
+stop_server
+start_server --compression-threads 0
+
+python - <<PY
+import gzip
+import http.client
+import sys
+
+conn = http.client.HTTPConnection("127.0.0.1", ${port}, timeout=5)
+conn.request("GET", "/page.html", headers={"Accept-Encoding": "gzip"})
+response = conn.getresponse()
+body = response.read()
+if response.getheader("Content-Encoding") != "gzip":
+    print("--compression-threads 0 이면 첫 요청부터 압축본이어야 합니다", file=sys.stderr)
+    sys.exit(1)
+with open("${root_dir}/page.html", "rb") as f:
+    if gzip.decompress(body) != f.read():
+        print("워커에서 바로 만든 압축본이 원본과 다릅니다", file=sys.stderr)
+        sys.exit(1)
+PY
+
+stop_server
+start_server --compression-threads 0 --compression-cache-bytes 4096
+
+python - <<PY
+import http.client
+import sys
+
+conn = http.client.HTTPConnection("127.0.0.1", ${port}, timeout=5)
+
+def get(path, encoding=None):
+    headers = {} if encoding is None else {"Accept-Encoding": encoding}
+    conn.request("GET", path, headers=headers)
+    response = conn.getresponse()
+    return response.status, response.getheader("Content-Encoding"), response.read()
+
+def precompressions():
+    _, _, body = get("/metrics")
+    for line in body.decode().splitlines():
+        if line.startswith("webserv_precompressions_total "):
+            return int(float(line.split()[1]))
+    return 0
+
+# 무작위 바이트는 압축해도 줄지 않아 원본을 보내는 항목으로 남는다. 4096 바이트 한도에는 40개가 다 들어가지 않는다.
+for i in range(40):
+    status, encoding, _ = get("/noise%d.txt" % i, "gzip")
+    if status != 200 or encoding is not None:
+        print("줄지 않는 파일은 원본이어야 합니다: noise%d.txt %r" % (i, encoding), file=sys.stderr)
+        sys.exit(1)
+if precompressions() != 40:
+    print("미리 압축 횟수가 40이 아닙니다: %d" % precompressions(), file=sys.stderr)
+    sys.exit(1)
+get("/noise39.txt", "gzip")
+if precompressions() != 40:
+    print("최근 항목은 캐시에 남아 있어야 합니다", file=sys.stderr)
+    sys.exit(1)
+get("/noise0.txt", "gzip")
+if precompressions() != 41:
+    print("오래된 원본 항목이 한도에서 밀려나지 않았습니다", file=sys.stderr)
+    sys.exit(1)
+PY
+
+stop_server
+start_server --compression-level 0
+
+python - <<PY
+import http.client
+import sys
+import time
+
+conn = http.client.HTTPConnection("127.0.0.1", ${port}, timeout=5)
+for path in ("/page.html", "/page.html", "/metrics"):
+    conn.request("GET", path, headers={"Accept-Encoding": "gzip"})
+    response = conn.getresponse()
+    response.read()
+    if response.getheader("Content-Encoding") is not None or response.getheader("Vary") is not None:
+        print("--compression-level 0 이면 압축하지 않아야 합니다: %s" % path, file=sys.stderr)
+        sys.exit(1)
+    time.sleep(0.05)
+PY
+
+echo "webserv v1.14.0 응답 압축 테스트 통과"
@@ -0,0 +1,100 @@
+#!/usr/bin/env bash
+# webserv-cpp17 v1.9.0 테스트: 연결을 빠르게 열고 닫아도 풀에서 재사용되는 연결 슬롯이 이전 연결의 상태를
+# 넘겨받지 않는지 검증한다. 큰 요청으로 입력 버퍼를 키운 슬롯, 응답 도중 끊긴 슬롯도 섞는다.
+set -euo pipefail
+
+if [ "$#" -ne 1 ]; then
+  echo "사용법: test_webserv_connection_churn.sh <webserv_binary>" >&2
+  exit 1
+fi
+
+binary="$1"
+port=9102
+
+# 입력 버퍼를 키우는 약 100KB 헤더 요청이 기본 헤더 제한(16KB, v1.12.0)에 걸리지 않도록 제한을 넓힌다.
+"$binary" "$port" 1000000 --idle-timeout-ms 5000 --max-runtime-sec 30 --max-header-bytes 262144 &
+server_pid=$!
+
+cleanup() {
+  if kill -0 "$server_pid" 2>/dev/null; then
+    kill "$server_pid"
+    wait "$server_pid" || true
+  fi
+}
+trap cleanup EXIT
+
+sleep 0.2
+
+python - <<PY
+import re
+import socket
+import sys
+
+def fail(message):
+    print(message, file=sys.stderr)
+    sys.exit(1)
+
+def read_all(s):
+    data = b""
+    while True:
+        chunk = s.recv(65536)
+        if not chunk:
+            return data
+        data += chunk
+
+def get(path, host, extra=b""):
+    s = socket.create_connection(("127.0.0.1", ${port}), timeout=5)
+    s.sendall(b"GET " + path + b" HTTP/1.1\r\nHost: " + host + b"\r\n" + extra + b"Connection: close\r\n\r\n")
+    data = read_all(s)
+    s.close()
+    return data
+
+# 교체 내내 열려 있는 keep-alive 연결. 다른 슬롯이 재사용되어도 이 연결은 영향을 받지 않아야 한다.
+keeper = socket.create_connection(("127.0.0.1", ${port}), timeout=5)
+
+def keeper_roundtrip():
+    keeper.sendall(b"GET /health HTTP/1.1\r\nHost: keeper\r\n\r\n")
+    data = b""
+    while b"status: ok\n" not in data:
+        chunk = keeper.recv(4096)
+        if not chunk:
+            fail("keep-alive 연결이 교체 도중 닫혔습니다.")
+        data += chunk
+
+keeper_roundtrip()
+churned = 0
+for i in range(1500):
+    host = b"churn-%d" % i
+    if i % 100 == 7:
+        # 약 100KB 헤더로 입력 버퍼를 키운다. 반납 시 줄어든 뒤 다음 연결이 깨끗한 버퍼를 받아야 한다.
+        padding = b"".join(b"X-Pad-%d: %s\r\n" % (n, b"p" * 4000) for n in range(25))
+        data = get(b"/", host, padding)
+    elif i % 100 == 13:
+        # 요청 절반만 보내고 끊는다. 이 슬롯의 파서 상태가 다음 연결로 넘어가면 안 된다.
+        s = socket.create_connection(("127.0.0.1", ${port}), timeout=5)
+        s.sendall(b"GET /health HTTP/1.1\r\nHost: half")
+        s.close()
+        churned += 1
+        continue
+    else:
+        data = get(b"/", host)
+    if not data.startswith(b"HTTP/1.1 200 OK") or b"Host: " + host + b"\n" not in data:
+        fail(f"{i}번째 연결 응답이 예상과 다릅니다:\n{data[:300]!r}")
+    churned += 1
+    if i % 250 == 0:
+        keeper_roundtrip()
+
+keeper_roundtrip()
+metrics = get(b"/metrics", b"t").decode()
+accepted = int(re.search(r"webserv_connections_accepted_total (\d+)", metrics).group(1))
+active = int(re.search(r"webserv_connections_active (\d+)", metrics).group(1))
+# keeper + 교체한 연결 + /metrics 연결
+if accepted != churned + 2:
+    fail(f"수락 수가 예상({churned + 2})과 다릅니다: {accepted}")
+# /metrics 연결은 응답을 만든 시점에 아직 열려 있으므로 keeper 와 함께 2개다. 끊긴 연결이 남아 있으면 안 된다.
+if active != 2:
+    fail(f"열린 연결 수가 예상(2)과 다릅니다: {active}")
+keeper.close()
+PY
+
+echo "webserv v1.9.0 연결 풀 재사용(연결 교체) 테스트 통과"
@@ -0,0 +1,340 @@
+#!/usr/bin/env bash
+# webserv-cpp17 v1.18.0 테스트: 이벤트 루프 위에서 멈췄다 재개하는 코루틴 핸들러를 검증한다.
+# - /sleep/:ms 가 타이머로 재개해 응답하고, 잘못된 값은 404 인지
+# - 워커 하나에서 /sleep/300 500개가 한꺼번에 잠들어도 약 300ms 에 모두 끝나고, 그동안 /health 가 기다리지 않는지
+# - POST /upload/echo 가 Content-Length, chunked, Expect: 100-continue 본문을 조각으로 받아 그대로 돌려주고, 제한을 넘으면 413 인지
+# - 코루틴이 멈춘 동안 파이프라이닝된 다음 요청이 앞지르지 않는지
+# - /fetch/*path 가 업스트림 응답(chunked 포함)을 모아 답하고, 맞는 --proxy 가 없으면 404, 업스트림이 죽어 있으면
+#   100ms 쉬고 한 번 더 시도한 뒤 502 인지, 업스트림 503 뒤 재시도가 성공하는지, 업스트림 연결을 재사용하는지
+# - 잠든 요청의 연결이 먼저 닫혀도 서버가 계속 동작하고, 유휴 타임아웃보다 긴 sleep 도 끝까지 기다리는지
+# - 계측(route="sleep"/"echo"/"fetch", webserv_coroutine_awaits_total)이 맞는지
+# - --demo-routes 없이 띄우면 예시 경로가 등록되지 않아 /fetch 가 업스트림에 요청을 보내지 않는지
+set -euo pipefail
+
+if [ "$#" -ne 1 ]; then
+  echo "사용법: test_webserv_coroutine.sh <webserv_binary>" >&2
+  exit 1
+fi
+
+binary="$1"
+port=9115
+upstream_port=9116
+down_port=9117
+work_dir="$(mktemp -d)"
+server_pid=""
+upstream_pid=""
+
+# /fetch 가 가져갈 업스트림. 맺은 연결 수를 /stats 로 알려 준다. /up/flaky 는 처음 한 번만 503 이다.
+cat > "$work_dir/upstream.py" <<'PY'
+import json
+import sys
+import threading
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+stats = {"connections": 0, "flaky": 0}
+
+
+class Handler(BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"
+
+    def setup(self):
+        super().setup()
+        stats["connections"] += 1
+
+    def log_message(self, *args):
+        pass
+
+    def reply(self, status, body):
+        self.send_response(status)
+        self.send_header("Content-Type", "text/plain")
+        self.send_header("Content-Length", str(len(body)))
+        self.end_headers()
+        self.wfile.write(body)
+
+    def do_GET(self):
+        if self.path == "/stats":
+            self.reply(200, json.dumps(stats).encode())
+        elif self.path == "/up/ok":
+            self.reply(200, b"hello\n")
+        elif self.path == "/up/missing":
+            self.reply(404, b"gone\n")
+        elif self.path == "/up/flaky":
+            stats["flaky"] += 1
+            self.reply(503 if stats["flaky"] == 1 else 200, b"flaky %d\n" % stats["flaky"])
+        elif self.path == "/up/chunked":
+            self.send_response(200)
+            self.send_header("Transfer-Encoding", "chunked")
+            self.end_headers()
+            for part in (b"alpha ", b"beta ", b"gamma\n"):
+                self.wfile.write(b"%x\r\n%s\r\n" % (len(part), part))
+            self.wfile.write(b"0\r\n\r\n")
+        else:
+            self.reply(404, b"no route\n")
+
+
+server = ThreadingHTTPServer(("127.0.0.1", int(sys.argv[1])), Handler)
+server.daemon_threads = True
+threading.Thread(target=server.serve_forever, daemon=True).start()
+print("ready", flush=True)
+threading.Event().wait()
+PY
+
+start_server() {
+  "$binary" "$port" 100000 --workers 1 --max-runtime-sec 60 "$@" &
+  server_pid=$!
+  sleep 0.2
+}
+
+stop_server() {
+  if [ -n "$server_pid" ] && kill -0 "$server_pid" 2>/dev/null; then
+    kill "$server_pid"
+    wait "$server_pid" || true
+  fi
+  server_pid=""
+  # io_uring 백엔드는 프로세스가 끝난 뒤에 리슨 소켓을 닫는다. 다음 서버가 바인드하기 전에 기다린다.
+  for _ in $(seq 1 40); do
+    (exec 3<>"/dev/tcp/127.0.0.1/$port") 2>/dev/null || break
+    sleep 0.05
+  done
+}
+
+cleanup() {
+  stop_server
+  if [ -n "$upstream_pid" ] && kill -0 "$upstream_pid" 2>/dev/null; then
+    kill "$upstream_pid"
+    wait "$upstream_pid" 2>/dev/null || true
+  fi
+  rm -rf "$work_dir"
+}
+trap cleanup EXIT
+
+python "$work_dir/upstream.py" "$upstream_port" > "$work_dir/upstream.log" 2>&1 &
+upstream_pid=$!
+for _ in $(seq 1 50); do
+  grep -q ready "$work_dir/upstream.log" && break
+  sleep 0.1
+done
+
+start_server --demo-routes --idle-timeout-ms 1000 --max-body-bytes 1048576 \
+  --proxy "/up=127.0.0.1:$upstream_port" --proxy "/down=127.0.0.1:$down_port"
+
+python - <<PY
+import http.client
+import json
+import os
+import socket
+import sys
+import time
+
+PORT = ${port}
+UPSTREAM = ${upstream_port}
+
+def fail(message):
+    print(message, file=sys.stderr)
+    sys.exit(1)
+
+def request(method, path, body=None, headers=None, conn=None):
+    own = conn is None
+    if own:
+        conn = http.client.HTTPConnection("127.0.0.1", PORT, timeout=10)
+    started = time.monotonic()
+    conn.request(method, path, body=body, headers=headers or {})
+    response = conn.getresponse()
+    data = response.read()
+    elapsed = time.monotonic() - started
+    if own:
+        conn.close()
+    return response.status, data, elapsed
+
+def read_all(sock):
+    data = b""
+    while True:
+        chunk = sock.recv(65536)
+        if not chunk:
+            return data
+        data += chunk
+
+# /sleep: 타이머로 재개한다. 잘못된 값은 404.
+status, body, elapsed = request("GET", "/sleep/50")
+if status != 200 or body != b"slept: 50 ms\n" or elapsed < 0.045:
+    fail("/sleep/50 응답이 이상합니다: %d %r %.3fs" % (status, body, elapsed))
+for path in ("/sleep/abc", "/sleep/20000", "/sleep/-1"):
+    status, body, _ = request("GET", path)
+    if status != 404 or body != b"Not found\n":
+        fail("%s 는 404 여야 합니다: %d %r" % (path, status, body))
+
+# 500개가 한꺼번에 잠들어도 스레드를 붙잡지 않으므로 약 300ms 에 모두 끝난다.
+socks = [socket.create_connection(("127.0.0.1", PORT), timeout=10) for _ in range(500)]
+started = time.monotonic()
+for sock in socks:
+    sock.sendall(b"GET /sleep/300 HTTP/1.1\r\nHost: t\r\nConnection: close\r\n\r\n")
+health = http.client.HTTPConnection("127.0.0.1", PORT, timeout=5)
+samples = []
+for _ in range(50):
+    status, _, elapsed = request("GET", "/health", conn=health)
+    if status != 200:
+        fail("/health 실패: %d" % status)
+    samples.append(elapsed)
+health.close()
+replies = [read_all(sock) for sock in socks]
+total = time.monotonic() - started
+for sock in socks:
+    sock.close()
+if any(b"slept: 300 ms" not in reply for reply in replies):
+    fail("잠든 요청 일부가 응답하지 않았습니다")
+if total > 1.5:
+    fail("/sleep/300 500개가 %.3fs 걸렸습니다" % total)
+samples.sort()
+if samples[int(len(samples) * 0.99) - 1] > 0.05:
+    fail("잠든 요청이 많은 동안 /health 가 느립니다: %r" % samples[-5:])
+
+# /upload/echo: Content-Length, chunked, Expect 본문을 그대로 돌려준다.
+payload = os.urandom(200000)
+status, body, _ = request("POST", "/upload/echo", body=payload)
+if status != 200 or body != payload:
+    fail("Content-Length 본문 echo 가 다릅니다: %d %d" % (status, len(body)))
+status, body, _ = request("POST", "/upload/echo", body=b"")
+if status != 200 or body != b"":
+    fail("빈 본문 echo 가 이상합니다: %d %r" % (status, body))
+
+sock = socket.create_connection(("127.0.0.1", PORT), timeout=5)
+sock.sendall(b"POST /upload/echo HTTP/1.1\r\nHost: t\r\nTransfer-Encoding: chunked\r\nConnection: close\r\n\r\n"
+             b"5\r\nhello\r\n")
+time.sleep(0.05)
+sock.sendall(b"1;ext=1\r\n \r\n6\r\nworld!\r\n0\r\nX-Trailer: 1\r\n\r\n")
+data = read_all(sock)
+sock.close()
+if not data.startswith(b"HTTP/1.1 200 OK") or not data.endswith(b"\r\n\r\nhello world!"):
+    fail("chunked 본문 echo 가 이상합니다: %r" % data)
+
+sock = socket.create_connection(("127.0.0.1", PORT), timeout=5)
+sock.sendall(b"POST /upload/echo HTTP/1.1\r\nHost: t\r\nContent-Length: 4\r\nExpect: 100-continue\r\nConnection: close\r\n\r\n")
+interim = sock.recv(4096)
+if not interim.startswith(b"HTTP/1.1 100 Continue\r\n\r\n"):
+    fail("100 Continue 가 없습니다: %r" % interim)
+sock.sendall(b"ping")
+data = interim[len(b"HTTP/1.1 100 Continue\r\n\r\n"):] + read_all(sock)
+sock.close()
+if not data.startswith(b"HTTP/1.1 200 OK") or not data.endswith(b"\r\n\r\nping"):
+    fail("Expect 본문 echo 가 이상합니다: %r" % data)
+
+sock = socket.create_connection(("127.0.0.1", PORT), timeout=5)
+# 코루틴이 조각 하나를 받은 뒤 제한(1MB)을 넘는 청크 크기 줄이 온다. 데이터를 받기 전에 413 이다.
+sock.sendall(b"POST /upload/echo HTTP/1.1\r\nHost: t\r\nTransfer-Encoding: chunked\r\n\r\n5\r\nhello\r\n200000\r\n")
+data = read_all(sock)
+sock.close()
+if not data.startswith(b"HTTP/1.1 413"):
+    fail("제한을 넘는 chunked 본문은 413 이어야 합니다: %r" % data[:80])
+
+# 파이프라이닝: 잠든 코루틴 뒤의 요청이 앞지르지 않는다.
+sock = socket.create_connection(("127.0.0.1", PORT), timeout=5)
+sock.sendall(b"GET /sleep/100 HTTP/1.1\r\nHost: t\r\n\r\n"
+             b"POST /upload/echo HTTP/1.1\r\nHost: t\r\nContent-Length: 6\r\n\r\nsecond"
+             b"GET /health HTTP/1.1\r\nHost: t\r\nConnection: close\r\n\r\n")
+data = read_all(sock)
+sock.close()
+first = data.find(b"slept: 100 ms")
+second = data.find(b"second")
+third = data.find(b"status: ok")
+if not (0 <= first < second < third) or data.count(b"HTTP/1.1 200 OK") != 3:
+    fail("파이프라이닝된 응답 순서가 틀렸습니다: %r" % data)
+
+# /fetch: 업스트림 응답을 모아 답한다.
+status, body, _ = request("GET", "/fetch/up/ok")
+if status != 200 or body != b"status: 200\nattempts: 1\nbytes: 6\n\nhello\n":
+    fail("/fetch/up/ok 응답이 이상합니다: %d %r" % (status, body))
+status, body, _ = request("GET", "/fetch/up/chunked")
+if status != 200 or body != b"status: 200\nattempts: 1\nbytes: 17\n\nalpha beta gamma\n":
+    fail("chunked 업스트림 응답을 풀어 모아야 합니다: %d %r" % (status, body))
+status, body, _ = request("GET", "/fetch/up/missing")
+if status != 200 or not body.startswith(b"status: 404\nattempts: 1\n"):
+    fail("업스트림 404 는 그대로 보고해야 합니다: %d %r" % (status, body))
+status, body, _ = request("GET", "/fetch/elsewhere")
+if status != 404 or body != b"Not found\n":
+    fail("맞는 --proxy 가 없으면 404 여야 합니다: %d %r" % (status, body))
+status, body, elapsed = request("GET", "/fetch/down/x")
+if status != 502 or body != b"Bad gateway\n" or elapsed < 0.09:
+    fail("죽은 업스트림은 한 번 더 시도한 뒤 502 여야 합니다: %d %r %.3fs" % (status, body, elapsed))
+status, body, elapsed = request("GET", "/fetch/up/flaky")
+if status != 200 or body != b"status: 200\nattempts: 2\nbytes: 8\n\nflaky 2\n" or elapsed < 0.09:
+    fail("업스트림 503 뒤 재시도가 성공해야 합니다: %d %r %.3fs" % (status, body, elapsed))
+
+# 차례로 보낸 /fetch 는 업스트림 연결 하나를 재사용한다.
+conn = http.client.HTTPConnection("127.0.0.1", UPSTREAM, timeout=5)
+conn.request("GET", "/stats")
+connections = json.loads(conn.getresponse().read())["connections"]
+conn.close()
+if connections != 2:
+    fail("업스트림 연결을 재사용해야 합니다(/stats 연결 포함 2개): %d" % connections)
+
+# 잠든 요청의 연결이 먼저 닫혀도 서버는 계속 동작한다.
+for _ in range(3):
+    sock = socket.create_connection(("127.0.0.1", PORT), timeout=5)
+    sock.sendall(b"GET /sleep/100 HTTP/1.1\r\nHost: t\r\n\r\n")
+    sock.close()
+time.sleep(0.3)
+status, _, _ = request("GET", "/health")
+if status != 200:
+    fail("닫힌 연결의 코루틴 뒤 서버가 응답하지 않습니다")
+
+# 잠든 동안은 유휴 타임아웃(1000ms)을 걸지 않는다.
+status, body, elapsed = request("GET", "/sleep/1500")
+if status != 200 or body != b"slept: 1500 ms\n" or elapsed < 1.45:
+    fail("유휴 타임아웃보다 긴 sleep 이 끝나지 않았습니다: %d %r %.3fs" % (status, body, elapsed))
+
+status, body, _ = request("GET", "/metrics")
+text = body.decode()
+# sleep: 50, 500개, 파이프라인 하나, 닫힌 연결 세 개, 1500 / 404 세 개
+# echo: Content-Length, 빈 본문, chunked, Expect, 파이프라인 하나
+# fetch: ok, chunked, missing, flaky / elsewhere 404 / down 502
+expected = {
+    'webserv_requests_total{route="sleep",code="200"}': 506,
+    'webserv_requests_total{route="sleep",code="404"}': 3,
+    'webserv_requests_total{route="echo",code="200"}': 5,
+    'webserv_requests_total{route="fetch",code="200"}': 4,
+    'webserv_requests_total{route="fetch",code="404"}': 1,
+    'webserv_requests_total{route="fetch",code="502"}': 1,
+    'webserv_coroutine_awaits_total{wait="timer"}': 508,
+    'webserv_coroutine_awaits_total{wait="upstream"}': 8,
+}
+for name, value in expected.items():
+    if "%s %d\n" % (name, value) not in text:
+        fail("%s 가 %d 가 아닙니다:\n%s" % (name, value, text))
+if 'webserv_requests_total{route="error",code="413"} 1\n' not in text:
+    fail("413 계측이 없습니다:\n%s" % text)
+PY
+
+stop_server
+# 접두사는 문자열 일치라 "/up" 이면 /upload/echo 도 업스트림으로 간다. 끝에 / 를 붙여 구분한다.
+start_server --proxy "/up/=127.0.0.1:$upstream_port"
+
+python - <<PY
+import http.client
+import sys
+
+PORT = ${port}
+
+def fail(message):
+    print(message, file=sys.stderr)
+    sys.exit(1)
+
+# 예시 경로는 --demo-routes 로 켤 때만 있다. 없으면 GET 은 기본 응답, 다른 메서드는 405 다.
+conn = http.client.HTTPConnection("127.0.0.1", PORT, timeout=5)
+for path in ("/sleep/300", "/fetch/up/ok"):
+    conn.request("GET", path)
+    response = conn.getresponse()
+    body = response.read()
+    if response.status != 200 or not body.startswith(b"Hello from webserv"):
+        fail("--demo-routes 없이 %s 가 등록되었습니다: %d %r" % (path, response.status, body))
+conn.request("POST", "/upload/echo", body=b"hello")
+response = conn.getresponse()
+response.read()
+if response.status != 405:
+    fail("--demo-routes 없이 POST /upload/echo 가 405 가 아닙니다: %d" % response.status)
+conn.request("GET", "/metrics")
+text = conn.getresponse().read().decode()
+if 'webserv_coroutine_awaits_total{wait="upstream"} 0\n' not in text:
+    fail("--demo-routes 없이 /fetch 가 업스트림에 요청했습니다:\n%s" % text)
+PY
+
+echo "webserv v1.18.0 코루틴 핸들러 테스트 통과"
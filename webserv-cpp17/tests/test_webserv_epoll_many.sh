@@ -0,0 +1,61 @@
+#!/usr/bin/env bash
+# webserv-cpp17 v1.1.0 테스트: FD_SETSIZE(1024)를 넘는 유휴 연결을 유지한 채 요청을 처리하는지 검증한다.
+set -euo pipefail
+
+if [ "$#" -ne 1 ]; then
+  echo "사용법: test_webserv_epoll_many.sh <webserv_binary>" >&2
+  exit 1
+fi
+
+binary="$1"
+port=9094
+max_requests=1
+
+"$binary" "$port" "$max_requests" --idle-timeout-ms 10000 --max-runtime-sec 30 &
+server_pid=$!
+
+cleanup() {
+  if kill -0 "$server_pid" 2>/dev/null; then
+    kill "$server_pid"
+    wait "$server_pid" || true
+  fi
+}
+trap cleanup EXIT
+
+sleep 0.2
+
+python - <<PY
+import resource
+import socket
+import sys
+
+soft, hard = resource.getrlimit(resource.RLIMIT_NOFILE)
+resource.setrlimit(resource.RLIMIT_NOFILE, (hard, hard))
+idle_count = min(1500, hard - 64)
+
+idle = []
+for _ in range(idle_count):
+    idle.append(socket.create_connection(("127.0.0.1", ${port})))
+
+s = socket.create_connection(("127.0.0.1", ${port}))
+s.sendall(b"GET /health HTTP/1.1\r\nHost: many.test\r\nConnection: close\r\n\r\n")
+received = b""
+s.settimeout(5)
+while True:
+    chunk = s.recv(4096)
+    if not chunk:
+        break
+    received += chunk
+s.close()
+for sock in idle:
+    sock.close()
+
+if idle_count <= 1024:
+    print("FD 한도가 낮아 1024개 초과 연결을 만들 수 없습니다.", file=sys.stderr)
+    sys.exit(1)
+if b"200 OK" not in received or b"status: ok" not in received:
+    print("다수 유휴 연결 상태에서 응답이 예상과 다릅니다.", file=sys.stderr)
+    sys.exit(1)
+PY
+
+echo "webserv v1.1.0 epoll 다중 유휴 연결 테스트 통과"
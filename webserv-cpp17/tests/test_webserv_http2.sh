@@ -0,0 +1,374 @@
+#!/usr/bin/env bash
+# webserv-cpp17 v1.23.0 테스트: HTTP/2 를 검증한다.
+# - curl 로 세 가지 시작 방식(평문 prior knowledge, h2c 업그레이드, TLS ALPN)과 정적 파일(해시 비교), 업로드 본문,
+#   압축 응답을 받는지, TLS 에서 `--http1.1` 은 그대로 HTTP/1.1 인지
+# - 한 연결의 여러 스트림이 작업 스레드 핸들러(/delay)를 동시에 기다리는지(연결 1개, 직렬 시간보다 짧음)
+# - 코루틴 라우트(/sleep)는 HTTP_1_1_REQUIRED 로 닫아 curl 이 HTTP/1.1 로 다시 보내는지
+# - 프레임 클라이언트로: 느린 스트림 뒤의 빠른 스트림이 먼저 끝나는지, PING/SETTINGS ACK, 작은 흐름 제어 창에서
+#   창을 넘지 않고 큰 파일을 다 보내는지, Content-Length 초과 413, 동시 스트림 상한을 넘는 스트림의 REFUSED_STREAM,
+#   잘못된 프레임 순서/크기의 GOAWAY, 클라이언트 GOAWAY 뒤 진행 중인 스트림을 마치고 닫는지
+# - HTTP/2 계측(webserv_http2_connections_total, webserv_http2_streams_total)
+# - `--http2 off` 면 업그레이드와 ALPN 이 HTTP/1.1 로 남는지, 잘못된 HTTP/2 옵션을 시작 전에 거절하는지
+# curl 이 HTTP/2 를 지원하지 않으면 건너뛴다(종료 코드 77).
+set -euo pipefail
+
+if [ "$#" -ne 1 ]; then
+  echo "사용법: test_webserv_http2.sh <webserv_binary>" >&2
+  exit 1
+fi
+
+binary="$1"
+port=9128
+tls_port=9129
+server_pid=""
+work_dir="$(mktemp -d)"
+
+cleanup() {
+  if [ -n "$server_pid" ] && kill -0 "$server_pid" 2>/dev/null; then
+    kill "$server_pid"
+    wait "$server_pid" || true
+  fi
+  rm -rf "$work_dir"
+}
+trap cleanup EXIT
+
+fail() {
+  echo "$1" >&2
+  exit 1
+}
+
+stop_server() {
+  kill "$server_pid"
+  wait "$server_pid" || true
+  server_pid=""
+}
+
+if ! curl -V | grep -q "HTTP2"; then
+  echo "curl 이 HTTP/2 를 지원하지 않아 건너뜁니다"
+  exit 77
+fi
+
+if "$binary" "$port" --http2 maybe 2>/dev/null; then
+  fail "--http2 maybe 를 받아들였습니다"
+fi
+if "$binary" "$port" --http2-max-streams 0 2>/dev/null; then
+  fail "--http2-max-streams 0 을 받아들였습니다"
+fi
+if "$binary" "$port" --http2-window 1000 2>/dev/null; then
+  fail "65535 보다 작은 --http2-window 를 받아들였습니다"
+fi
+
+openssl req -x509 -newkey ec -pkeyopt ec_paramgen_curve:prime256v1 -nodes -days 1 -subj "/CN=localhost" \
+  -addext "subjectAltName=DNS:localhost,IP:127.0.0.1" \
+  -keyout "$work_dir/key.pem" -out "$work_dir/cert.pem" 2>/dev/null
+cert="$work_dir/cert.pem"
+key="$work_dir/key.pem"
+
+mkdir -p "$work_dir/root"
+head -c 3000000 /dev/urandom > "$work_dir/root/big.bin"
+printf 'tiny file\n' > "$work_dir/root/small.txt"
+for _ in $(seq 200); do printf 'compressible line for http2\n'; done > "$work_dir/root/text.txt"
+head -c 5000 /dev/urandom > "$work_dir/upload.bin"
+
+# 프레임 클라이언트 도우미. 요청 헤더는 허프만/색인 없는 리터럴로만 쓰고, 응답 헤더 블록은 풀지 않는다.
+# 200 은 정적 테이블 색인 8(0x88) 한 바이트로 오므로 상태는 블록 첫 바이트로 본다.
+cat > "$work_dir/h2client.py" <<'PY'
+import re
+import socket
+import struct
+
+PREFACE = b"PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n"
+DATA, HEADERS, RST_STREAM, SETTINGS, PING, GOAWAY, WINDOW_UPDATE = 0, 1, 3, 4, 6, 7, 8
+END_STREAM, ACK, END_HEADERS = 0x1, 0x1, 0x4
+STATUS_200 = 0x88
+
+
+def frame(kind, flags, stream, payload=b""):
+    return struct.pack(">I", len(payload))[1:] + bytes([kind, flags]) + struct.pack(">I", stream) + payload
+
+
+def literal(name, value):
+    name, value = name.encode(), value.encode()
+    return bytes([0, len(name)]) + name + bytes([len(value)]) + value
+
+
+def request(stream, path, method="GET", headers=(), end_stream=True):
+    block = b"".join(literal(n, v) for n, v in
+                     [(":method", method), (":scheme", "http"), (":path", path), (":authority", "h2.test")]
+                     + list(headers))
+    return frame(HEADERS, END_HEADERS | (END_STREAM if end_stream else 0), stream, block)
+
+
+def settings(**values):
+    ids = {"initial_window": 0x4, "max_frame": 0x5}
+    return frame(SETTINGS, 0, 0, b"".join(struct.pack(">HI", ids[k], v) for k, v in values.items()))
+
+
+class Connection:
+    def __init__(self, port, client_settings=b""):
+        self.sock = socket.create_connection(("127.0.0.1", port), timeout=10)
+        self.pending = b""
+        self.sock.sendall(PREFACE + (client_settings or frame(SETTINGS, 0, 0)))
+
+    def send(self, data):
+        self.sock.sendall(data)
+
+    def read_frame(self):
+        while True:
+            if len(self.pending) >= 9:
+                length = int.from_bytes(self.pending[:3], "big")
+                if len(self.pending) >= 9 + length:
+                    head, self.pending = self.pending[:9 + length], self.pending[9 + length:]
+                    return head[3], head[4], int.from_bytes(head[5:9], "big") & 0x7fffffff, head[9:]
+            chunk = self.sock.recv(262144)
+            if not chunk:
+                return None
+            self.pending += chunk
+
+    def close(self):
+        self.sock.close()
+
+
+def responses(conn, streams, on_frame=None):
+    """streams 의 응답이 모두 끝날 때까지 프레임을 읽는다. 스트림별 (상태 바이트, 본문, 끝난 순서)를 돌려준다."""
+    result = {s: [None, b"", None] for s in streams}
+    order = 0
+    while any(r[2] is None for r in result.values()):
+        item = conn.read_frame()
+        if item is None:
+            raise SystemExit("응답 도중 연결이 닫혔습니다: %r" % {s: r[2] for s, r in result.items()})
+        kind, flags, stream, payload = item
+        if on_frame is not None:
+            on_frame(kind, flags, stream, payload)
+        if stream not in result:
+            continue
+        if kind == HEADERS:
+            result[stream][0] = payload[0]
+        elif kind == DATA:
+            result[stream][1] += payload
+        elif kind == RST_STREAM:
+            code = struct.unpack(">I", payload)[0]
+            if result[stream][2] is None:
+                result[stream][0] = ("reset", code)
+        if (kind in (HEADERS, DATA) and flags & END_STREAM) or (kind == RST_STREAM and result[stream][2] is None):
+            result[stream][2] = order
+            order += 1
+    return result
+
+
+def metrics(port):
+    with socket.create_connection(("127.0.0.1", port), timeout=5) as sock:
+        sock.sendall(b"GET /metrics HTTP/1.1\r\nHost: h2.test\r\nConnection: close\r\n\r\n")
+        body = b""
+        while True:
+            chunk = sock.recv(65536)
+            if not chunk:
+                break
+            body += chunk
+    values = {}
+    for line in body.decode().splitlines():
+        match = re.match(r'webserv_(http2_\w+|connections_accepted)_total(?:\{\w+="(\w+)"\})? (\d+)$', line)
+        if match:
+            name = match.group(1) + ("." + match.group(2) if match.group(2) else "")
+            values[name] = values.get(name, 0) + int(match.group(3))
+    if "http2_connections.prior_knowledge" not in values or "http2_streams.refused" not in values:
+        raise SystemExit("HTTP/2 계측이 없습니다: %r" % values)
+    return values
+PY
+
+# 1) 기본 설정(HTTP/2 켬), 워커 1개, TLS 리스너
+"$binary" "$port" --unlimited --workers 1 --demo-routes --root "$work_dir/root" --compression-level 6 \
+  --tls-port "$tls_port" --tls-cert "$cert" --tls-key "$key" &
+server_pid=$!
+sleep 0.3
+
+version_of() {
+  curl -s -o "$work_dir/body" -w '%{http_version} %{http_code}' "$@"
+}
+
+[ "$(version_of --http2-prior-knowledge "http://127.0.0.1:$port/health")" = "2 200" ] \
+  || fail "prior knowledge /health 가 HTTP/2 200 이 아닙니다"
+grep -q "status: ok" "$work_dir/body" || fail "prior knowledge /health 본문이 다릅니다"
+[ "$(version_of --http2 "http://127.0.0.1:$port/small.txt")" = "2 200" ] || fail "h2c 업그레이드가 HTTP/2 가 아닙니다"
+[ "$(cat "$work_dir/body")" = "tiny file" ] || fail "h2c 업그레이드로 받은 파일이 다릅니다"
+[ "$(version_of -k --http2 "https://127.0.0.1:$tls_port/big.bin")" = "2 200" ] || fail "ALPN 이 h2 를 고르지 않았습니다"
+cmp -s "$work_dir/body" "$work_dir/root/big.bin" || fail "HTTP/2 로 받은 큰 파일이 다릅니다"
+[ "$(version_of -k --http1.1 "https://127.0.0.1:$tls_port/health")" = "1.1 200" ] \
+  || fail "TLS 에서 http/1.1 을 고른 클라이언트가 HTTP/1.1 로 받지 못했습니다"
+[ "$(version_of --http2-prior-knowledge --compressed "http://127.0.0.1:$port/text.txt")" = "2 200" ] \
+  || fail "HTTP/2 압축 응답이 200 이 아닙니다"
+cmp -s "$work_dir/body" "$work_dir/root/text.txt" || fail "HTTP/2 압축 응답을 풀어도 원본과 다릅니다"
+[ "$(version_of --http2-prior-knowledge --data-binary @"$work_dir/upload.bin" "http://127.0.0.1:$port/upload")" = "2 200" ] \
+  || fail "HTTP/2 업로드가 200 이 아닙니다"
+crc=$(python -c "import sys, zlib; print('%08x' % zlib.crc32(open(sys.argv[1], 'rb').read()))" "$work_dir/upload.bin")
+grep -q "received: 5000" "$work_dir/body" && grep -q "crc32: $crc" "$work_dir/body" || fail "HTTP/2 업로드 결과가 다릅니다"
+[ "$(version_of --http2-prior-knowledge "http://127.0.0.1:$port/sleep/10")" = "1.1 200" ] \
+  || fail "코루틴 라우트가 HTTP/1.1 로 다시 보내지지 않았습니다"
+
+# 한 연결 다중화: /delay/300 8개를 한 TLS 연결의 스트림으로 보낸다. 작업 스레드 4개라 직렬이면 2.4초다.
+accepted_before=$(PYTHONPATH="$work_dir" python -c "import sys; from h2client import metrics; print(metrics(int(sys.argv[1]))['connections_accepted'])" "$port")
+start=$(date +%s%N)
+urls=()
+for _ in $(seq 8); do urls+=("https://127.0.0.1:$tls_port/delay/300" -o /dev/null); done
+curl -sk --no-progress-meter --http2 --parallel --parallel-max 8 -w '%{http_version} %{http_code}\n' "${urls[@]}" > "$work_dir/parallel.out"
+elapsed_ms=$((($(date +%s%N) - start) / 1000000))
+[ "$(grep -c '^2 200$' "$work_dir/parallel.out")" -eq 8 ] || fail "다중화 응답이 모두 HTTP/2 200 이 아닙니다: $(cat "$work_dir/parallel.out")"
+[ "$elapsed_ms" -lt 1500 ] || fail "다중화한 /delay 8개가 동시에 처리되지 않았습니다: ${elapsed_ms}ms"
+
+PYTHONPATH="$work_dir" python - "$port" "$accepted_before" "$work_dir/root/big.bin" <<'PY'
+import hashlib
+import struct
+import sys
+import time
+
+from h2client import (DATA, END_STREAM, GOAWAY, HEADERS, PING, RST_STREAM, SETTINGS, ACK, STATUS_200,
+                      WINDOW_UPDATE, Connection, frame, metrics, request, responses, settings)
+
+port, accepted_before, big = int(sys.argv[1]), int(sys.argv[2]), sys.argv[3]
+before = metrics(port)
+if before["connections_accepted"] - accepted_before != 2:
+    # 다중화 curl 연결 하나와 metrics 연결 하나
+    sys.exit("다중화가 연결 하나를 쓰지 않았습니다: %d" % (before["connections_accepted"] - accepted_before))
+
+# 느린 스트림(작업 스레드) 뒤의 빠른 스트림이 먼저 끝난다. PING 과 SETTINGS 에 ACK 로 답한다.
+conn = Connection(port)
+conn.send(request(1, "/delay/300") + request(3, "/health") + frame(PING, 0, 0, b"12345678"))
+seen = {"ping": False, "settings_ack": False}
+
+def watch(kind, flags, stream, payload):
+    if kind == PING and flags & ACK and payload == b"12345678":
+        seen["ping"] = True
+    if kind == SETTINGS and flags & ACK:
+        seen["settings_ack"] = True
+
+result = responses(conn, [1, 3], watch)
+if result[3][2] != 0 or result[1][2] != 1:
+    sys.exit("빠른 스트림이 느린 스트림을 기다렸습니다: %r" % result)
+if result[1][0] != STATUS_200 or result[1][1] != b"delayed: 300 ms\n" or result[3][1] != b"status: ok\n":
+    sys.exit("끼워 넣은 응답이 다릅니다: %r" % result)
+if not seen["ping"] or not seen["settings_ack"]:
+    sys.exit("PING/SETTINGS ACK 를 받지 못했습니다: %r" % seen)
+
+# Content-Length 가 제한(1MB)을 넘으면 413 으로 답하고 남은 본문은 RST_STREAM(NO_ERROR)로 그만 받는다.
+conn.send(request(5, "/upload", "POST", [("content-length", "5000000")], end_stream=False)
+          + frame(DATA, 0, 5, b"x" * 1000))
+reset = []
+result = responses(conn, [5], lambda k, f, s, p: reset.append(p) if k == RST_STREAM and s == 5 else None)
+if result[5][0] == STATUS_200 or result[5][1] != b"Request body too large\n":
+    sys.exit("큰 Content-Length 에 413 으로 답하지 않았습니다: %r" % result)
+time.sleep(0.1)
+conn.send(frame(PING, 0, 0, b"87654321"))
+while True:
+    kind, flags, stream, payload = conn.read_frame()
+    if kind == RST_STREAM and stream == 5:
+        reset.append(payload)
+    if kind == PING:
+        break
+if reset != [struct.pack(">I", 0)]:
+    sys.exit("413 뒤에 RST_STREAM(NO_ERROR)을 보내지 않았습니다: %r" % reset)
+
+# 클라이언트 GOAWAY: 진행 중인 스트림은 마치고 연결을 닫는다.
+conn.send(request(7, "/delay/100") + frame(GOAWAY, 0, 0, struct.pack(">II", 0, 0)))
+result = responses(conn, [7])
+if result[7][1] != b"delayed: 100 ms\n":
+    sys.exit("GOAWAY 뒤 진행 중인 스트림을 마치지 않았습니다: %r" % result)
+if conn.read_frame() is not None:
+    sys.exit("GOAWAY 를 받고 스트림이 끝났는데 연결을 닫지 않았습니다")
+conn.close()
+
+# 작은 흐름 제어 창: 스트림 창 1000, 연결 창 65535 를 넘지 않고 받은 만큼만 돌려준다.
+conn = Connection(port, settings(initial_window=1000))
+conn.send(request(1, "/big.bin"))
+stream_window, connection_window, body, frames = 1000, 65535, b"", 0
+while True:
+    kind, flags, stream, payload = conn.read_frame()
+    if kind != DATA:
+        continue
+    frames += 1
+    stream_window -= len(payload)
+    connection_window -= len(payload)
+    if stream_window < 0 or connection_window < 0:
+        sys.exit("흐름 제어 창을 넘겨 보냈습니다: stream=%d conn=%d" % (stream_window, connection_window))
+    body += payload
+    if flags & END_STREAM:
+        break
+    if len(payload) > 0:
+        conn.send(frame(WINDOW_UPDATE, 0, 1, struct.pack(">I", len(payload)))
+                  + frame(WINDOW_UPDATE, 0, 0, struct.pack(">I", len(payload))))
+        stream_window += len(payload)
+        connection_window += len(payload)
+if hashlib.sha256(body).digest() != hashlib.sha256(open(big, "rb").read()).digest():
+    sys.exit("작은 창으로 받은 큰 파일이 다릅니다")
+if frames < 3000:
+    sys.exit("창 1000 인데 DATA 프레임이 너무 적습니다: %d" % frames)
+conn.close()
+
+# 잘못된 프레임: 프리페이스 뒤 첫 프레임이 SETTINGS 가 아니면 PROTOCOL_ERROR(1),
+# 최대 크기(16384)를 넘는 프레임은 FRAME_SIZE_ERROR(6) 로 GOAWAY 를 보내고 닫는다.
+for payload, code in ((frame(PING, 0, 0, b"12345678"), 1), (frame(DATA, 0, 1, b"x" * 20000), 6)):
+    conn = Connection(port, payload)
+    goaway = None
+    while True:
+        item = conn.read_frame()
+        if item is None:
+            break
+        if item[0] == GOAWAY:
+            goaway = struct.unpack(">II", item[3][:8])[1]
+    if goaway != code:
+        sys.exit("잘못된 프레임에 GOAWAY(%d)를 보내지 않았습니다: %r" % (code, goaway))
+    conn.close()
+
+after = metrics(port)
+if after["http2_connections.prior_knowledge"] - before["http2_connections.prior_knowledge"] != 4:
+    sys.exit("prior knowledge 연결 수가 다릅니다: %r" % after)
+if after["http2_connections.alpn"] < 2 or after["http2_connections.upgrade"] < 1:
+    sys.exit("ALPN/업그레이드 연결 계측이 다릅니다: %r" % after)
+completed = after["http2_streams.completed"] - before["http2_streams.completed"]
+if completed != 5:
+    sys.exit("완료한 스트림 수가 다릅니다: %d" % completed)
+if after["http2_streams.local_reset"] < 1:
+    sys.exit("HTTP_1_1_REQUIRED 로 닫은 스트림을 세지 않았습니다: %r" % after)
+PY
+stop_server
+
+# 2) 동시 스트림 상한 2: 세 번째 스트림은 REFUSED_STREAM(7) 으로 닫고 앞의 둘은 답한다.
+"$binary" "$port" --unlimited --workers 1 --demo-routes --http2-max-streams 2 &
+server_pid=$!
+sleep 0.3
+
+PYTHONPATH="$work_dir" python - "$port" <<'PY'
+import sys
+
+from h2client import STATUS_200, Connection, metrics, request, responses
+
+port = int(sys.argv[1])
+conn = Connection(port)
+conn.send(request(1, "/delay/200") + request(3, "/delay/200") + request(5, "/health"))
+result = responses(conn, [1, 3, 5])
+if result[5][0] != ("reset", 7):
+    sys.exit("상한을 넘는 스트림을 REFUSED_STREAM 으로 닫지 않았습니다: %r" % result)
+if result[1][0] != STATUS_200 or result[3][0] != STATUS_200:
+    sys.exit("상한 안의 스트림이 200 이 아닙니다: %r" % result)
+# 앞의 스트림이 끝났으니 다시 보내면 받는다.
+conn.send(request(7, "/health"))
+if responses(conn, [7])[7][1] != b"status: ok\n":
+    sys.exit("자리가 난 뒤 새 스트림을 받지 않았습니다")
+conn.close()
+if metrics(port)["http2_streams.refused"] != 1:
+    sys.exit("거절한 스트림 계측이 다릅니다")
+PY
+stop_server
+
+# 3) `--http2 off`: 업그레이드 요청과 ALPN 모두 HTTP/1.1 로 남는다.
+"$binary" "$port" --unlimited --workers 1 --http2 off --tls-port "$tls_port" --tls-cert "$cert" --tls-key "$key" &
+server_pid=$!
+sleep 0.3
+
+[ "$(version_of --http2 "http://127.0.0.1:$port/health")" = "1.1 200" ] || fail "--http2 off 인데 업그레이드했습니다"
+[ "$(version_of -k --http2 "https://127.0.0.1:$tls_port/health")" = "1.1 200" ] || fail "--http2 off 인데 ALPN 이 h2 를 골랐습니다"
+if curl -s -o /dev/null --http2-prior-knowledge "http://127.0.0.1:$port/health"; then
+  fail "--http2 off 인데 prior knowledge 연결에 HTTP/2 로 답했습니다"
+fi
+stop_server
+
+echo "webserv v1.23.0 HTTP/2 테스트 통과"
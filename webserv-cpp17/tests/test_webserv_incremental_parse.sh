@@ -0,0 +1,62 @@
+#!/usr/bin/env bash
+# webserv-cpp17 v1.3.0 테스트: 여러 조각으로 나뉘어 도착한 요청을 증분 파서가 이어서 해석하는지,
+# 헤더 이름을 대소문자 구분 없이 찾는지, 형식이 잘못된 요청 라인에 400 을 돌려주는지 검증한다.
+set -euo pipefail
+
+if [ "$#" -ne 1 ]; then
+  echo "사용법: test_webserv_incremental_parse.sh <webserv_binary>" >&2
+  exit 1
+fi
+
+binary="$1"
+port=9096
+max_requests=2
+
+"$binary" "$port" "$max_requests" &
+server_pid=$!
+
+cleanup() {
+  if kill -0 "$server_pid" 2>/dev/null; then
+    kill "$server_pid"
+    wait "$server_pid" || true
+  fi
+}
+trap cleanup EXIT
+
+sleep 0.2
+
+python - <<PY
+import socket
+import sys
+import time
+
+def read_all(s):
+    data = b""
+    while True:
+        chunk = s.recv(4096)
+        if not chunk:
+            return data
+        data += chunk
+
+s = socket.create_connection(("127.0.0.1", ${port}))
+for piece in (b"GET /hel", b"lo HTTP/1.1\r\nHO", b"ST: split.test\r\nConnection: close\r", b"\n\r\n"):
+    s.sendall(piece)
+    time.sleep(0.05)
+data = read_all(s)
+s.close()
+if b"200 OK" not in data or b"Host: split.test" not in data:
+    print("조각난 요청 응답이 예상과 다릅니다.", file=sys.stderr)
+    print(data, file=sys.stderr)
+    sys.exit(1)
+
+s = socket.create_connection(("127.0.0.1", ${port}))
+s.sendall(b"BROKEN\r\nHost: bad.test\r\n\r\n")
+data = read_all(s)
+s.close()
+if b"400 Bad Request" not in data:
+    print("잘못된 요청 라인에 400 이 반환되지 않았습니다.", file=sys.stderr)
+    print(data, file=sys.stderr)
+    sys.exit(1)
+PY
+
+echo "webserv v1.3.0 증분 파서 테스트 통과"
@@ -0,0 +1,116 @@
+#!/usr/bin/env bash
+# webserv-cpp17 v1.11.0 테스트: `--io-backend uring` 으로 띄운 서버가 기존 시나리오(keep-alive, 파이프라이닝,
+# 느린 클라이언트 백프레셔, 정적 파일, 타임아웃, 연결 교체, 요청 본문(v1.12.0), 라우터(v1.13.0), 응답 압축(v1.14.0), 응답 캐시(v1.15.0), 리버스 프록시(v1.16.0), 핸들러 작업 스레드(v1.17.0), 코루틴 핸들러(v1.18.0), 수락 경로 옵션(v1.20.0), 접근 로그(v1.21.0), TLS 리스너(v1.22.0, epoll 로 대신하는지), HTTP/2(v1.23.0), 설정 다시 읽기와 무중단 업그레이드(v1.25.0) 등)를 epoll 백엔드와 똑같이 통과하는지,
+# 제공 버퍼 수(1024)보다 많은 연결이 한꺼번에 요청을 보내도 모두 응답하는지 검증한다.
+# 커널이 io_uring 을 허용하지 않으면 건너뛴다(종료 코드 77).
+set -euo pipefail
+
+if [ "$#" -ne 1 ]; then
+  echo "사용법: test_webserv_io_uring.sh <webserv_binary>" >&2
+  exit 1
+fi
+
+binary="$1"
+tests_dir="$(cd "$(dirname "$0")" && pwd)"
+port=9104
+work_dir="$(mktemp -d)"
+server_pid=""
+
+cleanup() {
+  if [ -n "$server_pid" ] && kill -0 "$server_pid" 2>/dev/null; then
+    kill "$server_pid"
+    wait "$server_pid" || true
+  fi
+  rm -rf "$work_dir"
+}
+trap cleanup EXIT
+
+# 기존 테스트 스크립트가 그대로 쓸 수 있도록 옵션을 덧붙여 실행하는 래퍼를 만든다.
+wrapper="$work_dir/webserv-uring"
+cat > "$wrapper" <<EOF
+#!/usr/bin/env bash
+exec "$binary" "\$@" --io-backend uring
+EOF
+chmod +x "$wrapper"
+
+"$wrapper" "$port" 1 --max-runtime-sec 1 2> "$work_dir/probe.log" || true
+if grep -q "epoll 로 대신합니다" "$work_dir/probe.log"; then
+  echo "io_uring 을 쓸 수 없는 환경이라 건너뜁니다: $(head -n 1 "$work_dir/probe.log")"
+  exit 77
+fi
+
+scenarios=(
+  test_webserv.sh
+  test_webserv_multi.sh
+  test_webserv_host_header.sh
+  test_webserv_keepalive.sh
+  test_webserv_dynamic.sh
+  test_webserv_epoll_many.sh
+  test_webserv_workers.sh
+  test_webserv_incremental_parse.sh
+  test_webserv_pipeline_depth.sh
+  test_webserv_slow_reader.sh
+  test_webserv_static_files.sh
+  test_webserv_metrics.sh
+  test_webserv_timeouts.sh
+  test_webserv_connection_churn.sh
+  test_webserv_request_body.sh
+  test_webserv_router.sh
+  test_webserv_compression.sh
+  test_webserv_response_cache.sh
+  test_webserv_proxy.sh
+  test_webserv_offload.sh
+  test_webserv_coroutine.sh
+  test_webserv_accept.sh
+  test_webserv_access_log.sh
+  test_webserv_tls.sh
+  test_webserv_http2.sh
+  test_webserv_reload.sh
+)
+for scenario in "${scenarios[@]}"; do
+  if ! "$tests_dir/$scenario" "$wrapper" > "$work_dir/scenario.log" 2>&1; then
+    echo "io_uring 백엔드에서 $scenario 실패" >&2
+    cat "$work_dir/scenario.log" >&2
+    exit 1
+  fi
+done
+
+connections=1500
+pipelined=4
+"$wrapper" "$port" $((connections * pipelined)) --idle-timeout-ms 10000 --max-runtime-sec 30 &
+server_pid=$!
+sleep 0.2
+
+python - <<PY
+import resource
+import socket
+import sys
+
+soft, hard = resource.getrlimit(resource.RLIMIT_NOFILE)
+resource.setrlimit(resource.RLIMIT_NOFILE, (hard, hard))
+count = min(${connections}, hard - 64)
+
+# 연결을 모두 연 뒤 한꺼번에 요청을 보낸다. 수신 완료가 제공 버퍼 수보다 많이 몰리면
+# 일부는 -ENOBUFS 로 끝나고, 버퍼가 돌아올 때 다시 걸려야 한다.
+sockets = [socket.create_connection(("127.0.0.1", ${port}), timeout=10) for _ in range(count)]
+for i, s in enumerate(sockets):
+    burst = b"".join(b"GET / HTTP/1.1\r\nHost: c%d-%d.test\r\n\r\n" % (i, j) for j in range(${pipelined} - 1))
+    burst += b"GET / HTTP/1.1\r\nHost: c%d-last.test\r\nConnection: close\r\n\r\n" % i
+    s.sendall(burst)
+
+for i, s in enumerate(sockets):
+    data = b""
+    while True:
+        chunk = s.recv(65536)
+        if not chunk:
+            break
+        data += chunk
+    s.close()
+    if data.count(b"HTTP/1.1 200 OK") != ${pipelined} or not data.endswith(b"Host: c%d-last.test\nConnection: close\n" % i):
+        print("연결 %d 의 응답이 예상과 다릅니다: %r" % (i, data[-200:]), file=sys.stderr)
+        sys.exit(1)
+PY
+
+wait "$server_pid"
+server_pid=""
+echo "webserv v1.11.0 io_uring 백엔드 테스트 통과"
@@ -0,0 +1,100 @@
+#!/usr/bin/env bash
+# webserv-cpp17 v1.7.0 테스트: /metrics 가 워커별 계측을 합산해 Prometheus 텍스트 형식으로 내보내는지 검증한다.
+# 경로/상태별 요청 수, 연결 수, 바이트 수, 지연 히스토그램의 일관성을 확인한다.
+set -euo pipefail
+
+if [ "$#" -ne 1 ]; then
+  echo "사용법: test_webserv_metrics.sh <webserv_binary>" >&2
+  exit 1
+fi
+
+binary="$1"
+port=9100
+max_requests=11
+
+"$binary" "$port" "$max_requests" --workers 2 &
+server_pid=$!
+
+cleanup() {
+  if kill -0 "$server_pid" 2>/dev/null; then
+    kill "$server_pid"
+    wait "$server_pid" || true
+  fi
+}
+trap cleanup EXIT
+
+sleep 0.2
+
+python - <<PY
+import re
+import socket
+import sys
+import time
+
+def exchange(raw):
+    s = socket.create_connection(("127.0.0.1", ${port}), timeout=5)
+    s.sendall(raw)
+    data = b""
+    while True:
+        chunk = s.recv(65536)
+        if not chunk:
+            break
+        data += chunk
+    s.close()
+    return data
+
+def get(path, method="GET"):
+    return exchange(("%s %s HTTP/1.1\r\nHost: metrics.test\r\nConnection: close\r\n\r\n" % (method, path)).encode())
+
+def fail(message):
+    print(message, file=sys.stderr)
+    sys.exit(1)
+
+for _ in range(5):
+    get("/health")
+for i in range(3):
+    get("/page-%d" % i)
+get("/health", method="POST")
+exchange(b"BROKEN\r\n\r\n")
+time.sleep(0.05)
+
+body = get("/metrics").split(b"\r\n\r\n", 1)[1].decode()
+
+samples = {}
+for line in body.splitlines():
+    if line.startswith("#") or not line:
+        continue
+    name, value = line.rsplit(" ", 1)
+    samples[name] = float(value)
+
+expected = {
+    'webserv_requests_total{route="health",code="200"}': 5,
+    'webserv_requests_total{route="default",code="200"}': 3,
+    'webserv_requests_total{route="error",code="405"}': 1,
+    'webserv_requests_total{route="error",code="400"}': 1,
+    "webserv_connections_accepted_total": 11,
+    "webserv_connections_active": 1,
+    "webserv_request_duration_seconds_count": 10,
+    'webserv_request_duration_seconds_bucket{le="+Inf"}': 10,
+}
+for name, value in expected.items():
+    if samples.get(name) != value:
+        fail("%s 값이 예상과 다릅니다: %r" % (name, samples.get(name)))
+
+if samples["webserv_received_bytes_total"] <= 0 or samples["webserv_sent_bytes_total"] <= 0:
+    fail("송수신 바이트 수가 기록되지 않았습니다")
+
+buckets = [(float(re.search(r'le="([^"]+)"', k).group(1)), v) for k, v in samples.items()
+           if k.startswith("webserv_request_duration_seconds_bucket")]
+counts = [v for _, v in sorted(buckets)]
+if counts != sorted(counts):
+    fail("히스토그램 버킷이 누적 형태가 아닙니다")
+
+p50 = samples['webserv_request_duration_quantile_seconds{quantile="0.5"}']
+p99 = samples['webserv_request_duration_quantile_seconds{quantile="0.99"}']
+if not (0 < p50 <= p99 < 1.0):
+    fail("지연 분위수가 올바르지 않습니다: p50=%r p99=%r" % (p50, p99))
+PY
+
+wait "$server_pid"
+echo "webserv v1.7.0 메트릭 테스트 통과"
@@ -0,0 +1,274 @@
+#!/usr/bin/env bash
+# webserv-cpp17 v1.17.0 테스트: 블로킹 핸들러를 작업 스레드 풀에 맡기는 경로를 검증한다.
+# - /delay/:ms 가 작업 스레드에서 돌아 응답하고, 잘못된 값은 404 인지
+# - 스레드와 대기 자리(--handler-threads 2 --handler-queue 2)가 차면 나머지 요청은 기다리지 않고 바로 503 인지
+# - 느린 핸들러가 풀을 채운 동안에도 같은 워커의 /health 지연이 작게 유지되는지
+# - 작업 결과를 기다리는 동안 파이프라이닝된 다음 요청이 앞지르지 않고 순서대로 응답되는지
+# - 결과를 기다리던 연결이 먼저 닫혀도 서버가 계속 동작하는지, 계측 값이 맞는지
+# - 작업 스레드보다 워커가 많아 주인 스레드가 없는 deque 의 작업도 다른 스레드가 훔쳐 와 끝내는지
+# - --handler-threads 0 이면 워커 스레드에서 부르지 않고 바로 503 으로 답하는지
+# - --demo-routes 없이 띄우면 /delay 가 등록되지 않는지
+set -euo pipefail
+
+if [ "$#" -ne 1 ]; then
+  echo "사용법: test_webserv_offload.sh <webserv_binary>" >&2
+  exit 1
+fi
+
+binary="$1"
+port=9114
+server_pid=""
+
+start_server() {
+  "$binary" "$port" 100000 --workers 1 --max-runtime-sec 30 "$@" &
+  server_pid=$!
+  sleep 0.2
+}
+
+stop_server() {
+  if [ -n "$server_pid" ] && kill -0 "$server_pid" 2>/dev/null; then
+    kill "$server_pid"
+    wait "$server_pid" || true
+  fi
+  server_pid=""
+  # io_uring 백엔드는 프로세스가 끝난 뒤에 리슨 소켓을 닫는다. 다음 서버가 바인드하기 전에 기다린다.
+  for _ in $(seq 1 40); do
+    (exec 3<>"/dev/tcp/127.0.0.1/$port") 2>/dev/null || break
+    sleep 0.05
+  done
+}
+
+trap stop_server EXIT
+
+start_server --demo-routes --handler-threads 2 --handler-queue 2
+
+python - <<PY
+import http.client
+import socket
+import sys
+import threading
+import time
+
+PORT = ${port}
+
+def fail(message):
+    print(message, file=sys.stderr)
+    sys.exit(1)
+
+def get(path, conn=None):
+    own = conn is None
+    if own:
+        conn = http.client.HTTPConnection("127.0.0.1", PORT, timeout=10)
+    started = time.monotonic()
+    conn.request("GET", path)
+    response = conn.getresponse()
+    body = response.read()
+    elapsed = time.monotonic() - started
+    if own:
+        conn.close()
+    return response.status, body, elapsed
+
+status, body, elapsed = get("/delay/50")
+if status != 200 or body != b"delayed: 50 ms\n" or elapsed < 0.045:
+    fail("/delay/50 응답이 이상합니다: %d %r %.3fs" % (status, body, elapsed))
+for path in ("/delay/abc", "/delay/20000", "/delay/-1"):
+    status, body, _ = get(path)
+    if status != 404 or body != b"Not found\n":
+        fail("%s 는 404 여야 합니다: %d %r" % (path, status, body))
+
+# 스레드 2개 + 대기 2개가 차면 나머지 6개는 바로 503 이다.
+results = []
+lock = threading.Lock()
+
+def slow(index):
+    result = get("/delay/800")
+    with lock:
+        results.append(result)
+
+threads = [threading.Thread(target=slow, args=(i,)) for i in range(10)]
+for thread in threads:
+    thread.start()
+    time.sleep(0.01)
+
+# 풀이 찬 동안 같은 워커의 /health 는 느린 핸들러를 기다리지 않는다.
+time.sleep(0.05)
+health = http.client.HTTPConnection("127.0.0.1", PORT, timeout=5)
+samples = []
+for _ in range(200):
+    status, body, elapsed = get("/health", health)
+    if status != 200:
+        fail("/health 실패: %d" % status)
+    samples.append(elapsed)
+health.close()
+samples.sort()
+p99 = samples[int(len(samples) * 0.99) - 1]
+if p99 > 0.05:
+    fail("풀이 찬 동안 /health p99 가 큽니다: %.1fms" % (p99 * 1000))
+
+for thread in threads:
+    thread.join()
+ok = [r for r in results if r[0] == 200]
+rejected = [r for r in results if r[0] == 503]
+if len(ok) != 4 or len(rejected) != 6:
+    fail("200 4개와 503 6개를 기대했습니다: %r" % sorted(r[0] for r in results))
+if any(r[1] != b"Service unavailable\n" or r[2] > 0.3 for r in rejected):
+    fail("503 은 기다리지 않고 바로 와야 합니다: %r" % [(r[1], round(r[2], 3)) for r in rejected])
+if any(r[1] != b"delayed: 800 ms\n" for r in ok):
+    fail("느린 응답 본문이 이상합니다: %r" % [r[1] for r in ok])
+if max(r[2] for r in ok) < 1.5:
+    fail("대기 자리의 요청은 앞선 작업이 끝난 뒤 돌아야 합니다: %r" % [round(r[2], 3) for r in ok])
+
+# 파이프라이닝: 작업 결과를 기다리는 동안 뒤의 /health 가 먼저 나가지 않는다.
+sock = socket.create_connection(("127.0.0.1", PORT), timeout=5)
+sock.sendall(b"GET /delay/150 HTTP/1.1\r\nHost: t\r\n\r\n"
+             b"GET /health HTTP/1.1\r\nHost: t\r\n\r\n"
+             b"GET /delay/1 HTTP/1.1\r\nHost: t\r\nConnection: close\r\n\r\n")
+data = b""
+while True:
+    chunk = sock.recv(65536)
+    if not chunk:
+        break
+    data += chunk
+sock.close()
+first = data.find(b"delayed: 150 ms")
+second = data.find(b"status: ok")
+third = data.find(b"delayed: 1 ms")
+if not (0 <= first < second < third) or data.count(b"HTTP/1.1 200 OK") != 3:
+    fail("파이프라이닝된 응답 순서가 틀렸습니다: %r" % data)
+
+# 결과를 기다리던 연결이 먼저 닫혀도 서버는 계속 동작한다. 반쯤 닫기와 구분할 수 없으므로 결과는 쓰고 닫는다.
+for _ in range(3):
+    sock = socket.create_connection(("127.0.0.1", PORT), timeout=5)
+    sock.sendall(b"GET /delay/100 HTTP/1.1\r\nHost: t\r\n\r\n")
+    sock.close()
+time.sleep(0.4)
+status, _, _ = get("/health")
+if status != 200:
+    fail("닫힌 연결의 작업 뒤 서버가 응답하지 않습니다")
+
+status, body, _ = get("/metrics")
+text = body.decode()
+# /delay/50, 404 세 개, 200 네 개, 파이프라인 두 개, 끊긴 연결 세 개
+expected = {
+    'webserv_offload_jobs_total{result="completed"}': 13,
+    'webserv_offload_jobs_total{result="rejected"}': 6,
+    'webserv_requests_total{route="delay",code="200"}': 10,
+    'webserv_requests_total{route="delay",code="404"}': 3,
+    'webserv_requests_total{route="delay",code="503"}': 6,
+}
+for name, value in expected.items():
+    if "%s %d\n" % (name, value) not in text:
+        fail("%s 가 %d 가 아닙니다:\n%s" % (name, value, text))
+PY
+
+stop_server
+# 워커 4개에 스레드 2개면 deque 2, 3 에는 주인 스레드가 없다. 그 워커로 간 작업은 훔쳐 와야만 끝난다.
+start_server --demo-routes --workers 4 --handler-threads 2 --handler-queue 16
+
+python - <<PY
+import http.client
+import sys
+import threading
+import time
+
+PORT = ${port}
+
+def fail(message):
+    print(message, file=sys.stderr)
+    sys.exit(1)
+
+results = []
+lock = threading.Lock()
+
+def slow():
+    conn = http.client.HTTPConnection("127.0.0.1", PORT, timeout=10)
+    conn.request("GET", "/delay/100")
+    response = conn.getresponse()
+    body = response.read()
+    with lock:
+        results.append((response.status, body))
+    conn.close()
+
+started = time.monotonic()
+threads = [threading.Thread(target=slow) for _ in range(16)]
+for thread in threads:
+    thread.start()
+for thread in threads:
+    thread.join()
+elapsed = time.monotonic() - started
+if len(results) != 16 or any(r != (200, b"delayed: 100 ms\n") for r in results):
+    fail("모든 /delay 가 200 이어야 합니다: %r" % results)
+# 스레드 2개가 100ms 작업 16개를 나눠 하면 0.8초 이상 걸린다.
+if elapsed < 0.75:
+    fail("작업이 스레드 수보다 많이 동시에 돌았습니다: %.3fs" % elapsed)
+
+conn = http.client.HTTPConnection("127.0.0.1", PORT, timeout=5)
+per_worker = []
+for worker in range(4):
+    conn.request("GET", "/metrics/workers/%d" % worker)
+    text = conn.getresponse().read().decode()
+    for line in text.splitlines():
+        if line.startswith('webserv_offload_jobs_total{result="completed"}'):
+            per_worker.append(int(line.split()[-1]))
+conn.close()
+if len(per_worker) != 4 or sum(per_worker) != 16:
+    fail("워커별 완료 작업 수가 이상합니다: %r" % per_worker)
+if per_worker[2] + per_worker[3] == 0:
+    fail("주인 스레드가 없는 워커로 간 연결이 없습니다(연결 분배를 확인하세요): %r" % per_worker)
+PY
+
+stop_server
+start_server --demo-routes --handler-threads 0
+
+python - <<PY
+import http.client
+import sys
+import time
+
+PORT = ${port}
+
+def fail(message):
+    print(message, file=sys.stderr)
+    sys.exit(1)
+
+# 작업 스레드가 없으면 블로킹 핸들러를 워커 스레드에서 부르지 않고 바로 거절한다.
+conn = http.client.HTTPConnection("127.0.0.1", PORT, timeout=5)
+started = time.monotonic()
+conn.request("GET", "/delay/400")
+response = conn.getresponse()
+body = response.read()
+elapsed = time.monotonic() - started
+if response.status != 503 or body != b"Service unavailable\n" or elapsed > 0.2:
+    fail("--handler-threads 0 에서 /delay 는 바로 503 이어야 합니다: %d %r %.3fs" % (response.status, body, elapsed))
+conn.request("GET", "/health")
+response = conn.getresponse()
+if response.status != 200 or response.read() != b"status: ok\n":
+    fail("503 뒤 같은 연결의 /health 가 실패했습니다")
+
+conn.request("GET", "/metrics")
+text = conn.getresponse().read().decode()
+if 'webserv_offload_jobs_total{result="completed"} 0\n' not in text or \
+   'webserv_requests_total{route="delay",code="503"} 1\n' not in text:
+    fail("풀 없는 거절 계측이 이상합니다:\n%s" % text)
+PY
+
+stop_server
+start_server
+
+python - <<PY
+import http.client
+import sys
+
+PORT = ${port}
+
+# 예시 경로는 --demo-routes 로 켤 때만 있다. 없으면 다른 GET 처럼 기본 응답이다.
+conn = http.client.HTTPConnection("127.0.0.1", PORT, timeout=5)
+conn.request("GET", "/delay/400")
+response = conn.getresponse()
+body = response.read()
+if response.status != 200 or b"delayed" in body or not body.startswith(b"Hello from webserv"):
+    print("--demo-routes 없이 /delay 가 등록되었습니다: %d %r" % (response.status, body), file=sys.stderr)
+    sys.exit(1)
+PY
+
+echo "webserv v1.17.0 핸들러 작업 스레드 테스트 통과"
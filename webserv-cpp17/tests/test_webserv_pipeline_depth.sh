@@ -0,0 +1,57 @@
+#!/usr/bin/env bash
+# webserv-cpp17 v1.4.0 테스트: 한 연결에 128개 요청을 파이프라이닝으로 보냈을 때
+# 입력 버퍼가 여러 번 정리/확장되어도 모든 요청이 순서대로 응답되는지 검증한다.
+set -euo pipefail
+
+if [ "$#" -ne 1 ]; then
+  echo "사용법: test_webserv_pipeline_depth.sh <webserv_binary>" >&2
+  exit 1
+fi
+
+binary="$1"
+port=9097
+max_requests=128
+
+"$binary" "$port" "$max_requests" &
+server_pid=$!
+
+cleanup() {
+  if kill -0 "$server_pid" 2>/dev/null; then
+    kill "$server_pid"
+    wait "$server_pid" || true
+  fi
+}
+trap cleanup EXIT
+
+sleep 0.2
+
+python - <<PY
+import socket
+import sys
+
+padding = b"X-Padding: " + b"p" * 500 + b"\r\n"
+requests = b""
+for i in range(${max_requests}):
+    connection = b"close" if i == ${max_requests} - 1 else b"keep-alive"
+    requests += (b"GET /req-%d HTTP/1.1\r\nHost: pipe-%d.test\r\n" % (i, i)) + padding + \
+        b"Connection: " + connection + b"\r\n\r\n"
+
+s = socket.create_connection(("127.0.0.1", ${port}))
+s.sendall(requests)
+received = b""
+s.settimeout(5)
+while True:
+    chunk = s.recv(65536)
+    if not chunk:
+        break
+    received += chunk
+s.close()
+
+hosts = [line for line in received.split(b"\n") if line.startswith(b"Host: pipe-")]
+expected = [b"Host: pipe-%d.test" % i for i in range(${max_requests})]
+if hosts != expected:
+    print("파이프라이닝 응답 수 또는 순서가 예상과 다릅니다: %d개" % len(hosts), file=sys.stderr)
+    sys.exit(1)
+PY
+
+echo "webserv v1.4.0 파이프라이닝 깊이 테스트 통과"
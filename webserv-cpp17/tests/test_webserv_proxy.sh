@@ -0,0 +1,355 @@
+#!/usr/bin/env bash
+# webserv-cpp17 v1.16.0 테스트: 리버스 프록시(--proxy)와 업스트림 keep-alive 연결 풀을 검증한다.
+# - 경로 접두사에 맞는 요청이 업스트림으로 가고, Host 는 그대로, X-Real-IP/X-Forwarded-For 는 클라이언트 주소로 채워지는지
+# - 업스트림 연결을 요청마다 새로 맺지 않고 풀에서 재사용하는지, 라운드 로빈/least-conn 으로 서버를 고르는지
+# - Content-Length/chunked 요청 본문과 큰 chunked 응답, 길이 없는 HTTP/1.0 업스트림 응답, HEAD 를 그대로 옮기는지
+# - chunked 를 모르는 HTTP/1.0 클라이언트에는 풀어서 보내는지
+# - 업스트림이 없으면 502, 응답이 늦으면 504, 풀에서 꺼낸 연결이 닫혀 있으면 새 연결로 한 번 다시 보내는지
+# - 내장 라우트(/health)는 `--proxy /` 보다 우선하는지
+set -euo pipefail
+
+if [ "$#" -ne 1 ]; then
+  echo "사용법: test_webserv_proxy.sh <webserv_binary>" >&2
+  exit 1
+fi
+
+binary="$1"
+port=9109
+upstream_a=9110
+upstream_b=9111
+down_port=9113
+work_dir="$(mktemp -d)"
+server_pid=""
+upstream_pid=""
+
+# 두 포트에서 도는 HTTP/1.1 업스트림. 요청 정보를 JSON 으로 돌려주고, 맺은 연결 수를 /stats 로 알려 준다.
+cat > "$work_dir/upstream.py" <<'PY'
+import hashlib
+import json
+import sys
+import threading
+import time
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+from urllib.parse import parse_qs, urlsplit
+
+
+def make_handler(name, stats):
+    class Handler(BaseHTTPRequestHandler):
+        protocol_version = "HTTP/1.1"
+
+        def setup(self):
+            super().setup()
+            stats["connections"] += 1
+            self.doomed = False
+
+        def log_message(self, *args):
+            pass
+
+        def read_body(self):
+            if self.headers.get("Transfer-Encoding", "").lower() == "chunked":
+                data = b""
+                while True:
+                    size = int(self.rfile.readline().split(b";")[0], 16)
+                    if size == 0:
+                        while self.rfile.readline() not in (b"\r\n", b""):
+                            pass
+                        return data, True
+                    data += self.rfile.read(size)
+                    self.rfile.readline()
+            length = int(self.headers.get("Content-Length", "0"))
+            return self.rfile.read(length), False
+
+        def reply(self, body, content_type="application/json"):
+            self.send_response(200)
+            self.send_header("Content-Type", content_type)
+            self.send_header("Content-Length", str(len(body)))
+            self.end_headers()
+            if self.command != "HEAD":
+                self.wfile.write(body)
+
+        def handle_request(self):
+            if self.doomed:
+                # 풀에 들어간 뒤 업스트림이 조용히 닫은 연결을 흉내 낸다. 응답 없이 닫는다.
+                self.close_connection = True
+                return
+            url = urlsplit(self.path)
+            query = parse_qs(url.query)
+            body, chunked = self.read_body()
+            if url.path.endswith("/slow"):
+                time.sleep(int(query["ms"][0]) / 1000)
+            elif url.path.endswith("/hang"):
+                time.sleep(int(query["ms"][0]) / 1000)
+            elif url.path.endswith("/stream"):
+                total = int(query["n"][0])
+                self.send_response(200)
+                self.send_header("Content-Type", "application/octet-stream")
+                self.send_header("Transfer-Encoding", "chunked")
+                self.end_headers()
+                sent = 0
+                while sent < total:
+                    size = min(65536, total - sent)
+                    self.wfile.write(b"%x\r\n" % size + bytes([65 + sent % 26]) * size + b"\r\n")
+                    sent += size
+                self.wfile.write(b"0\r\n\r\n")
+                return
+            elif url.path.endswith("/close10"):
+                self.wfile.write(b"HTTP/1.0 200 OK\r\nContent-Type: text/plain\r\n\r\nclose delimited body\n")
+                self.close_connection = True
+                return
+            elif url.path.endswith("/drop"):
+                self.doomed = True
+            info = {
+                "server": name,
+                "method": self.command,
+                "path": self.path,
+                "host": self.headers.get("Host"),
+                "real_ip": self.headers.get("X-Real-IP"),
+                "forwarded_for": self.headers.get("X-Forwarded-For"),
+                "connection": self.headers.get("Connection"),
+                "expect": self.headers.get("Expect"),
+                "body_length": len(body),
+                "body_sha": hashlib.sha256(body).hexdigest(),
+                "chunked": chunked,
+            }
+            self.reply(json.dumps(info).encode())
+
+        def do_GET(self):
+            if self.path == "/stats":
+                self.reply(json.dumps(stats).encode())
+                return
+            self.handle_request()
+
+        do_POST = do_GET
+        do_HEAD = do_GET
+
+    return Handler
+
+
+servers = []
+for index, port in enumerate(sys.argv[1:]):
+    stats = {"connections": 0}
+    server = ThreadingHTTPServer(("127.0.0.1", int(port)), make_handler("ab"[index], stats))
+    server.daemon_threads = True
+    threading.Thread(target=server.serve_forever, daemon=True).start()
+    servers.append(server)
+print("ready", flush=True)
+threading.Event().wait()
+PY
+
+start_server() {
+  "$binary" "$port" 100000 --workers 1 --max-runtime-sec 60 "$@" &
+  server_pid=$!
+  sleep 0.2
+}
+
+stop_server() {
+  if [ -n "$server_pid" ] && kill -0 "$server_pid" 2>/dev/null; then
+    kill "$server_pid"
+    wait "$server_pid" || true
+  fi
+  server_pid=""
+  # io_uring 백엔드는 프로세스가 끝난 뒤에 리슨 소켓을 닫는다. 다음 서버가 바인드하기 전에 기다린다.
+  for _ in $(seq 1 40); do
+    (exec 3<>"/dev/tcp/127.0.0.1/$port") 2>/dev/null || break
+    sleep 0.05
+  done
+}
+
+cleanup() {
+  stop_server
+  if [ -n "$upstream_pid" ] && kill -0 "$upstream_pid" 2>/dev/null; then
+    kill "$upstream_pid"
+    wait "$upstream_pid" 2>/dev/null || true
+  fi
+  rm -rf "$work_dir"
+}
+trap cleanup EXIT
+
+python "$work_dir/upstream.py" "$upstream_a" "$upstream_b" > "$work_dir/upstream.log" 2>&1 &
+upstream_pid=$!
+for _ in $(seq 1 50); do
+  grep -q ready "$work_dir/upstream.log" && break
+  sleep 0.1
+done
+
+start_server --proxy "/api=127.0.0.1:$upstream_a,127.0.0.1:$upstream_b" --proxy "/solo=127.0.0.1:$upstream_a" \
+  --proxy "/down=127.0.0.1:$down_port" --proxy-timeout-ms 500
+
+python - <<PY
+import hashlib
+import http.client
+import json
+import socket
+import sys
+import time
+
+port = ${port}
+
+def fail(message):
+    print(message, file=sys.stderr)
+    sys.exit(1)
+
+def upstream_connections(upstream_port):
+    conn = http.client.HTTPConnection("127.0.0.1", upstream_port, timeout=5)
+    conn.request("GET", "/stats")
+    return json.loads(conn.getresponse().read())["connections"]
+
+conn = http.client.HTTPConnection("127.0.0.1", port, timeout=5)
+
+def request(method, path, body=None, headers=None):
+    chunked = (headers or {}).get("Transfer-Encoding") == "chunked"
+    conn.request(method, path, body=body, headers=headers or {}, encode_chunked=chunked)
+    response = conn.getresponse()
+    return response.status, {k.lower(): v for k, v in response.getheaders()}, response.read()
+
+def echo(path, headers=None, method="GET", body=None):
+    status, response_headers, data = request(method, path, body, headers)
+    if status != 200:
+        fail("%s %s 가 200 이 아닙니다: %d %r" % (method, path, status, data))
+    return json.loads(data), response_headers
+
+# 기본 프록시: 경로/쿼리 유지, Host 유지, X-Real-IP/X-Forwarded-For, 홉 단위 헤더 제거
+info, headers = echo("/api/echo?x=1", {"Host": "example.test", "X-Real-IP": "6.6.6.6",
+                                        "X-Forwarded-For": "10.0.0.1", "Keep-Alive": "timeout=5"})
+if info["path"] != "/api/echo?x=1" or info["host"] != "example.test":
+    fail("경로나 Host 가 바뀌었습니다: %r" % info)
+if info["real_ip"] != "127.0.0.1" or info["forwarded_for"] != "10.0.0.1, 127.0.0.1":
+    fail("X-Real-IP/X-Forwarded-For 가 이상합니다: %r" % info)
+if info["connection"] != "keep-alive":
+    fail("업스트림 요청은 keep-alive 여야 합니다: %r" % info)
+if headers.get("connection") != "keep-alive":
+    fail("클라이언트 응답의 Connection 이 이상합니다: %r" % headers)
+
+# 라운드 로빈과 연결 재사용
+before = upstream_connections(${upstream_a}) + upstream_connections(${upstream_b})
+servers = [echo("/api/echo")[0]["server"] for _ in range(40)]
+if any(servers[i] == servers[i + 1] for i in range(len(servers) - 1)):
+    fail("라운드 로빈이 아닙니다: %r" % servers)
+after = upstream_connections(${upstream_a}) + upstream_connections(${upstream_b})
+# /stats 요청 두 번이 각각 연결 하나를 쓴다.
+if after - before - 2 > 2:
+    fail("업스트림 연결을 재사용하지 않습니다: 요청 40개에 연결 %d개" % (after - before - 2))
+
+# Content-Length 와 chunked 요청 본문
+payload = bytes(range(256)) * 2048
+info, _ = echo("/api/echo", method="POST", body=payload, headers={"Content-Type": "application/octet-stream"})
+if info["body_length"] != len(payload) or info["body_sha"] != hashlib.sha256(payload).hexdigest():
+    fail("Content-Length 본문이 그대로 가지 않았습니다: %r" % info)
+def chunks():
+    for offset in range(0, len(payload), 70000):
+        yield payload[offset:offset + 70000]
+info, _ = echo("/api/echo", method="POST", body=chunks(), headers={"Transfer-Encoding": "chunked"})
+if not info["chunked"] or info["body_sha"] != hashlib.sha256(payload).hexdigest():
+    fail("chunked 본문이 그대로 가지 않았습니다: %r" % info)
+info, _ = echo("/api/echo", method="POST", body=b"small", headers={"Expect": "100-continue"})
+if info["expect"] is not None or info["body_length"] != 5:
+    fail("Expect 는 프록시가 처리해야 합니다: %r" % info)
+
+# 큰 chunked 응답 스트리밍
+status, headers, data = request("GET", "/api/stream?n=3000000")
+if status != 200 or len(data) != 3000000 or headers.get("transfer-encoding") != "chunked":
+    fail("chunked 응답 스트리밍이 이상합니다: %d %d %r" % (status, len(data), headers))
+
+# HEAD 는 본문 없이
+status, headers, data = request("HEAD", "/api/echo")
+if status != 200 or data != b"" or int(headers.get("content-length", "0")) == 0:
+    fail("HEAD 응답이 이상합니다: %d %r" % (status, headers))
+
+# 길이 없는 HTTP/1.0 업스트림 응답은 연결 종료로 끝을 알린다
+status, headers, data = request("GET", "/api/close10")
+if status != 200 or data != b"close delimited body\n" or headers.get("connection") != "close":
+    fail("HTTP/1.0 업스트림 응답이 이상합니다: %d %r %r" % (status, headers, data))
+conn.close()
+
+# HTTP/1.0 클라이언트에는 chunked 를 풀어서 보낸다
+raw = socket.create_connection(("127.0.0.1", port), timeout=5)
+raw.sendall(b"GET /api/stream?n=200000 HTTP/1.0\r\n\r\n")
+received = b""
+while True:
+    chunk = raw.recv(65536)
+    if not chunk:
+        break
+    received += chunk
+raw.close()
+head, _, body = received.partition(b"\r\n\r\n")
+if b"chunked" in head.lower() or len(body) != 200000:
+    fail("HTTP/1.0 클라이언트 응답이 이상합니다: %r %d" % (head, len(body)))
+
+# 업스트림이 없으면 502, 연결은 유지
+status, _, data = request("GET", "/down/x")
+if status != 502 or data != b"Bad gateway\n":
+    fail("업스트림이 없으면 502 여야 합니다: %d %r" % (status, data))
+info, _ = echo("/api/echo")
+
+# 응답이 늦으면 504
+started = time.time()
+status, _, data = request("GET", "/api/hang?ms=2000")
+if status != 504 or data != b"Gateway timeout\n" or time.time() - started > 1.5:
+    fail("늦은 업스트림은 504 여야 합니다: %d %r" % (status, data))
+conn.close()
+
+# 업스트림이 조용히 닫은 풀 연결은 새 연결로 한 번 다시 보낸다
+conn = http.client.HTTPConnection("127.0.0.1", port, timeout=5)
+echo("/solo/drop")
+info, _ = echo("/solo/echo")
+if info["server"] != "a":
+    fail("/solo 는 업스트림 a 로만 가야 합니다: %r" % info)
+
+status, _, metrics = request("GET", "/metrics")
+values = {}
+for line in metrics.decode().splitlines():
+    if line and not line.startswith("#"):
+        name, value = line.rsplit(" ", 1)
+        values[name] = float(value)
+if values.get('webserv_requests_total{route="proxy",code="200"}', 0) < 45:
+    fail("프록시 요청 계측이 부족합니다: %r" % values)
+for result, minimum in (("reused", 30), ("retried", 1), ("failed", 2)):
+    if values.get('webserv_upstream_connections_total{result="%s"}' % result, 0) < minimum:
+        fail("업스트림 연결 계측(%s)이 부족합니다: %r" % (result, values))
+if values.get('webserv_connection_timeouts_total{phase="upstream"}', 0) < 1:
+    fail("업스트림 타임아웃 계측이 없습니다: %r" % values)
+PY
+
+stop_server
+start_server --proxy "/=127.0.0.1:$upstream_a,127.0.0.1:$upstream_b" --proxy-balance least-conn
+
+python - <<PY
+import http.client
+import json
+import sys
+import threading
+
+port = ${port}
+
+def fail(message):
+    print(message, file=sys.stderr)
+    sys.exit(1)
+
+def get(path):
+    conn = http.client.HTTPConnection("127.0.0.1", port, timeout=5)
+    conn.request("GET", path)
+    response = conn.getresponse()
+    return response.status, response.read()
+
+status, body = get("/health")
+if status != 200 or body != b"status: ok\n":
+    fail("내장 라우트는 --proxy / 보다 우선해야 합니다: %d %r" % (status, body))
+status, body = get("/anything/echo")
+if status != 200 or json.loads(body)["path"] != "/anything/echo":
+    fail("내장 라우트에 없는 경로는 업스트림으로 가야 합니다: %d %r" % (status, body))
+
+slow = {}
+def slow_request():
+    slow["result"] = get("/slow?ms=800")
+thread = threading.Thread(target=slow_request)
+thread.start()
+import time
+time.sleep(0.2)
+servers = [json.loads(get("/echo")[1])["server"] for _ in range(6)]
+thread.join()
+slow_server = json.loads(slow["result"][1])["server"]
+if any(server == slow_server for server in servers):
+    fail("least-conn 은 느린 요청을 맡은 서버를 피해야 합니다: slow=%s %r" % (slow_server, servers))
+PY
+
+echo "webserv v1.16.0 리버스 프록시 테스트 통과"
@@ -0,0 +1,458 @@
+#!/usr/bin/env bash
+# webserv-cpp17 v1.25.0 테스트: 설정 파일, SIGHUP 다시 읽기, 리슨 소켓을 넘기는 무중단 업그레이드를 검증한다.
+# - `--config`: 파일의 지시어로 뜨고 명령행 옵션이 파일을 덮는지, 틀린 지시어·값을 받지 않는 지시어·파일 안의
+#   config 는 `경로:줄:` 과 함께 시작 전에 거절하는지
+# - SIGHUP: 프록시 라우트와 유휴 타임아웃이 재시작 없이 바뀌는지, 재시작해야 하는 옵션(workers)은 경고만 남기는지,
+#   틀린 파일이면 이전 설정으로 계속 받는지(webserv_config_generation, webserv_config_reloads_total{result})
+# - `--control-socket/--takeover`: 요청을 보내는 도중 새 프로세스가 리슨 소켓을 넘겨받아도 실패한 요청이 없고,
+#   진행 중이던 느린 요청은 `Connection: close` 로 끝나며, 이전 프로세스는 남은 연결이 닫히면 끝나는지.
+#   제어 소켓이 없으면 새 프로세스가 시작하지 않는지
+# - SIGQUIT: 새 연결은 받지 않고, 유지 중인 HTTP/1 연결은 다음 응답에 `Connection: close`, HTTP/2 연결은 GOAWAY
+#   를 받은 뒤 프로세스가 스스로 끝나는지
+set -euo pipefail
+
+if [ "$#" -ne 1 ]; then
+  echo "사용법: test_webserv_reload.sh <webserv_binary>" >&2
+  exit 1
+fi
+
+binary="$1"
+reload_port=9133
+upgrade_port=9134
+drain_port=9135
+upstream_a=9136
+upstream_b=9137
+server_pid=""
+new_pid=""
+upstream_pid=""
+work_dir="$(mktemp -d)"
+
+cleanup() {
+  for pid in "$server_pid" "$new_pid" "$upstream_pid"; do
+    if [ -n "$pid" ] && kill -0 "$pid" 2>/dev/null; then
+      kill "$pid"
+      wait "$pid" || true
+    fi
+  done
+  rm -rf "$work_dir"
+}
+trap cleanup EXIT
+
+fail() {
+  echo "$1" >&2
+  exit 1
+}
+
+stop_server() {
+  kill "$server_pid"
+  wait "$server_pid" || true
+  server_pid=""
+}
+
+# 프로세스가 스스로 끝나기를 최대 $2 초 기다린다. 끝났으면 종료 코드를 돌려준다.
+wait_exit() {
+  local pid="$1" seconds="$2"
+  for _ in $(seq 1 $((seconds * 10))); do
+    if ! kill -0 "$pid" 2>/dev/null; then
+      wait "$pid"
+      return
+    fi
+    sleep 0.1
+  done
+  fail "프로세스 $pid 가 ${seconds}초 안에 끝나지 않았습니다"
+}
+
+# 시작 전에 거절해야 하는 설정
+printf 'port %s\nbogus 1\n' "$reload_port" > "$work_dir/bad.conf"
+if "$binary" --config "$work_dir/bad.conf" 2> "$work_dir/bad.log"; then
+  fail "알 수 없는 지시어가 든 설정 파일을 받아들였습니다"
+fi
+grep -q "bad.conf:2:" "$work_dir/bad.log" || fail "거절 메시지에 줄 번호가 없습니다: $(cat "$work_dir/bad.log")"
+printf 'unlimited yes\n' > "$work_dir/flag.conf"
+if "$binary" --config "$work_dir/flag.conf" 2>/dev/null; then
+  fail "값을 받지 않는 지시어에 값을 붙여도 받아들였습니다"
+fi
+printf 'config %s\n' "$work_dir/bad.conf" > "$work_dir/nested.conf"
+if "$binary" --config "$work_dir/nested.conf" 2>/dev/null; then
+  fail "설정 파일 안의 config 를 받아들였습니다"
+fi
+if "$binary" --config "$work_dir/missing.conf" 2>/dev/null; then
+  fail "없는 설정 파일을 받아들였습니다"
+fi
+if "$binary" "$reload_port" --drain-timeout-ms soon 2>/dev/null; then
+  fail "숫자가 아닌 --drain-timeout-ms 를 받아들였습니다"
+fi
+if "$binary" "$reload_port" --takeover "$work_dir/nobody.sock" 2>/dev/null; then
+  fail "넘겨줄 프로세스가 없는데 --takeover 로 시작했습니다"
+fi
+
+cat > "$work_dir/client.py" <<'PY'
+import re
+import socket
+import threading
+
+
+def connect(port):
+    sock = socket.create_connection(("127.0.0.1", port), timeout=5)
+    sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+    return sock
+
+
+def read_response(sock, pending):
+    while b"\r\n\r\n" not in pending:
+        chunk = sock.recv(65536)
+        if not chunk:
+            raise ConnectionError("응답 도중 연결이 닫혔습니다: %r" % pending)
+        pending += chunk
+    head, _, rest = pending.partition(b"\r\n\r\n")
+    length = int(re.search(rb"Content-Length: (\d+)", head, re.I).group(1))
+    while len(rest) < length:
+        chunk = sock.recv(65536)
+        if not chunk:
+            raise ConnectionError("본문 도중 연결이 닫혔습니다")
+        rest += chunk
+    return head, rest[:length], rest[length:]
+
+
+def get(sock, path="/health"):
+    sock.sendall(b"GET %s HTTP/1.1\r\nHost: reload.test\r\n\r\n" % path.encode())
+    head, body, _ = read_response(sock, b"")
+    return int(head.split(b" ", 2)[1]), head, body
+
+
+def fetch(port, path="/health"):
+    sock = connect(port)
+    try:
+        return get(sock, path)
+    finally:
+        sock.close()
+
+
+def metric(port, line):
+    _, _, body = fetch(port, "/metrics")
+    match = re.search(rb"^" + re.escape(line.encode()) + rb" (\d+)$", body, re.M)
+    return int(match.group(1)) if match else None
+
+
+def closed_by_peer(sock, seconds):
+    sock.settimeout(seconds)
+    try:
+        return sock.recv(1) == b""
+    except socket.timeout:
+        return False
+    except ConnectionResetError:
+        return True
+
+
+class Load:
+    """연결 유지 클라이언트 여럿이 쉬지 않고 /health 를 보낸다. `Connection: close` 를 받으면 다시 붙는다."""
+
+    def __init__(self, port, clients=4):
+        self.port = port
+        self.stop = threading.Event()
+        self.ok = 0
+        self.closed = 0
+        self.errors = []
+        self.lock = threading.Lock()
+        self.threads = [threading.Thread(target=self.run) for _ in range(clients)]
+        for thread in self.threads:
+            thread.start()
+
+    def run(self):
+        sock = None
+        while not self.stop.is_set():
+            try:
+                if sock is None:
+                    sock = connect(self.port)
+                status, head, _ = get(sock)
+                if status != 200:
+                    raise ConnectionError("상태 %d" % status)
+                close = b"Connection: close" in head
+                with self.lock:
+                    self.ok += 1
+                    self.closed += close
+                if close:
+                    sock.close()
+                    sock = None
+            except Exception as error:
+                with self.lock:
+                    self.errors.append(repr(error))
+                if sock is not None:
+                    sock.close()
+                sock = None
+        if sock is not None:
+            sock.close()
+
+    def finish(self):
+        self.stop.set()
+        for thread in self.threads:
+            thread.join()
+PY
+
+# 이름을 본문으로 답하는 업스트림 두 개. 라우트가 어느 쪽을 가리키는지 본문으로 구분한다.
+cat > "$work_dir/upstream.py" <<'PY'
+import sys
+import threading
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+
+def make_handler(name):
+    class Handler(BaseHTTPRequestHandler):
+        protocol_version = "HTTP/1.1"
+
+        def log_message(self, *args):
+            pass
+
+        def do_GET(self):
+            body = name.encode()
+            self.send_response(200)
+            self.send_header("Content-Length", str(len(body)))
+            self.end_headers()
+            self.wfile.write(body)
+
+    return Handler
+
+
+for name, port in (("a", sys.argv[1]), ("b", sys.argv[2])):
+    server = ThreadingHTTPServer(("127.0.0.1", int(port)), make_handler(name))
+    server.daemon_threads = True
+    threading.Thread(target=server.serve_forever, daemon=True).start()
+print("ready", flush=True)
+threading.Event().wait()
+PY
+python "$work_dir/upstream.py" "$upstream_a" "$upstream_b" > "$work_dir/upstream.log" 2>&1 &
+upstream_pid=$!
+for _ in $(seq 1 50); do
+  grep -q ready "$work_dir/upstream.log" && break
+  sleep 0.1
+done
+
+# 설정 파일로 뜨고, 명령행의 --max-header-bytes 1024 가 파일의 8192 를 덮는다.
+write_reload_conf() {
+  cat > "$work_dir/reload.conf" <<EOF
+# 다시 읽기 테스트 설정
+port $reload_port
+workers 1
+max-runtime-sec 60
+max-requests 100000
+idle-timeout-ms $1
+proxy /api=127.0.0.1:$2
+max-header-bytes 8192
+EOF
+}
+write_reload_conf 5000 "$upstream_a"
+"$binary" --config "$work_dir/reload.conf" --max-header-bytes 1024 2> "$work_dir/reload.log" &
+server_pid=$!
+sleep 0.3
+
+python - "$work_dir" "$reload_port" <<'PY'
+import sys
+
+sys.path.insert(0, sys.argv[1])
+from client import connect, fetch, metric
+
+port = int(sys.argv[2])
+status, _, body = fetch(port, "/api/x")
+if status != 200 or body != b"a":
+    raise SystemExit("설정 파일의 프록시 라우트가 적용되지 않았습니다: %d %r" % (status, body))
+sock = connect(port)
+sock.sendall(b"GET /health HTTP/1.1\r\nHost: reload.test\r\nX-Pad: " + b"p" * 2000 + b"\r\n\r\n")
+head = sock.recv(65536)
+if b" 431 " not in head.split(b"\r\n", 1)[0]:
+    raise SystemExit("명령행 --max-header-bytes 가 설정 파일 값을 덮지 않았습니다: %r" % head[:64])
+sock.close()
+if metric(port, "webserv_config_generation") != 0:
+    raise SystemExit("시작 직후 설정 세대가 0 이 아닙니다")
+PY
+
+# 라우트를 b 로, 유휴 타임아웃을 300ms 로 바꾸고, 재시작해야 바뀌는 workers 도 함께 바꾼다.
+write_reload_conf 300 "$upstream_b"
+sed -i 's/^workers 1$/workers 2/' "$work_dir/reload.conf"
+kill -HUP "$server_pid"
+sleep 0.5
+grep -q -- "--workers: 재시작" "$work_dir/reload.log" || fail "workers 변경에 경고가 없습니다: $(cat "$work_dir/reload.log")"
+
+python - "$work_dir" "$reload_port" <<'PY'
+import sys
+
+sys.path.insert(0, sys.argv[1])
+from client import closed_by_peer, connect, fetch, get, metric
+
+port = int(sys.argv[2])
+status, _, body = fetch(port, "/api/x")
+if status != 200 or body != b"b":
+    raise SystemExit("SIGHUP 뒤에도 프록시 라우트가 바뀌지 않았습니다: %d %r" % (status, body))
+if metric(port, "webserv_config_generation") != 1:
+    raise SystemExit("SIGHUP 뒤 설정 세대가 1 이 아닙니다")
+if metric(port, 'webserv_config_reloads_total{result="applied"}') != 1:
+    raise SystemExit("적용된 다시 읽기가 계측되지 않았습니다")
+sock = connect(port)
+get(sock)
+if not closed_by_peer(sock, 2.0):
+    raise SystemExit("다시 읽은 유휴 타임아웃(300ms)이 적용되지 않았습니다")
+sock.close()
+PY
+
+# 틀린 파일로 다시 읽으면 실패만 세고 이전 설정(라우트 b)으로 계속 받는다.
+echo "proxy-balance sideways" >> "$work_dir/reload.conf"
+kill -HUP "$server_pid"
+sleep 0.5
+grep -q "이전 설정을 유지합니다" "$work_dir/reload.log" || fail "다시 읽기 실패가 기록되지 않았습니다"
+python - "$work_dir" "$reload_port" <<'PY'
+import sys
+
+sys.path.insert(0, sys.argv[1])
+from client import fetch, metric
+
+port = int(sys.argv[2])
+status, _, body = fetch(port, "/api/x")
+if status != 200 or body != b"b":
+    raise SystemExit("다시 읽기에 실패한 뒤 이전 설정으로 받지 않습니다: %d %r" % (status, body))
+if metric(port, 'webserv_config_reloads_total{result="failed"}') != 1:
+    raise SystemExit("실패한 다시 읽기가 계측되지 않았습니다")
+if metric(port, "webserv_config_generation") != 1:
+    raise SystemExit("실패한 다시 읽기가 설정 세대를 올렸습니다")
+PY
+stop_server
+
+# 무중단 업그레이드: 요청을 보내는 동안 새 프로세스가 리슨 소켓을 넘겨받는다.
+control="$work_dir/control.sock"
+"$binary" "$upgrade_port" --workers 2 --unlimited --demo-routes --handler-threads 2 --idle-timeout-ms 500 \
+  --control-socket "$control" 2> "$work_dir/old.log" &
+server_pid=$!
+sleep 0.3
+[ -S "$control" ] || fail "제어 소켓이 만들어지지 않았습니다"
+
+# 느린 요청(/delay/2000)과 부하를 먼저 보내 두고, 그 사이에 새 프로세스를 띄운다.
+python - "$work_dir" "$upgrade_port" <<'PY' &
+import sys
+import threading
+import time
+
+sys.path.insert(0, sys.argv[1])
+from client import Load, connect, get
+
+port = int(sys.argv[2])
+slow = {}
+
+
+def slow_request():
+    sock = connect(port)
+    try:
+        slow["status"], slow["head"], _ = get(sock, "/delay/2000")
+    finally:
+        sock.close()
+
+
+# 느린 요청은 새 프로세스가 준비를 알린 뒤에 끝나도록 넉넉히 길게 잡는다.
+slow_thread = threading.Thread(target=slow_request)
+slow_thread.start()
+load = Load(port)
+slow_thread.join()
+time.sleep(0.3)
+load.finish()
+if load.errors:
+    raise SystemExit("업그레이드 중 실패한 요청이 있습니다: %d건, 예: %s" % (len(load.errors), load.errors[:3]))
+if load.ok < 100 or load.closed == 0:
+    raise SystemExit("업그레이드 중 부하가 이상합니다: ok=%d closed=%d" % (load.ok, load.closed))
+if slow.get("status") != 200 or b"Connection: close" not in slow["head"]:
+    raise SystemExit("진행 중이던 요청이 Connection: close 로 끝나지 않았습니다: %r" % slow)
+PY
+load_pid=$!
+sleep 0.7
+"$binary" "$upgrade_port" --workers 3 --unlimited --control-socket "$control" --takeover "$control" \
+  2> "$work_dir/new.log" &
+new_pid=$!
+wait "$load_pid"
+wait_exit "$server_pid" 5 || fail "이전 프로세스가 0 이 아닌 코드로 끝났습니다"
+server_pid=""
+kill -0 "$new_pid" 2>/dev/null || fail "새 프로세스가 살아 있지 않습니다: $(cat "$work_dir/new.log")"
+[ -S "$control" ] || fail "이전 프로세스가 새 프로세스의 제어 소켓을 지웠습니다"
+
+python - "$work_dir" "$upgrade_port" <<'PY'
+import sys
+
+sys.path.insert(0, sys.argv[1])
+from client import fetch, metric
+
+port = int(sys.argv[2])
+if fetch(port)[0] != 200:
+    raise SystemExit("새 프로세스가 응답하지 않습니다")
+if metric(port, "webserv_draining_workers") != 0:
+    raise SystemExit("새 프로세스가 drain 중으로 보입니다")
+PY
+server_pid="$new_pid"
+new_pid=""
+stop_server
+
+# SIGQUIT: 새 연결은 받지 않고, 유지 중인 연결을 마무리한 뒤 스스로 끝난다.
+"$binary" "$drain_port" --workers 1 --unlimited --idle-timeout-ms 60000 2> "$work_dir/drain.log" &
+server_pid=$!
+sleep 0.3
+python - "$work_dir" "$drain_port" "$server_pid" <<'PY'
+import os
+import signal
+import socket
+import struct
+import sys
+import time
+
+sys.path.insert(0, sys.argv[1])
+from client import closed_by_peer, connect, get
+
+port, pid = int(sys.argv[2]), int(sys.argv[3])
+PREFACE = b"PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n"
+SETTINGS, GOAWAY = 4, 7
+
+
+def frame(kind, flags, stream, payload=b""):
+    return struct.pack(">I", len(payload))[1:] + bytes([kind, flags]) + struct.pack(">I", stream) + payload
+
+
+def frame_kinds(sock, seconds):
+    sock.settimeout(seconds)
+    data, kinds = b"", []
+    try:
+        while True:
+            chunk = sock.recv(65536)
+            if not chunk:
+                break
+            data += chunk
+            while len(data) >= 9 and len(data) >= 9 + int.from_bytes(data[:3], "big"):
+                length = int.from_bytes(data[:3], "big")
+                kinds.append(data[3])
+                data = data[9 + length:]
+    except socket.timeout:
+        pass
+    return kinds
+
+
+http1 = connect(port)
+if get(http1)[0] != 200:
+    raise SystemExit("drain 전 요청이 실패했습니다")
+h2 = connect(port)
+h2.sendall(PREFACE + frame(SETTINGS, 0, 0))
+time.sleep(0.2)
+os.kill(pid, signal.SIGQUIT)
+time.sleep(0.3)
+try:
+    fresh = socket.create_connection(("127.0.0.1", port), timeout=1)
+    fresh.sendall(b"GET /health HTTP/1.1\r\nHost: reload.test\r\n\r\n")
+    if fresh.recv(65536):
+        raise SystemExit("drain 중에 새 연결을 받았습니다")
+except (ConnectionRefusedError, ConnectionResetError):
+    pass
+if GOAWAY not in frame_kinds(h2, 2.0):
+    raise SystemExit("drain 중인 HTTP/2 연결이 GOAWAY 를 받지 못했습니다")
+h2.close()
+status, head, _ = get(http1)
+if status != 200 or b"Connection: close" not in head:
+    raise SystemExit("drain 중 응답에 Connection: close 가 없습니다: %r" % head)
+if not closed_by_peer(http1, 2.0):
+    raise SystemExit("drain 중 Connection: close 뒤에 연결이 닫히지 않았습니다")
+http1.close()
+PY
+wait_exit "$server_pid" 5 || fail "drain 을 마친 프로세스가 0 이 아닌 코드로 끝났습니다"
+server_pid=""
+
+echo "설정 다시 읽기/무중단 업그레이드 테스트 통과"
@@ -0,0 +1,192 @@
+#!/usr/bin/env bash
+# webserv-cpp17 v1.12.0 테스트: 요청 본문(Content-Length, chunked)을 증분 해석해 핸들러에 흘려보내는지 검증한다.
+# - POST /upload 가 바이트 수와 CRC-32 를 돌려주고, 본문 뒤에 파이프라이닝된 요청도 이어서 처리하는지
+# - 다른 경로로 온 본문은 버리고 다음 요청으로 해석하지 않는지(본문 안의 요청 줄이 실행되지 않는지)
+# - 헤더/본문 크기 제한(431, 413), 잘못된 길이 정보(400), 지원하지 않는 전송 코딩(501), Expect: 100-continue
+# - 큰 업로드(128MB) 동안 서버 RSS 가 본문 크기와 무관하게 거의 늘지 않는지
+# - --demo-routes 없이 띄우면 /upload 가 없는 경로와 같은지
+set -euo pipefail
+
+if [ "$#" -ne 1 ]; then
+  echo "사용법: test_webserv_request_body.sh <webserv_binary>" >&2
+  exit 1
+fi
+
+binary="$1"
+port=9105
+
+"$binary" "$port" 1000 --demo-routes --idle-timeout-ms 5000 --max-runtime-sec 60 \
+  --max-header-bytes 8192 --max-body-bytes 1073741824 &
+server_pid=$!
+
+cleanup() {
+  if kill -0 "$server_pid" 2>/dev/null; then
+    kill "$server_pid"
+    wait "$server_pid" || true
+  fi
+}
+trap cleanup EXIT
+
+sleep 0.2
+
+python - <<PY
+import socket
+import sys
+import time
+import zlib
+
+PORT = ${port}
+PID = ${server_pid}
+
+def fail(message):
+    print(message, file=sys.stderr)
+    sys.exit(1)
+
+def connect():
+    s = socket.create_connection(("127.0.0.1", PORT), timeout=10)
+    s.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+    return s
+
+def read_all(s):
+    data = b""
+    while True:
+        try:
+            chunk = s.recv(65536)
+        except ConnectionResetError:
+            break
+        if not chunk:
+            break
+        data += chunk
+    s.close()
+    return data
+
+def exchange(raw):
+    s = connect()
+    s.sendall(raw)
+    return read_all(s)
+
+def upload_reply(body):
+    return b"received: %d\ncrc32: %08x\n" % (len(body), zlib.crc32(body))
+
+def rss_kb(field):
+    with open("/proc/%d/status" % PID) as f:
+        for line in f:
+            if line.startswith(field + ":"):
+                return int(line.split()[1])
+    return 0
+
+# 1. Content-Length 업로드 뒤에 파이프라이닝된 요청
+body = bytes(range(256)) * 40
+raw = (b"POST /upload HTTP/1.1\r\nHost: body.test\r\nContent-Length: %d\r\n\r\n" % len(body) + body +
+       b"GET /health HTTP/1.1\r\nHost: body.test\r\nConnection: close\r\n\r\n")
+data = exchange(raw)
+if data.count(b"HTTP/1.1 200 OK") != 2 or upload_reply(body) not in data or not data.endswith(b"status: ok\n"):
+    fail("Content-Length 업로드 응답이 예상과 다릅니다: %r" % data[-300:])
+
+# 2. chunked 업로드를 한 바이트씩 나눠 보낸다(청크 확장, 트레일러 포함)
+pieces = [b"hello ", b"streaming ", b"x" * 5000, b"world"]
+chunked = b"".join(b"%x;ext=1\r\n" % len(p) + p + b"\r\n" for p in pieces) + b"0\r\nX-Trailer: yes\r\n\r\n"
+s = connect()
+s.sendall(b"POST /upload HTTP/1.1\r\nHost: body.test\r\nTransfer-Encoding: chunked\r\nConnection: close\r\n\r\n")
+for i in range(0, len(chunked), 97):
+    s.sendall(chunked[i:i + 97])
+    time.sleep(0.001)
+data = read_all(s)
+if upload_reply(b"".join(pieces)) not in data:
+    fail("chunked 업로드 응답이 예상과 다릅니다: %r" % data)
+
+# 3. 다른 경로의 본문은 버린다. 본문 안의 요청 줄을 다음 요청으로 해석하면 안 된다.
+smuggled = b"GET /health HTTP/1.1\r\nHost: evil\r\n\r\n"
+raw = (b"POST /health HTTP/1.1\r\nHost: body.test\r\nContent-Length: %d\r\n\r\n" % len(smuggled) + smuggled +
+       b"PUT /x HTTP/1.1\r\nHost: body.test\r\nTransfer-Encoding: chunked\r\n\r\n" +
+       b"%x\r\n" % len(smuggled) + smuggled + b"\r\n0\r\n\r\n" +
+       b"GET /after HTTP/1.1\r\nHost: after.test\r\nConnection: close\r\n\r\n")
+data = exchange(raw)
+if data.count(b"HTTP/1.1 405 Method Not Allowed") != 2 or data.count(b"HTTP/1.1 200 OK") != 1 \
+        or b"status: ok" in data or b"Host: after.test" not in data:
+    fail("버린 본문 뒤의 요청 경계가 잘못되었습니다: %r" % data)
+
+# 4. 제한과 길이 오류
+cases = [
+    (b"GET / HTTP/1.1\r\nHost: h\r\nX-Big: " + b"a" * 9000 + b"\r\n\r\n", b"431 Request Header Fields Too Large"),
+    (b"GET / HTTP/1.1\r\nHost: h\r\nX-Big: " + b"a" * 9000, b"431 Request Header Fields Too Large"),
+    (b"POST /upload HTTP/1.1\r\nHost: h\r\nContent-Length: 2147483648\r\n\r\n", b"413 Content Too Large"),
+    (b"POST /upload HTTP/1.1\r\nHost: h\r\nTransfer-Encoding: chunked\r\n\r\n40000001\r\n", b"413 Content Too Large"),
+    (b"POST /upload HTTP/1.1\r\nHost: h\r\nContent-Length: 5\r\nContent-Length: 6\r\n\r\nhello", b"400 Bad Request"),
+    (b"POST /upload HTTP/1.1\r\nHost: h\r\nContent-Length: 5\r\nTransfer-Encoding: chunked\r\n\r\n0\r\n\r\n",
+     b"400 Bad Request"),
+    (b"POST /upload HTTP/1.1\r\nHost: h\r\nContent-Length: -5\r\n\r\n", b"400 Bad Request"),
+    (b"POST /upload HTTP/1.1\r\nHost: h\r\nTransfer-Encoding: gzip, chunked\r\n\r\n", b"501 Not Implemented"),
+    (b"POST /upload HTTP/1.1\r\nHost: h\r\nTransfer-Encoding: chunked\r\n\r\nzz\r\n", b"400 Bad Request"),
+    (b"POST /upload HTTP/1.1\r\nHost: h\r\nTransfer-Encoding: chunked\r\n\r\n3\r\nabcX\r\n", b"400 Bad Request"),
+]
+for raw, expected in cases:
+    data = exchange(raw)
+    if not data.startswith(b"HTTP/1.1 " + expected) or b"Connection: close" not in data:
+        fail("%r 요청에 %r 응답을 기대했지만 %r" % (raw[:80], expected, data[:200]))
+
+# 5. Expect: 100-continue 는 본문을 보내기 전에 중간 응답을 받는다.
+s = connect()
+s.sendall(b"POST /upload HTTP/1.1\r\nHost: h\r\nContent-Length: 4\r\nExpect: 100-continue\r\nConnection: close\r\n\r\n")
+interim = s.recv(65536)
+if interim != b"HTTP/1.1 100 Continue\r\n\r\n":
+    fail("100 Continue 중간 응답이 없습니다: %r" % interim)
+s.sendall(b"data")
+data = read_all(s)
+if upload_reply(b"data") not in data:
+    fail("Expect 업로드 응답이 예상과 다릅니다: %r" % data)
+
+# 6. 128MB chunked 업로드 동안 RSS 가 본문 크기만큼 늘지 않아야 한다.
+block = bytes((i * 7) & 0xff for i in range(65536))
+total_blocks = 2048
+rss_before = rss_kb("VmRSS")
+s = connect()
+s.sendall(b"POST /upload HTTP/1.1\r\nHost: h\r\nTransfer-Encoding: chunked\r\nConnection: close\r\n\r\n")
+crc = 0
+frame = b"%x\r\n" % len(block) + block + b"\r\n"
+for _ in range(total_blocks):
+    s.sendall(frame)
+    crc = zlib.crc32(block, crc)
+s.sendall(b"0\r\n\r\n")
+data = read_all(s)
+expected = b"received: %d\ncrc32: %08x\n" % (len(block) * total_blocks, crc)
+if expected not in data:
+    fail("큰 업로드 응답이 예상과 다릅니다: %r" % data)
+growth = rss_kb("VmHWM") - rss_before
+if growth > 8 * 1024:
+    fail("128MB 업로드 동안 서버 RSS 가 %dKB 늘었습니다" % growth)
+print("128MB 업로드 동안 서버 최대 RSS 증가: %dKB" % growth)
+PY
+
+kill "$server_pid"
+wait "$server_pid" || true
+# io_uring 백엔드는 프로세스가 끝난 뒤에 링을 정리하며 리슨 소켓을 닫는다. 다시 바인드하기 전에 기다린다.
+for _ in $(seq 1 40); do
+  (exec 3<>"/dev/tcp/127.0.0.1/$port") 2>/dev/null || break
+  sleep 0.05
+done
+
+# 7. --demo-routes 없이 띄우면 /upload 는 없는 경로다. 본문은 버리고 뒤에 파이프라이닝된 요청은 처리한다.
+"$binary" "$port" 10 --max-runtime-sec 10 &
+server_pid=$!
+sleep 0.2
+
+python - <<PY
+import socket
+import sys
+
+s = socket.create_connection(("127.0.0.1", ${port}), timeout=5)
+s.sendall(b"POST /upload HTTP/1.1\r\nHost: h\r\nContent-Length: 5\r\n\r\nhello"
+          b"GET /health HTTP/1.1\r\nHost: h\r\nConnection: close\r\n\r\n")
+data = b""
+while True:
+    chunk = s.recv(65536)
+    if not chunk:
+        break
+    data += chunk
+if not data.startswith(b"HTTP/1.1 405 ") or b"received:" in data or b"HTTP/1.1 200 " not in data:
+    print("--demo-routes 없이 /upload 가 처리되었습니다: %r" % data, file=sys.stderr)
+    sys.exit(1)
+PY
+
+echo "webserv v1.12.0 요청 본문 테스트 통과"
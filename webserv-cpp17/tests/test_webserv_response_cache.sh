@@ -0,0 +1,156 @@
+#!/usr/bin/env bash
+# webserv-cpp17 v1.15.0 테스트: 응답 캐시와 조건부 요청(ETag/If-None-Match, If-Modified-Since, 304)을 검증한다.
+# - 캐시 대상 라우트(/health, /metrics)에 ETag/Last-Modified 가 붙고, 검증자가 맞으면 본문 없는 304 로 답하는지
+# - TTL 안에서는 핸들러를 다시 부르지 않고 같은 본문을 보내며, TTL 이 지나면 새로 만드는지
+# - 본문이 그대로면 갱신 후에도 ETag 가 유지되는지, 키에 Host 가 들어가는지
+# - 정적 파일은 캐시 옵션과 상관없이 If-None-Match 로 304 를 받는지
+# - --response-cache-bytes 를 주지 않으면 동적 라우트에 검증자를 붙이지 않는지
+set -euo pipefail
+
+if [ "$#" -ne 1 ]; then
+  echo "사용법: test_webserv_response_cache.sh <webserv_binary>" >&2
+  exit 1
+fi
+
+binary="$1"
+port=9108
+root_dir="$(mktemp -d)"
+server_pid=""
+
+printf 'static body for conditional requests\n' > "$root_dir/index.html"
+
+start_server() {
+  "$binary" "$port" 1000 --root "$root_dir" --workers 1 --max-runtime-sec 30 "$@" &
+  server_pid=$!
+  sleep 0.2
+}
+
+stop_server() {
+  if [ -n "$server_pid" ] && kill -0 "$server_pid" 2>/dev/null; then
+    kill "$server_pid"
+    wait "$server_pid" || true
+  fi
+  server_pid=""
+  # io_uring 백엔드는 프로세스가 끝난 뒤에 리슨 소켓을 닫는다. 다음 서버가 바인드하기 전에 기다린다.
+  for _ in $(seq 1 40); do
+    (exec 3<>"/dev/tcp/127.0.0.1/$port") 2>/dev/null || break
+    sleep 0.05
+  done
+}
+
+cleanup() {
+  stop_server
+  rm -rf "$root_dir"
+}
+trap cleanup EXIT
+
+start_server --response-cache-bytes 65536 --response-cache-ttl-ms 300
+
+python - <<PY
+import http.client
+import sys
+import time
+
+conn = http.client.HTTPConnection("127.0.0.1", ${port}, timeout=5)
+
+def fail(message):
+    print(message, file=sys.stderr)
+    sys.exit(1)
+
+def get(path, headers=None):
+    conn.request("GET", path, headers=headers or {})
+    response = conn.getresponse()
+    return response.status, {k.lower(): v for k, v in response.getheaders()}, response.read()
+
+status, headers, body = get("/health")
+if status != 200 or body != b"status: ok\n":
+    fail("/health 응답이 이상합니다: %d %r" % (status, body))
+etag = headers.get("etag", "")
+last_modified = headers.get("last-modified", "")
+if not (etag.startswith('"') and etag.endswith('"')) or not last_modified.endswith(" GMT"):
+    fail("/health 에 ETag/Last-Modified 가 없습니다: %r" % headers)
+
+for condition in ({"If-None-Match": etag}, {"If-None-Match": 'W/"x", W/' + etag}, {"If-None-Match": "*"},
+                  {"If-Modified-Since": last_modified}):
+    status, headers, body = get("/health", condition)
+    if status != 304 or body != b"" or headers.get("etag") != etag or "content-length" in headers:
+        fail("%r 는 본문 없는 304 여야 합니다: %d %r" % (condition, status, headers))
+status, _, body = get("/health", {"If-None-Match": '"other"', "If-Modified-Since": last_modified})
+if status != 200 or body != b"status: ok\n":
+    fail("If-None-Match 가 어긋나면 If-Modified-Since 와 상관없이 200 이어야 합니다: %d" % status)
+status, _, _ = get("/health", {"If-Modified-Since": "Thu, 01 Jan 1970 00:00:00 GMT"})
+if status != 200:
+    fail("Last-Modified 보다 이른 If-Modified-Since 는 200 이어야 합니다: %d" % status)
+status, _, _ = get("/health", {"If-Modified-Since": "not a date"})
+if status != 200:
+    fail("형식이 틀린 If-Modified-Since 는 무시해야 합니다: %d" % status)
+
+# TTL 안에서는 /metrics 를 다시 만들지 않으므로 요청 수가 바뀌어도 본문이 같다.
+_, first_headers, first = get("/metrics")
+_, second_headers, second = get("/metrics")
+if first != second or first_headers["etag"] != second_headers["etag"]:
+    fail("TTL 안의 /metrics 는 캐시된 같은 본문이어야 합니다")
+status, _, _ = get("/metrics", {"If-None-Match": first_headers["etag"]})
+if status != 304:
+    fail("/metrics 도 ETag 가 맞으면 304 여야 합니다: %d" % status)
+
+time.sleep(0.4)
+_, third_headers, third = get("/metrics")
+if third == first or third_headers["etag"] == first_headers["etag"]:
+    fail("TTL 이 지나면 /metrics 를 새로 만들어야 합니다")
+
+# 본문이 그대로인 /health 는 갱신 뒤에도 ETag 가 유지되어 폴링 클라이언트가 계속 304 를 받는다.
+status, headers, _ = get("/health", {"If-None-Match": etag})
+if status != 304 or headers.get("etag") != etag:
+    fail("본문이 같으면 갱신 뒤에도 ETag 가 같아야 합니다: %d %r" % (status, headers))
+
+# 키에 Host 가 들어가므로 다른 Host 는 따로 캐시된다(본문이 같아 ETag 는 같다).
+status, headers, _ = get("/health", {"Host": "other.example"})
+if status != 200 or headers.get("etag") != etag:
+    fail("다른 Host 의 /health 응답이 이상합니다: %d %r" % (status, headers))
+
+# 404 는 캐시하지 않는다.
+status, headers, _ = get("/metrics/workers/99")
+if status != 404 or "etag" in headers:
+    fail("없는 워커 계측은 캐시하지 않은 404 여야 합니다: %d %r" % (status, headers))
+
+status, headers, body = get("/index.html")
+static_etag = headers.get("etag")
+if status != 200 or not static_etag:
+    fail("정적 파일에 ETag 가 없습니다: %r" % headers)
+status, headers, body = get("/index.html", {"If-None-Match": static_etag})
+if status != 304 or body != b"" or headers.get("etag") != static_etag:
+    fail("정적 파일도 ETag 가 맞으면 304 여야 합니다: %d %r" % (status, headers))
+
+time.sleep(0.4)
+_, _, metrics = get("/metrics")
+values = {}
+for line in metrics.decode().splitlines():
+    if line and not line.startswith("#"):
+        name, value = line.rsplit(" ", 1)
+        values[name] = float(value)
+if values.get('webserv_response_cache_total{result="hit"}', 0) < 8:
+    fail("캐시 적중 계측이 부족합니다: %r" % values)
+if values.get('webserv_response_cache_total{result="miss"}', 0) < 3:
+    fail("캐시 미스 계측이 부족합니다: %r" % values)
+if values.get('webserv_requests_total{route="health",code="304"}', 0) < 5:
+    fail("304 응답 계측이 부족합니다: %r" % values)
+PY
+
+stop_server
+start_server
+
+python - <<PY
+import http.client
+import sys
+
+conn = http.client.HTTPConnection("127.0.0.1", ${port}, timeout=5)
+conn.request("GET", "/health", headers={"If-None-Match": "*"})
+response = conn.getresponse()
+response.read()
+if response.status != 200 or response.getheader("ETag") is not None:
+    print("응답 캐시를 끄면 동적 라우트에 검증자가 없어야 합니다: %d" % response.status, file=sys.stderr)
+    sys.exit(1)
+PY
+
+echo "webserv v1.15.0 응답 캐시 테스트 통과"
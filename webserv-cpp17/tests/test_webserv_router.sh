@@ -0,0 +1,97 @@
+#!/usr/bin/env bash
+# webserv-cpp17 v1.13.0 테스트: 고정 경로 완전 해시 표와 기수 트리 라우터로 핸들러를 찾는지 검증한다.
+# - 고정 경로(/health, /metrics), 예시 경로 /upload(--demo-routes)와 매개변수 경로(/metrics/workers/:id)가 응답하는지
+# - 경로는 있지만 메서드가 다르면 405, 쿼리 문자열은 라우팅에서 빠지는지
+# - 워커별 계측을 합치면 전체 /metrics 값과 같은지
+set -euo pipefail
+
+if [ "$#" -ne 1 ]; then
+  echo "사용법: test_webserv_router.sh <webserv_binary>" >&2
+  exit 1
+fi
+
+binary="$1"
+port=9106
+
+"$binary" "$port" 1000 --workers 2 --max-runtime-sec 30 --demo-routes &
+server_pid=$!
+
+cleanup() {
+  if kill -0 "$server_pid" 2>/dev/null; then
+    kill "$server_pid"
+    wait "$server_pid" || true
+  fi
+}
+trap cleanup EXIT
+
+sleep 0.2
+
+python - <<PY
+import socket
+import sys
+
+PORT = ${port}
+
+def fail(message):
+    print(message, file=sys.stderr)
+    sys.exit(1)
+
+def request(method, path, body=b""):
+    s = socket.create_connection(("127.0.0.1", PORT), timeout=5)
+    head = "%s %s HTTP/1.1\r\nHost: router.test\r\nConnection: close\r\n" % (method, path)
+    if body:
+        head += "Content-Length: %d\r\n" % len(body)
+    s.sendall(head.encode() + b"\r\n" + body)
+    data = b""
+    while True:
+        chunk = s.recv(65536)
+        if not chunk:
+            break
+        data += chunk
+    s.close()
+    status = int(data.split(b" ", 2)[1])
+    return status, data.split(b"\r\n\r\n", 1)[1]
+
+def samples(body):
+    values = {}
+    for line in body.decode().splitlines():
+        if line and not line.startswith("#"):
+            name, value = line.rsplit(" ", 1)
+            values[name] = float(value)
+    return values
+
+cases = [
+    ("GET", "/health", 200, b"status: ok"),
+    ("GET", "/health?probe=1", 200, b"status: ok"),
+    ("GET", "/metrics", 200, b"webserv_requests_total"),
+    ("GET", "/metrics/workers/0", 200, b"webserv_requests_total"),
+    ("GET", "/metrics/workers/1?x=y", 200, b"webserv_requests_total"),
+    ("GET", "/metrics/workers/2", 404, b""),
+    ("GET", "/metrics/workers/01x", 404, b""),
+    ("POST", "/health", 405, b""),
+    ("DELETE", "/metrics/workers/0", 405, b""),
+    ("BREW", "/", 405, b""),
+    ("PUT", "/upload", 405, b""),
+    ("GET", "/upload", 405, b""),
+    ("GET", "/healthz", 200, b"Hello from webserv"),
+]
+for method, path, expected_status, expected_body in cases:
+    status, body = request(method, path)
+    if status != expected_status or expected_body not in body:
+        fail("%s %s: 상태 %d 를 기대했지만 %d, 본문 %r" % (method, path, expected_status, status, body[:120]))
+
+status, body = request("POST", "/upload", b"routed")
+if status != 200 or b"received: 6" not in body:
+    fail("POST /upload 라우팅 실패: %d %r" % (status, body))
+
+# 워커 두 개의 health 요청 수를 더하면 전체 값과 같아야 한다.
+for _ in range(20):
+    request("GET", "/health")
+key = 'webserv_requests_total{route="health",code="200"}'
+total = samples(request("GET", "/metrics")[1]).get(key, 0)
+per_worker = sum(samples(request("GET", "/metrics/workers/%d" % w)[1]).get(key, 0) for w in range(2))
+if total != per_worker or total < 22:
+    fail("워커별 health 요청 합 %s 가 전체 %s 와 다릅니다" % (per_worker, total))
+PY
+
+echo "webserv v1.13.0 라우터 테스트 통과"
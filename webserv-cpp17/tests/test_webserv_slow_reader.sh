@@ -0,0 +1,89 @@
+#!/usr/bin/env bash
+# webserv-cpp17 v1.5.0 테스트: 응답을 읽지 않는 느린 클라이언트가 요청을 대량으로 파이프라이닝해도
+# 서버가 그 연결의 수신을 멈춰(백프레셔) 다른 연결에 계속 응답하고, 나중에 모든 응답을 순서대로 보내는지 검증한다.
+set -euo pipefail
+
+if [ "$#" -ne 1 ]; then
+  echo "사용법: test_webserv_slow_reader.sh <webserv_binary>" >&2
+  exit 1
+fi
+
+binary="$1"
+port=9098
+pipelined=100000
+max_requests=$((pipelined + 1))
+
+"$binary" "$port" "$max_requests" --idle-timeout-ms 10000 --max-runtime-sec 60 &
+server_pid=$!
+
+cleanup() {
+  if kill -0 "$server_pid" 2>/dev/null; then
+    kill "$server_pid"
+    wait "$server_pid" || true
+  fi
+}
+trap cleanup EXIT
+
+sleep 0.2
+
+python - <<PY
+import socket
+import sys
+import threading
+import time
+
+count = ${pipelined}
+request = b"GET /slow HTTP/1.1\r\nHost: slow.test\r\nX-Padding: " + b"p" * 400 + b"\r\n\r\n"
+payload = request * (count - 1) + b"GET /slow HTTP/1.1\r\nHost: slow.test\r\nConnection: close\r\n\r\n"
+
+slow = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+slow.setsockopt(socket.SOL_SOCKET, socket.SO_RCVBUF, 4096)
+slow.connect(("127.0.0.1", ${port}))
+sender_done = threading.Event()
+
+def send_all():
+    slow.sendall(payload)
+    sender_done.set()
+
+sender = threading.Thread(target=send_all, daemon=True)
+sender.start()
+time.sleep(1.0)
+
+# 서버가 느린 연결의 응답을 큐에 무한정 쌓지 않으려면 그 연결의 수신을 멈춰야 하고,
+# 그 결과 클라이언트의 송신도 막혀 있어야 한다.
+if sender_done.is_set():
+    print("백프레셔가 동작하지 않아 모든 요청이 수신되었습니다", file=sys.stderr)
+    sys.exit(1)
+
+started = time.monotonic()
+other = socket.create_connection(("127.0.0.1", ${port}), timeout=2)
+other.sendall(b"GET /health HTTP/1.1\r\nHost: other.test\r\nConnection: close\r\n\r\n")
+reply = b""
+while True:
+    chunk = other.recv(4096)
+    if not chunk:
+        break
+    reply += chunk
+other.close()
+if b"status: ok" not in reply or time.monotonic() - started > 1.0:
+    print("느린 클라이언트가 막혀 있는 동안 다른 연결이 응답받지 못했습니다", file=sys.stderr)
+    sys.exit(1)
+
+slow.settimeout(10)
+received = bytearray()
+while True:
+    chunk = slow.recv(1 << 20)
+    if not chunk:
+        break
+    received += chunk
+slow.close()
+sender.join(5)
+
+responses = received.count(b"HTTP/1.1 200 OK")
+if responses != count or not received.endswith(b"Connection: close\n"):
+    print("느린 클라이언트 응답 수가 예상과 다릅니다: %d" % responses, file=sys.stderr)
+    sys.exit(1)
+PY
+
+wait "$server_pid"
+echo "webserv v1.5.0 느린 클라이언트 백프레셔 테스트 통과"
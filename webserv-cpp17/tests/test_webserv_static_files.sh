@@ -0,0 +1,104 @@
+#!/usr/bin/env bash
+# webserv-cpp17 v1.6.0 테스트: --root 문서 루트의 정적 파일을 sendfile 로 서빙하고,
+# 파일이 수정/교체되면 inotify 로 캐시가 무효화되어 새 내용이 나가는지 검증한다.
+set -euo pipefail
+
+if [ "$#" -ne 1 ]; then
+  echo "사용법: test_webserv_static_files.sh <webserv_binary>" >&2
+  exit 1
+fi
+
+binary="$1"
+port=9099
+max_requests=9
+root_dir="$(mktemp -d)"
+
+mkdir -p "$root_dir/assets"
+printf '<h1>webserv static</h1>\n' > "$root_dir/index.html"
+printf 'body { color: red; }\n' > "$root_dir/assets/site.css"
+head -c 3145728 /dev/urandom > "$root_dir/assets/large.bin"
+
+"$binary" "$port" "$max_requests" --root "$root_dir" &
+server_pid=$!
+
+cleanup() {
+  if kill -0 "$server_pid" 2>/dev/null; then
+    kill "$server_pid"
+    wait "$server_pid" || true
+  fi
+  rm -rf "$root_dir"
+}
+trap cleanup EXIT
+
+sleep 0.2
+
+python - <<PY
+import http.client
+import os
+import sys
+import time
+
+root = "${root_dir}"
+conn = http.client.HTTPConnection("127.0.0.1", ${port}, timeout=5)
+
+def get(path):
+    conn.request("GET", path)
+    response = conn.getresponse()
+    return response.status, dict(response.getheaders()), response.read()
+
+def fail(message):
+    print(message, file=sys.stderr)
+    sys.exit(1)
+
+status, headers, body = get("/index.html")
+if status != 200 or body != b"<h1>webserv static</h1>\n" or not headers.get("Content-Type", "").startswith("text/html"):
+    fail("index.html 응답이 예상과 다릅니다: %d %r" % (status, headers))
+etag = headers.get("ETag")
+if not etag:
+    fail("ETag 헤더가 없습니다")
+
+status, _, body = get("/")
+if status != 200 or body != b"<h1>webserv static</h1>\n":
+    fail("디렉터리 경로가 index.html 로 연결되지 않았습니다")
+
+status, headers, body = get("/assets/large.bin?v=1")
+with open(os.path.join(root, "assets/large.bin"), "rb") as f:
+    expected = f.read()
+if status != 200 or body != expected or headers.get("Content-Type") != "application/octet-stream":
+    fail("큰 파일 내용이 원본과 다릅니다: %d바이트" % len(body))
+
+status, _, _ = get("/../index.html")
+if status != 404:
+    fail("상위 경로 접근이 차단되지 않았습니다: %d" % status)
+
+status, _, _ = get("/missing.txt")
+if status != 404:
+    fail("없는 파일에 404 를 돌려주지 않았습니다: %d" % status)
+
+# 제자리 수정: IN_MODIFY 로 무효화되어야 한다.
+with open(os.path.join(root, "index.html"), "w") as f:
+    f.write("<h1>updated in place</h1>\n")
+time.sleep(0.2)
+status, headers, body = get("/index.html")
+if body != b"<h1>updated in place</h1>\n" or headers.get("ETag") == etag:
+    fail("수정된 파일이 반영되지 않았습니다: %r" % body)
+
+# 원자적 교체(rename): 캐시는 옛 아이노드 FD 를 들고 있으므로 디렉터리 이벤트로 무효화되어야 한다.
+status, _, _ = get("/assets/site.css")
+replacement = os.path.join(root, "assets/site.css.tmp")
+with open(replacement, "w") as f:
+    f.write("body { color: blue; }\n")
+os.rename(replacement, os.path.join(root, "assets/site.css"))
+time.sleep(0.2)
+status, headers, body = get("/assets/site.css")
+if body != b"body { color: blue; }\n" or not headers.get("Content-Type", "").startswith("text/css"):
+    fail("교체된 파일이 반영되지 않았습니다: %r" % body)
+
+status, _, body = get("/health")
+if status != 200 or body != b"status: ok\n":
+    fail("동적 경로가 정적 파일 처리에 가려졌습니다")
+conn.close()
+PY
+
+wait "$server_pid"
+echo "webserv v1.6.0 정적 파일 테스트 통과"
@@ -0,0 +1,127 @@
+#!/usr/bin/env bash
+# webserv-cpp17 v1.8.0 테스트: 헤더 수신/유휴(keep-alive)/송신 타임아웃이 단계별로 따로 적용되는지 검증한다.
+# 헤더를 조금씩 흘려 보내는 연결(slowloris)은 바이트가 계속 와도 헤더 타임아웃에 닫혀야 한다.
+set -euo pipefail
+
+if [ "$#" -ne 1 ]; then
+  echo "사용법: test_webserv_timeouts.sh <webserv_binary>" >&2
+  exit 1
+fi
+
+binary="$1"
+port=9101
+
+"$binary" "$port" 100000 --idle-timeout-ms 400 --header-timeout-ms 800 --write-timeout-ms 600 \
+  --max-runtime-sec 20 &
+server_pid=$!
+
+cleanup() {
+  if kill -0 "$server_pid" 2>/dev/null; then
+    kill "$server_pid"
+    wait "$server_pid" || true
+  fi
+}
+trap cleanup EXIT
+
+sleep 0.2
+
+python - <<PY
+import re
+import select
+import socket
+import sys
+import time
+
+def fail(message):
+    print(message, file=sys.stderr)
+    sys.exit(1)
+
+def wait_closed(s, limit=3.0):
+    # 서버가 닫을 때까지 받은 데이터는 버리고, 닫힌 시각을 돌려준다.
+    end = time.monotonic() + limit
+    while time.monotonic() < end:
+        try:
+            if not s.recv(65536):
+                return time.monotonic()
+        except ConnectionResetError:
+            return time.monotonic()
+    fail("제한 시간 안에 연결이 닫히지 않았습니다.")
+
+# 1. 아무것도 보내지 않는 연결은 유휴 타임아웃(400ms)에 닫힌다.
+s = socket.create_connection(("127.0.0.1", ${port}))
+begin = time.monotonic()
+elapsed = wait_closed(s) - begin
+s.close()
+if not 0.35 <= elapsed < 0.75:
+    fail(f"유휴 타임아웃 시각이 예상과 다릅니다: {elapsed:.3f}s")
+
+# 2. 헤더를 100ms 마다 한 줄씩 보내도 첫 바이트부터 800ms 에 닫힌다(바이트가 마감을 늘리지 않음).
+s = socket.create_connection(("127.0.0.1", ${port}))
+s.sendall(b"GET / HTTP/1.1\r\n")
+begin = time.monotonic()
+closed_at = None
+while closed_at is None and time.monotonic() - begin < 3.0:
+    readable, _, _ = select.select([s], [], [], 0.1)
+    if readable:
+        try:
+            if not s.recv(4096):
+                closed_at = time.monotonic()
+                break
+        except ConnectionResetError:
+            closed_at = time.monotonic()
+            break
+    try:
+        s.sendall(b"X-Slow: 1\r\n")
+    except (BrokenPipeError, ConnectionResetError):
+        closed_at = time.monotonic()
+s.close()
+if closed_at is None:
+    fail("헤더를 흘려 보내는 연결이 닫히지 않았습니다.")
+elapsed = closed_at - begin
+if not 0.75 <= elapsed < 1.3:
+    fail(f"헤더 수신 타임아웃 시각이 예상과 다릅니다: {elapsed:.3f}s")
+
+# 3. 응답을 받은 뒤 다음 요청이 없으면 그 시점부터 유휴 타임아웃(400ms)에 닫힌다.
+s = socket.create_connection(("127.0.0.1", ${port}))
+time.sleep(0.3)
+s.sendall(b"GET /health HTTP/1.1\r\nHost: t\r\n\r\n")
+data = b""
+while b"status: ok" not in data:
+    chunk = s.recv(4096)
+    if not chunk:
+        fail("keep-alive 응답 전에 연결이 닫혔습니다.")
+    data += chunk
+begin = time.monotonic()
+elapsed = wait_closed(s) - begin
+s.close()
+if not 0.35 <= elapsed < 0.75:
+    fail(f"keep-alive 유휴 타임아웃 시각이 예상과 다릅니다: {elapsed:.3f}s")
+
+# 4. 응답을 읽지 않아 송신이 멈춘 연결은 송신 타임아웃(600ms)에 닫힌다.
+# 작은 /metrics 요청 4000개(약 140KB)는 모두 완성된 요청이고, 응답(약 11MB)은 커널 송신 버퍼보다 커서 송신이 멈춘다.
+s = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+s.setsockopt(socket.SOL_SOCKET, socket.SO_RCVBUF, 4096)
+s.connect(("127.0.0.1", ${port}))
+s.sendall(b"GET /metrics HTTP/1.1\r\nHost: t\r\n\r\n" * 4000)
+time.sleep(1.2)
+s.close()
+
+# 5. 단계별 타임아웃 수를 /metrics 로 확인한다.
+m = socket.create_connection(("127.0.0.1", ${port}), timeout=5)
+m.sendall(b"GET /metrics HTTP/1.1\r\nHost: t\r\nConnection: close\r\n\r\n")
+body = b""
+while True:
+    chunk = m.recv(65536)
+    if not chunk:
+        break
+    body += chunk
+m.close()
+text = body.decode()
+expected = {"header": 1, "idle": 2, "write": 1}
+for phase, count in expected.items():
+    found = re.search(r'webserv_connection_timeouts_total\{phase="%s"\} (\d+)' % phase, text)
+    if not found or int(found.group(1)) != count:
+        fail(f"{phase} 타임아웃 수가 예상({count})과 다릅니다:\n{text}")
+PY
+
+echo "webserv v1.8.0 단계별 타임아웃(타이밍 휠) 테스트 통과"
@@ -0,0 +1,295 @@
+#!/usr/bin/env bash
+# webserv-cpp17 v1.22.0 테스트: TLS 리스너를 검증한다.
+# - 자체 서명 인증서로 TLS 포트에서 /health, 파이프라이닝, 업로드 본문, 큰 정적 파일(해시 비교)을 주고받는지,
+#   평문 포트는 그대로 동작하는지(워커 2개)
+# - 세션 재개: 티켓(TLS 1.3), 티켓을 끄면 세션 캐시(TLS 1.3 상태 저장 티켓, TLS 1.2 세션 ID),
+#   둘 다 끄면 재개하지 않는지와 full/resumed 계측
+# - TLS 포트에 평문 HTTP 를 보내면 연결을 닫고 failed 로 세는지
+# - 핸드셰이크 도중 멈춘 클라이언트를 유휴 마감으로 닫는지
+# - kTLS 계측이 있고 `--tls-ktls off` 면 0 인지
+# - 잘못된 TLS 옵션과 읽을 수 없는 인증서는 시작 전에 거절하는지
+set -euo pipefail
+
+if [ "$#" -ne 1 ]; then
+  echo "사용법: test_webserv_tls.sh <webserv_binary>" >&2
+  exit 1
+fi
+
+binary="$1"
+port=9125
+tls_port=9126
+other_tls_port=9127
+server_pid=""
+work_dir="$(mktemp -d)"
+
+cleanup() {
+  if [ -n "$server_pid" ] && kill -0 "$server_pid" 2>/dev/null; then
+    kill "$server_pid"
+    wait "$server_pid" || true
+  fi
+  rm -rf "$work_dir"
+}
+trap cleanup EXIT
+
+fail() {
+  echo "$1" >&2
+  exit 1
+}
+
+stop_server() {
+  kill "$server_pid"
+  wait "$server_pid" || true
+  server_pid=""
+}
+
+openssl req -x509 -newkey ec -pkeyopt ec_paramgen_curve:prime256v1 -nodes -days 1 -subj "/CN=localhost" \
+  -addext "subjectAltName=DNS:localhost,IP:127.0.0.1" \
+  -keyout "$work_dir/key.pem" -out "$work_dir/cert.pem" 2>/dev/null
+cert="$work_dir/cert.pem"
+key="$work_dir/key.pem"
+
+if "$binary" "$port" --tls-port "$tls_port" 2>/dev/null; then
+  fail "인증서 없는 --tls-port 를 받아들였습니다"
+fi
+if "$binary" "$port" --tls-port "$port" --tls-cert "$cert" --tls-key "$key" 2>/dev/null; then
+  fail "평문 포트와 같은 TLS 포트를 받아들였습니다"
+fi
+if "$binary" "$port" --tls-port 0 --tls-cert "$cert" --tls-key "$key" 2>/dev/null; then
+  fail "--tls-port 0 을 받아들였습니다"
+fi
+if "$binary" "$port" --tls-tickets maybe 2>/dev/null; then
+  fail "--tls-tickets maybe 를 받아들였습니다"
+fi
+if "$binary" "$port" 1 --tls-port "$tls_port" --tls-cert "$work_dir/missing.pem" --tls-key "$key" \
+  2> "$work_dir/cert.log"; then
+  fail "없는 인증서로 서버가 떴습니다"
+fi
+grep -q "TLS 설정 실패" "$work_dir/cert.log" || fail "인증서 읽기 실패를 알리지 않았습니다"
+if "$binary" "$port" 1 --tls-port "$tls_port" --tls-cert "$cert" --tls-key "$cert" 2> "$work_dir/key.log"; then
+  fail "개인 키가 아닌 파일로 서버가 떴습니다"
+fi
+grep -q "TLS 설정 실패" "$work_dir/key.log" || fail "개인 키 읽기 실패를 알리지 않았습니다"
+
+mkdir -p "$work_dir/root"
+head -c 5000000 /dev/urandom > "$work_dir/root/big.bin"
+printf 'tiny file\n' > "$work_dir/root/small.txt"
+
+# 공용 클라이언트 도우미
+cat > "$work_dir/client.py" <<'PY'
+import re
+import socket
+import ssl
+
+def context(cert, maximum=None):
+    ctx = ssl.SSLContext(ssl.PROTOCOL_TLS_CLIENT)
+    ctx.load_verify_locations(cert)
+    if maximum is not None:
+        ctx.maximum_version = maximum
+    return ctx
+
+
+def read_response(sock, pending):
+    while b"\r\n\r\n" not in pending:
+        chunk = sock.recv(65536)
+        if not chunk:
+            raise SystemExit("응답 도중 연결이 닫혔습니다: %r" % pending[:200])
+        pending += chunk
+    head, _, rest = pending.partition(b"\r\n\r\n")
+    length = int(re.search(rb"Content-Length: (\d+)", head, re.I).group(1))
+    while len(rest) < length:
+        chunk = sock.recv(262144)
+        if not chunk:
+            raise SystemExit("본문 도중 연결이 닫혔습니다")
+        rest += chunk
+    return head, rest[:length], rest[length:]
+
+
+def exchange(sock, payload, count):
+    sock.sendall(payload)
+    responses, pending = [], b""
+    for _ in range(count):
+        head, body, pending = read_response(sock, pending)
+        responses.append((head, body))
+    return responses
+
+
+def tls_connect(ctx, port, session=None):
+    raw = socket.create_connection(("127.0.0.1", port), timeout=10)
+    return ctx.wrap_socket(raw, server_hostname="localhost", session=session)
+
+
+def metrics(port):
+    with socket.create_connection(("127.0.0.1", port), timeout=5) as sock:
+        _, body = exchange(sock, b"GET /metrics HTTP/1.1\r\nHost: tls.test\r\nConnection: close\r\n\r\n", 1)[0]
+    handshakes, ktls = {}, None
+    for line in body.decode().splitlines():
+        match = re.match(r'webserv_tls_handshakes_total\{result="(\w+)"\} (\d+)$', line)
+        if match:
+            handshakes[match.group(1)] = handshakes.get(match.group(1), 0) + int(match.group(2))
+        match = re.match(r"webserv_tls_ktls_send_total (\d+)$", line)
+        if match:
+            ktls = int(match.group(1))
+    if set(handshakes) != {"full", "resumed", "failed"} or ktls is None:
+        raise SystemExit("TLS 계측이 없습니다: %r %r" % (handshakes, ktls))
+    return handshakes, ktls
+
+
+def resume_once(ctx, port):
+    """연결 두 개를 차례로 맺는다. 두 번째 연결이 첫 연결의 세션으로 재개했는지 돌려준다."""
+    request = b"GET /health HTTP/1.1\r\nHost: tls.test\r\n\r\n"
+    with tls_connect(ctx, port) as first:
+        exchange(first, request, 1)
+        # TLS 1.3 티켓은 핸드셰이크 뒤에 오므로 응답을 한 번 받은 다음에 세션을 꺼낸다.
+        session = first.session
+    with tls_connect(ctx, port, session) as second:
+        exchange(second, request, 1)
+        return second.session_reused
+PY
+
+# 1) 기본 설정(티켓 + 세션 캐시), 워커 2개
+"$binary" "$port" --unlimited --workers 2 --demo-routes --root "$work_dir/root" --idle-timeout-ms 400 --write-timeout-ms 5000 \
+  --tls-port "$tls_port" --tls-cert "$cert" --tls-key "$key" &
+server_pid=$!
+sleep 0.3
+
+PYTHONPATH="$work_dir" python - "$port" "$tls_port" "$cert" "$work_dir/root/big.bin" <<'PY'
+import hashlib
+import socket
+import ssl
+import sys
+import time
+
+from client import context, exchange, metrics, resume_once, tls_connect
+
+port, tls_port, cert, big = int(sys.argv[1]), int(sys.argv[2]), sys.argv[3], sys.argv[4]
+ctx = context(cert)
+before, _ = metrics(port)
+
+with tls_connect(ctx, tls_port) as sock:
+    if sock.version() not in ("TLSv1.3", "TLSv1.2"):
+        sys.exit("TLS 버전이 이상합니다: %s" % sock.version())
+    replies = exchange(sock, b"GET /health HTTP/1.1\r\nHost: tls.test\r\n\r\n" * 20
+                             + b"POST /upload HTTP/1.1\r\nHost: tls.test\r\nContent-Length: 11\r\n\r\nhello world", 21)
+    if any(b" 200 " not in head.split(b"\r\n")[0] for head, _ in replies):
+        sys.exit("TLS 파이프라이닝 응답이 200 이 아닙니다: %r" % replies[0][0])
+
+    # 작은 파일 뒤에 큰 파일: 헤더와 파일 본문을 한 레코드로 묶는 경로와 여러 레코드로 나뉘는 경로
+    replies = exchange(sock, b"GET /small.txt HTTP/1.1\r\nHost: tls.test\r\n\r\n"
+                             b"GET /big.bin HTTP/1.1\r\nHost: tls.test\r\n\r\n"
+                             b"GET /small.txt HTTP/1.1\r\nHost: tls.test\r\n\r\n", 3)
+    if replies[0][1] != b"tiny file\n" or replies[2][1] != b"tiny file\n":
+        sys.exit("TLS 로 받은 작은 파일이 다릅니다: %r" % replies[0][1])
+    expected = hashlib.sha256(open(big, "rb").read()).hexdigest()
+    if hashlib.sha256(replies[1][1]).hexdigest() != expected:
+        sys.exit("TLS 로 받은 큰 파일의 해시가 다릅니다")
+
+# 늦게 읽는 클라이언트: 소켓 송신 버퍼가 차서 SSL_write 가 막혔다가 쓰기 이벤트로 이어 가는 경로.
+# 수신 버퍼는 TLS 레코드 하나(16KB + 헤더)보다 커야 클라이언트가 레코드를 풀 수 있다.
+raw = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+raw.setsockopt(socket.SOL_SOCKET, socket.SO_RCVBUF, 65536)
+raw.settimeout(10)
+raw.connect(("127.0.0.1", tls_port))
+with ctx.wrap_socket(raw, server_hostname="localhost") as sock:
+    sock.sendall(b"GET /big.bin HTTP/1.1\r\nHost: tls.test\r\nConnection: close\r\n\r\n")
+    time.sleep(0.2)
+    data = b""
+    while True:
+        chunk = sock.recv(65536)
+        if not chunk:
+            break
+        data += chunk
+    body = data.partition(b"\r\n\r\n")[2]
+    if hashlib.sha256(body).hexdigest() != expected:
+        sys.exit("늦게 읽은 큰 파일의 해시가 다릅니다")
+
+# 평문 포트는 그대로다.
+with socket.create_connection(("127.0.0.1", port), timeout=5) as sock:
+    head, _ = exchange(sock, b"GET /health HTTP/1.1\r\nHost: tls.test\r\n\r\n", 1)[0]
+    if b" 200 " not in head:
+        sys.exit("평문 포트 응답이 200 이 아닙니다")
+
+# 세션 재개: TLS 1.3 티켓, TLS 1.2 티켓
+if not resume_once(ctx, tls_port):
+    sys.exit("TLS 1.3 세션 티켓으로 재개하지 못했습니다")
+if not resume_once(context(cert, ssl.TLSVersion.TLSv1_2), tls_port):
+    sys.exit("TLS 1.2 세션 티켓으로 재개하지 못했습니다")
+
+# TLS 포트에 평문 HTTP
+with socket.create_connection(("127.0.0.1", tls_port), timeout=5) as sock:
+    sock.sendall(b"GET /health HTTP/1.1\r\nHost: tls.test\r\n\r\n")
+    reply = b""
+    while True:
+        chunk = sock.recv(4096)
+        if not chunk:
+            break
+        reply += chunk
+    if b"HTTP/1.1" in reply:
+        sys.exit("TLS 포트가 평문 HTTP 에 응답했습니다: %r" % reply)
+
+# 핸드셰이크 도중 멈춘 클라이언트: 레코드 헤더만 보내고 기다린다.
+with socket.create_connection(("127.0.0.1", tls_port), timeout=5) as sock:
+    sock.sendall(b"\x16\x03\x01\x02\x00")
+    start = time.time()
+    if sock.recv(4096) != b"":
+        sys.exit("멈춘 핸드셰이크에 응답을 보냈습니다")
+    if time.time() - start > 2.0:
+        sys.exit("멈춘 핸드셰이크를 유휴 마감에 닫지 않았습니다")
+
+after, ktls = metrics(port)
+full = after["full"] - before["full"]
+resumed = after["resumed"] - before["resumed"]
+failed = after["failed"] - before["failed"]
+# 전체 핸드셰이크: 첫 연결, 느린 클라이언트, 재개 검사의 첫 연결 두 개. 재개: 재개 검사의 두 번째 연결 두 개.
+if full != 4 or resumed != 2 or failed != 1:
+    sys.exit("TLS 핸드셰이크 계측이 다릅니다: full=%d resumed=%d failed=%d" % (full, resumed, failed))
+PY
+stop_server
+
+# 2) 티켓을 끄면 서버 세션 캐시로 재개한다. 워커가 둘이어도 캐시는 함께 쓴다.
+"$binary" "$port" --unlimited --workers 2 --tls-port "$other_tls_port" --tls-cert "$cert" --tls-key "$key" \
+  --tls-tickets off --tls-ktls off &
+server_pid=$!
+sleep 0.3
+
+PYTHONPATH="$work_dir" python - "$port" "$other_tls_port" "$cert" <<'PY'
+import ssl
+import sys
+
+from client import context, metrics, resume_once
+
+port, tls_port, cert = int(sys.argv[1]), int(sys.argv[2]), sys.argv[3]
+for _ in range(3):
+    if not resume_once(context(cert), tls_port):
+        sys.exit("티켓을 끈 TLS 1.3 에서 세션 캐시로 재개하지 못했습니다")
+    if not resume_once(context(cert, ssl.TLSVersion.TLSv1_2), tls_port):
+        sys.exit("티켓을 끈 TLS 1.2 에서 세션 ID 로 재개하지 못했습니다")
+handshakes, ktls = metrics(port)
+if handshakes["resumed"] != 6:
+    sys.exit("세션 캐시 재개 계측이 다릅니다: %r" % handshakes)
+if ktls != 0:
+    sys.exit("--tls-ktls off 인데 kTLS 송신을 셌습니다: %d" % ktls)
+PY
+stop_server
+
+# 3) 티켓과 세션 캐시를 모두 끄면 재개하지 않는다.
+"$binary" "$port" --unlimited --workers 1 --tls-port "$other_tls_port" --tls-cert "$cert" --tls-key "$key" \
+  --tls-tickets off --tls-session-cache 0 &
+server_pid=$!
+sleep 0.3
+
+PYTHONPATH="$work_dir" python - "$port" "$other_tls_port" "$cert" <<'PY'
+import ssl
+import sys
+
+from client import context, metrics, resume_once
+
+port, tls_port, cert = int(sys.argv[1]), int(sys.argv[2]), sys.argv[3]
+if resume_once(context(cert), tls_port) or resume_once(context(cert, ssl.TLSVersion.TLSv1_2), tls_port):
+    sys.exit("티켓과 세션 캐시를 모두 껐는데 재개했습니다")
+handshakes, _ = metrics(port)
+if handshakes["full"] != 4 or handshakes["resumed"] != 0:
+    sys.exit("재개 없는 핸드셰이크 계측이 다릅니다: %r" % handshakes)
+PY
+stop_server
+
+echo "webserv v1.22.0 TLS 테스트 통과"
@@ -0,0 +1,74 @@
+#!/usr/bin/env bash
+# webserv-cpp17 v1.2.0 테스트: --workers 4 로 실행했을 때 여러 워커가 요청을 나눠 처리하고,
+# 전체 처리 건수가 max_requests 에 도달하면 모든 워커가 함께 종료하는지 검증한다.
+set -euo pipefail
+
+if [ "$#" -ne 1 ]; then
+  echo "사용법: test_webserv_workers.sh <webserv_binary>" >&2
+  exit 1
+fi
+
+binary="$1"
+port=9095
+max_requests=40
+
+"$binary" "$port" "$max_requests" --workers 4 &
+server_pid=$!
+
+cleanup() {
+  if kill -0 "$server_pid" 2>/dev/null; then
+    kill "$server_pid"
+    wait "$server_pid" || true
+  fi
+}
+trap cleanup EXIT
+
+sleep 0.3
+
+threads=$(ls "/proc/${server_pid}/task" | wc -l)
+if [ "$threads" -lt 4 ]; then
+  echo "워커 스레드 수가 예상보다 적습니다: ${threads}" >&2
+  exit 1
+fi
+
+python - <<PY
+import socket
+import sys
+import threading
+
+errors = []
+
+def client():
+    try:
+        for _ in range(5):
+            s = socket.create_connection(("127.0.0.1", ${port}))
+            s.sendall(b"GET /health HTTP/1.1\r\nHost: workers.test\r\nConnection: close\r\n\r\n")
+            data = b""
+            while True:
+                chunk = s.recv(4096)
+                if not chunk:
+                    break
+                data += chunk
+            s.close()
+            if b"status: ok" not in data:
+                errors.append(data)
+    except OSError as exc:
+        errors.append(exc)
+
+threads = [threading.Thread(target=client) for _ in range(8)]
+for t in threads:
+    t.start()
+for t in threads:
+    t.join()
+if errors:
+    print("멀티 워커 응답이 예상과 다릅니다:", errors[:1], file=sys.stderr)
+    sys.exit(1)
+PY
+
+sleep 0.5
+if kill -0 "$server_pid" 2>/dev/null; then
+  echo "전체 처리 건수 도달 후 서버가 종료되지 않았습니다." >&2
+  exit 1
+fi
+
+echo "webserv v1.2.0 멀티 워커 테스트 통과"